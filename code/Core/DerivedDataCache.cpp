@@ -0,0 +1,568 @@
+#include "DerivedDataCache.h"
+#include "FFLog.h"
+#include "PathManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    inline uint64_t rotl64(uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline uint64_t fmix64(uint64_t k)
+    {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdull;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ull;
+        k ^= k >> 33;
+        return k;
+    }
+
+    double millisecondsSince(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    std::string toHex(const uint64_t hash[2])
+    {
+        char text[33];
+        snprintf(text, sizeof(text), "%016llx%016llx", (unsigned long long)hash[0], (unsigned long long)hash[1]);
+        return text;
+    }
+
+    // Content hashes of source files, reused while their size and mtime are unchanged
+    struct SFileHash {
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        uint64_t hash[2] = {0, 0};
+    };
+    std::mutex s_fileHashMutex;
+    std::unordered_map<std::string, SFileHash> s_fileHashes;
+}
+
+// ============================================
+// Hashing
+// ============================================
+
+void HashBytes128(const void* data, size_t size, uint64_t seed, uint64_t outHash[2])
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const size_t blockCount = size / 16;
+    const uint64_t c1 = 0x87c37b91114253d5ull;
+    const uint64_t c2 = 0x4cf5ad432745937full;
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    for (size_t i = 0; i < blockCount; i++) {
+        uint64_t k1, k2;
+        memcpy(&k1, bytes + i * 16, 8);
+        memcpy(&k2, bytes + i * 16 + 8, 8);
+
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const uint8_t* tail = bytes + blockCount * 16;
+    const size_t rest = size & 15;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (size_t i = rest; i > 8; i--) {
+        k2 ^= (uint64_t)tail[i - 1] << ((i - 9) * 8);
+    }
+    if (rest > 8) {
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+    }
+    for (size_t i = std::min<size_t>(rest, 8); i > 0; i--) {
+        k1 ^= (uint64_t)tail[i - 1] << ((i - 1) * 8);
+    }
+    if (rest > 0) {
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    h1 ^= size; h2 ^= size;
+    h1 += h2; h2 += h1;
+    h1 = fmix64(h1); h2 = fmix64(h2);
+    h1 += h2; h2 += h1;
+    outHash[0] = h1;
+    outHash[1] = h2;
+}
+
+std::string SDerivedDataKey::ToString() const
+{
+    return kind + "/" + toHex(hash);
+}
+
+// ============================================
+// CDerivedDataKeyBuilder
+// ============================================
+
+CDerivedDataKeyBuilder::CDerivedDataKeyBuilder(const char* kind, uint32_t version)
+    : m_kind(kind)
+{
+    HashBytes128(m_kind.data(), m_kind.size(), 0, m_state);
+    Add(version);
+}
+
+CDerivedDataKeyBuilder& CDerivedDataKeyBuilder::Add(const void* data, size_t size)
+{
+    // Chain: state = H(state, H(part)); seeding the part with its length delimits it
+    uint64_t chain[4];
+    HashBytes128(data, size, size, chain + 2);
+    chain[0] = m_state[0];
+    chain[1] = m_state[1];
+    HashBytes128(chain, sizeof(chain), 0, m_state);
+    return *this;
+}
+
+bool CDerivedDataKeyBuilder::AddFile(const std::string& path)
+{
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+
+    SFileHash entry;
+    entry.size = static_cast<uint64_t>(size);
+    entry.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    std::string name = FFPath::Normalize(path);
+
+    bool cached = false;
+    {
+        std::lock_guard<std::mutex> lock(s_fileHashMutex);
+        auto it = s_fileHashes.find(name);
+        if (it != s_fileHashes.end() && it->second.size == entry.size && it->second.mtime == entry.mtime) {
+            entry = it->second;
+            cached = true;
+        }
+    }
+
+    if (!cached) {
+        CMappedFile file;
+        if (!file.Open(path)) {
+            return false;
+        }
+        HashBytes128(file.Data(), file.Size(), 0, entry.hash);
+        std::lock_guard<std::mutex> lock(s_fileHashMutex);
+        s_fileHashes[name] = entry;
+    }
+
+    Add(entry.hash, sizeof(entry.hash));
+    return true;
+}
+
+SDerivedDataKey CDerivedDataKeyBuilder::Build() const
+{
+    SDerivedDataKey key;
+    key.kind = m_kind;
+    key.hash[0] = m_state[0];
+    key.hash[1] = m_state[1];
+    return key;
+}
+
+// ============================================
+// CDerivedDataCache
+// ============================================
+
+CDerivedDataCache& CDerivedDataCache::Instance()
+{
+    static CDerivedDataCache instance;
+    return instance;
+}
+
+void CDerivedDataCache::SetRoot(const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_root = directory;
+    m_rootSet = !directory.empty();
+    m_indexed = false;
+    m_entries.clear();
+    m_totalBytes = 0;
+}
+
+std::string CDerivedDataCache::GetRoot()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    EnsureIndexLocked();
+    return m_root;
+}
+
+void CDerivedDataCache::SetSizeLimit(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sizeLimit = bytes;
+    if (m_indexed) {
+        EvictLocked(std::string());
+    }
+}
+
+bool CDerivedDataCache::EnsureIndexLocked()
+{
+    if (m_root.empty() && !m_rootSet && FFPath::IsInitialized()) {
+        m_root = FFPath::GetProjectRoot() + "/cache/ddc";
+    }
+    if (m_root.empty()) {
+        return false;
+    }
+    if (m_indexed) {
+        return true;
+    }
+
+    // Recency across runs comes from file mtimes: oldest first gets the lowest clock
+    struct SScanned {
+        std::filesystem::file_time_type mtime;
+        std::string name;
+        uint64_t size;
+    };
+    std::vector<SScanned> scanned;
+    std::vector<std::filesystem::path> interrupted;
+    std::error_code ec;
+    for (auto it = std::filesystem::recursive_directory_iterator(m_root, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        std::error_code fileError;
+        if (!it->is_regular_file(fileError)) continue;
+        const std::filesystem::path& path = it->path();
+        if (path.filename().string().find(".tmp") != std::string::npos) {
+            interrupted.push_back(path);    // Put that never reached its rename
+            continue;
+        }
+        if (path.extension() != ".ddc") continue;
+
+        SScanned entry;
+        entry.name = path.parent_path().filename().string() + "/" + path.stem().string();
+        entry.size = static_cast<uint64_t>(it->file_size(fileError));
+        entry.mtime = it->last_write_time(fileError);
+        if (!fileError) scanned.push_back(std::move(entry));
+    }
+    for (const auto& path : interrupted) {
+        std::filesystem::remove(path, ec);
+    }
+    std::sort(scanned.begin(), scanned.end(),
+              [](const SScanned& a, const SScanned& b) { return a.mtime < b.mtime; });
+
+    m_entries.clear();
+    m_totalBytes = 0;
+    for (const SScanned& entry : scanned) {
+        m_entries[entry.name] = SEntry{entry.size, ++m_clock};
+        m_totalBytes += entry.size;
+    }
+    m_indexed = true;
+    EvictLocked(std::string());
+    return true;
+}
+
+std::string CDerivedDataCache::GetEntryPathLocked(const SDerivedDataKey& key) const
+{
+    return m_root + "/" + key.kind + "/" + toHex(key.hash) + ".ddc";
+}
+
+void CDerivedDataCache::EvictLocked(const std::string& keep)
+{
+    if (m_totalBytes <= m_sizeLimit) {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> order;
+    order.reserve(m_entries.size());
+    for (const auto& [name, entry] : m_entries) {
+        if (name != keep) order.emplace_back(entry.lastUse, name);
+    }
+    std::sort(order.begin(), order.end());
+
+    for (const auto& [lastUse, name] : order) {
+        if (m_totalBytes <= m_sizeLimit) break;
+        std::error_code ec;
+        std::filesystem::remove(m_root + "/" + name + ".ddc", ec);
+        if (ec) continue;   // Still mapped by a reader: try again after the next Put
+
+        auto it = m_entries.find(name);
+        m_totalBytes -= it->second.size;
+        m_entries.erase(it);
+        std::string kind = name.substr(0, name.find('/'));
+        m_stats.kinds[kind].evictions++;
+        m_stats.total.evictions++;
+    }
+}
+
+void CDerivedDataCache::TouchLocked(const std::string& name, const std::string& path)
+{
+    m_entries[name].lastUse = ++m_clock;
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+}
+
+void CDerivedDataCache::RecordLocked(const SDerivedDataKey& key, const std::function<void(SKindStats&)>& update)
+{
+    update(m_stats.kinds[key.kind]);
+    update(m_stats.total);
+}
+
+void CDerivedDataCache::DropLocked(const std::string& name, const std::string& path)
+{
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    auto it = m_entries.find(name);
+    if (it != m_entries.end()) {
+        m_totalBytes -= it->second.size;
+        m_entries.erase(it);
+    }
+}
+
+bool CDerivedDataCache::OpenEntry(const SDerivedDataKey& key, CMappedFile& outFile, SDerivedDataHeader& outHeader)
+{
+    if (!m_enabled || !key.IsValid()) {
+        return false;
+    }
+
+    std::string name = key.ToString();
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!EnsureIndexLocked()) {
+            return false;
+        }
+        path = GetEntryPathLocked(key);
+        if (m_entries.find(name) == m_entries.end()) {
+            RecordLocked(key, [](SKindStats& s) { s.misses++; });
+            return false;
+        }
+        // Before mapping: the mapping blocks writes to the file
+        TouchLocked(name, path);
+    }
+
+    bool valid = outFile.Open(path) && outFile.Size() >= sizeof(SDerivedDataHeader);
+    if (valid) {
+        memcpy(&outHeader, outFile.Data(), sizeof(outHeader));
+        valid = outHeader.magic == DDC_MAGIC && outHeader.version == DDC_VERSION &&
+                outHeader.keyHash[0] == key.hash[0] && outHeader.keyHash[1] == key.hash[1] &&
+                outHeader.payloadSize == outFile.Size() - sizeof(SDerivedDataHeader);
+    }
+    if (!valid) {
+        outFile.Close();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        DropLocked(name, path);
+        RecordLocked(key, [](SKindStats& s) { s.misses++; s.corrupt++; });
+        CFFLog::Warning("[DDC] Dropped invalid entry %s", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CDerivedDataCache::Map(const SDerivedDataKey& key, CMappedFile& outFile, size_t& outOffset)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    SDerivedDataHeader header;
+    if (!OpenEntry(key, outFile, header)) {
+        return false;
+    }
+
+    outOffset = sizeof(SDerivedDataHeader);
+    double ms = millisecondsSince(start);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RecordLocked(key, [&](SKindStats& s) {
+        s.hits++;
+        s.bytesRead += header.payloadSize;
+        s.hitMs += ms;
+        s.buildMsSaved += header.buildMs;
+    });
+    return true;
+}
+
+bool CDerivedDataCache::Get(const SDerivedDataKey& key, std::vector<uint8_t>& outData)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    CMappedFile file;
+    SDerivedDataHeader header;
+    if (!OpenEntry(key, file, header)) {
+        return false;
+    }
+
+    const uint8_t* payload = file.Data() + sizeof(SDerivedDataHeader);
+    uint64_t hash[2];
+    HashBytes128(payload, header.payloadSize, 0, hash);
+    if (hash[0] != header.payloadHash) {
+        file.Close();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        DropLocked(key.ToString(), GetEntryPathLocked(key));
+        RecordLocked(key, [](SKindStats& s) { s.misses++; s.corrupt++; });
+        CFFLog::Warning("[DDC] Dropped corrupt entry %s", key.ToString().c_str());
+        return false;
+    }
+    outData.assign(payload, payload + header.payloadSize);
+
+    double ms = millisecondsSince(start);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RecordLocked(key, [&](SKindStats& s) {
+        s.hits++;
+        s.bytesRead += header.payloadSize;
+        s.hitMs += ms;
+        s.buildMsSaved += header.buildMs;
+    });
+    return true;
+}
+
+bool CDerivedDataCache::Put(const SDerivedDataKey& key, const void* data, size_t size, double buildMs)
+{
+    if (!m_enabled || !key.IsValid()) {
+        return false;
+    }
+
+    std::string name = key.ToString();
+    std::string path;
+    uint64_t tempId = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!EnsureIndexLocked()) {
+            return false;
+        }
+        if (size + sizeof(SDerivedDataHeader) > m_sizeLimit) {
+            return false;   // Would evict everything else and itself
+        }
+        path = GetEntryPathLocked(key);
+        tempId = ++m_tempCounter;
+    }
+
+    SDerivedDataHeader header = {};
+    header.magic = DDC_MAGIC;
+    header.version = DDC_VERSION;
+    header.keyHash[0] = key.hash[0];
+    header.keyHash[1] = key.hash[1];
+    header.payloadSize = size;
+    uint64_t payloadHash[2];
+    HashBytes128(data, size, 0, payloadHash);
+    header.payloadHash = payloadHash[0];
+    header.buildMs = buildMs;
+
+    std::error_code ec;
+    std::filesystem::path target(path);
+    std::filesystem::create_directories(target.parent_path(), ec);
+    std::filesystem::path temp = target;
+    temp += ".tmp" + std::to_string(tempId);
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            CFFLog::Error("[DDC] Failed to open for writing: %s", temp.string().c_str());
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!file.good()) {
+            CFFLog::Error("[DDC] Write failed: %s", path.c_str());
+            file.close();
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        CFFLog::Warning("[DDC] Failed to replace %s: %s", path.c_str(), ec.message().c_str());
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t fileSize = size + sizeof(SDerivedDataHeader);
+    SEntry& entry = m_entries[name];
+    m_totalBytes = m_totalBytes - entry.size + fileSize;
+    entry.size = fileSize;
+    entry.lastUse = ++m_clock;
+    RecordLocked(key, [&](SKindStats& s) {
+        s.puts++;
+        s.bytesWritten += fileSize;
+    });
+    EvictLocked(name);
+    return true;
+}
+
+bool CDerivedDataCache::GetOrBuild(const SDerivedDataKey& key, std::vector<uint8_t>& outData,
+                                   const std::function<bool(std::vector<uint8_t>&)>& build)
+{
+    if (Get(key, outData)) {
+        return true;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    outData.clear();
+    if (!build(outData)) {
+        return false;
+    }
+    Put(key, outData, millisecondsSince(start));
+    return true;
+}
+
+bool CDerivedDataCache::Contains(const SDerivedDataKey& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_enabled && key.IsValid() && EnsureIndexLocked() && m_entries.count(key.ToString()) > 0;
+}
+
+void CDerivedDataCache::Remove(const SDerivedDataKey& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (key.IsValid() && EnsureIndexLocked()) {
+        DropLocked(key.ToString(), GetEntryPathLocked(key));
+    }
+}
+
+void CDerivedDataCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!EnsureIndexLocked()) {
+        return;
+    }
+    for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+        std::error_code ec;
+        std::filesystem::remove(m_root + "/" + it->first + ".ddc", ec);
+        if (ec) {
+            ++it;   // Mapped by a reader
+            continue;
+        }
+        m_totalBytes -= it->second.size;
+        it = m_entries.erase(it);
+    }
+}
+
+CDerivedDataCache::SStats CDerivedDataCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    EnsureIndexLocked();
+    SStats stats = m_stats;
+    stats.entries = static_cast<uint32_t>(m_entries.size());
+    stats.totalBytes = m_totalBytes;
+    return stats;
+}
+
+void CDerivedDataCache::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = SStats();
+}
+
+void CDerivedDataCache::LogReport()
+{
+    SStats stats = GetStats();
+    CFFLog::Info("[DDC] %s: %u entries, %.2f MB (limit %.0f MB)", GetRoot().c_str(), stats.entries,
+                 stats.totalBytes / (1024.0 * 1024.0), m_sizeLimit / (1024.0 * 1024.0));
+
+    auto logKind = [](const std::string& kind, const SKindStats& s) {
+        uint32_t lookups = s.hits + s.misses;
+        CFFLog::Info("[DDC]   %-8s: %u hits / %u misses (%.1f%%), %u puts, %u evicted, %u corrupt, "
+                     "%.2f MB read, %.2f MB written, saved %.2f ms (%.2f ms built, %.2f ms reading)",
+                     kind.c_str(), s.hits, s.misses, lookups ? 100.0 * s.hits / lookups : 0.0, s.puts,
+                     s.evictions, s.corrupt, s.bytesRead / (1024.0 * 1024.0), s.bytesWritten / (1024.0 * 1024.0),
+                     s.GetTimeSavedMs(), s.buildMsSaved, s.hitMs);
+    };
+    for (const auto& [kind, s] : stats.kinds) {
+        logKind(kind, s);
+    }
+    logKind("total", stats.total);
+}
@@ -0,0 +1,199 @@
+#pragma once
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ============================================
+// Derived-data cache (DDC)
+// ============================================
+// Content-addressed store for data computed from source assets: cooked meshes
+// (tangents, xatlas UV2, reordering, LODs), cooked textures (mips + BC blocks)
+// and anything else that is expensive to rebuild and cheap to read back.
+//
+// A key hashes a kind ("mesh", "texture", ...), the kind's version, the bytes
+// of every source file involved and the import settings (see
+// CDerivedDataKeyBuilder). Touching a file without changing it keeps its
+// entries; editing it, changing a setting or bumping a cooker version just
+// produces another key, and the stale entry ages out.
+//
+// Values are opaque binary blobs, one file per entry:
+//
+//   <root>/<kind>/<32 hex digits>.ddc     SDerivedDataHeader, then the payload
+//
+// The payload starts 64 bytes in, so mapped payloads keep 16-byte alignment
+// (Map() is zero copy; Get() copies and verifies the payload hash).
+//
+// The directory is capped by SetSizeLimit(): after a Put the least recently
+// used entries are deleted. Every hit rewrites the entry's mtime, so recency
+// survives restarts (the directory is scanned once, on first use).
+//
+// Thread-safe. A single process is expected to own the directory.
+
+struct SDerivedDataKey {
+    std::string kind;               // Sub-directory and stats bucket
+    uint64_t hash[2] = {0, 0};
+
+    bool IsValid() const { return !kind.empty(); }
+    std::string ToString() const;   // "<kind>/<32 hex>"
+    bool operator==(const SDerivedDataKey& o) const {
+        return kind == o.kind && hash[0] == o.hash[0] && hash[1] == o.hash[1];
+    }
+};
+
+// 128-bit hash of a byte range (MurmurHash3 x64)
+void HashBytes128(const void* data, size_t size, uint64_t seed, uint64_t outHash[2]);
+
+// ============================================
+// CDerivedDataKeyBuilder
+// ============================================
+// Usage:
+//   CDerivedDataKeyBuilder builder("mesh", FFMESH_VERSION);
+//   if (builder.AddFile(path)) { builder.Add(importFlags); SDerivedDataKey key = builder.Build(); }
+//
+// Every Add is length-prefixed, so ("ab", "c") and ("a", "bc") differ.
+class CDerivedDataKeyBuilder
+{
+public:
+    CDerivedDataKeyBuilder(const char* kind, uint32_t version);
+
+    CDerivedDataKeyBuilder& Add(const void* data, size_t size);
+    CDerivedDataKeyBuilder& Add(const std::string& text) { return Add(text.data(), text.size()); }
+    CDerivedDataKeyBuilder& Add(const char* text) { return Add(std::string(text)); }
+    CDerivedDataKeyBuilder& Add(uint64_t value) { return Add(&value, sizeof(value)); }
+    CDerivedDataKeyBuilder& Add(uint32_t value) { return Add(&value, sizeof(value)); }
+    CDerivedDataKeyBuilder& Add(bool value) { return Add((uint32_t)(value ? 1 : 0)); }
+    CDerivedDataKeyBuilder& Add(float value) { return Add(&value, sizeof(value)); }
+
+    // Content of a source file (not its path or mtime). False if it cannot be read.
+    bool AddFile(const std::string& path);
+
+    SDerivedDataKey Build() const;
+
+private:
+    std::string m_kind;
+    uint64_t m_state[2];
+};
+
+// On-disk entry header (native endianness)
+struct SDerivedDataHeader {
+    uint32_t magic;             // DDC_MAGIC
+    uint32_t version;           // DDC_VERSION (container only, kinds version their payloads)
+    uint64_t keyHash[2];        // Guards against renamed / misplaced files
+    uint64_t payloadSize;
+    uint64_t payloadHash;       // First half of HashBytes128(payload, 0)
+    double buildMs;             // Time the producer spent computing the payload
+    uint8_t reserved[16];
+};
+static_assert(sizeof(SDerivedDataHeader) == 64, "SDerivedDataHeader layout is part of the file format");
+
+static const uint32_t DDC_MAGIC = 0x43444446;       // "FDDC"
+static const uint32_t DDC_VERSION = 1;
+static const uint64_t kDefaultDerivedDataSizeLimit = 4ull << 30;
+
+class CDerivedDataCache
+{
+public:
+    static CDerivedDataCache& Instance();
+
+    // Directory of the cache; empty = <project>/cache/ddc once FFPath is
+    // initialized (the default). Changing it drops the in-memory index, the
+    // next call rescans the directory (stats are kept).
+    void SetRoot(const std::string& directory);
+    std::string GetRoot();
+
+    // Off: every lookup misses and nothing is written
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+
+    // Total size of all entries; applied after every Put (and now, if lower)
+    void SetSizeLimit(uint64_t bytes);
+    uint64_t GetSizeLimit() const { return m_sizeLimit; }
+
+    // Copy of the payload, verified against its hash. A corrupt entry is deleted.
+    bool Get(const SDerivedDataKey& key, std::vector<uint8_t>& outData);
+
+    // Zero-copy view: the payload is outFile.Data() + outOffset, up to outFile.Size().
+    // Only the header is validated; payload formats check their own structure.
+    bool Map(const SDerivedDataKey& key, CMappedFile& outFile, size_t& outOffset);
+
+    // Store a payload; buildMs is what a later hit saves. Written through a
+    // temporary file, then older entries are evicted down to the size limit.
+    bool Put(const SDerivedDataKey& key, const void* data, size_t size, double buildMs);
+    bool Put(const SDerivedDataKey& key, const std::vector<uint8_t>& data, double buildMs) {
+        return Put(key, data.data(), data.size(), buildMs);
+    }
+
+    // Get, or run build (timed) and Put its output. False if build fails.
+    bool GetOrBuild(const SDerivedDataKey& key, std::vector<uint8_t>& outData,
+                    const std::function<bool(std::vector<uint8_t>&)>& build);
+
+    bool Contains(const SDerivedDataKey& key);
+
+    // Drop one entry (e.g. a payload its reader rejected)
+    void Remove(const SDerivedDataKey& key);
+
+    // Delete every entry
+    void Clear();
+
+    // Hits / misses are counted by Get, Map and GetOrBuild
+    struct SKindStats {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t puts = 0;
+        uint32_t evictions = 0;
+        uint32_t corrupt = 0;       // Entries rejected on read (header or payload hash)
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+        double hitMs = 0.0;         // Spent reading hits
+        double buildMsSaved = 0.0;  // Sum of the stored build times of hits
+        double GetTimeSavedMs() const { return buildMsSaved - hitMs; }
+    };
+    struct SStats {
+        std::map<std::string, SKindStats> kinds;
+        SKindStats total;
+        uint32_t entries = 0;       // On disk, as indexed
+        uint64_t totalBytes = 0;
+    };
+    SStats GetStats();
+    void ResetStats();
+    void LogReport();
+
+private:
+    CDerivedDataCache() = default;
+    CDerivedDataCache(const CDerivedDataCache&) = delete;
+    CDerivedDataCache& operator=(const CDerivedDataCache&) = delete;
+
+    struct SEntry {
+        uint64_t size = 0;          // Whole file
+        uint64_t lastUse = 0;       // m_clock at the last hit / put
+    };
+
+    // Read the header of an entry (touches it); counts the miss when there is none
+    bool OpenEntry(const SDerivedDataKey& key, CMappedFile& outFile, SDerivedDataHeader& outHeader);
+
+    // *Locked: caller holds m_mutex
+    bool EnsureIndexLocked();
+    void EvictLocked(const std::string& keep);
+    std::string GetEntryPathLocked(const SDerivedDataKey& key) const;
+    void TouchLocked(const std::string& name, const std::string& path);
+    void DropLocked(const std::string& name, const std::string& path);
+    void RecordLocked(const SDerivedDataKey& key, const std::function<void(SKindStats&)>& update);
+
+    std::mutex m_mutex;
+    std::string m_root;
+    bool m_rootSet = false;         // Explicit root: no FFPath default
+    bool m_indexed = false;
+    bool m_enabled = true;
+    uint64_t m_sizeLimit = kDefaultDerivedDataSizeLimit;
+    uint64_t m_totalBytes = 0;
+    uint64_t m_clock = 0;
+    uint64_t m_tempCounter = 0;
+    std::unordered_map<std::string, SEntry> m_entries;     // "<kind>/<hex>"
+    SStats m_stats;
+};
@@ -1,5 +1,6 @@
 #include "KTXExporter.h"
 #include "Core/FFLog.h"
+#include "Core/Loader/TextureLoader.h"
 #include "RHI/RHIManager.h"
 #include "RHI/RHIDescriptors.h"
 #include "RHI/ICommandList.h"
@@ -27,6 +28,20 @@ static uint32_t RHIFormatToVkFormat(ETextureFormat format) {
             return 43;  // VK_FORMAT_R8G8B8A8_SRGB
         case ETextureFormat::R16G16_FLOAT:
             return 83;  // VK_FORMAT_R16G16_SFLOAT (for BRDF LUT)
+        case ETextureFormat::BC1_UNORM:
+            return 133; // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case ETextureFormat::BC1_UNORM_SRGB:
+            return 134; // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        case ETextureFormat::BC3_UNORM:
+            return 137; // VK_FORMAT_BC3_UNORM_BLOCK
+        case ETextureFormat::BC3_UNORM_SRGB:
+            return 138; // VK_FORMAT_BC3_SRGB_BLOCK
+        case ETextureFormat::BC5_UNORM:
+            return 141; // VK_FORMAT_BC5_UNORM_BLOCK
+        case ETextureFormat::BC7_UNORM:
+            return 145; // VK_FORMAT_BC7_UNORM_BLOCK
+        case ETextureFormat::BC7_UNORM_SRGB:
+            return 146; // VK_FORMAT_BC7_SRGB_BLOCK
         default:
             CFFLog::Error("KTXExporter: Unsupported RHI format: %d", (int)format);
             return 0;
@@ -515,3 +530,150 @@ bool CKTXExporter::Export2DFromFloat3Buffer(
     CFFLog::Info("[KTXExporter] Exported float3 buffer to %s (%dx%d)", filepath.c_str(), width, height);
     return true;
 }
+
+bool CKTXExporter::Export2DFromFloat4Buffer(
+    const DirectX::XMFLOAT4* data,
+    int width,
+    int height,
+    const std::string& filepath)
+{
+    using namespace DirectX::PackedVector;
+
+    if (!data || width <= 0 || height <= 0) {
+        CFFLog::Error("[KTXExporter] Invalid input for Export2DFromFloat4Buffer");
+        return false;
+    }
+
+    // Ensure output directory exists
+    std::filesystem::path path(filepath);
+    std::filesystem::create_directories(path.parent_path());
+
+    // Create KTX texture (R16G16B16A16_FLOAT format)
+    ktxTextureCreateInfo createInfo = {};
+    createInfo.glInternalformat = 0;
+    createInfo.vkFormat = 97;  // VK_FORMAT_R16G16B16A16_SFLOAT
+    createInfo.baseWidth = width;
+    createInfo.baseHeight = height;
+    createInfo.baseDepth = 1;
+    createInfo.numDimensions = 2;
+    createInfo.numLevels = 1;
+    createInfo.numLayers = 1;
+    createInfo.numFaces = 1;
+    createInfo.isArray = KTX_FALSE;
+    createInfo.generateMipmaps = KTX_FALSE;
+
+    ktxTexture2* ktxTex = nullptr;
+    KTX_error_code result = ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &ktxTex);
+    if (result != KTX_SUCCESS) {
+        CFFLog::Error("[KTXExporter] Failed to create KTX texture: %d", result);
+        return false;
+    }
+
+    std::vector<XMHALF4> halfData(width * height);
+    for (int i = 0; i < width * height; ++i) {
+        halfData[i].x = XMConvertFloatToHalf(data[i].x);
+        halfData[i].y = XMConvertFloatToHalf(data[i].y);
+        halfData[i].z = XMConvertFloatToHalf(data[i].z);
+        halfData[i].w = XMConvertFloatToHalf(data[i].w);
+    }
+
+    result = ktxTexture_SetImageFromMemory(
+        ktxTexture(ktxTex),
+        0, 0, 0,
+        (const ktx_uint8_t*)halfData.data(),
+        halfData.size() * sizeof(XMHALF4)
+    );
+
+    if (result != KTX_SUCCESS) {
+        CFFLog::Error("[KTXExporter] Failed to set image data: %d", result);
+        ktxTexture2_Destroy(ktxTex);
+        return false;
+    }
+
+    // Write to file
+    result = ktxTexture_WriteToNamedFile(ktxTexture(ktxTex), filepath.c_str());
+    if (result != KTX_SUCCESS) {
+        CFFLog::Error("[KTXExporter] Failed to write KTX file: %d", result);
+        ktxTexture2_Destroy(ktxTex);
+        return false;
+    }
+
+    ktxTexture2_Destroy(ktxTex);
+    CFFLog::Info("[KTXExporter] Exported float4 buffer to %s (%dx%d)", filepath.c_str(), width, height);
+    return true;
+}
+
+bool CKTXExporter::Export2DFromDecoded(
+    const SDecodedTexture& texture,
+    const std::string& filepath)
+{
+    if (texture.mips.empty() || texture.generateMips) {
+        CFFLog::Error("[KTXExporter] Export2DFromDecoded needs every mip level: %s", filepath.c_str());
+        return false;
+    }
+
+    ktxTextureCreateInfo createInfo = {};
+    createInfo.glInternalformat = 0;
+    createInfo.vkFormat = RHIFormatToVkFormat(texture.format);
+    createInfo.baseWidth = texture.width;
+    createInfo.baseHeight = texture.height;
+    createInfo.baseDepth = 1;
+    createInfo.numDimensions = 2;
+    createInfo.numLevels = (ktx_uint32_t)texture.mips.size();
+    createInfo.numLayers = 1;
+    createInfo.numFaces = 1;
+    createInfo.isArray = KTX_FALSE;
+    createInfo.generateMipmaps = KTX_FALSE;
+
+    if (createInfo.vkFormat == 0) {
+        return false;
+    }
+
+    ktxTexture2* ktxTex = nullptr;
+    KTX_error_code result = ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &ktxTex);
+    if (result != KTX_SUCCESS) {
+        CFFLog::Error("[KTXExporter] Failed to create KTX texture: %d", result);
+        return false;
+    }
+
+    // Mips are stored tightly packed (row pitch = bytes per row / row of blocks)
+    for (uint32_t mip = 0; mip < createInfo.numLevels; ++mip) {
+        size_t size = ktxTexture_GetImageSize(ktxTexture(ktxTex), mip);
+        size_t offset = texture.mips[mip].offset;
+        if (offset + size > texture.data.size()) {
+            CFFLog::Error("[KTXExporter] Mip %u is truncated: %s", mip, filepath.c_str());
+            ktxTexture2_Destroy(ktxTex);
+            return false;
+        }
+        result = ktxTexture_SetImageFromMemory(ktxTexture(ktxTex), mip, 0, 0,
+                                               texture.data.data() + offset, size);
+        if (result != KTX_SUCCESS) {
+            CFFLog::Error("[KTXExporter] Failed to set mip %u data: %d", mip, result);
+            ktxTexture2_Destroy(ktxTex);
+            return false;
+        }
+    }
+
+    // Write next to the target and rename, so readers never see a partial file
+    std::error_code ec;
+    std::filesystem::path target(filepath);
+    std::filesystem::create_directories(target.parent_path(), ec);
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+
+    result = ktxTexture_WriteToNamedFile(ktxTexture(ktxTex), temp.string().c_str());
+    ktxTexture2_Destroy(ktxTex);
+    if (result != KTX_SUCCESS) {
+        CFFLog::Error("[KTXExporter] Failed to write KTX file: %d", result);
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        CFFLog::Error("[KTXExporter] Failed to replace %s: %s", filepath.c_str(), ec.message().c_str());
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
@@ -5,6 +5,8 @@
 #include <vector>
 #include <DirectXMath.h>
 
+struct SDecodedTexture;
+
 // Helper class to export textures to KTX2 format
 class CKTXExporter {
 public:
@@ -52,4 +54,19 @@ public:
         int height,
         const std::string& filepath
     );
+
+    // Export CPU 2D RGBA float buffer to KTX2 file (R16G16B16A16_FLOAT, alpha kept)
+    static bool Export2DFromFloat4Buffer(
+        const DirectX::XMFLOAT4* data,
+        int width,
+        int height,
+        const std::string& filepath
+    );
+
+    // Export CPU texture data with all its mips (RGBA8 or BC, see TextureCooker.h).
+    // Written to a temporary file first, so readers never see a partial file.
+    static bool Export2DFromDecoded(
+        const SDecodedTexture& texture,
+        const std::string& filepath
+    );
 };
@@ -1,8 +1,18 @@
 #pragma once
 #include "RHI/RHIResources.h"
+#include "PackedVertex.h"
 #include <DirectXMath.h>
 #include <memory>
 #include <cstdint>
+#include <vector>
+
+// Index range of one simplified level inside the mesh's index buffer.
+// error is the geometric deviation from LOD0 in mesh units (see MeshSimplifier.h).
+struct SGpuMeshLod {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f;
+};
 
 // RAII wrapper for GPU mesh resources
 // Automatically releases GPU resources when destroyed
@@ -10,15 +20,60 @@
 //       Textures and materials are managed separately by TextureManager and MaterialManager.
 class GpuMeshResource {
 public:
+    // Full layout: vbo holds interleaved SVertexPNT.
+    // Packed layout: positionVbo holds SPackedPosition, vbo holds SPackedAttributes.
     std::unique_ptr<RHI::IBuffer> vbo;
+    std::unique_ptr<RHI::IBuffer> positionVbo;
     std::unique_ptr<RHI::IBuffer> ibo;
     uint32_t indexCount = 0;
+    RHI::EIndexFormat indexFormat = RHI::EIndexFormat::UInt32;   // UInt16 when vertexCount allows
+    uint32_t vertexCount = 0;
+    EVertexLayout layout = EVertexLayout::Full;
+
+    // LOD1..N, stored in ibo after the LOD0 range [0, indexCount); empty = no LODs.
+    // All levels share the vertex buffers.
+    std::vector<SGpuMeshLod> lods;
+
+    // Position in the source file's sub-mesh list (GetOrLoad order, ray tracing cache key)
+    uint32_t subMeshIndex = 0;
 
     // Local space AABB (computed once at load time, shared by all instances)
     DirectX::XMFLOAT3 localBoundsMin{-0.5f, -0.5f, -0.5f};
     DirectX::XMFLOAT3 localBoundsMax{ 0.5f,  0.5f,  0.5f};
     bool hasBounds = false;
 
+    // Stream read by position-only passes (depth pre-pass, shadows)
+    RHI::IBuffer* GetPositionBuffer() const {
+        return layout == EVertexLayout::Packed ? positionVbo.get() : vbo.get();
+    }
+    uint32_t GetPositionStride() const {
+        return layout == EVertexLayout::Packed ? sizeof(SPackedPosition) : sizeof(SVertexPNT);
+    }
+    uint32_t GetAttributeStride() const {
+        return layout == EVertexLayout::Packed ? sizeof(SPackedAttributes) : sizeof(SVertexPNT);
+    }
+    size_t GetIndexBytes() const {
+        size_t count = indexCount;
+        for (const SGpuMeshLod& lod : lods) count += lod.indexCount;
+        return count * (indexFormat == RHI::EIndexFormat::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t));
+    }
+
+    uint32_t GetLodCount() const { return 1 + (uint32_t)lods.size(); }
+    SGpuMeshLod GetLod(uint32_t lod) const {
+        if (lod == 0 || lod > lods.size()) return SGpuMeshLod{0, indexCount, 0.0f};
+        return lods[lod - 1];
+    }
+    // Coarsest level whose error stays within maxError (mesh units); 0 = full detail
+    uint32_t SelectLod(float maxError) const {
+        uint32_t selected = 0;
+        for (uint32_t i = 0; i < lods.size() && lods[i].error <= maxError; i++) selected = i + 1;
+        return selected;
+    }
+    size_t GetVertexBytes() const {
+        return (size_t)vertexCount * (layout == EVertexLayout::Packed
+            ? sizeof(SPackedPosition) + sizeof(SPackedAttributes) : sizeof(SVertexPNT));
+    }
+
     GpuMeshResource() = default;
     ~GpuMeshResource() = default;
 
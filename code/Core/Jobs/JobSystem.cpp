@@ -0,0 +1,335 @@
+#include "JobSystem.h"
+#include "Core/FFLog.h"
+#include <algorithm>
+
+// Index of the worker that owns the current thread (0 = main / external thread)
+static thread_local uint32_t s_workerIndex = 0;
+
+// ============================================
+// CWorkStealingQueue
+// ============================================
+
+void CWorkStealingQueue::Push(SJob&& job)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(std::move(job));
+}
+
+bool CWorkStealingQueue::Pop(SJob& outJob)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_jobs.empty()) {
+        return false;
+    }
+    outJob = std::move(m_jobs.back());
+    m_jobs.pop_back();
+    return true;
+}
+
+bool CWorkStealingQueue::Steal(SJob& outJob)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_jobs.empty()) {
+        return false;
+    }
+    outJob = std::move(m_jobs.front());
+    m_jobs.pop_front();
+    return true;
+}
+
+size_t CWorkStealingQueue::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_jobs.size();
+}
+
+// ============================================
+// Lifecycle
+// ============================================
+
+CJobSystem& CJobSystem::Instance()
+{
+    static CJobSystem instance;
+    return instance;
+}
+
+CJobSystem::~CJobSystem()
+{
+    Shutdown();
+}
+
+void CJobSystem::Initialize(uint32_t workerThreadCount)
+{
+    if (m_initialized) {
+        CFFLog::Warning("[JobSystem] Already initialized, restarting...");
+        Shutdown();
+    }
+
+    if (workerThreadCount == 0) {
+        uint32_t hw = std::thread::hardware_concurrency();
+        workerThreadCount = (hw > 1) ? hw - 1 : 1;
+    }
+
+    m_stop = false;
+    m_queuedJobs = 0;
+
+    // Slot 0 = main thread, 1..N = worker threads
+    m_queues.clear();
+    for (uint32_t i = 0; i < workerThreadCount + 1; i++) {
+        m_queues.push_back(std::make_unique<CWorkStealingQueue>());
+    }
+
+    m_initialized = true;
+
+    m_threads.reserve(workerThreadCount);
+    for (uint32_t i = 1; i <= workerThreadCount; i++) {
+        m_threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    CFFLog::Info("[JobSystem] Initialized: %u worker threads (+ main thread)", workerThreadCount);
+}
+
+void CJobSystem::Shutdown()
+{
+    if (!m_initialized) {
+        return;
+    }
+
+    // Run anything still queued so counters held by callers reach zero
+    while (tryExecuteOne(GetCurrentWorkerIndex())) {
+    }
+
+    m_stop = true;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& t : m_threads) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+    m_threads.clear();
+    m_queues.clear();
+    m_initialized = false;
+}
+
+uint32_t CJobSystem::GetCurrentWorkerIndex()
+{
+    return s_workerIndex;
+}
+
+// ============================================
+// Job submission
+// ============================================
+
+void CJobSystem::Run(std::function<void()> func, CJobCounter* counter)
+{
+    if (counter) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SJob job;
+    job.func = std::move(func);
+    job.counter = counter;
+
+    if (!m_initialized) {
+        execute(job);
+        return;
+    }
+
+    enqueue(std::move(job));
+}
+
+void CJobSystem::RunAfter(CJobCounter& dependency, std::function<void()> func, CJobCounter* counter)
+{
+    if (counter) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SJob job;
+    job.func = std::move(func);
+    job.counter = counter;
+
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_continuationMutex);
+        if (dependency.m_pending.load(std::memory_order_acquire) != 0) {
+            dependency.m_continuations.push_back(std::move(job));
+            return;
+        }
+    }
+
+    // Dependency already satisfied
+    if (!m_initialized) {
+        execute(job);
+    } else {
+        enqueue(std::move(job));
+    }
+}
+
+void CJobSystem::Wait(CJobCounter& counter)
+{
+    uint32_t workerIndex = GetCurrentWorkerIndex();
+    while (!counter.IsDone()) {
+        if (!m_initialized || !tryExecuteOne(workerIndex)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool CJobSystem::TryExecuteOne()
+{
+    return m_initialized && tryExecuteOne(GetCurrentWorkerIndex());
+}
+
+void CJobSystem::ParallelFor(uint32_t count, uint32_t grainSize,
+                             const std::function<void(uint32_t begin, uint32_t end)>& func)
+{
+    if (count == 0) {
+        return;
+    }
+
+    if (grainSize == 0) {
+        uint32_t chunks = std::max(1u, GetThreadCount() * 4);
+        grainSize = std::max(1u, (count + chunks - 1) / chunks);
+    }
+
+    // Small range or no workers: run inline
+    if (!m_initialized || count <= grainSize) {
+        func(0, count);
+        return;
+    }
+
+    CJobCounter counter;
+    for (uint32_t begin = 0; begin < count; begin += grainSize) {
+        uint32_t end = std::min(count, begin + grainSize);
+        Run([&func, begin, end]() { func(begin, end); }, &counter);
+    }
+    Wait(counter);
+}
+
+// ============================================
+// Statistics
+// ============================================
+
+CJobSystem::SStats CJobSystem::GetStats() const
+{
+    SStats stats;
+    stats.jobsExecuted = m_jobsExecuted.load(std::memory_order_relaxed);
+    stats.jobsStolen = m_jobsStolen.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void CJobSystem::ResetStats()
+{
+    m_jobsExecuted = 0;
+    m_jobsStolen = 0;
+}
+
+// ============================================
+// Internal
+// ============================================
+
+void CJobSystem::enqueue(SJob&& job)
+{
+    uint32_t workerIndex = GetCurrentWorkerIndex();
+    if (workerIndex >= m_queues.size()) {
+        workerIndex = 0;
+    }
+    m_queues[workerIndex]->Push(std::move(job));
+    m_queuedJobs.fetch_add(1, std::memory_order_release);
+
+    // Lock/unlock pairs with the predicate check in workerLoop (no lost wakeups)
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wakeCondition.notify_one();
+}
+
+bool CJobSystem::fetchJob(uint32_t workerIndex, SJob& outJob)
+{
+    const uint32_t queueCount = static_cast<uint32_t>(m_queues.size());
+    if (queueCount == 0) {
+        return false;
+    }
+
+    // Own queue first (LIFO)
+    if (workerIndex < queueCount && m_queues[workerIndex]->Pop(outJob)) {
+        m_queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    // Steal from the others (FIFO), starting at the next neighbour
+    for (uint32_t i = 1; i < queueCount; i++) {
+        uint32_t victim = (workerIndex + i) % queueCount;
+        if (m_queues[victim]->Steal(outJob)) {
+            m_queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+            m_jobsStolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CJobSystem::tryExecuteOne(uint32_t workerIndex)
+{
+    SJob job;
+    if (!fetchJob(workerIndex, job)) {
+        return false;
+    }
+    execute(job);
+    return true;
+}
+
+void CJobSystem::execute(SJob& job)
+{
+    if (job.func) {
+        job.func();
+    }
+    m_jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+    finishJob(job.counter);
+}
+
+void CJobSystem::finishJob(CJobCounter* counter)
+{
+    if (!counter) {
+        return;
+    }
+
+    // Decrement under the lock: a waiter that sees zero may destroy the counter right
+    // away, so the continuations must be swapped out before the count becomes visible,
+    // and the counter must not be touched after the lock is released.
+    std::vector<SJob> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_continuationMutex);
+        if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        continuations.swap(counter->m_continuations);
+    }
+    for (auto& job : continuations) {
+        if (m_initialized) {
+            enqueue(std::move(job));
+        } else {
+            execute(job);
+        }
+    }
+}
+
+void CJobSystem::workerLoop(uint32_t workerIndex)
+{
+    s_workerIndex = workerIndex;
+
+    while (!m_stop.load(std::memory_order_acquire)) {
+        if (tryExecuteOne(workerIndex)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeCondition.wait(lock, [this]() {
+            return m_stop.load(std::memory_order_acquire) ||
+                   m_queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
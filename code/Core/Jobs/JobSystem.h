@@ -0,0 +1,178 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ============================================
+// Job System - Work-stealing CPU job scheduler
+// ============================================
+//
+// Design:
+// - One deque per worker; the owner pushes/pops at the back (LIFO, cache-warm),
+//   idle workers steal from the front of other deques (FIFO, oldest/largest work)
+// - Slot 0 belongs to the main thread (and any non-worker thread that submits work)
+// - CJobCounter tracks outstanding jobs; Wait() helps execute jobs instead of blocking
+// - Dependencies: RunAfter() chains a job behind a counter (continuation)
+//
+// Usage:
+//   CJobCounter counter;
+//   CJobSystem::Instance().Run([]{ ... }, &counter);
+//   CJobSystem::Instance().Wait(counter);
+//
+//   CJobSystem::Instance().ParallelFor(count, 64, [&](uint32_t begin, uint32_t end) {
+//       for (uint32_t i = begin; i < end; i++) { ... }
+//   });
+//
+// If the system is not initialized, Run() executes the job inline on the caller.
+// ============================================
+
+class CJobCounter;
+
+struct SJob
+{
+    std::function<void()> func;
+    CJobCounter* counter = nullptr;  // Decremented after func returns (optional)
+};
+
+// ============================================
+// CJobCounter - Completion counter / dependency handle
+// ============================================
+class CJobCounter
+{
+public:
+    CJobCounter() = default;
+    CJobCounter(const CJobCounter&) = delete;
+    CJobCounter& operator=(const CJobCounter&) = delete;
+
+    // Once this returns true the counter is no longer touched by any worker and may be
+    // destroyed. The final decrement happens under m_continuationMutex, so acquiring it
+    // here waits for that worker to leave finishJob().
+    bool IsDone() const
+    {
+        if (m_pending.load(std::memory_order_acquire) != 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(m_continuationMutex);
+        return true;
+    }
+    int GetPending() const { return m_pending.load(std::memory_order_acquire); }
+
+private:
+    friend class CJobSystem;
+
+    std::atomic<int> m_pending{0};
+
+    // Guards m_continuations and the decrement of m_pending in finishJob().
+    // Jobs scheduled via RunAfter(), released when m_pending reaches zero
+    mutable std::mutex m_continuationMutex;
+    std::vector<SJob> m_continuations;
+};
+
+// ============================================
+// CWorkStealingQueue - Per-worker job deque
+// ============================================
+class CWorkStealingQueue
+{
+public:
+    void Push(SJob&& job);
+    bool Pop(SJob& outJob);    // Owner end (back)
+    bool Steal(SJob& outJob);  // Thief end (front)
+    size_t Size() const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::deque<SJob> m_jobs;
+};
+
+// ============================================
+// CJobSystem - Singleton scheduler
+// ============================================
+class CJobSystem
+{
+public:
+    static CJobSystem& Instance();
+
+    CJobSystem(const CJobSystem&) = delete;
+    CJobSystem& operator=(const CJobSystem&) = delete;
+
+    // Start worker threads
+    // workerThreadCount = 0: hardware_concurrency - 1 (main thread is also a worker)
+    void Initialize(uint32_t workerThreadCount = 0);
+
+    // Drain remaining jobs and join all worker threads
+    void Shutdown();
+
+    bool IsInitialized() const { return m_initialized; }
+
+    // Number of threads executing jobs (worker threads + main thread)
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_queues.size()); }
+
+    // 0 = main / external thread, 1..N = worker threads
+    static uint32_t GetCurrentWorkerIndex();
+
+    // ============================================
+    // Job submission
+    // ============================================
+
+    // Schedule a job; counter (optional) is incremented now and decremented on completion
+    void Run(std::function<void()> func, CJobCounter* counter = nullptr);
+
+    // Schedule a job that starts only after 'dependency' reaches zero
+    void RunAfter(CJobCounter& dependency, std::function<void()> func, CJobCounter* counter = nullptr);
+
+    // Wait for counter to reach zero, executing other jobs meanwhile
+    void Wait(CJobCounter& counter);
+
+    // Execute one queued job on the calling thread; false if nothing was queued.
+    // For callers that wait manually (e.g. to report progress between jobs).
+    bool TryExecuteOne();
+
+    // Split [0, count) into chunks of grainSize and run them in parallel (blocking)
+    // grainSize = 0: pick a chunk size that gives ~4 chunks per thread
+    void ParallelFor(uint32_t count, uint32_t grainSize,
+                     const std::function<void(uint32_t begin, uint32_t end)>& func);
+
+    // ============================================
+    // Statistics
+    // ============================================
+    struct SStats
+    {
+        uint64_t jobsExecuted = 0;
+        uint64_t jobsStolen = 0;
+    };
+    SStats GetStats() const;
+    void ResetStats();
+
+private:
+    CJobSystem() = default;
+    ~CJobSystem();
+
+    void workerLoop(uint32_t workerIndex);
+    bool tryExecuteOne(uint32_t workerIndex);
+    bool fetchJob(uint32_t workerIndex, SJob& outJob);
+    void execute(SJob& job);
+    void enqueue(SJob&& job);
+    void finishJob(CJobCounter* counter);
+
+private:
+    std::atomic<bool> m_initialized{false};
+    std::atomic<bool> m_stop{false};
+
+    std::vector<std::unique_ptr<CWorkStealingQueue>> m_queues;  // [0] = main thread
+    std::vector<std::thread> m_threads;
+
+    // Sleep/wake for idle workers
+    std::atomic<int> m_queuedJobs{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeCondition;
+
+    // Stats
+    std::atomic<uint64_t> m_jobsExecuted{0};
+    std::atomic<uint64_t> m_jobsStolen{0};
+};
@@ -0,0 +1,260 @@
+#include "FFMeshLoader.h"
+#include "Core/FFLog.h"
+#include <algorithm>
+#include <cfloat>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    uint64_t alignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    void append(std::vector<uint8_t>& out, const void* data, size_t bytes)
+    {
+        const uint8_t* begin = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), begin, begin + bytes);
+    }
+
+    bool indicesInRange(const uint32_t* indices, uint32_t count, uint32_t vertexCount)
+    {
+        for (uint32_t i = 0; i < count; i++) {
+            if (indices[i] >= vertexCount) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool GetFFMeshSourceKey(const std::string& sourcePath, uint32_t importOptions, SFFMeshSourceKey& outKey)
+{
+    std::error_code ec;
+    std::filesystem::path path(sourcePath);
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+
+    outKey = SFFMeshSourceKey();
+    outKey.sourceMtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    outKey.sourceSize = static_cast<uint64_t>(size);
+    outKey.importOptions = importOptions;
+    return true;
+}
+
+void SerializeFFMesh(const SFFMeshSourceKey& key, const std::vector<const SMeshCPU_PNT*>& subMeshes,
+                     std::vector<uint8_t>& out)
+{
+    SFFMeshHeader header = {};
+    header.magic = FFMESH_MAGIC;
+    header.version = FFMESH_VERSION;
+    header.vertexStride = sizeof(SVertexPNT);
+    header.subMeshCount = static_cast<uint32_t>(subMeshes.size());
+    header.source = key;
+
+    std::vector<SFFMeshSubMesh> descs(subMeshes.size());
+    std::vector<SFFMeshLod> lods;
+    for (size_t i = 0; i < subMeshes.size(); i++) {
+        const SMeshCPU_PNT& mesh = *subMeshes[i];
+        SFFMeshSubMesh& desc = descs[i];
+        desc.firstVertex = static_cast<uint32_t>(header.vertexCount);
+        desc.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        desc.firstIndex = static_cast<uint32_t>(header.indexCount);
+        desc.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        desc.firstLod = static_cast<uint32_t>(lods.size());
+        desc.lodCount = static_cast<uint32_t>(mesh.lods.size());
+
+        uint32_t lodFirstIndex = desc.indexCount;
+        for (const SMeshLodCPU& lod : mesh.lods) {
+            SFFMeshLod entry = {};
+            entry.firstIndex = lodFirstIndex;
+            entry.indexCount = static_cast<uint32_t>(lod.indices.size());
+            entry.error = lod.error;
+            lods.push_back(entry);
+            lodFirstIndex += entry.indexCount;
+        }
+
+        float bmin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+        float bmax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+        for (const auto& v : mesh.vertices) {
+            bmin[0] = std::min(bmin[0], v.px); bmax[0] = std::max(bmax[0], v.px);
+            bmin[1] = std::min(bmin[1], v.py); bmax[1] = std::max(bmax[1], v.py);
+            bmin[2] = std::min(bmin[2], v.pz); bmax[2] = std::max(bmax[2], v.pz);
+        }
+        std::copy(bmin, bmin + 3, desc.boundsMin);
+        std::copy(bmax, bmax + 3, desc.boundsMax);
+
+        header.vertexCount += mesh.vertices.size();
+        header.indexCount += lodFirstIndex;
+    }
+
+    uint64_t subMeshOffset = sizeof(SFFMeshHeader);
+    header.lodCount = static_cast<uint32_t>(lods.size());
+    header.lodDataOffset = alignUp(subMeshOffset + descs.size() * sizeof(SFFMeshSubMesh), 16);
+    header.vertexDataOffset = alignUp(header.lodDataOffset + lods.size() * sizeof(SFFMeshLod), 16);
+    header.indexDataOffset = alignUp(header.vertexDataOffset + header.vertexCount * sizeof(SVertexPNT), 16);
+
+    out.clear();
+    out.reserve(header.indexDataOffset + header.indexCount * sizeof(uint32_t));
+    append(out, &header, sizeof(header));
+    append(out, descs.data(), descs.size() * sizeof(SFFMeshSubMesh));
+    out.resize(header.lodDataOffset, 0);
+    append(out, lods.data(), lods.size() * sizeof(SFFMeshLod));
+    out.resize(header.vertexDataOffset, 0);
+    for (const SMeshCPU_PNT* mesh : subMeshes) {
+        append(out, mesh->vertices.data(), mesh->vertices.size() * sizeof(SVertexPNT));
+    }
+    out.resize(header.indexDataOffset, 0);
+    for (const SMeshCPU_PNT* mesh : subMeshes) {
+        append(out, mesh->indices.data(), mesh->indices.size() * sizeof(uint32_t));
+        for (const SMeshLodCPU& lod : mesh->lods) {
+            append(out, lod.indices.data(), lod.indices.size() * sizeof(uint32_t));
+        }
+    }
+}
+
+bool WriteFFMesh(const std::string& path, const SFFMeshSourceKey& key,
+                 const std::vector<const SMeshCPU_PNT*>& subMeshes)
+{
+    std::vector<uint8_t> bytes;
+    SerializeFFMesh(key, subMeshes, bytes);
+
+    std::error_code ec;
+    std::filesystem::path target(path);
+    std::filesystem::create_directories(target.parent_path(), ec);
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            CFFLog::Error("[FFMesh] Failed to open for writing: %s", path.c_str());
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file.good()) {
+            CFFLog::Error("[FFMesh] Write failed: %s", path.c_str());
+            file.close();
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        CFFLog::Error("[FFMesh] Failed to replace %s: %s", path.c_str(), ec.message().c_str());
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+// ============================================
+// CFFMeshFile
+// ============================================
+
+bool CFFMeshFile::Open(const std::string& path)
+{
+    CMappedFile file;
+    if (!file.Open(path)) {
+        Close();
+        return false;
+    }
+    return Open(std::move(file), 0, path);
+}
+
+bool CFFMeshFile::Open(CMappedFile&& file, size_t offset, const std::string& name)
+{
+    Close();
+    m_file = std::move(file);
+    if (!m_file.IsOpen() || offset > m_file.Size()) {
+        Close();
+        return false;
+    }
+
+    const uint8_t* data = m_file.Data() + offset;
+    uint64_t size = m_file.Size() - offset;
+    if (size < sizeof(SFFMeshHeader)) {
+        Close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const SFFMeshHeader*>(data);
+    if (header->magic != FFMESH_MAGIC || header->version != FFMESH_VERSION ||
+        header->vertexStride != sizeof(SVertexPNT)) {
+        Close();
+        return false;   // Other format / older cooker: caller re-cooks
+    }
+
+    // Structure checks (sizes and ranges) plus index values: the DDC maps entries
+    // without hashing the payload, and the GPU upload trusts every index
+    uint64_t subMeshEnd = sizeof(SFFMeshHeader) + (uint64_t)header->subMeshCount * sizeof(SFFMeshSubMesh);
+    uint64_t lodEnd = header->lodDataOffset + (uint64_t)header->lodCount * sizeof(SFFMeshLod);
+    uint64_t vertexEnd = header->vertexDataOffset + header->vertexCount * sizeof(SVertexPNT);
+    uint64_t indexEnd = header->indexDataOffset + header->indexCount * sizeof(uint32_t);
+    if (subMeshEnd > size || header->lodDataOffset < subMeshEnd || lodEnd > size ||
+        header->vertexDataOffset < lodEnd || vertexEnd > size || header->lodDataOffset % 4 != 0 ||
+        header->indexDataOffset < vertexEnd || indexEnd > size ||
+        header->vertexDataOffset % 4 != 0 || header->indexDataOffset % 4 != 0) {
+        CFFLog::Warning("[FFMesh] Corrupt file: %s", name.c_str());
+        Close();
+        return false;
+    }
+
+    const auto* subMeshes = reinterpret_cast<const SFFMeshSubMesh*>(data + sizeof(SFFMeshHeader));
+    const auto* lods = reinterpret_cast<const SFFMeshLod*>(data + header->lodDataOffset);
+    const auto* indices = reinterpret_cast<const uint32_t*>(data + header->indexDataOffset);
+    for (uint32_t i = 0; i < header->subMeshCount; i++) {
+        const SFFMeshSubMesh& desc = subMeshes[i];
+        bool valid = (uint64_t)desc.firstVertex + desc.vertexCount <= header->vertexCount &&
+                     (uint64_t)desc.firstIndex + desc.indexCount <= header->indexCount &&
+                     (uint64_t)desc.firstLod + desc.lodCount <= header->lodCount;
+        for (uint32_t l = 0; valid && l < desc.lodCount; l++) {
+            const SFFMeshLod& lod = lods[desc.firstLod + l];
+            valid = (uint64_t)desc.firstIndex + lod.firstIndex + lod.indexCount <= header->indexCount;
+        }
+        valid = valid && indicesInRange(indices + desc.firstIndex, desc.indexCount, desc.vertexCount);
+        for (uint32_t l = 0; valid && l < desc.lodCount; l++) {
+            const SFFMeshLod& lod = lods[desc.firstLod + l];
+            valid = indicesInRange(indices + desc.firstIndex + lod.firstIndex, lod.indexCount, desc.vertexCount);
+        }
+        if (!valid) {
+            CFFLog::Warning("[FFMesh] Corrupt sub-mesh %u: %s", i, name.c_str());
+            Close();
+            return false;
+        }
+    }
+
+    m_header = header;
+    m_subMeshes = subMeshes;
+    m_lods = lods;
+    m_vertices = reinterpret_cast<const SVertexPNT*>(data + header->vertexDataOffset);
+    m_indices = indices;
+    return true;
+}
+
+void CFFMeshFile::Close()
+{
+    m_file.Close();
+    m_header = nullptr;
+    m_subMeshes = nullptr;
+    m_lods = nullptr;
+    m_vertices = nullptr;
+    m_indices = nullptr;
+}
+
+void CFFMeshFile::CopySubMesh(uint32_t i, SMeshCPU_PNT& out) const
+{
+    const SFFMeshSubMesh& desc = m_subMeshes[i];
+    out.vertices.assign(GetVertices(i), GetVertices(i) + desc.vertexCount);
+    out.indices.assign(GetIndices(i), GetIndices(i) + desc.indexCount);
+    out.lods.resize(desc.lodCount);
+    for (uint32_t l = 0; l < desc.lodCount; l++) {
+        const SFFMeshLod& lod = GetLod(i, l);
+        out.lods[l].indices.assign(GetIndices(i) + lod.firstIndex, GetIndices(i) + lod.firstIndex + lod.indexCount);
+        out.lods[l].error = lod.error;
+    }
+}
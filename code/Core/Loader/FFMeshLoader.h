@@ -0,0 +1,138 @@
+#pragma once
+#include "Mesh.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================
+// .ffmesh - cooked mesh, loaded with mmap
+// ============================================
+// Holds the final vertex / index streams as the importer produced them
+// (after recentering, tangents, lightmap UV2 and index / vertex reordering), so loading is a file
+// mapping and a GPU upload with no per-vertex work.
+//
+// Layout (native endianness, sections 16-byte aligned):
+//   SFFMeshHeader
+//   SFFMeshSubMesh[subMeshCount]
+//   SFFMeshLod[lodCount]         LOD1..N of every sub-mesh
+//   SVertexPNT[vertexCount]      all sub-meshes back to back
+//   uint32_t[indexCount]         relative to the sub-mesh's first vertex; per
+//                                sub-mesh the full mesh, then each LOD
+//
+// Imported meshes are cached as .ffmesh payloads in the derived-data cache
+// (see DerivedDataCache.h), keyed by source content and import settings.
+// The header also records the source size, mtime and import options, so a
+// standalone .ffmesh can be checked against its source.
+
+static const uint32_t FFMESH_MAGIC = 0x48534D46;   // "FMSH"
+static const uint32_t FFMESH_VERSION = 3;           // Bump when the cooked data changes
+
+// Import options that change the cooked data
+enum EFFMeshImportOptions : uint32_t {
+    FFMeshImport_None = 0,
+    FFMeshImport_LightmapUV2 = 1 << 0,
+    FFMeshImport_VertexCache = 1 << 1,      // See MeshOptimizer.h
+    FFMeshImport_Overdraw = 1 << 2,
+    FFMeshImport_VertexFetch = 1 << 3,
+    FFMeshImport_Lods = 1 << 4,             // See MeshSimplifier.h
+};
+
+struct SFFMeshSourceKey {
+    int64_t sourceMtime = 0;    // filesystem::last_write_time ticks
+    uint64_t sourceSize = 0;
+    uint32_t importOptions = 0;
+    uint32_t reserved = 0;
+
+    bool operator==(const SFFMeshSourceKey& o) const {
+        return sourceMtime == o.sourceMtime && sourceSize == o.sourceSize && importOptions == o.importOptions;
+    }
+};
+
+struct SFFMeshHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexStride;      // sizeof(SVertexPNT)
+    uint32_t subMeshCount;
+    uint64_t vertexDataOffset;
+    uint64_t indexDataOffset;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    SFFMeshSourceKey source;
+    uint64_t lodDataOffset;
+    uint32_t lodCount;
+    uint32_t reserved;
+};
+
+struct SFFMeshSubMesh {
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+    uint32_t firstIndex;
+    uint32_t indexCount;        // Full mesh (LOD0)
+    float boundsMin[3];
+    float boundsMax[3];
+    uint32_t firstLod;          // Into the LOD table
+    uint32_t lodCount;          // LOD1..N, 0 = none
+};
+
+struct SFFMeshLod {
+    uint32_t firstIndex;        // Relative to the sub-mesh's firstIndex
+    uint32_t indexCount;
+    float error;                // Mesh units, see SMeshLodCPU
+    uint32_t reserved;
+};
+
+static_assert(sizeof(SFFMeshHeader) == 88, "SFFMeshHeader layout is part of the file format");
+static_assert(sizeof(SFFMeshSubMesh) == 48, "SFFMeshSubMesh layout is part of the file format");
+static_assert(sizeof(SFFMeshLod) == 16, "SFFMeshLod layout is part of the file format");
+
+// Key of the source file as it is now; false if it does not exist
+bool GetFFMeshSourceKey(const std::string& sourcePath, uint32_t importOptions, SFFMeshSourceKey& outKey);
+
+// Sub-meshes as .ffmesh bytes
+void SerializeFFMesh(const SFFMeshSourceKey& key, const std::vector<const SMeshCPU_PNT*>& subMeshes,
+                     std::vector<uint8_t>& out);
+
+// Write sub-meshes to a .ffmesh (via a temporary file, so readers never see a partial file)
+bool WriteFFMesh(const std::string& path, const SFFMeshSourceKey& key,
+                 const std::vector<const SMeshCPU_PNT*>& subMeshes);
+
+// ============================================
+// CFFMeshFile - mapped .ffmesh (zero copy)
+// ============================================
+// Pointers returned by GetVertices / GetIndices point into the mapping and
+// stay valid while the file is open.
+class CFFMeshFile
+{
+public:
+    // Maps and validates the file structure
+    bool Open(const std::string& path);
+    // Takes over a mapping whose .ffmesh data starts at offset (e.g. a DDC entry);
+    // name is only used in warnings
+    bool Open(CMappedFile&& file, size_t offset, const std::string& name);
+    void Close();
+    bool IsOpen() const { return m_header != nullptr; }
+
+    const SFFMeshHeader& GetHeader() const { return *m_header; }
+    bool Matches(const SFFMeshSourceKey& key) const { return m_header && m_header->source == key; }
+
+    uint32_t GetSubMeshCount() const { return m_header ? m_header->subMeshCount : 0; }
+    const SFFMeshSubMesh& GetSubMesh(uint32_t i) const { return m_subMeshes[i]; }
+    const SVertexPNT* GetVertices(uint32_t i) const { return m_vertices + m_subMeshes[i].firstVertex; }
+    const uint32_t* GetIndices(uint32_t i) const { return m_indices + m_subMeshes[i].firstIndex; }
+    // LODs of sub-mesh i; their index ranges are relative to GetIndices(i)
+    uint32_t GetLodCount(uint32_t i) const { return m_subMeshes[i].lodCount; }
+    const SFFMeshLod& GetLod(uint32_t i, uint32_t lod) const { return m_lods[m_subMeshes[i].firstLod + lod]; }
+    size_t GetFileSize() const { return m_file.Size(); }
+
+    // Copy of one sub-mesh (for CPU consumers that need owned data)
+    void CopySubMesh(uint32_t i, SMeshCPU_PNT& out) const;
+
+private:
+    CMappedFile m_file;
+    const SFFMeshHeader* m_header = nullptr;
+    const SFFMeshSubMesh* m_subMeshes = nullptr;
+    const SFFMeshLod* m_lods = nullptr;
+    const SVertexPNT* m_vertices = nullptr;
+    const uint32_t* m_indices = nullptr;
+};
@@ -1,22 +1,122 @@
 #include "GltfLoader.h"
 #include "Core/FFLog.h"
+#include "Jobs/JobSystem.h"
 #include <DirectXMath.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
-#include <cassert>
-#include <iostream>
 #define CGLTF_IMPLEMENTATION
 #include "cgltf.h"
 
-// 读取 accessor 的一个元素（float/uint 等）成 float 或 index
-static bool ReadVec2(const cgltf_accessor* acc, size_t i, float out[2]){
-    return cgltf_accessor_read_float(acc, i, out, 2);
+using namespace DirectX;
+
+// ============================================
+// Accessor copies
+// ============================================
+// Attributes are copied a whole accessor at a time into the interleaved
+// SVertexPNT array: plain float data straight from the buffer (one memcpy per
+// element, or one for the accessor when both sides are tightly packed),
+// anything else (normalized integers, sparse or meshopt-compressed data)
+// through one cgltf_accessor_unpack_floats call.
+
+namespace
+{
+    struct SAccessorCounts {
+        uint32_t bulk = 0;
+        uint32_t converted = 0;
+    };
+
+    struct SPrimitiveRef {
+        const cgltf_primitive* prim = nullptr;
+        uint32_t meshIndex = 0;
+    };
 }
-static bool ReadVec3(const cgltf_accessor* acc, size_t i, float out[3]){
-    return cgltf_accessor_read_float(acc, i, out, 3);
+
+// Element data of an accessor that can be read in place; nullptr if it needs cgltf to decode
+static const uint8_t* AccessorData(const cgltf_accessor* acc) {
+    if (!acc || acc->is_sparse || !acc->buffer_view) return nullptr;
+    const cgltf_buffer_view* view = acc->buffer_view;
+    const uint8_t* base = nullptr;
+    if (view->data) {
+        base = static_cast<const uint8_t*>(view->data);     // Decompressed (EXT_meshopt_compression)
+    } else if (!view->has_meshopt_compression && view->buffer && view->buffer->data) {
+        base = static_cast<const uint8_t*>(view->buffer->data) + view->offset;
+    }
+    return base ? base + acc->offset : nullptr;
 }
-static uint32_t ReadIndex(const cgltf_accessor* acc, size_t i){
-    cgltf_uint idx = cgltf_accessor_read_index(acc, i);
-    return (uint32_t)idx;
+
+// Up to comps floats per element into dst, dstStride bytes apart
+static bool CopyFloats(const cgltf_accessor* acc, size_t count, uint32_t comps,
+                       float* dst, size_t dstStride, SAccessorCounts& counts) {
+    const uint32_t accComps = (uint32_t)cgltf_num_components(acc->type);
+    comps = std::min(comps, accComps);
+    count = std::min(count, (size_t)acc->count);
+    const size_t bytes = comps * sizeof(float);
+    uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+
+    const uint8_t* src = AccessorData(acc);
+    if (src && acc->component_type == cgltf_component_type_r_32f && !acc->normalized) {
+        if (acc->stride == bytes && dstStride == bytes) {
+            memcpy(out, src, count * bytes);
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                memcpy(out + i * dstStride, src + i * acc->stride, bytes);
+            }
+        }
+        counts.bulk++;
+        return true;
+    }
+
+    std::vector<float> unpacked((size_t)acc->count * accComps);
+    if (cgltf_accessor_unpack_floats(acc, unpacked.data(), unpacked.size()) < unpacked.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        memcpy(out + i * dstStride, &unpacked[i * accComps], bytes);
+    }
+    counts.converted++;
+    return true;
+}
+
+template<class T>
+static void WidenIndices(const uint8_t* src, size_t stride, size_t count, uint32_t* dst) {
+    for (size_t i = 0; i < count; i++) {
+        T value;
+        memcpy(&value, src + i * stride, sizeof(T));
+        dst[i] = value;
+    }
+}
+
+static void CopyIndices(const cgltf_accessor* acc, uint32_t* dst, SAccessorCounts& counts) {
+    const size_t count = acc->count;
+    const uint8_t* src = AccessorData(acc);
+    if (src) {
+        switch (acc->component_type) {
+        case cgltf_component_type_r_32u:
+            if (acc->stride == sizeof(uint32_t)) {
+                memcpy(dst, src, count * sizeof(uint32_t));
+            } else {
+                WidenIndices<uint32_t>(src, acc->stride, count, dst);
+            }
+            counts.bulk++;
+            return;
+        case cgltf_component_type_r_16u:
+            WidenIndices<uint16_t>(src, acc->stride, count, dst);
+            counts.bulk++;
+            return;
+        case cgltf_component_type_r_8u:
+            WidenIndices<uint8_t>(src, acc->stride, count, dst);
+            counts.bulk++;
+            return;
+        default:
+            break;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = (uint32_t)cgltf_accessor_read_index(acc, i);
+    }
+    counts.converted++;
 }
 
 static std::string DirOf(const std::string& p){
@@ -34,10 +134,46 @@ static void ApplyFlipLH(SVertexPNT& v){
     // handedness 不变；如果你发现法线贴图方向不对，可在 shader 里翻 normal.y
 }
 
-static void AppendPrimitive(const cgltf_primitive* prim,
-                            const std::string& baseDir,
-                            bool flipZ, bool flipWinding,
-                            SGltfMeshCPU& out)
+static const cgltf_accessor* FindPositions(const cgltf_primitive* prim) {
+    for (size_t a = 0; a < prim->attributes_count; ++a) {
+        if (prim->attributes[a].type == cgltf_attribute_type_position) return prim->attributes[a].data;
+    }
+    return nullptr;
+}
+
+// Same test with and without geometry, so primitive ranges never depend on the buffers
+static bool KeepPrimitive(const cgltf_primitive* prim) {
+    const cgltf_accessor* pos = FindPositions(prim);
+    return prim->type == cgltf_primitive_type_triangles && pos && pos->count > 0;
+}
+
+static void ReadTextures(const cgltf_material* mat, const std::string& baseDir, GltfTextures& out) {
+    // 贴图路径（baseColor / normal / metallicRoughness）
+    if (!mat) return;
+    // baseColor
+    if (mat->pbr_metallic_roughness.base_color_texture.texture &&
+        mat->pbr_metallic_roughness.base_color_texture.texture->image &&
+        mat->pbr_metallic_roughness.base_color_texture.texture->image->uri){
+        out.baseColorPath = Join(baseDir, mat->pbr_metallic_roughness.base_color_texture.texture->image->uri);
+    }
+    // normal
+    if (mat->normal_texture.texture &&
+        mat->normal_texture.texture->image &&
+        mat->normal_texture.texture->image->uri){
+        out.normalPath = Join(baseDir, mat->normal_texture.texture->image->uri);
+    }
+    // metallic-roughness (glTF 2.0 standard: G=Roughness, B=Metallic)
+    if (mat->pbr_metallic_roughness.metallic_roughness_texture.texture &&
+        mat->pbr_metallic_roughness.metallic_roughness_texture.texture->image &&
+        mat->pbr_metallic_roughness.metallic_roughness_texture.texture->image->uri){
+        out.metallicRoughnessPath = Join(baseDir, mat->pbr_metallic_roughness.metallic_roughness_texture.texture->image->uri);
+    }
+}
+
+static bool ReadPrimitive(const cgltf_primitive* prim,
+                          const std::string& baseDir,
+                          bool flipZ, bool flipWinding,
+                          SGltfMeshCPU& out, SAccessorCounts& counts)
 {
     // --- attributes ---
     const cgltf_accessor* acc_pos = nullptr;
@@ -46,22 +182,6 @@ static void AppendPrimitive(const cgltf_primitive* prim,
     const cgltf_accessor* acc_tan = nullptr;
     const cgltf_accessor* acc_col = nullptr;
 
-    // Debug: Print all attributes to check for vertex colors
-    for (size_t a=0;a<prim->attributes_count;++a){
-        auto& att = prim->attributes[a];
-        const char* typeName = "UNKNOWN";
-        switch(att.type){
-            case cgltf_attribute_type_position: typeName = "POSITION"; break;
-            case cgltf_attribute_type_normal: typeName = "NORMAL"; break;
-            case cgltf_attribute_type_texcoord: typeName = "TEXCOORD"; break;
-            case cgltf_attribute_type_tangent: typeName = "TANGENT"; break;
-            case cgltf_attribute_type_color: typeName = "COLOR"; break;
-            case cgltf_attribute_type_joints: typeName = "JOINTS"; break;
-            case cgltf_attribute_type_weights: typeName = "WEIGHTS"; break;
-            default: break;
-        }
-    }
-
     for (size_t a=0;a<prim->attributes_count;++a){
         auto& att = prim->attributes[a];
         switch(att.type){
@@ -73,90 +193,220 @@ static void AppendPrimitive(const cgltf_primitive* prim,
             default: break;
         }
     }
-    if (!acc_pos) return;
-
-    size_t vcount = acc_pos->count;
-    size_t icount = prim->indices ? prim->indices->count : 0;
-
-    // 读取顶点
-    std::vector<SVertexPNT> verts(vcount);
-    for (size_t i=0;i<vcount;++i){
-        float p[3]={0}, n[3]={0}, uv[2]={0}, t[4]={0,0,0,1}, c[4]={1,1,1,1};
-        ReadVec3(acc_pos, i, p);
-        if (acc_nrm) ReadVec3(acc_nrm, i, n);
-        if (acc_uv0) ReadVec2(acc_uv0, i, uv);
-        if (acc_tan) cgltf_accessor_read_float(acc_tan, i, t, 4);
-        if (acc_col) {
-            // glTF COLOR_0 can be VEC3 or VEC4
-            if (acc_col->type == cgltf_type_vec4) {
-                cgltf_accessor_read_float(acc_col, i, c, 4);
-            } else if (acc_col->type == cgltf_type_vec3) {
-                cgltf_accessor_read_float(acc_col, i, c, 3);
-                c[3] = 1.0f;  // Default alpha
-            }
-        }
 
-        SVertexPNT v{};
-        v.px=p[0]; v.py=p[1]; v.pz=p[2];
-        v.nx=n[0]; v.ny=n[1]; v.nz=n[2];
-        v.u=uv[0]; v.v=uv[1];
-        v.tx=t[0]; v.ty=t[1]; v.tz=t[2]; v.tw=t[3]; // 若 glTF 带切线，直接拿来用
-        v.r=c[0]; v.g=c[1]; v.b=c[2]; v.a=c[3];     // Vertex color (default white if not present)
-        v.u2=0.0f; v.v2=0.0f;  // UV2 for lightmap (default 0, set by lightmap baker)
+    const size_t vcount = acc_pos->count;
+
+    // 读取顶点：缺省值（切线 w = 1，顶点色白色，UV2 由 lightmap 流程生成）
+    SVertexPNT defaults{};
+    defaults.tw = 1.0f;
+    defaults.r = defaults.g = defaults.b = defaults.a = 1.0f;
+    std::vector<SVertexPNT> verts(vcount, defaults);
+
+    const size_t stride = sizeof(SVertexPNT);
+    bool ok = CopyFloats(acc_pos, vcount, 3, &verts[0].px, stride, counts);
+    if (acc_nrm) ok = ok && CopyFloats(acc_nrm, vcount, 3, &verts[0].nx, stride, counts);
+    if (acc_uv0) ok = ok && CopyFloats(acc_uv0, vcount, 2, &verts[0].u, stride, counts);
+    if (acc_tan) ok = ok && CopyFloats(acc_tan, vcount, 4, &verts[0].tx, stride, counts);
+    if (acc_col) ok = ok && CopyFloats(acc_col, vcount, 4, &verts[0].r, stride, counts);   // VEC3 keeps alpha 1
+    if (!ok) return false;
 
-        if (flipZ) ApplyFlipLH(v);
-        verts[i]=v;
+    if (flipZ) {
+        for (SVertexPNT& v : verts) ApplyFlipLH(v);
     }
 
-    // 读取索引
+    // 读取索引（无索引则按三角列表生成）
     std::vector<uint32_t> indices;
-    if (icount>0){
-        indices.resize(icount);
-        for (size_t i=0;i<icount;++i) indices[i] = ReadIndex(prim->indices, i);
-        if (flipWinding){
-            for (size_t i=0;i+2<indices.size(); i+=3) std::swap(indices[i+1], indices[i+2]);
+    if (prim->indices){
+        indices.resize(prim->indices->count);
+        CopyIndices(prim->indices, indices.data(), counts);
+        for (uint32_t index : indices) {
+            if (index >= vcount) return false;
         }
     } else {
-        // 无索引，转三角列表
-        assert(prim->type == cgltf_primitive_type_triangles);
         indices.resize(vcount);
         for (uint32_t i=0;i<vcount;++i) indices[i]=i;
-        if (flipWinding){
-            for (size_t i=0;i+2<indices.size(); i+=3) std::swap(indices[i+1], indices[i+2]);
-        }
     }
-
-    // 贴图路径（只取 baseColor/normal）
-    if (prim->material){
-        auto* mat = prim->material;
-        // baseColor
-        if (mat->pbr_metallic_roughness.base_color_texture.texture &&
-            mat->pbr_metallic_roughness.base_color_texture.texture->image &&
-            mat->pbr_metallic_roughness.base_color_texture.texture->image->uri){
-            out.textures.baseColorPath = Join(baseDir, mat->pbr_metallic_roughness.base_color_texture.texture->image->uri);
-        }
-        // normal
-        if (mat->normal_texture.texture &&
-            mat->normal_texture.texture->image &&
-            mat->normal_texture.texture->image->uri){
-            out.textures.normalPath = Join(baseDir, mat->normal_texture.texture->image->uri);
-        }
-        // metallic-roughness (glTF 2.0 standard: G=Roughness, B=Metallic)
-        if (mat->pbr_metallic_roughness.metallic_roughness_texture.texture &&
-            mat->pbr_metallic_roughness.metallic_roughness_texture.texture->image &&
-            mat->pbr_metallic_roughness.metallic_roughness_texture.texture->image->uri){
-            out.textures.metallicRoughnessPath = Join(baseDir, mat->pbr_metallic_roughness.metallic_roughness_texture.texture->image->uri);
-        }
+    indices.resize(indices.size() / 3 * 3);
+    if (flipWinding){
+        for (size_t i=0;i+2<indices.size(); i+=3) std::swap(indices[i+1], indices[i+2]);
     }
 
+    ReadTextures(prim->material, baseDir, out.textures);
+
     out.mesh.vertices = std::move(verts);
     out.mesh.indices  = std::move(indices);
 
     // 若 glTF 没有 TANGENT（很常见），用你现有函数生成
-    bool has_tangent = (acc_tan != nullptr);
-    if (!has_tangent) {
+    if (!acc_tan) {
         ComputeTangents(out.mesh.vertices, out.mesh.indices);
     }
+    return true;
+}
+
+// ============================================
+// Nodes
+// ============================================
+// Right- to left-handed is the reflection S = diag(1, 1, -1) applied on both
+// sides of every local matrix (S * M * S), which keeps TRS form:
+// translation.z and the quaternion's x / y change sign, scale is unchanged.
+
+static void ReadNodeTransform(const cgltf_node* node, bool flipZ, SGltfNode& out) {
+    if (node->has_matrix) {
+        // Column-major column-vector matrix = row-major row-vector matrix
+        XMFLOAT4X4 m;
+        memcpy(m.m, node->matrix, sizeof(m.m));
+        if (flipZ) {
+            for (int r = 0; r < 4; r++) {
+                for (int c = 0; c < 4; c++) {
+                    if ((r == 2) != (c == 2)) m.m[r][c] = -m.m[r][c];
+                }
+            }
+        }
+        XMVECTOR s, q, t;
+        if (XMMatrixDecompose(&s, &q, &t, XMLoadFloat4x4(&m))) {
+            XMStoreFloat3(&out.scale, s);
+            XMStoreFloat4(&out.rotation, q);
+            XMStoreFloat3(&out.translation, t);
+        } else {
+            CFFLog::Warning("[GltfLoader] Node '%s': matrix is not a TRS, using identity",
+                            node->name ? node->name : "");
+        }
+        return;
+    }
+
+    if (node->has_translation) out.translation = XMFLOAT3(node->translation[0], node->translation[1], node->translation[2]);
+    if (node->has_rotation) out.rotation = XMFLOAT4(node->rotation[0], node->rotation[1], node->rotation[2], node->rotation[3]);
+    if (node->has_scale) out.scale = XMFLOAT3(node->scale[0], node->scale[1], node->scale[2]);
+    if (flipZ) {
+        out.translation.z = -out.translation.z;
+        out.rotation.x = -out.rotation.x;
+        out.rotation.y = -out.rotation.y;
+    }
+}
+
+// Depth-first from the default scene's roots (every parentless node if the
+// file has no scene), so parents always precede their children
+static void ReadNodes(const cgltf_data* data, bool flipZ, std::vector<SGltfNode>& outNodes) {
+    std::vector<int> remap(data->nodes_count, -1);
+    std::vector<const cgltf_node*> stack;
+
+    const cgltf_scene* scene = data->scene ? data->scene : (data->scenes_count > 0 ? &data->scenes[0] : nullptr);
+    if (scene) {
+        for (size_t i = scene->nodes_count; i-- > 0;) stack.push_back(scene->nodes[i]);
+    } else {
+        for (size_t i = data->nodes_count; i-- > 0;) {
+            if (!data->nodes[i].parent) stack.push_back(&data->nodes[i]);
+        }
+    }
+
+    while (!stack.empty()) {
+        const cgltf_node* node = stack.back();
+        stack.pop_back();
+        size_t index = node - data->nodes;
+        if (remap[index] >= 0) continue;    // Listed twice (invalid file)
+        remap[index] = (int)outNodes.size();
+
+        SGltfNode n;
+        n.name = node->name ? node->name : "";
+        n.parent = node->parent ? remap[node->parent - data->nodes] : -1;
+        n.mesh = node->mesh ? (int)(node->mesh - data->meshes) : -1;
+        ReadNodeTransform(node, flipZ, n);
+        outNodes.push_back(std::move(n));
+
+        for (size_t c = node->children_count; c-- > 0;) stack.push_back(node->children[c]);
+    }
+}
+
+// ============================================
+// Entry points
+// ============================================
+
+static double MillisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+bool LoadGLTFScene(const std::string& gltfPath, SGltfSceneCPU& outScene,
+                   const SGltfLoadOptions& options, SGltfLoadStats* outStats)
+{
+    outScene = SGltfSceneCPU();
+    SGltfLoadStats stats;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    cgltf_options opt{}; cgltf_data* data=nullptr;
+    if (cgltf_parse_file(&opt, gltfPath.c_str(), &data) != cgltf_result_success) return false;
+    if (options.loadGeometry && cgltf_load_buffers(&opt, data, gltfPath.c_str()) != cgltf_result_success){
+        cgltf_free(data);
+        return false;
+    }
+    stats.parseMs = MillisecondsSince(start);
+
+    // Mesh → primitive ranges
+    std::vector<SPrimitiveRef> refs;
+    outScene.meshes.resize(data->meshes_count);
+    for (size_t mi=0; mi<data->meshes_count; ++mi){
+        const cgltf_mesh& mesh = data->meshes[mi];
+        SGltfMeshRange& range = outScene.meshes[mi];
+        range.name = mesh.name ? mesh.name : "";
+        range.firstPrimitive = (uint32_t)refs.size();
+        for (size_t pi=0; pi<mesh.primitives_count; ++pi){
+            if (KeepPrimitive(&mesh.primitives[pi])) {
+                refs.push_back({&mesh.primitives[pi], (uint32_t)mi});
+            } else {
+                CFFLog::Warning("[GltfLoader] %s: mesh %zu primitive %zu skipped (no positions or not triangles)",
+                                gltfPath.c_str(), mi, pi);
+            }
+        }
+        range.primitiveCount = (uint32_t)refs.size() - range.firstPrimitive;
+    }
+
+    ReadNodes(data, options.flipZ_to_LH, outScene.nodes);
+
+    bool ok = true;
+    if (options.loadGeometry) {
+        // Primitives are independent: copies and tangents run one primitive per job
+        start = std::chrono::high_resolution_clock::now();
+        std::string baseDir = DirOf(gltfPath);
+        const uint32_t count = (uint32_t)refs.size();
+        outScene.primitives.resize(count);
+        std::vector<SAccessorCounts> counts(count);
+        std::vector<uint8_t> read(count, 0);
+
+        auto readRange = [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                SGltfMeshCPU& out = outScene.primitives[i];
+                out.meshIndex = refs[i].meshIndex;
+                read[i] = ReadPrimitive(refs[i].prim, baseDir, options.flipZ_to_LH, options.flipWinding,
+                                        out, counts[i]) ? 1 : 0;
+            }
+        };
+        if (options.parallel) {
+            CJobSystem::Instance().ParallelFor(count, 1, readRange);
+        } else {
+            readRange(0, count);
+        }
+
+        for (uint32_t i = 0; i < count; i++) {
+            if (!read[i]) {
+                CFFLog::Error("[GltfLoader] %s: mesh %u has invalid primitive data", gltfPath.c_str(), refs[i].meshIndex);
+                ok = false;
+                break;
+            }
+            stats.bulkAccessors += counts[i].bulk;
+            stats.convertedAccessors += counts[i].converted;
+            stats.vertices += outScene.primitives[i].mesh.vertices.size();
+            stats.indices += outScene.primitives[i].mesh.indices.size();
+        }
+        stats.primitives = count;
+        stats.geometryMs = MillisecondsSince(start);
+    }
+
+    cgltf_free(data);
+    if (!ok) {
+        outScene = SGltfSceneCPU();
+        return false;
+    }
+    if (outStats) *outStats = stats;
+    return true;
 }
 
 bool LoadGLTF_PNT(const std::string& gltfPath,
@@ -165,23 +415,31 @@ bool LoadGLTF_PNT(const std::string& gltfPath,
 {
     outMeshes.clear();
 
+    SGltfLoadOptions options;
+    options.flipZ_to_LH = flipZ_to_LH;
+    options.flipWinding = flipWinding;
+    SGltfSceneCPU scene;
+    if (!LoadGLTFScene(gltfPath, scene, options)) return false;
+
+    outMeshes = std::move(scene.primitives);
+    return !outMeshes.empty();
+}
+
+bool GetGltfBufferFiles(const std::string& gltfPath, std::vector<std::string>& outFiles)
+{
+    outFiles.clear();
     cgltf_options opt{}; cgltf_data* data=nullptr;
     if (cgltf_parse_file(&opt, gltfPath.c_str(), &data) != cgltf_result_success) return false;
-    if (cgltf_load_buffers(&opt, data, gltfPath.c_str()) != cgltf_result_success){ cgltf_free(data); return false; }
 
     std::string baseDir = DirOf(gltfPath);
-
-    // 遍历节点 → mesh → primitives
-    // 这里不把节点矩阵应用到顶点（保持 object-space），你可以在渲染时用 world 矩阵
-    for (size_t mi=0; mi<data->meshes_count; ++mi){
-        auto* mesh = &data->meshes[mi];
-        for (size_t pi=0; pi<mesh->primitives_count; ++pi){
-            SGltfMeshCPU m{};
-            AppendPrimitive(&mesh->primitives[pi], baseDir, flipZ_to_LH, flipWinding, m);
-            if (!m.mesh.vertices.empty()) outMeshes.push_back(std::move(m));
-        }
+    for (size_t i=0; i<data->buffers_count; ++i){
+        const char* uri = data->buffers[i].uri;
+        // GLB chunk (no uri) or embedded base64
+        if (!uri || strncmp(uri, "data:", 5) == 0) continue;
+        std::string decoded(uri);
+        decoded.resize(cgltf_decode_uri(decoded.data()));
+        outFiles.push_back(Join(baseDir, decoded));
     }
-
     cgltf_free(data);
-    return !outMeshes.empty();
+    return true;
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include <DirectXMath.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "Mesh.h"
@@ -12,10 +14,69 @@ struct GltfTextures {
 struct SGltfMeshCPU {
     SMeshCPU_PNT mesh;     // 我们现有的 P/N/UV + tangent.w
     GltfTextures textures;
+    uint32_t meshIndex = 0; // glTF mesh this primitive belongs to
     // 可扩展 metallic-roughness、ao 等
 };
 
-// 返回多个实例化后的 mesh（已应用节点变换合并到 world 中的话，可扩展）
+// ============================================
+// Scene import (node hierarchy + instancing)
+// ============================================
+// Geometry stays in mesh space: every glTF mesh is read once, however many
+// nodes reference it, and nodes keep their local TRS so the hierarchy can be
+// rebuilt with STransform parents (see CScene::ImportModel).
+//
+// Primitives are the sub-meshes CMeshResourceManager uploads for the file, in
+// the same order: a node draws primitives[firstPrimitive, +primitiveCount) of
+// its mesh. Primitives without positions or with a non-triangle topology are
+// skipped in both the tables and the geometry, so the ranges are valid
+// whether or not geometry was loaded.
+struct SGltfMeshRange {
+    std::string name;
+    uint32_t firstPrimitive = 0;
+    uint32_t primitiveCount = 0;
+};
+
+struct SGltfNode {
+    std::string name;
+    int parent = -1;                            // Index into nodes, -1 = root
+    int mesh = -1;                              // Index into meshes, -1 = transform only
+    DirectX::XMFLOAT3 translation{0, 0, 0};     // Local, converted like the vertices
+    DirectX::XMFLOAT4 rotation{0, 0, 0, 1};     // Quaternion
+    DirectX::XMFLOAT3 scale{1, 1, 1};
+};
+
+struct SGltfSceneCPU {
+    std::vector<SGltfMeshCPU> primitives;       // Empty when loadGeometry is off
+    std::vector<SGltfMeshRange> meshes;
+    std::vector<SGltfNode> nodes;               // Default scene, parents before children
+};
+
+struct SGltfLoadOptions {
+    bool flipZ_to_LH = true;
+    bool flipWinding = true;
+    bool loadGeometry = true;   // false: node / mesh tables only, buffers are not read
+    bool parallel = true;       // Read primitives on the job system (if initialized)
+};
+
+struct SGltfLoadStats {
+    double parseMs = 0.0;           // JSON + buffers
+    double geometryMs = 0.0;        // Accessor copies + tangents, all primitives
+    uint32_t primitives = 0;
+    uint32_t bulkAccessors = 0;     // Float / index data copied straight from the buffer
+    uint32_t convertedAccessors = 0;// Normalized, sparse or compressed: unpacked by cgltf
+    uint64_t vertices = 0;
+    uint64_t indices = 0;
+};
+
+bool LoadGLTFScene(const std::string& gltfPath, SGltfSceneCPU& outScene,
+                   const SGltfLoadOptions& options = SGltfLoadOptions(),
+                   SGltfLoadStats* outStats = nullptr);
+
+// External .bin files the geometry is read from (JSON only, nothing is loaded).
+// Embedded and GLB buffers are part of the file itself and are not listed.
+bool GetGltfBufferFiles(const std::string& gltfPath, std::vector<std::string>& outFiles);
+
+// 返回所有 primitive（mesh 空间，不应用节点变换）；节点层级见 LoadGLTFScene
 bool LoadGLTF_PNT(const std::string& gltfPath,
                   std::vector<SGltfMeshCPU>& outMeshes,
                   bool flipZ_to_LH = true, bool flipWinding = true);
@@ -1,4 +1,5 @@
 #include "KTXLoader.h"
+#include "TextureLoader.h"
 #include "Core/FFLog.h"
 #include "RHI/RHIManager.h"
 #include "RHI/IRenderContext.h"
@@ -16,6 +17,15 @@ static ETextureFormat VkFormatToRHIFormat(uint32_t vkFormat) {
         case 37:  return ETextureFormat::R8G8B8A8_UNORM;      // VK_FORMAT_R8G8B8A8_UNORM
         case 43:  return ETextureFormat::R8G8B8A8_UNORM_SRGB; // VK_FORMAT_R8G8B8A8_SRGB
         case 83:  return ETextureFormat::R16G16_FLOAT;        // VK_FORMAT_R16G16_SFLOAT
+        case 131:                                             // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 133: return ETextureFormat::BC1_UNORM;           // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case 132:                                             // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+        case 134: return ETextureFormat::BC1_UNORM_SRGB;      // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        case 137: return ETextureFormat::BC3_UNORM;           // VK_FORMAT_BC3_UNORM_BLOCK
+        case 138: return ETextureFormat::BC3_UNORM_SRGB;      // VK_FORMAT_BC3_SRGB_BLOCK
+        case 141: return ETextureFormat::BC5_UNORM;           // VK_FORMAT_BC5_UNORM_BLOCK
+        case 145: return ETextureFormat::BC7_UNORM;           // VK_FORMAT_BC7_UNORM_BLOCK
+        case 146: return ETextureFormat::BC7_UNORM_SRGB;      // VK_FORMAT_BC7_SRGB_BLOCK
         default:
             CFFLog::Error("KTXLoader: Unsupported Vulkan format: %d", vkFormat);
             return ETextureFormat::Unknown;
@@ -96,39 +106,31 @@ ITexture* CKTXLoader::LoadCubemapFromKTX2(const std::string& filepath) {
     return texture;
 }
 
-ITexture* CKTXLoader::Load2DTextureFromKTX2(const std::string& filepath) {
+bool CKTXLoader::Decode2DTextureFromKTX2(const std::string& filepath, SDecodedTexture& outData) {
     ktxTexture2* ktxTex = nullptr;
     KTX_error_code result = ktxTexture2_CreateFromNamedFile(filepath.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &ktxTex);
     if (result != KTX_SUCCESS) {
         CFFLog::Error("KTXLoader: Failed to load %s (error %d)", filepath.c_str(), result);
-        return nullptr;
+        return false;
     }
 
     // Verify it's a 2D texture
     if (ktxTex->numFaces != 1) {
         CFFLog::Error("KTXLoader: %s is not a 2D texture (faces=%d)", filepath.c_str(), ktxTex->numFaces);
         ktxTexture2_Destroy(ktxTex);
-        return nullptr;
+        return false;
     }
 
     // Convert format
     ETextureFormat rhiFormat = VkFormatToRHIFormat(ktxTex->vkFormat);
     if (rhiFormat == ETextureFormat::Unknown) {
         ktxTexture2_Destroy(ktxTex);
-        return nullptr;
-    }
-
-    IRenderContext* ctx = CRHIManager::Instance().GetRenderContext();
-    if (!ctx) {
-        CFFLog::Error("KTXLoader: RHI context not available");
-        ktxTexture2_Destroy(ktxTex);
-        return nullptr;
+        return false;
     }
 
-    // Prepare subresource data (mipLevels)
-    uint32_t bytesPerPixel = GetBytesPerPixel(rhiFormat);
-    std::vector<SubresourceData> subresources;
-    subresources.reserve(ktxTex->numLevels);
+    // Mip offsets into the image data (copied below, the ktx texture is freed)
+    outData.mips.clear();
+    outData.mips.reserve(ktxTex->numLevels);
 
     for (uint32_t mip = 0; mip < ktxTex->numLevels; ++mip) {
         size_t offset;
@@ -136,33 +138,36 @@ ITexture* CKTXLoader::Load2DTextureFromKTX2(const std::string& filepath) {
         if (result != KTX_SUCCESS) {
             CFFLog::Error("KTXLoader: Failed to get image offset");
             ktxTexture2_Destroy(ktxTex);
-            return nullptr;
+            return false;
         }
 
         uint32_t mipWidth = ktxTex->baseWidth >> mip;
         if (mipWidth == 0) mipWidth = 1;
 
-        SubresourceData data;
-        data.pData = ktxTex->pData + offset;
-        data.rowPitch = mipWidth * bytesPerPixel;
-        data.slicePitch = 0;
-        subresources.push_back(data);
+        outData.mips.push_back({offset, GetRowPitch(rhiFormat, mipWidth)});
     }
 
-    // Create texture via RHI
-    TextureDesc desc;
-    desc.width = ktxTex->baseWidth;
-    desc.height = ktxTex->baseHeight;
-    desc.mipLevels = ktxTex->numLevels;
-    desc.format = rhiFormat;
-    desc.usage = ETextureUsage::ShaderResource;
-    desc.debugName = "KTX2DTexture";
+    outData.width = ktxTex->baseWidth;
+    outData.height = ktxTex->baseHeight;
+    outData.format = rhiFormat;
+    outData.generateMips = false;
+    outData.data.assign(ktxTex->pData, ktxTex->pData + ktxTex->dataSize);
 
-    ITexture* texture = ctx->CreateTextureWithData(desc, subresources.data(), (uint32_t)subresources.size());
+    ktxTexture2_Destroy(ktxTex);
+    return true;
+}
 
-    CFFLog::Info("KTXLoader: Loaded 2D texture %s (%dx%d, %d mips)", filepath.c_str(), desc.width, desc.height, desc.mipLevels);
+ITexture* CKTXLoader::Load2DTextureFromKTX2(const std::string& filepath) {
+    SDecodedTexture decoded;
+    if (!Decode2DTextureFromKTX2(filepath, decoded)) {
+        return nullptr;
+    }
 
-    ktxTexture2_Destroy(ktxTex);
+    ITexture* texture = CreateTextureFromDecoded(decoded, "KTX2DTexture");
+    if (texture) {
+        CFFLog::Info("KTXLoader: Loaded 2D texture %s (%dx%d, %d mips)", filepath.c_str(),
+                     decoded.width, decoded.height, (int)decoded.mips.size());
+    }
     return texture;
 }
 
@@ -4,6 +4,8 @@
 #include <vector>
 #include <DirectXMath.h>
 
+struct SDecodedTexture;
+
 class CKTXLoader {
 public:
     // Load KTX2 cubemap texture (returns RHI texture with SRV)
@@ -12,6 +14,10 @@ public:
     // Load KTX2 2D texture (returns RHI texture with SRV)
     static RHI::ITexture* Load2DTextureFromKTX2(const std::string& filepath);
 
+    // Read a KTX2 2D texture (all mips) to CPU memory without touching the RHI,
+    // thread-safe. Upload with CreateTextureFromDecoded (TextureLoader.h).
+    static bool Decode2DTextureFromKTX2(const std::string& filepath, SDecodedTexture& outData);
+
     // ============================================
     // CPU-side loading (for path tracing)
     // ============================================
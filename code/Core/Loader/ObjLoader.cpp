@@ -1,68 +1,347 @@
-
 #include "ObjLoader.h"
-#include <fstream>
-#include <sstream>
+#include "MappedFile.h"
+#include "Jobs/JobSystem.h"
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <limits>
 #include <cmath>
 #include <DirectXMath.h>
 
-struct VIdx { int v=-1, vt=-1, vn=-1; };
-static inline VIdx parseVIdx(const std::string& s) {
-    VIdx idx{}; std::string buf; int slot=0; int vals[3]={-1,-1,-1};
-    for (char c: s){ if (c=='/'){ vals[slot++]=buf.empty()? -1:std::stoi(buf); buf.clear(); } else buf.push_back(c); }
-    vals[slot++]=buf.empty()? -1:std::stoi(buf);
-    idx.v=vals[0]; idx.vt=vals[1]; idx.vn=vals[2]; return idx;
-}
-static inline void trim(std::string& s){ size_t a=0; while (a<s.size() && isspace((unsigned char)s[a])) ++a; size_t b=s.size(); while (b>a && isspace((unsigned char)s[b-1])) --b; s=s.substr(a,b-a); }
-static inline int fix(int idx, int n){ return idx>0? idx-1 : (idx<0? n+idx : -1); }
+// ============================================
+// Streaming OBJ parser
+// ============================================
+// The file is mapped and tokenized in place (from_chars, no per-line strings
+// or streams). Large files are cut into chunks at line boundaries:
+//   1. Parse (parallel): each chunk collects v / vn / vt and triangulated face
+//      corners. Negative (relative) indices are resolved against the chunk's
+//      own counts and patched with the chunk's offsets afterwards.
+//   2. Dedupe (parallel): each chunk gives its unique corners local ids in
+//      first-use order (open addressing hash map).
+//   3. Merge (serial, unique corners only): chunks in file order map local ids
+//      to global ids, so vertices come out in first-use order over the whole
+//      file - the same order as a single pass.
+//   4. Remap indices and build vertices (parallel).
+// The result is identical to the previous line-by-line parser.
 
-bool LoadOBJ_PNT(const std::string& path, SMeshCPU_PNT& out, bool flipZ, bool flipWinding)
+namespace
 {
-    std::ifstream in(path); if (!in) return false;
-    std::vector<float> P; std::vector<float> N; std::vector<float> T;
+    struct SObjCorner { int32_t v, vt, vn; };   // 0-based, -1 = absent
+
+    inline bool isBlank(char c) { return c==' ' || c=='\t' || c=='\r' || c=='\v' || c=='\f'; }
+
+    // ============================================
+    // CCornerMap - corner -> id, open addressing with linear probing
+    // ============================================
+    class CCornerMap
+    {
+    public:
+        explicit CCornerMap(size_t expected) {
+            size_t capacity = 16;
+            while (capacity < expected * 2) capacity <<= 1;
+            m_slots.assign(capacity, SSlot{{0, 0, 0}, EMPTY});
+            m_mask = capacity - 1;
+        }
+
+        // Id of an equal corner already in the map, otherwise inserts newId and returns it
+        uint32_t FindOrInsert(const SObjCorner& key, uint32_t newId) {
+            if ((m_count + 1) * 2 > m_slots.size()) grow();
+            for (size_t i = hash(key) & m_mask;; i = (i + 1) & m_mask) {
+                SSlot& slot = m_slots[i];
+                if (slot.id == EMPTY) {
+                    slot.key = key; slot.id = newId; m_count++;
+                    return newId;
+                }
+                if (slot.key.v == key.v && slot.key.vt == key.vt && slot.key.vn == key.vn) {
+                    return slot.id;
+                }
+            }
+        }
+
+    private:
+        static const uint32_t EMPTY = 0xFFFFFFFFu;
+        struct SSlot { SObjCorner key; uint32_t id; };
+
+        static size_t hash(const SObjCorner& k) {
+            uint32_t h = (uint32_t)k.v * 0x9E3779B1u ^ (uint32_t)k.vt * 0x85EBCA77u ^ (uint32_t)k.vn * 0xC2B2AE3Du;
+            h ^= h >> 15; h *= 0x2C1B3C6Du; h ^= h >> 12;
+            return h;
+        }
+
+        void grow() {
+            std::vector<SSlot> old;
+            old.swap(m_slots);
+            m_slots.assign(old.size() * 2, SSlot{{0, 0, 0}, EMPTY});
+            m_mask = m_slots.size() - 1;
+            for (const SSlot& slot : old) {
+                if (slot.id == EMPTY) continue;
+                size_t i = hash(slot.key) & m_mask;
+                while (m_slots[i].id != EMPTY) i = (i + 1) & m_mask;
+                m_slots[i] = slot;
+            }
+        }
+
+        std::vector<SSlot> m_slots;
+        size_t m_mask = 0;
+        size_t m_count = 0;
+    };
 
-    struct Key{ int v,vt,vn; bool operator==(const Key&o)const{return v==o.v&&vt==o.vt&&vn==o.vn;} };
-    struct KH{ size_t operator()(const Key&k)const{ return (std::hash<int>()(k.v)*73856093)^(std::hash<int>()(k.vt)*19349663)^(std::hash<int>()(k.vn)*83492791); } };
-    std::unordered_map<Key, uint32_t, KH> map;
+    struct SObjChunk {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        bool failed = false;
 
+        // Parse
+        std::vector<float> P, N, T;
+        std::vector<SObjCorner> corners;        // 3 per triangle, before the winding flip
+        std::vector<uint32_t> relative;         // corner*3 + component of indices that were relative (negative)
+
+        // Dedupe
+        std::vector<SObjCorner> unique;         // local id -> corner, first-use order
+        std::vector<uint32_t> localIds;         // per corner
+        std::vector<uint32_t> globalIds;        // local id -> global id
+    };
+
+    // Like istream >> float: skips blanks, allows a leading '+', 0 if nothing parses
+    const char* parseFloat(const char* p, const char* end, float& out) {
+        while (p < end && isBlank(*p)) ++p;
+        const char* num = (p < end && *p == '+' && p + 1 < end && p[1] != '-') ? p + 1 : p;
+        auto res = std::from_chars(num, end, out);
+        if (res.ec != std::errc()) { out = 0.0f; return p; }
+        return res.ptr;
+    }
+
+    // One face token: "v", "v/vt", "v//vn" or "v/vt/vn". Empty components are 0.
+    // False if a component is not a number.
+    bool parseCornerToken(const char*& p, const char* end, int32_t raw[3]) {
+        raw[0] = raw[1] = raw[2] = 0;
+        for (int slot = 0; p < end && !isBlank(*p); ++slot) {
+            if (*p != '/') {
+                const char* num = (*p == '+') ? p + 1 : p;
+                int32_t ignored;
+                auto res = std::from_chars(num, end, slot < 3 ? raw[slot] : ignored);
+                if (res.ec != std::errc()) return false;
+                p = res.ptr;
+                while (p < end && *p != '/' && !isBlank(*p)) ++p;   // stoi ignores trailing characters
+            }
+            if (p < end && *p == '/') ++p;
+        }
+        return true;
+    }
+
+    void parseChunk(SObjChunk& c, bool flipZ) {
+        std::vector<SObjCorner> face;
+        std::vector<uint8_t> faceRelative;
+        const char* p = c.begin;
+        while (p < c.end) {
+            const char* lineEnd = (const char*)memchr(p, '\n', c.end - p);
+            if (!lineEnd) lineEnd = c.end;
+            const char* q = p;
+            p = lineEnd < c.end ? lineEnd + 1 : c.end;
+
+            while (q < lineEnd && isBlank(*q)) ++q;
+            if (q == lineEnd || *q == '#') continue;
+            const char* tag = q;
+            while (q < lineEnd && !isBlank(*q)) ++q;
+            size_t tagLen = q - tag;
+
+            if (tagLen == 1 && tag[0] == 'v') {
+                float x, y, z;
+                q = parseFloat(q, lineEnd, x); q = parseFloat(q, lineEnd, y); parseFloat(q, lineEnd, z);
+                if (flipZ) z = -z;
+                c.P.insert(c.P.end(), {x, y, z});
+            }
+            else if (tagLen == 2 && tag[0] == 'v' && tag[1] == 'n') {
+                float x, y, z;
+                q = parseFloat(q, lineEnd, x); q = parseFloat(q, lineEnd, y); parseFloat(q, lineEnd, z);
+                if (flipZ) z = -z;
+                c.N.insert(c.N.end(), {x, y, z});
+            }
+            else if (tagLen == 2 && tag[0] == 'v' && tag[1] == 't') {
+                float u, v;
+                q = parseFloat(q, lineEnd, u); parseFloat(q, lineEnd, v);
+                c.T.insert(c.T.end(), {u, v});
+            }
+            else if (tagLen == 1 && tag[0] == 'f') {
+                const int32_t counts[3] = { (int32_t)(c.P.size() / 3), (int32_t)(c.T.size() / 2), (int32_t)(c.N.size() / 3) };
+                face.clear(); faceRelative.clear();
+                for (;;) {
+                    while (q < lineEnd && isBlank(*q)) ++q;
+                    if (q == lineEnd) break;
+                    int32_t raw[3];
+                    if (!parseCornerToken(q, lineEnd, raw)) { c.failed = true; return; }
+
+                    int32_t resolved[3]; uint8_t relativeMask = 0;
+                    for (int k = 0; k < 3; ++k) {
+                        if (raw[k] > 0) resolved[k] = raw[k] - 1;
+                        else if (raw[k] < 0) { resolved[k] = counts[k] + raw[k]; relativeMask |= 1 << k; }
+                        else resolved[k] = -1;
+                    }
+                    face.push_back({resolved[0], resolved[1], resolved[2]});
+                    faceRelative.push_back(relativeMask);
+                }
+                if (face.size() < 3) continue;
+
+                // Fan triangulation
+                for (size_t k = 1; k + 1 < face.size(); ++k) {
+                    const size_t tri[3] = { 0, k, k + 1 };
+                    for (size_t t : tri) {
+                        for (int comp = 0; comp < 3; ++comp) {
+                            if (faceRelative[t] & (1 << comp)) c.relative.push_back((uint32_t)c.corners.size() * 3 + comp);
+                        }
+                        c.corners.push_back(face[t]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool LoadOBJ_PNT(const std::string& path, SMeshCPU_PNT& out, bool flipZ, bool flipWinding, bool parallel)
+{
+    CMappedFile file; if (!file.Open(path)) return false;
+    return ParseOBJ_PNT(reinterpret_cast<const char*>(file.Data()), file.Size(), out, flipZ, flipWinding, parallel);
+}
+
+bool ParseOBJ_PNT(const char* text, size_t size, SMeshCPU_PNT& out, bool flipZ, bool flipWinding, bool parallel)
+{
     out.vertices.clear(); out.indices.clear();
-    std::string line;
-    while (std::getline(in,line)){
-        trim(line); if (line.empty()||line[0]=='#') continue;
-        std::istringstream iss(line); std::string tag; iss>>tag;
-        if (tag=="v"){ float x,y,z; iss>>x>>y>>z; if (flipZ) z=-z; P.insert(P.end(),{x,y,z}); }
-        else if (tag=="vn"){ float x,y,z; iss>>x>>y>>z; if (flipZ) z=-z; N.insert(N.end(),{x,y,z}); }
-        else if (tag=="vt"){ float u,v; iss>>u>>v; T.insert(T.end(),{u,v}); }
-        else if (tag=="f"){
-            std::vector<VIdx> face; std::string s; while (iss>>s) face.push_back(parseVIdx(s));
-            if (face.size()<3) continue;
-            for (size_t k=1;k+1<face.size();++k){
-                VIdx tri[3] = { face[0], face[k], face[k+1] };
-                for (int t=0;t<3;++t){
-                    int nv=(int)P.size()/3, nn=(int)N.size()/3, nt=(int)T.size()/2;
-                    int iv=fix(tri[t].v,nv), it=fix(tri[t].vt,nt), in=fix(tri[t].vn,nn);
-                    Key key{iv,it,in}; auto itK=map.find(key); uint32_t oi;
-                    if (itK==map.end()){
-                        SVertexPNT v{};
-                        v.px=P[iv*3+0]; v.py=P[iv*3+1]; v.pz=P[iv*3+2];
-                        if (in>=0){ v.nx=N[in*3+0]; v.ny=N[in*3+1]; v.nz=N[in*3+2]; }
-                        else { v.nx=0; v.ny=1; v.nz=0; }
-                        if (it>=0){ v.u=T[it*2+0]; v.v=T[it*2+1]; } else { v.u=0; v.v=0; }
-                        v.tx=v.ty=v.tz=0; v.tw=1;
-                        v.r=v.g=v.b=v.a=1.0f;  // OBJ doesn't support vertex colors, default to white
-                        v.u2=0.0f; v.v2=0.0f;  // UV2 for lightmap (default 0, set by lightmap baker)
-                        oi=(uint32_t)out.vertices.size(); out.vertices.push_back(v); map.emplace(key,oi);
-                    } else oi=itK->second;
-                    out.indices.push_back(oi);
+    if (!text || size == 0) return false;
+
+    CJobSystem& jobs = CJobSystem::Instance();
+    uint32_t chunkCount = 1;
+    if (parallel && jobs.IsInitialized() && size >= OBJ_PARALLEL_MIN_BYTES) {
+        // ~2 chunks per thread for balance, at least 1 MB each
+        chunkCount = (uint32_t)std::clamp<size_t>(size / (1024 * 1024), 1, jobs.GetThreadCount() * 2);
+    }
+
+    // Split at line starts
+    std::vector<SObjChunk> chunks(chunkCount);
+    const char* end = text + size;
+    const char* begin = text;
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        const char* chunkEnd = end;
+        if (i + 1 < chunkCount) {
+            chunkEnd = std::max(begin, text + size / chunkCount * (i + 1));
+            const char* nl = (const char*)memchr(chunkEnd, '\n', end - chunkEnd);
+            chunkEnd = nl ? nl + 1 : end;
+        }
+        chunks[i].begin = begin; chunks[i].end = chunkEnd;
+        begin = chunkEnd;
+    }
+
+    // 1. Parse
+    jobs.ParallelFor(chunkCount, 1, [&](uint32_t b, uint32_t e) {
+        for (uint32_t i = b; i < e; ++i) parseChunk(chunks[i], flipZ);
+    });
+
+    std::vector<int32_t> offsets(chunkCount * 3);
+    int32_t totals[3] = {0, 0, 0};
+    size_t cornerTotal = 0;
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        const SObjChunk& c = chunks[i];
+        if (c.failed) return false;
+        offsets[i * 3 + 0] = totals[0]; totals[0] += (int32_t)(c.P.size() / 3);
+        offsets[i * 3 + 1] = totals[1]; totals[1] += (int32_t)(c.T.size() / 2);
+        offsets[i * 3 + 2] = totals[2]; totals[2] += (int32_t)(c.N.size() / 3);
+        cornerTotal += c.corners.size();
+    }
+
+    // 2. Patch relative indices, validate, dedupe per chunk
+    jobs.ParallelFor(chunkCount, 1, [&](uint32_t b, uint32_t e) {
+        for (uint32_t i = b; i < e; ++i) {
+            SObjChunk& c = chunks[i];
+            for (uint32_t r : c.relative) {
+                int32_t* corner = &c.corners[r / 3].v;
+                corner[r % 3] += offsets[i * 3 + r % 3];
+            }
+
+            CCornerMap map(std::max(c.P.size() / 3, c.corners.size() / 6));
+            c.localIds.resize(c.corners.size());
+            for (size_t k = 0; k < c.corners.size(); ++k) {
+                const SObjCorner& corner = c.corners[k];
+                if (corner.v < 0 || corner.v >= totals[0] || corner.vt < -1 || corner.vt >= totals[1] ||
+                    corner.vn < -1 || corner.vn >= totals[2]) {
+                    c.failed = true;
+                    break;
                 }
-                if (flipWinding) std::swap(out.indices[out.indices.size()-3], out.indices[out.indices.size()-2]);
+                uint32_t id = map.FindOrInsert(corner, (uint32_t)c.unique.size());
+                if (id == c.unique.size()) c.unique.push_back(corner);
+                c.localIds[k] = id;
+            }
+        }
+    });
+    for (const SObjChunk& c : chunks) if (c.failed) return false;
+
+    // 3. Merge in file order
+    std::vector<SObjCorner> unique;
+    if (chunkCount == 1) {
+        unique.swap(chunks[0].unique);
+    } else {
+        size_t localTotal = 0;
+        for (const SObjChunk& c : chunks) localTotal += c.unique.size();
+        CCornerMap map(localTotal);
+        unique.reserve(localTotal);
+        for (SObjChunk& c : chunks) {
+            c.globalIds.resize(c.unique.size());
+            for (size_t k = 0; k < c.unique.size(); ++k) {
+                uint32_t id = map.FindOrInsert(c.unique[k], (uint32_t)unique.size());
+                if (id == unique.size()) unique.push_back(c.unique[k]);
+                c.globalIds[k] = id;
+            }
+        }
+    }
+
+    // 4. Indices
+    if (chunkCount == 1) {
+        out.indices.swap(chunks[0].localIds);
+    } else {
+        out.indices.resize(cornerTotal);
+        std::vector<size_t> indexOffsets(chunkCount, 0);
+        for (uint32_t i = 1; i < chunkCount; ++i) indexOffsets[i] = indexOffsets[i - 1] + chunks[i - 1].corners.size();
+        jobs.ParallelFor(chunkCount, 1, [&](uint32_t b, uint32_t e) {
+            for (uint32_t i = b; i < e; ++i) {
+                const SObjChunk& c = chunks[i];
+                uint32_t* dst = out.indices.data() + indexOffsets[i];
+                for (size_t k = 0; k < c.localIds.size(); ++k) dst[k] = c.globalIds[c.localIds[k]];
             }
+        });
+    }
+    if (flipWinding) {
+        for (size_t i = 0; i + 2 < out.indices.size(); i += 3) std::swap(out.indices[i], out.indices[i + 1]);
+    }
+
+    // Vertices
+    std::vector<float> P, N, T;
+    if (chunkCount == 1) {
+        P.swap(chunks[0].P); N.swap(chunks[0].N); T.swap(chunks[0].T);
+    } else {
+        P.reserve((size_t)totals[0] * 3); N.reserve((size_t)totals[2] * 3); T.reserve((size_t)totals[1] * 2);
+        for (SObjChunk& c : chunks) {
+            P.insert(P.end(), c.P.begin(), c.P.end()); std::vector<float>().swap(c.P);
+            N.insert(N.end(), c.N.begin(), c.N.end()); std::vector<float>().swap(c.N);
+            T.insert(T.end(), c.T.begin(), c.T.end()); std::vector<float>().swap(c.T);
         }
     }
+
+    out.vertices.resize(unique.size());
+    jobs.ParallelFor((uint32_t)unique.size(), 4096, [&](uint32_t b, uint32_t e) {
+        for (uint32_t i = b; i < e; ++i) {
+            int iv = unique[i].v, it = unique[i].vt, in = unique[i].vn;
+            SVertexPNT v{};
+            v.px=P[iv*3+0]; v.py=P[iv*3+1]; v.pz=P[iv*3+2];
+            if (in>=0){ v.nx=N[in*3+0]; v.ny=N[in*3+1]; v.nz=N[in*3+2]; }
+            else { v.nx=0; v.ny=1; v.nz=0; }
+            if (it>=0){ v.u=T[it*2+0]; v.v=T[it*2+1]; } else { v.u=0; v.v=0; }
+            v.tx=v.ty=v.tz=0; v.tw=1;
+            v.r=v.g=v.b=v.a=1.0f;  // OBJ doesn't support vertex colors, default to white
+            v.u2=0.0f; v.v2=0.0f;  // UV2 for lightmap (default 0, set by lightmap baker)
+            out.vertices[i] = v;
+        }
+    });
+
     // generate normals if missing
     if (N.empty()){
         std::vector<DirectX::XMFLOAT3> acc(out.vertices.size(),{0,0,0});
@@ -1,7 +1,11 @@
-
 #pragma once
 #include <string>
 #include "Mesh.h"
 
-bool LoadOBJ_PNT(const std::string& path, SMeshCPU_PNT& out, bool flipZ=true, bool flipWinding=true);
+// Files at least this large are split into chunks parsed on the job system
+static const size_t OBJ_PARALLEL_MIN_BYTES = 4u * 1024 * 1024;
+
+bool LoadOBJ_PNT(const std::string& path, SMeshCPU_PNT& out, bool flipZ=true, bool flipWinding=true, bool parallel=true);
+// Same as LoadOBJ_PNT, for OBJ text already in memory (need not be null-terminated)
+bool ParseOBJ_PNT(const char* text, size_t size, SMeshCPU_PNT& out, bool flipZ=true, bool flipWinding=true, bool parallel=true);
 void RecenterAndScale(SMeshCPU_PNT& m, float targetDiag = 2.0f);
@@ -30,87 +30,125 @@ static void LogHRError(const std::wstring& path, const char* operation, HRESULT
                   operation, narrowPath.c_str(), hr, narrowMsg.c_str());
 }
 
-RHI::ITexture* LoadTextureWIC(const std::wstring& path, bool srgb)
+bool DecodeTextureWIC(const std::wstring& path, bool srgb, SDecodedTexture& out)
 {
-    RHI::IRenderContext* ctx = RHI::CRHIManager::Instance().GetRenderContext();
-    if (!ctx) {
-        CFFLog::Error("[TextureLoader] RHI context not available: %s", WideToNarrow(path).c_str());
-        return nullptr;
-    }
-
     HRESULT hr = S_OK;
     ComPtr<IWICImagingFactory> factory;
     ComPtr<IWICBitmapDecoder> decoder;
     ComPtr<IWICBitmapFrameDecode> frame;
     ComPtr<IWICFormatConverter> converter;
 
+    // Per thread, decoding may run on streaming workers
     CoInitializeEx(nullptr, COINIT_MULTITHREADED);
     hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER,
                           IID_PPV_ARGS(factory.GetAddressOf()));
     if (FAILED(hr)) {
         LogHRError(path, "CoCreateInstance(WICImagingFactory)", hr);
-        return nullptr;
+        return false;
     }
 
     hr = factory->CreateDecoderFromFilename(path.c_str(), nullptr, GENERIC_READ,
                                             WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
     if (FAILED(hr)) {
         LogHRError(path, "CreateDecoderFromFilename", hr);
-        return nullptr;
+        return false;
     }
 
     hr = decoder->GetFrame(0, frame.GetAddressOf());
     if (FAILED(hr)) {
         LogHRError(path, "GetFrame(0)", hr);
-        return nullptr;
+        return false;
     }
 
     hr = factory->CreateFormatConverter(converter.GetAddressOf());
     if (FAILED(hr)) {
         LogHRError(path, "CreateFormatConverter", hr);
-        return nullptr;
+        return false;
     }
 
     hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA,
                                WICBitmapDitherTypeNone, nullptr, 0.f, WICBitmapPaletteTypeCustom);
     if (FAILED(hr)) {
         LogHRError(path, "FormatConverter::Initialize", hr);
-        return nullptr;
+        return false;
     }
 
     UINT w = 0, h = 0;
     converter->GetSize(&w, &h);
-    std::vector<uint8_t> pixels(w * h * 4);
-    hr = converter->CopyPixels(nullptr, w * 4, (UINT)pixels.size(), pixels.data());
+    out.data.resize((size_t)w * h * 4);
+    hr = converter->CopyPixels(nullptr, w * 4, (UINT)out.data.size(), out.data.data());
     if (FAILED(hr)) {
         LogHRError(path, "CopyPixels", hr);
+        out.data.clear();
+        return false;
+    }
+
+    out.width = w;
+    out.height = h;
+    out.format = srgb ? RHI::ETextureFormat::R8G8B8A8_UNORM_SRGB : RHI::ETextureFormat::R8G8B8A8_UNORM;
+    out.generateMips = true;
+    out.mips.assign(1, SDecodedTexture::SMip{0, w * 4});
+    return true;
+}
+
+RHI::ITexture* CreateTextureFromDecoded(const SDecodedTexture& decoded, const char* debugName)
+{
+    RHI::IRenderContext* ctx = RHI::CRHIManager::Instance().GetRenderContext();
+    if (!ctx) {
+        CFFLog::Error("[TextureLoader] RHI context not available: %s", debugName);
+        return nullptr;
+    }
+    if (decoded.mips.empty()) {
         return nullptr;
     }
 
-    // Create texture via RHI with mipmap generation support
     RHI::TextureDesc desc;
-    desc.width = w;
-    desc.height = h;
-    desc.mipLevels = 0;  // 0 = auto-generate full mipmap chain
+    desc.width = decoded.width;
+    desc.height = decoded.height;
     desc.arraySize = 1;
-    desc.format = srgb ? RHI::ETextureFormat::R8G8B8A8_UNORM_SRGB : RHI::ETextureFormat::R8G8B8A8_UNORM;
-    desc.usage = RHI::ETextureUsage::ShaderResource | RHI::ETextureUsage::RenderTarget;  // RenderTarget for GenerateMips
-    desc.miscFlags = RHI::ETextureMiscFlags::GenerateMips;
-    desc.debugName = "WICTexture";
+    desc.format = decoded.format;
+    desc.debugName = debugName;
+
+    RHI::ITexture* texture = nullptr;
+    if (decoded.generateMips) {
+        // Create texture with initial data at mip 0, full chain generated below
+        desc.mipLevels = 0;  // 0 = auto-generate full mipmap chain
+        desc.usage = RHI::ETextureUsage::ShaderResource | RHI::ETextureUsage::RenderTarget;  // RenderTarget for GenerateMips
+        desc.miscFlags = RHI::ETextureMiscFlags::GenerateMips;
+        texture = ctx->CreateTexture(desc, decoded.data.data());
+    } else {
+        std::vector<RHI::SubresourceData> subresources(decoded.mips.size());
+        for (size_t mip = 0; mip < decoded.mips.size(); mip++) {
+            subresources[mip].pData = decoded.data.data() + decoded.mips[mip].offset;
+            subresources[mip].rowPitch = decoded.mips[mip].rowPitch;
+        }
+        desc.mipLevels = (uint32_t)decoded.mips.size();
+        desc.usage = RHI::ETextureUsage::ShaderResource;
+        texture = ctx->CreateTextureWithData(desc, subresources.data(), (uint32_t)subresources.size());
+    }
 
-    // Create texture with initial data at mip 0
-    RHI::ITexture* texture = ctx->CreateTexture(desc, pixels.data());
     if (!texture) {
         CFFLog::Error("[TextureLoader] CreateTexture failed: %s (%ux%u)",
-                      WideToNarrow(path).c_str(), w, h);
+                      debugName, decoded.width, decoded.height);
         return nullptr;
     }
 
-    // Generate mipmaps via RHI
-    RHI::ICommandList* cmdList = ctx->GetCommandList();
-    if (cmdList) {
-        cmdList->GenerateMips(texture);
+    if (decoded.generateMips) {
+        // Generate mipmaps via RHI
+        RHI::ICommandList* cmdList = ctx->GetCommandList();
+        if (cmdList) {
+            cmdList->GenerateMips(texture);
+        }
     }
 
     return texture;
 }
+
+RHI::ITexture* LoadTextureWIC(const std::wstring& path, bool srgb)
+{
+    SDecodedTexture decoded;
+    if (!DecodeTextureWIC(path, srgb, decoded)) {
+        return nullptr;
+    }
+    return CreateTextureFromDecoded(decoded, "WICTexture");
+}
@@ -1,6 +1,34 @@
 #pragma once
 #include "RHI/RHIResources.h"
+#include <cstdint>
 #include <string>
+#include <vector>
+
+// CPU-side texture data, produced by the decoders below.
+// Decoding touches no GPU state and may run on any thread; the upload
+// (CreateTextureFromDecoded) must run on the render thread.
+struct SDecodedTexture {
+    struct SMip {
+        size_t offset = 0;      // Byte offset into data
+        uint32_t rowPitch = 0;
+    };
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    RHI::ETextureFormat format = RHI::ETextureFormat::Unknown;
+    bool generateMips = false;  // Only mip 0 is stored, the chain is generated on the GPU after upload
+    std::vector<uint8_t> data;  // All stored mip levels
+    std::vector<SMip> mips;
+
+    size_t GetSizeBytes() const { return data.size(); }
+};
+
+// Decode an image with WIC (PNG/JPG/BMP/TGA/...) to RGBA8, thread-safe
+bool DecodeTextureWIC(const std::wstring& path, bool srgb, SDecodedTexture& out);
+
+// Create the RHI texture (and generate mips if requested), render thread only
+// Caller takes ownership of the returned texture
+RHI::ITexture* CreateTextureFromDecoded(const SDecodedTexture& decoded, const char* debugName);
 
 // Load texture using WIC (Windows Imaging Component)
 // Returns RHI texture on success, nullptr on failure
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ============================================
+// CMappedFile - read-only memory-mapped file
+// ============================================
+// Maps a whole file into the address space; the OS pages data in on first
+// access, so opening is O(1) and nothing is copied. The view stays valid
+// until Close() or destruction.
+//
+// Usage:
+//   CMappedFile file;
+//   if (file.Open(path)) { const uint8_t* p = file.Data(); size_t n = file.Size(); }
+class CMappedFile
+{
+public:
+    CMappedFile() = default;
+    ~CMappedFile() { Close(); }
+
+    CMappedFile(const CMappedFile&) = delete;
+    CMappedFile& operator=(const CMappedFile&) = delete;
+    CMappedFile(CMappedFile&& other) noexcept;
+    CMappedFile& operator=(CMappedFile&& other) noexcept;
+
+    // False if the file is missing or cannot be mapped (an empty file opens with Size() == 0)
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_open; }
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+};
@@ -74,6 +74,7 @@ bool CMaterialManager::IsLoaded(const std::string& path) const {
 
 void CMaterialManager::Clear() {
     m_materials.clear();
+    ++m_generation;
     CFFLog::Info("MaterialManager cache cleared");
 }
 
@@ -4,6 +4,7 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <cstdint>
 
 /**
  * Material Manager - Singleton for managing material assets
@@ -51,12 +52,18 @@ public:
      */
     void Clear();
 
+    /**
+     * Bumped by Clear(); material pointers from an older generation are invalid
+     */
+    uint32_t GetGeneration() const { return m_generation; }
+
 private:
     CMaterialManager();
     ~CMaterialManager() = default;
 
     std::unordered_map<std::string, std::unique_ptr<CMaterialAsset>> m_materials;
     std::unique_ptr<CMaterialAsset> m_defaultMaterial;
+    uint32_t m_generation = 0;
 
     std::string ResolveFullPath(const std::string& relativePath) const;
 };
@@ -13,9 +13,16 @@ struct SVertexPNT {
     float u2, v2;      // UV2 for lightmap (optional, 0 if unused)
 };
 
+// Reduced-detail index list over the same vertices (see MeshSimplifier.h)
+struct SMeshLodCPU {
+    std::vector<uint32_t> indices;
+    float error = 0.0f;     // Geometric error vs. the full mesh, mesh units
+};
+
 struct SMeshCPU_PNT {
     std::vector<SVertexPNT> vertices;
     std::vector<uint32_t> indices;
+    std::vector<SMeshLodCPU> lods;  // LOD1..N, coarser with each level (empty = no LODs)
 };
 
 void ComputeTangents(std::vector<SVertexPNT>& vtx, const std::vector<uint32_t>& idx);
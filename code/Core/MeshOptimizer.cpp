@@ -0,0 +1,471 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // ============================================
+    // Forsyth vertex scoring
+    // ============================================
+    // Tom Forsyth, "Linear-Speed Vertex Cache Optimisation" (2006). Scores are
+    // tabulated; the modelled cache is LRU and larger than the FIFO used for
+    // reporting, which is what the original tuning assumes.
+    const int kForsythCacheSize = 32;
+    const int kForsythMaxValence = 32;
+    const float kCacheDecayPower = 1.5f;
+    const float kLastTriScore = 0.75f;
+    const float kValenceBoostScale = 2.0f;
+    const float kValenceBoostPower = 0.5f;
+
+    struct SForsythTables {
+        float cache[kForsythCacheSize];
+        float valence[kForsythMaxValence + 1];
+
+        SForsythTables() {
+            for (int i = 0; i < kForsythCacheSize; i++) {
+                if (i < 3) {
+                    // The last triangle's vertices: fixed score so it is not simply repeated
+                    cache[i] = kLastTriScore;
+                } else {
+                    float scaler = 1.0f / (kForsythCacheSize - 3);
+                    cache[i] = std::pow(1.0f - (i - 3) * scaler, kCacheDecayPower);
+                }
+            }
+            valence[0] = 0.0f;
+            for (int i = 1; i <= kForsythMaxValence; i++) {
+                valence[i] = kValenceBoostScale * std::pow((float)i, -kValenceBoostPower);
+            }
+        }
+    };
+
+    const SForsythTables& forsythTables() {
+        static const SForsythTables tables;
+        return tables;
+    }
+
+    float vertexScore(int cachePosition, uint32_t liveTriangles) {
+        if (liveTriangles == 0) {
+            return -1.0f;   // No triangles left to emit
+        }
+        const SForsythTables& t = forsythTables();
+        float score = cachePosition >= 0 ? t.cache[cachePosition] : 0.0f;
+        // Low-valence vertices get a boost so stragglers are cleared early
+        score += t.valence[std::min<uint32_t>(liveTriangles, kForsythMaxValence)];
+        return score;
+    }
+
+    // ============================================
+    // Cluster cache model for the overdraw pass
+    // ============================================
+    // Timestamp window: a vertex is cached if it was loaded within the last
+    // cacheSize misses. Bumping the timestamp by cacheSize + 1 flushes it.
+    struct STimestampCache {
+        std::vector<uint32_t> loaded;
+        uint32_t timestamp;
+        uint32_t size;
+
+        STimestampCache(uint32_t vertexCount, uint32_t cacheSize)
+            : loaded(vertexCount, 0), timestamp(cacheSize + 1), size(cacheSize) {}
+
+        uint32_t Touch(uint32_t v) {
+            if (timestamp - loaded[v] > size) {
+                loaded[v] = timestamp++;
+                return 1;
+            }
+            return 0;
+        }
+        uint32_t Triangle(const uint32_t* tri) {
+            return Touch(tri[0]) + Touch(tri[1]) + Touch(tri[2]);
+        }
+        void Flush() {
+            timestamp += size + 1;
+        }
+    };
+
+    struct SCluster {
+        uint32_t firstTriangle;
+        uint32_t triangleCount;
+        float sortKey;
+    };
+}
+
+// ============================================
+// Analysis
+// ============================================
+
+SVertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                                     uint32_t cacheSize) {
+    SVertexCacheStats s;
+    s.triangles = static_cast<uint32_t>(indexCount / 3);
+    if (indexCount == 0 || vertexCount == 0 || cacheSize == 0) {
+        return s;
+    }
+
+    // FIFO: a hit does not refresh the entry, unlike the LRU model used for scoring
+    std::vector<uint32_t> fifo(cacheSize, kUnusedVertex);
+    std::vector<uint8_t> cached(vertexCount, 0);
+    std::vector<uint8_t> referenced(vertexCount, 0);
+    uint32_t head = 0;
+
+    for (size_t i = 0; i < s.triangles * 3; i++) {
+        uint32_t v = indices[i];
+        if (!referenced[v]) {
+            referenced[v] = 1;
+            s.vertices++;
+        }
+        if (cached[v]) {
+            continue;
+        }
+        s.misses++;
+        if (fifo[head] != kUnusedVertex) {
+            cached[fifo[head]] = 0;
+        }
+        fifo[head] = v;
+        cached[v] = 1;
+        head = (head + 1) % cacheSize;
+    }
+
+    s.acmr = s.triangles ? (float)s.misses / s.triangles : 0.0f;
+    s.atvr = s.vertices ? (float)s.misses / s.vertices : 0.0f;
+    return s;
+}
+
+// ============================================
+// Vertex cache
+// ============================================
+
+void OptimizeVertexCache(uint32_t* indices, size_t indexCount, uint32_t vertexCount) {
+    const uint32_t triangleCount = static_cast<uint32_t>(indexCount / 3);
+    if (triangleCount == 0 || vertexCount == 0) {
+        return;
+    }
+    const std::vector<uint32_t> input(indices, indices + triangleCount * 3);
+
+    // Vertex -> triangle adjacency (CSR). The first liveCount[v] entries of a
+    // vertex's range are the triangles not emitted yet.
+    std::vector<uint32_t> liveCount(vertexCount, 0);
+    for (uint32_t index : input) {
+        liveCount[index]++;
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        offsets[v + 1] = offsets[v] + liveCount[v];
+    }
+    std::vector<uint32_t> adjacency(input.size());
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (uint32_t t = 0; t < triangleCount; t++) {
+            for (int k = 0; k < 3; k++) {
+                adjacency[fill[input[t * 3 + k]]++] = t;
+            }
+        }
+    }
+
+    std::vector<float> vScore(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        vScore[v] = vertexScore(-1, liveCount[v]);
+    }
+
+    std::vector<float> tScore(triangleCount);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    uint32_t best = 0;
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        const uint32_t* tri = &input[t * 3];
+        tScore[t] = vScore[tri[0]] + vScore[tri[1]] + vScore[tri[2]];
+        if (tScore[t] > tScore[best]) {
+            best = t;
+        }
+    }
+
+    uint32_t cache[kForsythCacheSize + 3];
+    uint32_t cacheCount = 0;
+    uint32_t nextUnemitted = 0;     // Fallback scan cursor
+    size_t out = 0;
+
+    for (;;) {
+        const uint32_t* tri = &input[best * 3];
+        indices[out++] = tri[0];
+        indices[out++] = tri[1];
+        indices[out++] = tri[2];
+        emitted[best] = 1;
+        if (out == input.size()) {
+            break;
+        }
+
+        // Drop the triangle from its vertices' live lists (once per corner,
+        // so degenerate triangles with a repeated vertex are handled too)
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = tri[k];
+            uint32_t* list = &adjacency[offsets[v]];
+            uint32_t n = liveCount[v];
+            for (uint32_t i = 0; i < n; i++) {
+                if (list[i] == best) {
+                    std::swap(list[i], list[n - 1]);
+                    liveCount[v]--;
+                    break;
+                }
+            }
+        }
+
+        // New LRU state: the emitted triangle's vertices at the front
+        uint32_t newCache[kForsythCacheSize + 3];
+        uint32_t newCount = 0;
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = tri[k];
+            if (std::find(newCache, newCache + newCount, v) == newCache + newCount) {
+                newCache[newCount++] = v;
+            }
+        }
+        for (uint32_t i = 0; i < cacheCount; i++) {
+            uint32_t v = cache[i];
+            if (std::find(newCache, newCache + newCount, v) == newCache + newCount) {
+                newCache[newCount++] = v;
+            }
+        }
+
+        // Rescore every vertex whose position or valence changed; evicted ones lose their cache score
+        for (uint32_t i = 0; i < newCount; i++) {
+            uint32_t v = newCache[i];
+            int position = i < (uint32_t)kForsythCacheSize ? (int)i : -1;
+
+            float score = vertexScore(position, liveCount[v]);
+            float delta = score - vScore[v];
+            vScore[v] = score;
+
+            const uint32_t* list = &adjacency[offsets[v]];
+            for (uint32_t j = 0; j < liveCount[v]; j++) {
+                tScore[list[j]] += delta;
+            }
+        }
+        cacheCount = std::min<uint32_t>(newCount, kForsythCacheSize);
+        std::memcpy(cache, newCache, cacheCount * sizeof(uint32_t));
+
+        // Best live triangle touching the cache; ties go to the lowest triangle index
+        float bestScore = 0.0f;
+        uint32_t bestCandidate = kUnusedVertex;
+        for (uint32_t i = 0; i < cacheCount; i++) {
+            uint32_t v = cache[i];
+            const uint32_t* list = &adjacency[offsets[v]];
+            for (uint32_t j = 0; j < liveCount[v]; j++) {
+                uint32_t t = list[j];
+                if (bestCandidate == kUnusedVertex || tScore[t] > bestScore ||
+                    (tScore[t] == bestScore && t < bestCandidate)) {
+                    bestScore = tScore[t];
+                    bestCandidate = t;
+                }
+            }
+        }
+
+        if (bestCandidate != kUnusedVertex) {
+            best = bestCandidate;
+        } else {
+            // Nothing adjacent to the cache: continue with the next triangle in input order
+            while (emitted[nextUnemitted]) {
+                nextUnemitted++;
+            }
+            best = nextUnemitted;
+        }
+    }
+}
+
+// ============================================
+// Overdraw
+// ============================================
+
+void OptimizeOverdraw(uint32_t* indices, size_t indexCount,
+                      const SVertexPNT* vertices, uint32_t vertexCount, float threshold) {
+    const uint32_t triangleCount = static_cast<uint32_t>(indexCount / 3);
+    if (triangleCount < 2 || vertexCount == 0) {
+        return;
+    }
+
+    // Hard boundaries: triangles whose three vertices all miss start a new patch
+    std::vector<uint32_t> hard;
+    {
+        STimestampCache cache(vertexCount, kVertexCacheAnalyzeSize);
+        for (uint32_t t = 0; t < triangleCount; t++) {
+            if (cache.Triangle(&indices[t * 3]) == 3 || t == 0) {
+                hard.push_back(t);
+            }
+        }
+    }
+    hard.push_back(triangleCount);
+
+    // Soft boundaries: split a patch wherever the cluster so far is within
+    // threshold of the patch's own ACMR. Each cluster starts from a flushed
+    // cache, so reordering clusters costs at most that threshold.
+    std::vector<SCluster> clusters;
+    {
+        STimestampCache cache(vertexCount, kVertexCacheAnalyzeSize);
+        for (size_t h = 0; h + 1 < hard.size(); h++) {
+            uint32_t start = hard[h], end = hard[h + 1];
+
+            cache.Flush();
+            uint32_t patchMisses = 0;
+            for (uint32_t t = start; t < end; t++) {
+                patchMisses += cache.Triangle(&indices[t * 3]);
+            }
+            float patchThreshold = threshold * (float)patchMisses / (float)(end - start);
+
+            cache.Flush();
+            uint32_t clusterStart = start, clusterMisses = 0;
+            for (uint32_t t = start; t < end; t++) {
+                clusterMisses += cache.Triangle(&indices[t * 3]);
+                uint32_t clusterSize = t + 1 - clusterStart;
+                if (t + 1 < end && (float)clusterMisses / (float)clusterSize <= patchThreshold) {
+                    clusters.push_back({clusterStart, clusterSize, 0.0f});
+                    clusterStart = t + 1;
+                    clusterMisses = 0;
+                    cache.Flush();
+                }
+            }
+            clusters.push_back({clusterStart, end - clusterStart, 0.0f});
+        }
+    }
+    if (clusters.size() < 2) {
+        return;
+    }
+
+    // Sort key: how far a cluster faces away from the mesh centre. Outward-facing
+    // clusters are drawn first so they occlude the rest. Vertex normals give the
+    // facing so the result does not depend on the winding convention.
+    struct SClusterMoments {
+        double area = 0.0;
+        double centroid[3] = {0.0, 0.0, 0.0};
+        double normal[3] = {0.0, 0.0, 0.0};
+        double pointSum[3] = {0.0, 0.0, 0.0};   // Unweighted fallback for zero-area clusters
+    };
+    std::vector<SClusterMoments> moments(clusters.size());
+    double meshArea = 0.0;
+    double meshCentroid[3] = {0.0, 0.0, 0.0};
+    double meshPointSum[3] = {0.0, 0.0, 0.0};
+
+    for (size_t c = 0; c < clusters.size(); c++) {
+        SClusterMoments& m = moments[c];
+        for (uint32_t t = clusters[c].firstTriangle; t < clusters[c].firstTriangle + clusters[c].triangleCount; t++) {
+            const SVertexPNT& a = vertices[indices[t * 3 + 0]];
+            const SVertexPNT& b = vertices[indices[t * 3 + 1]];
+            const SVertexPNT& d = vertices[indices[t * 3 + 2]];
+            double e1[3] = {b.px - a.px, b.py - a.py, b.pz - a.pz};
+            double e2[3] = {d.px - a.px, d.py - a.py, d.pz - a.pz};
+            double cx = e1[1] * e2[2] - e1[2] * e2[1];
+            double cy = e1[2] * e2[0] - e1[0] * e2[2];
+            double cz = e1[0] * e2[1] - e1[1] * e2[0];
+            double area = 0.5 * std::sqrt(cx * cx + cy * cy + cz * cz);
+            double center[3] = {(a.px + b.px + d.px) / 3.0, (a.py + b.py + d.py) / 3.0, (a.pz + b.pz + d.pz) / 3.0};
+
+            m.area += area;
+            for (int k = 0; k < 3; k++) {
+                m.centroid[k] += center[k] * area;
+                m.pointSum[k] += center[k];
+            }
+            m.normal[0] += (a.nx + b.nx + d.nx) * area;
+            m.normal[1] += (a.ny + b.ny + d.ny) * area;
+            m.normal[2] += (a.nz + b.nz + d.nz) * area;
+        }
+        meshArea += m.area;
+        for (int k = 0; k < 3; k++) {
+            meshCentroid[k] += m.centroid[k];
+            meshPointSum[k] += m.pointSum[k];
+        }
+    }
+    for (int k = 0; k < 3; k++) {
+        meshCentroid[k] = meshArea > 0.0 ? meshCentroid[k] / meshArea : meshPointSum[k] / triangleCount;
+    }
+
+    for (size_t c = 0; c < clusters.size(); c++) {
+        SClusterMoments& m = moments[c];
+        double centroid[3];
+        for (int k = 0; k < 3; k++) {
+            centroid[k] = m.area > 0.0 ? m.centroid[k] / m.area : m.pointSum[k] / clusters[c].triangleCount;
+        }
+        double len = std::sqrt(m.normal[0] * m.normal[0] + m.normal[1] * m.normal[1] + m.normal[2] * m.normal[2]);
+        double key = 0.0;
+        if (len > 0.0) {
+            for (int k = 0; k < 3; k++) {
+                key += (centroid[k] - meshCentroid[k]) * m.normal[k] / len;
+            }
+        }
+        clusters[c].sortKey = (float)key;
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), [](const SCluster& a, const SCluster& b) {
+        return a.sortKey > b.sortKey;
+    });
+
+    const std::vector<uint32_t> input(indices, indices + triangleCount * 3);
+    size_t out = 0;
+    for (const SCluster& c : clusters) {
+        const uint32_t* src = &input[c.firstTriangle * 3];
+        std::memcpy(indices + out, src, c.triangleCount * 3 * sizeof(uint32_t));
+        out += c.triangleCount * 3;
+    }
+}
+
+// ============================================
+// Vertex fetch
+// ============================================
+
+uint32_t BuildVertexFetchRemap(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                               std::vector<uint32_t>& outRemap) {
+    outRemap.assign(vertexCount, kUnusedVertex);
+    uint32_t next = 0;
+    for (size_t i = 0; i < indexCount; i++) {
+        uint32_t& slot = outRemap[indices[i]];
+        if (slot == kUnusedVertex) {
+            slot = next++;
+        }
+    }
+    return next;
+}
+
+uint32_t OptimizeVertexFetch(SMeshCPU_PNT& mesh) {
+    std::vector<uint32_t> remap;
+    uint32_t used = BuildVertexFetchRemap(mesh.indices.data(), mesh.indices.size(),
+                                          static_cast<uint32_t>(mesh.vertices.size()), remap);
+
+    std::vector<SVertexPNT> vertices(used);
+    for (size_t v = 0; v < mesh.vertices.size(); v++) {
+        if (remap[v] != kUnusedVertex) {
+            vertices[remap[v]] = mesh.vertices[v];
+        }
+    }
+    for (uint32_t& index : mesh.indices) {
+        index = remap[index];
+    }
+    mesh.vertices = std::move(vertices);
+    return used;
+}
+
+// ============================================
+// Full pipeline
+// ============================================
+
+SMeshOptimizeReport OptimizeMesh(SMeshCPU_PNT& mesh, const SMeshOptimizeOptions& options) {
+    auto start = std::chrono::high_resolution_clock::now();
+    SMeshOptimizeReport report;
+    uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    report.verticesBefore = vertexCount;
+    report.before = AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), vertexCount);
+
+    // Trailing indices that do not form a triangle are not drawable; drop them
+    mesh.indices.resize(mesh.indices.size() - mesh.indices.size() % 3);
+
+    if (options.vertexCache) {
+        OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), vertexCount);
+    }
+    if (options.overdraw) {
+        OptimizeOverdraw(mesh.indices.data(), mesh.indices.size(), mesh.vertices.data(), vertexCount,
+                         options.overdrawThreshold);
+    }
+    if (options.vertexFetch) {
+        vertexCount = OptimizeVertexFetch(mesh);
+    }
+
+    report.verticesAfter = vertexCount;
+    report.after = AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), vertexCount);
+    report.ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return report;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "Mesh.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================
+// Mesh optimization (import time, CPU only)
+// ============================================
+// Reorders an indexed triangle list for the GPU without changing the surface:
+//
+//   1. Vertex cache   Forsyth's linear-speed greedy triangle ordering (LRU model)
+//   2. Overdraw       Optional. Splits the cache-ordered list into clusters at
+//                     cache-flush points and sorts them outside-in (Sander et al.
+//                     "Fast triangle reordering", the second half of Tipsify),
+//                     bounded by an ACMR threshold so cache efficiency is kept
+//   3. Vertex fetch   Vertices renumbered in first-use order (unreferenced ones
+//                     dropped) so the vertex stream is read front to back
+//
+// Every step is deterministic: same input, same output on every machine.
+// Triangle winding and the set of triangles are preserved; only their order
+// and the vertex numbering change.
+
+// FIFO post-transform cache size used for reporting (conservative for modern GPUs)
+static const uint32_t kVertexCacheAnalyzeSize = 16;
+
+struct SVertexCacheStats {
+    uint32_t triangles = 0;
+    uint32_t vertices = 0;          // Referenced vertices
+    uint32_t misses = 0;            // Vertex shader invocations
+    float acmr = 0.0f;              // Average cache miss ratio: misses / triangle (0.5 ideal, 3 worst)
+    float atvr = 0.0f;              // Average transformed vertex ratio: misses / vertex (1 ideal)
+};
+
+// Simulates a FIFO post-transform cache of cacheSize entries
+SVertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                                     uint32_t cacheSize = kVertexCacheAnalyzeSize);
+
+// In place. indexCount must be a multiple of 3, indices < vertexCount.
+void OptimizeVertexCache(uint32_t* indices, size_t indexCount, uint32_t vertexCount);
+
+// In place, on a cache-optimized list. threshold bounds the ACMR of each
+// re-sorted cluster relative to the input (1.05 = at most 5% worse).
+void OptimizeOverdraw(uint32_t* indices, size_t indexCount,
+                      const SVertexPNT* vertices, uint32_t vertexCount, float threshold = 1.05f);
+
+// remap[old] = new vertex index in first-use order, or kUnusedVertex. Returns the used vertex count.
+static const uint32_t kUnusedVertex = 0xFFFFFFFFu;
+uint32_t BuildVertexFetchRemap(const uint32_t* indices, size_t indexCount, uint32_t vertexCount,
+                               std::vector<uint32_t>& outRemap);
+
+// Applies BuildVertexFetchRemap to the mesh; returns the new vertex count
+uint32_t OptimizeVertexFetch(SMeshCPU_PNT& mesh);
+
+// 16-bit index buffers: 0xFFFF is kept free (strip-cut value) so any vertex count up to 65535 fits
+inline bool CanUse16BitIndices(uint32_t vertexCount) {
+    return vertexCount <= 0xFFFFu;
+}
+
+// ============================================
+// Full pipeline
+// ============================================
+struct SMeshOptimizeOptions {
+    bool vertexCache = true;
+    bool overdraw = false;
+    float overdrawThreshold = 1.05f;
+    bool vertexFetch = true;
+};
+
+struct SMeshOptimizeReport {
+    SVertexCacheStats before;
+    SVertexCacheStats after;
+    uint32_t verticesBefore = 0;    // mesh.vertices.size() before fetch optimization
+    uint32_t verticesAfter = 0;
+    double ms = 0.0;
+};
+
+SMeshOptimizeReport OptimizeMesh(SMeshCPU_PNT& mesh, const SMeshOptimizeOptions& options = SMeshOptimizeOptions());
@@ -4,41 +4,54 @@
 #include "Mesh.h"
 #include "Loader/ObjLoader.h"
 #include "Loader/GltfLoader.h"
+#include "Loader/FFMeshLoader.h"
+#include "DerivedDataCache.h"
+#include "PathManager.h"
 #include "../Engine/Rendering/RayTracing/SceneGeometryExport.h"
 #include "../Engine/Rendering/Lightmap/LightmapUV2.h"
 #include "FFLog.h"
+#include "Jobs/JobSystem.h"
 #include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 
 CMeshResourceManager& CMeshResourceManager::Instance() {
     static CMeshResourceManager instance;
     return instance;
 }
 
-void CMeshResourceManager::CacheMeshForRayTracing(const SMeshCPU_PNT& cpu, const std::string& path, uint32_t subMeshIndex) {
+void CMeshResourceManager::CacheMeshForRayTracing(const SVertexPNT* vertices, uint32_t vertexCount,
+                                                  const uint32_t* indices, uint32_t indexCount,
+                                                  const std::string& path, uint32_t subMeshIndex) {
     SRayTracingMeshData rtData;
     rtData.sourcePath = path;
-    rtData.vertexCount = static_cast<uint32_t>(cpu.vertices.size());
-    rtData.indexCount = static_cast<uint32_t>(cpu.indices.size());
+    rtData.vertexCount = vertexCount;
+    rtData.indexCount = indexCount;
 
     // Extract positions, normals, and UV2
-    rtData.positions.reserve(cpu.vertices.size());
-    rtData.normals.reserve(cpu.vertices.size());
-    rtData.uv2.reserve(cpu.vertices.size());
-    for (const auto& v : cpu.vertices) {
+    rtData.positions.reserve(vertexCount);
+    rtData.normals.reserve(vertexCount);
+    rtData.uv2.reserve(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; i++) {
+        const SVertexPNT& v = vertices[i];
         rtData.positions.push_back(DirectX::XMFLOAT3(v.px, v.py, v.pz));
         rtData.normals.push_back(DirectX::XMFLOAT3(v.nx, v.ny, v.nz));
         rtData.uv2.push_back(DirectX::XMFLOAT2(v.u2, v.v2));
     }
 
     // Copy indices
-    rtData.indices = cpu.indices;
+    rtData.indices.assign(indices, indices + indexCount);
 
     // Compute bounds
-    if (!cpu.vertices.empty()) {
+    if (vertexCount > 0) {
         rtData.boundsMin = DirectX::XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
         rtData.boundsMax = DirectX::XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
 
-        for (const auto& v : cpu.vertices) {
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            const SVertexPNT& v = vertices[i];
             rtData.boundsMin.x = std::min(rtData.boundsMin.x, v.px);
             rtData.boundsMin.y = std::min(rtData.boundsMin.y, v.py);
             rtData.boundsMin.z = std::min(rtData.boundsMin.z, v.pz);
@@ -127,6 +140,117 @@ static void ApplyUV2ToMesh(SMeshCPU_PNT& cpu, int texelsPerUnit = 16) {
                  static_cast<int>(cpu.indices.size()));
 }
 
+static bool EndsWith(const std::string& s, const char* suffix) {
+    size_t n = strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+static double MillisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+bool CMeshResourceManager::MakeDerivedDataKey(const std::string& sourcePath, bool generateLightmapUV2,
+                                              SDerivedDataKey& outKey) const {
+    CDerivedDataKeyBuilder builder("mesh", FFMESH_VERSION);
+    if (!builder.AddFile(sourcePath)) {
+        return false;
+    }
+
+    // .gltf geometry lives in separate .bin files
+    std::string lower = sourcePath;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    if (EndsWith(lower, ".gltf")) {
+        std::vector<std::string> buffers;
+        if (!GetGltfBufferFiles(sourcePath, buffers)) {
+            return false;
+        }
+        for (const std::string& buffer : buffers) {
+            if (!builder.AddFile(buffer)) {
+                return false;
+            }
+        }
+    }
+
+    builder.Add(GetImportOptions(generateLightmapUV2));
+    builder.Add(m_optimizeOptions.overdrawThreshold);
+    builder.Add(m_lodOptions.lodCount).Add(m_lodOptions.reduction).Add(m_lodOptions.maxError)
+           .Add(m_lodOptions.minTriangles).Add(m_lodOptions.minReduction);
+    outKey = builder.Build();
+    return true;
+}
+
+uint32_t CMeshResourceManager::GetImportOptions(bool generateLightmapUV2) const {
+    uint32_t options = generateLightmapUV2 ? FFMeshImport_LightmapUV2 : FFMeshImport_None;
+    if (m_optimizeOptions.vertexCache) options |= FFMeshImport_VertexCache;
+    if (m_optimizeOptions.overdraw) options |= FFMeshImport_Overdraw;
+    if (m_optimizeOptions.vertexFetch) options |= FFMeshImport_VertexFetch;
+    if (m_lodOptions.lodCount > 1) options |= FFMeshImport_Lods;
+    return options;
+}
+
+bool CMeshResourceManager::ImportSourceMesh(const std::string& path, const std::string& lowerPath,
+                                            bool generateLightmapUV2, const SMeshOptimizeOptions& optimize,
+                                            const SMeshLodOptions& lodOptions,
+                                            std::vector<SMeshCPU_PNT>& outMeshes,
+                                            std::vector<SMeshOptimizeReport>& outReports) {
+    // Reordering runs last: xatlas (UV2) rebuilds the index buffer.
+    // LODs index the final (fetch-ordered) vertices, so they come after it.
+    auto finish = [&](SMeshCPU_PNT& mesh) {
+        if (generateLightmapUV2) {
+            ApplyUV2ToMesh(mesh);
+        }
+        SMeshOptimizeReport report = OptimizeMesh(mesh, optimize);
+        if (lodOptions.lodCount > 1) {
+            GenerateMeshLods(mesh, lodOptions);
+        }
+        return report;
+    };
+
+    // Load OBJ
+    if (EndsWith(lowerPath, ".obj")) {
+        SMeshCPU_PNT cpu;
+        if (!LoadOBJ_PNT(path, cpu, /*flipZ*/true, /*flipWinding*/true)) {
+            return false;
+        }
+        RecenterAndScale(cpu, 2.0f);
+        outReports.push_back(finish(cpu));
+        outMeshes.push_back(std::move(cpu));
+        return true;
+    }
+
+    // Load glTF / GLB
+    // Geometry stays in mesh space, one sub-mesh per primitive: node transforms
+    // and instancing are applied by the scene (see CScene::ImportModel).
+    // Textures and materials are managed separately by MaterialAsset system.
+    if (EndsWith(lowerPath, ".gltf") || EndsWith(lowerPath, ".glb")) {
+        SGltfSceneCPU scene;
+        SGltfLoadStats stats;
+        if (!LoadGLTFScene(path, scene, SGltfLoadOptions(), &stats) || scene.primitives.empty()) {
+            return false;
+        }
+        CFFLog::Info("[GltfLoader] %s: %u primitives, %zu meshes, %zu nodes, %u bulk / %u converted accessors "
+                     "(parse %.2f ms, geometry %.2f ms)", path.c_str(), stats.primitives, scene.meshes.size(),
+                     scene.nodes.size(), stats.bulkAccessors, stats.convertedAccessors, stats.parseMs, stats.geometryMs);
+
+        // Primitives are independent: UV2, reordering and LODs run one per job
+        const uint32_t count = (uint32_t)scene.primitives.size();
+        const size_t first = outMeshes.size();
+        outMeshes.resize(first + count);
+        outReports.resize(first + count);
+        CJobSystem::Instance().ParallelFor(count, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                SMeshCPU_PNT& mesh = outMeshes[first + i];
+                mesh = std::move(scene.primitives[i].mesh);
+                outReports[first + i] = finish(mesh);
+            }
+        });
+        return true;
+    }
+
+    return false;
+}
+
 std::vector<std::shared_ptr<GpuMeshResource>> CMeshResourceManager::GetOrLoad(
     const std::string& path,
     bool cacheForRayTracing,
@@ -157,6 +281,7 @@ std::vector<std::shared_ptr<GpuMeshResource>> CMeshResourceManager::GetOrLoad(
         }
 
         if (allValid && !result.empty()) {
+            m_loadStats.memoryHits++;
             return result; // Cache hit
         }
 
@@ -165,91 +290,114 @@ std::vector<std::shared_ptr<GpuMeshResource>> CMeshResourceManager::GetOrLoad(
     }
 
     // Cache miss - load from disk
+    auto start = std::chrono::high_resolution_clock::now();
     std::string lower = path;
     std::transform(lower.begin(), lower.end(), lower.begin(),
                    [](unsigned char c) { return std::tolower(c); });
 
     std::vector<std::shared_ptr<GpuMeshResource>> resources;
 
-    // Load OBJ
-    if (lower.size() >= 4 && lower.substr(lower.size() - 4) == ".obj") {
-        SMeshCPU_PNT cpu;
-        if (!LoadOBJ_PNT(path, cpu, /*flipZ*/true, /*flipWinding*/true)) {
-            return {};
+    if (EndsWith(lower, ".ffmesh")) {
+        // Cooked file referenced directly
+        CFFMeshFile cooked;
+        if (cooked.Open(path)) {
+            resources = UploadCooked(cooked, path, cacheForRayTracing);
+            m_loadStats.cookedLoads++;
+            m_loadStats.cookedBytes += cooked.GetFileSize();
+            m_loadStats.cookedLoadMs += MillisecondsSince(start);
         }
-        RecenterAndScale(cpu, 2.0f);
-
-        // Generate UV2 if requested (must be before ray tracing cache)
-        if (generateLightmapUV2) {
-            ApplyUV2ToMesh(cpu);
-        }
-
-        // Cache for ray tracing if requested
-        if (cacheForRayTracing) {
-            CacheMeshForRayTracing(cpu, path, 0);
-        }
-
-        auto resource = UploadMesh(cpu);
-        if (resource) {
-            resources.push_back(resource);
-        }
-    }
-    // Load glTF
-    else if (lower.size() >= 5 && lower.substr(lower.size() - 5) == ".gltf") {
-        std::vector<SGltfMeshCPU> meshes;
-        if (!LoadGLTF_PNT(path.c_str(), meshes, /*flipZ_to_LH*/true, /*flipWinding*/true)) {
-            return {};
+    } else {
+        CDerivedDataCache& ddc = CDerivedDataCache::Instance();
+        SDerivedDataKey ddcKey;
+        bool cacheable = m_diskCacheEnabled && MakeDerivedDataKey(path, generateLightmapUV2, ddcKey);
+
+        // Cooked cache hit: map the DDC entry and upload, no parsing
+        CMappedFile mapped;
+        size_t offset = 0;
+        if (cacheable && ddc.Map(ddcKey, mapped, offset)) {
+            CFFMeshFile cooked;
+            if (cooked.Open(std::move(mapped), offset, ddcKey.ToString())) {
+                resources = UploadCooked(cooked, path, cacheForRayTracing);
+                double ms = MillisecondsSince(start);
+                m_loadStats.cookedLoads++;
+                m_loadStats.cookedBytes += cooked.GetFileSize();
+                m_loadStats.cookedLoadMs += ms;
+                CFFLog::Info("[MeshResourceManager] %s: cooked cache hit (%.2f ms)", path.c_str(), ms);
+            } else {
+                ddc.Remove(ddcKey);
+            }
         }
 
-        uint32_t subMeshIndex = 0;
-        for (auto& gltfMesh : meshes) {
-            // // Generate UV2 if requested (must be before ray tracing cache)
-            // if (generateLightmapUV2) {
-            //     ApplyUV2ToMesh(gltfMesh.mesh);
-            // }
-
-            // Cache for ray tracing if requested
-            if (cacheForRayTracing) {
-                CacheMeshForRayTracing(gltfMesh.mesh, path, subMeshIndex);
+        if (resources.empty()) {
+            std::vector<SMeshCPU_PNT> meshes;
+            std::vector<SMeshOptimizeReport> reports;
+            auto importStart = std::chrono::high_resolution_clock::now();
+            if (!ImportSourceMesh(path, lower, generateLightmapUV2, m_optimizeOptions, m_lodOptions, meshes, reports)) {
+                return {};
             }
-
-            auto resource = UploadGltfMesh(gltfMesh);
-            if (resource) {
-                resources.push_back(resource);
+            double importMs = MillisecondsSince(importStart);
+
+            for (size_t i = 0; i < reports.size(); i++) {
+                const SMeshOptimizeReport& r = reports[i];
+                m_loadStats.optimizedMeshes++;
+                m_loadStats.optimizedTriangles += r.after.triangles;
+                m_loadStats.cacheMissesBefore += r.before.misses;
+                m_loadStats.cacheMissesAfter += r.after.misses;
+                m_loadStats.optimizeMs += r.ms;
+                CFFLog::Info("[MeshOptimizer] %s[%zu]: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %u -> %u vertices (%.2f ms)",
+                             path.c_str(), i, r.before.acmr, r.after.acmr, r.before.atvr, r.after.atvr,
+                             r.verticesBefore, r.verticesAfter, r.ms);
+                if (!meshes[i].lods.empty()) {
+                    std::string chain = std::to_string(meshes[i].indices.size() / 3);
+                    for (const SMeshLodCPU& lod : meshes[i].lods) {
+                        char level[48];
+                        snprintf(level, sizeof(level), " -> %zu (%.4f)", lod.indices.size() / 3, lod.error);
+                        chain += level;
+                    }
+                    CFFLog::Info("[MeshSimplifier] %s[%zu]: triangles %s", path.c_str(), i, chain.c_str());
+                }
             }
-            subMeshIndex++;
-        }
-    }
-    // Load GLB (same as glTF)
-    else if (lower.size() >= 4 && lower.substr(lower.size() - 4) == ".glb") {
-        std::vector<SGltfMeshCPU> meshes;
-        if (!LoadGLTF_PNT(path.c_str(), meshes, /*flipZ_to_LH*/true, /*flipWinding*/true)) {
-            return {};
-        }
-
-        uint32_t subMeshIndex = 0;
-        for (auto& gltfMesh : meshes) {
-            // // Generate UV2 if requested (must be before ray tracing cache)
-            // if (generateLightmapUV2) {
-            //     ApplyUV2ToMesh(gltfMesh.mesh);
-            // }
 
-            // Cache for ray tracing if requested
-            if (cacheForRayTracing) {
-                CacheMeshForRayTracing(gltfMesh.mesh, path, subMeshIndex);
+            if (cacheable) {
+                std::vector<const SMeshCPU_PNT*> subMeshes;
+                for (const auto& mesh : meshes) subMeshes.push_back(&mesh);
+                SFFMeshSourceKey sourceKey;
+                GetFFMeshSourceKey(path, GetImportOptions(generateLightmapUV2), sourceKey);
+                std::vector<uint8_t> bytes;
+                SerializeFFMesh(sourceKey, subMeshes, bytes);
+                ddc.Put(ddcKey, bytes, importMs);
             }
 
-            auto resource = UploadGltfMesh(gltfMesh);
-            if (resource) {
-                resources.push_back(resource);
+            uint32_t subMeshIndex = 0;
+            for (const auto& mesh : meshes) {
+                // Cache for ray tracing if requested
+                if (cacheForRayTracing) {
+                    CacheMeshForRayTracing(mesh.vertices.data(), (uint32_t)mesh.vertices.size(),
+                                           mesh.indices.data(), (uint32_t)mesh.indices.size(),
+                                           path, subMeshIndex);
+                }
+
+                auto resource = UploadMesh(mesh);
+                if (resource) {
+                    resources.push_back(resource);
+                }
+                subMeshIndex++;
             }
-            subMeshIndex++;
+
+            double ms = MillisecondsSince(start);
+            m_loadStats.sourceLoads++;
+            m_loadStats.sourceLoadMs += ms;
+            CFFLog::Info("[MeshResourceManager] %s: imported%s (%.2f ms)", path.c_str(),
+                         cacheable ? " and cooked" : "", ms);
         }
     }
 
     if (resources.empty()) {
         return {};
     }
+    for (size_t i = 0; i < resources.size(); i++) {
+        resources[i]->subMeshIndex = (uint32_t)i;
+    }
 
     // Store in cache as weak_ptr
     std::vector<std::weak_ptr<GpuMeshResource>> weakPtrs;
@@ -261,8 +409,84 @@ std::vector<std::shared_ptr<GpuMeshResource>> CMeshResourceManager::GetOrLoad(
     return resources;
 }
 
-std::shared_ptr<GpuMeshResource> CMeshResourceManager::UploadMesh(
-    const SMeshCPU_PNT& cpu
+std::vector<std::shared_ptr<GpuMeshResource>> CMeshResourceManager::UploadCooked(
+    const CFFMeshFile& file, const std::string& path, bool cacheForRayTracing
+) {
+    std::vector<std::shared_ptr<GpuMeshResource>> resources;
+    for (uint32_t i = 0; i < file.GetSubMeshCount(); i++) {
+        const SFFMeshSubMesh& desc = file.GetSubMesh(i);
+
+        if (cacheForRayTracing) {
+            CacheMeshForRayTracing(file.GetVertices(i), desc.vertexCount,
+                                   file.GetIndices(i), desc.indexCount, path, i);
+        }
+
+        // LOD index runs follow LOD0 in the file, so the whole range uploads as one buffer
+        std::vector<SGpuMeshLod> lods(file.GetLodCount(i));
+        for (uint32_t l = 0; l < lods.size(); l++) {
+            const SFFMeshLod& lod = file.GetLod(i, l);
+            lods[l] = SGpuMeshLod{lod.firstIndex, lod.indexCount, lod.error};
+        }
+        auto resource = UploadBuffers(file.GetVertices(i), desc.vertexCount, file.GetIndices(i), desc.indexCount, lods);
+        if (!resource) {
+            return {};
+        }
+        if (desc.vertexCount > 0) {
+            resource->localBoundsMin = DirectX::XMFLOAT3(desc.boundsMin[0], desc.boundsMin[1], desc.boundsMin[2]);
+            resource->localBoundsMax = DirectX::XMFLOAT3(desc.boundsMax[0], desc.boundsMax[1], desc.boundsMax[2]);
+            resource->hasBounds = true;
+        }
+        resources.push_back(resource);
+    }
+    return resources;
+}
+
+void CMeshResourceManager::LogLoadReport() const {
+    const SLoadStats& s = m_loadStats;
+    CFFLog::Info("[MeshResourceManager] Load report: %u memory hits", s.memoryHits);
+    CFFLog::Info("[MeshResourceManager]   cooked : %u meshes, %.2f ms (%.3f ms avg), %.2f MB mapped",
+                 s.cookedLoads, s.cookedLoadMs, s.cookedLoads ? s.cookedLoadMs / s.cookedLoads : 0.0,
+                 s.cookedBytes / (1024.0 * 1024.0));
+    CFFLog::Info("[MeshResourceManager]   source : %u meshes, %.2f ms (%.3f ms avg)",
+                 s.sourceLoads, s.sourceLoadMs, s.sourceLoads ? s.sourceLoadMs / s.sourceLoads : 0.0);
+    CFFLog::Info("[MeshResourceManager]   layout : %u packed, %u full, %.2f MB vertex data (%.2f MB as SVertexPNT)",
+                 s.packedMeshes, s.fullMeshes, s.vertexBytes / (1024.0 * 1024.0), s.vertexBytesFull / (1024.0 * 1024.0));
+    CFFLog::Info("[MeshResourceManager]   index  : %u meshes 16-bit, %.2f MB index data",
+                 s.index16Meshes, s.indexBytes / (1024.0 * 1024.0));
+    if (s.optimizedTriangles > 0) {
+        CFFLog::Info("[MeshResourceManager]   reorder: %u meshes, ACMR %.3f -> %.3f, %.2f ms",
+                     s.optimizedMeshes, (double)s.cacheMissesBefore / s.optimizedTriangles,
+                     (double)s.cacheMissesAfter / s.optimizedTriangles, s.optimizeMs);
+    }
+    if (s.lodMeshes > 0) {
+        CFFLog::Info("[MeshResourceManager]   lod    : %u meshes, %u levels, %.2f MB index data",
+                     s.lodMeshes, s.lodLevels, s.lodIndexBytes / (1024.0 * 1024.0));
+    }
+}
+
+EVertexLayout CMeshResourceManager::SelectVertexLayout(const SVertexPNT* vertices, uint32_t vertexCount,
+                                                       EVertexLayoutMode mode, const SVertexPackingTolerance& tolerance,
+                                                       SVertexPackingError* outError) {
+    if (mode == EVertexLayoutMode::Full || vertexCount == 0) {
+        return EVertexLayout::Full;
+    }
+
+    SVertexPackingError error = MeasurePackingError(vertices, vertexCount);
+    if (outError) {
+        *outError = error;
+    }
+
+    if (mode == EVertexLayoutMode::Auto) {
+        return tolerance.Accepts(error) ? EVertexLayout::Packed : EVertexLayout::Full;
+    }
+    // Forced: only refuse what half cannot represent at all
+    return std::isfinite(error.maxPosition) ? EVertexLayout::Packed : EVertexLayout::Full;
+}
+
+std::shared_ptr<GpuMeshResource> CMeshResourceManager::UploadBuffers(
+    const SVertexPNT* vertices, uint32_t vertexCount,
+    const uint32_t* indices, uint32_t indexCount,
+    const std::vector<SGpuMeshLod>& lods
 ) {
     RHI::IRenderContext* rhiCtx = RHI::CRHIManager::Instance().GetRenderContext();
     if (!rhiCtx) {
@@ -270,28 +494,98 @@ std::shared_ptr<GpuMeshResource> CMeshResourceManager::UploadMesh(
     }
 
     auto resource = std::make_shared<GpuMeshResource>();
+    resource->vertexCount = vertexCount;
+    resource->layout = SelectVertexLayout(vertices, vertexCount, m_vertexLayoutMode, m_packingTolerance);
 
-    // Create VBO using RHI
     RHI::BufferDesc vboDesc;
-    vboDesc.size = static_cast<uint32_t>(cpu.vertices.size() * sizeof(SVertexPNT));
     vboDesc.usage = RHI::EBufferUsage::Vertex;
     vboDesc.cpuAccess = RHI::ECPUAccess::None;
-    resource->vbo.reset(rhiCtx->CreateBuffer(vboDesc, cpu.vertices.data()));
-    if (!resource->vbo) {
-        return nullptr;
+
+    if (resource->layout == EVertexLayout::Packed) {
+        // Position stream + attribute stream
+        SPackedMesh packed;
+        PackVertices(vertices, vertexCount, packed);
+
+        vboDesc.size = static_cast<uint32_t>(vertexCount * sizeof(SPackedPosition));
+        resource->positionVbo.reset(rhiCtx->CreateBuffer(vboDesc, packed.positions.data()));
+        vboDesc.size = static_cast<uint32_t>(vertexCount * sizeof(SPackedAttributes));
+        resource->vbo.reset(rhiCtx->CreateBuffer(vboDesc, packed.attributes.data()));
+        if (!resource->positionVbo || !resource->vbo) {
+            return nullptr;
+        }
+        m_loadStats.packedMeshes++;
+    } else {
+        // Create VBO using RHI
+        vboDesc.size = static_cast<uint32_t>(vertexCount * sizeof(SVertexPNT));
+        resource->vbo.reset(rhiCtx->CreateBuffer(vboDesc, vertices));
+        if (!resource->vbo) {
+            return nullptr;
+        }
+        m_loadStats.fullMeshes++;
     }
+    m_loadStats.vertexBytes += resource->GetVertexBytes();
+    m_loadStats.vertexBytesFull += (uint64_t)vertexCount * sizeof(SVertexPNT);
 
-    // Create IBO using RHI
+    // Create IBO using RHI (narrowed to 16-bit when every index fits)
+    uint32_t totalIndexCount = indexCount;
+    for (const SGpuMeshLod& lod : lods) {
+        totalIndexCount = std::max(totalIndexCount, lod.firstIndex + lod.indexCount);
+    }
     RHI::BufferDesc iboDesc;
-    iboDesc.size = static_cast<uint32_t>(cpu.indices.size() * sizeof(uint32_t));
     iboDesc.usage = RHI::EBufferUsage::Index;
     iboDesc.cpuAccess = RHI::ECPUAccess::None;
-    resource->ibo.reset(rhiCtx->CreateBuffer(iboDesc, cpu.indices.data()));
+    if (CanUse16BitIndices(vertexCount)) {
+        std::vector<uint16_t> narrow(totalIndexCount);
+        for (uint32_t i = 0; i < totalIndexCount; i++) {
+            narrow[i] = static_cast<uint16_t>(indices[i]);
+        }
+        iboDesc.size = static_cast<uint32_t>(totalIndexCount * sizeof(uint16_t));
+        resource->ibo.reset(rhiCtx->CreateBuffer(iboDesc, narrow.data()));
+        resource->indexFormat = RHI::EIndexFormat::UInt16;
+        m_loadStats.index16Meshes++;
+    } else {
+        iboDesc.size = static_cast<uint32_t>(totalIndexCount * sizeof(uint32_t));
+        resource->ibo.reset(rhiCtx->CreateBuffer(iboDesc, indices));
+        resource->indexFormat = RHI::EIndexFormat::UInt32;
+    }
     if (!resource->ibo) {
         return nullptr;
     }
 
-    resource->indexCount = static_cast<uint32_t>(cpu.indices.size());
+    resource->indexCount = indexCount;
+    resource->lods = lods;
+    m_loadStats.indexBytes += resource->GetIndexBytes();
+    if (!lods.empty()) {
+        m_loadStats.lodMeshes++;
+        m_loadStats.lodLevels += static_cast<uint32_t>(lods.size());
+        m_loadStats.lodIndexBytes += (uint64_t)(totalIndexCount - indexCount) *
+            (resource->indexFormat == RHI::EIndexFormat::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t));
+    }
+    return resource;
+}
+
+std::shared_ptr<GpuMeshResource> CMeshResourceManager::UploadMesh(
+    const SMeshCPU_PNT& cpu
+) {
+    std::shared_ptr<GpuMeshResource> resource;
+    if (cpu.lods.empty()) {
+        resource = UploadBuffers(cpu.vertices.data(), static_cast<uint32_t>(cpu.vertices.size()),
+                                 cpu.indices.data(), static_cast<uint32_t>(cpu.indices.size()));
+    } else {
+        // One index buffer: LOD0 then each level
+        std::vector<uint32_t> indices(cpu.indices);
+        std::vector<SGpuMeshLod> lods;
+        for (const SMeshLodCPU& lod : cpu.lods) {
+            lods.push_back(SGpuMeshLod{static_cast<uint32_t>(indices.size()),
+                                       static_cast<uint32_t>(lod.indices.size()), lod.error});
+            indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+        }
+        resource = UploadBuffers(cpu.vertices.data(), static_cast<uint32_t>(cpu.vertices.size()),
+                                 indices.data(), static_cast<uint32_t>(cpu.indices.size()), lods);
+    }
+    if (!resource) {
+        return nullptr;
+    }
 
     // Compute AABB from vertices
     if (!cpu.vertices.empty()) {
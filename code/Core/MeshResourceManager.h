@@ -1,5 +1,7 @@
 #pragma once
 #include "GpuMeshResource.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -7,9 +9,22 @@
 
 // Forward declarations
 struct SMeshCPU_PNT;
+struct SVertexPNT;
 struct SGltfMeshCPU;
+class CFFMeshFile;
+struct SDerivedDataKey;
 
 // Manages GPU mesh resources with path-based caching and automatic deduplication
+//
+// Cooked mesh cache:
+// Importing a source mesh (.obj/.gltf/.glb: parse, recenter, tangents, xatlas UV2)
+// is done once; the result is stored as .ffmesh bytes in the derived-data cache
+// ("mesh" entries, see DerivedDataCache.h), keyed by the source bytes (and .gltf
+// buffers) + import settings. Later loads map the entry and upload it directly
+// (see FFMeshLoader.h). .ffmesh files can also be loaded by path.
+//
+// Imported meshes are reordered for the vertex cache and vertex fetch before
+// cooking (see MeshOptimizer.h); meshes under 64K vertices get 16-bit indices.
 class CMeshResourceManager {
 public:
     // Get singleton instance
@@ -17,7 +32,7 @@ public:
 
     // Load or retrieve cached mesh resource by path
     // Returns nullptr on failure
-    // Supports .obj and .gltf files
+    // Supports .obj, .gltf, .glb and cooked .ffmesh files
     // For glTF files with multiple sub-meshes, returns a vector
     // If cacheForRayTracing is true, also stores mesh data in CRayTracingMeshCache
     // If generateLightmapUV2 is true, generates UV2 coordinates using xatlas
@@ -33,6 +48,68 @@ public:
     // Clear all cached resources
     void ClearCache();
 
+    // Cooked mesh cache (on by default; off = always import from source, nothing written)
+    void SetDiskCacheEnabled(bool enabled) { m_diskCacheEnabled = enabled; }
+    bool IsDiskCacheEnabled() const { return m_diskCacheEnabled; }
+
+    // DDC key of a source mesh with the current settings; false if the source
+    // (or one of its .gltf buffers) cannot be read
+    bool MakeDerivedDataKey(const std::string& sourcePath, bool generateLightmapUV2, SDerivedDataKey& outKey) const;
+
+    // GPU vertex layout for newly uploaded meshes (see Core/PackedVertex.h).
+    // Meshes already in the cache keep their layout until ClearCache().
+    enum class EVertexLayoutMode {
+        Full,       // Always SVertexPNT
+        Packed,     // Always packed, unless positions overflow half precision
+        Auto        // Packed when the round-trip error is within the packing tolerance
+    };
+    void SetVertexLayoutMode(EVertexLayoutMode mode) { m_vertexLayoutMode = mode; }
+    EVertexLayoutMode GetVertexLayoutMode() const { return m_vertexLayoutMode; }
+    void SetPackingTolerance(const SVertexPackingTolerance& tolerance) { m_packingTolerance = tolerance; }
+    const SVertexPackingTolerance& GetPackingTolerance() const { return m_packingTolerance; }
+
+    // Index / vertex reordering applied at import. Part of the cooked key, so
+    // changing it re-imports meshes on their next load.
+    void SetOptimizeOptions(const SMeshOptimizeOptions& options) { m_optimizeOptions = options; }
+    const SMeshOptimizeOptions& GetOptimizeOptions() const { return m_optimizeOptions; }
+
+    // LOD chain built at import (after reordering). lodCount <= 1 disables it.
+    // Part of the cooked key; ClearCache() to reload meshes already in memory.
+    void SetLodOptions(const SMeshLodOptions& options) { m_lodOptions = options; }
+    const SMeshLodOptions& GetLodOptions() const { return m_lodOptions; }
+
+    // Per-mesh layout decision (no GPU work); outError receives the measured error if not null
+    static EVertexLayout SelectVertexLayout(const SVertexPNT* vertices, uint32_t vertexCount,
+                                            EVertexLayoutMode mode, const SVertexPackingTolerance& tolerance,
+                                            SVertexPackingError* outError = nullptr);
+
+    // Load timing, GPU upload included
+    struct SLoadStats {
+        uint32_t memoryHits = 0;        // Resource still alive in m_cache
+        uint32_t cookedLoads = 0;       // Mapped .ffmesh
+        uint32_t sourceLoads = 0;       // Imported from .obj / .gltf (and cooked)
+        double cookedLoadMs = 0.0;
+        double sourceLoadMs = 0.0;
+        uint64_t cookedBytes = 0;
+        uint32_t packedMeshes = 0;      // Uploaded with the packed vertex layout
+        uint32_t fullMeshes = 0;        // Uploaded with SVertexPNT
+        uint64_t vertexBytes = 0;       // Vertex memory actually uploaded
+        uint64_t vertexBytesFull = 0;   // Same meshes as SVertexPNT
+        uint32_t index16Meshes = 0;     // Uploaded with 16-bit indices
+        uint64_t indexBytes = 0;        // Index memory actually uploaded
+        uint32_t optimizedMeshes = 0;   // Reordered at import (cooked loads are already optimized)
+        uint64_t optimizedTriangles = 0;
+        uint64_t cacheMissesBefore = 0; // FIFO(kVertexCacheAnalyzeSize) misses over optimized meshes
+        uint64_t cacheMissesAfter = 0;
+        double optimizeMs = 0.0;
+        uint32_t lodMeshes = 0;         // Uploaded with at least one LOD
+        uint32_t lodLevels = 0;         // LOD1..N over all meshes
+        uint64_t lodIndexBytes = 0;     // Part of indexBytes
+    };
+    const SLoadStats& GetLoadStats() const { return m_loadStats; }
+    void ResetLoadStats() { m_loadStats = SLoadStats(); }
+    void LogLoadReport() const;
+
 private:
     CMeshResourceManager() = default;
     ~CMeshResourceManager() = default;
@@ -46,15 +123,49 @@ private:
         const SMeshCPU_PNT& cpu
     );
 
+    // Create VBO / IBO (bounds are left to the caller). indices holds LOD0
+    // (indexCount) followed by the ranges in lods.
+    std::shared_ptr<GpuMeshResource> UploadBuffers(
+        const SVertexPNT* vertices, uint32_t vertexCount,
+        const uint32_t* indices, uint32_t indexCount,
+        const std::vector<SGpuMeshLod>& lods = {}
+    );
+
+    // Upload every sub-mesh of a mapped .ffmesh straight from the mapping
+    std::vector<std::shared_ptr<GpuMeshResource>> UploadCooked(
+        const CFFMeshFile& file, const std::string& path, bool cacheForRayTracing
+    );
+
+    // Import a source mesh into final vertex / index streams (one per sub-mesh)
+    // Optimizes each sub-mesh with optimize, reports go to outReports (one per sub-mesh),
+    // then builds its LOD chain with lodOptions
+    static bool ImportSourceMesh(const std::string& path, const std::string& lowerPath,
+                                 bool generateLightmapUV2, const SMeshOptimizeOptions& optimize,
+                                 const SMeshLodOptions& lodOptions,
+                                 std::vector<SMeshCPU_PNT>& outMeshes,
+                                 std::vector<SMeshOptimizeReport>& outReports);
+
+    // Cooked-key import flags for the current settings
+    uint32_t GetImportOptions(bool generateLightmapUV2) const;
+
     // Upload glTF mesh to GPU (with textures)
     std::shared_ptr<GpuMeshResource> UploadGltfMesh(
         const SGltfMeshCPU& gltfMesh
     );
 
     // Cache mesh data for ray tracing
-    void CacheMeshForRayTracing(const SMeshCPU_PNT& cpu, const std::string& path, uint32_t subMeshIndex);
+    void CacheMeshForRayTracing(const SVertexPNT* vertices, uint32_t vertexCount,
+                                const uint32_t* indices, uint32_t indexCount,
+                                const std::string& path, uint32_t subMeshIndex);
 
 private:
     // Cache: path -> weak_ptr (allows resources to be freed when no longer used)
     std::unordered_map<std::string, std::vector<std::weak_ptr<GpuMeshResource>>> m_cache;
+
+    bool m_diskCacheEnabled = true;
+    EVertexLayoutMode m_vertexLayoutMode = EVertexLayoutMode::Full;
+    SVertexPackingTolerance m_packingTolerance;
+    SMeshOptimizeOptions m_optimizeOptions;
+    SMeshLodOptions m_lodOptions;
+    SLoadStats m_loadStats;
 };
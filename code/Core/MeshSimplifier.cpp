@@ -0,0 +1,534 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+    const uint32_t kNone = 0xFFFFFFFFu;
+    const double kBoundaryWeight = 10.0;
+
+    enum EVertexKind : uint8_t {
+        Kind_Manifold,
+        Kind_Border,
+        Kind_Seam,
+        Kind_Locked,
+        Kind_Count
+    };
+
+    // kCanCollapse[from][to]
+    const bool kCanCollapse[Kind_Count][Kind_Count] = {
+        {true,  true,  true,  true },
+        {false, true,  false, true },
+        {false, false, true,  true },
+        {false, false, false, false},
+    };
+
+    // Edges between these kinds appear in both directions (in position space),
+    // so only one direction is considered
+    const bool kHasOpposite[Kind_Count][Kind_Count] = {
+        {true,  true,  true,  true },
+        {true,  false, true,  false},
+        {true,  true,  true,  true },
+        {true,  false, true,  false},
+    };
+
+    struct SVec3 {
+        double x, y, z;
+    };
+
+    SVec3 sub(const SVec3& a, const SVec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+    double dot(const SVec3& a, const SVec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    SVec3 cross(const SVec3& a, const SVec3& b) {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+    double length(const SVec3& a) { return std::sqrt(dot(a, a)); }
+
+    // Symmetric 4x4 quadric: error(p) = p'Ap + 2b'p + c, weighted by w
+    struct SQuadric {
+        double a00 = 0, a11 = 0, a22 = 0, a10 = 0, a20 = 0, a21 = 0;
+        double b0 = 0, b1 = 0, b2 = 0, c = 0;
+        double w = 0;
+
+        static SQuadric FromPlane(const SVec3& n, double d, double weight) {
+            SQuadric q;
+            q.a00 = weight * n.x * n.x;
+            q.a11 = weight * n.y * n.y;
+            q.a22 = weight * n.z * n.z;
+            q.a10 = weight * n.y * n.x;
+            q.a20 = weight * n.z * n.x;
+            q.a21 = weight * n.z * n.y;
+            q.b0 = weight * n.x * d;
+            q.b1 = weight * n.y * d;
+            q.b2 = weight * n.z * d;
+            q.c = weight * d * d;
+            q.w = weight;
+            return q;
+        }
+
+        void Add(const SQuadric& o) {
+            a00 += o.a00; a11 += o.a11; a22 += o.a22;
+            a10 += o.a10; a20 += o.a20; a21 += o.a21;
+            b0 += o.b0; b1 += o.b1; b2 += o.b2;
+            c += o.c;
+            w += o.w;
+        }
+
+        // Weighted mean squared distance of p to the accumulated planes
+        double Error(const SVec3& p) const {
+            double rx = p.x * a00 + 2.0 * (p.y * a10 + p.z * a20 + b0);
+            double ry = p.y * a11 + 2.0 * (p.z * a21 + b1);
+            double rz = p.z * a22 + 2.0 * b2;
+            double r = rx * p.x + ry * p.y + rz * p.z + c;
+            return w > 0.0 ? std::fabs(r) / w : 0.0;
+        }
+    };
+
+    struct SPositionKey {
+        uint32_t x, y, z;
+        bool operator==(const SPositionKey& o) const { return x == o.x && y == o.y && z == o.z; }
+    };
+
+    struct SPositionKeyHash {
+        size_t operator()(const SPositionKey& k) const {
+            return (size_t)((k.x * 73856093u) ^ (k.y * 19349663u) ^ (k.z * 83492791u));
+        }
+    };
+
+    uint32_t floatBits(float f) {
+        f += 0.0f;  // -0 and +0 weld
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    // Vertex -> items CSR (outgoing half-edges or triangles)
+    struct SAdjacency {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> items;
+
+        const uint32_t* Begin(uint32_t v) const { return items.data() + offsets[v]; }
+        const uint32_t* End(uint32_t v) const { return items.data() + offsets[v + 1]; }
+    };
+
+    // Half-edges a->b, stored as targets per source vertex
+    void buildEdges(SAdjacency& adj, const std::vector<uint32_t>& indices, uint32_t vertexCount) {
+        adj.offsets.assign(vertexCount + 1, 0);
+        for (uint32_t index : indices) adj.offsets[index + 1]++;
+        for (uint32_t v = 0; v < vertexCount; v++) adj.offsets[v + 1] += adj.offsets[v];
+        adj.items.resize(indices.size());
+        std::vector<uint32_t> fill(adj.offsets.begin(), adj.offsets.end() - 1);
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            for (int k = 0; k < 3; k++) {
+                adj.items[fill[indices[t + k]]++] = indices[t + (k + 1) % 3];
+            }
+        }
+    }
+
+    // Triangles per vertex
+    void buildTriangles(SAdjacency& adj, const std::vector<uint32_t>& indices, uint32_t vertexCount) {
+        adj.offsets.assign(vertexCount + 1, 0);
+        for (uint32_t index : indices) adj.offsets[index + 1]++;
+        for (uint32_t v = 0; v < vertexCount; v++) adj.offsets[v + 1] += adj.offsets[v];
+        adj.items.resize(indices.size());
+        std::vector<uint32_t> fill(adj.offsets.begin(), adj.offsets.end() - 1);
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            for (int k = 0; k < 3; k++) {
+                adj.items[fill[indices[t + k]]++] = static_cast<uint32_t>(t / 3);
+            }
+        }
+    }
+
+    bool hasEdge(const SAdjacency& edges, uint32_t a, uint32_t b) {
+        return std::find(edges.Begin(a), edges.End(a), b) != edges.End(a);
+    }
+
+    struct SCollapse {
+        uint32_t v0;        // Moves ...
+        uint32_t v1;        // ... onto this vertex
+        bool bidirectional;
+        double error;       // Squared, normalized units
+    };
+
+    class CSimplifier {
+    public:
+        CSimplifier(const SVertexPNT* vertices, uint32_t vertexCount)
+            : m_vertices(vertices), m_vertexCount(vertexCount), m_positions(vertexCount) {}
+
+        const SVertexPNT* m_vertices;
+        uint32_t m_vertexCount;
+        std::vector<SVec3> m_positions;     // Normalized to the unit cube
+        std::vector<uint32_t> m_remap;      // First vertex with the same position
+        std::vector<uint32_t> m_wedge;      // Next vertex with the same position (cycle)
+        std::vector<uint8_t> m_kind;
+        std::vector<uint32_t> m_loop;       // Target of the single open half-edge, or kNone
+        std::vector<SQuadric> m_quadrics;   // Per position (indexed by m_remap)
+
+        void WeldPositions() {
+            m_remap.resize(m_vertexCount);
+            m_wedge.resize(m_vertexCount);
+            std::unordered_map<SPositionKey, uint32_t, SPositionKeyHash> first;
+            first.reserve(m_vertexCount);
+            for (uint32_t v = 0; v < m_vertexCount; v++) {
+                const SVertexPNT& p = m_vertices[v];
+                SPositionKey key = {floatBits(p.px), floatBits(p.py), floatBits(p.pz)};
+                auto it = first.emplace(key, v).first;
+                uint32_t r = it->second;
+                m_remap[v] = r;
+                if (r == v) {
+                    m_wedge[v] = v;
+                } else {
+                    m_wedge[v] = m_wedge[r];
+                    m_wedge[r] = v;
+                }
+            }
+        }
+
+        void Classify(const std::vector<uint32_t>& indices) {
+            SAdjacency edges;
+            buildEdges(edges, indices, m_vertexCount);
+
+            // Single open half-edge in / out per vertex; the vertex itself marks "more than one"
+            std::vector<uint32_t> openIn(m_vertexCount, kNone), openOut(m_vertexCount, kNone);
+            for (uint32_t v = 0; v < m_vertexCount; v++) {
+                for (const uint32_t* e = edges.Begin(v); e != edges.End(v); e++) {
+                    uint32_t target = *e;
+                    if (!hasEdge(edges, target, v)) {
+                        openIn[target] = (openIn[target] == kNone) ? v : target;
+                        openOut[v] = (openOut[v] == kNone) ? target : v;
+                    }
+                }
+            }
+
+            m_kind.assign(m_vertexCount, Kind_Locked);
+            for (uint32_t v = 0; v < m_vertexCount; v++) {
+                if (m_remap[v] != v) continue;
+
+                uint8_t kind = Kind_Locked;
+                if (m_wedge[v] == v) {
+                    uint32_t in = openIn[v], out = openOut[v];
+                    if (in == kNone && out == kNone) {
+                        kind = Kind_Manifold;
+                    } else if (in != kNone && out != kNone && in != v && out != v) {
+                        kind = Kind_Border;
+                    }
+                } else if (m_wedge[m_wedge[v]] == v) {
+                    // Two copies, each with exactly one open edge in and out, and the
+                    // open edges of both copies run between the same two positions
+                    uint32_t w = m_wedge[v];
+                    uint32_t inV = openIn[v], outV = openOut[v], inW = openIn[w], outW = openOut[w];
+                    bool single = inV != kNone && inV != v && outV != kNone && outV != v &&
+                                  inW != kNone && inW != w && outW != kNone && outW != w;
+                    if (single && m_remap[inV] == m_remap[outW] && m_remap[outV] == m_remap[inW]) {
+                        kind = Kind_Seam;
+                    }
+                }
+                m_kind[v] = kind;
+            }
+            for (uint32_t v = 0; v < m_vertexCount; v++) {
+                m_kind[v] = m_kind[m_remap[v]];
+            }
+
+            m_loop.assign(m_vertexCount, kNone);
+            for (uint32_t v = 0; v < m_vertexCount; v++) {
+                if (openOut[v] != kNone && openOut[v] != v) {
+                    m_loop[v] = openOut[v];
+                }
+            }
+        }
+
+        void FillQuadrics(const std::vector<uint32_t>& indices) {
+            m_quadrics.assign(m_vertexCount, SQuadric());
+            for (size_t t = 0; t < indices.size(); t += 3) {
+                uint32_t i0 = indices[t], i1 = indices[t + 1], i2 = indices[t + 2];
+                const SVec3& p0 = m_positions[i0];
+                SVec3 n = cross(sub(m_positions[i1], p0), sub(m_positions[i2], p0));
+                double area2 = length(n);
+                if (area2 <= 0.0) continue;
+                n = {n.x / area2, n.y / area2, n.z / area2};
+                SQuadric q = SQuadric::FromPlane(n, -dot(n, p0), area2 * 0.5);
+                m_quadrics[m_remap[i0]].Add(q);
+                m_quadrics[m_remap[i1]].Add(q);
+                m_quadrics[m_remap[i2]].Add(q);
+            }
+
+            // Planes through open / seam edges, perpendicular to the triangle
+            for (size_t t = 0; t < indices.size(); t += 3) {
+                for (int k = 0; k < 3; k++) {
+                    uint32_t i0 = indices[t + k], i1 = indices[t + (k + 1) % 3], i2 = indices[t + (k + 2) % 3];
+                    uint8_t k0 = m_kind[i0], k1 = m_kind[i1];
+                    if (k0 != k1 || (k0 != Kind_Border && k0 != Kind_Seam) || m_loop[i0] != i1) continue;
+                    if (kHasOpposite[k0][k1] && m_remap[i1] > m_remap[i0]) continue;
+
+                    const SVec3& p0 = m_positions[i0];
+                    SVec3 p10 = sub(m_positions[i1], p0);
+                    SVec3 p20 = sub(m_positions[i2], p0);
+                    double len2 = dot(p10, p10);
+                    if (len2 <= 0.0) continue;
+                    double s = dot(p10, p20) / len2;
+                    SVec3 n = {p20.x - p10.x * s, p20.y - p10.y * s, p20.z - p10.z * s};
+                    double nl = length(n);
+                    if (nl <= 0.0) continue;
+                    n = {n.x / nl, n.y / nl, n.z / nl};
+                    SQuadric q = SQuadric::FromPlane(n, -dot(n, p0), len2 * kBoundaryWeight);
+                    m_quadrics[m_remap[i0]].Add(q);
+                    m_quadrics[m_remap[i1]].Add(q);
+                }
+            }
+        }
+
+        void PickCollapses(const std::vector<uint32_t>& indices, std::vector<SCollapse>& out) const {
+            out.clear();
+            for (size_t t = 0; t < indices.size(); t += 3) {
+                for (int k = 0; k < 3; k++) {
+                    uint32_t i0 = indices[t + k], i1 = indices[t + (k + 1) % 3];
+                    if (m_remap[i0] == m_remap[i1]) continue;
+
+                    uint8_t k0 = m_kind[i0], k1 = m_kind[i1];
+                    bool forward = kCanCollapse[k0][k1], backward = kCanCollapse[k1][k0];
+                    if (!forward && !backward) continue;
+                    if (kHasOpposite[k0][k1] && m_remap[i1] > m_remap[i0]) continue;
+                    // Border / seam vertices only slide along their own edge loop
+                    if (k0 == k1 && (k0 == Kind_Border || k0 == Kind_Seam) && m_loop[i0] != i1) continue;
+
+                    if (forward && backward) {
+                        out.push_back({i0, i1, true, 0.0});
+                    } else if (forward) {
+                        out.push_back({i0, i1, false, 0.0});
+                    } else {
+                        out.push_back({i1, i0, false, 0.0});
+                    }
+                }
+            }
+
+            // Cheaper direction; costs are read before any collapse of this pass
+            for (SCollapse& c : out) {
+                double e0 = m_quadrics[m_remap[c.v0]].Error(m_positions[c.v1]);
+                if (c.bidirectional) {
+                    double e1 = m_quadrics[m_remap[c.v1]].Error(m_positions[c.v0]);
+                    if (e1 < e0) {
+                        std::swap(c.v0, c.v1);
+                        e0 = e1;
+                    }
+                }
+                c.error = e0;
+            }
+        }
+
+        // Would moving v0 onto v1 flip (or nearly flip) any surviving triangle around v0?
+        bool HasFlips(const SAdjacency& triangles, const std::vector<uint32_t>& indices,
+                      const std::vector<uint32_t>& collapseRemap, uint32_t v0, uint32_t v1) const {
+            const SVec3& target = m_positions[v1];
+            const SVec3 targetNormal = {m_vertices[v1].nx, m_vertices[v1].ny, m_vertices[v1].nz};
+            const bool hasNormal = dot(targetNormal, targetNormal) > 0.0;
+            for (const uint32_t* t = triangles.Begin(v0); t != triangles.End(v0); t++) {
+                uint32_t c[3];
+                int corner = -1;
+                bool collapses = false;
+                for (int k = 0; k < 3; k++) {
+                    uint32_t v = indices[*t * 3 + k];
+                    if (v == v0) corner = k;
+                    c[k] = collapseRemap[v];
+                    if (v != v0 && m_remap[c[k]] == m_remap[v1]) collapses = true;
+                }
+                if (collapses || corner < 0) continue;
+
+                SVec3 p[3] = {m_positions[c[0]], m_positions[c[1]], m_positions[c[2]]};
+                SVec3 before = cross(sub(p[1], p[0]), sub(p[2], p[0]));
+                p[corner] = target;
+                SVec3 after = cross(sub(p[1], p[0]), sub(p[2], p[0]));
+                // Rotations past ~75 degrees count as flips: a 90 degree cutoff lets a
+                // triangle turn over through a series of near-perpendicular collapses
+                if (dot(before, after) <= 0.25 * length(before) * length(after)) return true;
+                // Small turns can still add up to a triangle facing away from the surface
+                if (hasNormal && dot(after, targetNormal) <= 0.0) return true;
+            }
+            return false;
+        }
+
+        // Seam partner of v1 for v0's copy s0: the copy of v1 that shares a triangle with s0
+        uint32_t SeamPartner(const SAdjacency& triangles, const std::vector<uint32_t>& indices,
+                             uint32_t s0, uint32_t v1) const {
+            for (const uint32_t* t = triangles.Begin(s0); t != triangles.End(s0); t++) {
+                for (int k = 0; k < 3; k++) {
+                    uint32_t v = indices[*t * 3 + k];
+                    if (m_remap[v] == m_remap[v1]) return v;
+                }
+            }
+            return kNone;
+        }
+    };
+}
+
+// ============================================
+// SimplifyMesh
+// ============================================
+
+std::vector<uint32_t> SimplifyMesh(const SVertexPNT* vertices, uint32_t vertexCount,
+                                   const uint32_t* indices, size_t indexCount,
+                                   size_t targetIndexCount, float maxError, float* outError) {
+    std::vector<uint32_t> result(indices, indices + (indexCount - indexCount % 3));
+    if (outError) *outError = 0.0f;
+    if (result.size() <= targetIndexCount || vertexCount == 0) {
+        return result;
+    }
+
+    // Work in the unit cube so quadric magnitudes do not depend on mesh scale
+    float bmin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float bmax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        const SVertexPNT& p = vertices[v];
+        bmin[0] = std::min(bmin[0], p.px); bmax[0] = std::max(bmax[0], p.px);
+        bmin[1] = std::min(bmin[1], p.py); bmax[1] = std::max(bmax[1], p.py);
+        bmin[2] = std::min(bmin[2], p.pz); bmax[2] = std::max(bmax[2], p.pz);
+    }
+    double scale = std::max({bmax[0] - bmin[0], bmax[1] - bmin[1], bmax[2] - bmin[2]});
+    if (!(scale > 0.0) || !std::isfinite(scale)) {
+        return result;
+    }
+
+    CSimplifier s(vertices, vertexCount);
+    for (uint32_t v = 0; v < vertexCount; v++) {
+        s.m_positions[v] = {(vertices[v].px - bmin[0]) / scale,
+                            (vertices[v].py - bmin[1]) / scale,
+                            (vertices[v].pz - bmin[2]) / scale};
+    }
+    s.WeldPositions();
+    s.Classify(result);
+    s.FillQuadrics(result);
+
+    const double errorLimit = (double)maxError / scale * ((double)maxError / scale);
+    double resultError = 0.0;
+
+    SAdjacency triangles;
+    std::vector<SCollapse> collapses;
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> collapseRemap(vertexCount);
+    std::vector<uint8_t> collapseLocked(vertexCount);
+
+    while (result.size() > targetIndexCount) {
+        buildTriangles(triangles, result, vertexCount);
+        s.PickCollapses(result, collapses);
+        if (collapses.empty()) break;
+
+        order.resize(collapses.size());
+        for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&collapses](uint32_t a, uint32_t b) {
+            return collapses[a].error < collapses[b].error;
+        });
+
+        for (uint32_t v = 0; v < vertexCount; v++) collapseRemap[v] = v;
+        std::fill(collapseLocked.begin(), collapseLocked.end(), 0);
+
+        // Each collapse removes ~2 triangles (1 on a border); stop once the target is met
+        size_t triangleGoal = (result.size() - targetIndexCount + 2) / 3;
+        size_t triangleCollapses = 0;
+        size_t performed = 0;
+
+        for (uint32_t i : order) {
+            const SCollapse& c = collapses[i];
+            if (c.error > errorLimit || triangleCollapses >= triangleGoal) break;
+
+            uint32_t v0 = c.v0, v1 = c.v1;
+            uint32_t r0 = s.m_remap[v0], r1 = s.m_remap[v1];
+            if (collapseLocked[r0] || collapseLocked[r1]) continue;
+            if (s.HasFlips(triangles, result, collapseRemap, v0, v1)) continue;
+
+            uint8_t kind = s.m_kind[v0];
+            if (kind == Kind_Seam) {
+                // Both copies move together so the seam stays closed
+                uint32_t s0 = s.m_wedge[v0];
+                uint32_t s1 = s.SeamPartner(triangles, result, s0, v1);
+                if (s1 == kNone || s.HasFlips(triangles, result, collapseRemap, s0, s1)) continue;
+                collapseRemap[v0] = v1;
+                collapseRemap[s0] = s1;
+            } else {
+                collapseRemap[v0] = v1;
+            }
+
+            collapseLocked[r0] = 1;
+            collapseLocked[r1] = 1;
+            s.m_quadrics[r1].Add(s.m_quadrics[r0]);
+            triangleCollapses += (kind == Kind_Border) ? 1 : 2;
+            resultError = std::max(resultError, c.error);
+            performed++;
+        }
+        if (performed == 0) break;
+
+        // Apply, keep the open-edge loops pointing at surviving vertices
+        for (uint32_t& index : result) {
+            index = collapseRemap[index];
+        }
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            uint32_t l = s.m_loop[v];
+            if (l == kNone) continue;
+            uint32_t r = collapseRemap[l];
+            // v == r: the loop edge itself collapsed onto v, follow it one step
+            s.m_loop[v] = (v == r) ? s.m_loop[l] : r;
+        }
+
+        // Drop triangles that became degenerate in position space
+        size_t write = 0;
+        for (size_t t = 0; t < result.size(); t += 3) {
+            uint32_t a = result[t], b = result[t + 1], c = result[t + 2];
+            uint32_t ra = s.m_remap[a], rb = s.m_remap[b], rc = s.m_remap[c];
+            if (ra == rb || ra == rc || rb == rc) continue;
+            result[write++] = a;
+            result[write++] = b;
+            result[write++] = c;
+        }
+        result.resize(write);
+    }
+
+    if (outError) {
+        *outError = static_cast<float>(std::sqrt(resultError) * scale);
+    }
+    return result;
+}
+
+// ============================================
+// LOD chains
+// ============================================
+
+uint32_t GenerateMeshLods(SMeshCPU_PNT& mesh, const SMeshLodOptions& options) {
+    mesh.lods.clear();
+    if (options.lodCount < 2 || mesh.vertices.empty() || mesh.indices.size() < 3) {
+        return 0;
+    }
+
+    float bmin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float bmax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (const SVertexPNT& v : mesh.vertices) {
+        bmin[0] = std::min(bmin[0], v.px); bmax[0] = std::max(bmax[0], v.px);
+        bmin[1] = std::min(bmin[1], v.py); bmax[1] = std::max(bmax[1], v.py);
+        bmin[2] = std::min(bmin[2], v.pz); bmax[2] = std::max(bmax[2], v.pz);
+    }
+    float dx = bmax[0] - bmin[0], dy = bmax[1] - bmin[1], dz = bmax[2] - bmin[2];
+    float errorBudget = options.maxError * 0.5f * std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    const uint32_t vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    float error = 0.0f;
+    for (uint32_t lod = 1; lod < options.lodCount; lod++) {
+        const std::vector<uint32_t>& source = mesh.lods.empty() ? mesh.indices : mesh.lods.back().indices;
+        size_t sourceTriangles = source.size() / 3;
+        size_t targetTriangles = (size_t)(sourceTriangles * options.reduction);
+        if (targetTriangles < options.minTriangles || error >= errorBudget) break;
+
+        float levelError = 0.0f;
+        std::vector<uint32_t> indices = SimplifyMesh(mesh.vertices.data(), vertexCount, source.data(), source.size(),
+                                                     targetTriangles * 3, errorBudget - error, &levelError);
+        if (indices.size() / 3 > sourceTriangles * options.minReduction || indices.empty()) break;
+
+        OptimizeVertexCache(indices.data(), indices.size(), vertexCount);
+        error += levelError;
+
+        SMeshLodCPU level;
+        level.indices = std::move(indices);
+        level.error = error;
+        mesh.lods.push_back(std::move(level));
+    }
+    return static_cast<uint32_t>(mesh.lods.size());
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Mesh.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================
+// Mesh simplification (quadric error metric)
+// ============================================
+// Edge-collapse simplifier after Garland & Heckbert: each position carries the
+// sum of the plane quadrics of its triangles, an edge collapses its cheaper
+// endpoint onto the other, and the cost is the quadric distance of the move.
+//
+// Collapses are restricted to existing vertices, so a simplified index list
+// references the same vertex buffer as the full mesh and LODs are plain index
+// ranges. Vertices that share a position (UV / normal seams) are kept welded:
+//
+//   Manifold   interior vertex, collapses anywhere
+//   Border     on an open edge, slides along its border only
+//   Seam       two attribute copies of one position, both slide along the seam
+//   Locked     anything else (corners, 3+ copies), never moves
+//
+// Open edges and seams also get perpendicular plane quadrics so their shape is
+// kept. Triangles whose normal would flip are never produced.
+
+// Returns triangles over the input vertices with at most targetIndexCount
+// indices, unless that needs a collapse costing more than maxError (mesh units).
+// outError receives the largest collapse error made (mesh units).
+std::vector<uint32_t> SimplifyMesh(const SVertexPNT* vertices, uint32_t vertexCount,
+                                   const uint32_t* indices, size_t indexCount,
+                                   size_t targetIndexCount, float maxError, float* outError = nullptr);
+
+// ============================================
+// LOD chains
+// ============================================
+struct SMeshLodOptions {
+    uint32_t lodCount = 4;          // Including LOD0 (the full mesh); 1 = no LODs
+    float reduction = 0.5f;         // Target triangle ratio between consecutive LODs
+    float maxError = 0.05f;         // Cumulative error limit, fraction of the bounds radius
+    uint32_t minTriangles = 32;     // Do not build LODs below this
+    float minReduction = 0.85f;     // Stop when a level keeps more than this ratio of triangles
+};
+
+// Fills mesh.lods with LOD1..N (each simplified from the previous one and
+// vertex-cache optimized); errors are cumulative, in mesh units.
+// Returns the number of LODs built (0 if the mesh cannot be simplified).
+uint32_t GenerateMeshLods(SMeshCPU_PNT& mesh, const SMeshLodOptions& options = SMeshLodOptions());
@@ -0,0 +1,216 @@
+#include "PackedVertex.h"
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX::PackedVector;
+
+namespace
+{
+    const float kRadToDeg = 57.29577951308232f;
+
+    int16_t toSnorm16(float v)
+    {
+        v = std::clamp(v, -1.0f, 1.0f);
+        return static_cast<int16_t>(std::lround(v * 32767.0f));
+    }
+
+    float fromSnorm16(int16_t v)
+    {
+        return std::max(static_cast<float>(v) / 32767.0f, -1.0f);
+    }
+
+    uint16_t toUnorm16(float v)
+    {
+        v = std::clamp(v, 0.0f, 1.0f);
+        return static_cast<uint16_t>(std::lround(v * 65535.0f));
+    }
+
+    uint8_t toUnorm8(float v)
+    {
+        v = std::clamp(v, 0.0f, 1.0f);
+        return static_cast<uint8_t>(std::lround(v * 255.0f));
+    }
+
+    void packOct(float x, float y, float z, int16_t out[2])
+    {
+        float u, v;
+        OctEncode(x, y, z, u, v);
+        out[0] = toSnorm16(u);
+        out[1] = toSnorm16(v);
+    }
+
+    // Angle between two directions in degrees; 0 if either is degenerate.
+    // atan2(|a x b|, a . b) stays accurate for tiny angles, where acos(dot) does not.
+    float angleDegrees(float ax, float ay, float az, float bx, float by, float bz)
+    {
+        float la = std::sqrt(ax * ax + ay * ay + az * az);
+        float lb = std::sqrt(bx * bx + by * by + bz * bz);
+        if (la < 1e-8f || lb < 1e-8f) return 0.0f;
+        float cx = ay * bz - az * by;
+        float cy = az * bx - ax * bz;
+        float cz = ax * by - ay * bx;
+        float cross = std::sqrt(cx * cx + cy * cy + cz * cz);
+        float dot = ax * bx + ay * by + az * bz;
+        return std::atan2(cross, dot) * kRadToDeg;
+    }
+
+    float absDiff(float a, float b)
+    {
+        // inf - inf is NaN; report overflowed values as infinite error
+        if (!std::isfinite(a) || !std::isfinite(b)) return INFINITY;
+        return std::fabs(a - b);
+    }
+}
+
+// ============================================
+// Octahedral encoding
+// ============================================
+
+void OctEncode(float x, float y, float z, float& outU, float& outV)
+{
+    float l1 = std::fabs(x) + std::fabs(y) + std::fabs(z);
+    if (l1 < 1e-20f) {
+        outU = 0.0f;
+        outV = 0.0f;
+        return;
+    }
+    x /= l1;
+    y /= l1;
+    z /= l1;
+    if (z < 0.0f) {
+        // Fold the lower hemisphere over the diagonals
+        float fx = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float fy = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = fx;
+        y = fy;
+    }
+    outU = x;
+    outV = y;
+}
+
+void OctDecode(float u, float v, float& outX, float& outY, float& outZ)
+{
+    float x = u;
+    float y = v;
+    float z = 1.0f - std::fabs(u) - std::fabs(v);
+    if (z < 0.0f) {
+        float t = -z;
+        x += (x >= 0.0f) ? -t : t;
+        y += (y >= 0.0f) ? -t : t;
+    }
+    float len = std::sqrt(x * x + y * y + z * z);
+    outX = x / len;
+    outY = y / len;
+    outZ = z / len;
+}
+
+// ============================================
+// Pack / unpack
+// ============================================
+
+SPackedPosition PackPosition(const SVertexPNT& v)
+{
+    SPackedPosition p;
+    p.x = XMConvertFloatToHalf(v.px);
+    p.y = XMConvertFloatToHalf(v.py);
+    p.z = XMConvertFloatToHalf(v.pz);
+    p.w = XMConvertFloatToHalf(v.tw < 0.0f ? -1.0f : 1.0f);
+    return p;
+}
+
+SPackedAttributes PackAttributes(const SVertexPNT& v)
+{
+    SPackedAttributes a;
+    packOct(v.nx, v.ny, v.nz, a.normal);
+    packOct(v.tx, v.ty, v.tz, a.tangent);
+    a.uv[0] = XMConvertFloatToHalf(v.u);
+    a.uv[1] = XMConvertFloatToHalf(v.v);
+    a.uv2[0] = toUnorm16(v.u2);
+    a.uv2[1] = toUnorm16(v.v2);
+    a.color[0] = toUnorm8(v.r);
+    a.color[1] = toUnorm8(v.g);
+    a.color[2] = toUnorm8(v.b);
+    a.color[3] = toUnorm8(v.a);
+    return a;
+}
+
+SVertexPNT UnpackVertex(const SPackedPosition& p, const SPackedAttributes& a)
+{
+    SVertexPNT v;
+    v.px = XMConvertHalfToFloat(p.x);
+    v.py = XMConvertHalfToFloat(p.y);
+    v.pz = XMConvertHalfToFloat(p.z);
+    OctDecode(fromSnorm16(a.normal[0]), fromSnorm16(a.normal[1]), v.nx, v.ny, v.nz);
+    OctDecode(fromSnorm16(a.tangent[0]), fromSnorm16(a.tangent[1]), v.tx, v.ty, v.tz);
+    v.tw = XMConvertHalfToFloat(p.w);
+    v.u = XMConvertHalfToFloat(a.uv[0]);
+    v.v = XMConvertHalfToFloat(a.uv[1]);
+    v.u2 = a.uv2[0] / 65535.0f;
+    v.v2 = a.uv2[1] / 65535.0f;
+    v.r = a.color[0] / 255.0f;
+    v.g = a.color[1] / 255.0f;
+    v.b = a.color[2] / 255.0f;
+    v.a = a.color[3] / 255.0f;
+    return v;
+}
+
+void PackVertices(const SVertexPNT* vertices, size_t count, SPackedMesh& out)
+{
+    out.positions.resize(count);
+    out.attributes.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        out.positions[i] = PackPosition(vertices[i]);
+        out.attributes[i] = PackAttributes(vertices[i]);
+    }
+}
+
+// ============================================
+// Error metrics
+// ============================================
+
+bool SVertexPackingTolerance::Accepts(const SVertexPackingError& e) const
+{
+    // Written as "<=" so NaN compares false and is rejected
+    return e.maxPositionRelative <= maxPositionRelative &&
+           e.maxNormalDegrees <= maxNormalDegrees &&
+           e.maxTangentDegrees <= maxNormalDegrees &&
+           e.maxUV <= maxUV &&
+           e.maxUV2 <= maxUV2 &&
+           e.maxColor <= maxColor;
+}
+
+SVertexPackingError MeasurePackingError(const SVertexPNT* vertices, size_t count)
+{
+    SVertexPackingError e;
+    if (count == 0) return e;
+
+    float bmin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float bmax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+    for (size_t i = 0; i < count; i++) {
+        const SVertexPNT& v = vertices[i];
+        SVertexPNT r = UnpackVertex(PackPosition(v), PackAttributes(v));
+
+        bmin[0] = std::min(bmin[0], v.px); bmax[0] = std::max(bmax[0], v.px);
+        bmin[1] = std::min(bmin[1], v.py); bmax[1] = std::max(bmax[1], v.py);
+        bmin[2] = std::min(bmin[2], v.pz); bmax[2] = std::max(bmax[2], v.pz);
+
+        e.maxPosition = std::max({e.maxPosition, absDiff(v.px, r.px), absDiff(v.py, r.py), absDiff(v.pz, r.pz)});
+        e.maxNormalDegrees = std::max(e.maxNormalDegrees, angleDegrees(v.nx, v.ny, v.nz, r.nx, r.ny, r.nz));
+        e.maxTangentDegrees = std::max(e.maxTangentDegrees, angleDegrees(v.tx, v.ty, v.tz, r.tx, r.ty, r.tz));
+        e.maxUV = std::max({e.maxUV, absDiff(v.u, r.u), absDiff(v.v, r.v)});
+        e.maxUV2 = std::max({e.maxUV2, absDiff(v.u2, r.u2), absDiff(v.v2, r.v2)});
+        e.maxColor = std::max({e.maxColor, absDiff(v.r, r.r), absDiff(v.g, r.g), absDiff(v.b, r.b), absDiff(v.a, r.a)});
+    }
+
+    float dx = bmax[0] - bmin[0], dy = bmax[1] - bmin[1], dz = bmax[2] - bmin[2];
+    float diagonal = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (!std::isfinite(e.maxPosition)) {
+        e.maxPositionRelative = INFINITY;
+    } else {
+        e.maxPositionRelative = diagonal > 0.0f ? e.maxPosition / diagonal : 0.0f;
+    }
+    return e;
+}
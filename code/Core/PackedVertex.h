@@ -0,0 +1,82 @@
+#pragma once
+#include "Mesh.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================
+// Packed vertex layout
+// ============================================
+// Optional compact alternative to the 80-byte float SVertexPNT, split in two
+// streams so depth-only passes (pre-pass, shadows) fetch positions alone:
+//
+//   Stream 0 (SPackedPosition, 8 bytes)     half xyz, w = tangent handedness
+//   Stream 1 (SPackedAttributes, 20 bytes)  octahedral snorm16 normal + tangent,
+//                                           half UV, unorm16 UV2, unorm8 color
+//
+// Positions stay in mesh-local units (half, no bounds remap) so the shaders need
+// no per-draw dequantization constants; meshes whose extent or detail does not
+// survive half precision are kept on the full layout (see MeasurePackingError).
+
+enum class EVertexLayout : uint8_t {
+    Full,       // SVertexPNT, one interleaved stream
+    Packed      // SPackedPosition + SPackedAttributes
+};
+
+struct SPackedPosition {
+    uint16_t x, y, z;   // half
+    uint16_t w;         // half, tangent handedness (+1 / -1)
+};
+
+struct SPackedAttributes {
+    int16_t normal[2];      // octahedral, snorm16
+    int16_t tangent[2];     // octahedral, snorm16
+    uint16_t uv[2];         // half
+    uint16_t uv2[2];        // unorm16 (lightmap UVs live in [0,1])
+    uint8_t color[4];       // unorm8 RGBA
+};
+
+static_assert(sizeof(SPackedPosition) == 8, "Position stream must stay 8 bytes");
+static_assert(sizeof(SPackedAttributes) == 20, "Attribute stream must stay 20 bytes");
+
+struct SPackedMesh {
+    std::vector<SPackedPosition> positions;
+    std::vector<SPackedAttributes> attributes;
+};
+
+// Octahedral unit vector encoding, components in [-1, 1]. Zero vectors encode as +Z.
+void OctEncode(float x, float y, float z, float& outU, float& outV);
+void OctDecode(float u, float v, float& outX, float& outY, float& outZ);
+
+SPackedPosition PackPosition(const SVertexPNT& v);
+SPackedAttributes PackAttributes(const SVertexPNT& v);
+SVertexPNT UnpackVertex(const SPackedPosition& p, const SPackedAttributes& a);
+
+void PackVertices(const SVertexPNT* vertices, size_t count, SPackedMesh& out);
+
+// ============================================
+// Error metrics
+// ============================================
+struct SVertexPackingError {
+    float maxPosition = 0.0f;           // Absolute, mesh units
+    float maxPositionRelative = 0.0f;   // maxPosition / bounds diagonal
+    float maxNormalDegrees = 0.0f;
+    float maxTangentDegrees = 0.0f;
+    float maxUV = 0.0f;
+    float maxUV2 = 0.0f;
+    float maxColor = 0.0f;
+};
+
+struct SVertexPackingTolerance {
+    float maxPositionRelative = 1.0f / 2048.0f;
+    float maxNormalDegrees = 1.0f;       // Also applied to tangents
+    float maxUV = 1.0f / 1024.0f;
+    float maxUV2 = 1.0f / 8192.0f;
+    float maxColor = 1.0f / 255.0f;
+
+    // NaN / inf errors (half overflow) are never accepted
+    bool Accepts(const SVertexPackingError& e) const;
+};
+
+// Round-trips every vertex through the packed layout and reports the worst deviation
+SVertexPackingError MeasurePackingError(const SVertexPNT* vertices, size_t count);
@@ -2,6 +2,12 @@
 #include <cmath>
 #include <filesystem>
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#if FF_SH_SIMD
+#include <xmmintrin.h>
+#endif
 
 #include "Exporter/KTXExporter.h"
 
@@ -97,114 +103,220 @@ namespace SphericalHarmonics
     }
 
     // ============================================
-    // SH Projection
+    // Projection Kernel
     // ============================================
 
-    void ProjectCubemapToSH(
-        const std::array<std::vector<XMFLOAT4>, 6>& cubemapData,
-        int size,
-        std::array<XMFLOAT3, 9>& outCoeffs)
+    namespace
     {
-        // 初始化系数为 0
-        for (int i = 0; i < 9; i++)
+        template<int Order>
+        void evaluateBasisOrder(const XMFLOAT3& dir, std::array<float, CoeffCount(Order)>& basis)
         {
-            outCoeffs[i] = XMFLOAT3(0, 0, 0);
+            if constexpr (Order == 1) EvaluateBasisL1(dir, basis);
+            else if constexpr (Order == 2) EvaluateBasis(dir, basis);
+            else if constexpr (Order == 3) EvaluateBasisL3(dir, basis);
+            else EvaluateBasisL4(dir, basis);
         }
 
-        // 遍历 6 个面
-        for (int face = 0; face < 6; face++)
+        // weights[i * texelCount + t] = Y_i(dir_t) * dω_t
+        struct SProjectionTable
         {
-            const std::vector<XMFLOAT4>& faceData = cubemapData[face];
+            size_t texelCount = 0;
+            std::vector<float> weights;
+        };
 
-            // 遍历该面的所有像素
-            for (int y = 0; y < size; y++)
-            {
-                for (int x = 0; x < size; x++)
-                {
-                    // 1. 计算 UV 和立体角
-                    float u = ((float)x + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float v = ((float)y + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float solidAngle = ComputeSolidAngle(u, v, size);
+        std::mutex s_tableMutex;
+        std::map<std::pair<int, int>, std::shared_ptr<const SProjectionTable>> s_tables;
 
-                    // 2. 计算方向向量
-                    XMFLOAT3 dir = CubemapTexelToDirection(face, x, y, size);
+        template<int Order>
+        std::shared_ptr<const SProjectionTable> buildTable(int size)
+        {
+            constexpr int N = CoeffCount(Order);
+            auto table = std::make_shared<SProjectionTable>();
+            table->texelCount = (size_t)6 * size * size;
+            table->weights.resize(N * table->texelCount);
 
-                    // 3. 采样颜色
-                    int pixelIndex = y * size + x;
-                    XMFLOAT3 color(
-                        faceData[pixelIndex].x,
-                        faceData[pixelIndex].y,
-                        faceData[pixelIndex].z
-                    );
-                    // 4. 计算 SH 基函数
-                    std::array<float, 9> basis;
-                    EvaluateBasis(dir, basis);
-
-                    // 5. 累加到 SH 系数（Riemann 求和）
-                    // c_i = ∫ f(ω) * Y_i(ω) dω ≈ Σ f * Y * dω
-                    for (int i = 0; i < 9; i++)
+            size_t t = 0;
+            for (int face = 0; face < 6; face++)
+            {
+                for (int y = 0; y < size; y++)
+                {
+                    for (int x = 0; x < size; x++, t++)
                     {
-                        outCoeffs[i].x += color.x * basis[i] * solidAngle;
-                        outCoeffs[i].y += color.y * basis[i] * solidAngle;
-                        outCoeffs[i].z += color.z * basis[i] * solidAngle;
+                        float u = ((float)x + 0.5f) / (float)size * 2.0f - 1.0f;
+                        float v = ((float)y + 0.5f) / (float)size * 2.0f - 1.0f;
+                        float solidAngle = ComputeSolidAngle(u, v, size);
+
+                        std::array<float, N> basis;
+                        evaluateBasisOrder<Order>(CubemapTexelToDirection(face, x, y, size), basis);
+                        for (int i = 0; i < N; i++)
+                            table->weights[i * table->texelCount + t] = basis[i] * solidAngle;
                     }
                 }
             }
+            return table;
         }
-        // 不需要额外归一化，因为 solidAngle 已经是正确的 dω
-    }
 
-    // Flat buffer overload for GPU output format
-    void ProjectCubemapToSH(
-        const XMFLOAT4* flatCubemapData,
-        int size,
-        std::array<XMFLOAT3, 9>& outCoeffs)
-    {
-        // Initialize coefficients to zero
-        for (int i = 0; i < 9; i++)
+        template<int Order>
+        std::shared_ptr<const SProjectionTable> getTable(int size)
         {
-            outCoeffs[i] = XMFLOAT3(0, 0, 0);
+            std::lock_guard<std::mutex> lock(s_tableMutex);
+            auto& table = s_tables[{ size, Order }];
+            if (!table)
+                table = buildTable<Order>(size);
+            return table;
         }
 
-        int pixelsPerFace = size * size;
+#if FF_SH_SIMD
+        inline float horizontalSum(__m128 v)
+        {
+            __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 sums = _mm_add_ps(v, shuf);
+            shuf = _mm_movehl_ps(shuf, sums);
+            return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+        }
 
-        // Iterate over 6 faces
-        for (int face = 0; face < 6; face++)
+        // 4 texel 一组：转置成 rrrr/gggg/bbbb，与每个系数的 4 个权重相乘累加。
+        // 返回处理到的 x，剩余部分由标量循环完成
+        template<int N>
+        int projectRowSIMD(const XMFLOAT4* row, const float* weights, size_t stride, int size, float rowSum[][3])
         {
-            // Iterate over all pixels in this face
-            for (int y = 0; y < size; y++)
+            __m128 sumR[N], sumG[N], sumB[N];
+            for (int i = 0; i < N; i++)
+                sumR[i] = sumG[i] = sumB[i] = _mm_setzero_ps();
+
+            int x = 0;
+            for (; x + 4 <= size; x += 4)
             {
-                for (int x = 0; x < size; x++)
+                __m128 r = _mm_loadu_ps(&row[x].x);
+                __m128 g = _mm_loadu_ps(&row[x + 1].x);
+                __m128 b = _mm_loadu_ps(&row[x + 2].x);
+                __m128 a = _mm_loadu_ps(&row[x + 3].x);
+                _MM_TRANSPOSE4_PS(r, g, b, a);
+
+                for (int i = 0; i < N; i++)
                 {
-                    // 1. Compute UV and solid angle
-                    float u = ((float)x + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float v = ((float)y + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float solidAngle = ComputeSolidAngle(u, v, size);
+                    __m128 w = _mm_loadu_ps(weights + i * stride + x);
+                    sumR[i] = _mm_add_ps(sumR[i], _mm_mul_ps(r, w));
+                    sumG[i] = _mm_add_ps(sumG[i], _mm_mul_ps(g, w));
+                    sumB[i] = _mm_add_ps(sumB[i], _mm_mul_ps(b, w));
+                }
+            }
 
-                    // 2. Compute direction vector
-                    XMFLOAT3 dir = CubemapTexelToDirection(face, x, y, size);
+            for (int i = 0; i < N; i++)
+            {
+                rowSum[i][0] = horizontalSum(sumR[i]);
+                rowSum[i][1] = horizontalSum(sumG[i]);
+                rowSum[i][2] = horizontalSum(sumB[i]);
+            }
+            return x;
+        }
+#endif
 
-                    // 3. Sample color from flat buffer
-                    int pixelIndex = face * pixelsPerFace + y * size + x;
-                    const XMFLOAT4& pixel = flatCubemapData[pixelIndex];
-                    XMFLOAT3 color(pixel.x, pixel.y, pixel.z);
+        template<int Order>
+        void projectTable(const XMFLOAT4* const faces[6], int size, bool simd, std::array<XMFLOAT3, CoeffCount(Order)>& outCoeffs)
+        {
+            constexpr int N = CoeffCount(Order);
+            std::shared_ptr<const SProjectionTable> table = getTable<Order>(size);
+            const size_t stride = table->texelCount;
 
-                    // 4. Compute SH basis functions
-                    std::array<float, 9> basis;
-                    EvaluateBasis(dir, basis);
+            double sum[N][3] = {};
+            for (int face = 0; face < 6; face++)
+            {
+                for (int y = 0; y < size; y++)
+                {
+                    const XMFLOAT4* row = faces[face] + (size_t)y * size;
+                    const float* weights = table->weights.data() + ((size_t)face * size + y) * size;
+
+                    float rowSum[N][3] = {};
+                    int x = 0;
+#if FF_SH_SIMD
+                    if (simd)
+                        x = projectRowSIMD<N>(row, weights, stride, size, rowSum);
+#endif
+                    for (; x < size; x++)
+                    {
+                        for (int i = 0; i < N; i++)
+                        {
+                            float w = weights[i * stride + x];
+                            rowSum[i][0] += row[x].x * w;
+                            rowSum[i][1] += row[x].y * w;
+                            rowSum[i][2] += row[x].z * w;
+                        }
+                    }
 
-                    // 5. Accumulate to SH coefficients (Riemann sum)
-                    for (int i = 0; i < 9; i++)
+                    for (int i = 0; i < N; i++)
                     {
-                        outCoeffs[i].x += color.x * basis[i] * solidAngle;
-                        outCoeffs[i].y += color.y * basis[i] * solidAngle;
-                        outCoeffs[i].z += color.z * basis[i] * solidAngle;
+                        sum[i][0] += rowSum[i][0];
+                        sum[i][1] += rowSum[i][1];
+                        sum[i][2] += rowSum[i][2];
                     }
                 }
             }
+
+            for (int i = 0; i < N; i++)
+                outCoeffs[i] = XMFLOAT3((float)sum[i][0], (float)sum[i][1], (float)sum[i][2]);
         }
     }
 
+    template<int Order>
+    void ProjectCubemap(
+        const XMFLOAT4* const faces[6],
+        int size,
+        std::array<XMFLOAT3, CoeffCount(Order)>& outCoeffs,
+        EProjectKernel kernel)
+    {
+        static_assert(Order >= 1 && Order <= 4, "SH projection supports L1 - L4");
+        projectTable<Order>(faces, size, kernel == EProjectKernel::SIMD, outCoeffs);
+    }
+
+    template void ProjectCubemap<1>(const XMFLOAT4* const[6], int, std::array<XMFLOAT3, 4>&, EProjectKernel);
+    template void ProjectCubemap<2>(const XMFLOAT4* const[6], int, std::array<XMFLOAT3, 9>&, EProjectKernel);
+    template void ProjectCubemap<3>(const XMFLOAT4* const[6], int, std::array<XMFLOAT3, 16>&, EProjectKernel);
+    template void ProjectCubemap<4>(const XMFLOAT4* const[6], int, std::array<XMFLOAT3, 25>&, EProjectKernel);
+
+    size_t GetProjectionTableBytes()
+    {
+        std::lock_guard<std::mutex> lock(s_tableMutex);
+        size_t bytes = 0;
+        for (const auto& entry : s_tables)
+            bytes += entry.second->weights.size() * sizeof(float);
+        return bytes;
+    }
+
+    void ReleaseProjectionTables()
+    {
+        std::lock_guard<std::mutex> lock(s_tableMutex);
+        s_tables.clear();
+    }
+
+    // ============================================
+    // SH Projection
+    // ============================================
+
+    void ProjectCubemapToSH(
+        const std::array<std::vector<XMFLOAT4>, 6>& cubemapData,
+        int size,
+        std::array<XMFLOAT3, 9>& outCoeffs)
+    {
+        const XMFLOAT4* faces[6];
+        for (int face = 0; face < 6; face++)
+            faces[face] = cubemapData[face].data();
+        ProjectCubemap<2>(faces, size, outCoeffs);
+    }
+
+    // Flat buffer overload for GPU output format
+    void ProjectCubemapToSH(
+        const XMFLOAT4* flatCubemapData,
+        int size,
+        std::array<XMFLOAT3, 9>& outCoeffs)
+    {
+        const size_t pixelsPerFace = (size_t)size * size;
+        const XMFLOAT4* faces[6];
+        for (int face = 0; face < 6; face++)
+            faces[face] = flatCubemapData + face * pixelsPerFace;
+        ProjectCubemap<2>(faces, size, outCoeffs);
+    }
+
     // ============================================
     // SH Evaluation (Reconstruction)
     // ============================================
@@ -321,44 +433,10 @@ namespace SphericalHarmonics
         int size,
         std::array<XMFLOAT3, 4>& outCoeffs)
     {
-        for (int i = 0; i < 4; i++)
-        {
-            outCoeffs[i] = XMFLOAT3(0, 0, 0);
-        }
-
+        const XMFLOAT4* faces[6];
         for (int face = 0; face < 6; face++)
-        {
-            const std::vector<XMFLOAT4>& faceData = cubemapData[face];
-
-            for (int y = 0; y < size; y++)
-            {
-                for (int x = 0; x < size; x++)
-                {
-                    float u = ((float)x + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float v = ((float)y + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float solidAngle = ComputeSolidAngle(u, v, size);
-
-                    XMFLOAT3 dir = CubemapTexelToDirection(face, x, y, size);
-
-                    int pixelIndex = y * size + x;
-                    XMFLOAT3 color(
-                        faceData[pixelIndex].x,
-                        faceData[pixelIndex].y,
-                        faceData[pixelIndex].z
-                    );
-
-                    std::array<float, 4> basis;
-                    EvaluateBasisL1(dir, basis);
-
-                    for (int i = 0; i < 4; i++)
-                    {
-                        outCoeffs[i].x += color.x * basis[i] * solidAngle;
-                        outCoeffs[i].y += color.y * basis[i] * solidAngle;
-                        outCoeffs[i].z += color.z * basis[i] * solidAngle;
-                    }
-                }
-            }
-        }
+            faces[face] = cubemapData[face].data();
+        ProjectCubemap<1>(faces, size, outCoeffs);
     }
 
     // ============================================
@@ -485,44 +563,10 @@ namespace SphericalHarmonics
         int size,
         std::array<XMFLOAT3, 16>& outCoeffs)
     {
-        for (int i = 0; i < 16; i++)
-        {
-            outCoeffs[i] = XMFLOAT3(0, 0, 0);
-        }
-
+        const XMFLOAT4* faces[6];
         for (int face = 0; face < 6; face++)
-        {
-            const std::vector<XMFLOAT4>& faceData = cubemapData[face];
-
-            for (int y = 0; y < size; y++)
-            {
-                for (int x = 0; x < size; x++)
-                {
-                    float u = ((float)x + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float v = ((float)y + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float solidAngle = ComputeSolidAngle(u, v, size);
-
-                    XMFLOAT3 dir = CubemapTexelToDirection(face, x, y, size);
-
-                    int pixelIndex = y * size + x;
-                    XMFLOAT3 color(
-                        faceData[pixelIndex].x,
-                        faceData[pixelIndex].y,
-                        faceData[pixelIndex].z
-                    );
-
-                    std::array<float, 16> basis;
-                    EvaluateBasisL3(dir, basis);
-
-                    for (int i = 0; i < 16; i++)
-                    {
-                        outCoeffs[i].x += color.x * basis[i] * solidAngle;
-                        outCoeffs[i].y += color.y * basis[i] * solidAngle;
-                        outCoeffs[i].z += color.z * basis[i] * solidAngle;
-                    }
-                }
-            }
-        }
+            faces[face] = cubemapData[face].data();
+        ProjectCubemap<3>(faces, size, outCoeffs);
     }
 
     // ============================================
@@ -661,46 +705,10 @@ namespace SphericalHarmonics
         int size,
         std::array<XMFLOAT3, 25>& outCoeffs)
     {
-        // 初始化系数为 0
-        for (int i = 0; i < 25; i++)
-        {
-            outCoeffs[i] = XMFLOAT3(0, 0, 0);
-        }
-
-        // 遍历 6 个面
+        const XMFLOAT4* faces[6];
         for (int face = 0; face < 6; face++)
-        {
-            const std::vector<XMFLOAT4>& faceData = cubemapData[face];
-
-            for (int y = 0; y < size; y++)
-            {
-                for (int x = 0; x < size; x++)
-                {
-                    float u = ((float)x + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float v = ((float)y + 0.5f) / (float)size * 2.0f - 1.0f;
-                    float solidAngle = ComputeSolidAngle(u, v, size);
-
-                    XMFLOAT3 dir = CubemapTexelToDirection(face, x, y, size);
-
-                    int pixelIndex = y * size + x;
-                    XMFLOAT3 color(
-                        faceData[pixelIndex].x,
-                        faceData[pixelIndex].y,
-                        faceData[pixelIndex].z
-                    );
-
-                    std::array<float, 25> basis;
-                    EvaluateBasisL4(dir, basis);
-
-                    for (int i = 0; i < 25; i++)
-                    {
-                        outCoeffs[i].x += color.x * basis[i] * solidAngle;
-                        outCoeffs[i].y += color.y * basis[i] * solidAngle;
-                        outCoeffs[i].z += color.z * basis[i] * solidAngle;
-                    }
-                }
-            }
-        }
+            faces[face] = cubemapData[face].data();
+        ProjectCubemap<4>(faces, size, outCoeffs);
     }
 
     // ============================================
@@ -4,6 +4,12 @@
 #include <vector>
 #include <string>
 
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define FF_SH_SIMD 1
+#else
+#define FF_SH_SIMD 0
+#endif
+
 // ============================================
 // SphericalHarmonics - L2 球谐函数工具类
 // ============================================
@@ -80,6 +86,44 @@ namespace SphericalHarmonics
         std::array<DirectX::XMFLOAT3, 9>& outCoeffs
     );
 
+    // ============================================
+    // Projection Kernel (L1 - L4)
+    // ============================================
+    // 所有 ProjectCubemapToSH* 都走这里。
+    // Y_i(dir) * dω 只取决于分辨率，按 (size, order) 预计算一次权重表
+    // （SoA：[coeff][face * size² + y * size + x]），之后每个 probe 只剩乘加：
+    // SIMD 一次处理 4 个 texel，每行先在 float 中求和，行与行之间用 double 累加，
+    // 256² 的 cubemap 也不会因累加顺序丢精度。权重表线程安全地共享，
+    // 大小为 系数数 * 6 * size² * 4 字节（256² L4 约 38 MB），烘焙结束后可释放。
+
+    constexpr int CoeffCount(int order) { return (order + 1) * (order + 1); }
+
+    enum class EProjectKernel
+    {
+        Scalar,     // 权重表 + 标量循环
+        SIMD        // 权重表 + 4 texel/次；FF_SH_SIMD == 0 时退化为 Scalar
+    };
+
+#if FF_SH_SIMD
+    constexpr EProjectKernel SH_DEFAULT_KERNEL = EProjectKernel::SIMD;
+#else
+    constexpr EProjectKernel SH_DEFAULT_KERNEL = EProjectKernel::Scalar;
+#endif
+
+    // faces: 6 个面的像素（RGBA float，每面 size * size，行优先）
+    // Order: 1 - 4（在 .cpp 中显式实例化）
+    template<int Order>
+    void ProjectCubemap(
+        const DirectX::XMFLOAT4* const faces[6],
+        int size,
+        std::array<DirectX::XMFLOAT3, CoeffCount(Order)>& outCoeffs,
+        EProjectKernel kernel = SH_DEFAULT_KERNEL
+    );
+
+    // 当前缓存的权重表占用的字节数；Release 后下一次投影重新生成
+    size_t GetProjectionTableBytes();
+    void ReleaseProjectionTables();
+
     // ============================================
     // SH Evaluation (Reconstruction)
     // ============================================
@@ -0,0 +1,383 @@
+#include "SphericalHarmonicsBatch.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#if FF_SH_SIMD
+#include <xmmintrin.h>
+#endif
+
+using namespace DirectX;
+
+namespace SphericalHarmonics
+{
+    namespace
+    {
+        constexpr int MAX_COEFFS = L4_COEFF_COUNT;
+        constexpr int MAX_BAND_SIZE = 9;                // 2 * 4 + 1
+        constexpr int ROTATION_SAMPLE_COUNT = 64;
+
+        void evaluateBasis(int order, const XMFLOAT3& dir, float* out)
+        {
+            switch (order)
+            {
+                case 1: { std::array<float, 4> b; EvaluateBasisL1(dir, b); std::copy(b.begin(), b.end(), out); break; }
+                case 2: { std::array<float, 9> b; EvaluateBasis(dir, b); std::copy(b.begin(), b.end(), out); break; }
+                case 3: { std::array<float, 16> b; EvaluateBasisL3(dir, b); std::copy(b.begin(), b.end(), out); break; }
+                default: { std::array<float, 25> b; EvaluateBasisL4(dir, b); std::copy(b.begin(), b.end(), out); break; }
+            }
+        }
+
+        // ============================================
+        // Rotation
+        // ============================================
+        // A band-l function is fixed by its values at a few directions:
+        // c = P * g(n_s), P = pseudo-inverse of B[s][m] = Y_lm(n_s). The rotated
+        // function has g'(n_s) = g(R⁻¹ n_s), so the band matrix is
+        // M = P * Y_lm(R⁻¹ n_s). P only depends on the sample set (built once).
+        struct SRotationSamples
+        {
+            XMFLOAT3 dirs[ROTATION_SAMPLE_COUNT];
+            // pinv[band][m * ROTATION_SAMPLE_COUNT + s]
+            std::vector<double> pinv[5];
+        };
+
+        // Least squares over a Fibonacci sphere, well conditioned for every band
+        SRotationSamples buildRotationSamples()
+        {
+            SRotationSamples samples;
+            const double golden = 3.14159265358979 * (3.0 - std::sqrt(5.0));
+            for (int s = 0; s < ROTATION_SAMPLE_COUNT; s++)
+            {
+                double y = 1.0 - (s + 0.5) * 2.0 / ROTATION_SAMPLE_COUNT;
+                double r = std::sqrt(1.0 - y * y);
+                samples.dirs[s] = XMFLOAT3((float)(r * std::cos(golden * s)), (float)y, (float)(r * std::sin(golden * s)));
+            }
+
+            std::vector<std::array<float, MAX_COEFFS>> basis(ROTATION_SAMPLE_COUNT);
+            for (int s = 0; s < ROTATION_SAMPLE_COUNT; s++)
+                evaluateBasis(4, samples.dirs[s], basis[s].data());
+
+            for (int band = 1; band <= 4; band++)
+            {
+                const int first = band * band;
+                const int n = 2 * band + 1;
+
+                // [BᵀB | I] -> [I | (BᵀB)⁻¹], Gauss-Jordan with partial pivoting
+                double a[MAX_BAND_SIZE][2 * MAX_BAND_SIZE] = {};
+                for (int i = 0; i < n; i++)
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        for (int s = 0; s < ROTATION_SAMPLE_COUNT; s++)
+                            a[i][j] += (double)basis[s][first + i] * basis[s][first + j];
+                    }
+                    a[i][n + i] = 1.0;
+                }
+                for (int col = 0; col < n; col++)
+                {
+                    int pivot = col;
+                    for (int row = col + 1; row < n; row++)
+                        if (std::abs(a[row][col]) > std::abs(a[pivot][col])) pivot = row;
+                    std::swap(a[col], a[pivot]);
+                    const double inv = 1.0 / a[col][col];
+                    for (int j = 0; j < 2 * n; j++) a[col][j] *= inv;
+                    for (int row = 0; row < n; row++)
+                    {
+                        if (row == col) continue;
+                        const double f = a[row][col];
+                        for (int j = 0; j < 2 * n; j++) a[row][j] -= f * a[col][j];
+                    }
+                }
+
+                // P = (BᵀB)⁻¹ Bᵀ
+                std::vector<double>& pinv = samples.pinv[band];
+                pinv.assign((size_t)n * ROTATION_SAMPLE_COUNT, 0.0);
+                for (int m = 0; m < n; m++)
+                    for (int s = 0; s < ROTATION_SAMPLE_COUNT; s++)
+                        for (int j = 0; j < n; j++)
+                            pinv[m * ROTATION_SAMPLE_COUNT + s] += a[m][n + j] * basis[s][first + j];
+            }
+            return samples;
+        }
+
+        // Block-diagonal rotation: matrix[band] is (2l+1)², row-major
+        void buildRotation(int order, const XMFLOAT3X3& r, std::array<std::array<float, MAX_BAND_SIZE * MAX_BAND_SIZE>, 5>& matrix)
+        {
+            static const SRotationSamples samples = buildRotationSamples();
+
+            std::vector<std::array<float, MAX_COEFFS>> rotated(ROTATION_SAMPLE_COUNT);
+            for (int s = 0; s < ROTATION_SAMPLE_COUNT; s++)
+            {
+                // R⁻¹ n = n * Rᵀ for an orthonormal R
+                const XMFLOAT3& n = samples.dirs[s];
+                XMFLOAT3 src(n.x * r._11 + n.y * r._12 + n.z * r._13,
+                             n.x * r._21 + n.y * r._22 + n.z * r._23,
+                             n.x * r._31 + n.y * r._32 + n.z * r._33);
+                evaluateBasis(order, src, rotated[s].data());
+            }
+
+            for (int band = 1; band <= order; band++)
+            {
+                const int first = band * band;
+                const int n = 2 * band + 1;
+                const std::vector<double>& pinv = samples.pinv[band];
+                for (int m = 0; m < n; m++)
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        double sum = 0.0;
+                        for (int s = 0; s < ROTATION_SAMPLE_COUNT; s++)
+                            sum += pinv[m * ROTATION_SAMPLE_COUNT + s] * rotated[s][first + j];
+                        matrix[band][m * n + j] = (float)sum;
+                    }
+                }
+            }
+        }
+    }
+
+    // ============================================
+    // CSHBatch
+    // ============================================
+
+    void CSHBatch::Reset(int order, size_t count)
+    {
+        m_order = std::clamp(order, 1, 4);
+        m_count = count;
+        m_stride = (count + 3) & ~(size_t)3;
+        m_data.assign((size_t)GetCoeffCount() * 3 * m_stride, 0.0f);
+    }
+
+    void CSHBatch::SetProbe(size_t probe, const XMFLOAT3* coeffs)
+    {
+        for (int i = 0; i < GetCoeffCount(); i++)
+        {
+            Row(i, 0)[probe] = coeffs[i].x;
+            Row(i, 1)[probe] = coeffs[i].y;
+            Row(i, 2)[probe] = coeffs[i].z;
+        }
+    }
+
+    void CSHBatch::GetProbe(size_t probe, XMFLOAT3* coeffs) const
+    {
+        for (int i = 0; i < GetCoeffCount(); i++)
+            coeffs[i] = XMFLOAT3(Row(i, 0)[probe], Row(i, 1)[probe], Row(i, 2)[probe]);
+    }
+
+    // ============================================
+    // Evaluate
+    // ============================================
+
+    void EvaluateBatch(const CSHBatch& probes, const XMFLOAT3* dirs, size_t dirCount, XMFLOAT3* out, EBatchKernel kernel)
+    {
+        const int coeffCount = probes.GetCoeffCount();
+        const size_t count = probes.GetCount();
+
+        for (size_t d = 0; d < dirCount; d++)
+        {
+            float basis[MAX_COEFFS];
+            evaluateBasis(probes.GetOrder(), dirs[d], basis);
+            XMFLOAT3* dst = out + d * count;
+
+            size_t p = 0;
+#if FF_SH_SIMD
+            if (kernel == EBatchKernel::SIMD)
+            {
+                // Padding lanes are 0, the last group is stored partially
+                for (; p < count; p += 4)
+                {
+                    __m128 r = _mm_setzero_ps(), g = _mm_setzero_ps(), b = _mm_setzero_ps();
+                    for (int i = 0; i < coeffCount; i++)
+                    {
+                        __m128 y = _mm_set1_ps(basis[i]);
+                        r = _mm_add_ps(r, _mm_mul_ps(y, _mm_loadu_ps(probes.Row(i, 0) + p)));
+                        g = _mm_add_ps(g, _mm_mul_ps(y, _mm_loadu_ps(probes.Row(i, 1) + p)));
+                        b = _mm_add_ps(b, _mm_mul_ps(y, _mm_loadu_ps(probes.Row(i, 2) + p)));
+                    }
+                    alignas(16) float lanes[3][4];
+                    _mm_store_ps(lanes[0], r);
+                    _mm_store_ps(lanes[1], g);
+                    _mm_store_ps(lanes[2], b);
+                    const size_t n = std::min<size_t>(4, count - p);
+                    for (size_t j = 0; j < n; j++)
+                        dst[p + j] = XMFLOAT3(lanes[0][j], lanes[1][j], lanes[2][j]);
+                }
+            }
+#endif
+            for (; p < count; p++)
+            {
+                XMFLOAT3 c(0, 0, 0);
+                for (int i = 0; i < coeffCount; i++)
+                {
+                    c.x += basis[i] * probes.Row(i, 0)[p];
+                    c.y += basis[i] * probes.Row(i, 1)[p];
+                    c.z += basis[i] * probes.Row(i, 2)[p];
+                }
+                dst[p] = c;
+            }
+        }
+    }
+
+    // ============================================
+    // Blend
+    // ============================================
+
+    void BlendBatch(const CSHBatch& probes, const uint32_t* indices, const float* weights,
+                    size_t targetCount, int k, CSHBatch& out, EBatchKernel kernel)
+    {
+        out.Reset(probes.GetOrder(), targetCount);
+        const int rowCount = probes.GetCoeffCount() * 3;
+
+        size_t t = 0;
+#if FF_SH_SIMD
+        if (kernel == EBatchKernel::SIMD)
+        {
+            // 4 targets per group; sources are gathered per row (no gather in SSE2),
+            // the weights are loaded once per group
+            std::vector<float> w((size_t)k * 4);
+            std::vector<uint32_t> src((size_t)k * 4);
+            for (; t + 4 <= targetCount; t += 4)
+            {
+                for (int j = 0; j < k; j++)
+                {
+                    for (int lane = 0; lane < 4; lane++)
+                    {
+                        w[j * 4 + lane] = weights[(t + lane) * k + j];
+                        src[j * 4 + lane] = indices[(t + lane) * k + j];
+                    }
+                }
+                for (int row = 0; row < rowCount; row++)
+                {
+                    const float* in = probes.Row(row / 3, row % 3);
+                    __m128 sum = _mm_setzero_ps();
+                    for (int j = 0; j < k; j++)
+                    {
+                        const uint32_t* s = &src[j * 4];
+                        __m128 v = _mm_setr_ps(in[s[0]], in[s[1]], in[s[2]], in[s[3]]);
+                        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&w[j * 4]), v));
+                    }
+                    _mm_storeu_ps(out.Row(row / 3, row % 3) + t, sum);
+                }
+            }
+        }
+#endif
+        for (; t < targetCount; t++)
+        {
+            for (int row = 0; row < rowCount; row++)
+            {
+                const float* in = probes.Row(row / 3, row % 3);
+                float sum = 0.0f;
+                for (int j = 0; j < k; j++)
+                    sum += weights[t * k + j] * in[indices[t * k + j]];
+                out.Row(row / 3, row % 3)[t] = sum;
+            }
+        }
+    }
+
+    // ============================================
+    // Rotate
+    // ============================================
+
+    void RotateBatch(const CSHBatch& in, const XMFLOAT3X3& rotation, CSHBatch& out, EBatchKernel kernel)
+    {
+        CSHBatch copy;
+        const CSHBatch* src = &in;
+        if (&in == &out)
+        {
+            copy = in;
+            src = &copy;
+        }
+        out.Reset(src->GetOrder(), src->GetCount());
+
+        std::array<std::array<float, MAX_BAND_SIZE * MAX_BAND_SIZE>, 5> matrix;
+        buildRotation(src->GetOrder(), rotation, matrix);
+
+        const size_t stride = src->GetStride();
+        for (int c = 0; c < 3; c++)
+            std::memcpy(out.Row(0, c), src->Row(0, c), stride * sizeof(float));
+
+        for (int band = 1; band <= src->GetOrder(); band++)
+        {
+            const int first = band * band;
+            const int n = 2 * band + 1;
+            const float* m = matrix[band].data();
+
+            for (int c = 0; c < 3; c++)
+            {
+                for (int row = 0; row < n; row++)
+                {
+                    float* dst = out.Row(first + row, c);
+                    size_t p = 0;
+#if FF_SH_SIMD
+                    if (kernel == EBatchKernel::SIMD)
+                    {
+                        for (; p < stride; p += 4)
+                        {
+                            __m128 sum = _mm_setzero_ps();
+                            for (int j = 0; j < n; j++)
+                                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m[row * n + j]), _mm_loadu_ps(src->Row(first + j, c) + p)));
+                            _mm_storeu_ps(dst + p, sum);
+                        }
+                    }
+#endif
+                    for (; p < stride; p++)
+                    {
+                        float sum = 0.0f;
+                        for (int j = 0; j < n; j++)
+                            sum += m[row * n + j] * src->Row(first + j, c)[p];
+                        dst[p] = sum;
+                    }
+                }
+            }
+        }
+    }
+
+    // ============================================
+    // Windowing
+    // ============================================
+    // Sloan, "Deringing Spherical Harmonics" (SIGGRAPH Asia 2017)
+
+    void ComputeWindow(ESHWindow window, int order, float width, float* outBandScale)
+    {
+        const float pi = 3.14159265f;
+        for (int l = 0; l <= order; l++)
+        {
+            if (l == 0)
+                outBandScale[l] = 1.0f;
+            else if ((float)l >= width)
+                outBandScale[l] = 0.0f;
+            else if (window == ESHWindow::Hanning)
+                outBandScale[l] = 0.5f * (1.0f + std::cos(pi * l / width));
+            else
+                outBandScale[l] = std::sin(pi * l / width) / (pi * l / width);
+        }
+    }
+
+    void ApplyWindow(CSHBatch& probes, ESHWindow window, float width, EBatchKernel kernel)
+    {
+        float scale[5];
+        ComputeWindow(window, probes.GetOrder(), width, scale);
+
+        const size_t stride = probes.GetStride();
+        for (int i = 0; i < probes.GetCoeffCount(); i++)
+        {
+            const float s = scale[(int)std::sqrt((float)i)];   // band of coefficient i
+            for (int c = 0; c < 3; c++)
+            {
+                float* row = probes.Row(i, c);
+                size_t p = 0;
+#if FF_SH_SIMD
+                if (kernel == EBatchKernel::SIMD)
+                {
+                    const __m128 s4 = _mm_set1_ps(s);
+                    for (; p < stride; p += 4)
+                        _mm_storeu_ps(row + p, _mm_mul_ps(s4, _mm_loadu_ps(row + p)));
+                }
+#endif
+                for (; p < stride; p++)
+                    row[p] *= s;
+            }
+        }
+    }
+
+} // namespace SphericalHarmonics
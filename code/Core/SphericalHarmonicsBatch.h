@@ -0,0 +1,121 @@
+#pragma once
+#include "SphericalHarmonics.h"
+#include <DirectXMath.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================
+// SphericalHarmonicsBatch - SH operations on many probes at once
+// ============================================
+// CSHBatch stores the coefficients of N probes (L1 - L4) structure-of-arrays:
+// one row of N floats per (coefficient, channel), rows padded with zeros to a
+// multiple of 4. The SIMD kernels process 4 probes per instruction; whatever
+// is per-call (basis of a direction, rotation matrix, window) is computed
+// once and shared by the whole batch.
+//
+//   EvaluateBatch   N probes x M directions
+//   BlendBatch      each target = weighted sum of K source probes
+//   RotateBatch     one rotation applied to every probe
+//   ApplyWindow     Hanning / Lanczos deringing
+//
+// Single probes keep using the SphericalHarmonics functions; CSHBatch
+// converts from / to their XMFLOAT3[] layout with SetProbe / GetProbe.
+
+namespace SphericalHarmonics
+{
+    enum class EBatchKernel
+    {
+        Scalar,
+        SIMD        // Falls back to Scalar when FF_SH_SIMD == 0
+    };
+
+#if FF_SH_SIMD
+    constexpr EBatchKernel SH_BATCH_DEFAULT_KERNEL = EBatchKernel::SIMD;
+#else
+    constexpr EBatchKernel SH_BATCH_DEFAULT_KERNEL = EBatchKernel::Scalar;
+#endif
+
+    enum class ESHWindow
+    {
+        Hanning,    // (1 + cos(π l / w)) / 2
+        Lanczos     // sinc(π l / w)
+    };
+
+    // ============================================
+    // CSHBatch
+    // ============================================
+    class CSHBatch
+    {
+    public:
+        CSHBatch() = default;
+        CSHBatch(int order, size_t count) { Reset(order, count); }
+
+        // order: 1 - 4. All coefficients are set to 0.
+        void Reset(int order, size_t count);
+
+        int GetOrder() const { return m_order; }
+        int GetCoeffCount() const { return CoeffCount(m_order); }
+        size_t GetCount() const { return m_count; }
+        size_t GetStride() const { return m_stride; }
+
+        // GetStride() floats, one per probe (padding is 0)
+        float* Row(int coeff, int channel) { return m_data.data() + ((size_t)coeff * 3 + channel) * m_stride; }
+        const float* Row(int coeff, int channel) const { return m_data.data() + ((size_t)coeff * 3 + channel) * m_stride; }
+
+        // coeffs: GetCoeffCount() RGB coefficients (same layout as ProjectCubemapToSH*)
+        void SetProbe(size_t probe, const DirectX::XMFLOAT3* coeffs);
+        void GetProbe(size_t probe, DirectX::XMFLOAT3* coeffs) const;
+
+    private:
+        int m_order = 2;
+        size_t m_count = 0;
+        size_t m_stride = 0;
+        std::vector<float> m_data;
+    };
+
+    // out[d * probes.GetCount() + p] = Σ_i c_i(p) * Y_i(dirs[d])
+    // Not clamped (EvaluateSH clamps negative values to 0).
+    void EvaluateBatch(
+        const CSHBatch& probes,
+        const DirectX::XMFLOAT3* dirs,
+        size_t dirCount,
+        DirectX::XMFLOAT3* out,
+        EBatchKernel kernel = SH_BATCH_DEFAULT_KERNEL
+    );
+
+    // out probe t = Σ_k weights[t * k + j] * probes[indices[t * k + j]], j < k
+    // Weights are used as given (normalize them beforehand for an average).
+    // out is reset to targetCount probes of the same order.
+    void BlendBatch(
+        const CSHBatch& probes,
+        const uint32_t* indices,
+        const float* weights,
+        size_t targetCount,
+        int k,
+        CSHBatch& out,
+        EBatchKernel kernel = SH_BATCH_DEFAULT_KERNEL
+    );
+
+    // Rotate the lighting of every probe: afterwards the probes evaluated at
+    // d * rotation (DirectXMath row-vector convention) give what the input gave
+    // at d. rotation must be orthonormal. in and out may be the same batch.
+    void RotateBatch(
+        const CSHBatch& in,
+        const DirectX::XMFLOAT3X3& rotation,
+        CSHBatch& out,
+        EBatchKernel kernel = SH_BATCH_DEFAULT_KERNEL
+    );
+
+    // Per-band scale σ_l for l = 0..order (width: bands at l >= width are
+    // removed; order + 1 keeps every band)
+    void ComputeWindow(ESHWindow window, int order, float width, float* outBandScale);
+
+    void ApplyWindow(
+        CSHBatch& probes,
+        ESHWindow window,
+        float width,
+        EBatchKernel kernel = SH_BATCH_DEFAULT_KERNEL
+    );
+
+} // namespace SphericalHarmonics
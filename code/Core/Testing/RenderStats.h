@@ -40,6 +40,23 @@ public:
         }
     }
 
+    // Frustum culling tracking (view 0 = camera, 1..4 = shadow cascades)
+    void RecordCulling(int viewIndex, int testedCount, int visibleCount) {
+        if (viewIndex >= 0 && viewIndex < MAX_CULL_VIEWS) {
+            m_cullTested[viewIndex] = testedCount;
+            m_cullVisible[viewIndex] = visibleCount;
+        }
+    }
+    void RecordCullTime(float ms) { m_cullTimeMs = ms; }
+
+    // Mesh LOD selection (one call per mesh drawn; levels past the last slot are merged into it)
+    void RecordLodDraw(bool shadow, int lod, int triangles) {
+        int slot = lod < 0 ? 0 : (lod < MAX_LOD_STATS ? lod : MAX_LOD_STATS - 1);
+        int pass = shadow ? 1 : 0;
+        m_lodDraws[pass][slot]++;
+        m_lodTriangles[pass][slot] += triangles;
+    }
+
     // Reset per-frame counters (call at frame start)
     void BeginFrame() {
         m_drawCallCount = 0;
@@ -48,6 +65,17 @@ public:
         for (int i = 0; i < 4; ++i) {
             m_shadowDrawCalls[i] = 0;
         }
+        for (int i = 0; i < MAX_CULL_VIEWS; ++i) {
+            m_cullTested[i] = 0;
+            m_cullVisible[i] = 0;
+        }
+        m_cullTimeMs = 0.0f;
+        for (int p = 0; p < 2; ++p) {
+            for (int i = 0; i < MAX_LOD_STATS; ++i) {
+                m_lodDraws[p][i] = 0;
+                m_lodTriangles[p][i] = 0;
+            }
+        }
     }
 
     // Reset all statistics
@@ -102,6 +130,29 @@ public:
         }
         oss << "  Total Shadow Draw Calls: " << totalShadowDrawCalls << "\n";
 
+        // Culling stats
+        oss << "\n[Frustum Culling]\n";
+        for (int i = 0; i < MAX_CULL_VIEWS; ++i) {
+            if (m_cullTested[i] > 0) {
+                oss << "  " << (i == 0 ? "Camera" : "Cascade " + std::to_string(i - 1))
+                    << ": visible " << m_cullVisible[i] << ", culled " << GetCulledCount(i)
+                    << " / " << m_cullTested[i] << "\n";
+            }
+        }
+        oss << "  Cull Time: " << std::fixed << std::setprecision(3) << m_cullTimeMs << " ms\n";
+
+        // LOD stats
+        oss << "\n[LOD]\n";
+        for (int p = 0; p < 2; ++p) {
+            oss << (p == 0 ? "  Main:  " : "  Shadow:");
+            for (int i = 0; i < MAX_LOD_STATS; ++i) {
+                if (m_lodDraws[p][i] > 0) {
+                    oss << " LOD" << i << " " << m_lodDraws[p][i] << " draws / " << m_lodTriangles[p][i] << " tris;";
+                }
+            }
+            oss << " total " << GetLodTriangles(p == 1) << " tris\n";
+        }
+
         oss << "\n================================\n";
 
         return oss.str();
@@ -114,6 +165,18 @@ public:
     int GetDrawCallCount() const { return m_drawCallCount; }
     int GetTotalVertices() const { return m_totalVertices; }
     int GetTotalIndices() const { return m_totalIndices; }
+    int GetVisibleCount(int viewIndex) const { return (viewIndex >= 0 && viewIndex < MAX_CULL_VIEWS) ? m_cullVisible[viewIndex] : 0; }
+    int GetCulledCount(int viewIndex) const { return (viewIndex >= 0 && viewIndex < MAX_CULL_VIEWS) ? m_cullTested[viewIndex] - m_cullVisible[viewIndex] : 0; }
+    float GetCullTimeMs() const { return m_cullTimeMs; }
+    int GetLodDraws(bool shadow, int lod) const { return (lod >= 0 && lod < MAX_LOD_STATS) ? m_lodDraws[shadow ? 1 : 0][lod] : 0; }
+    int GetLodTriangles(bool shadow) const {
+        int total = 0;
+        for (int i = 0; i < MAX_LOD_STATS; ++i) total += m_lodTriangles[shadow ? 1 : 0][i];
+        return total;
+    }
+
+    static const int MAX_CULL_VIEWS = 5;    // Camera + 4 cascades
+    static const int MAX_LOD_STATS = 8;
 
 private:
     CRenderStats() = default;
@@ -131,4 +194,13 @@ private:
 
     // Shadow stats
     int m_shadowDrawCalls[4] = {0, 0, 0, 0};
+
+    // Culling stats
+    int m_cullTested[MAX_CULL_VIEWS] = {0, 0, 0, 0, 0};
+    int m_cullVisible[MAX_CULL_VIEWS] = {0, 0, 0, 0, 0};
+    float m_cullTimeMs = 0.0f;
+
+    // LOD stats, [0] = main pass, [1] = shadow cascades
+    int m_lodDraws[2][MAX_LOD_STATS] = {};
+    int m_lodTriangles[2][MAX_LOD_STATS] = {};
 };
@@ -0,0 +1,886 @@
+#include "TextureCooker.h"
+#include "Jobs/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace
+{
+    double millisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // Rows [0, count) split into jobs of at least minItems items (rows * itemsPerRow)
+    void forRows(uint32_t count, uint32_t itemsPerRow, uint32_t minItems, bool parallel,
+                 const std::function<void(uint32_t begin, uint32_t end)>& func) {
+        if (!parallel || (uint64_t)count * itemsPerRow <= minItems) {
+            func(0, count);
+            return;
+        }
+        uint32_t grain = std::max(1u, minItems / std::max(1u, itemsPerRow));
+        CJobSystem::Instance().ParallelFor(count, grain, func);
+    }
+
+    // ============================================
+    // sRGB transfer
+    // ============================================
+    struct SSrgbTables {
+        float toLinear[256];
+        uint8_t toSrgb[4096];       // Linear quantized to 12 bits
+
+        SSrgbTables() {
+            for (int i = 0; i < 256; i++) {
+                float c = i / 255.0f;
+                toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            for (int i = 0; i < 4096; i++) {
+                float l = i / 4095.0f;
+                float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                toSrgb[i] = (uint8_t)std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f);
+            }
+        }
+    };
+
+    const SSrgbTables& srgbTables() {
+        static const SSrgbTables tables;
+        return tables;
+    }
+
+    uint8_t unorm8(float v) {
+        return (uint8_t)std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f);
+    }
+
+    // ============================================
+    // Mip filter
+    // ============================================
+    enum class EMipFilter { Linear, Srgb, Normal };
+
+    // 2x2 box of src (clamped at odd edges) into one level down
+    void downsample(EMipFilter filter, const uint8_t* src, uint32_t srcW, uint32_t srcH, uint32_t srcPitch,
+                    uint8_t* dst, uint32_t dstW, uint32_t dstH, bool parallel) {
+        const SSrgbTables& srgb = srgbTables();
+        forRows(dstH, dstW, 4096, parallel, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t y = begin; y < end; y++) {
+                const uint8_t* row0 = src + (size_t)std::min(2 * y, srcH - 1) * srcPitch;
+                const uint8_t* row1 = src + (size_t)std::min(2 * y + 1, srcH - 1) * srcPitch;
+                uint8_t* out = dst + (size_t)y * dstW * 4;
+                for (uint32_t x = 0; x < dstW; x++, out += 4) {
+                    uint32_t x0 = std::min(2 * x, srcW - 1) * 4;
+                    uint32_t x1 = std::min(2 * x + 1, srcW - 1) * 4;
+                    const uint8_t* p[4] = {row0 + x0, row0 + x1, row1 + x0, row1 + x1};
+
+                    uint32_t alpha = p[0][3] + p[1][3] + p[2][3] + p[3][3];
+                    out[3] = (uint8_t)((alpha + 2) / 4);
+
+                    if (filter == EMipFilter::Srgb) {
+                        for (int c = 0; c < 3; c++) {
+                            float l = 0.25f * (srgb.toLinear[p[0][c]] + srgb.toLinear[p[1][c]] +
+                                               srgb.toLinear[p[2][c]] + srgb.toLinear[p[3][c]]);
+                            out[c] = srgb.toSrgb[(int)(l * 4095.0f + 0.5f)];
+                        }
+                    } else if (filter == EMipFilter::Normal) {
+                        float n[3] = {0.0f, 0.0f, 0.0f};
+                        for (int i = 0; i < 4; i++) {
+                            for (int c = 0; c < 3; c++) {
+                                n[c] += p[i][c] / 127.5f - 1.0f;
+                            }
+                        }
+                        float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                        if (len < 1e-6f) {
+                            n[0] = 0.0f; n[1] = 0.0f; n[2] = 1.0f; len = 1.0f;
+                        }
+                        for (int c = 0; c < 3; c++) {
+                            out[c] = unorm8(n[c] / len * 0.5f + 0.5f);
+                        }
+                    } else {
+                        for (int c = 0; c < 3; c++) {
+                            out[c] = (uint8_t)((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) / 4);
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    // ============================================
+    // Block helpers
+    // ============================================
+    struct SBlock {
+        uint8_t px[16][4];
+    };
+
+    // 4x4 block at (bx, by), edge pixels repeated past the image
+    void loadBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t rowPitch,
+                   uint32_t bx, uint32_t by, SBlock& block) {
+        for (uint32_t y = 0; y < 4; y++) {
+            const uint8_t* row = rgba + (size_t)std::min(by * 4 + y, height - 1) * rowPitch;
+            for (uint32_t x = 0; x < 4; x++) {
+                memcpy(block.px[y * 4 + x], row + std::min(bx * 4 + x, width - 1) * 4, 4);
+            }
+        }
+    }
+
+    // Principal axis of the block over the first `channels` channels (power iteration)
+    void principalAxis(const SBlock& block, int channels, float mean[4], float axis[4]) {
+        for (int c = 0; c < 4; c++) {
+            mean[c] = 0.0f;
+            axis[c] = 0.0f;
+        }
+        for (int i = 0; i < 16; i++) {
+            for (int c = 0; c < channels; c++) mean[c] += block.px[i][c];
+        }
+        for (int c = 0; c < channels; c++) mean[c] /= 16.0f;
+
+        float cov[4][4] = {};
+        for (int i = 0; i < 16; i++) {
+            float d[4];
+            for (int c = 0; c < channels; c++) d[c] = block.px[i][c] - mean[c];
+            for (int a = 0; a < channels; a++) {
+                for (int b = a; b < channels; b++) cov[a][b] += d[a] * d[b];
+            }
+        }
+        for (int a = 0; a < channels; a++) {
+            for (int b = 0; b < a; b++) cov[a][b] = cov[b][a];
+        }
+
+        // Start from the largest-variance channel direction, a few iterations are plenty for 16 points
+        int start = 0;
+        for (int c = 1; c < channels; c++) {
+            if (cov[c][c] > cov[start][start]) start = c;
+        }
+        float v[4] = {};
+        for (int c = 0; c < channels; c++) v[c] = cov[start][c];
+        for (int iter = 0; iter < 6; iter++) {
+            float next[4] = {};
+            for (int a = 0; a < channels; a++) {
+                for (int b = 0; b < channels; b++) next[a] += cov[a][b] * v[b];
+            }
+            float len = 0.0f;
+            for (int c = 0; c < channels; c++) len += next[c] * next[c];
+            if (len < 1e-12f) break;
+            len = 1.0f / std::sqrt(len);
+            for (int c = 0; c < channels; c++) v[c] = next[c] * len;
+        }
+        float len = 0.0f;
+        for (int c = 0; c < channels; c++) len += v[c] * v[c];
+        if (len < 1e-12f) {
+            for (int c = 0; c < channels; c++) v[c] = 1.0f;   // Flat block: any axis
+            len = (float)channels;
+        }
+        len = 1.0f / std::sqrt(len);
+        for (int c = 0; c < channels; c++) axis[c] = v[c] * len;
+    }
+
+    // Endpoints at the extreme projections of the block on the principal axis
+    void axisEndpoints(const SBlock& block, int channels, float e0[4], float e1[4]) {
+        float mean[4], axis[4];
+        principalAxis(block, channels, mean, axis);
+        float tMin = 0.0f, tMax = 0.0f;
+        for (int i = 0; i < 16; i++) {
+            float t = 0.0f;
+            for (int c = 0; c < channels; c++) t += (block.px[i][c] - mean[c]) * axis[c];
+            tMin = std::min(tMin, t);
+            tMax = std::max(tMax, t);
+        }
+        for (int c = 0; c < channels; c++) {
+            e0[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+            e1[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+        }
+    }
+
+    // Least-squares endpoints for fixed weights (w = share of e1). False if degenerate.
+    bool refitEndpoints(const SBlock& block, int channels, const float weights[16], float e0[4], float e1[4]) {
+        float a = 0.0f, b = 0.0f, c2 = 0.0f;
+        float x0[4] = {}, x1[4] = {};
+        for (int i = 0; i < 16; i++) {
+            float w = weights[i], iw = 1.0f - w;
+            a += iw * iw;
+            b += iw * w;
+            c2 += w * w;
+            for (int c = 0; c < channels; c++) {
+                x0[c] += iw * block.px[i][c];
+                x1[c] += w * block.px[i][c];
+            }
+        }
+        float det = a * c2 - b * b;
+        if (std::fabs(det) < 1e-6f) {
+            return false;
+        }
+        float inv = 1.0f / det;
+        for (int c = 0; c < channels; c++) {
+            e0[c] = std::clamp((c2 * x0[c] - b * x1[c]) * inv, 0.0f, 255.0f);
+            e1[c] = std::clamp((a * x1[c] - b * x0[c]) * inv, 0.0f, 255.0f);
+        }
+        return true;
+    }
+
+    // Palette position (0..64 along the line) -> nearest palette entry, for
+    // palettes whose entries sit at weights[0..steps) (in 1/64)
+    struct SWeightLookup {
+        uint8_t index[65];
+
+        SWeightLookup(const int* weights, int steps) {
+            for (int t = 0; t <= 64; t++) {
+                int best = 0;
+                for (int s = 1; s < steps; s++) {
+                    if (std::abs(weights[s] - t) < std::abs(weights[best] - t)) best = s;
+                }
+                index[t] = (uint8_t)best;
+            }
+        }
+    };
+
+    // Each pixel is projected on the palette line (palette[0] -> palette[steps - 1])
+    // and takes the entry nearest to its position. Returns the squared error.
+    uint32_t fitIndices(const SBlock& block, int channels, const int (*palette)[4], int steps,
+                        const SWeightLookup& lookup, uint8_t outIndices[16]) {
+        int dir[4] = {};
+        int dirLen = 0;
+        for (int c = 0; c < channels; c++) {
+            dir[c] = palette[steps - 1][c] - palette[0][c];
+            dirLen += dir[c] * dir[c];
+        }
+
+        uint32_t total = 0;
+        for (int i = 0; i < 16; i++) {
+            int index = 0;
+            if (dirLen > 0) {
+                int dot = 0;
+                for (int c = 0; c < channels; c++) dot += (block.px[i][c] - palette[0][c]) * dir[c];
+                int t = std::clamp((dot * 64 + dirLen / 2) / dirLen, 0, 64);
+                index = lookup.index[t];
+            }
+            outIndices[i] = (uint8_t)index;
+            for (int c = 0; c < channels; c++) {
+                int d = block.px[i][c] - palette[index][c];
+                total += (uint32_t)(d * d);
+            }
+        }
+        return total;
+    }
+
+    // ============================================
+    // BC1 color block
+    // ============================================
+    uint16_t pack565(const float c[4]) {
+        int r = std::clamp((int)std::lround(c[0] * 31.0f / 255.0f), 0, 31);
+        int g = std::clamp((int)std::lround(c[1] * 63.0f / 255.0f), 0, 63);
+        int b = std::clamp((int)std::lround(c[2] * 31.0f / 255.0f), 0, 31);
+        return (uint16_t)((r << 11) | (g << 5) | b);
+    }
+
+    void unpack565(uint16_t v, int out[4]) {
+        int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+        out[0] = (r << 3) | (r >> 2);
+        out[1] = (g << 2) | (g >> 4);
+        out[2] = (b << 3) | (b >> 2);
+        out[3] = 255;
+    }
+
+    // Four-color palette in line order (e0, 2/3 e0, 1/3 e0, e1)
+    void bc1Palette(uint16_t c0, uint16_t c1, int line[4][4]) {
+        unpack565(c0, line[0]);
+        unpack565(c1, line[3]);
+        for (int c = 0; c < 4; c++) {
+            line[1][c] = (2 * line[0][c] + line[3][c] + 1) / 3;
+            line[2][c] = (line[0][c] + 2 * line[3][c] + 1) / 3;
+        }
+    }
+
+    // Line order -> BC1 index (0 = color0, 1 = color1, 2 = 2/3 color0, 3 = 1/3 color0)
+    const uint8_t kBC1Index[4] = {0, 2, 3, 1};
+    const int kBC1Weights[4] = {0, 21, 43, 64};
+    const SWeightLookup kBC1Lookup(kBC1Weights, 4);
+
+    uint32_t tryBC1(const SBlock& block, const float e0[4], const float e1[4],
+                    uint16_t& outC0, uint16_t& outC1, uint8_t outLine[16]) {
+        uint16_t c0 = pack565(e0), c1 = pack565(e1);
+        if (c0 < c1) {
+            std::swap(c0, c1);   // color0 > color1 selects the four-color mode
+        }
+        outC0 = c0;
+        outC1 = c1;
+        int line[4][4];
+        bc1Palette(c0, c1, line);
+        return fitIndices(block, 3, line, c0 == c1 ? 1 : 4, kBC1Lookup, outLine);
+    }
+
+    void encodeColorBlock(const SBlock& block, uint8_t* out) {
+        float e0[4], e1[4];
+        axisEndpoints(block, 3, e0, e1);
+
+        uint16_t c0, c1;
+        uint8_t line[16];
+        uint32_t err = tryBC1(block, e0, e1, c0, c1, line);
+
+        // One least-squares pass with the indices just chosen
+        if (err > 0 && c0 != c1) {
+            static const float kLineWeight[4] = {0.0f, 1.0f / 3.0f, 2.0f / 3.0f, 1.0f};
+            float weights[16];
+            for (int i = 0; i < 16; i++) weights[i] = kLineWeight[line[i]];
+            // Weights follow the palette (color0 -> color1), not the unquantized e0 / e1
+            float f0[4], f1[4];
+            if (refitEndpoints(block, 3, weights, f0, f1)) {
+                uint16_t r0, r1;
+                uint8_t refitLine[16];
+                uint32_t refitErr = tryBC1(block, f0, f1, r0, r1, refitLine);
+                if (refitErr < err) {
+                    err = refitErr;
+                    c0 = r0;
+                    c1 = r1;
+                    memcpy(line, refitLine, 16);
+                }
+            }
+        }
+
+        uint32_t bits = 0;
+        for (int i = 0; i < 16; i++) {
+            bits |= (uint32_t)(c0 == c1 ? 0 : kBC1Index[line[i]]) << (2 * i);
+        }
+        memcpy(out + 0, &c0, 2);
+        memcpy(out + 2, &c1, 2);
+        memcpy(out + 4, &bits, 4);
+    }
+
+    void decodeColorBlock(const uint8_t* in, bool alwaysFourColor, uint8_t out[16][4]) {
+        uint16_t c0, c1;
+        uint32_t bits;
+        memcpy(&c0, in + 0, 2);
+        memcpy(&c1, in + 2, 2);
+        memcpy(&bits, in + 4, 4);
+
+        int palette[4][4];
+        unpack565(c0, palette[0]);
+        unpack565(c1, palette[1]);
+        if (c0 > c1 || alwaysFourColor) {
+            for (int c = 0; c < 3; c++) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+            }
+            palette[2][3] = palette[3][3] = 255;
+        } else {
+            for (int c = 0; c < 3; c++) {
+                palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+                palette[3][c] = 0;
+            }
+            palette[2][3] = 255;
+            palette[3][3] = 0;
+        }
+        for (int i = 0; i < 16; i++) {
+            const int* p = palette[(bits >> (2 * i)) & 3];
+            for (int c = 0; c < 4; c++) out[i][c] = (uint8_t)p[c];
+        }
+    }
+
+    // ============================================
+    // BC4 single channel (BC3 alpha, BC5 R / G)
+    // ============================================
+    void encodeChannelBlock(const SBlock& block, int channel, uint8_t* out) {
+        int lo = 255, hi = 0;
+        for (int i = 0; i < 16; i++) {
+            lo = std::min<int>(lo, block.px[i][channel]);
+            hi = std::max<int>(hi, block.px[i][channel]);
+        }
+        out[0] = (uint8_t)hi;   // a0 > a1: eight-value mode
+        out[1] = (uint8_t)lo;
+
+        uint64_t bits = 0;
+        if (hi > lo) {
+            for (int i = 0; i < 16; i++) {
+                // Step along lo -> hi (0..7), then to the BC4 index: 7 -> 0, 0 -> 1, k -> 8 - k
+                int k = ((block.px[i][channel] - lo) * 14 + (hi - lo)) / (2 * (hi - lo));
+                uint64_t index = k == 7 ? 0 : (k == 0 ? 1 : (uint64_t)(8 - k));
+                bits |= index << (3 * i);
+            }
+        }
+        for (int b = 0; b < 6; b++) {
+            out[2 + b] = (uint8_t)(bits >> (8 * b));
+        }
+    }
+
+    void decodeChannelBlock(const uint8_t* in, int channel, uint8_t out[16][4]) {
+        int a0 = in[0], a1 = in[1];
+        int palette[8] = {a0, a1};
+        if (a0 > a1) {
+            for (int i = 2; i < 8; i++) palette[i] = ((8 - i) * a0 + (i - 1) * a1 + 3) / 7;
+        } else {
+            for (int i = 2; i < 6; i++) palette[i] = ((6 - i) * a0 + (i - 1) * a1 + 2) / 5;
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+        uint64_t bits = 0;
+        for (int b = 0; b < 6; b++) {
+            bits |= (uint64_t)in[2 + b] << (8 * b);
+        }
+        for (int i = 0; i < 16; i++) {
+            out[i][channel] = (uint8_t)palette[(bits >> (3 * i)) & 7];
+        }
+    }
+
+    // ============================================
+    // BC7 mode 6
+    // ============================================
+    const int kBC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    const SWeightLookup kBC7Lookup(kBC7Weights4, 16);
+
+    struct SBC7Mode6 {
+        int q[2][4];        // 7-bit endpoints
+        int p[2];           // p-bits
+        uint8_t index[16];
+        uint32_t error = UINT32_MAX;
+    };
+
+    void bc7Palette(const SBC7Mode6& m, int palette[16][4]) {
+        for (int c = 0; c < 4; c++) {
+            int a = (m.q[0][c] << 1) | m.p[0];
+            int b = (m.q[1][c] << 1) | m.p[1];
+            for (int s = 0; s < 16; s++) {
+                palette[s][c] = ((64 - kBC7Weights4[s]) * a + kBC7Weights4[s] * b + 32) >> 6;
+            }
+        }
+    }
+
+    // Best p-bit pair for float endpoints
+    void tryBC7(const SBlock& block, const float e0[4], const float e1[4], SBC7Mode6& best) {
+        for (int pb = 0; pb < 4; pb++) {
+            SBC7Mode6 m;
+            m.p[0] = pb & 1;
+            m.p[1] = pb >> 1;
+            for (int c = 0; c < 4; c++) {
+                m.q[0][c] = std::clamp((int)std::lround((e0[c] - m.p[0]) * 0.5f), 0, 127);
+                m.q[1][c] = std::clamp((int)std::lround((e1[c] - m.p[1]) * 0.5f), 0, 127);
+            }
+            int palette[16][4];
+            bc7Palette(m, palette);
+            m.error = fitIndices(block, 4, palette, 16, kBC7Lookup, m.index);
+            if (m.error < best.error) {
+                best = m;
+            }
+        }
+    }
+
+    struct SBitWriter {
+        uint8_t* out;
+        uint32_t pos = 0;
+
+        void write(uint32_t value, uint32_t count) {
+            for (uint32_t i = 0; i < count; i++, pos++) {
+                out[pos >> 3] |= (uint8_t)(((value >> i) & 1) << (pos & 7));
+            }
+        }
+    };
+
+    struct SBitReader {
+        const uint8_t* in;
+        uint32_t pos = 0;
+
+        uint32_t read(uint32_t count) {
+            uint32_t value = 0;
+            for (uint32_t i = 0; i < count; i++, pos++) {
+                value |= (uint32_t)((in[pos >> 3] >> (pos & 7)) & 1) << i;
+            }
+            return value;
+        }
+    };
+
+    void encodeBC7Block(const SBlock& block, uint8_t* out) {
+        float e0[4], e1[4];
+        axisEndpoints(block, 4, e0, e1);
+
+        SBC7Mode6 best;
+        tryBC7(block, e0, e1, best);
+
+        if (best.error > 0) {
+            float weights[16];
+            for (int i = 0; i < 16; i++) weights[i] = kBC7Weights4[best.index[i]] / 64.0f;
+            if (refitEndpoints(block, 4, weights, e0, e1)) {
+                tryBC7(block, e0, e1, best);
+            }
+        }
+
+        // The anchor (pixel 0) index has an implicit 0 MSB: mirror the block if needed
+        if (best.index[0] >= 8) {
+            for (int c = 0; c < 4; c++) std::swap(best.q[0][c], best.q[1][c]);
+            std::swap(best.p[0], best.p[1]);
+            for (int i = 0; i < 16; i++) best.index[i] = (uint8_t)(15 - best.index[i]);
+        }
+
+        memset(out, 0, 16);
+        SBitWriter writer{out};
+        writer.write(1u << 6, 7);               // Mode 6
+        for (int c = 0; c < 4; c++) {
+            writer.write((uint32_t)best.q[0][c], 7);
+            writer.write((uint32_t)best.q[1][c], 7);
+        }
+        writer.write((uint32_t)best.p[0], 1);
+        writer.write((uint32_t)best.p[1], 1);
+        for (int i = 0; i < 16; i++) {
+            writer.write(best.index[i], i == 0 ? 3 : 4);
+        }
+    }
+
+    void decodeBC7Block(const uint8_t* in, uint8_t out[16][4]) {
+        SBitReader reader{in};
+        if (reader.read(7) != (1u << 6)) {
+            for (int i = 0; i < 16; i++) {
+                out[i][0] = 255; out[i][1] = 0; out[i][2] = 255; out[i][3] = 255;
+            }
+            return;
+        }
+        SBC7Mode6 m;
+        for (int c = 0; c < 4; c++) {
+            m.q[0][c] = (int)reader.read(7);
+            m.q[1][c] = (int)reader.read(7);
+        }
+        m.p[0] = (int)reader.read(1);
+        m.p[1] = (int)reader.read(1);
+        int palette[16][4];
+        bc7Palette(m, palette);
+        for (int i = 0; i < 16; i++) {
+            const int* p = palette[reader.read(i == 0 ? 3 : 4)];
+            for (int c = 0; c < 4; c++) out[i][c] = (uint8_t)p[c];
+        }
+    }
+
+    void encodeBlock(ETextureCookFormat format, const SBlock& block, uint8_t* out) {
+        switch (format) {
+            case ETextureCookFormat::BC1:
+                encodeColorBlock(block, out);
+                break;
+            case ETextureCookFormat::BC3:
+                encodeChannelBlock(block, 3, out);
+                encodeColorBlock(block, out + 8);
+                break;
+            case ETextureCookFormat::BC5:
+                encodeChannelBlock(block, 0, out);
+                encodeChannelBlock(block, 1, out + 8);
+                break;
+            case ETextureCookFormat::BC7:
+                encodeBC7Block(block, out);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void decodeBlock(ETextureCookFormat format, const uint8_t* in, uint8_t out[16][4]) {
+        switch (format) {
+            case ETextureCookFormat::BC1:
+                decodeColorBlock(in, false, out);
+                break;
+            case ETextureCookFormat::BC3:
+                decodeColorBlock(in + 8, true, out);
+                decodeChannelBlock(in, 3, out);
+                break;
+            case ETextureCookFormat::BC5:
+                decodeChannelBlock(in, 0, out);
+                decodeChannelBlock(in + 8, 1, out);
+                for (int i = 0; i < 16; i++) {
+                    out[i][2] = 0;
+                    out[i][3] = 255;
+                }
+                break;
+            case ETextureCookFormat::BC7:
+                decodeBC7Block(in, out);
+                break;
+            default:
+                memset(out, 0, 64);
+                break;
+        }
+    }
+
+    bool isBlockFormat(ETextureCookFormat format) {
+        return GetCookBlockBytes(format) != 0;
+    }
+}
+
+const char* GetCookFormatName(ETextureCookFormat format) {
+    switch (format) {
+        case ETextureCookFormat::Auto:  return "Auto";
+        case ETextureCookFormat::RGBA8: return "RGBA8";
+        case ETextureCookFormat::BC1:   return "BC1";
+        case ETextureCookFormat::BC3:   return "BC3";
+        case ETextureCookFormat::BC5:   return "BC5";
+        case ETextureCookFormat::BC7:   return "BC7";
+    }
+    return "?";
+}
+
+uint32_t GetCookBlockBytes(ETextureCookFormat format) {
+    switch (format) {
+        case ETextureCookFormat::BC1:   return 8;
+        case ETextureCookFormat::BC3:
+        case ETextureCookFormat::BC5:
+        case ETextureCookFormat::BC7:   return 16;
+        default:                        return 0;
+    }
+}
+
+RHI::ETextureFormat GetCookRHIFormat(ETextureCookFormat format, bool srgb) {
+    using RHI::ETextureFormat;
+    switch (format) {
+        case ETextureCookFormat::BC1:   return srgb ? ETextureFormat::BC1_UNORM_SRGB : ETextureFormat::BC1_UNORM;
+        case ETextureCookFormat::BC3:   return srgb ? ETextureFormat::BC3_UNORM_SRGB : ETextureFormat::BC3_UNORM;
+        case ETextureCookFormat::BC5:   return ETextureFormat::BC5_UNORM;
+        case ETextureCookFormat::BC7:   return srgb ? ETextureFormat::BC7_UNORM_SRGB : ETextureFormat::BC7_UNORM;
+        default:                        return srgb ? ETextureFormat::R8G8B8A8_UNORM_SRGB : ETextureFormat::R8G8B8A8_UNORM;
+    }
+}
+
+bool IsNormalMapRGBA8(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t rowPitch) {
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    // Up to 64x64 samples on a regular grid
+    const uint32_t stepX = std::max(1u, width / 64), stepY = std::max(1u, height / 64);
+    uint32_t samples = 0, unit = 0;
+    for (uint32_t y = stepY / 2; y < height; y += stepY) {
+        const uint8_t* row = rgba + (size_t)y * rowPitch;
+        for (uint32_t x = stepX / 2; x < width; x += stepX) {
+            const uint8_t* p = row + x * 4;
+            float nx = p[0] / 127.5f - 1.0f, ny = p[1] / 127.5f - 1.0f, nz = p[2] / 127.5f - 1.0f;
+            float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+            samples++;
+            if (std::fabs(len - 1.0f) < 0.15f && nz > -0.05f) {
+                unit++;
+            }
+        }
+    }
+    return unit * 100 >= samples * 95;
+}
+
+ETextureCookFormat SelectCookFormat(const SDecodedTexture& source, bool srgb,
+                                    const STextureCookOptions& options, bool* outNormalMap) {
+    const uint8_t* top = source.data.data() + (source.mips.empty() ? 0 : source.mips[0].offset);
+    const uint32_t pitch = source.mips.empty() ? source.width * 4 : source.mips[0].rowPitch;
+
+    bool normalMap = !srgb && options.detectNormalMaps && IsNormalMapRGBA8(top, source.width, source.height, pitch);
+    if (outNormalMap) {
+        *outNormalMap = normalMap;
+    }
+
+    ETextureCookFormat format = options.colorFormat;
+    if (normalMap && format != ETextureCookFormat::RGBA8) {
+        format = ETextureCookFormat::BC5;
+    } else if (format == ETextureCookFormat::BC5 || format == ETextureCookFormat::Auto) {
+        // BC5 drops blue and alpha: only meant for normal maps
+        bool opaque = true;
+        for (uint32_t y = 0; y < source.height && opaque; y++) {
+            const uint8_t* row = top + (size_t)y * pitch;
+            for (uint32_t x = 0; x < source.width; x++) {
+                if (row[x * 4 + 3] != 255) {
+                    opaque = false;
+                    break;
+                }
+            }
+        }
+        format = opaque ? ETextureCookFormat::BC1 : ETextureCookFormat::BC3;
+    }
+
+    // D3D12 needs block-aligned top levels
+    if (isBlockFormat(format) && (source.width % 4 != 0 || source.height % 4 != 0)) {
+        format = ETextureCookFormat::RGBA8;
+    }
+    return format;
+}
+
+bool CookTexture(const SDecodedTexture& source, const STextureCookOptions& options,
+                 SDecodedTexture& out, STextureCookReport* outReport) {
+    const bool srgb = source.format == RHI::ETextureFormat::R8G8B8A8_UNORM_SRGB;
+    if ((!srgb && source.format != RHI::ETextureFormat::R8G8B8A8_UNORM) || source.mips.empty() ||
+        source.width == 0 || source.height == 0) {
+        return false;
+    }
+
+    STextureCookReport report;
+    report.format = SelectCookFormat(source, srgb, options, &report.normalMap);
+
+    // ---- Mip chain (RGBA8) ----
+    auto start = std::chrono::high_resolution_clock::now();
+    struct SLevel {
+        uint32_t width, height, rowPitch;
+        const uint8_t* pixels;
+    };
+    std::vector<SLevel> levels;
+    std::vector<std::vector<uint8_t>> storage;      // Levels 1..N (level 0 is the source)
+    levels.push_back({source.width, source.height, source.mips[0].rowPitch,
+                      source.data.data() + source.mips[0].offset});
+
+    const EMipFilter filter = report.normalMap ? EMipFilter::Normal : (srgb ? EMipFilter::Srgb : EMipFilter::Linear);
+    if (options.generateMips) {
+        uint32_t levelCount = 1;
+        for (uint32_t size = std::max(source.width, source.height); size > 1; size >>= 1) {
+            levelCount++;
+        }
+        storage.reserve(levelCount - 1);
+        while (levels.size() < levelCount) {
+            const SLevel& prev = levels.back();
+            uint32_t w = std::max(1u, prev.width >> 1), h = std::max(1u, prev.height >> 1);
+            storage.emplace_back((size_t)w * h * 4);
+            downsample(filter, prev.pixels, prev.width, prev.height, prev.rowPitch,
+                       storage.back().data(), w, h, options.parallel);
+            levels.push_back({w, h, w * 4, storage.back().data()});
+        }
+    }
+    report.mipMs = millisecondsSince(start);
+
+    // ---- Encode ----
+    start = std::chrono::high_resolution_clock::now();
+    const RHI::ETextureFormat rhiFormat = GetCookRHIFormat(report.format, srgb);
+    size_t total = 0;
+    out.mips.clear();
+    for (const SLevel& level : levels) {
+        uint32_t pitch = RHI::GetRowPitch(rhiFormat, level.width);
+        uint32_t rows = isBlockFormat(report.format) ? (level.height + 3) / 4 : level.height;
+        out.mips.push_back({total, pitch});
+        total += (size_t)pitch * rows;
+        report.sourceBytes += (uint64_t)level.width * level.height * 4;
+    }
+    out.data.assign(total, 0);
+    for (size_t i = 0; i < levels.size(); i++) {
+        const SLevel& level = levels[i];
+        uint8_t* dst = out.data.data() + out.mips[i].offset;
+        if (isBlockFormat(report.format)) {
+            EncodeBlocks(report.format, level.pixels, level.width, level.height, level.rowPitch, dst, options.parallel);
+        } else {
+            for (uint32_t y = 0; y < level.height; y++) {
+                memcpy(dst + (size_t)y * out.mips[i].rowPitch, level.pixels + (size_t)y * level.rowPitch,
+                       (size_t)level.width * 4);
+            }
+        }
+    }
+    report.encodeMs = millisecondsSince(start);
+
+    out.width = source.width;
+    out.height = source.height;
+    out.format = rhiFormat;
+    out.generateMips = false;
+    report.mipCount = (uint32_t)levels.size();
+    report.cookedBytes = total;
+    if (outReport) {
+        *outReport = report;
+    }
+    return true;
+}
+
+// ============================================
+// Cooked texture payload
+// ============================================
+
+namespace
+{
+    struct SCookedTextureHeader {
+        uint32_t magic;
+        uint32_t width;
+        uint32_t height;
+        uint32_t format;        // RHI::ETextureFormat
+        uint32_t mipCount;
+        uint32_t reserved;
+        uint64_t dataSize;
+    };
+
+    struct SCookedTextureMip {
+        uint64_t offset;
+        uint32_t rowPitch;
+        uint32_t reserved;
+    };
+
+    const uint32_t kCookedTextureMagic = 0x58455446;   // "FTEX"
+}
+
+void SerializeCookedTexture(const SDecodedTexture& texture, std::vector<uint8_t>& out) {
+    SCookedTextureHeader header = {};
+    header.magic = kCookedTextureMagic;
+    header.width = texture.width;
+    header.height = texture.height;
+    header.format = static_cast<uint32_t>(texture.format);
+    header.mipCount = static_cast<uint32_t>(texture.mips.size());
+    header.dataSize = texture.data.size();
+
+    const size_t tableBytes = texture.mips.size() * sizeof(SCookedTextureMip);
+    out.resize(sizeof(header) + tableBytes + texture.data.size());
+    memcpy(out.data(), &header, sizeof(header));
+    for (size_t i = 0; i < texture.mips.size(); i++) {
+        SCookedTextureMip mip = {texture.mips[i].offset, texture.mips[i].rowPitch, 0};
+        memcpy(out.data() + sizeof(header) + i * sizeof(mip), &mip, sizeof(mip));
+    }
+    if (!texture.data.empty()) {
+        memcpy(out.data() + sizeof(header) + tableBytes, texture.data.data(), texture.data.size());
+    }
+}
+
+bool DeserializeCookedTexture(const uint8_t* data, size_t size, SDecodedTexture& out) {
+    SCookedTextureHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    const uint64_t tableBytes = (uint64_t)header.mipCount * sizeof(SCookedTextureMip);
+    if (header.magic != kCookedTextureMagic || header.mipCount == 0 || header.mipCount > 32 ||
+        sizeof(header) + tableBytes + header.dataSize != size) {
+        return false;
+    }
+
+    out = SDecodedTexture();
+    out.width = header.width;
+    out.height = header.height;
+    out.format = static_cast<RHI::ETextureFormat>(header.format);
+    out.generateMips = false;
+    out.mips.resize(header.mipCount);
+    for (uint32_t i = 0; i < header.mipCount; i++) {
+        SCookedTextureMip mip;
+        memcpy(&mip, data + sizeof(header) + i * sizeof(mip), sizeof(mip));
+        if (mip.offset >= header.dataSize) {
+            out = SDecodedTexture();
+            return false;
+        }
+        out.mips[i].offset = static_cast<size_t>(mip.offset);
+        out.mips[i].rowPitch = mip.rowPitch;
+    }
+    const uint8_t* pixels = data + sizeof(header) + tableBytes;
+    out.data.assign(pixels, pixels + header.dataSize);
+    return true;
+}
+
+void EncodeBlocks(ETextureCookFormat format, const uint8_t* rgba, uint32_t width, uint32_t height,
+                  uint32_t rowPitch, uint8_t* outBlocks, bool parallel) {
+    const uint32_t blockBytes = GetCookBlockBytes(format);
+    if (blockBytes == 0 || width == 0 || height == 0) {
+        return;
+    }
+    const uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    forRows(blocksY, blocksX, 256, parallel, [&](uint32_t begin, uint32_t end) {
+        SBlock block;
+        for (uint32_t by = begin; by < end; by++) {
+            uint8_t* out = outBlocks + (size_t)by * blocksX * blockBytes;
+            for (uint32_t bx = 0; bx < blocksX; bx++, out += blockBytes) {
+                loadBlock(rgba, width, height, rowPitch, bx, by, block);
+                encodeBlock(format, block, out);
+            }
+        }
+    });
+}
+
+void DecodeBlocks(ETextureCookFormat format, const uint8_t* blocks, uint32_t width, uint32_t height,
+                  uint8_t* outRgba) {
+    const uint32_t blockBytes = GetCookBlockBytes(format);
+    if (blockBytes == 0) {
+        return;
+    }
+    const uint32_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    uint8_t px[16][4];
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++) {
+            decodeBlock(format, blocks + ((size_t)by * blocksX + bx) * blockBytes, px);
+            for (uint32_t y = 0; y < 4 && by * 4 + y < height; y++) {
+                for (uint32_t x = 0; x < 4 && bx * 4 + x < width; x++) {
+                    memcpy(outRgba + ((size_t)(by * 4 + y) * width + bx * 4 + x) * 4, px[y * 4 + x], 4);
+                }
+            }
+        }
+    }
+}
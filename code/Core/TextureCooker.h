@@ -0,0 +1,98 @@
+#pragma once
+#include "Loader/TextureLoader.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================
+// Texture cooking (import time, CPU only)
+// ============================================
+// Turns a decoded RGBA8 image into an upload-ready texture:
+//
+//   1. Mip chain   2x2 box filter down to 1x1 (odd sizes clamp at the edge).
+//                  sRGB images are filtered in linear space, alpha is always
+//                  linear, normal maps are averaged as vectors and renormalized
+//   2. Encoding    BC1 / BC3 / BC5 / BC7 blocks, one 4x4 block at a time:
+//                    BC1  RGB along the principal axis, one least-squares refit
+//                    BC3  BC1 color + 8-step alpha (BC4)
+//                    BC5  two BC4 channels, tangent-space normal XY
+//                    BC7  mode 6 only (RGBA 7.7.7.7 + p-bit, 16 steps), principal
+//                         axis + least-squares refit, best p-bit pair
+//
+// Mips and blocks are split over the job system (rows of blocks per job), so
+// the result is identical whatever the thread count.
+//
+// BC formats need a top level whose size is a multiple of 4 (D3D12); other
+// images are cooked to RGBA8 with the same CPU mip chain.
+
+// Bump when the cooked output changes (part of the cache key)
+static const uint32_t kTextureCookVersion = 1;
+
+enum class ETextureCookFormat {
+    Auto,       // Color: BC1 when opaque, else BC3. Detected normal maps: BC5
+    RGBA8,      // Mips only
+    BC1,
+    BC3,
+    BC5,        // R, G only: shaders rebuild Z
+    BC7
+};
+
+const char* GetCookFormatName(ETextureCookFormat format);
+
+// 8 bytes (BC1) or 16 bytes per 4x4 block, 0 for RGBA8 / Auto
+uint32_t GetCookBlockBytes(ETextureCookFormat format);
+
+// RHI format of a cooked texture, e.g. BC7 + srgb = BC7_UNORM_SRGB (BC5 has no sRGB variant)
+RHI::ETextureFormat GetCookRHIFormat(ETextureCookFormat format, bool srgb);
+
+struct STextureCookOptions {
+    ETextureCookFormat colorFormat = ETextureCookFormat::BC7;
+    bool detectNormalMaps = true;   // Linear images that decode to unit +Z vectors use BC5
+    bool generateMips = true;       // false: top level only
+    bool parallel = true;           // Split over the job system (if initialized)
+};
+
+struct STextureCookReport {
+    ETextureCookFormat format = ETextureCookFormat::RGBA8;
+    bool normalMap = false;
+    uint32_t mipCount = 0;
+    uint64_t sourceBytes = 0;       // RGBA8, all mips
+    uint64_t cookedBytes = 0;
+    double mipMs = 0.0;
+    double encodeMs = 0.0;
+};
+
+// Tangent-space normal map test on a sample of the pixels: XYZ = RGB * 2 - 1
+// must be close to unit length with Z >= 0 almost everywhere
+bool IsNormalMapRGBA8(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t rowPitch);
+
+// Format the cooker picks for an image (never Auto)
+ETextureCookFormat SelectCookFormat(const SDecodedTexture& source, bool srgb,
+                                    const STextureCookOptions& options, bool* outNormalMap = nullptr);
+
+// source: RGBA8 / RGBA8_SRGB, top level only. out gets every mip, generateMips = false.
+bool CookTexture(const SDecodedTexture& source, const STextureCookOptions& options,
+                 SDecodedTexture& out, STextureCookReport* outReport = nullptr);
+
+// Cooked texture as a derived-data payload: a small header, the mip table,
+// then the mip data as stored in SDecodedTexture. Deserialize rejects
+// anything whose sizes do not add up.
+void SerializeCookedTexture(const SDecodedTexture& texture, std::vector<uint8_t>& out);
+bool DeserializeCookedTexture(const uint8_t* data, size_t size, SDecodedTexture& out);
+
+// ============================================
+// Block codecs
+// ============================================
+// Whole images; width / height need not be multiples of 4 (edge pixels are
+// repeated into partial blocks). Output rows are tightly packed blocks.
+// format: BC1 (alpha ignored) / BC3 / BC5 / BC7. Errors are measured on the
+// stored values, so sRGB data is fitted in sRGB space like other encoders do.
+void EncodeBlocks(ETextureCookFormat format, const uint8_t* rgba, uint32_t width, uint32_t height,
+                  uint32_t rowPitch, uint8_t* outBlocks, bool parallel = true);
+
+// Back to RGBA8 (tightly packed), for validation and CPU-side readers.
+// BC5 writes Z = 0, A = 255; BC7 decodes mode 6 only (what EncodeBlocks writes),
+// other modes decode to opaque magenta.
+void DecodeBlocks(ETextureCookFormat format, const uint8_t* blocks, uint32_t width, uint32_t height,
+                  uint8_t* outRgba);
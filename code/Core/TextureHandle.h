@@ -3,6 +3,7 @@
 #include "RHI/RHIResources.h"
 #include "RHI/RHIPointers.h"
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -93,6 +94,8 @@ private:
 
     RHI::TextureSharedPtr m_placeholder;
     RHI::TextureSharedPtr m_realTexture;
+    uint64_t m_streamRequest = 0;       // CTextureStreamer request while loading
+    uint32_t m_lastRequestFrame = 0;    // TextureManager frame of the last LoadAsync (streaming priority)
     std::string m_path;
     bool m_srgb;
     EState m_state;
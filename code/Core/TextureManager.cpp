@@ -9,6 +9,7 @@
 #include <codecvt>
 #include <locale>
 #include <algorithm>
+#include <chrono>
 
 CTextureManager& CTextureManager::Instance() {
     static CTextureManager instance;
@@ -58,7 +59,7 @@ RHI::TextureSharedPtr CTextureManager::Load(const std::string& path, bool srgb)
     return m_textures[cacheKey].texture;
 }
 
-TextureHandlePtr CTextureManager::LoadAsync(const std::string& path, bool srgb) {
+TextureHandlePtr CTextureManager::LoadAsync(const std::string& path, bool srgb, float priority) {
     if (path.empty()) {
         // Return a handle that's immediately ready with default texture
         auto handle = std::make_shared<CTextureHandle>(
@@ -72,6 +73,14 @@ TextureHandlePtr CTextureManager::LoadAsync(const std::string& path, bool srgb)
     // Check handle cache first (already loaded or pending)
     auto handleIt = m_handles.find(cacheKey);
     if (handleIt != m_handles.end()) {
+        CTextureHandle& handle = *handleIt->second;
+        handle.m_lastRequestFrame = m_frameIndex;
+        if (handle.IsLoading()) {
+            auto pendingIt = m_pendingLoads.find(handle.m_streamRequest);
+            if (pendingIt != m_pendingLoads.end() && priority > pendingIt->second.priority) {
+                pendingIt->second.priority = priority;  // Sent to the streamer on the next Tick
+            }
+        }
         return handleIt->second;
     }
 
@@ -85,18 +94,29 @@ TextureHandlePtr CTextureManager::LoadAsync(const std::string& path, bool srgb)
         return handle;
     }
 
+    if (!m_streamer) {
+        m_streamer = std::make_unique<CTextureStreamer>(
+            [this](const std::string& fullPath, bool srgb, SDecodedTexture& out) {
+                return DecodeTextureFile(fullPath, srgb, out);
+            });
+        CFFLog::Info("TextureManager: started %u texture decode threads", m_streamer->GetWorkerCount());
+    }
+
     // Create new handle with placeholder
     auto handle = std::make_shared<CTextureHandle>(m_placeholder, path, srgb);
+    handle->m_lastRequestFrame = m_frameIndex;
     m_handles[cacheKey] = handle;
 
-    // Queue load request
+    // Queue load request (decoded on a streamer thread)
     LoadRequest request;
     request.path = path;
-    request.fullPath = ResolveFullPath(path);
     request.cacheKey = cacheKey;
     request.srgb = srgb;
+    request.priority = priority;
+    request.streamPriority = priority;
     request.handle = handle;
-    m_pendingLoads.push(std::move(request));
+    handle->m_streamRequest = m_streamer->Request(ResolveFullPath(path), srgb, priority);
+    m_pendingLoads[handle->m_streamRequest] = std::move(request);
 
     CFFLog::Info(("Queued async load: " + path + " (pending: " +
                   std::to_string(m_pendingLoads.size()) + ")").c_str());
@@ -105,20 +125,17 @@ TextureHandlePtr CTextureManager::LoadAsync(const std::string& path, bool srgb)
 }
 
 uint32_t CTextureManager::Tick(uint32_t maxLoadsPerFrame) {
+    m_frameIndex++;
     if (m_pendingLoads.empty()) {
         return 0;
     }
 
-    uint32_t loadCount = 0;
-    uint32_t limit = (maxLoadsPerFrame == 0) ? UINT32_MAX : maxLoadsPerFrame;
+    UpdatePendingPriorities();
 
-    while (!m_pendingLoads.empty() && loadCount < limit) {
-        LoadRequest request = std::move(m_pendingLoads.front());
-        m_pendingLoads.pop();
-
-        ProcessLoadRequest(request);
-        loadCount++;
-    }
+    CTextureStreamer::SUploadBudget budget = m_uploadBudget;
+    budget.maxUploads = maxLoadsPerFrame;
+    uint32_t loadCount = m_streamer->PumpUploads(budget,
+        [this](CTextureStreamer::RequestId id, SDecodedTexture* decoded) { CompleteLoadRequest(id, decoded); });
 
     if (loadCount > 0) {
         CFFLog::Info(("TextureManager::Tick processed " + std::to_string(loadCount) +
@@ -128,19 +145,55 @@ uint32_t CTextureManager::Tick(uint32_t maxLoadsPerFrame) {
     return loadCount;
 }
 
+void CTextureManager::UpdatePendingPriorities() {
+    for (auto it = m_pendingLoads.begin(); it != m_pendingLoads.end();) {
+        LoadRequest& request = it->second;
+        uint32_t framesSinceRequest = m_frameIndex - request.handle->m_lastRequestFrame;
+
+        // Nobody asked for it in a while and only the manager holds the handle
+        // (m_handles + this request): drop it, a later LoadAsync re-queues it
+        if (framesSinceRequest > STALE_FRAMES && request.handle.use_count() <= 2) {
+            m_streamer->Cancel(it->first);
+            m_handles.erase(request.cacheKey);
+            CFFLog::Info(("Cancelled stale async load: " + request.path).c_str());
+            it = m_pendingLoads.erase(it);
+            continue;
+        }
+
+        // Requested during the last frame = drawn this frame
+        float priority = request.priority + (framesSinceRequest <= 1 ? VISIBLE_PRIORITY_BOOST : 0.0f);
+        if (priority != request.streamPriority) {
+            m_streamer->SetPriority(it->first, priority);
+            request.streamPriority = priority;
+        }
+        ++it;
+    }
+}
+
 void CTextureManager::FlushPendingLoads() {
-    uint32_t count = Tick(0);  // 0 = unlimited
+    if (m_pendingLoads.empty()) {
+        return;
+    }
+    uint32_t count = m_streamer->Flush(
+        [this](CTextureStreamer::RequestId id, SDecodedTexture* decoded) { CompleteLoadRequest(id, decoded); });
     if (count > 0) {
         CFFLog::Info(("TextureManager::FlushPendingLoads: loaded " +
                       std::to_string(count) + " textures").c_str());
     }
 }
 
-void CTextureManager::ProcessLoadRequest(LoadRequest& request) {
-    request.handle->SetState(CTextureHandle::EState::Loading);
+void CTextureManager::CompleteLoadRequest(CTextureStreamer::RequestId id, SDecodedTexture* decoded) {
+    auto it = m_pendingLoads.find(id);
+    if (it == m_pendingLoads.end()) {
+        return;     // Cleared while decoding
+    }
+    LoadRequest request = std::move(it->second);
+    m_pendingLoads.erase(it);
+    request.handle->m_streamRequest = 0;
+    request.handle->SetState(CTextureHandle::EState::Uploading);
 
-    // Load from disk + GPU upload + mip generation
-    RHI::ITexture* texture = LoadTextureFromFile(request.fullPath, request.srgb);
+    // GPU upload + mip generation (disk I/O and decode already done)
+    RHI::ITexture* texture = decoded ? CreateTextureFromDecoded(*decoded, request.path.c_str()) : nullptr;
 
     if (!texture) {
         CFFLog::Warning(("Failed to load texture (async): " + request.path).c_str());
@@ -168,6 +221,29 @@ void CTextureManager::ProcessLoadRequest(LoadRequest& request) {
                   (request.srgb ? " (sRGB)" : " (Linear)")).c_str());
 }
 
+void CTextureManager::CancelPendingLoads() {
+    if (m_streamer) {
+        for (const auto& [id, request] : m_pendingLoads) {
+            m_streamer->Cancel(id);
+        }
+    }
+    m_pendingLoads.clear();
+}
+
+CTextureStreamer::SStats CTextureManager::GetStreamingStats() const {
+    return m_streamer ? m_streamer->GetStats() : CTextureStreamer::SStats();
+}
+
+CTextureManager::SCookStats CTextureManager::GetCookStats() const {
+    std::lock_guard<std::mutex> lock(m_cookStatsMutex);
+    return m_cookStats;
+}
+
+void CTextureManager::ResetCookStats() {
+    std::lock_guard<std::mutex> lock(m_cookStatsMutex);
+    m_cookStats = SCookStats();
+}
+
 RHI::TextureSharedPtr CTextureManager::GetDefaultWhite() {
     return m_defaultWhite;
 }
@@ -196,10 +272,8 @@ bool CTextureManager::IsLoaded(const std::string& path) const {
 }
 
 void CTextureManager::Clear() {
-    // Clear pending loads queue
-    while (!m_pendingLoads.empty()) {
-        m_pendingLoads.pop();
-    }
+    // Drop pending loads (results still decoding are discarded)
+    CancelPendingLoads();
 
     m_textures.clear();
     m_handles.clear();
@@ -207,10 +281,9 @@ void CTextureManager::Clear() {
 }
 
 void CTextureManager::Shutdown() {
-    // Clear pending loads queue
-    while (!m_pendingLoads.empty()) {
-        m_pendingLoads.pop();
-    }
+    // Drop pending loads and join the decode threads
+    CancelPendingLoads();
+    m_streamer.reset();
 
     m_textures.clear();
     m_handles.clear();
@@ -314,6 +387,14 @@ std::string CTextureManager::ResolveFullPath(const std::string& relativePath) co
 }
 
 RHI::ITexture* CTextureManager::LoadTextureFromFile(const std::string& fullPath, bool srgb) {
+    SDecodedTexture decoded;
+    if (!DecodeTextureFile(fullPath, srgb, decoded)) {
+        return nullptr;
+    }
+    return CreateTextureFromDecoded(decoded, fullPath.c_str());
+}
+
+bool CTextureManager::DecodeTextureFile(const std::string& fullPath, bool srgb, SDecodedTexture& out) {
     // Get file extension (case-insensitive)
     std::string ext;
     size_t dotPos = fullPath.rfind('.');
@@ -325,11 +406,100 @@ RHI::ITexture* CTextureManager::LoadTextureFromFile(const std::string& fullPath,
     // Route to appropriate loader based on extension
     if (ext == ".ktx2" || ext == ".ktx") {
         // KTX2 loader (ignores srgb flag - format is embedded in file)
-        return CKTXLoader::Load2DTextureFromKTX2(fullPath);
+        return CKTXLoader::Decode2DTextureFromKTX2(fullPath, out);
     }
 
     // Default: WIC loader for PNG/JPG/BMP/TGA/etc.
+    if (m_cookEnabled) {
+        return DecodeAndCook(fullPath, srgb, out);
+    }
     std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
     std::wstring wpath = converter.from_bytes(fullPath);
-    return LoadTextureWIC(wpath, srgb);
+    if (!DecodeTextureWIC(wpath, srgb, out)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_cookStatsMutex);
+    m_cookStats.uncooked++;
+    return true;
+}
+
+bool CTextureManager::MakeCookKey(const std::string& fullPath, bool srgb, const STextureCookOptions& options,
+                                  SDerivedDataKey& outKey) {
+    CDerivedDataKeyBuilder builder("texture", kTextureCookVersion);
+    if (!builder.AddFile(fullPath)) {
+        return false;
+    }
+    builder.Add(srgb).Add((uint32_t)options.colorFormat).Add(options.detectNormalMaps).Add(options.generateMips);
+    outKey = builder.Build();
+    return true;
+}
+
+// RGBA8 size of a texture with the same mip chain
+static uint64_t GetRGBA8ChainBytes(uint32_t width, uint32_t height, size_t mipCount) {
+    uint64_t bytes = 0;
+    for (size_t mip = 0; mip < mipCount; mip++) {
+        bytes += (uint64_t)std::max(1u, width >> mip) * std::max(1u, height >> mip) * 4;
+    }
+    return bytes;
+}
+
+bool CTextureManager::DecodeAndCook(const std::string& fullPath, bool srgb, SDecodedTexture& out) {
+    const STextureCookOptions options = m_cookOptions;
+    auto start = std::chrono::high_resolution_clock::now();
+    auto elapsedMs = [&start]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    };
+
+    // Cooked cache hit: straight copy of the compressed mips
+    CDerivedDataCache& ddc = CDerivedDataCache::Instance();
+    SDerivedDataKey key;
+    bool cacheable = m_diskCacheEnabled && MakeCookKey(fullPath, srgb, options, key);
+    CMappedFile mapped;
+    size_t offset = 0;
+    if (cacheable && ddc.Map(key, mapped, offset)) {
+        bool valid = DeserializeCookedTexture(mapped.Data() + offset, mapped.Size() - offset, out);
+        mapped.Close();
+        if (valid) {
+            std::lock_guard<std::mutex> lock(m_cookStatsMutex);
+            m_cookStats.cachedLoads++;
+            m_cookStats.cachedLoadMs += elapsedMs();
+            m_cookStats.rgbaBytes += GetRGBA8ChainBytes(out.width, out.height, out.mips.size());
+            m_cookStats.cookedBytes += out.GetSizeBytes();
+            return true;
+        }
+        ddc.Remove(key);
+    }
+
+    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+    SDecodedTexture source;
+    if (!DecodeTextureWIC(converter.from_bytes(fullPath), srgb, source)) {
+        return false;
+    }
+
+    STextureCookReport report;
+    if (!CookTexture(source, options, out, &report)) {
+        // Not an RGBA8 image: upload as decoded, mips on the GPU
+        out = std::move(source);
+        std::lock_guard<std::mutex> lock(m_cookStatsMutex);
+        m_cookStats.uncooked++;
+        return true;
+    }
+    double ms = elapsedMs();
+    if (cacheable) {
+        std::vector<uint8_t> payload;
+        SerializeCookedTexture(out, payload);
+        ddc.Put(key, payload, ms);
+    }
+
+    CFFLog::Info("[TextureManager] Cooked %s: %ux%u %s%s, %u mips, %.1f -> %.1f KB (mips %.2f ms, encode %.2f ms, total %.2f ms)",
+                 fullPath.c_str(), out.width, out.height, GetCookFormatName(report.format),
+                 report.normalMap ? " (normal map)" : "", report.mipCount, report.sourceBytes / 1024.0,
+                 report.cookedBytes / 1024.0, report.mipMs, report.encodeMs, ms);
+
+    std::lock_guard<std::mutex> lock(m_cookStatsMutex);
+    m_cookStats.cooks++;
+    m_cookStats.cookMs += ms;
+    m_cookStats.rgbaBytes += report.sourceBytes;
+    m_cookStats.cookedBytes += report.cookedBytes;
+    return true;
 }
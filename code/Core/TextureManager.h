@@ -3,10 +3,13 @@
 #include "RHI/RHIResources.h"
 #include "RHI/RHIPointers.h"
 #include "TextureHandle.h"
+#include "TextureStreamer.h"
+#include "TextureCooker.h"
+#include "DerivedDataCache.h"
 #include <string>
 #include <unordered_map>
-#include <queue>
 #include <memory>
+#include <mutex>
 
 /**
  * Texture Manager - Singleton for managing texture resources
@@ -25,8 +28,22 @@
  *
  * Async Loading:
  * - LoadAsync() returns TextureHandlePtr immediately with placeholder
- * - Call Tick() at frame start to process pending loads
+ * - Disk I/O and decoding run on CTextureStreamer worker threads
+ * - Call Tick() at frame start: uploads decoded textures under the upload budget
  * - TextureHandle automatically returns real texture when ready
+ *
+ * Prioritization / cancellation:
+ * - Pending textures requested again this frame (LoadAsync from a draw) get
+ *   VISIBLE_PRIORITY_BOOST, otherwise request order decides
+ * - A pending texture nobody has requested for STALE_FRAMES frames and whose
+ *   handle is held only by the manager is cancelled (requested again = re-queued)
+ *
+ * Cooking:
+ * - Image files (PNG/JPG/...) are cooked on their first load: CPU mip chain and
+ *   BC compression (TextureCooker.h), stored in the derived-data cache
+ *   ("texture" entries, see DerivedDataCache.h)
+ * - Later loads read the cooked mips and upload them as is (no GPU mip generation)
+ * - Entries are keyed by the image bytes, color space and cook options
  */
 class CTextureManager {
 public:
@@ -48,6 +65,7 @@ public:
      * Load a texture asynchronously (NON-BLOCKING - preferred API)
      * @param path Relative path from assets directory
      * @param srgb True for sRGB color space
+     * @param priority Higher loads first (ties: request order)
      * @return TextureHandlePtr that returns placeholder until texture is ready
      *
      * The returned handle will:
@@ -55,20 +73,26 @@ public:
      * - Return the real texture once loading completes
      * - Handle load failures gracefully (returns fallback texture)
      */
-    TextureHandlePtr LoadAsync(const std::string& path, bool srgb);
+    TextureHandlePtr LoadAsync(const std::string& path, bool srgb, float priority = 0.0f);
 
     /**
-     * Process pending texture loads (call at frame start)
-     * @param maxLoadsPerFrame Maximum number of textures to load this frame (0 = unlimited)
-     * @return Number of textures actually loaded this frame
+     * Upload decoded textures (call at frame start)
+     * @param maxLoadsPerFrame Maximum number of uploads this frame (0 = upload budget only)
+     * @return Number of textures completed this frame
      *
-     * Each load includes: Disk I/O + GPU Upload + Mip Generation
-     * Typical cost: 5-15ms per texture depending on size
+     * Only GPU upload + mip generation run here, limited by the upload budget.
+     * Also updates priorities and cancels stale requests.
      */
-    uint32_t Tick(uint32_t maxLoadsPerFrame = 2);
+    uint32_t Tick(uint32_t maxLoadsPerFrame = 0);
 
     /**
-     * Get number of textures waiting to be loaded
+     * Per-frame upload limits (bytes / milliseconds, 0 = unlimited)
+     */
+    void SetUploadBudget(const CTextureStreamer::SUploadBudget& budget) { m_uploadBudget = budget; }
+    const CTextureStreamer::SUploadBudget& GetUploadBudget() const { return m_uploadBudget; }
+
+    /**
+     * Get number of textures waiting to be loaded (queued, decoding or waiting for upload)
      */
     uint32_t GetPendingCount() const { return static_cast<uint32_t>(m_pendingLoads.size()); }
 
@@ -77,6 +101,48 @@ public:
      */
     bool HasPendingLoads() const { return !m_pendingLoads.empty(); }
 
+    /**
+     * Streaming statistics (decode / upload times, cancellations)
+     */
+    CTextureStreamer::SStats GetStreamingStats() const;
+
+    /**
+     * Texture cooking (on by default; off = RGBA8 upload + GPU mips, as before)
+     * Read on the decode threads: change before loading textures, then Clear()
+     */
+    void SetCookEnabled(bool enabled) { m_cookEnabled = enabled; }
+    bool IsCookEnabled() const { return m_cookEnabled; }
+
+    /**
+     * Cooked texture cache (off = cook on every load, nothing written)
+     */
+    void SetDiskCacheEnabled(bool enabled) { m_diskCacheEnabled = enabled; }
+    bool IsDiskCacheEnabled() const { return m_diskCacheEnabled; }
+
+    /**
+     * Encoder settings; part of the cooked key, so a change re-cooks on the next load
+     */
+    void SetCookOptions(const STextureCookOptions& options) { m_cookOptions = options; }
+    const STextureCookOptions& GetCookOptions() const { return m_cookOptions; }
+
+    /**
+     * DDC key of a cooked image; false if the file cannot be read
+     */
+    static bool MakeCookKey(const std::string& fullPath, bool srgb, const STextureCookOptions& options,
+                            SDerivedDataKey& outKey);
+
+    struct SCookStats {
+        uint32_t cachedLoads = 0;       // Read from the derived-data cache
+        uint32_t cooks = 0;             // Cooked from the source image (and saved)
+        uint32_t uncooked = 0;          // Cooking off or not possible: RGBA8 + GPU mips
+        double cachedLoadMs = 0.0;      // Summed over decode threads
+        double cookMs = 0.0;            // Image decode + mips + encode
+        uint64_t rgbaBytes = 0;         // Cooked textures as RGBA8 with a full mip chain
+        uint64_t cookedBytes = 0;       // Same textures as uploaded
+    };
+    SCookStats GetCookStats() const;
+    void ResetCookStats();
+
     /**
      * Force load all pending textures (blocking)
      * Useful for loading screens or initialization
@@ -124,6 +190,9 @@ public:
      */
     void Shutdown();
 
+    static constexpr float VISIBLE_PRIORITY_BOOST = 1000.0f;
+    static constexpr uint32_t STALE_FRAMES = 120;
+
 private:
     CTextureManager();
     ~CTextureManager() = default;
@@ -134,12 +203,13 @@ private:
         bool isSRGB;
     };
 
-    // Async load request
+    // Async load request (in flight in m_streamer)
     struct LoadRequest {
         std::string path;
-        std::string fullPath;
         std::string cacheKey;
         bool srgb;
+        float priority;             // Requested priority
+        float streamPriority;       // Last priority sent to the streamer
         TextureHandlePtr handle;
     };
 
@@ -149,8 +219,20 @@ private:
     // Cache for async-loaded texture handles
     std::unordered_map<std::string, TextureHandlePtr> m_handles;
 
-    // Queue of pending async loads
-    std::queue<LoadRequest> m_pendingLoads;
+    // Pending async loads by streamer request id
+    std::unordered_map<CTextureStreamer::RequestId, LoadRequest> m_pendingLoads;
+
+    // Background decode workers (created on first LoadAsync)
+    std::unique_ptr<CTextureStreamer> m_streamer;
+    CTextureStreamer::SUploadBudget m_uploadBudget;
+    uint32_t m_frameIndex = 1;
+
+    // Cooking (settings read by the decode threads)
+    bool m_cookEnabled = true;
+    bool m_diskCacheEnabled = true;
+    STextureCookOptions m_cookOptions;
+    mutable std::mutex m_cookStatsMutex;
+    SCookStats m_cookStats;
 
     // Default textures
     RHI::TextureSharedPtr m_defaultWhite;
@@ -164,7 +246,12 @@ private:
     std::string ResolveFullPath(const std::string& relativePath) const;
     std::string MakeCacheKey(const std::string& path, bool srgb) const;
     RHI::ITexture* LoadTextureFromFile(const std::string& fullPath, bool srgb);
+    // Runs on streamer threads
+    bool DecodeTextureFile(const std::string& fullPath, bool srgb, SDecodedTexture& out);
+    bool DecodeAndCook(const std::string& fullPath, bool srgb, SDecodedTexture& out);
 
-    // Process a single load request
-    void ProcessLoadRequest(LoadRequest& request);
+    // Finish a single load request with the decoded data (nullptr = failed)
+    void CompleteLoadRequest(CTextureStreamer::RequestId id, SDecodedTexture* decoded);
+    void UpdatePendingPriorities();
+    void CancelPendingLoads();
 };
@@ -0,0 +1,253 @@
+#include "TextureStreamer.h"
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    double elapsedMs(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+CTextureStreamer::CTextureStreamer(DecodeFunc decode, uint32_t workerCount)
+    : m_decode(std::move(decode))
+{
+    if (workerCount == 0) {
+        workerCount = std::clamp(std::thread::hardware_concurrency() / 4, 1u, 4u);
+    }
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; i++) {
+        m_workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+CTextureStreamer::~CTextureStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+    }
+    m_workAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+// ============================================
+// Requests
+// ============================================
+
+CTextureStreamer::RequestId CTextureStreamer::Request(const std::string& path, bool srgb, float priority)
+{
+    RequestId id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        id = m_nextId++;
+        SRequest& request = m_requests[id];
+        request.path = path;
+        request.srgb = srgb;
+        request.priority = priority;
+        m_queue.insert({priority, id});
+        m_stats.requested++;
+    }
+    m_workAvailable.notify_one();
+    return id;
+}
+
+bool CTextureStreamer::SetPriority(RequestId id, float priority)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_requests.find(id);
+    if (it == m_requests.end() || it->second.cancelled) {
+        return false;
+    }
+    SRequest& request = it->second;
+    if (request.state == EState::Queued && request.priority != priority) {
+        m_queue.erase({request.priority, id});
+        m_queue.insert({priority, id});
+    }
+    request.priority = priority;    // Decoded requests: upload order
+    return true;
+}
+
+bool CTextureStreamer::Cancel(RequestId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_requests.find(id);
+    if (it == m_requests.end() || it->second.cancelled) {
+        return false;
+    }
+
+    SRequest& request = it->second;
+    switch (request.state) {
+    case EState::Queued:
+        m_queue.erase({request.priority, id});
+        m_requests.erase(it);
+        break;
+    case EState::Decoding:
+        request.cancelled = true;   // Worker drops the result
+        break;
+    case EState::Decoded:
+        m_ready.erase(std::remove(m_ready.begin(), m_ready.end(), id), m_ready.end());
+        m_requests.erase(it);
+        break;
+    }
+    m_stats.cancelled++;
+    return true;
+}
+
+// ============================================
+// Worker threads
+// ============================================
+
+void CTextureStreamer::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_workAvailable.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+        if (m_stop) {
+            return;
+        }
+
+        RequestId id = m_queue.begin()->second;
+        m_queue.erase(m_queue.begin());
+        SRequest& request = m_requests[id];
+        request.state = EState::Decoding;
+        std::string path = request.path;
+        bool srgb = request.srgb;
+        m_decoding++;
+
+        // Decode without the lock (m_requests may rehash, only touch locals)
+        lock.unlock();
+        auto start = std::chrono::high_resolution_clock::now();
+        SDecodedTexture decoded;
+        bool succeeded = m_decode(path, srgb, decoded);
+        double decodeMs = elapsedMs(start);
+        lock.lock();
+
+        m_decoding--;
+        m_stats.decodeMs += decodeMs;
+        auto it = m_requests.find(id);
+        if (it->second.cancelled) {
+            m_requests.erase(it);
+        } else {
+            it->second.state = EState::Decoded;
+            it->second.succeeded = succeeded;
+            it->second.decoded = std::move(decoded);
+            m_ready.push_back(id);
+            if (succeeded) {
+                m_stats.decoded++;
+            } else {
+                m_stats.failed++;
+            }
+        }
+        m_decodeFinished.notify_all();
+    }
+}
+
+// ============================================
+// Upload (render thread)
+// ============================================
+
+uint32_t CTextureStreamer::PumpUploads(const SUploadBudget& budget, const UploadFunc& upload)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    uint32_t count = 0;
+    uint64_t bytes = 0;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_ready.empty()) {
+        m_stats.lastPumpMs = 0.0f;
+        return 0;
+    }
+
+    // Best first; pop from the back
+    std::sort(m_ready.begin(), m_ready.end(), [this](RequestId a, RequestId b) {
+        const SRequest& ra = m_requests[a];
+        const SRequest& rb = m_requests[b];
+        return SQueueOrder()({rb.priority, b}, {ra.priority, a});
+    });
+
+    while (!m_ready.empty()) {
+        if (budget.maxUploads != 0 && count >= budget.maxUploads) {
+            break;
+        }
+        RequestId id = m_ready.back();
+        auto it = m_requests.find(id);
+        uint64_t size = it->second.decoded.GetSizeBytes();
+        if (count > 0) {
+            if (budget.maxBytes != 0 && bytes + size > budget.maxBytes) break;
+            if (budget.maxMilliseconds > 0.0f && elapsedMs(start) >= budget.maxMilliseconds) break;
+        }
+
+        m_ready.pop_back();
+        SRequest request = std::move(it->second);
+        m_requests.erase(it);
+        lock.unlock();
+
+        upload(id, request.succeeded ? &request.decoded : nullptr);
+        count++;
+        bytes += size;
+
+        lock.lock();
+        m_stats.uploaded++;
+        m_stats.uploadedBytes += size;
+    }
+
+    double pumpMs = elapsedMs(start);
+    m_stats.uploadMs += pumpMs;
+    m_stats.lastPumpMs = (float)pumpMs;
+    return count;
+}
+
+uint32_t CTextureStreamer::Flush(const UploadFunc& upload)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_decodeFinished.wait(lock, [this]() { return m_queue.empty() && m_decoding == 0; });
+    }
+    SUploadBudget unlimited;
+    unlimited.maxBytes = 0;
+    unlimited.maxMilliseconds = 0.0f;
+    return PumpUploads(unlimited, upload);
+}
+
+// ============================================
+// Queries
+// ============================================
+
+uint32_t CTextureStreamer::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t pending = 0;
+    for (const auto& [id, request] : m_requests) {
+        if (!request.cancelled) pending++;
+    }
+    return pending;
+}
+
+uint32_t CTextureStreamer::GetQueuedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (uint32_t)m_queue.size();
+}
+
+uint32_t CTextureStreamer::GetReadyCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (uint32_t)m_ready.size();
+}
+
+CTextureStreamer::SStats CTextureStreamer::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void CTextureStreamer::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats = SStats();
+}
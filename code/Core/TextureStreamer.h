@@ -0,0 +1,129 @@
+#pragma once
+#include "Loader/TextureLoader.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// ============================================
+// CTextureStreamer - background decode, budgeted upload
+// ============================================
+// Requests are decoded (file read + image decode) on a small pool of
+// dedicated threads. Decoded results wait until the owner pumps them on the
+// render thread, where the upload runs under a per-frame byte/time budget.
+//
+// Ordering: higher priority first, then request order. Priorities may change
+// while a request waits (e.g. texture became visible). Cancel() drops a
+// request in any state; a result that is still being decoded is discarded
+// when the worker finishes.
+//
+// Dedicated threads instead of CJobSystem: decode jobs block on disk I/O for
+// milliseconds, and CJobSystem::Wait() on the main thread would pick them up.
+//
+// Usage:
+//   CTextureStreamer streamer(decodeFunc);
+//   auto id = streamer.Request(fullPath, srgb, priority);
+//   ...
+//   streamer.PumpUploads(budget, [](RequestId id, SDecodedTexture* decoded) { ... });  // once per frame
+class CTextureStreamer
+{
+public:
+    using RequestId = uint64_t;
+    static const RequestId INVALID_REQUEST = 0;
+
+    // Runs on a worker thread; returns false on failure
+    using DecodeFunc = std::function<bool(const std::string& path, bool srgb, SDecodedTexture& out)>;
+    // Runs on the pumping thread; decoded = nullptr if decoding failed
+    using UploadFunc = std::function<void(RequestId id, SDecodedTexture* decoded)>;
+
+    // Per-PumpUploads limits (0 = unlimited). At least one upload always runs
+    // when something is ready, so textures larger than the budget still arrive.
+    struct SUploadBudget {
+        uint64_t maxBytes = 64ull * 1024 * 1024;
+        float maxMilliseconds = 4.0f;
+        uint32_t maxUploads = 0;
+    };
+
+    struct SStats {
+        uint64_t requested = 0;
+        uint64_t decoded = 0;
+        uint64_t failed = 0;
+        uint64_t uploaded = 0;          // Includes failed results handed to the upload callback
+        uint64_t cancelled = 0;
+        uint64_t uploadedBytes = 0;
+        double decodeMs = 0.0;          // Worker time (sum over threads)
+        double uploadMs = 0.0;          // Pumping thread time
+        float lastPumpMs = 0.0f;
+    };
+
+    // workerCount = 0: a quarter of the hardware threads, 1..4
+    explicit CTextureStreamer(DecodeFunc decode, uint32_t workerCount = 0);
+    ~CTextureStreamer();    // Cancels what is queued and joins the workers
+
+    CTextureStreamer(const CTextureStreamer&) = delete;
+    CTextureStreamer& operator=(const CTextureStreamer&) = delete;
+
+    RequestId Request(const std::string& path, bool srgb, float priority = 0.0f);
+    // False if the request already finished or was cancelled
+    bool SetPriority(RequestId id, float priority);
+    bool Cancel(RequestId id);
+
+    // Hands decoded results to upload (highest priority first) until the budget is used up.
+    // Returns the number of results handed over.
+    uint32_t PumpUploads(const SUploadBudget& budget, const UploadFunc& upload);
+
+    // Blocks until every request is decoded, then uploads all of them
+    uint32_t Flush(const UploadFunc& upload);
+
+    // Requests not handed to PumpUploads yet (queued + decoding + decoded)
+    uint32_t GetPendingCount() const;
+    uint32_t GetQueuedCount() const;
+    uint32_t GetReadyCount() const;
+    uint32_t GetWorkerCount() const { return (uint32_t)m_workers.size(); }
+
+    SStats GetStats() const;
+    void ResetStats();
+
+private:
+    enum class EState { Queued, Decoding, Decoded };
+
+    struct SRequest {
+        std::string path;
+        bool srgb = false;
+        float priority = 0.0f;
+        EState state = EState::Queued;
+        bool cancelled = false;         // Set while decoding, result dropped by the worker
+        bool succeeded = false;
+        SDecodedTexture decoded;
+    };
+
+    // Highest priority first, then oldest request
+    struct SQueueOrder {
+        bool operator()(const std::pair<float, RequestId>& a, const std::pair<float, RequestId>& b) const {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        }
+    };
+
+    void workerLoop();
+
+    DecodeFunc m_decode;
+    std::vector<std::thread> m_workers;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_decodeFinished;
+    bool m_stop = false;
+
+    RequestId m_nextId = 1;
+    std::unordered_map<RequestId, SRequest> m_requests;
+    std::set<std::pair<float, RequestId>, SQueueOrder> m_queue;
+    std::vector<RequestId> m_ready;
+    uint32_t m_decoding = 0;
+
+    SStats m_stats;
+};
@@ -297,7 +297,7 @@ void Panels::DrawInspector(CScene& scene) {
                             // Bake the probe
                             CFFLog::Info("Baking Reflection Probe...");
                             bool success = baker.BakeProbe(
-                                tr->position,
+                                tr->GetWorldPosition(),
                                 rp->resolution,
                                 scene,
                                 rp->assetPath
@@ -354,11 +354,12 @@ void Panels::DrawInspector(CScene& scene) {
                             CFFLog::Error("Failed to initialize LightProbeBaker");
                         } else {
                             // Bake the probe
+                            DirectX::XMFLOAT3 probePosition = tr->GetWorldPosition();
                             CFFLog::Info("Baking Light Probe at (%.1f, %.1f, %.1f)...",
-                                        tr->position.x, tr->position.y, tr->position.z);
+                                        probePosition.x, probePosition.y, probePosition.z);
                             bool success = baker.BakeProbe(
                                 *lp,
-                                tr->position,
+                                probePosition,
                                 scene
                             );
 
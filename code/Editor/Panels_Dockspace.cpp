@@ -4,6 +4,7 @@
 #include "Engine/Rendering/RenderPipeline.h"
 #include "Engine/Rendering/IBLGenerator.h"
 #include "Core/FFLog.h"
+#include "Core/PathManager.h"
 #include <windows.h> // For file dialogs
 #include <commdlg.h>
 #include <string>
@@ -87,18 +88,26 @@ void Panels::DrawDockspace(bool* pOpen, CScene& scene, CRenderPipeline* pipeline
 
             // Save Scene As: Always show dialog
             if (ImGui::MenuItem("Save Scene As...")) {
-                std::string path = SaveFileDialog("Scene Files (*.scene)\0*.scene\0All Files (*.*)\0*.*\0");
+                std::string path = SaveFileDialog("Scene Files (*.scene;*.ffscene)\0*.scene;*.ffscene\0JSON Scene (*.scene)\0*.scene\0Binary Scene (*.ffscene)\0*.ffscene\0All Files (*.*)\0*.*\0");
                 if (!path.empty()) {
                     scene.SaveToFile(path);
                 }
             }
 
             if (ImGui::MenuItem("Load Scene", "Ctrl+O")) {
-                std::string path = OpenFileDialog("Scene Files (*.scene)\0*.scene\0All Files (*.*)\0*.*\0");
+                std::string path = OpenFileDialog("Scene Files (*.scene;*.ffscene)\0*.scene;*.ffscene\0JSON Scene (*.scene)\0*.scene\0Binary Scene (*.ffscene)\0*.ffscene\0All Files (*.*)\0*.*\0");
                 if (!path.empty()) {
                     scene.LoadFromFile(path);
                 }
             }
+
+            // Model import: glTF node hierarchy as GameObjects (see CScene::ImportModel)
+            if (ImGui::MenuItem("Import Model...")) {
+                std::string path = OpenFileDialog("Model Files (*.gltf;*.glb;*.obj)\0*.gltf;*.glb;*.obj\0All Files (*.*)\0*.*\0");
+                if (!path.empty()) {
+                    scene.ImportModel(FFPath::Normalize(path));
+                }
+            }
             ImGui::Separator();
             if (ImGui::MenuItem("Exit")) {
                 *pOpen = false;
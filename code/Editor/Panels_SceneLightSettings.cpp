@@ -203,6 +203,15 @@ static void DrawVolumetricLightmapSection(CSceneLightSettings& settings) {
             ImGui::Text("CPU Settings:");
             ImGui::SliderInt("Samples/Voxel##CPU", &s_bakeConfig.cpuSamplesPerVoxel, 64, 16384);
             ImGui::SliderInt("Max Bounces##CPU", &s_bakeConfig.cpuMaxBounces, 1, 8);
+            ImGui::SliderInt("Samples/Pass##CPU", &s_bakeConfig.cpuSamplesPerPass, 0, 1024);
+            HelpTooltip(
+                "Progressive bake: accumulate samples in passes.\n"
+                "0 = single pass. A checkpoint is saved after each pass\n"
+                "and an interrupted bake resumes from it.");
+            ImGui::SliderFloat("Convergence##CPU", &s_bakeConfig.cpuConvergenceThreshold, 0.0f, 0.1f, "%.3f");
+            HelpTooltip(
+                "Stop baking a brick once the relative noise of every voxel\n"
+                "is below this value (0 = always take all samples).");
         }
         ImGui::PopItemWidth();
 
@@ -281,6 +290,11 @@ static void DrawLightmap2DSection() {
             ImGui::SetTooltip("Intel Open Image Denoise - AI-based denoising\nfor cleaner lightmaps with fewer samples.");
         }
 
+        ImGui::Checkbox("Use GPU (DXR)##LM2D", &s_lightmap2DConfig.bakeConfig.useGPU);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Bake with DXR when available.\nOff, or without DXR: multithreaded CPU path tracer.");
+        }
+
         ImGui::Spacing();
 
         // Bake button
@@ -1066,6 +1080,8 @@ bool Panels::ExecutePendingGPUBake() {
     if (vl.Initialize(s_pendingBakeVLConfig)) {
         vl.BuildOctree(CScene::Instance());
         CFFLog::Info("[VolumetricLightmap] Starting bake with GPU (DXR) backend...");
+        s_bakeConfig.checkpointPath = (s_bakeConfig.cpuSamplesPerPass > 0)
+            ? FFPath::GetDebugDir() + "/volumetric_lightmap.vlcheckpoint" : "";
         vl.BakeAllBricks(CScene::Instance(), s_bakeConfig);
 
         if (vl.CreateGPUResources()) {
@@ -345,38 +345,9 @@ void Panels::DrawViewport(CScene& scene, CCamera& editorCam,  // ✅ 改用 CCam
                     snapValues);
 
                 if (manipulated) {
-                    // Decompose ImGuizmo's world matrix to extract T, R, S
-                    XMMATRIX newWorld = XMLoadFloat4x4(&worldF);
-                    XMVECTOR scaleVec, rotationQuat, translationVec;
-
-                    if (XMMatrixDecompose(&scaleVec, &rotationQuat, &translationVec, newWorld)) {
-                        // Update position and scale
-                        XMStoreFloat3(&transform->position, translationVec);
-                        XMStoreFloat3(&transform->scale, scaleVec);
-
-                        // Convert quaternion to rotation matrix
-                        XMMATRIX rotMat = XMMatrixRotationQuaternion(rotationQuat);
-                        XMFLOAT4X4 m;
-                        XMStoreFloat4x4(&m, rotMat);
-
-                        // Extract Euler angles from rotation matrix
-                        // For XMMatrixRotationRollPitchYaw(pitch, yaw, roll) order
-                        float pitch, yaw, roll;
-                        float sinPitch = -m._31;
-
-                        if (fabsf(sinPitch) >= 0.9999f) {
-                            // Gimbal lock case
-                            pitch = copysignf(XM_PIDIV2, sinPitch);
-                            yaw = atan2f(-m._13, m._33);
-                            roll = 0.0f;
-                        } else {
-                            pitch = asinf(sinPitch);
-                            yaw = atan2f(m._32, m._33);
-                            roll = atan2f(m._12, m._11);  // Use m._12 (sin) not m._21
-                        }
-
-                        transform->rotationEuler = XMFLOAT3(pitch, yaw, roll);
-                    }
+                    // ImGuizmo edits the world matrix; convert back to local TRS
+                    // (relative to the parent, rotation stored as quaternion)
+                    transform->SetWorldMatrix(XMLoadFloat4x4(&worldF));
                 }
             }
         }
@@ -410,41 +381,11 @@ void Panels::DrawViewport(CScene& scene, CCamera& editorCam,  // ✅ 改用 CCam
             PickingUtils::Ray ray = PickingUtils::GenerateRayFromScreen(
                 mouseX, mouseY, avail.x, avail.y, view, proj);
 
-            // Find closest intersected object
-            float closestDistance = FLT_MAX;
-            int closestObjectIndex = -1;
-
-            const auto& objects = scene.GetWorld().Objects();
-
-            for (size_t i = 0; i < objects.size(); ++i) {
-                CGameObject* obj = objects[i].get();
-                if (!obj) continue;
-
-                // Get transform and mesh renderer
-                STransform* transform = obj->GetComponent<STransform>();
-                SMeshRenderer* meshRenderer = obj->GetComponent<SMeshRenderer>();
-
-                if (!transform || !meshRenderer) continue;
-
-                // Get local-space AABB from mesh
-                XMFLOAT3 localMin, localMax;
-                if (!meshRenderer->GetLocalBounds(localMin, localMax)) {
-                    continue;  // No bounds available
-                }
-
-                // Transform AABB to world space
-                XMMATRIX worldMat = transform->WorldMatrix();
-                XMFLOAT3 worldMin, worldMax;
-                PickingUtils::TransformAABB(localMin, localMax, worldMat, worldMin, worldMax);
-
-                // Test ray intersection with world-space AABB
-                std::optional<float> hitDistance = PickingUtils::RayAABBIntersect(ray, worldMin, worldMax);
-
-                if (hitDistance.has_value() && hitDistance.value() < closestDistance) {
-                    closestDistance = hitDistance.value();
-                    closestObjectIndex = static_cast<int>(i);
-                }
-            }
+            // Find closest intersected object (world-space mesh bounds in the spatial index)
+            CSceneSpatialIndex& spatialIndex = scene.GetSpatialIndex();
+            spatialIndex.Update(scene.GetWorld());
+            const SSpatialEntry* hit = spatialIndex.RayCast(ray.origin, ray.direction, FLT_MAX, SpatialCategory_Mesh);
+            int closestObjectIndex = hit ? static_cast<int>(hit->worldIndex) : -1;
 
             // Update selection (only if we hit something)
             if (closestObjectIndex >= 0) {
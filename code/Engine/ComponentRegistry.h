@@ -32,6 +32,12 @@ public:
         return nullptr;
     }
 
+    // Factory of a type (nullptr if unknown), for callers creating many components of one type
+    const FactoryFunc* Find(const std::string& typeName) const {
+        auto it = m_factories.find(typeName);
+        return it != m_factories.end() ? &it->second : nullptr;
+    }
+
 private:
     CComponentRegistry() = default;
     std::unordered_map<std::string, FactoryFunc> m_factories;
@@ -0,0 +1,286 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Component.h"
+
+// ============================================
+// Sparse-set component storage
+// ============================================
+// Components of one type live in a TComponentPool:
+//   - Paged slot storage: components are constructed in place in fixed-size
+//     pages, so they are packed in memory and NEVER move once created.
+//     Raw component pointers (render proxies, spatial index, editor) stay
+//     valid until the component's entity is destroyed.
+//   - Sparse set: sparse[entity] -> dense index, dense arrays hold the
+//     entity ids and component pointers back to back. Iteration walks the
+//     dense arrays, lookup by entity is O(1).
+//
+// CComponentStorage owns one pool per component type plus the entity id
+// allocator. CWorld owns one storage; CGameObject is a facade over an entity
+// (AddComponent / GetComponent forward here).
+//
+// Typed views iterate the smallest pool and look the other types up through
+// the sparse arrays:
+//   world.View<STransform, SMeshRenderer>().Each(
+//       [](EntityId e, STransform& t, SMeshRenderer& mr) { ... });
+//
+// One component per type per entity (exact type match, no base-class lookup).
+
+using EntityId = uint32_t;
+constexpr EntityId INVALID_ENTITY = std::numeric_limits<EntityId>::max();
+
+// Process-wide dense id per component type (index into the storage's pool table)
+class CComponentTypeId {
+public:
+    template<class T>
+    static uint32_t Get() {
+        static const uint32_t id = s_next++;
+        return id;
+    }
+private:
+    inline static uint32_t s_next = 0;
+};
+
+class IComponentPool {
+public:
+    virtual ~IComponentPool() = default;
+    virtual bool Contains(EntityId e) const = 0;
+    virtual CComponent* GetBase(EntityId e) = 0;
+    virtual void Remove(EntityId e) = 0;
+    virtual size_t Size() const = 0;
+    virtual const EntityId* Entities() const = 0;
+};
+
+template<class T>
+class TComponentPool final : public IComponentPool {
+public:
+    static constexpr uint32_t PAGE_SIZE = 256;      // Components per page
+    static constexpr uint32_t NPOS = 0xFFFFFFFFu;
+
+    TComponentPool() = default;
+    TComponentPool(const TComponentPool&) = delete;
+    TComponentPool& operator=(const TComponentPool&) = delete;
+
+    ~TComponentPool() override {
+        for (T* c : m_components) {
+            c->~T();
+        }
+    }
+
+    template<class... Args>
+    T* Emplace(EntityId e, Args&&... args) {
+        if (T* existing = Get(e)) return existing;
+
+        uint32_t slot;
+        if (!m_freeSlots.empty()) {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            slot = m_slotCount++;
+            if (slot / PAGE_SIZE >= m_pages.size()) {
+                m_pages.emplace_back(new SPage);
+            }
+        }
+        T* c = new (slotAddress(slot)) T(std::forward<Args>(args)...);
+
+        if (e >= m_sparse.size()) {
+            m_sparse.resize((size_t)e + 1, NPOS);
+        }
+        m_sparse[e] = (uint32_t)m_entities.size();
+        m_entities.push_back(e);
+        m_components.push_back(c);
+        m_slots.push_back(slot);
+        return c;
+    }
+
+    T* Get(EntityId e) const {
+        if (e >= m_sparse.size() || m_sparse[e] == NPOS) return nullptr;
+        return m_components[m_sparse[e]];
+    }
+
+    bool Contains(EntityId e) const override {
+        return e < m_sparse.size() && m_sparse[e] != NPOS;
+    }
+    CComponent* GetBase(EntityId e) override { return Get(e); }
+
+    // Swap-remove from the dense arrays; the component's slot is recycled
+    void Remove(EntityId e) override {
+        if (!Contains(e)) return;
+        uint32_t index = m_sparse[e];
+        uint32_t last = (uint32_t)m_entities.size() - 1;
+
+        m_components[index]->~T();
+        m_freeSlots.push_back(m_slots[index]);
+
+        if (index != last) {
+            m_entities[index] = m_entities[last];
+            m_components[index] = m_components[last];
+            m_slots[index] = m_slots[last];
+            m_sparse[m_entities[index]] = index;
+        }
+        m_entities.pop_back();
+        m_components.pop_back();
+        m_slots.pop_back();
+        m_sparse[e] = NPOS;
+    }
+
+    size_t Size() const override { return m_entities.size(); }
+    const EntityId* Entities() const override { return m_entities.data(); }
+    T* const* Components() const { return m_components.data(); }
+
+private:
+    struct SPage {
+        alignas(T) unsigned char data[sizeof(T) * PAGE_SIZE];
+    };
+    void* slotAddress(uint32_t slot) {
+        return m_pages[slot / PAGE_SIZE]->data + sizeof(T) * (slot % PAGE_SIZE);
+    }
+
+    std::vector<std::unique_ptr<SPage>> m_pages;
+    uint32_t m_slotCount = 0;
+    std::vector<uint32_t> m_freeSlots;
+
+    std::vector<uint32_t> m_sparse;     // entity -> dense index
+    std::vector<EntityId> m_entities;   // dense
+    std::vector<T*> m_components;       // dense, parallel to m_entities
+    std::vector<uint32_t> m_slots;      // dense, parallel to m_entities
+};
+
+template<class... Ts>
+class TComponentView;
+
+class CComponentStorage {
+public:
+    CComponentStorage() = default;
+    CComponentStorage(const CComponentStorage&) = delete;
+    CComponentStorage& operator=(const CComponentStorage&) = delete;
+
+    EntityId CreateEntity() {
+        if (!m_freeEntities.empty()) {
+            EntityId e = m_freeEntities.back();
+            m_freeEntities.pop_back();
+            return e;
+        }
+        return m_nextEntity++;
+    }
+
+    // Destroys every component of the entity and recycles its id
+    void DestroyEntity(EntityId e) {
+        for (auto& pool : m_pools) {
+            if (pool) pool->Remove(e);
+        }
+        m_freeEntities.push_back(e);
+    }
+
+    template<class T, class... Args>
+    T* Add(EntityId e, Args&&... args) {
+        return Pool<T>().Emplace(e, std::forward<Args>(args)...);
+    }
+
+    template<class T>
+    T* Get(EntityId e) const {
+        const TComponentPool<T>* pool = FindPool<T>();
+        return pool ? pool->Get(e) : nullptr;
+    }
+
+    template<class T>
+    TComponentPool<T>& Pool() {
+        uint32_t id = CComponentTypeId::Get<T>();
+        if (id >= m_pools.size()) {
+            m_pools.resize((size_t)id + 1);
+        }
+        if (!m_pools[id]) {
+            m_pools[id] = std::make_unique<TComponentPool<T>>();
+        }
+        return static_cast<TComponentPool<T>&>(*m_pools[id]);
+    }
+
+    // nullptr if no component of this type was ever added
+    template<class T>
+    const TComponentPool<T>* FindPool() const {
+        uint32_t id = CComponentTypeId::Get<T>();
+        if (id >= m_pools.size()) return nullptr;
+        return static_cast<const TComponentPool<T>*>(m_pools[id].get());
+    }
+
+    template<class... Ts>
+    TComponentView<Ts...> View() const { return TComponentView<Ts...>(*this); }
+
+    size_t GetEntityCount() const { return m_nextEntity - m_freeEntities.size(); }
+
+private:
+    std::vector<std::unique_ptr<IComponentPool>> m_pools;  // Indexed by CComponentTypeId
+    EntityId m_nextEntity = 0;
+    std::vector<EntityId> m_freeEntities;
+};
+
+// ============================================
+// TComponentView - entities owning all of Ts...
+// ============================================
+// Each() walks the dense arrays of the smallest pool. Adding or removing
+// components of the viewed types inside Each() is not allowed.
+template<class... Ts>
+class TComponentView {
+public:
+    explicit TComponentView(const CComponentStorage& storage)
+        : m_pools{storage.FindPool<Ts>()...} {}
+
+    // func(EntityId, Ts&...)
+    template<class Func>
+    void Each(Func&& func) const {
+        each(std::forward<Func>(func), std::index_sequence_for<Ts...>{});
+    }
+
+    // Upper bound on the number of matching entities
+    size_t SizeHint() const {
+        const IComponentPool* lead = leadPool();
+        return lead ? lead->Size() : 0;
+    }
+
+private:
+    // Smallest pool, nullptr if a type was never added (empty view)
+    const IComponentPool* leadPool() const {
+        const IComponentPool* lead = nullptr;
+        bool missing = false;
+        auto consider = [&](const IComponentPool* pool) {
+            if (!pool) { missing = true; return; }
+            if (!lead || pool->Size() < lead->Size()) lead = pool;
+        };
+        std::apply([&](const auto*... pools) { (consider(pools), ...); }, m_pools);
+        return missing ? nullptr : lead;
+    }
+
+    template<class Func, size_t... I>
+    void each(Func&& func, std::index_sequence<I...>) const {
+        const IComponentPool* lead = leadPool();
+        if (!lead) return;
+
+        // Fast path: single-type view iterates the dense component array directly
+        if constexpr (sizeof...(Ts) == 1) {
+            const auto* pool = std::get<0>(m_pools);
+            const EntityId* entities = pool->Entities();
+            auto* const* components = pool->Components();
+            for (size_t i = 0, n = pool->Size(); i < n; i++) {
+                func(entities[i], *components[i]);
+            }
+        } else {
+            const EntityId* entities = lead->Entities();
+            for (size_t i = 0, n = lead->Size(); i < n; i++) {
+                EntityId e = entities[i];
+                auto components = std::make_tuple(std::get<I>(m_pools)->Get(e)...);
+                if (((std::get<I>(components) != nullptr) && ...)) {
+                    func(e, *std::get<I>(components)...);
+                }
+            }
+        }
+    }
+
+    std::tuple<const TComponentPool<Ts>*...> m_pools;
+};
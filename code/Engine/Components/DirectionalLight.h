@@ -68,13 +68,8 @@ struct SDirectionalLight : public CComponent {
             return XMFLOAT3(0.0f, -1.0f, 0.0f);
         }
 
-        // Calculate forward vector from rotation (DirectX uses -Z as forward)
-        // XMMatrixRotationRollPitchYaw parameter order: (Pitch, Yaw, Roll)
-        XMMATRIX R = XMMatrixRotationRollPitchYaw(
-            transform->rotationEuler.x,  // pitch
-            transform->rotationEuler.y,  // yaw
-            transform->rotationEuler.z   // roll
-        );
+        // Calculate forward vector from world rotation (DirectX uses -Z as forward)
+        XMMATRIX R = transform->GetRotationMatrix();
 
         // Transform forward vector (-Z direction) by rotation
         XMVECTOR forward = XMVectorSet(0.0f, 0.0f, -1.0f, 0.0f);
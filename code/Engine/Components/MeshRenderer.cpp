@@ -3,6 +3,7 @@
 #include "Core/MeshResourceManager.h"
 #include "Core/GpuMeshResource.h"
 #include "Core/FFLog.h"
+#include <algorithm>
 
 bool SMeshRenderer::EnsureUploaded() {
     if (!meshes.empty()) return true;
@@ -12,6 +13,12 @@ bool SMeshRenderer::EnsureUploaded() {
 
     // Load or retrieve cached resources via MeshResourceManager
     meshes = CMeshResourceManager::Instance().GetOrLoad(path,true,true);
+    if (subMeshCount >= 0 && !meshes.empty()) {
+        size_t first = std::min((size_t)std::max(subMeshFirst, 0), meshes.size());
+        size_t last = std::min(first + (size_t)subMeshCount, meshes.size());
+        meshes = std::vector<std::shared_ptr<GpuMeshResource>>(meshes.begin() + first, meshes.begin() + last);
+    }
+    if (!meshes.empty()) MarkRenderStateDirty();
 
     if (meshes.empty()) {
         CFFLog::Error("ERROR: Failed to load mesh from: %s" , path);
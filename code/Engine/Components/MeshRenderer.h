@@ -3,6 +3,7 @@
 #include "PropertyVisitor.h"
 #include "ComponentRegistry.h"
 #include <DirectXMath.h>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -15,12 +16,23 @@ struct SMeshRenderer : public CComponent {
     std::string materialPath; // Path to material asset (.ffasset)
     std::vector<std::shared_ptr<GpuMeshResource>> meshes; // GPU resources (glTF may have multiple sub-meshes)
 
+    // Sub-meshes of the file drawn by this renderer: [subMeshFirst, +subMeshCount), -1 = all.
+    // glTF node instances (CScene::ImportModel) each draw their mesh's primitives.
+    int subMeshFirst = 0;
+    int subMeshCount = -1;
+
     // Lightmap data (set after baking)
     int lightmapInfosIndex = -1;  // Index into CLightmap2DManager buffer (-1 = no lightmap)
+    float lightmapScale = 1.0f;   // Texel density multiplier for baking (x atlas texelsPerUnit)
 
     // Debug: show bounds wireframe in viewport
     bool showBounds = false;
 
+    // Bumped when mesh or material changes; CRenderProxyTable re-resolves on change.
+    // Call MarkRenderStateDirty() after changing path/materialPath from code.
+    uint32_t renderVersion = 0;
+    void MarkRenderStateDirty() { ++renderVersion; }
+
     // Ensure GPU mesh exists, returns true if ok
     bool EnsureUploaded();
 
@@ -30,22 +42,33 @@ struct SMeshRenderer : public CComponent {
     const char* GetTypeName() const override { return "MeshRenderer"; }
 
     void VisitProperties(CPropertyVisitor& visitor) override {
-        // Save old value to detect changes
+        // Save old values to detect changes
         std::string oldPath = path;
+        std::string oldMaterialPath = materialPath;
+        int oldSubMeshFirst = subMeshFirst;
+        int oldSubMeshCount = subMeshCount;
 
         // Expose mesh path with browse button
         visitor.VisitFilePath("Path", path, "Mesh Files\0*.obj;*.gltf;*.glb\0OBJ Files\0*.obj\0glTF Files\0*.gltf;*.glb\0All Files\0*.*\0");
 
-        // If path changed, mark for reload
-        if (path != oldPath) {
+        visitor.VisitInt("subMeshFirst", subMeshFirst);
+        visitor.VisitInt("subMeshCount", subMeshCount);
+
+        // If path or sub-mesh range changed, mark for reload
+        if (path != oldPath || subMeshFirst != oldSubMeshFirst || subMeshCount != oldSubMeshCount) {
             meshes.clear(); // Clear to trigger reload in EnsureUploaded
+            MarkRenderStateDirty();
         }
 
         // Expose material path with browse button
         visitor.VisitFilePath("Material", materialPath, "Material Files\0*.ffasset\0All Files\0*.*\0");
+        if (materialPath != oldMaterialPath) {
+            MarkRenderStateDirty();
+        }
 
         // Lightmap index (internal, read-only in Inspector)
         visitor.VisitInt("lightmapInfosIndex", lightmapInfosIndex);
+        visitor.VisitFloat("Lightmap Scale", lightmapScale);
 
         // Show local bounds info (read-only) from mesh resource
         DirectX::XMFLOAT3 localMin, localMax;
@@ -0,0 +1,222 @@
+#include "Transform.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace
+{
+    template<class T>
+    bool sameBits(const T& a, const T& b)
+    {
+        return std::memcmp(&a, &b, sizeof(T)) == 0;
+    }
+}
+
+STransform::~STransform()
+{
+    // Children keep their world pose when the parent goes away
+    while (!m_children.empty()) {
+        m_children.back()->SetParent(nullptr, true);
+    }
+    if (m_parent) {
+        SetParent(nullptr, false);
+    }
+}
+
+// ============================================
+// Matrices
+// ============================================
+
+XMMATRIX STransform::LocalMatrix() const
+{
+    // S * R * T without the two matrix multiplies: scale the rotation rows,
+    // then put the translation in the last row
+    XMMATRIX m = XMMatrixRotationQuaternion(XMLoadFloat4(&rotation));
+    m.r[0] = XMVectorScale(m.r[0], scale.x);
+    m.r[1] = XMVectorScale(m.r[1], scale.y);
+    m.r[2] = XMVectorScale(m.r[2], scale.z);
+    m.r[3] = XMVectorSetW(XMLoadFloat3(&position), 1.0f);
+    return m;
+}
+
+bool STransform::refreshWorld() const
+{
+    XMMATRIX parentWorld = XMMatrixIdentity();
+    uint32_t parentVersion = 0;
+    if (m_parent) {
+        parentWorld = m_parent->WorldMatrix();
+        parentVersion = m_parent->m_cache.worldVersion;
+    }
+
+    if (m_cache.valid &&
+        m_cache.parent == m_parent &&
+        m_cache.parentVersion == parentVersion &&
+        sameBits(m_cache.position, position) &&
+        sameBits(m_cache.rotation, rotation) &&
+        sameBits(m_cache.scale, scale)) {
+        return false;
+    }
+
+    XMMATRIX world = LocalMatrix();
+    if (m_parent) {
+        world = XMMatrixMultiply(world, parentWorld);
+    }
+    XMStoreFloat4x4(&m_cache.world, world);
+    m_cache.position = position;
+    m_cache.rotation = rotation;
+    m_cache.scale = scale;
+    m_cache.parent = m_parent;
+    m_cache.parentVersion = parentVersion;
+    m_cache.worldVersion++;
+    m_cache.valid = true;
+    return true;
+}
+
+void STransform::invalidateWorld()
+{
+    m_cache.valid = false;
+}
+
+XMMATRIX STransform::WorldMatrix() const
+{
+    refreshWorld();
+    return XMLoadFloat4x4(&m_cache.world);
+}
+
+XMMATRIX STransform::PrevWorldMatrix() const
+{
+    return m_hasFrameHistory ? XMLoadFloat4x4(&m_prevWorld) : WorldMatrix();
+}
+
+uint32_t STransform::GetWorldVersion() const
+{
+    refreshWorld();
+    return m_cache.worldVersion;
+}
+
+void STransform::beginFrame()
+{
+    refreshWorld();
+    m_prevWorld = m_hasFrameHistory ? m_frameWorld : m_cache.world;
+    m_frameWorld = m_cache.world;
+    m_hasFrameHistory = true;
+}
+
+XMFLOAT3 STransform::GetWorldPosition() const
+{
+    refreshWorld();
+    return {m_cache.world._41, m_cache.world._42, m_cache.world._43};
+}
+
+XMVECTOR STransform::GetWorldRotation() const
+{
+    XMVECTOR local = XMLoadFloat4(&rotation);
+    if (!m_parent) {
+        return local;
+    }
+    // Row vectors: local rotation first, then the parent's
+    return XMQuaternionMultiply(local, m_parent->GetWorldRotation());
+}
+
+XMMATRIX STransform::GetRotationMatrix() const
+{
+    return XMMatrixRotationQuaternion(GetWorldRotation());
+}
+
+bool STransform::SetWorldMatrix(FXMMATRIX world)
+{
+    XMMATRIX local = world;
+    if (m_parent) {
+        local = XMMatrixMultiply(world, XMMatrixInverse(nullptr, m_parent->WorldMatrix()));
+    }
+
+    XMVECTOR s, r, t;
+    if (!XMMatrixDecompose(&s, &r, &t, local)) {
+        return false;
+    }
+    XMStoreFloat3(&position, t);
+    XMStoreFloat4(&rotation, XMQuaternionNormalize(r));
+    XMStoreFloat3(&scale, s);
+    return true;
+}
+
+// ============================================
+// Euler angles
+// ============================================
+
+XMFLOAT3 STransform::GetRotationEuler() const
+{
+    if (sameBits(m_eulerHintRotation, rotation)) {
+        return m_eulerHint;
+    }
+
+    // XMMatrixRotationRollPitchYaw = Rz(roll) * Rx(pitch) * Ry(yaw):
+    //   _32 = -sin(pitch), _31 / _33 -> yaw, _12 / _22 -> roll
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, XMMatrixRotationQuaternion(XMLoadFloat4(&rotation)));
+
+    XMFLOAT3 euler;
+    float sinPitch = std::clamp(-m._32, -1.0f, 1.0f);
+    euler.x = std::asin(sinPitch);
+    if (std::fabs(sinPitch) < 0.9999f) {
+        euler.y = std::atan2(m._31, m._33);
+        euler.z = std::atan2(m._12, m._22);
+    } else {
+        // Gimbal lock: yaw and roll share an axis, put it all in yaw
+        euler.y = std::atan2(-m._13, m._11);
+        euler.z = 0.0f;
+    }
+    return euler;
+}
+
+void STransform::SetRotationEuler(const XMFLOAT3& pitchYawRoll)
+{
+    XMStoreFloat4(&rotation, XMQuaternionRotationRollPitchYaw(pitchYawRoll.x, pitchYawRoll.y, pitchYawRoll.z));
+    m_eulerHint = pitchYawRoll;
+    m_eulerHintRotation = rotation;
+}
+
+// ============================================
+// Hierarchy
+// ============================================
+
+uint32_t STransform::GetDepth() const
+{
+    uint32_t depth = 0;
+    for (const STransform* p = m_parent; p; p = p->m_parent) {
+        depth++;
+    }
+    return depth;
+}
+
+bool STransform::SetParent(STransform* parent, bool keepWorldTransform)
+{
+    if (parent == m_parent) {
+        return true;
+    }
+    for (const STransform* p = parent; p; p = p->m_parent) {
+        if (p == this) {
+            return false;   // Would create a cycle
+        }
+    }
+
+    XMMATRIX world = WorldMatrix();
+
+    if (m_parent) {
+        auto& siblings = m_parent->m_children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
+    m_parent = parent;
+    if (m_parent) {
+        m_parent->m_children.push_back(this);
+    }
+
+    if (keepWorldTransform) {
+        SetWorldMatrix(world);
+    }
+    invalidateWorld();
+    ++s_hierarchyEpoch;
+    return true;
+}
@@ -3,42 +3,127 @@
 #include "PropertyVisitor.h"
 #include "ComponentRegistry.h"
 #include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
 
+// ============================================
+// STransform - local TRS + parent/child hierarchy
+// ============================================
+// position / rotation / scale are LOCAL (relative to the parent, world space
+// for root transforms) and may be written directly. The world matrix is
+// cached and rebuilt lazily when:
+//   - the local TRS differs from the values it was built from, or
+//   - the parent's world version changed (dirty state propagates down the
+//     hierarchy through the version numbers, children never get stale)
+//
+// CTransformSystem::Update() refreshes every transform once per frame in
+// hierarchy order (optionally in parallel) and records the previous frame's
+// world matrix for motion vectors. Multi-threaded readers should only call
+// WorldMatrix() after that update.
 struct STransform : public CComponent {
     DirectX::XMFLOAT3 position{0,0,0};
-    DirectX::XMFLOAT3 rotationEuler{0,0,0}; // (pitch, yaw, roll) in radians
+    DirectX::XMFLOAT4 rotation{0,0,0,1};    // Quaternion
     DirectX::XMFLOAT3 scale{1,1,1};
 
-    DirectX::XMMATRIX WorldMatrix() const {
-        using namespace DirectX;
-        XMMATRIX S = XMMatrixScaling(scale.x, scale.y, scale.z);
-        // XMMatrixRotationRollPitchYaw parameter order: (Pitch, Yaw, Roll)
-        // rotationEuler storage: (pitch, yaw, roll)
-        XMMATRIX R = XMMatrixRotationRollPitchYaw(rotationEuler.x, rotationEuler.y, rotationEuler.z);
-        XMMATRIX T = XMMatrixTranslation(position.x, position.y, position.z);
-        // DirectX row-major: P' = P * World, apply order: Scale -> Rotate -> Translate (SRT standard)
-        return S * R * T;
-    }
+    STransform() = default;
+    STransform(const STransform&) = delete;
+    STransform& operator=(const STransform&) = delete;
+    ~STransform() override;     // Detaches from parent; children become roots (world pose kept)
 
-    DirectX::XMMATRIX GetRotationMatrix() const {
-        using namespace DirectX;
-        return XMMatrixRotationRollPitchYaw(rotationEuler.x, rotationEuler.y, rotationEuler.z);
-    }
+    // ============================================
+    // Matrices (row vectors: P' = P * M)
+    // ============================================
+    DirectX::XMMATRIX LocalMatrix() const;      // S * R * T
+    DirectX::XMMATRIX WorldMatrix() const;      // Local * parent world (cached)
+    // World matrix of the previous CTransformSystem::Update (= WorldMatrix() before the first one)
+    DirectX::XMMATRIX PrevWorldMatrix() const;
+    // Incremented whenever WorldMatrix() changes (render caches compare it)
+    uint32_t GetWorldVersion() const;
+
+    DirectX::XMFLOAT3 GetWorldPosition() const;
+    DirectX::XMVECTOR GetWorldRotation() const;   // Quaternion
+    DirectX::XMMATRIX GetRotationMatrix() const;  // World rotation only
+
+    // Sets the local TRS so that WorldMatrix() == world (e.g. editor gizmo)
+    bool SetWorldMatrix(DirectX::FXMMATRIX world);
 
+    // ============================================
+    // Euler helpers: (pitch, yaw, roll), XMMatrixRotationRollPitchYaw convention
+    // ============================================
+    // Radians. Returns the angles last set if the rotation was not changed since,
+    // so editor values stay stable near gimbal lock.
+    DirectX::XMFLOAT3 GetRotationEuler() const;
+    void SetRotationEuler(const DirectX::XMFLOAT3& pitchYawRoll);
+    // Degrees
     void SetRotation(float pitch, float yaw, float roll) {
-        // Convert degrees to radians
-        rotationEuler.x = DirectX::XMConvertToRadians(pitch);
-        rotationEuler.y = DirectX::XMConvertToRadians(yaw);
-        rotationEuler.z = DirectX::XMConvertToRadians(roll);
+        SetRotationEuler({DirectX::XMConvertToRadians(pitch), DirectX::XMConvertToRadians(yaw),
+                          DirectX::XMConvertToRadians(roll)});
     }
 
+    // ============================================
+    // Hierarchy
+    // ============================================
+    STransform* GetParent() const { return m_parent; }
+    const std::vector<STransform*>& GetChildren() const { return m_children; }
+    uint32_t GetDepth() const;
+
+    // parent = nullptr detaches. keepWorldTransform recomputes the local TRS so
+    // the object does not move. Returns false (no change) if it would create a cycle.
+    bool SetParent(STransform* parent, bool keepWorldTransform = true);
+
+    // Bumped on every SetParent (CTransformSystem re-sorts when it changes)
+    static uint32_t GetHierarchyEpoch() { return s_hierarchyEpoch; }
+
     const char* GetTypeName() const override { return "Transform"; }
 
     void VisitProperties(CPropertyVisitor& visitor) override {
         visitor.VisitFloat3("Position", position);
-        visitor.VisitFloat3AsAngles("Rotation", rotationEuler);  // Display as degrees, store as radians
+
+        // Stored as quaternion, edited / serialized as Euler angles
+        DirectX::XMFLOAT3 euler = GetRotationEuler();
+        DirectX::XMFLOAT3 oldEuler = euler;
+        visitor.VisitFloat3AsAngles("Rotation", euler);  // Display as degrees, store as radians
+        if (euler.x != oldEuler.x || euler.y != oldEuler.y || euler.z != oldEuler.z) {
+            SetRotationEuler(euler);
+        }
+
         visitor.VisitFloat3("Scale", scale);
     }
+
+private:
+    friend class CTransformSystem;
+
+    // Rebuilds the cached world matrix if stale; true if it was rebuilt
+    bool refreshWorld() const;
+    // CTransformSystem: shift the frame history (prev <- last frame, last frame <- current)
+    void beginFrame();
+    void invalidateWorld();
+
+    STransform* m_parent = nullptr;
+    std::vector<STransform*> m_children;
+
+    // Euler angles of the last SetRotationEuler and the quaternion they produced
+    DirectX::XMFLOAT3 m_eulerHint{0,0,0};
+    DirectX::XMFLOAT4 m_eulerHintRotation{0,0,0,1};
+
+    struct SWorldCache
+    {
+        DirectX::XMFLOAT3 position;         // Local TRS the matrix was built from
+        DirectX::XMFLOAT4 rotation;
+        DirectX::XMFLOAT3 scale;
+        const STransform* parent = nullptr; // Parent it was built against
+        uint32_t parentVersion = 0;         // parent->worldVersion at build time
+        uint32_t worldVersion = 0;
+        bool valid = false;
+        DirectX::XMFLOAT4X4 world;
+    };
+    mutable SWorldCache m_cache;
+
+    DirectX::XMFLOAT4X4 m_frameWorld;       // World matrix at the last CTransformSystem::Update
+    DirectX::XMFLOAT4X4 m_prevWorld;        // World matrix at the update before that
+    bool m_hasFrameHistory = false;
+
+    inline static uint32_t s_hierarchyEpoch = 0;
 };
 
 // Auto-register component
@@ -0,0 +1,311 @@
+#include "DynamicAABBTree.h"
+#include <cassert>
+
+using namespace DirectX;
+
+SAABB SAABB::Transform(const XMFLOAT3& localMin, const XMFLOAT3& localMax, const XMMATRIX& world)
+{
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, world);
+
+    const float lmin[3] = {localMin.x, localMin.y, localMin.z};
+    const float lmax[3] = {localMax.x, localMax.y, localMax.z};
+    float wmin[3], wmax[3];
+    for (int j = 0; j < 3; j++) {
+        wmin[j] = wmax[j] = m.m[3][j];
+        for (int i = 0; i < 3; i++) {
+            float a = m.m[i][j] * lmin[i];
+            float b = m.m[i][j] * lmax[i];
+            wmin[j] += std::min(a, b);
+            wmax[j] += std::max(a, b);
+        }
+    }
+
+    SAABB result;
+    result.min = {wmin[0], wmin[1], wmin[2]};
+    result.max = {wmax[0], wmax[1], wmax[2]};
+    return result;
+}
+
+// ============================================
+// Node pool
+// ============================================
+
+int32_t CDynamicAABBTree::allocateNode()
+{
+    if (m_freeList == NULL_NODE) {
+        m_nodes.emplace_back();
+        return (int32_t)m_nodes.size() - 1;
+    }
+    int32_t nodeId = m_freeList;
+    m_freeList = m_nodes[nodeId].parent;
+    m_nodes[nodeId] = SNode();
+    return nodeId;
+}
+
+void CDynamicAABBTree::freeNode(int32_t nodeId)
+{
+    m_nodes[nodeId].parent = m_freeList;
+    m_nodes[nodeId].height = -1;
+    m_freeList = nodeId;
+}
+
+void CDynamicAABBTree::Clear()
+{
+    m_nodes.clear();
+    m_root = NULL_NODE;
+    m_freeList = NULL_NODE;
+    m_proxyCount = 0;
+}
+
+SAABB CDynamicAABBTree::fatten(const SAABB& aabb) const
+{
+    SAABB fat;
+    fat.min = {aabb.min.x - m_margin, aabb.min.y - m_margin, aabb.min.z - m_margin};
+    fat.max = {aabb.max.x + m_margin, aabb.max.y + m_margin, aabb.max.z + m_margin};
+    return fat;
+}
+
+// ============================================
+// Proxies
+// ============================================
+
+int32_t CDynamicAABBTree::CreateProxy(const SAABB& aabb, uint32_t userData)
+{
+    int32_t proxyId = allocateNode();
+    m_nodes[proxyId].aabb = fatten(aabb);
+    m_nodes[proxyId].userData = userData;
+    m_nodes[proxyId].height = 0;
+    insertLeaf(proxyId);
+    m_proxyCount++;
+    return proxyId;
+}
+
+void CDynamicAABBTree::DestroyProxy(int32_t proxyId)
+{
+    assert(m_nodes[proxyId].IsLeaf());
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    m_proxyCount--;
+}
+
+bool CDynamicAABBTree::MoveProxy(int32_t proxyId, const SAABB& aabb)
+{
+    assert(m_nodes[proxyId].IsLeaf());
+    if (m_nodes[proxyId].aabb.Contains(aabb)) {
+        return false;
+    }
+    removeLeaf(proxyId);
+    m_nodes[proxyId].aabb = fatten(aabb);
+    insertLeaf(proxyId);
+    return true;
+}
+
+// ============================================
+// Insertion / removal
+// ============================================
+
+void CDynamicAABBTree::insertLeaf(int32_t leaf)
+{
+    if (m_root == NULL_NODE) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Find the best sibling: descend while the cost of pushing the leaf
+    // further down is lower than pairing it with the current node
+    SAABB leafAABB = m_nodes[leaf].aabb;
+    int32_t index = m_root;
+    while (!m_nodes[index].IsLeaf()) {
+        int32_t child1 = m_nodes[index].child1;
+        int32_t child2 = m_nodes[index].child2;
+
+        float area = m_nodes[index].aabb.SurfaceArea();
+        float combinedArea = SAABB::Union(m_nodes[index].aabb, leafAABB).SurfaceArea();
+
+        // Cost of creating a new parent for this node and the leaf
+        float cost = 2.0f * combinedArea;
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child) {
+            float unionArea = SAABB::Union(leafAABB, m_nodes[child].aabb).SurfaceArea();
+            if (m_nodes[child].IsLeaf()) {
+                return unionArea + inheritanceCost;
+            }
+            return (unionArea - m_nodes[child].aabb.SurfaceArea()) + inheritanceCost;
+        };
+        float cost1 = descendCost(child1);
+        float cost2 = descendCost(child2);
+
+        if (cost < cost1 && cost < cost2) break;
+        index = (cost1 < cost2) ? child1 : child2;
+    }
+    int32_t sibling = index;
+
+    // Create a new parent for sibling + leaf
+    int32_t oldParent = m_nodes[sibling].parent;
+    int32_t newParent = allocateNode();
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].aabb = SAABB::Union(leafAABB, m_nodes[sibling].aabb);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE) {
+        if (m_nodes[oldParent].child1 == sibling) {
+            m_nodes[oldParent].child1 = newParent;
+        } else {
+            m_nodes[oldParent].child2 = newParent;
+        }
+    } else {
+        m_root = newParent;
+    }
+
+    refitAncestors(m_nodes[leaf].parent);
+}
+
+void CDynamicAABBTree::removeLeaf(int32_t leaf)
+{
+    if (leaf == m_root) {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    int32_t parent = m_nodes[leaf].parent;
+    int32_t grandParent = m_nodes[parent].parent;
+    int32_t sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent != NULL_NODE) {
+        // Replace parent with sibling
+        if (m_nodes[grandParent].child1 == parent) {
+            m_nodes[grandParent].child1 = sibling;
+        } else {
+            m_nodes[grandParent].child2 = sibling;
+        }
+        m_nodes[sibling].parent = grandParent;
+        freeNode(parent);
+        refitAncestors(grandParent);
+    } else {
+        m_root = sibling;
+        m_nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+void CDynamicAABBTree::refitAncestors(int32_t index)
+{
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        int32_t child1 = m_nodes[index].child1;
+        int32_t child2 = m_nodes[index].child2;
+        m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+        m_nodes[index].aabb = SAABB::Union(m_nodes[child1].aabb, m_nodes[child2].aabb);
+
+        index = m_nodes[index].parent;
+    }
+}
+
+// ============================================
+// Balancing
+// ============================================
+// Rotates the taller grandchild subtree up when the children's heights
+// differ by more than one. Returns the index of the subtree root.
+
+int32_t CDynamicAABBTree::balance(int32_t iA)
+{
+    SNode& A = m_nodes[iA];
+    if (A.IsLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    int32_t iB = A.child1;
+    int32_t iC = A.child2;
+    int32_t heightDiff = m_nodes[iC].height - m_nodes[iB].height;
+
+    // Rotate child iUp above iA (iOther stays under iA)
+    auto rotateUp = [this, iA](int32_t iUp, int32_t iOther, bool upIsChild2) {
+        SNode& A = m_nodes[iA];
+        SNode& U = m_nodes[iUp];
+        int32_t iF = U.child1;
+        int32_t iG = U.child2;
+
+        // Swap A and U
+        U.child1 = iA;
+        U.parent = A.parent;
+        A.parent = iUp;
+
+        if (U.parent != NULL_NODE) {
+            if (m_nodes[U.parent].child1 == iA) {
+                m_nodes[U.parent].child1 = iUp;
+            } else {
+                m_nodes[U.parent].child2 = iUp;
+            }
+        } else {
+            m_root = iUp;
+        }
+
+        // Keep the taller grandchild under U, move the shorter one under A
+        int32_t iTall = (m_nodes[iF].height > m_nodes[iG].height) ? iF : iG;
+        int32_t iShort = (iTall == iF) ? iG : iF;
+        U.child2 = iTall;
+        if (upIsChild2) {
+            A.child2 = iShort;
+        } else {
+            A.child1 = iShort;
+        }
+        m_nodes[iShort].parent = iA;
+
+        A.aabb = SAABB::Union(m_nodes[iOther].aabb, m_nodes[iShort].aabb);
+        A.height = 1 + std::max(m_nodes[iOther].height, m_nodes[iShort].height);
+        U.aabb = SAABB::Union(A.aabb, m_nodes[iTall].aabb);
+        U.height = 1 + std::max(A.height, m_nodes[iTall].height);
+        return iUp;
+    };
+
+    if (heightDiff > 1) {
+        return rotateUp(iC, iB, true);
+    }
+    if (heightDiff < -1) {
+        return rotateUp(iB, iC, false);
+    }
+    return iA;
+}
+
+// ============================================
+// Validation
+// ============================================
+
+bool CDynamicAABBTree::Validate() const
+{
+    if (m_root == NULL_NODE) return m_proxyCount == 0;
+    if (m_nodes[m_root].parent != NULL_NODE) return false;
+
+    int leafCount = 0;
+    std::vector<int32_t> stack = {m_root};
+    while (!stack.empty()) {
+        int32_t index = stack.back();
+        stack.pop_back();
+        const SNode& node = m_nodes[index];
+
+        if (node.IsLeaf()) {
+            if (node.height != 0) return false;
+            leafCount++;
+            continue;
+        }
+
+        const SNode& c1 = m_nodes[node.child1];
+        const SNode& c2 = m_nodes[node.child2];
+        if (c1.parent != index || c2.parent != index) return false;
+        if (node.height != 1 + std::max(c1.height, c2.height)) return false;
+        if (!node.aabb.Contains(c1.aabb) || !node.aabb.Contains(c2.aabb)) return false;
+
+        stack.push_back(node.child1);
+        stack.push_back(node.child2);
+    }
+    return leafCount == m_proxyCount;
+}
@@ -0,0 +1,202 @@
+#pragma once
+#include "Rendering/FrustumCulling.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// World-space axis-aligned box
+struct SAABB
+{
+    DirectX::XMFLOAT3 min{0, 0, 0};
+    DirectX::XMFLOAT3 max{0, 0, 0};
+
+    bool Overlaps(const SAABB& o) const {
+        return min.x <= o.max.x && max.x >= o.min.x &&
+               min.y <= o.max.y && max.y >= o.min.y &&
+               min.z <= o.max.z && max.z >= o.min.z;
+    }
+    bool Contains(const SAABB& o) const {
+        return min.x <= o.min.x && min.y <= o.min.y && min.z <= o.min.z &&
+               max.x >= o.max.x && max.y >= o.max.y && max.z >= o.max.z;
+    }
+    bool OverlapsSphere(const DirectX::XMFLOAT3& center, float radius) const {
+        float dx = std::max(std::max(min.x - center.x, 0.0f), center.x - max.x);
+        float dy = std::max(std::max(min.y - center.y, 0.0f), center.y - max.y);
+        float dz = std::max(std::max(min.z - center.z, 0.0f), center.z - max.z);
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+    // Same plane test as FrustumCulling (conservative: intersecting boxes pass)
+    bool IntersectsFrustum(const SFrustumPlanes& frustum) const {
+        float cx = (min.x + max.x) * 0.5f, ex = (max.x - min.x) * 0.5f;
+        float cy = (min.y + max.y) * 0.5f, ey = (max.y - min.y) * 0.5f;
+        float cz = (min.z + max.z) * 0.5f, ez = (max.z - min.z) * 0.5f;
+        for (const DirectX::XMFLOAT4& p : frustum.planes) {
+            float d = p.x * cx + p.y * cy + p.z * cz + p.w;
+            float r = std::fabs(p.x) * ex + std::fabs(p.y) * ey + std::fabs(p.z) * ez;
+            if (d + r < 0.0f) return false;
+        }
+        return true;
+    }
+    // Slab test against a ray with precomputed 1/dir; outEntry = max(0, entry distance)
+    bool IntersectsRay(const float org[3], const float invDir[3], float maxT, float& outEntry) const {
+        const float bmin[3] = {min.x, min.y, min.z};
+        const float bmax[3] = {max.x, max.y, max.z};
+        float tNear = 0.0f, tFar = maxT;
+        for (int a = 0; a < 3; a++) {
+            float t1 = (bmin[a] - org[a]) * invDir[a];
+            float t2 = (bmax[a] - org[a]) * invDir[a];
+            // NaN (0 * inf on a slab boundary) is ignored by the min/max ordering
+            tNear = std::max(tNear, std::min(t1, t2));
+            tFar = std::min(tFar, std::max(t1, t2));
+        }
+        outEntry = tNear;
+        return tNear <= tFar;
+    }
+    float SurfaceArea() const {
+        float dx = max.x - min.x, dy = max.y - min.y, dz = max.z - min.z;
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+    // Local box transformed by a row-vector world matrix (Arvo)
+    static SAABB Transform(const DirectX::XMFLOAT3& localMin, const DirectX::XMFLOAT3& localMax,
+                           const DirectX::XMMATRIX& world);
+    static SAABB Union(const SAABB& a, const SAABB& b) {
+        SAABB r;
+        r.min = {std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)};
+        r.max = {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)};
+        return r;
+    }
+};
+
+// ============================================
+// CDynamicAABBTree
+// ============================================
+// Incrementally updated bounding volume hierarchy (Box2D-style dynamic tree):
+//   - Leaves store a "fat" AABB (tight bounds + margin). MoveProxy() only
+//     re-inserts a leaf when its new bounds leave the fat AABB, so small
+//     motions cost nothing and the tree is never rebuilt from scratch.
+//   - Insertion picks the sibling with the lowest surface-area cost;
+//     AVL-style rotations keep the height O(log n).
+//
+// Queries walk the tree with an explicit stack and call back per leaf with
+// the proxy's user data. Callbacks return false to stop the query early
+// (ray casts return the new max distance instead, see RayCast).
+class CDynamicAABBTree
+{
+public:
+    static const int32_t NULL_NODE = -1;
+
+    int32_t CreateProxy(const SAABB& aabb, uint32_t userData);
+    void DestroyProxy(int32_t proxyId);
+    // Returns true if the leaf was re-inserted (bounds left the fat AABB)
+    bool MoveProxy(int32_t proxyId, const SAABB& aabb);
+    void Clear();
+
+    uint32_t GetUserData(int32_t proxyId) const { return m_nodes[proxyId].userData; }
+    void SetUserData(int32_t proxyId, uint32_t userData) { m_nodes[proxyId].userData = userData; }
+    const SAABB& GetFatAABB(int32_t proxyId) const { return m_nodes[proxyId].aabb; }
+
+    // Fat AABB margin in world units (applies to proxies created / moved afterwards)
+    void SetMargin(float margin) { m_margin = margin; }
+    float GetMargin() const { return m_margin; }
+
+    int GetProxyCount() const { return m_proxyCount; }
+    int GetHeight() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+
+    // callback(uint32_t userData) -> bool continue
+    template<typename Func>
+    void QueryAABB(const SAABB& aabb, Func&& callback) const {
+        traverse([&aabb](const SAABB& box) { return box.Overlaps(aabb); }, callback);
+    }
+
+    template<typename Func>
+    void QuerySphere(const DirectX::XMFLOAT3& center, float radius, Func&& callback) const {
+        traverse([&center, radius](const SAABB& box) { return box.OverlapsSphere(center, radius); }, callback);
+    }
+
+    template<typename Func>
+    void QueryFrustum(const SFrustumPlanes& frustum, Func&& callback) const {
+        traverse([&frustum](const SAABB& box) { return box.IntersectsFrustum(frustum); }, callback);
+    }
+
+    // callback(uint32_t userData, float tEntry) -> float newMaxDistance
+    //   return maxDistance to continue unchanged, a smaller value to clip the
+    //   ray (closest hit), or 0 to terminate.
+    // tEntry is the ray's entry distance into the leaf's fat AABB.
+    template<typename Func>
+    void RayCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir, float maxDistance,
+                 Func&& callback) const {
+        if (m_root == NULL_NODE) return;
+        const float invDir[3] = {1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z};
+        const float org[3] = {origin.x, origin.y, origin.z};
+
+        int32_t stack[STACK_SIZE];
+        int count = 0;
+        stack[count++] = m_root;
+        while (count > 0) {
+            const SNode& node = m_nodes[stack[--count]];
+            float tEntry;
+            if (!node.aabb.IntersectsRay(org, invDir, maxDistance, tEntry)) continue;
+
+            if (node.IsLeaf()) {
+                maxDistance = callback(node.userData, tEntry);
+                if (maxDistance <= 0.0f) return;
+            } else if (count + 2 <= STACK_SIZE) {
+                stack[count++] = node.child1;
+                stack[count++] = node.child2;
+            }
+        }
+    }
+
+    // Debug: verify parent links, heights and that parents enclose children
+    bool Validate() const;
+
+private:
+    static const int STACK_SIZE = 256;      // Height stays O(log n) thanks to balancing
+
+    struct SNode
+    {
+        SAABB aabb;
+        int32_t parent = NULL_NODE;         // Next free node when on the free list
+        int32_t child1 = NULL_NODE;
+        int32_t child2 = NULL_NODE;
+        int32_t height = -1;                // Leaf = 0, free = -1
+        uint32_t userData = 0;
+
+        bool IsLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    template<typename Overlap, typename Func>
+    void traverse(Overlap&& overlap, Func&& callback) const {
+        if (m_root == NULL_NODE) return;
+        int32_t stack[STACK_SIZE];
+        int count = 0;
+        stack[count++] = m_root;
+        while (count > 0) {
+            const SNode& node = m_nodes[stack[--count]];
+            if (!overlap(node.aabb)) continue;
+
+            if (node.IsLeaf()) {
+                if (!callback(node.userData)) return;
+            } else if (count + 2 <= STACK_SIZE) {
+                stack[count++] = node.child1;
+                stack[count++] = node.child2;
+            }
+        }
+    }
+
+    int32_t allocateNode();
+    void freeNode(int32_t nodeId);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    int32_t balance(int32_t nodeId);
+    void refitAncestors(int32_t nodeId);
+    SAABB fatten(const SAABB& aabb) const;
+
+    std::vector<SNode> m_nodes;
+    int32_t m_root = NULL_NODE;
+    int32_t m_freeList = NULL_NODE;
+    int m_proxyCount = 0;
+    float m_margin = 0.1f;
+};
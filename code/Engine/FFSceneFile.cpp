@@ -0,0 +1,692 @@
+#include "FFSceneFile.h"
+#include "World.h"
+#include "GameObject.h"
+#include "Component.h"
+#include "PropertyVisitor.h"
+#include "SceneLightSettings.h"
+#include "Components/Transform.h"
+#include "Core/FFLog.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+
+namespace
+{
+    uint64_t alignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    void append(std::vector<uint8_t>& out, const void* data, size_t bytes)
+    {
+        const uint8_t* begin = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), begin, begin + bytes);
+    }
+
+    int32_t cellCoord(float value, float cellSize)
+    {
+        return (int32_t)std::floor(value / cellSize);
+    }
+
+    uint32_t propertyStride(EFFScenePropertyKind kind, uint32_t count)
+    {
+        switch (kind) {
+        case EFFScenePropertyKind::Bool: return 1;
+        case EFFScenePropertyKind::Float3: return 12;
+        case EFFScenePropertyKind::Float3Array: return 12 * count;
+        default: return 4;
+        }
+    }
+
+    class CStringTable
+    {
+    public:
+        uint32_t Intern(const std::string& text)
+        {
+            auto it = m_lookup.find(text);
+            if (it != m_lookup.end()) return it->second;
+
+            uint32_t index = (uint32_t)m_entries.size();
+            m_entries.push_back({(uint32_t)m_data.size(), (uint32_t)text.size()});
+            m_data.insert(m_data.end(), text.begin(), text.end());
+            m_data.push_back('\0');
+            m_lookup.emplace(text, index);
+            return index;
+        }
+
+        const std::vector<SFFSceneString>& Entries() const { return m_entries; }
+        const std::vector<char>& Data() const { return m_data; }
+
+    private:
+        std::unordered_map<std::string, uint32_t> m_lookup;
+        std::vector<SFFSceneString> m_entries;
+        std::vector<char> m_data;
+    };
+
+    struct SFieldDesc {
+        uint32_t name;              // String index
+        EFFScenePropertyKind kind;
+        uint16_t count;
+    };
+
+    // One component's properties: schema and value bytes, in visit order
+    class CCollectVisitor : public CPropertyVisitor
+    {
+    public:
+        explicit CCollectVisitor(CStringTable& strings) : m_strings(strings) {}
+
+        void Reset() { fields.clear(); values.clear(); }
+
+        void VisitFloat(const char* name, float& value) override { add(name, EFFScenePropertyKind::Float, 1, &value); }
+        void VisitInt(const char* name, int& value) override { add(name, EFFScenePropertyKind::Int, 1, &value); }
+        void VisitEnum(const char* name, int& value, const std::vector<const char*>&) override {
+            add(name, EFFScenePropertyKind::Int, 1, &value);
+        }
+        void VisitBool(const char* name, bool& value) override {
+            uint8_t b = value ? 1 : 0;
+            add(name, EFFScenePropertyKind::Bool, 1, &b);
+        }
+        void VisitString(const char* name, std::string& value) override {
+            uint32_t index = m_strings.Intern(value);
+            add(name, EFFScenePropertyKind::String, 1, &index);
+        }
+        void VisitFloat3(const char* name, DirectX::XMFLOAT3& value) override {
+            add(name, EFFScenePropertyKind::Float3, 1, &value);
+        }
+        void VisitFloat3Array(const char* name, DirectX::XMFLOAT3* values, int count) override {
+            add(name, EFFScenePropertyKind::Float3Array, (uint16_t)std::clamp(count, 0, 0xFFFF), values);
+        }
+
+        std::vector<SFieldDesc> fields;
+        std::vector<uint8_t> values;
+
+    private:
+        void add(const char* name, EFFScenePropertyKind kind, uint16_t count, const void* data) {
+            fields.push_back({m_strings.Intern(name), kind, count});
+            append(values, data, propertyStride(kind, count));
+        }
+
+        CStringTable& m_strings;
+    };
+
+    // One column per (type, schema): components whose visit order differs
+    // between instances simply end up in several columns of the same type
+    struct SColumnBuild {
+        uint32_t typeName;
+        std::vector<SFieldDesc> schema;
+        std::vector<uint32_t> objects;
+        std::vector<std::vector<uint8_t>> data;     // Per property
+    };
+
+    bool sameSchema(const std::vector<SFieldDesc>& a, const std::vector<SFieldDesc>& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (a[i].name != b[i].name || a[i].kind != b[i].kind || a[i].count != b[i].count) return false;
+        }
+        return true;
+    }
+
+    // Matches visited properties to a column's schema
+    class CReadVisitor : public CPropertyVisitor
+    {
+    public:
+        CReadVisitor(const CFFSceneFile& file, const uint8_t* base, const SFFSceneProperty* properties,
+                     uint32_t count, uint32_t row)
+            : m_file(file), m_base(base), m_properties(properties), m_count(count), m_row(row) {}
+
+        void VisitFloat(const char* name, float& value) override {
+            if (const uint8_t* p = find(name, EFFScenePropertyKind::Float)) memcpy(&value, p, 4);
+        }
+        void VisitInt(const char* name, int& value) override {
+            if (const uint8_t* p = find(name, EFFScenePropertyKind::Int)) memcpy(&value, p, 4);
+        }
+        void VisitEnum(const char* name, int& value, const std::vector<const char*>&) override {
+            if (const uint8_t* p = find(name, EFFScenePropertyKind::Int)) memcpy(&value, p, 4);
+        }
+        void VisitBool(const char* name, bool& value) override {
+            if (const uint8_t* p = find(name, EFFScenePropertyKind::Bool)) value = *p != 0;
+        }
+        void VisitString(const char* name, std::string& value) override {
+            if (const uint8_t* p = find(name, EFFScenePropertyKind::String)) {
+                uint32_t index;
+                memcpy(&index, p, 4);
+                value.assign(m_file.GetString(index));
+            }
+        }
+        void VisitFloat3(const char* name, DirectX::XMFLOAT3& value) override {
+            if (const uint8_t* p = find(name, EFFScenePropertyKind::Float3)) memcpy(&value, p, 12);
+        }
+        void VisitFloat3Array(const char* name, DirectX::XMFLOAT3* values, int count) override {
+            const uint8_t* p = find(name, EFFScenePropertyKind::Float3Array);
+            if (p && count >= 0 && m_found->count >= count) {
+                memcpy(values, p, 12 * (size_t)count);
+            }
+        }
+
+    private:
+        // Components visit in the order they were saved: try the next property first
+        const uint8_t* find(const char* name, EFFScenePropertyKind kind) {
+            for (uint32_t n = 0; n < m_count; n++) {
+                uint32_t i = (m_cursor + n) % m_count;
+                const SFFSceneProperty& prop = m_properties[i];
+                if (prop.kind == kind && m_file.GetString(prop.name) == name) {
+                    m_cursor = i + 1;
+                    m_found = &prop;
+                    return m_base + prop.dataOffset + (uint64_t)m_row * prop.stride;
+                }
+            }
+            return nullptr;
+        }
+
+        const CFFSceneFile& m_file;
+        const uint8_t* m_base;
+        const SFFSceneProperty* m_properties;
+        uint32_t m_count;
+        uint32_t m_row;
+        uint32_t m_cursor = 0;
+        const SFFSceneProperty* m_found = nullptr;
+    };
+}
+
+// ============================================
+// Writer
+// ============================================
+
+void SerializeFFScene(const CWorld& world, const CSceneLightSettings& settings,
+                      std::vector<uint8_t>& out, float cellSize)
+{
+    if (!(cellSize > 0.0f)) cellSize = kFFSceneDefaultCellSize;
+
+    CStringTable strings;
+    CCollectVisitor collect(strings);
+    std::vector<SColumnBuild> columns;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> columnsByType;
+
+    const uint32_t objectCount = (uint32_t)world.Count();
+    std::vector<SFFSceneObject> objects(objectCount);
+    std::vector<SFFSceneComponentRef> components;
+    std::map<std::pair<int32_t, int32_t>, std::vector<uint32_t>> cellMap;
+
+    std::unordered_map<const STransform*, int32_t> transformIndex;
+    for (uint32_t i = 0; i < objectCount; i++) {
+        if (const STransform* t = world.Get(i)->GetComponent<STransform>()) {
+            transformIndex[t] = (int32_t)i;
+        }
+    }
+
+    for (uint32_t i = 0; i < objectCount; i++) {
+        const CGameObject* go = world.Get(i);
+        SFFSceneObject& obj = objects[i];
+        obj.name = strings.Intern(go->GetName());
+        obj.parent = -1;
+        obj.firstComponent = (uint32_t)components.size();
+        obj.cell = FFSCENE_NO_CELL;
+        obj.position[0] = obj.position[1] = obj.position[2] = 0.0f;
+
+        if (const STransform* t = go->GetComponent<STransform>()) {
+            if (t->GetParent()) {
+                auto it = transformIndex.find(t->GetParent());
+                if (it != transformIndex.end()) obj.parent = it->second;
+            }
+            DirectX::XMFLOAT3 p = t->GetWorldPosition();
+            obj.position[0] = p.x;
+            obj.position[1] = p.y;
+            obj.position[2] = p.z;
+            cellMap[{cellCoord(p.x, cellSize), cellCoord(p.z, cellSize)}].push_back(i);
+        }
+
+        go->ForEachComponent([&](const CComponent* comp) {
+            collect.Reset();
+            // const_cast is safe: the collect visitor only reads values
+            const_cast<CComponent*>(comp)->VisitProperties(collect);
+
+            uint32_t typeName = strings.Intern(comp->GetTypeName());
+            std::vector<uint32_t>& candidates = columnsByType[typeName];
+            uint32_t column = UINT32_MAX;
+            for (uint32_t c : candidates) {
+                if (sameSchema(columns[c].schema, collect.fields)) { column = c; break; }
+            }
+            if (column == UINT32_MAX) {
+                column = (uint32_t)columns.size();
+                candidates.push_back(column);
+                SColumnBuild build;
+                build.typeName = typeName;
+                build.schema = collect.fields;
+                build.data.resize(collect.fields.size());
+                columns.push_back(std::move(build));
+            }
+
+            SColumnBuild& build = columns[column];
+            components.push_back({column, (uint32_t)build.objects.size()});
+            build.objects.push_back(i);
+            size_t offset = 0;
+            for (size_t f = 0; f < collect.fields.size(); f++) {
+                uint32_t stride = propertyStride(collect.fields[f].kind, collect.fields[f].count);
+                append(build.data[f], collect.values.data() + offset, stride);
+                offset += stride;
+            }
+        });
+        obj.componentCount = (uint32_t)components.size() - obj.firstComponent;
+    }
+
+    std::vector<SFFSceneCell> cells;
+    std::vector<uint32_t> cellRefs;
+    cells.reserve(cellMap.size());
+    for (const auto& [coord, refs] : cellMap) {
+        SFFSceneCell cell = {coord.first, coord.second, (uint32_t)cellRefs.size(), (uint32_t)refs.size()};
+        for (uint32_t ref : refs) objects[ref].cell = (uint32_t)cells.size();
+        cellRefs.insert(cellRefs.end(), refs.begin(), refs.end());
+        cells.push_back(cell);
+    }
+
+    // Header and settings (interned before the string table is laid out)
+    SFFSceneHeader header = {};
+    header.magic = FFSCENE_MAGIC;
+    header.version = FFSCENE_VERSION;
+    header.cellSize = cellSize;
+    SFFSceneSettings& s = header.settings;
+    s.skyboxAssetPath = strings.Intern(settings.skyboxAssetPath);
+    s.diffuseGIMode = (int32_t)settings.diffuseGIMode;
+    s.gBufferDebugMode = (int32_t)settings.gBufferDebugMode;
+    const SVolumetricLightmapConfig& vl = settings.volumetricLightmap;
+    s.volumeMin[0] = vl.volumeMin.x; s.volumeMin[1] = vl.volumeMin.y; s.volumeMin[2] = vl.volumeMin.z;
+    s.volumeMax[0] = vl.volumeMax.x; s.volumeMax[1] = vl.volumeMax.y; s.volumeMax[2] = vl.volumeMax.z;
+    s.minBrickWorldSize = vl.minBrickWorldSize;
+    s.volumeEnabled = vl.enabled ? 1 : 0;
+
+    std::vector<SFFSceneColumn> columnDescs(columns.size());
+    std::vector<SFFSceneProperty> properties;
+    for (size_t c = 0; c < columns.size(); c++) {
+        columnDescs[c].typeName = columns[c].typeName;
+        columnDescs[c].firstProperty = (uint32_t)properties.size();
+        columnDescs[c].propertyCount = (uint32_t)columns[c].schema.size();
+        columnDescs[c].rowCount = (uint32_t)columns[c].objects.size();
+        for (const SFieldDesc& field : columns[c].schema) {
+            SFFSceneProperty prop = {};
+            prop.name = field.name;
+            prop.kind = field.kind;
+            prop.count = field.count;
+            prop.stride = propertyStride(field.kind, field.count);
+            properties.push_back(prop);
+        }
+    }
+
+    // Layout
+    header.objectCount = objectCount;
+    header.componentCount = (uint32_t)components.size();
+    header.columnCount = (uint32_t)columnDescs.size();
+    header.propertyCount = (uint32_t)properties.size();
+    header.stringCount = (uint32_t)strings.Entries().size();
+    header.cellCount = (uint32_t)cells.size();
+    header.cellRefCount = (uint32_t)cellRefs.size();
+
+    uint64_t offset = alignUp(sizeof(SFFSceneHeader), 8);
+    header.stringTableOffset = offset;
+    offset += strings.Entries().size() * sizeof(SFFSceneString);
+    header.stringDataOffset = offset;
+    header.stringDataSize = strings.Data().size();
+    offset = alignUp(offset + header.stringDataSize, 8);
+    header.objectOffset = offset;
+    offset += objects.size() * sizeof(SFFSceneObject);
+    header.componentOffset = offset = alignUp(offset, 8);
+    offset += components.size() * sizeof(SFFSceneComponentRef);
+    header.columnOffset = offset = alignUp(offset, 8);
+    offset += columnDescs.size() * sizeof(SFFSceneColumn);
+    header.propertyOffset = offset = alignUp(offset, 8);
+    offset += properties.size() * sizeof(SFFSceneProperty);
+    for (size_t c = 0; c < columns.size(); c++) {
+        columnDescs[c].objectsOffset = offset = alignUp(offset, 8);
+        offset += columns[c].objects.size() * sizeof(uint32_t);
+        for (uint32_t p = 0; p < columnDescs[c].propertyCount; p++) {
+            SFFSceneProperty& prop = properties[columnDescs[c].firstProperty + p];
+            prop.dataOffset = offset = alignUp(offset, 8);
+            offset += columns[c].data[p].size();
+        }
+    }
+    header.cellOffset = offset = alignUp(offset, 8);
+    offset += cells.size() * sizeof(SFFSceneCell);
+    header.cellRefOffset = offset = alignUp(offset, 8);
+    offset += cellRefs.size() * sizeof(uint32_t);
+
+    out.clear();
+    out.reserve(offset);
+    append(out, &header, sizeof(header));
+    out.resize(header.stringTableOffset, 0);
+    append(out, strings.Entries().data(), strings.Entries().size() * sizeof(SFFSceneString));
+    append(out, strings.Data().data(), strings.Data().size());
+    out.resize(header.objectOffset, 0);
+    append(out, objects.data(), objects.size() * sizeof(SFFSceneObject));
+    out.resize(header.componentOffset, 0);
+    append(out, components.data(), components.size() * sizeof(SFFSceneComponentRef));
+    out.resize(header.columnOffset, 0);
+    append(out, columnDescs.data(), columnDescs.size() * sizeof(SFFSceneColumn));
+    out.resize(header.propertyOffset, 0);
+    append(out, properties.data(), properties.size() * sizeof(SFFSceneProperty));
+    for (size_t c = 0; c < columns.size(); c++) {
+        out.resize(columnDescs[c].objectsOffset, 0);
+        append(out, columns[c].objects.data(), columns[c].objects.size() * sizeof(uint32_t));
+        for (uint32_t p = 0; p < columnDescs[c].propertyCount; p++) {
+            out.resize(properties[columnDescs[c].firstProperty + p].dataOffset, 0);
+            append(out, columns[c].data[p].data(), columns[c].data[p].size());
+        }
+    }
+    out.resize(header.cellOffset, 0);
+    append(out, cells.data(), cells.size() * sizeof(SFFSceneCell));
+    out.resize(header.cellRefOffset, 0);
+    append(out, cellRefs.data(), cellRefs.size() * sizeof(uint32_t));
+}
+
+bool WriteFFScene(const std::string& path, const CWorld& world, const CSceneLightSettings& settings,
+                  float cellSize)
+{
+    std::vector<uint8_t> bytes;
+    SerializeFFScene(world, settings, bytes, cellSize);
+
+    std::error_code ec;
+    std::filesystem::path target(path);
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), ec);
+    }
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            CFFLog::Error("[FFScene] Failed to open for writing: %s", path.c_str());
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file.good()) {
+            CFFLog::Error("[FFScene] Write failed: %s", path.c_str());
+            file.close();
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp, target, ec);
+    if (ec) {
+        CFFLog::Error("[FFScene] Failed to replace %s: %s", path.c_str(), ec.message().c_str());
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+// ============================================
+// CFFSceneFile
+// ============================================
+
+bool CFFSceneFile::Open(const std::string& path)
+{
+    Close();
+    if (!m_file.Open(path)) {
+        return false;
+    }
+    if (!Validate(path)) {
+        Close();
+        return false;
+    }
+
+    m_factories.resize(m_header->columnCount);
+    for (uint32_t c = 0; c < m_header->columnCount; c++) {
+        std::string type(GetString(m_columns[c].typeName));
+        m_factories[c] = CComponentRegistry::Instance().Find(type);
+        if (!m_factories[c]) {
+            CFFLog::Error("[FFScene] Unknown component type %s (%u instances skipped): %s",
+                          type.c_str(), m_columns[c].rowCount, path.c_str());
+        }
+    }
+    m_instances.assign(m_header->objectCount, nullptr);
+    return true;
+}
+
+bool CFFSceneFile::Validate(const std::string& name)
+{
+    const uint8_t* data = m_file.Data();
+    const uint64_t size = m_file.Size();
+    if (size < sizeof(SFFSceneHeader)) return false;
+
+    const auto* header = reinterpret_cast<const SFFSceneHeader*>(data);
+    if (header->magic != FFSCENE_MAGIC || header->version != FFSCENE_VERSION) {
+        return false;   // Other format / older writer
+    }
+
+    // Structure checks (ranges, indices); values are read as they are
+    auto section = [&](uint64_t offset, uint64_t count, uint64_t elementSize) {
+        return offset % 8 == 0 && offset <= size && count * elementSize <= size - offset;
+    };
+    auto corrupt = [&](const char* what) {
+        CFFLog::Warning("[FFScene] Corrupt file (%s): %s", what, name.c_str());
+        return false;
+    };
+
+    if (!section(header->stringTableOffset, header->stringCount, sizeof(SFFSceneString)) ||
+        header->stringDataOffset > size || header->stringDataSize > size - header->stringDataOffset ||
+        !section(header->objectOffset, header->objectCount, sizeof(SFFSceneObject)) ||
+        !section(header->componentOffset, header->componentCount, sizeof(SFFSceneComponentRef)) ||
+        !section(header->columnOffset, header->columnCount, sizeof(SFFSceneColumn)) ||
+        !section(header->propertyOffset, header->propertyCount, sizeof(SFFSceneProperty)) ||
+        !section(header->cellOffset, header->cellCount, sizeof(SFFSceneCell)) ||
+        !section(header->cellRefOffset, header->cellRefCount, sizeof(uint32_t)) ||
+        !(header->cellSize > 0.0f)) {
+        return corrupt("sections");
+    }
+
+    const auto* strings = reinterpret_cast<const SFFSceneString*>(data + header->stringTableOffset);
+    const char* stringData = reinterpret_cast<const char*>(data + header->stringDataOffset);
+    for (uint32_t i = 0; i < header->stringCount; i++) {
+        uint64_t end = (uint64_t)strings[i].offset + strings[i].length;
+        if (end >= header->stringDataSize || stringData[end] != '\0') return corrupt("strings");
+    }
+    if (header->settings.skyboxAssetPath >= header->stringCount) return corrupt("settings");
+
+    const auto* columns = reinterpret_cast<const SFFSceneColumn*>(data + header->columnOffset);
+    const auto* properties = reinterpret_cast<const SFFSceneProperty*>(data + header->propertyOffset);
+    for (uint32_t c = 0; c < header->columnCount; c++) {
+        const SFFSceneColumn& column = columns[c];
+        if (column.typeName >= header->stringCount ||
+            (uint64_t)column.firstProperty + column.propertyCount > header->propertyCount ||
+            !section(column.objectsOffset, column.rowCount, sizeof(uint32_t))) {
+            return corrupt("columns");
+        }
+        for (uint32_t p = 0; p < column.propertyCount; p++) {
+            const SFFSceneProperty& prop = properties[column.firstProperty + p];
+            if (prop.name >= header->stringCount || prop.kind > EFFScenePropertyKind::Float3Array ||
+                prop.stride != propertyStride(prop.kind, prop.count) ||
+                !section(prop.dataOffset, column.rowCount, prop.stride)) {
+                return corrupt("properties");
+            }
+        }
+    }
+
+    const auto* components = reinterpret_cast<const SFFSceneComponentRef*>(data + header->componentOffset);
+    for (uint32_t i = 0; i < header->componentCount; i++) {
+        if (components[i].column >= header->columnCount ||
+            components[i].row >= columns[components[i].column].rowCount) {
+            return corrupt("components");
+        }
+    }
+
+    const auto* objects = reinterpret_cast<const SFFSceneObject*>(data + header->objectOffset);
+    for (uint32_t i = 0; i < header->objectCount; i++) {
+        const SFFSceneObject& obj = objects[i];
+        if (obj.name >= header->stringCount ||
+            obj.parent < -1 || obj.parent >= (int64_t)header->objectCount || obj.parent == (int32_t)i ||
+            (uint64_t)obj.firstComponent + obj.componentCount > header->componentCount ||
+            (obj.cell != FFSCENE_NO_CELL && obj.cell >= header->cellCount)) {
+            return corrupt("objects");
+        }
+    }
+
+    const auto* cells = reinterpret_cast<const SFFSceneCell*>(data + header->cellOffset);
+    const auto* cellRefs = reinterpret_cast<const uint32_t*>(data + header->cellRefOffset);
+    for (uint32_t c = 0; c < header->cellCount; c++) {
+        if ((uint64_t)cells[c].firstRef + cells[c].refCount > header->cellRefCount) return corrupt("cells");
+    }
+    for (uint32_t i = 0; i < header->cellRefCount; i++) {
+        if (cellRefs[i] >= header->objectCount) return corrupt("cells");
+    }
+
+    m_header = header;
+    m_strings = strings;
+    m_stringData = stringData;
+    m_objects = objects;
+    m_components = components;
+    m_columns = columns;
+    m_properties = properties;
+    m_cells = cells;
+    m_cellRefs = cellRefs;
+    return true;
+}
+
+void CFFSceneFile::Close()
+{
+    m_file.Close();
+    m_header = nullptr;
+    m_strings = nullptr;
+    m_stringData = nullptr;
+    m_objects = nullptr;
+    m_components = nullptr;
+    m_columns = nullptr;
+    m_properties = nullptr;
+    m_cells = nullptr;
+    m_cellRefs = nullptr;
+    m_factories.clear();
+    m_instances.clear();
+    m_instanceCount = 0;
+    m_globalsCreated = false;
+}
+
+std::string_view CFFSceneFile::GetString(uint32_t index) const
+{
+    if (!m_header || index >= m_header->stringCount) return {};
+    return std::string_view(m_stringData + m_strings[index].offset, m_strings[index].length);
+}
+
+DirectX::XMFLOAT3 CFFSceneFile::GetObjectPosition(uint32_t i) const
+{
+    const float* p = m_objects[i].position;
+    return DirectX::XMFLOAT3(p[0], p[1], p[2]);
+}
+
+void CFFSceneFile::ReadLightSettings(CSceneLightSettings& out) const
+{
+    const SFFSceneSettings& s = m_header->settings;
+    out.skyboxAssetPath.assign(GetString(s.skyboxAssetPath));
+    out.diffuseGIMode = static_cast<EDiffuseGIMode>(s.diffuseGIMode);
+    out.gBufferDebugMode = static_cast<EGBufferDebugMode>(s.gBufferDebugMode);
+    SVolumetricLightmapConfig& vl = out.volumetricLightmap;
+    vl.volumeMin = DirectX::XMFLOAT3(s.volumeMin[0], s.volumeMin[1], s.volumeMin[2]);
+    vl.volumeMax = DirectX::XMFLOAT3(s.volumeMax[0], s.volumeMax[1], s.volumeMax[2]);
+    vl.minBrickWorldSize = s.minBrickWorldSize;
+    vl.enabled = s.volumeEnabled != 0;
+}
+
+uint32_t CFFSceneFile::Instantiate(CWorld& world)
+{
+    if (!m_header || m_instanceCount == m_header->objectCount) return 0;
+
+    std::vector<uint32_t> all;
+    all.reserve(m_header->objectCount - m_instanceCount);
+    for (uint32_t i = 0; i < m_header->objectCount; i++) {
+        if (!m_instances[i]) all.push_back(i);
+    }
+    m_globalsCreated = true;
+    return InstantiateObjects(world, all);
+}
+
+uint32_t CFFSceneFile::InstantiateRegion(CWorld& world, const DirectX::XMFLOAT3& boundsMin,
+                                         const DirectX::XMFLOAT3& boundsMax)
+{
+    if (!m_header) return 0;
+
+    const uint32_t objectCount = m_header->objectCount;
+    std::vector<uint8_t> selected(objectCount, 0);
+
+    const float cellSize = m_header->cellSize;
+    const int32_t x0 = cellCoord(boundsMin.x, cellSize), x1 = cellCoord(boundsMax.x, cellSize);
+    const int32_t z0 = cellCoord(boundsMin.z, cellSize), z1 = cellCoord(boundsMax.z, cellSize);
+    for (uint32_t c = 0; c < m_header->cellCount; c++) {
+        const SFFSceneCell& cell = m_cells[c];
+        if (cell.x < x0 || cell.x > x1 || cell.z < z0 || cell.z > z1) continue;
+        for (uint32_t r = 0; r < cell.refCount; r++) {
+            uint32_t i = m_cellRefs[cell.firstRef + r];
+            const float* p = m_objects[i].position;
+            if (p[0] >= boundsMin.x && p[0] <= boundsMax.x && p[1] >= boundsMin.y && p[1] <= boundsMax.y &&
+                p[2] >= boundsMin.z && p[2] <= boundsMax.z) {
+                selected[i] = 1;
+            }
+        }
+    }
+    if (!m_globalsCreated) {
+        for (uint32_t i = 0; i < objectCount; i++) {
+            if (m_objects[i].cell == FFSCENE_NO_CELL) selected[i] = 1;
+        }
+        m_globalsCreated = true;
+    }
+
+    // Ancestors keep local transforms meaningful; stops at the first marked one
+    // (also ends the walk on a parent cycle)
+    for (uint32_t i = 0; i < objectCount; i++) {
+        if (!selected[i] || m_instances[i]) continue;
+        for (int32_t p = m_objects[i].parent; p >= 0 && !selected[p]; p = m_objects[p].parent) {
+            selected[p] = 1;
+        }
+    }
+    std::vector<uint32_t> pending;
+    for (uint32_t i = 0; i < objectCount; i++) {
+        if (selected[i] && !m_instances[i]) pending.push_back(i);
+    }
+    return InstantiateObjects(world, pending);
+}
+
+uint32_t CFFSceneFile::InstantiateObjects(CWorld& world, const std::vector<uint32_t>& sortedObjects)
+{
+    for (uint32_t i : sortedObjects) {
+        const SFFSceneObject& obj = m_objects[i];
+        CGameObject* go = world.Create(std::string(GetString(obj.name)));
+        for (uint32_t c = 0; c < obj.componentCount; c++) {
+            const SFFSceneComponentRef& ref = m_components[obj.firstComponent + c];
+            const CComponentRegistry::FactoryFunc* factory = m_factories[ref.column];
+            if (!factory) continue;
+            if (CComponent* comp = (*factory)(go)) {
+                ReadComponent(*comp, m_columns[ref.column], ref.row);
+            }
+        }
+        m_instances[i] = go;
+    }
+    m_instanceCount += (uint32_t)sortedObjects.size();
+
+    // Parent links once both ends exist (Transform values are local). Ancestors
+    // are always created with (or before) their descendants.
+    for (uint32_t i : sortedObjects) {
+        int32_t parentIndex = m_objects[i].parent;
+        if (parentIndex < 0 || !m_instances[parentIndex]) continue;
+        auto* transform = m_instances[i]->GetComponent<STransform>();
+        auto* parent = m_instances[parentIndex]->GetComponent<STransform>();
+        if (transform && parent && !transform->SetParent(parent, false)) {
+            CFFLog::Warning("[FFScene] Ignoring cyclic parent link on object %u", i);
+        }
+    }
+    return (uint32_t)sortedObjects.size();
+}
+
+void CFFSceneFile::ReadComponent(CComponent& comp, const SFFSceneColumn& column, uint32_t row) const
+{
+    CReadVisitor visitor(*this, m_file.Data(), m_properties + column.firstProperty, column.propertyCount, row);
+    comp.VisitProperties(visitor);
+}
+
+void CFFSceneFile::ForgetInstances()
+{
+    std::fill(m_instances.begin(), m_instances.end(), nullptr);
+    m_instanceCount = 0;
+    m_globalsCreated = false;
+}
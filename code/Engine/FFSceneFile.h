@@ -0,0 +1,199 @@
+#pragma once
+#include "Core/MappedFile.h"
+#include "ComponentRegistry.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CWorld;
+class CSceneLightSettings;
+
+// ============================================
+// .ffscene - binary scene, loaded with mmap
+// ============================================
+// Same content as the JSON .scene (objects, parent links, component
+// properties, light settings), laid out for loading without parsing:
+//
+//   SFFSceneHeader
+//   SFFSceneString[stringCount]        offset / length into the string data
+//   char[]                             string data, each string 0-terminated
+//   SFFSceneObject[objectCount]        file order = CWorld order
+//   SFFSceneComponentRef[componentCount]  per object, in ForEachComponent order
+//   SFFSceneColumn[columnCount]        one per component type (and property layout)
+//   SFFSceneProperty[propertyCount]    schema of every column
+//   uint32_t[] / property arrays       per column: owning objects, then one
+//                                      array per property (rowCount values)
+//   SFFSceneCell[cellCount]            XZ grid over object world positions
+//   uint32_t[cellRefCount]             object indices, grouped by cell
+//
+// Names (object names, type names, property names, string values) are
+// interned once in the string table; properties are matched to the visitor
+// by position in the column schema, so reading a component is a few memcpy.
+//
+// CFFSceneFile maps the file and validates the tables, objects are created
+// on demand: all of them (Instantiate) or those of a region of the world
+// (InstantiateRegion), which can be called again as the region moves.
+//
+// Native endianness, sections 8-byte aligned. CSceneSerializer picks the
+// format by extension and converts between the two (ConvertScene).
+
+static const uint32_t FFSCENE_MAGIC = 0x43534646;   // "FFSC"
+static const uint32_t FFSCENE_VERSION = 1;
+static const float kFFSceneDefaultCellSize = 64.0f;
+static const uint32_t FFSCENE_NO_CELL = 0xFFFFFFFFu;
+
+enum class EFFScenePropertyKind : uint16_t {
+    Float = 0,
+    Int = 1,            // Also enums
+    Bool = 2,           // 1 byte
+    String = 3,         // String table index (also file paths)
+    Float3 = 4,
+    Float3Array = 5,    // count * 3 floats
+};
+
+struct SFFSceneString {
+    uint32_t offset;
+    uint32_t length;            // Without the terminator
+};
+
+// Light settings saved with the scene (the fields of the JSON "lightSettings")
+struct SFFSceneSettings {
+    uint32_t skyboxAssetPath;   // String index
+    int32_t diffuseGIMode;
+    int32_t gBufferDebugMode;
+    float volumeMin[3];
+    float volumeMax[3];
+    float minBrickWorldSize;
+    uint32_t volumeEnabled;
+};
+
+struct SFFSceneHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t objectCount;
+    uint32_t componentCount;
+    uint32_t columnCount;
+    uint32_t propertyCount;
+    uint32_t stringCount;
+    uint32_t cellCount;
+    uint64_t stringTableOffset;
+    uint64_t stringDataOffset;
+    uint64_t stringDataSize;
+    uint64_t objectOffset;
+    uint64_t componentOffset;
+    uint64_t columnOffset;
+    uint64_t propertyOffset;
+    uint64_t cellOffset;
+    uint64_t cellRefOffset;
+    uint32_t cellRefCount;
+    float cellSize;
+    SFFSceneSettings settings;
+};
+
+struct SFFSceneObject {
+    uint32_t name;              // String index
+    int32_t parent;             // Object index, -1 = root
+    uint32_t firstComponent;
+    uint32_t componentCount;
+    float position[3];          // World position at save time (region queries)
+    uint32_t cell;              // FFSCENE_NO_CELL: no Transform, loaded with every region
+};
+
+struct SFFSceneComponentRef {
+    uint32_t column;
+    uint32_t row;
+};
+
+struct SFFSceneColumn {
+    uint32_t typeName;          // String index, CComponentRegistry key
+    uint32_t firstProperty;
+    uint32_t propertyCount;
+    uint32_t rowCount;
+    uint64_t objectsOffset;     // uint32_t[rowCount] owning object of each row
+};
+
+struct SFFSceneProperty {
+    uint32_t name;              // String index
+    EFFScenePropertyKind kind;
+    uint16_t count;             // Float3Array length, else 1
+    uint32_t stride;            // Bytes per row
+    uint32_t reserved;
+    uint64_t dataOffset;        // stride * rowCount bytes
+};
+
+struct SFFSceneCell {
+    int32_t x, z;               // floor(position / cellSize)
+    uint32_t firstRef;
+    uint32_t refCount;
+};
+
+// Serialize a world and its light settings (cellSize: region grid, world units)
+void SerializeFFScene(const CWorld& world, const CSceneLightSettings& settings,
+                      std::vector<uint8_t>& out, float cellSize = kFFSceneDefaultCellSize);
+bool WriteFFScene(const std::string& path, const CWorld& world, const CSceneLightSettings& settings,
+                  float cellSize = kFFSceneDefaultCellSize);
+
+// ============================================
+// CFFSceneFile
+// ============================================
+// Usage:
+//   CFFSceneFile file;
+//   if (file.Open(path)) {
+//       file.ReadLightSettings(settings);
+//       file.InstantiateRegion(world, cameraPos - radius, cameraPos + radius);
+//   }
+//
+// Instances are remembered per object so streaming never creates an object
+// twice; the file does not observe the world, call ForgetInstances() before
+// destroying objects it created.
+class CFFSceneFile
+{
+public:
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_header != nullptr; }
+
+    uint32_t GetObjectCount() const { return m_header ? m_header->objectCount : 0; }
+    std::string_view GetString(uint32_t index) const;
+    std::string_view GetObjectName(uint32_t i) const { return GetString(m_objects[i].name); }
+    int GetParent(uint32_t i) const { return m_objects[i].parent; }
+    DirectX::XMFLOAT3 GetObjectPosition(uint32_t i) const;
+    float GetCellSize() const { return m_header->cellSize; }
+
+    void ReadLightSettings(CSceneLightSettings& out) const;
+
+    // Create every object not created yet, in file order. Returns the number created.
+    uint32_t Instantiate(CWorld& world);
+
+    // Create the objects whose saved world position lies in [boundsMin, boundsMax],
+    // their ancestors, and objects without a Transform. Returns the number created.
+    uint32_t InstantiateRegion(CWorld& world, const DirectX::XMFLOAT3& boundsMin,
+                               const DirectX::XMFLOAT3& boundsMax);
+
+    CGameObject* GetInstance(uint32_t i) const { return i < m_instances.size() ? m_instances[i] : nullptr; }
+    uint32_t GetInstanceCount() const { return m_instanceCount; }
+    void ForgetInstances();
+
+private:
+    bool Validate(const std::string& name);
+    uint32_t InstantiateObjects(CWorld& world, const std::vector<uint32_t>& sortedObjects);
+    void ReadComponent(CComponent& comp, const SFFSceneColumn& column, uint32_t row) const;
+
+    CMappedFile m_file;
+    const SFFSceneHeader* m_header = nullptr;
+    const SFFSceneString* m_strings = nullptr;
+    const char* m_stringData = nullptr;
+    const SFFSceneObject* m_objects = nullptr;
+    const SFFSceneComponentRef* m_components = nullptr;
+    const SFFSceneColumn* m_columns = nullptr;
+    const SFFSceneProperty* m_properties = nullptr;
+    const SFFSceneCell* m_cells = nullptr;
+    const uint32_t* m_cellRefs = nullptr;
+
+    std::vector<const CComponentRegistry::FactoryFunc*> m_factories;   // Per column, resolved at Open (nullptr = unknown type)
+    std::vector<CGameObject*> m_instances;      // Per object, nullptr = not created
+    uint32_t m_instanceCount = 0;
+    bool m_globalsCreated = false;              // Objects without a cell
+};
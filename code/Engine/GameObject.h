@@ -3,51 +3,76 @@
 #include <memory>
 #include <vector>
 #include <type_traits>
+#include <cstdint>
 #include "Component.h"
+#include "ComponentStorage.h"
 
+// CGameObject is a facade over an entity in a CComponentStorage (owned by
+// CWorld). Components live in per-type dense pools; the object only keeps
+// the insertion order for ForEachComponent (serialization / inspector).
 class CGameObject {
 public:
-    explicit CGameObject(std::string name): m_name(std::move(name)) {}
+    // Standalone object (owns a private storage)
+    explicit CGameObject(std::string name)
+        : m_name(std::move(name))
+        , m_ownedStorage(std::make_unique<CComponentStorage>())
+        , m_storage(m_ownedStorage.get())
+        , m_entity(m_storage->CreateEntity()) {}
+
+    // Object whose components live in a shared storage (CWorld)
+    CGameObject(std::string name, CComponentStorage& storage)
+        : m_name(std::move(name))
+        , m_storage(&storage)
+        , m_entity(storage.CreateEntity()) {}
+
+    ~CGameObject() { m_storage->DestroyEntity(m_entity); }
+
+    CGameObject(const CGameObject&) = delete;
+    CGameObject& operator=(const CGameObject&) = delete;
+
     const std::string& GetName() const { return m_name; }
     void SetName(const std::string& n){ m_name = n; }
+    EntityId GetEntity() const { return m_entity; }
 
+    // One component per type: adding an existing type returns the existing one
     template<class T, class...Args>
     T* AddComponent(Args&&...args){
         static_assert(std::is_base_of<CComponent,T>::value, "T must be CComponent");
-        auto up = std::make_unique<T>(std::forward<Args>(args)...);
-        T* raw = up.get();
+        if (T* existing = m_storage->Get<T>(m_entity)) return existing;
+
+        T* raw = m_storage->Add<T>(m_entity, std::forward<Args>(args)...);
         raw->SetOwner(this);
-        m_components.emplace_back(std::move(up));
+        m_components.push_back(raw);
+        ++s_componentEpoch;
         return raw;
     }
 
+    // Bumped whenever any object gains a component (render caches compare it)
+    static uint32_t GetComponentEpoch() { return s_componentEpoch; }
+
     template<class T>
     T* GetComponent(){
-        for (auto& c : m_components){
-            if (auto p = dynamic_cast<T*>(c.get())) return p;
-        }
-        return nullptr;
+        return m_storage->Get<T>(m_entity);
     }
 
     template<class T>
     const T* GetComponent() const {
-        for (const auto& c : m_components){
-            if (auto p = dynamic_cast<const T*>(c.get())) return p;
-        }
-        return nullptr;
+        return m_storage->Get<T>(m_entity);
     }
 
     // Iterate over all components (for serialization/reflection)
     template<typename Func>
     void ForEachComponent(Func&& func) const {
-        for (const auto& comp : m_components) {
-            func(comp.get());
+        for (CComponent* comp : m_components) {
+            func(comp);
         }
     }
 
 private:
     std::string m_name;
-    std::vector<std::unique_ptr<CComponent>> m_components;
+    std::unique_ptr<CComponentStorage> m_ownedStorage;
+    CComponentStorage* m_storage;
+    EntityId m_entity;
+    std::vector<CComponent*> m_components;  // Insertion order, owned by the storage pools
+    inline static uint32_t s_componentEpoch = 0;
 };
-
-
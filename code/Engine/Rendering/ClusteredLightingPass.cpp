@@ -14,6 +14,7 @@
 #include "Engine/Components/Transform.h"
 #include "Engine/Components/PointLight.h"
 #include "Engine/Components/SpotLight.h"
+#include <algorithm>
 #include <cmath>
 
 using namespace DirectX;
@@ -268,6 +269,9 @@ void CClusteredLightingPass::BuildClusterGrid(ICommandList* cmdList,
                                                float nearZ, float farZ) {
     if (!cmdList) return;
 
+    XMStoreFloat4x4(&m_lightCullProjection, projection);
+    m_hasLightCullProjection = true;
+
     // Use descriptor set path if available (DX12)
     if (IsDescriptorSetModeAvailable()) {
         BuildClusterGrid_DS(cmdList, projection, nearZ, farZ);
@@ -380,30 +384,48 @@ void CClusteredLightingPass::CullLights_DS(ICommandList* cmdList,
     if (!m_cullLightsPSO_ds || !m_perPassSet || !m_clusterAABBBuffer ||
         !m_clusterDataBuffer || !m_compactLightListBuffer || !m_globalCounterBuffer) return;
 
-    // Gather all lights (Point + Spot) from scene
+    // Gather lights (Point + Spot) whose range sphere touches the view frustum.
+    // Lights come from the scene spatial index; sorting keeps the GPU order
+    // stable (world order, point before spot) regardless of tree layout.
+    CSceneSpatialIndex& spatialIndex = scene->GetSpatialIndex();
+    spatialIndex.Update(scene->GetWorld());
+
+    std::vector<const SSpatialEntry*> visibleLights;
+    auto gatherLight = [&visibleLights](const SSpatialEntry& entry) {
+        visibleLights.push_back(&entry);
+        return true;
+    };
+    if (m_hasLightCullProjection) {
+        XMMATRIX viewProj = view * XMLoadFloat4x4(&m_lightCullProjection);
+        spatialIndex.QueryFrustum(SFrustumPlanes::FromViewProj(viewProj), SpatialCategory_Lights, gatherLight);
+    } else {
+        for (size_t i = 0; i < spatialIndex.GetEntryCount(); i++) {
+            const SSpatialEntry& entry = spatialIndex.GetEntry(i);
+            if (entry.category & SpatialCategory_Lights) gatherLight(entry);
+        }
+    }
+    std::sort(visibleLights.begin(), visibleLights.end(), [](const SSpatialEntry* a, const SSpatialEntry* b) {
+        return a->worldIndex != b->worldIndex ? a->worldIndex < b->worldIndex : a->category < b->category;
+    });
+
     std::vector<SGpuLight> gpuLights;
-    auto& world = scene->GetWorld();
-    for (auto& go : world.Objects()) {
-        auto* transform = go->GetComponent<STransform>();
-        if (!transform) continue;
-
-        // Check for Point Light
-        auto* pointLight = go->GetComponent<SPointLight>();
-        if (pointLight) {
+    gpuLights.reserve(visibleLights.size());
+    for (const SSpatialEntry* entry : visibleLights) {
+        const STransform* transform = entry->transform;
+
+        if (entry->category == SpatialCategory_PointLight) {
+            auto* pointLight = static_cast<const SPointLight*>(entry->component);
             SGpuLight gpuLight = {};
-            gpuLight.position = transform->position;
+            gpuLight.position = transform->GetWorldPosition();
             gpuLight.range = pointLight->range;
             gpuLight.color = pointLight->color;
             gpuLight.intensity = pointLight->intensity;
             gpuLight.type = (uint32_t)ELightType::Point;
             gpuLights.push_back(gpuLight);
-        }
-
-        // Check for Spot Light
-        auto* spotLight = go->GetComponent<SSpotLight>();
-        if (spotLight) {
+        } else {
+            auto* spotLight = static_cast<const SSpotLight*>(entry->component);
             SGpuLight gpuLight = {};
-            gpuLight.position = transform->position;
+            gpuLight.position = transform->GetWorldPosition();
             gpuLight.range = spotLight->range;
             gpuLight.color = spotLight->color;
             gpuLight.intensity = spotLight->intensity;
@@ -427,14 +449,17 @@ void CClusteredLightingPass::CullLights_DS(ICommandList* cmdList,
         }
     }
 
-    if (gpuLights.empty()) {
+    // Lights that exist but are all off-screen still dispatch (numLights = 0)
+    // so clusters do not keep last frame's light lists
+    if (gpuLights.empty() && !m_hadVisibleLights) {
         return;
     }
+    m_hadVisibleLights = !gpuLights.empty();
 
     CScopedDebugEvent evt(cmdList, L"ClusteredLighting CullLights (DS)");
 
     // Upload all lights to GPU
-    void* mapped = m_pointLightBuffer->Map();
+    void* mapped = gpuLights.empty() ? nullptr : m_pointLightBuffer->Map();
     if (mapped) {
         memcpy(mapped, gpuLights.data(), sizeof(SGpuLight) * gpuLights.size());
         m_pointLightBuffer->Unmap();
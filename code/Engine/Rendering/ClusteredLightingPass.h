@@ -166,6 +166,12 @@ private:
     float m_cachedFarZ = 0.0f;
     float m_cachedFovY = 0.0f;  // Field of view (from projection matrix)
     bool m_clusterGridDirty = true;  // Force rebuild on first frame
+
+    // Projection from the last BuildClusterGrid, used to frustum-cull lights
+    // on the CPU before upload
+    DirectX::XMFLOAT4X4 m_lightCullProjection;
+    bool m_hasLightCullProjection = false;
+    bool m_hadVisibleLights = false;
     bool m_initialized = false;
 
     // ============================================
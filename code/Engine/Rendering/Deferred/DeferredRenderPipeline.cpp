@@ -337,18 +337,38 @@ void CDeferredRenderPipeline::Render(const RenderContext& ctx)
     camera.SetTAAEnabled(taaActive);
     camera.SetJitterSampleCount(m_taaPass.GetSettings().jitter_samples);
 
+    // ============================================
+    // 1.6. Frustum Culling (camera + shadow cascades, one pass)
+    // ============================================
+    SDirectionalLight* dirLight = nullptr;
+    int cascadeCount = 0;
+    if (ctx.showFlags.Shadows) {
+        for (auto& objPtr : ctx.scene.GetWorld().Objects()) {
+            dirLight = objPtr->GetComponent<SDirectionalLight>();
+            if (dirLight) break;
+        }
+        if (dirLight) {
+            cascadeCount = m_shadowPass.PrepareCascades(dirLight,
+                                                        ctx.camera.GetViewMatrix(),
+                                                        ctx.camera.GetProjectionMatrix());
+        }
+    }
+    m_culler.Cull(ctx.scene, ctx.camera.GetViewMatrix() * ctx.camera.GetProjectionMatrix(),
+                  m_shadowPass.GetOutput().lightSpaceVPs, cascadeCount);
+    m_culler.ReportStats();
+
     // ============================================
     // 2. Depth Pre-Pass
     // ============================================
     {
-        m_depthPrePass.Render(ctx.camera, ctx.scene, m_gbuffer.GetDepthBuffer(), ctx.width, ctx.height);
+        m_depthPrePass.Render(ctx.camera, m_culler, m_gbuffer.GetDepthBuffer(), ctx.width, ctx.height);
     }
 
     // ============================================
     // 3. G-Buffer Pass
     // ============================================
     {
-        m_gbufferPass.Render(ctx.camera, ctx.scene, m_gbuffer, m_viewProjPrev,
+        m_gbufferPass.Render(ctx.camera, ctx.scene, m_culler, m_gbuffer, m_viewProjPrev,
                              ctx.width, ctx.height, m_perFrameSet);
     }
 
@@ -369,20 +389,10 @@ void CDeferredRenderPipeline::Render(const RenderContext& ctx)
     // 4. Shadow Pass (if enabled)
     // ============================================
     const CShadowPass::Output* shadowData = nullptr;
-    if (ctx.showFlags.Shadows) {
-        SDirectionalLight* dirLight = nullptr;
-        for (auto& objPtr : ctx.scene.GetWorld().Objects()) {
-            dirLight = objPtr->GetComponent<SDirectionalLight>();
-            if (dirLight) break;
-        }
-
-        if (dirLight) {
-            CScopedDebugEvent evt(cmdList, L"Shadow Pass");
-            m_shadowPass.Render(ctx.scene, dirLight,
-                               ctx.camera.GetViewMatrix(),
-                               ctx.camera.GetProjectionMatrix());
-            shadowData = &m_shadowPass.GetOutput();
-        }
+    if (dirLight) {
+        CScopedDebugEvent evt(cmdList, L"Shadow Pass");
+        m_shadowPass.Render(dirLight, m_culler);
+        shadowData = &m_shadowPass.GetOutput();
     }
 
     // ============================================
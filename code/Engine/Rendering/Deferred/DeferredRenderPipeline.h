@@ -7,6 +7,7 @@
 #include "DeferredLightingPass.h"
 #include "TransparentForwardPass.h"
 #include "Engine/Rendering/ShadowPass.h"
+#include "Engine/Rendering/FrustumCulling.h"
 #include "Engine/Rendering/ClusteredLightingPass.h"
 #include "Engine/Rendering/PostProcessPass.h"
 #include "Engine/Rendering/BloomPass.h"
@@ -103,6 +104,7 @@ private:
     // ============================================
     // Render Passes
     // ============================================
+    CSceneCuller m_culler;          // Camera + cascades, once per frame
     CDepthPrePass m_depthPrePass;
     CGBufferPass m_gbufferPass;
     CShadowPass m_shadowPass;
@@ -11,11 +11,13 @@
 #include "Core/PathManager.h"
 #include "Core/GpuMeshResource.h"
 #include "Core/Mesh.h"
+#include "Engine/Rendering/MeshVertexStreams.h"
 #include "Engine/Scene.h"
 #include "Engine/GameObject.h"
 #include "Engine/Camera.h"
 #include "Engine/Components/Transform.h"
 #include "Engine/Components/MeshRenderer.h"
+#include "Engine/Rendering/FrustumCulling.h"
 #include "Core/MaterialManager.h"
 #include <fstream>
 #include <sstream>
@@ -210,7 +212,7 @@ void CDepthPrePass::Shutdown()
 
 void CDepthPrePass::Render(
     const CCamera& camera,
-    CScene& scene,
+    const CSceneCuller& culler,
     RHI::ITexture* depthTarget,
     uint32_t width,
     uint32_t height)
@@ -251,22 +253,15 @@ void CDepthPrePass::Render(
     m_perPassSet->Bind(BindingSetItem::VolatileCBV(0, &passCB, sizeof(passCB)));
     cmdList->BindDescriptorSet(1, m_perPassSet);
 
-    // Render all opaque objects
-    for (auto& objPtr : scene.GetWorld().Objects()) {
-        auto* obj = objPtr.get();
-        auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
-        auto* transform = obj->GetComponent<STransform>();
+    // PSO follows the vertex layout of each mesh (full or packed)
+    EVertexLayout boundLayout = EVertexLayout::Full;
 
-        if (!meshRenderer || !transform) continue;
+    // Render all opaque objects inside the camera frustum
+    for (const SCullItem& item : culler.GetVisible(CULL_VIEW_CAMERA)) {
+        SMeshRenderer* meshRenderer = item.meshRenderer;
 
-        meshRenderer->EnsureUploaded();
-        if (meshRenderer->meshes.empty()) continue;
-
-        // Get material for alpha mode check
-        CMaterialAsset* material = CMaterialManager::Instance().GetDefault();
-        if (!meshRenderer->materialPath.empty()) {
-            material = CMaterialManager::Instance().Load(meshRenderer->materialPath);
-        }
+        // Material for alpha mode check (resolved by the render proxy table)
+        CMaterialAsset* material = item.material;
 
         // Skip transparent and alpha-tested objects
         if (material && (material->alphaMode == EAlphaMode::Blend ||
@@ -274,12 +269,12 @@ void CDepthPrePass::Render(
             continue;
         }
 
-        XMMATRIX worldMatrix = transform->WorldMatrix();
+        const XMMATRIX& worldMatrix = item.worldMatrix;
 
         // Bind PerDraw set (Set 3) with world matrix
         PerDrawSlots::CB_PerDraw perDraw;
         XMStoreFloat4x4(&perDraw.World, XMMatrixTranspose(worldMatrix));
-        XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(worldMatrix));
+        XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(item.prevWorldMatrix));
         perDraw.lightmapIndex = -1;  // Not used in depth pre-pass
         perDraw.objectID = 0;
 
@@ -290,9 +285,15 @@ void CDepthPrePass::Render(
         for (auto& gpuMesh : meshRenderer->meshes) {
             if (!gpuMesh) continue;
 
-            cmdList->SetVertexBuffer(0, gpuMesh->vbo.get(), sizeof(SVertexPNT), 0);
-            cmdList->SetIndexBuffer(gpuMesh->ibo.get(), EIndexFormat::UInt32, 0);
-            cmdList->DrawIndexed(gpuMesh->indexCount, 0, 0);
+            if (gpuMesh->layout != boundLayout) {
+                if (!bindVertexLayout(cmdList, gpuMesh->layout)) continue;
+                boundLayout = gpuMesh->layout;
+            }
+
+            // Must match the GBuffer LOD exactly for the depth-equal test
+            SGpuMeshLod lod = gpuMesh->GetLod(gpuMesh->SelectLod(item.lodMaxError));
+            MeshVertexStreams::BindPositions(cmdList, *gpuMesh);
+            cmdList->DrawIndexed(lod.indexCount, lod.firstIndex, 0);
         }
     }
 }
@@ -392,15 +393,8 @@ void CDepthPrePass::CreatePSOWithLayouts(IDescriptorSetLayout* perFrameLayout)
     psoDesc.vertexShader = m_depthVS_ds.get();
     psoDesc.pixelShader = nullptr;  // Depth-only, no pixel shader
 
-    // Input layout (same as legacy PSO)
-    psoDesc.inputLayout = {
-        { EVertexSemantic::Position, 0, EVertexFormat::Float3, 0, 0 },
-        { EVertexSemantic::Normal,   0, EVertexFormat::Float3, 12, 0 },
-        { EVertexSemantic::Texcoord, 0, EVertexFormat::Float2, 24, 0 },
-        { EVertexSemantic::Tangent,  0, EVertexFormat::Float4, 32, 0 },
-        { EVertexSemantic::Color,    0, EVertexFormat::Float4, 48, 0 },
-        { EVertexSemantic::Texcoord, 1, EVertexFormat::Float2, 64, 0 }
-    };
+    // Input layout: positions only (the packed variant is created below)
+    psoDesc.inputLayout = MeshVertexStreams::PositionLayout(EVertexLayout::Full);
 
     // Rasterizer state
     psoDesc.rasterizer.fillMode = EFillMode::Solid;
@@ -436,4 +430,25 @@ void CDepthPrePass::CreatePSOWithLayouts(IDescriptorSetLayout* perFrameLayout)
     } else {
         CFFLog::Error("[DepthPrePass] Failed to create PSO with descriptor set layouts");
     }
+
+    // Packed meshes: same shader, half4 position stream
+    psoDesc.inputLayout = MeshVertexStreams::PositionLayout(EVertexLayout::Packed);
+    psoDesc.debugName = "DepthPrePass_DS_Packed_PSO";
+    m_psoPacked_ds.reset(ctx->CreatePipelineState(psoDesc));
+    if (!m_psoPacked_ds) {
+        CFFLog::Warning("[DepthPrePass] Failed to create packed vertex PSO, packed meshes are skipped");
+    }
+}
+
+// Switches to the PSO for a mesh vertex layout. SetPipelineState re-sets the
+// root signature, so sets 1 and 3 are bound again.
+bool CDepthPrePass::bindVertexLayout(ICommandList* cmdList, EVertexLayout layout)
+{
+    IPipelineState* pso = layout == EVertexLayout::Packed ? m_psoPacked_ds.get() : m_pso_ds.get();
+    if (!pso) return false;
+
+    cmdList->SetPipelineState(pso);
+    cmdList->BindDescriptorSet(1, m_perPassSet);
+    cmdList->BindDescriptorSet(3, m_perDrawSet);
+    return true;
 }
@@ -4,10 +4,12 @@
 #include <DirectXMath.h>
 
 // Forward declarations
-class CScene;
 class CCamera;
+class CSceneCuller;
+enum class EVertexLayout : uint8_t;
 
 namespace RHI {
+    class ICommandList;
     class ITexture;
     class IDescriptorSetLayout;
     class IDescriptorSet;
@@ -46,12 +48,12 @@ public:
     // ============================================
     // Rendering
     // ============================================
-    // Render depth-only pass for all opaque objects
+    // Render depth-only pass for all opaque objects visible to the camera
     // depthTarget: The depth buffer to render to (typically GBuffer's depth)
     // width, height: Viewport dimensions
     void Render(
         const CCamera& camera,
-        CScene& scene,
+        const CSceneCuller& culler,
         RHI::ITexture* depthTarget,
         uint32_t width,
         uint32_t height
@@ -65,6 +67,7 @@ public:
 
 private:
     void initDescriptorSets();
+    bool bindVertexLayout(RHI::ICommandList* cmdList, EVertexLayout layout);
     // Depth-only vertex shader (no PS)
     RHI::ShaderPtr m_depthVS;
 
@@ -79,7 +82,8 @@ private:
     // Descriptor Set Resources (SM 5.1, DX12 only)
     // ============================================
     RHI::ShaderPtr m_depthVS_ds;
-    RHI::PipelineStatePtr m_pso_ds;
+    RHI::PipelineStatePtr m_pso_ds;         // Full vertex layout (position read from SVertexPNT)
+    RHI::PipelineStatePtr m_psoPacked_ds;   // Packed vertex layout (position stream only)
 
     // Descriptor set layouts
     RHI::IDescriptorSetLayout* m_perPassLayout = nullptr;
@@ -12,6 +12,7 @@
 #include "Core/PathManager.h"
 #include "Core/GpuMeshResource.h"
 #include "Core/Mesh.h"
+#include "Engine/Rendering/MeshVertexStreams.h"
 #include "Core/MaterialManager.h"
 #include "Core/TextureManager.h"
 #include "Engine/Scene.h"
@@ -19,6 +20,8 @@
 #include "Engine/Camera.h"
 #include "Engine/Components/Transform.h"
 #include "Engine/Components/MeshRenderer.h"
+#include "Engine/Rendering/FrustumCulling.h"
+#include "Core/Testing/RenderStats.h"
 #include <fstream>
 #include <sstream>
 
@@ -277,7 +280,7 @@ void CGBufferPass::initDescriptorSets()
         return;
     }
 
-    SCompiledShader vsCompiled = CompileShaderFromSource(vsSource.c_str(), "main", "vs_5_1", nullptr, debugShaders);
+    SCompiledShader vsCompiled = CompileShaderFromSource(vsSource.c_str(), "main", "vs_5_1", &includeHandler, debugShaders);
     if (!vsCompiled.success) {
         CFFLog::Error("[GBufferPass] GBuffer_DS.vs.hlsl compile error: %s", vsCompiled.errorMessage.c_str());
         return;
@@ -290,6 +293,18 @@ void CGBufferPass::initDescriptorSets()
     vsDesc.debugName = "GBuffer_DS_VS";
     m_vs_ds.reset(ctx->CreateShader(vsDesc));
 
+    // Packed vertex layout variant (optional, packed meshes are skipped without it)
+    std::string vsPackedSource = MeshVertexStreams::ShaderSource(vsSource, EVertexLayout::Packed);
+    SCompiledShader vsPackedCompiled = CompileShaderFromSource(vsPackedSource.c_str(), "main", "vs_5_1", &includeHandler, debugShaders);
+    if (vsPackedCompiled.success) {
+        vsDesc.bytecode = vsPackedCompiled.bytecode.data();
+        vsDesc.bytecodeSize = vsPackedCompiled.bytecode.size();
+        vsDesc.debugName = "GBuffer_DS_Packed_VS";
+        m_vsPacked_ds.reset(ctx->CreateShader(vsDesc));
+    } else {
+        CFFLog::Error("[GBufferPass] GBuffer_DS.vs.hlsl (PACKED_VERTEX) compile error: %s", vsPackedCompiled.errorMessage.c_str());
+    }
+
     // Compile SM 5.1 pixel shader
     std::string psSource = LoadShaderSource(shaderDir + "GBuffer_DS.ps.hlsl");
     if (psSource.empty()) {
@@ -407,15 +422,8 @@ void CGBufferPass::CreatePSOWithLayouts(IDescriptorSetLayout* perFrameLayout)
     psoDesc.vertexShader = m_vs_ds.get();
     psoDesc.pixelShader = m_ps_ds.get();
 
-    // Input layout (matches SVertexPNT)
-    psoDesc.inputLayout = {
-        { EVertexSemantic::Position, 0, EVertexFormat::Float3, 0, 0 },
-        { EVertexSemantic::Normal,   0, EVertexFormat::Float3, 12, 0 },
-        { EVertexSemantic::Texcoord, 0, EVertexFormat::Float2, 24, 0 },
-        { EVertexSemantic::Tangent,  0, EVertexFormat::Float4, 32, 0 },
-        { EVertexSemantic::Color,    0, EVertexFormat::Float4, 48, 0 },
-        { EVertexSemantic::Texcoord, 1, EVertexFormat::Float2, 64, 0 }
-    };
+    // Input layout (matches SVertexPNT, the packed variant is created below)
+    psoDesc.inputLayout = MeshVertexStreams::FullLayout();
 
     // Rasterizer state
     psoDesc.rasterizer.fillMode = EFillMode::Solid;
@@ -464,6 +472,31 @@ void CGBufferPass::CreatePSOWithLayouts(IDescriptorSetLayout* perFrameLayout)
     } else {
         CFFLog::Error("[GBufferPass] Failed to create PSO with descriptor set layouts");
     }
+
+    // Packed meshes: PACKED_VERTEX shader, two vertex streams
+    if (m_vsPacked_ds) {
+        psoDesc.vertexShader = m_vsPacked_ds.get();
+        psoDesc.inputLayout = MeshVertexStreams::PackedLayout();
+        psoDesc.debugName = "GBufferPass_DS_Packed_PSO";
+        m_psoPacked_ds.reset(ctx->CreatePipelineState(psoDesc));
+    }
+    if (!m_psoPacked_ds) {
+        CFFLog::Warning("[GBufferPass] No packed vertex PSO, packed meshes are skipped");
+    }
+}
+
+// Switches to the PSO for a mesh vertex layout and re-binds sets 1-3
+// (SetPipelineState re-sets the root signature).
+bool CGBufferPass::bindVertexLayout(ICommandList* cmdList, EVertexLayout layout)
+{
+    IPipelineState* pso = layout == EVertexLayout::Packed ? m_psoPacked_ds.get() : m_pso_ds.get();
+    if (!pso) return false;
+
+    cmdList->SetPipelineState(pso);
+    cmdList->BindDescriptorSet(1, m_perPassSet);
+    cmdList->BindDescriptorSet(2, m_perMaterialSet);
+    cmdList->BindDescriptorSet(3, m_perDrawSet);
+    return true;
 }
 
 // ============================================
@@ -472,6 +505,7 @@ void CGBufferPass::CreatePSOWithLayouts(IDescriptorSetLayout* perFrameLayout)
 void CGBufferPass::Render(
     const CCamera& camera,
     CScene& scene,
+    const CSceneCuller& culler,
     CGBuffer& gbuffer,
     const DirectX::XMMATRIX& viewProjPrev,
     uint32_t width,
@@ -545,22 +579,15 @@ void CGBufferPass::Render(
     }
     cmdList->BindDescriptorSet(1, m_perPassSet);
 
-    // Render all opaque objects
-    for (auto& objPtr : scene.GetWorld().Objects()) {
-        auto* obj = objPtr.get();
-        auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
-        auto* transform = obj->GetComponent<STransform>();
+    // PSO follows the vertex layout of each mesh (full or packed)
+    EVertexLayout boundLayout = EVertexLayout::Full;
 
-        if (!meshRenderer || !transform) continue;
+    // Render all opaque objects inside the camera frustum
+    for (const SCullItem& item : culler.GetVisible(CULL_VIEW_CAMERA)) {
+        SMeshRenderer* meshRenderer = item.meshRenderer;
 
-        meshRenderer->EnsureUploaded();
-        if (meshRenderer->meshes.empty()) continue;
-
-        // Get material
-        CMaterialAsset* material = CMaterialManager::Instance().GetDefault();
-        if (!meshRenderer->materialPath.empty()) {
-            material = CMaterialManager::Instance().Load(meshRenderer->materialPath);
-        }
+        // Material resolved by the render proxy table
+        CMaterialAsset* material = item.material;
 
         // Skip transparent objects
         if (material && material->alphaMode == EAlphaMode::Blend) {
@@ -603,11 +630,11 @@ void CGBufferPass::Render(
         cmdList->BindDescriptorSet(2, m_perMaterialSet);
 
         // Bind Set 3 (PerDraw)
-        XMMATRIX worldMatrix = transform->WorldMatrix();
+        const XMMATRIX& worldMatrix = item.worldMatrix;
 
         PerDrawSlots::CB_PerDraw perDraw;
         XMStoreFloat4x4(&perDraw.World, XMMatrixTranspose(worldMatrix));
-        XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(worldMatrix));  // TODO: Track previous frame
+        XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(item.prevWorldMatrix));
         perDraw.lightmapIndex = meshRenderer->lightmapInfosIndex;
         perDraw.objectID = 0;  // TODO: Add object ID to CGameObject
 
@@ -618,9 +645,17 @@ void CGBufferPass::Render(
         for (auto& gpuMesh : meshRenderer->meshes) {
             if (!gpuMesh) continue;
 
-            cmdList->SetVertexBuffer(0, gpuMesh->vbo.get(), sizeof(SVertexPNT), 0);
-            cmdList->SetIndexBuffer(gpuMesh->ibo.get(), EIndexFormat::UInt32, 0);
-            cmdList->DrawIndexed(gpuMesh->indexCount, 0, 0);
+            if (gpuMesh->layout != boundLayout) {
+                if (!bindVertexLayout(cmdList, gpuMesh->layout)) continue;
+                boundLayout = gpuMesh->layout;
+            }
+
+            // Same selection as DepthPrePass (depth-equal test)
+            uint32_t lodIndex = gpuMesh->SelectLod(item.lodMaxError);
+            SGpuMeshLod lod = gpuMesh->GetLod(lodIndex);
+            MeshVertexStreams::Bind(cmdList, *gpuMesh);
+            cmdList->DrawIndexed(lod.indexCount, lod.firstIndex, 0);
+            CRenderStats::Instance().RecordLodDraw(false, (int)lodIndex, (int)(lod.indexCount / 3));
         }
     }
 
@@ -7,8 +7,11 @@
 // Forward declarations
 class CScene;
 class CCamera;
+class CSceneCuller;
+enum class EVertexLayout : uint8_t;
 
 namespace RHI {
+    class ICommandList;
     class IDescriptorSetLayout;
     class IDescriptorSet;
 }
@@ -57,6 +60,7 @@ public:
     void Render(
         const CCamera& camera,
         CScene& scene,
+        const CSceneCuller& culler,
         CGBuffer& gbuffer,
         const DirectX::XMMATRIX& viewProjPrev,
         uint32_t width,
@@ -75,6 +79,7 @@ public:
 
 private:
     void initDescriptorSets();
+    bool bindVertexLayout(RHI::ICommandList* cmdList, EVertexLayout layout);
 
     // ============================================
     // Legacy Resources (SM 5.0)
@@ -88,8 +93,10 @@ private:
     // Descriptor Set Resources (SM 5.1, DX12 only)
     // ============================================
     RHI::ShaderPtr m_vs_ds;
+    RHI::ShaderPtr m_vsPacked_ds;           // PACKED_VERTEX variant
     RHI::ShaderPtr m_ps_ds;
-    RHI::PipelineStatePtr m_pso_ds;
+    RHI::PipelineStatePtr m_pso_ds;         // Full vertex layout
+    RHI::PipelineStatePtr m_psoPacked_ds;   // Packed vertex layout
 
     // Descriptor set layouts
     RHI::IDescriptorSetLayout* m_perPassLayout = nullptr;
@@ -12,6 +12,7 @@
 #include "Core/MaterialManager.h"
 #include "Core/TextureManager.h"
 #include "Core/Mesh.h"
+#include "Engine/Rendering/MeshVertexStreams.h"
 #include "Engine/Scene.h"
 #include "Engine/Camera.h"
 #include "Engine/GameObject.h"
@@ -21,7 +22,10 @@
 #include "Engine/Rendering/ClusteredLightingPass.h"
 #include "Engine/Rendering/ReflectionProbeManager.h"
 #include "Engine/Rendering/VolumetricLightmap.h"
+#include "Engine/Rendering/MeshLod.h"
+#include "Core/Testing/RenderStats.h"
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <sstream>
 
@@ -39,6 +43,8 @@ struct TransparentItem {
     XMMATRIX worldMatrix;
     float distanceToCamera;
     GpuMeshResource* gpuMesh;
+    SGpuMeshLod lod;
+    int lodIndex;
     ITexture* albedoTex;
     ITexture* normalTex;
     ITexture* metallicRoughnessTex;
@@ -49,6 +55,17 @@ struct TransparentItem {
     int lightmapIndex;
 };
 
+// Not culled, so the LOD budget the culler gives opaque items is computed here
+float transparentLodError(const MeshLod::SView& view, const CRenderProxyTable& proxies, size_t proxyIndex,
+                          const XMMATRIX& worldMatrix) {
+    const SCullBounds& bounds = proxies.GetBounds();
+    XMFLOAT3 center(bounds.centerX[proxyIndex], bounds.centerY[proxyIndex], bounds.centerZ[proxyIndex]);
+    float radius = std::sqrt(bounds.extentX[proxyIndex] * bounds.extentX[proxyIndex] +
+                             bounds.extentY[proxyIndex] * bounds.extentY[proxyIndex] +
+                             bounds.extentZ[proxyIndex] * bounds.extentZ[proxyIndex]);
+    return MeshLod::MaxError(view, center, radius, worldMatrix);
+}
+
 // CB_Frame structure (must match MainPass.ps.hlsl)
 struct alignas(16) CB_Frame {
     XMMATRIX view;
@@ -120,8 +137,10 @@ void CTransparentForwardPass::Shutdown()
 
     // Cleanup DS resources
     m_vs_ds.reset();
+    m_vsPacked_ds.reset();
     m_ps_ds.reset();
     m_pso_ds.reset();
+    m_psoPacked_ds.reset();
 
     auto* ctx = CRHIManager::Instance().GetRenderContext();
     if (ctx) {
@@ -297,6 +316,9 @@ void CTransparentForwardPass::Render(
     // ============================================
     std::vector<TransparentItem> transparentItems;
     XMVECTOR eye = XMLoadFloat3(&camera.position);
+    const SMeshLodSettings& lodSettings = MeshLod::Settings();
+    MeshLod::SView lodView = MeshLod::MakeView(camera.GetViewMatrix() * camera.GetProjectionMatrix(),
+                                               lodSettings.enabled ? lodSettings.screenError : 0.0f);
 
     auto& probeManager = scene.GetProbeManager();
     CTextureManager& texMgr = CTextureManager::Instance();
@@ -304,26 +326,22 @@ void CTransparentForwardPass::Render(
     ITexture* defaultNormal = texMgr.GetDefaultNormal().get();
     ITexture* defaultBlack = texMgr.GetDefaultBlack().get();
 
-    for (auto& objPtr : scene.GetWorld().Objects()) {
-        auto* obj = objPtr.get();
-        auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
-        auto* transform = obj->GetComponent<STransform>();
+    // Proxies are refreshed by the pipeline's culling stage earlier this frame
+    const CRenderProxyTable& proxies = scene.GetRenderProxies();
+    for (size_t proxyIndex = 0; proxyIndex < proxies.Size(); proxyIndex++) {
+        if (!proxies.IsDrawable(proxyIndex)) continue;
 
-        if (!meshRenderer || !transform) continue;
+        auto* obj = proxies.GetGameObject(proxyIndex);
+        auto* meshRenderer = proxies.GetMeshRenderer(proxyIndex);
+        auto* transform = proxies.GetTransform(proxyIndex);
 
-        meshRenderer->EnsureUploaded();
-
-        // Get material via MaterialManager
-        CMaterialAsset* material = CMaterialManager::Instance().GetDefault();
-        if (!meshRenderer->materialPath.empty()) {
-            material = CMaterialManager::Instance().Load(meshRenderer->materialPath);
-        }
+        CMaterialAsset* material = proxies.GetMaterial(proxyIndex);
         if (!material) continue;
 
         // Only collect transparent objects
         if (material->alphaMode != EAlphaMode::Blend) continue;
 
-        XMMATRIX worldMatrix = transform->WorldMatrix();
+        XMMATRIX worldMatrix = proxies.GetWorldMatrix(proxyIndex);
         XMVECTOR objPos = worldMatrix.r[3];
         float distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(objPos, eye)));
 
@@ -344,6 +362,7 @@ void CTransparentForwardPass::Render(
         XMFLOAT3 worldPos;
         XMStoreFloat3(&worldPos, objPos);
         int probeIndex = probeManager.SelectProbeForPosition(worldPos);
+        float lodMaxError = transparentLodError(lodView, proxies, proxyIndex, worldMatrix);
 
         // Collect each mesh
         for (auto& gpuMesh : meshRenderer->meshes) {
@@ -357,6 +376,8 @@ void CTransparentForwardPass::Render(
             item.worldMatrix = worldMatrix;
             item.distanceToCamera = distance;
             item.gpuMesh = gpuMesh.get();
+            item.lodIndex = (int)gpuMesh->SelectLod(lodMaxError);
+            item.lod = gpuMesh->GetLod((uint32_t)item.lodIndex);
             item.albedoTex = albedoTex ? albedoTex : defaultWhite;
             item.normalTex = normalTex ? normalTex : defaultNormal;
             item.metallicRoughnessTex = metallicRoughnessTex ? metallicRoughnessTex : defaultWhite;
@@ -460,7 +481,15 @@ void CTransparentForwardPass::Render(
     // ============================================
     // Render each transparent item
     // ============================================
+    // PSO follows the vertex layout of each mesh (full or packed)
+    EVertexLayout boundLayout = EVertexLayout::Full;
+
     for (const auto& item : transparentItems) {
+        if (item.gpuMesh->layout != boundLayout) {
+            if (!bindVertexLayout(cmdList, item.gpuMesh->layout, nullptr)) continue;
+            boundLayout = item.gpuMesh->layout;
+        }
+
         // Update per-object constants (PerMaterial CB)
         CB_Object co{};
         co.world = XMMatrixTranspose(item.worldMatrix);
@@ -487,9 +516,9 @@ void CTransparentForwardPass::Render(
         cmdList->BindDescriptorSet(2, m_perMaterialSet);
 
         // Bind vertex/index buffers and draw
-        cmdList->SetVertexBuffer(0, item.gpuMesh->vbo.get(), sizeof(SVertexPNT), 0);
-        cmdList->SetIndexBuffer(item.gpuMesh->ibo.get(), EIndexFormat::UInt32, 0);
-        cmdList->DrawIndexed(item.gpuMesh->indexCount, 0, 0);
+        MeshVertexStreams::Bind(cmdList, *item.gpuMesh);
+        cmdList->DrawIndexed(item.lod.indexCount, item.lod.firstIndex, 0);
+        CRenderStats::Instance().RecordLodDraw(false, item.lodIndex, (int)(item.lod.indexCount / 3));
     }
 }
 
@@ -544,6 +573,18 @@ void CTransparentForwardPass::initDescriptorSets()
     vsDesc.debugName = "TransparentForward_DS_VS";
     m_vs_ds.reset(ctx->CreateShader(vsDesc));
 
+    // Packed vertex layout variant (optional, packed meshes are skipped without it)
+    std::string vsPackedSource = MeshVertexStreams::ShaderSource(vsSource, EVertexLayout::Packed);
+    SCompiledShader vsPackedCompiled = CompileShaderFromSource(vsPackedSource.c_str(), "main", "vs_5_1", &includeHandler, debugShaders);
+    if (vsPackedCompiled.success) {
+        vsDesc.bytecode = vsPackedCompiled.bytecode.data();
+        vsDesc.bytecodeSize = vsPackedCompiled.bytecode.size();
+        vsDesc.debugName = "TransparentForward_DS_Packed_VS";
+        m_vsPacked_ds.reset(ctx->CreateShader(vsDesc));
+    } else {
+        CFFLog::Error("[TransparentForwardPass] MainPass_DS.vs.hlsl (PACKED_VERTEX) compile error: %s", vsPackedCompiled.errorMessage.c_str());
+    }
+
     ShaderDesc psDesc;
     psDesc.type = EShaderType::Pixel;
     psDesc.bytecode = psCompiled.bytecode.data();
@@ -614,21 +655,12 @@ void CTransparentForwardPass::CreatePSOWithLayouts(IDescriptorSetLayout* perFram
     IRenderContext* ctx = CRHIManager::Instance().GetRenderContext();
     if (!ctx) return;
 
-    // Input layout (matches SVertexPNT)
-    std::vector<VertexElement> inputLayout = {
-        { EVertexSemantic::Position, 0, EVertexFormat::Float3, 0, 0 },
-        { EVertexSemantic::Normal,   0, EVertexFormat::Float3, 12, 0 },
-        { EVertexSemantic::Texcoord, 0, EVertexFormat::Float2, 24, 0 },
-        { EVertexSemantic::Tangent,  0, EVertexFormat::Float4, 32, 0 },
-        { EVertexSemantic::Color,    0, EVertexFormat::Float4, 48, 0 },
-        { EVertexSemantic::Texcoord, 1, EVertexFormat::Float2, 64, 0 }  // UV2 for lightmap
-    };
-
     // Transparent PSO: depth read-only, alpha blending
+    // Input layout matches SVertexPNT; the packed variant is created below
     PipelineStateDesc psoDesc;
     psoDesc.vertexShader = m_vs_ds.get();
     psoDesc.pixelShader = m_ps_ds.get();
-    psoDesc.inputLayout = inputLayout;
+    psoDesc.inputLayout = MeshVertexStreams::FullLayout();
     psoDesc.rasterizer.fillMode = EFillMode::Solid;
     psoDesc.rasterizer.cullMode = ECullMode::Back;
     psoDesc.rasterizer.frontCounterClockwise = false;
@@ -665,6 +697,32 @@ void CTransparentForwardPass::CreatePSOWithLayouts(IDescriptorSetLayout* perFram
     } else {
         CFFLog::Error("[TransparentForwardPass] Failed to create PSO with descriptor set layouts");
     }
+
+    // Packed meshes: PACKED_VERTEX shader, two vertex streams
+    if (m_vsPacked_ds) {
+        psoDesc.vertexShader = m_vsPacked_ds.get();
+        psoDesc.inputLayout = MeshVertexStreams::PackedLayout();
+        psoDesc.debugName = "TransparentForward_DS_Packed_PSO";
+        m_psoPacked_ds.reset(ctx->CreatePipelineState(psoDesc));
+    }
+    if (!m_psoPacked_ds) {
+        CFFLog::Warning("[TransparentForwardPass] No packed vertex PSO, packed meshes are skipped");
+    }
+}
+
+// Switches to the PSO for a mesh vertex layout. Frame and pass sets are bound
+// again; the per-material set follows per item.
+bool CTransparentForwardPass::bindVertexLayout(ICommandList* cmdList, EVertexLayout layout, IDescriptorSet* perFrameSet)
+{
+    IPipelineState* pso = layout == EVertexLayout::Packed ? m_psoPacked_ds.get() : m_pso_ds.get();
+    if (!pso) return false;
+
+    cmdList->SetPipelineState(pso);
+    if (perFrameSet) {
+        cmdList->BindDescriptorSet(0, perFrameSet);
+    }
+    cmdList->BindDescriptorSet(1, m_perPassSet);
+    return true;
 }
 
 // ============================================
@@ -697,6 +755,9 @@ void CTransparentForwardPass::Render(
     // ============================================
     std::vector<TransparentItem> transparentItems;
     XMVECTOR eye = XMLoadFloat3(&camera.position);
+    const SMeshLodSettings& lodSettings = MeshLod::Settings();
+    MeshLod::SView lodView = MeshLod::MakeView(camera.GetViewMatrix() * camera.GetProjectionMatrix(),
+                                               lodSettings.enabled ? lodSettings.screenError : 0.0f);
 
     auto& probeManager = scene.GetProbeManager();
     CTextureManager& texMgr = CTextureManager::Instance();
@@ -704,26 +765,22 @@ void CTransparentForwardPass::Render(
     ITexture* defaultNormal = texMgr.GetDefaultNormal().get();
     ITexture* defaultBlack = texMgr.GetDefaultBlack().get();
 
-    for (auto& objPtr : scene.GetWorld().Objects()) {
-        auto* obj = objPtr.get();
-        auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
-        auto* transform = obj->GetComponent<STransform>();
-
-        if (!meshRenderer || !transform) continue;
+    // Proxies are refreshed by the pipeline's culling stage earlier this frame
+    const CRenderProxyTable& proxies = scene.GetRenderProxies();
+    for (size_t proxyIndex = 0; proxyIndex < proxies.Size(); proxyIndex++) {
+        if (!proxies.IsDrawable(proxyIndex)) continue;
 
-        meshRenderer->EnsureUploaded();
+        auto* obj = proxies.GetGameObject(proxyIndex);
+        auto* meshRenderer = proxies.GetMeshRenderer(proxyIndex);
+        auto* transform = proxies.GetTransform(proxyIndex);
 
-        // Get material via MaterialManager
-        CMaterialAsset* material = CMaterialManager::Instance().GetDefault();
-        if (!meshRenderer->materialPath.empty()) {
-            material = CMaterialManager::Instance().Load(meshRenderer->materialPath);
-        }
+        CMaterialAsset* material = proxies.GetMaterial(proxyIndex);
         if (!material) continue;
 
         // Only collect transparent objects
         if (material->alphaMode != EAlphaMode::Blend) continue;
 
-        XMMATRIX worldMatrix = transform->WorldMatrix();
+        XMMATRIX worldMatrix = proxies.GetWorldMatrix(proxyIndex);
         XMVECTOR objPos = worldMatrix.r[3];
         float distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(objPos, eye)));
 
@@ -744,6 +801,7 @@ void CTransparentForwardPass::Render(
         XMFLOAT3 worldPos;
         XMStoreFloat3(&worldPos, objPos);
         int probeIndex = probeManager.SelectProbeForPosition(worldPos);
+        float lodMaxError = transparentLodError(lodView, proxies, proxyIndex, worldMatrix);
 
         // Collect each mesh
         for (auto& gpuMesh : meshRenderer->meshes) {
@@ -757,6 +815,8 @@ void CTransparentForwardPass::Render(
             item.worldMatrix = worldMatrix;
             item.distanceToCamera = distance;
             item.gpuMesh = gpuMesh.get();
+            item.lodIndex = (int)gpuMesh->SelectLod(lodMaxError);
+            item.lod = gpuMesh->GetLod((uint32_t)item.lodIndex);
             item.albedoTex = albedoTex ? albedoTex : defaultWhite;
             item.normalTex = normalTex ? normalTex : defaultNormal;
             item.metallicRoughnessTex = metallicRoughnessTex ? metallicRoughnessTex : defaultWhite;
@@ -865,7 +925,15 @@ void CTransparentForwardPass::Render(
     // ============================================
     // Render each transparent item
     // ============================================
+    // PSO follows the vertex layout of each mesh (full or packed)
+    EVertexLayout boundLayout = EVertexLayout::Full;
+
     for (const auto& item : transparentItems) {
+        if (item.gpuMesh->layout != boundLayout) {
+            if (!bindVertexLayout(cmdList, item.gpuMesh->layout, perFrameSet)) continue;
+            boundLayout = item.gpuMesh->layout;
+        }
+
         // Update per-object constants (PerMaterial CB)
         CB_Object co{};
         co.world = XMMatrixTranspose(item.worldMatrix);
@@ -892,8 +960,8 @@ void CTransparentForwardPass::Render(
         cmdList->BindDescriptorSet(2, m_perMaterialSet);
 
         // Bind vertex/index buffers and draw
-        cmdList->SetVertexBuffer(0, item.gpuMesh->vbo.get(), sizeof(SVertexPNT), 0);
-        cmdList->SetIndexBuffer(item.gpuMesh->ibo.get(), EIndexFormat::UInt32, 0);
-        cmdList->DrawIndexed(item.gpuMesh->indexCount, 0, 0);
+        MeshVertexStreams::Bind(cmdList, *item.gpuMesh);
+        cmdList->DrawIndexed(item.lod.indexCount, item.lod.firstIndex, 0);
+        CRenderStats::Instance().RecordLodDraw(false, item.lodIndex, (int)(item.lod.indexCount / 3));
     }
 }
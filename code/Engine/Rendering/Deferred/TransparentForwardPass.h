@@ -7,8 +7,10 @@
 class CCamera;
 class CScene;
 class CClusteredLightingPass;
+enum class EVertexLayout : uint8_t;
 
 namespace RHI {
+    class ICommandList;
     class IDescriptorSetLayout;
     class IDescriptorSet;
 }
@@ -95,13 +97,16 @@ private:
     // Descriptor Set Resources (SM 5.1, DX12 only)
     // ============================================
     void initDescriptorSets();
+    bool bindVertexLayout(RHI::ICommandList* cmdList, EVertexLayout layout, RHI::IDescriptorSet* perFrameSet);
 
     // SM 5.1 shaders
     RHI::ShaderPtr m_vs_ds;
+    RHI::ShaderPtr m_vsPacked_ds;   // PACKED_VERTEX variant
     RHI::ShaderPtr m_ps_ds;
 
-    // SM 5.1 PSO
+    // SM 5.1 PSOs, one per mesh vertex layout
     RHI::PipelineStatePtr m_pso_ds;
+    RHI::PipelineStatePtr m_psoPacked_ds;
 
     // Descriptor set layout and set for PerPass (Set 1, space1)
     RHI::IDescriptorSetLayout* m_perPassLayout = nullptr;
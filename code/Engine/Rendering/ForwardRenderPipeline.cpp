@@ -82,24 +82,34 @@ void CForwardRenderPipeline::Render(const RenderContext& ctx)
     // 3. Shadow Pass (if enabled)
     // ============================================
     const CShadowPass::Output* shadowData = nullptr;
+    SDirectionalLight* dirLight = nullptr;
+    int cascadeCount = 0;
     // Shadow Pass disabled for DX12 until debugging is complete
     if (ctx.showFlags.Shadows) {
         // Find DirectionalLight in scene
-        SDirectionalLight* dirLight = nullptr;
         for (auto& objPtr : ctx.scene.GetWorld().Objects()) {
             dirLight = objPtr->GetComponent<SDirectionalLight>();
             if (dirLight) break;
         }
 
         if (dirLight) {
-            RHI::CScopedDebugEvent evt(cmdList, L"Shadow Pass");
-            m_shadowPass.Render(ctx.scene, dirLight,
-                              ctx.camera.GetViewMatrix(),
-                              ctx.camera.GetProjectionMatrix());
-            shadowData = &m_shadowPass.GetOutput();
+            cascadeCount = m_shadowPass.PrepareCascades(dirLight,
+                                                        ctx.camera.GetViewMatrix(),
+                                                        ctx.camera.GetProjectionMatrix());
         }
     }
 
+    // Camera + shadow cascades culled in one pass
+    m_culler.Cull(ctx.scene, ctx.camera.GetViewMatrix() * ctx.camera.GetProjectionMatrix(),
+                  m_shadowPass.GetOutput().lightSpaceVPs, cascadeCount);
+    m_culler.ReportStats();
+
+    if (dirLight) {
+        RHI::CScopedDebugEvent evt(cmdList, L"Shadow Pass");
+        m_shadowPass.Render(dirLight, m_culler);
+        shadowData = &m_shadowPass.GetOutput();
+    }
+
     // ============================================
     // 4. Clear HDR render target
     // ============================================
@@ -124,7 +134,7 @@ void CForwardRenderPipeline::Render(const RenderContext& ctx)
         m_sceneRenderer.Render(ctx.camera, ctx.scene,
                               m_offHDR.get(), m_offDepth.get(),
                               ctx.width, ctx.height, ctx.deltaTime,
-                              shadowData, clusteredPass, nullptr, nullptr);
+                              shadowData, clusteredPass, nullptr, nullptr, &m_culler);
     }
 
     // ============================================
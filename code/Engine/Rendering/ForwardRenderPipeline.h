@@ -67,6 +67,7 @@ private:
     CClusteredLightingPass m_clusteredLighting;
     CShadowPass m_shadowPass;
     CSceneRenderer m_sceneRenderer;
+    CSceneCuller m_culler;          // Camera + cascades, once per frame
     CDebugLinePass m_debugLinePass;
     CPostProcessPass m_postProcess;
 
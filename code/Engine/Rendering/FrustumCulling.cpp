@@ -0,0 +1,300 @@
+#include "FrustumCulling.h"
+#include "RenderProxy.h"
+#include "MeshLod.h"
+#include "Engine/Scene.h"
+#include "Core/Testing/RenderStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#if FF_CULL_SIMD
+#include <emmintrin.h>
+#endif
+
+using namespace DirectX;
+
+// ============================================
+// SFrustumPlanes
+// ============================================
+
+SFrustumPlanes SFrustumPlanes::FromViewProj(const XMMATRIX& viewProj)
+{
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, viewProj);
+
+    // Row-vector convention: clip = p * M, so plane coefficients come from columns
+    auto column = [&m](int c) {
+        return XMFLOAT4(m.m[0][c], m.m[1][c], m.m[2][c], m.m[3][c]);
+    };
+    XMFLOAT4 c0 = column(0), c1 = column(1), c2 = column(2), c3 = column(3);
+
+    SFrustumPlanes result;
+    result.planes[0] = {c3.x + c0.x, c3.y + c0.y, c3.z + c0.z, c3.w + c0.w};   // Left   (-w <= x)
+    result.planes[1] = {c3.x - c0.x, c3.y - c0.y, c3.z - c0.z, c3.w - c0.w};   // Right  (x <= w)
+    result.planes[2] = {c3.x + c1.x, c3.y + c1.y, c3.z + c1.z, c3.w + c1.w};   // Bottom (-w <= y)
+    result.planes[3] = {c3.x - c1.x, c3.y - c1.y, c3.z - c1.z, c3.w - c1.w};   // Top    (y <= w)
+    result.planes[4] = c2;                                                      // 0 <= z
+    result.planes[5] = {c3.x - c2.x, c3.y - c2.y, c3.z - c2.z, c3.w - c2.w};   // z <= w
+
+    for (auto& p : result.planes) {
+        float len = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (len > 1e-12f) {
+            p = {p.x / len, p.y / len, p.z / len, p.w / len};
+        } else {
+            p = {0.0f, 0.0f, 0.0f, 1.0f};   // Degenerate (e.g. infinite far plane): always inside
+        }
+    }
+    return result;
+}
+
+// ============================================
+// SCullBounds
+// ============================================
+
+void SCullBounds::Clear()
+{
+    centerX.clear(); centerY.clear(); centerZ.clear();
+    extentX.clear(); extentY.clear(); extentZ.clear();
+}
+
+void SCullBounds::Reserve(size_t count)
+{
+    centerX.reserve(count); centerY.reserve(count); centerZ.reserve(count);
+    extentX.reserve(count); extentY.reserve(count); extentZ.reserve(count);
+}
+
+void SCullBounds::Resize(size_t count)
+{
+    centerX.resize(count); centerY.resize(count); centerZ.resize(count);
+    extentX.resize(count); extentY.resize(count); extentZ.resize(count);
+}
+
+void SCullBounds::Add(const XMFLOAT3& center, const XMFLOAT3& extent)
+{
+    centerX.push_back(center.x); centerY.push_back(center.y); centerZ.push_back(center.z);
+    extentX.push_back(extent.x); extentY.push_back(extent.y); extentZ.push_back(extent.z);
+}
+
+void SCullBounds::Set(size_t index, const XMFLOAT3& center, const XMFLOAT3& extent)
+{
+    centerX[index] = center.x; centerY[index] = center.y; centerZ[index] = center.z;
+    extentX[index] = extent.x; extentY[index] = extent.y; extentZ[index] = extent.z;
+}
+
+void SCullBounds::AddTransformed(const XMFLOAT3& localMin, const XMFLOAT3& localMax, const XMMATRIX& world)
+{
+    Resize(Size() + 1);
+    SetTransformed(Size() - 1, localMin, localMax, world);
+}
+
+void SCullBounds::SetTransformed(size_t index, const XMFLOAT3& localMin, const XMFLOAT3& localMax,
+                                 const XMMATRIX& world)
+{
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, world);
+
+    const float lc[3] = {
+        (localMin.x + localMax.x) * 0.5f, (localMin.y + localMax.y) * 0.5f, (localMin.z + localMax.z) * 0.5f
+    };
+    const float le[3] = {
+        (localMax.x - localMin.x) * 0.5f, (localMax.y - localMin.y) * 0.5f, (localMax.z - localMin.z) * 0.5f
+    };
+
+    // center' = c * M,  extent'_j = sum_i |M[i][j]| * e_i
+    float wc[3], we[3];
+    for (int j = 0; j < 3; j++) {
+        wc[j] = m.m[3][j];
+        we[j] = 0.0f;
+        for (int i = 0; i < 3; i++) {
+            wc[j] += lc[i] * m.m[i][j];
+            we[j] += le[i] * std::fabs(m.m[i][j]);
+        }
+    }
+    Set(index, {wc[0], wc[1], wc[2]}, {we[0], we[1], we[2]});
+}
+
+// ============================================
+// Kernels
+// ============================================
+
+namespace
+{
+    void cullScalar(const SCullBounds& b, size_t begin, size_t end,
+                    const SFrustumPlanes* frusta, int frustumCount, uint8_t* outMasks)
+    {
+        for (size_t i = begin; i < end; i++) {
+            uint8_t mask = 0;
+            for (int v = 0; v < frustumCount; v++) {
+                bool inside = true;
+                for (const XMFLOAT4& p : frusta[v].planes) {
+                    float d = p.x * b.centerX[i] + p.y * b.centerY[i] + p.z * b.centerZ[i] + p.w;
+                    float r = std::fabs(p.x) * b.extentX[i] + std::fabs(p.y) * b.extentY[i] + std::fabs(p.z) * b.extentZ[i];
+                    if (d + r < 0.0f) {
+                        inside = false;
+                        break;
+                    }
+                }
+                if (inside) mask |= (uint8_t)(1u << v);
+            }
+            outMasks[i] = mask;
+        }
+    }
+
+#if FF_CULL_SIMD
+    // 4 objects per iteration; returns the first index not processed
+    size_t cullSIMD(const SCullBounds& b, size_t count,
+                    const SFrustumPlanes* frusta, int frustumCount, uint8_t* outMasks)
+    {
+        // Broadcast planes once: [view][plane] -> n, |n|, w
+        struct SPlane4 { __m128 nx, ny, nz, ax, ay, az, w; };
+        SPlane4 planes[CULL_MAX_VIEWS][6];
+        for (int v = 0; v < frustumCount; v++) {
+            for (int k = 0; k < 6; k++) {
+                const XMFLOAT4& p = frusta[v].planes[k];
+                planes[v][k] = {
+                    _mm_set1_ps(p.x), _mm_set1_ps(p.y), _mm_set1_ps(p.z),
+                    _mm_set1_ps(std::fabs(p.x)), _mm_set1_ps(std::fabs(p.y)), _mm_set1_ps(std::fabs(p.z)),
+                    _mm_set1_ps(p.w)
+                };
+            }
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 cx = _mm_loadu_ps(&b.centerX[i]);
+            __m128 cy = _mm_loadu_ps(&b.centerY[i]);
+            __m128 cz = _mm_loadu_ps(&b.centerZ[i]);
+            __m128 ex = _mm_loadu_ps(&b.extentX[i]);
+            __m128 ey = _mm_loadu_ps(&b.extentY[i]);
+            __m128 ez = _mm_loadu_ps(&b.extentZ[i]);
+
+            uint32_t laneMasks[4] = {0, 0, 0, 0};
+            for (int v = 0; v < frustumCount; v++) {
+                __m128 outside = zero;
+                for (int k = 0; k < 6; k++) {
+                    const SPlane4& p = planes[v][k];
+                    // Same association order as the scalar kernel
+                    __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(p.nx, cx), _mm_mul_ps(p.ny, cy)),
+                                                     _mm_mul_ps(p.nz, cz)), p.w);
+                    __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p.ax, ex), _mm_mul_ps(p.ay, ey)),
+                                          _mm_mul_ps(p.az, ez));
+                    outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), zero));
+                }
+                int insideBits = ~_mm_movemask_ps(outside) & 0xF;
+                for (int lane = 0; lane < 4; lane++) {
+                    if (insideBits & (1 << lane)) laneMasks[lane] |= 1u << v;
+                }
+            }
+            for (int lane = 0; lane < 4; lane++) {
+                outMasks[i + lane] = (uint8_t)laneMasks[lane];
+            }
+        }
+        return i;
+    }
+#endif
+}
+
+void FrustumCulling::CullBounds(const SCullBounds& bounds, const SFrustumPlanes* frusta, int frustumCount,
+                                uint8_t* outMasks, ECullKernel kernel)
+{
+    frustumCount = std::min(frustumCount, CULL_MAX_VIEWS);
+    const size_t count = bounds.Size();
+    size_t begin = 0;
+
+#if FF_CULL_SIMD
+    if (kernel == ECullKernel::SIMD) {
+        begin = cullSIMD(bounds, count, frusta, frustumCount, outMasks);
+    }
+#endif
+
+    // Scalar kernel, or the SIMD tail (< 4 objects)
+    cullScalar(bounds, begin, count, frusta, frustumCount, outMasks);
+}
+
+// ============================================
+// CSceneCuller
+// ============================================
+
+void CSceneCuller::Cull(CScene& scene, const XMMATRIX& cameraViewProj,
+                        const XMMATRIX* cascadeViewProjs, int cascadeCount)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    cascadeCount = cascadeViewProjs ? std::clamp(cascadeCount, 0, MAX_CASCADES) : 0;
+    m_viewCount = 1 + cascadeCount;
+
+    // Refresh dirty proxies (world matrices, bounds, materials)
+    CRenderProxyTable& proxies = scene.GetRenderProxies();
+    proxies.Update(scene.GetWorld());
+
+    // One pass over all bounds for every view
+    SFrustumPlanes frusta[CULL_MAX_VIEWS];
+    frusta[CULL_VIEW_CAMERA] = SFrustumPlanes::FromViewProj(cameraViewProj);
+    for (int c = 0; c < cascadeCount; c++) {
+        frusta[CULL_VIEW_CASCADE0 + c] = SFrustumPlanes::FromViewProj(cascadeViewProjs[c]);
+    }
+
+    m_masks.resize(proxies.Size());
+    FrustumCulling::CullBounds(proxies.GetBounds(), frusta, m_viewCount, m_masks.data());
+
+    for (int v = 0; v < CULL_MAX_VIEWS; v++) {
+        m_visible[v].clear();
+    }
+
+    // LOD budgets come from the camera for every view (cascades scaled by shadowBias)
+    const SMeshLodSettings& lodSettings = MeshLod::Settings();
+    MeshLod::SView lodView = MeshLod::MakeView(cameraViewProj, lodSettings.enabled ? lodSettings.screenError : 0.0f);
+    const SCullBounds& bounds = proxies.GetBounds();
+
+    m_testedCount = 0;
+    for (size_t i = 0; i < proxies.Size(); i++) {
+        if (!proxies.IsDrawable(i)) continue;
+        m_testedCount++;
+
+        uint8_t mask = m_masks[i];
+        if (mask == 0) continue;
+
+        SCullItem item;
+        item.obj = proxies.GetGameObject(i);
+        item.meshRenderer = proxies.GetMeshRenderer(i);
+        item.transform = proxies.GetTransform(i);
+        item.material = proxies.GetMaterial(i);
+        item.worldMatrix = proxies.GetWorldMatrix(i);
+        item.prevWorldMatrix = proxies.GetPrevWorldMatrix(i);
+        item.proxyIndex = (uint32_t)i;
+
+        XMFLOAT3 center(bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i]);
+        float radius = std::sqrt(bounds.extentX[i] * bounds.extentX[i] + bounds.extentY[i] * bounds.extentY[i] +
+                                 bounds.extentZ[i] * bounds.extentZ[i]);
+        float cameraError = MeshLod::MaxError(lodView, center, radius, item.worldMatrix);
+        float shadowError = 0.0f;
+        if (mask & ~(1u << CULL_VIEW_CAMERA)) {
+            // Casters behind or around the camera: near-plane budget, not full detail
+            shadowError = MeshLod::MaxError(lodView, center, radius, item.worldMatrix, true) * lodSettings.shadowBias;
+        }
+
+        for (int v = 0; v < m_viewCount; v++) {
+            if (mask & (1u << v)) {
+                item.lodMaxError = v == CULL_VIEW_CAMERA ? cameraError : shadowError;
+                m_visible[v].push_back(item);
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_cullTimeMs = std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+void CSceneCuller::ReportStats() const
+{
+    CRenderStats& stats = CRenderStats::Instance();
+    for (int v = 0; v < CRenderStats::MAX_CULL_VIEWS; v++) {
+        if (v < m_viewCount) {
+            stats.RecordCulling(v, m_testedCount, (int)m_visible[v].size());
+        } else {
+            stats.RecordCulling(v, 0, 0);
+        }
+    }
+    stats.RecordCullTime(m_cullTimeMs);
+}
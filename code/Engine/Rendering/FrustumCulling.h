@@ -0,0 +1,135 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// SSE2 is the x64 baseline; everything else uses the scalar kernel
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define FF_CULL_SIMD 1
+#else
+#define FF_CULL_SIMD 0
+#endif
+
+class CScene;
+class CGameObject;
+class CMaterialAsset;
+struct SMeshRenderer;
+struct STransform;
+
+// ============================================
+// Frustum Culling
+// ============================================
+// Bounds are world-space AABBs stored as center/extent SoA. One call tests
+// every object against up to CULL_MAX_VIEWS frusta (camera + CSM cascades)
+// and writes one visibility bit per view, so the data is walked once per
+// frame instead of once per pass.
+//
+// Plane test (per object, per plane):
+//   d = dot(n, center) + w,  r = dot(|n|, extent)
+//   outside if d + r < 0
+// The SIMD kernel tests 4 objects per instruction with the same arithmetic
+// in the same order, so it returns exactly the scalar result.
+
+constexpr int CULL_MAX_VIEWS = 8;
+constexpr int CULL_VIEW_CAMERA = 0;
+constexpr int CULL_VIEW_CASCADE0 = 1;    // Cascade i = CULL_VIEW_CASCADE0 + i
+
+enum class ECullKernel
+{
+    Scalar,
+    SIMD        // Falls back to Scalar when FF_CULL_SIMD == 0
+};
+
+#if FF_CULL_SIMD
+constexpr ECullKernel CULL_DEFAULT_KERNEL = ECullKernel::SIMD;
+#else
+constexpr ECullKernel CULL_DEFAULT_KERNEL = ECullKernel::Scalar;
+#endif
+
+// 6 normalized planes, inside = dot(n, p) + w >= 0
+struct SFrustumPlanes
+{
+    DirectX::XMFLOAT4 planes[6];
+
+    // Gribb-Hartmann extraction from a row-vector view-projection matrix
+    // (D3D clip space, 0 <= z <= w). Works for perspective, orthographic and
+    // reversed-Z projections.
+    static SFrustumPlanes FromViewProj(const DirectX::XMMATRIX& viewProj);
+};
+
+// World-space AABBs, SoA
+struct SCullBounds
+{
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+
+    void Clear();
+    void Reserve(size_t count);
+    size_t Size() const { return centerX.size(); }
+
+    void Resize(size_t count);
+
+    void Add(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extent);
+    void Set(size_t index, const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extent);
+    // Local AABB transformed by a row-vector world matrix (Arvo)
+    void AddTransformed(const DirectX::XMFLOAT3& localMin, const DirectX::XMFLOAT3& localMax,
+                        const DirectX::XMMATRIX& world);
+    void SetTransformed(size_t index, const DirectX::XMFLOAT3& localMin, const DirectX::XMFLOAT3& localMax,
+                        const DirectX::XMMATRIX& world);
+};
+
+namespace FrustumCulling
+{
+    // outMasks[i] bit v = object i intersects frusta[v]
+    void CullBounds(const SCullBounds& bounds, const SFrustumPlanes* frusta, int frustumCount,
+                    uint8_t* outMasks, ECullKernel kernel = CULL_DEFAULT_KERNEL);
+}
+
+// ============================================
+// CSceneCuller - per-frame culling stage
+// ============================================
+// Refreshes the scene's CRenderProxyTable (cached world matrices, bounds and
+// materials of every drawable CGameObject) and culls its bounds against the
+// camera and shadow cascades in one pass.
+// Passes iterate GetVisible(view) instead of CWorld::Objects().
+//
+// Usage:
+//   culler.Cull(scene, cameraViewProj, cascadeVPs, cascadeCount);
+//   for (const SCullItem& item : culler.GetVisible(CULL_VIEW_CAMERA)) { ... }
+//   culler.ReportStats();   // -> CRenderStats
+
+struct SCullItem
+{
+    CGameObject* obj = nullptr;
+    SMeshRenderer* meshRenderer = nullptr;
+    STransform* transform = nullptr;
+    CMaterialAsset* material = nullptr;
+    DirectX::XMMATRIX worldMatrix;
+    DirectX::XMMATRIX prevWorldMatrix;  // Previous frame (motion vectors)
+    uint32_t proxyIndex = 0;        // Index into CScene::GetRenderProxies()
+    float lodMaxError = 0.0f;       // Mesh-space LOD budget for this view (see MeshLod.h)
+};
+
+class CSceneCuller
+{
+public:
+    static const int MAX_CASCADES = CULL_MAX_VIEWS - 1;
+
+    void Cull(CScene& scene, const DirectX::XMMATRIX& cameraViewProj,
+              const DirectX::XMMATRIX* cascadeViewProjs = nullptr, int cascadeCount = 0);
+
+    const std::vector<SCullItem>& GetVisible(int view) const { return m_visible[view]; }
+    int GetViewCount() const { return m_viewCount; }
+    int GetTestedCount() const { return m_testedCount; }
+    float GetCullTimeMs() const { return m_cullTimeMs; }
+
+    // Record tested / visible counts per view in CRenderStats
+    void ReportStats() const;
+
+private:
+    std::vector<uint8_t> m_masks;
+    std::vector<SCullItem> m_visible[CULL_MAX_VIEWS];
+    int m_viewCount = 0;
+    int m_testedCount = 0;
+    float m_cullTimeMs = 0.0f;
+};
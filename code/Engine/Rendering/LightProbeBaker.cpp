@@ -130,7 +130,7 @@ int CLightProbeBaker::BakeAllProbes(CScene& scene)
         if (!transform) continue;
 
         // 烘焙该 probe
-        if (BakeProbe(*probeComp, transform->position, scene)) {
+        if (BakeProbe(*probeComp, transform->GetWorldPosition(), scene)) {
             bakedCount++;
             CFFLog::Info("[LightProbeBaker] Baked probe '%s' (%d/%d)",
                         objPtr->GetName().c_str(), bakedCount, scene.GetWorld().Count());
@@ -78,7 +78,7 @@ void CLightProbeManager::LoadProbesFromScene(CScene& scene)
 
         // 构建 GPU 数据
         LightProbeData gpuData{};
-        gpuData.position = transform->position;
+        gpuData.position = transform->GetWorldPosition();
         gpuData.radius = probeComp->radius;
 
         // 拷贝 SH 系数（9 bands × RGB）
@@ -91,7 +91,7 @@ void CLightProbeManager::LoadProbesFromScene(CScene& scene)
 
         CFFLog::Info("[LightProbeManager] Loaded probe '%s' at index %d (pos=%.1f,%.1f,%.1f r=%.1f)",
                     objPtr->GetName().c_str(), m_probeCount - 1,
-                    transform->position.x, transform->position.y, transform->position.z,
+                    gpuData.position.x, gpuData.position.y, gpuData.position.z,
                     probeComp->radius);
     }
 
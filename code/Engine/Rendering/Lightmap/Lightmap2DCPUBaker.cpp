@@ -0,0 +1,665 @@
+#include "Lightmap2DCPUBaker.h"
+#include "LightmapRasterizer.h"
+#include "LightmapDenoiser.h"
+#include "../RayTracing/RayTracer.h"
+#include "Engine/Scene.h"
+#include "Engine/SceneLightSettings.h"
+#include "RHI/RHIManager.h"
+#include "RHI/IRenderContext.h"
+#include "Core/FFLog.h"
+#include "Core/PathManager.h"
+#include "Core/Loader/FFAssetLoader.h"
+#include "Core/Jobs/JobSystem.h"
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace DirectX;
+
+// ============================================
+// Constants
+// ============================================
+static const float PI = 3.14159265358979323846f;
+static const float INV_PI = 1.0f / PI;
+
+// Must match Lightmap2DBake.hlsl, Lightmap2DFinalize.cs.hlsl and CLightmap2DGPUBaker
+static const float RAY_OFFSET = 0.001f;             // OffsetRayOrigin() and ray TMin
+static const float RAY_TMAX = 10000.0f;
+static const float MAX_SAMPLE_RADIANCE = 500.0f;    // Per-sample clamp before accumulation
+static const float MAX_TEXEL_RADIANCE = 100.0f;     // Finalize clamp
+static const int DILATION_PASSES = 4;
+
+// Back faces stepped over by one ray before it counts as a miss
+static const int MAX_BACKFACE_SKIPS = 16;
+
+// ============================================
+// Sampling helpers (same math as LightmapBakeCommon.hlsl)
+// ============================================
+
+namespace
+{
+    inline XMFLOAT3 offsetRayOrigin(const XMFLOAT3& position, const XMFLOAT3& normal)
+    {
+        return {
+            position.x + normal.x * RAY_OFFSET,
+            position.y + normal.y * RAY_OFFSET,
+            position.z + normal.z * RAY_OFFSET
+        };
+    }
+
+    inline XMFLOAT3 normalize3(const XMFLOAT3& v)
+    {
+        float len = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+        if (len < 1e-20f) return {0, 1, 0};
+        float inv = 1.0f / len;
+        return {v.x * inv, v.y * inv, v.z * inv};
+    }
+
+    inline float saturate(float x)
+    {
+        return std::clamp(x, 0.0f, 1.0f);
+    }
+
+    // Cosine-weighted direction around normal (Frisvad basis, as BuildOrthonormalBasis)
+    XMFLOAT3 sampleHemisphereCosine(const XMFLOAT3& normal, float u1, float u2)
+    {
+        float r = std::sqrt(u1);
+        float phi = 2.0f * PI * u2;
+        float x = r * std::cos(phi);
+        float y = r * std::sin(phi);
+        float z = std::sqrt(std::max(0.0f, 1.0f - u1));
+
+        XMFLOAT3 tangent, bitangent;
+        if (normal.z < -0.9999999f) {
+            tangent = {0.0f, -1.0f, 0.0f};
+            bitangent = {-1.0f, 0.0f, 0.0f};
+        } else {
+            float a = 1.0f / (1.0f + normal.z);
+            float b = -normal.x * normal.y * a;
+            tangent = {1.0f - normal.x * normal.x * a, b, -normal.x};
+            bitangent = {b, 1.0f - normal.y * normal.y * a, -normal.y};
+        }
+
+        return {
+            x * tangent.x + y * bitangent.x + z * normal.x,
+            x * tangent.y + y * bitangent.y + z * normal.y,
+            x * tangent.z + y * bitangent.z + z * normal.z
+        };
+    }
+
+    // D3D cubemap face selection, face order +X, -X, +Y, -Y, +Z, -Z
+    void directionToCubemapUV(const XMFLOAT3& dir, int& face, float& u, float& v)
+    {
+        float absX = std::abs(dir.x);
+        float absY = std::abs(dir.y);
+        float absZ = std::abs(dir.z);
+        float ma, sc, tc;
+
+        if (absX >= absY && absX >= absZ) {
+            ma = absX;
+            face = dir.x > 0 ? 0 : 1;
+            sc = dir.x > 0 ? -dir.z : dir.z;
+            tc = -dir.y;
+        } else if (absY >= absZ) {
+            ma = absY;
+            face = dir.y > 0 ? 2 : 3;
+            sc = dir.x;
+            tc = dir.y > 0 ? dir.z : -dir.z;
+        } else {
+            ma = absZ;
+            face = dir.z > 0 ? 4 : 5;
+            sc = dir.z > 0 ? dir.x : -dir.x;
+            tc = -dir.y;
+        }
+
+        u = std::clamp(0.5f * (sc / ma + 1.0f), 0.0f, 1.0f);
+        v = std::clamp(0.5f * (tc / ma + 1.0f), 0.0f, 1.0f);
+    }
+
+    // Bilinear sample of one face (mip 0, like SampleLevel(..., 0))
+    XMFLOAT3 sampleCubemapFace(const CKTXLoader::SCubemapCPUData& cubemap, int face, float u, float v)
+    {
+        const auto& faceData = cubemap.faces[face];
+        const int size = cubemap.size;
+        if (faceData.size() < (size_t)size * size || size <= 0) {
+            return {0, 0, 0};
+        }
+
+        float fx = u * (size - 1);
+        float fy = v * (size - 1);
+        int x0 = (int)fx;
+        int y0 = (int)fy;
+        int x1 = std::min(x0 + 1, size - 1);
+        int y1 = std::min(y0 + 1, size - 1);
+        float dx = fx - x0;
+        float dy = fy - y0;
+
+        const XMFLOAT4& p00 = faceData[y0 * size + x0];
+        const XMFLOAT4& p10 = faceData[y0 * size + x1];
+        const XMFLOAT4& p01 = faceData[y1 * size + x0];
+        const XMFLOAT4& p11 = faceData[y1 * size + x1];
+        float w00 = (1 - dx) * (1 - dy), w10 = dx * (1 - dy), w01 = (1 - dx) * dy, w11 = dx * dy;
+
+        return {
+            w00 * p00.x + w10 * p10.x + w01 * p01.x + w11 * p11.x,
+            w00 * p00.y + w10 * p10.y + w01 * p01.y + w11 * p11.y,
+            w00 * p00.z + w10 * p10.z + w01 * p01.z + w11 * p11.z
+        };
+    }
+}
+
+// ============================================
+// CLightmap2DCPUBaker Implementation
+// ============================================
+
+CLightmap2DCPUBaker::CLightmap2DCPUBaker() = default;
+CLightmap2DCPUBaker::~CLightmap2DCPUBaker() = default;
+
+void CLightmap2DCPUBaker::reportProgress(float progress, const char* stage)
+{
+    if (m_config.progressCallback) {
+        m_config.progressCallback(progress, stage);
+    }
+    CFFLog::Info("[Lightmap2DCPUBaker] %.0f%% - %s", progress * 100.0f, stage);
+}
+
+bool CLightmap2DCPUBaker::loadSkybox(CScene& scene)
+{
+    m_sceneSkybox = CKTXLoader::SCubemapCPUData();
+
+    const std::string& skyboxAssetPath = scene.GetLightSettings().skyboxAssetPath;
+    if (skyboxAssetPath.empty()) {
+        return false;
+    }
+
+    CFFAssetLoader::SkyboxAsset skyboxAsset;
+    std::string fullAssetPath = FFPath::GetAbsolutePath(skyboxAssetPath);
+    if (!CFFAssetLoader::LoadSkyboxAsset(fullAssetPath, skyboxAsset)) {
+        CFFLog::Error("[Lightmap2DCPUBaker] Failed to load skybox asset: %s", fullAssetPath.c_str());
+        return false;
+    }
+
+    std::string ktx2Path = FFPath::GetAbsolutePath(skyboxAsset.envPath);
+    if (!CKTXLoader::LoadCubemapToCPU(ktx2Path, m_sceneSkybox)) {
+        CFFLog::Error("[Lightmap2DCPUBaker] Failed to load skybox cubemap: %s", ktx2Path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ============================================
+// Main Baking Entry Points
+// ============================================
+
+bool CLightmap2DCPUBaker::BakeLightmap(
+    CScene& scene,
+    const CLightmapRasterizer& rasterizer,
+    const SLightmap2DCPUBakeConfig& config)
+{
+    if (!loadSkybox(scene)) {
+        CFFLog::Warning("[Lightmap2DCPUBaker] No skybox cubemap, sky is black");
+    }
+
+    auto sceneData = CSceneGeometryExporter::ExportScene(scene);
+    if (!sceneData) {
+        CFFLog::Error("[Lightmap2DCPUBaker] Failed to export scene geometry");
+        return false;
+    }
+
+    return BakeLightmap(
+        *sceneData,
+        rasterizer.GetTexels(),
+        rasterizer.GetWidth(),
+        rasterizer.GetHeight(),
+        &m_sceneSkybox,
+        config);
+}
+
+bool CLightmap2DCPUBaker::BakeLightmap(
+    const SRayTracingSceneData& sceneData,
+    const std::vector<STexelData>& texels,
+    uint32_t atlasWidth,
+    uint32_t atlasHeight,
+    const CKTXLoader::SCubemapCPUData* skybox,
+    const SLightmap2DCPUBakeConfig& config)
+{
+    m_config = config;
+    m_atlas.clear();
+    m_bakedTexelCount = 0;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    reportProgress(0.0f, "Starting CPU lightmap bake");
+
+    if (texels.size() < (size_t)atlasWidth * atlasHeight) {
+        CFFLog::Error("[Lightmap2DCPUBaker] %zu texels for a %ux%u atlas", texels.size(), atlasWidth, atlasHeight);
+        return false;
+    }
+    m_atlasWidth = atlasWidth;
+    m_atlasHeight = atlasHeight;
+    m_atlas.assign((size_t)atlasWidth * atlasHeight, XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f));
+
+    // Phase 1: Scene
+    reportProgress(0.05f, "Building BVH");
+    m_rayTracer = std::make_unique<CRayTracer>();
+    if (!m_rayTracer->Initialize(sceneData)) {
+        CFFLog::Error("[Lightmap2DCPUBaker] Failed to build BVH");
+        m_rayTracer.reset();
+        return false;
+    }
+    m_lights = sceneData.lights;
+    m_skybox = (skybox && skybox->valid) ? skybox : nullptr;
+
+    // Phase 2: Tiles that contain valid texels
+    reportProgress(0.10f, "Scheduling tiles");
+    const int tileSize = std::max(1, m_config.tileSize);
+    const int tilesX = ((int)atlasWidth + tileSize - 1) / tileSize;
+    const int tilesY = ((int)atlasHeight + tileSize - 1) / tileSize;
+    std::vector<uint32_t> tiles;
+    int validTexels = 0;
+    for (int ty = 0; ty < tilesY; ty++) {
+        for (int tx = 0; tx < tilesX; tx++) {
+            int count = 0;
+            for (int y = ty * tileSize; y < std::min((ty + 1) * tileSize, (int)atlasHeight); y++) {
+                for (int x = tx * tileSize; x < std::min((tx + 1) * tileSize, (int)atlasWidth); x++) {
+                    if (texels[(size_t)y * atlasWidth + x].valid) count++;
+                }
+            }
+            if (count > 0) {
+                tiles.push_back((uint32_t)(ty * tilesX + tx));
+                validTexels += count;
+            }
+        }
+    }
+
+    if (validTexels == 0) {
+        CFFLog::Warning("[Lightmap2DCPUBaker] No valid texels to bake");
+        m_rayTracer.reset();
+        return false;
+    }
+
+    auto& jobs = CJobSystem::Instance();
+    const uint32_t threadCount = jobs.IsInitialized() ? jobs.GetThreadCount() : 1;
+    CFFLog::Info("[Lightmap2DCPUBaker] %d texels in %d tiles of %d^2, %u samples, %u bounces, %u threads",
+                 validTexels, (int)tiles.size(), tileSize, m_config.samplesPerTexel, m_config.maxBounces, threadCount);
+
+    // Phase 3: Bake, one job per tile
+    reportProgress(0.15f, "Baking");
+    auto bakeStart = std::chrono::high_resolution_clock::now();
+
+    std::atomic<int> texelsDone{0};
+    CJobCounter counter;
+    for (uint32_t tile : tiles) {
+        jobs.Run([this, &texels, &texelsDone, tile, tilesX]() {
+            int baked = bakeTile((int)(tile % tilesX), (int)(tile / tilesX), texels);
+            texelsDone.fetch_add(baked, std::memory_order_relaxed);
+        }, &counter);
+    }
+
+    // The calling thread helps, and reports progress (callbacks stay on this thread)
+    const int progressInterval = std::max(1, validTexels / 20);
+    int lastReported = 0;
+    while (true) {
+        bool finished = counter.IsDone();
+        if (!finished && !jobs.TryExecuteOne()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        int done = texelsDone.load(std::memory_order_relaxed);
+        if (done - lastReported >= progressInterval || (finished && done != lastReported)) {
+            lastReported = done;
+            reportProgress(0.15f + 0.70f * done / validTexels, "Baking");
+        }
+        if (finished) break;
+    }
+    m_bakedTexelCount = (uint32_t)validTexels;
+
+    float bakeSeconds = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - bakeStart).count();
+
+    m_rayTracer.reset();
+    m_lights.clear();
+    m_skybox = nullptr;
+
+    // Phase 4: Dilation
+    reportProgress(0.85f, "Dilating");
+    dilate(DILATION_PASSES);
+
+    // Phase 5: OIDN Denoising (optional)
+    denoise();
+
+    reportProgress(1.0f, "Bake complete");
+
+    float totalSeconds = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - startTime).count();
+    double samples = (double)validTexels * std::max(1u, m_config.samplesPerTexel);
+    CFFLog::Info("[Lightmap2DCPUBaker] Bake complete: %ux%u atlas, %d texels, %.2f seconds (trace %.2f s, %.2f Msamples/s)",
+                 atlasWidth, atlasHeight, validTexels, totalSeconds, bakeSeconds,
+                 bakeSeconds > 0.0f ? samples / bakeSeconds / 1e6 : 0.0);
+    return true;
+}
+
+// ============================================
+// Baking
+// ============================================
+
+int CLightmap2DCPUBaker::bakeTile(int tileX, int tileY, const std::vector<STexelData>& texels)
+{
+    const int tileSize = std::max(1, m_config.tileSize);
+    const int x0 = tileX * tileSize;
+    const int y0 = tileY * tileSize;
+    const int x1 = std::min(x0 + tileSize, (int)m_atlasWidth);
+    const int y1 = std::min(y0 + tileSize, (int)m_atlasHeight);
+    const uint32_t sampleCount = std::max(1u, m_config.samplesPerTexel);
+
+    int baked = 0;
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            const size_t idx = (size_t)y * m_atlasWidth + x;
+            const STexelData& texel = texels[idx];
+            if (!texel.valid) continue;
+
+            const XMFLOAT3 normal = normalize3(texel.normal);
+
+            // One stream per texel: the result does not depend on tile order or thread
+            SBakeRandom rng(SBakeRandom::MakeKey((uint32_t)x, (uint32_t)y));
+
+            XMFLOAT3 sum = {0, 0, 0};
+            for (uint32_t s = 0; s < sampleCount; s++) {
+                XMFLOAT3 contribution = traceSample(texel.worldPos, normal, rng);
+                sum.x += std::clamp(contribution.x, 0.0f, MAX_SAMPLE_RADIANCE);
+                sum.y += std::clamp(contribution.y, 0.0f, MAX_SAMPLE_RADIANCE);
+                sum.z += std::clamp(contribution.z, 0.0f, MAX_SAMPLE_RADIANCE);
+            }
+
+            // Finalize: mean over samples, clamped to the HDR range
+            const float invCount = 1.0f / (float)sampleCount;
+            m_atlas[idx] = {
+                std::clamp(sum.x * invCount, 0.0f, MAX_TEXEL_RADIANCE),
+                std::clamp(sum.y * invCount, 0.0f, MAX_TEXEL_RADIANCE),
+                std::clamp(sum.z * invCount, 0.0f, MAX_TEXEL_RADIANCE),
+                1.0f
+            };
+            baked++;
+        }
+    }
+    return baked;
+}
+
+XMFLOAT3 CLightmap2DCPUBaker::traceSample(
+    const XMFLOAT3& worldPos,
+    const XMFLOAT3& normal,
+    SBakeRandom& rng) const
+{
+    // Direct irradiance at the texel itself
+    XMFLOAT3 radiance = evaluateDirectIrradiance(worldPos, normal);
+    XMFLOAT3 throughput = {1, 1, 1};
+
+    // Indirect: one cosine-weighted path. With pdf = cos / PI every hit or
+    // miss adds L * PI (see ClosestHit in Lightmap2DBake.hlsl)
+    SRay ray;
+    ray.origin = offsetRayOrigin(worldPos, normal);
+    float u1 = rng.Next();
+    float u2 = rng.Next();
+    ray.direction = sampleHemisphereCosine(normal, u1, u2);
+    ray.tMin = RAY_OFFSET;
+    ray.tMax = RAY_TMAX;
+
+    for (uint32_t bounceCount = 1; ; bounceCount++) {
+        SRayHit hit;
+        if (!traceFrontFace(ray, hit)) {
+            XMFLOAT3 sky = sampleSky(ray.direction);
+            float k = m_config.skyIntensity * PI;
+            radiance.x += throughput.x * sky.x * k;
+            radiance.y += throughput.y * sky.y * k;
+            radiance.z += throughput.z * sky.z * k;
+            break;
+        }
+
+        // Lambertian hit: L = albedo * E / PI, which adds L * PI
+        const XMFLOAT3& albedo = hit.albedo;
+        XMFLOAT3 irradiance = evaluateDirectIrradiance(hit.position, hit.normal);
+        radiance.x += throughput.x * albedo.x * irradiance.x;
+        radiance.y += throughput.y * albedo.y * irradiance.y;
+        radiance.z += throughput.z * albedo.z * irradiance.z;
+
+        // Russian roulette after 2 bounces
+        if (bounceCount >= 2) {
+            float survivalProb = std::min(std::max({albedo.x, albedo.y, albedo.z}), 0.95f);
+            if (rng.Next() > survivalProb) {
+                break;
+            }
+            throughput.x /= survivalProb;
+            throughput.y /= survivalProb;
+            throughput.z /= survivalProb;
+        }
+
+        if (bounceCount >= m_config.maxBounces) {
+            break;
+        }
+
+        u1 = rng.Next();
+        u2 = rng.Next();
+        ray.direction = sampleHemisphereCosine(hit.normal, u1, u2);
+        ray.origin = offsetRayOrigin(hit.position, hit.normal);
+        ray.tMin = RAY_OFFSET;
+        throughput.x *= albedo.x;
+        throughput.y *= albedo.y;
+        throughput.z *= albedo.z;
+    }
+
+    return {radiance.x * INV_PI, radiance.y * INV_PI, radiance.z * INV_PI};
+}
+
+XMFLOAT3 CLightmap2DCPUBaker::evaluateDirectIrradiance(const XMFLOAT3& pos, const XMFLOAT3& normal) const
+{
+    XMFLOAT3 result = {0, 0, 0};
+    const XMFLOAT3 shadowOrigin = offsetRayOrigin(pos, normal);
+
+    for (const SRayTracingLight& light : m_lights) {
+        XMFLOAT3 L;
+        float lightDist;
+        float attenuation = 1.0f;
+
+        if (light.type == SRayTracingLight::EType::Directional) {
+            XMFLOAT3 dir = normalize3(light.direction);
+            L = {-dir.x, -dir.y, -dir.z};
+            lightDist = RAY_TMAX;
+        } else {
+            XMFLOAT3 toLight = {light.position.x - pos.x, light.position.y - pos.y, light.position.z - pos.z};
+            lightDist = std::sqrt(toLight.x * toLight.x + toLight.y * toLight.y + toLight.z * toLight.z);
+            if (lightDist > light.range || lightDist < 1e-6f) continue;
+            L = {toLight.x / lightDist, toLight.y / lightDist, toLight.z / lightDist};
+
+            float falloff = saturate(1.0f - lightDist / light.range);
+            attenuation = falloff * falloff;
+
+            if (light.type == SRayTracingLight::EType::Spot) {
+                XMFLOAT3 spotDir = normalize3(light.direction);
+                float cosAngle = -(L.x * spotDir.x + L.y * spotDir.y + L.z * spotDir.z);
+                float cosOuter = std::cos(light.spotAngle);
+                float cosInner = std::cos(light.spotAngle * 0.8f);
+                attenuation *= saturate((cosAngle - cosOuter) / (cosInner - cosOuter));
+            }
+        }
+
+        float NdotL = saturate(normal.x * L.x + normal.y * L.y + normal.z * L.z);
+        if (NdotL <= 0.0f) continue;
+
+        if (!isVisible(shadowOrigin, L, lightDist - RAY_OFFSET)) continue;
+
+        // Incoming light only: no BRDF term
+        float k = light.intensity * NdotL * attenuation;
+        result.x += light.color.x * k;
+        result.y += light.color.y * k;
+        result.z += light.color.z * k;
+    }
+
+    return result;
+}
+
+bool CLightmap2DCPUBaker::traceFrontFace(const SRay& ray, SRayHit& outHit) const
+{
+    SRay r = ray;
+    for (int i = 0; i < MAX_BACKFACE_SKIPS; i++) {
+        outHit = m_rayTracer->TraceRay(r);
+        if (!outHit.valid) return false;
+        if (outHit.frontFace) return true;
+        r.tMin = outHit.distance + RAY_OFFSET;  // Step past the back face
+    }
+    outHit = SRayHit();
+    return false;
+}
+
+bool CLightmap2DCPUBaker::isVisible(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance) const
+{
+    SRay ray;
+    ray.origin = origin;
+    ray.direction = direction;
+    ray.tMin = RAY_OFFSET;
+    ray.tMax = maxDistance;
+
+    // Any-hit first; only a blocked ray pays for the back-face check
+    if (!m_rayTracer->Occluded(ray)) {
+        return true;
+    }
+    SRayHit hit;
+    return !traceFrontFace(ray, hit);
+}
+
+XMFLOAT3 CLightmap2DCPUBaker::sampleSky(const XMFLOAT3& direction) const
+{
+    if (!m_skybox) {
+        return {0, 0, 0};
+    }
+    int face;
+    float u, v;
+    directionToCubemapUV(direction, face, u, v);
+    return sampleCubemapFace(*m_skybox, face, u, v);
+}
+
+// ============================================
+// Post-processing
+// ============================================
+
+void CLightmap2DCPUBaker::dilate(int passes)
+{
+    if (passes <= 0 || m_atlas.empty()) return;
+
+    const int width = (int)m_atlasWidth;
+    const int height = (int)m_atlasHeight;
+    std::vector<XMFLOAT4> temp(m_atlas.size());
+
+    // Ping-pong, one texel per pass (Lightmap2DDilate.cs.hlsl with radius 1)
+    for (int pass = 0; pass < passes; pass++) {
+        const std::vector<XMFLOAT4>& src = (pass % 2 == 0) ? m_atlas : temp;
+        std::vector<XMFLOAT4>& dst = (pass % 2 == 0) ? temp : m_atlas;
+
+        CJobSystem::Instance().ParallelFor((uint32_t)height, 16, [&](uint32_t rowBegin, uint32_t rowEnd) {
+            for (int y = (int)rowBegin; y < (int)rowEnd; y++) {
+                for (int x = 0; x < width; x++) {
+                    const XMFLOAT4& current = src[(size_t)y * width + x];
+                    if (current.w > 0.0f) {
+                        dst[(size_t)y * width + x] = current;
+                        continue;
+                    }
+
+                    // Nearest valid neighbour; orthogonal before diagonal
+                    const XMFLOAT4* best = nullptr;
+                    int bestDistSq = INT32_MAX;
+                    for (int dy = -1; dy <= 1; dy++) {
+                        for (int dx = -1; dx <= 1; dx++) {
+                            int nx = x + dx, ny = y + dy;
+                            if ((dx == 0 && dy == 0) || nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                            const XMFLOAT4& neighbor = src[(size_t)ny * width + nx];
+                            int distSq = dx * dx + dy * dy;
+                            if (neighbor.w > 0.0f && distSq < bestDistSq) {
+                                bestDistSq = distSq;
+                                best = &neighbor;
+                            }
+                        }
+                    }
+                    dst[(size_t)y * width + x] = best ? XMFLOAT4(best->x, best->y, best->z, 0.5f)
+                                                      : XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+                }
+            }
+        });
+    }
+
+    if (passes % 2 != 0) {
+        m_atlas.swap(temp);
+    }
+}
+
+void CLightmap2DCPUBaker::denoise()
+{
+    if (!m_config.enableDenoiser) {
+        reportProgress(0.99f, "Denoising skipped (disabled)");
+        return;
+    }
+
+    reportProgress(0.90f, "Initializing denoiser");
+
+    if (!m_denoiser) {
+        m_denoiser = std::make_unique<CLightmapDenoiser>();
+        if (!m_denoiser->Initialize()) {
+            CFFLog::Error("[Lightmap2DCPUBaker] Failed to initialize OIDN denoiser");
+            m_denoiser.reset();
+            return;
+        }
+    }
+
+    const size_t pixelCount = m_atlas.size();
+    std::vector<float> colorBuffer(pixelCount * 3);
+    for (size_t i = 0; i < pixelCount; i++) {
+        colorBuffer[i * 3 + 0] = m_atlas[i].x;
+        colorBuffer[i * 3 + 1] = m_atlas[i].y;
+        colorBuffer[i * 3 + 2] = m_atlas[i].z;
+    }
+
+    reportProgress(0.93f, "Denoising with OIDN");
+
+    if (!m_denoiser->Denoise(colorBuffer.data(), (int)m_atlasWidth, (int)m_atlasHeight)) {
+        CFFLog::Error("[Lightmap2DCPUBaker] OIDN denoising failed: %s", m_denoiser->GetLastError());
+        return;
+    }
+
+    // Same as the GPU path: alpha = 1 after denoising
+    for (size_t i = 0; i < pixelCount; i++) {
+        m_atlas[i] = {colorBuffer[i * 3 + 0], colorBuffer[i * 3 + 1], colorBuffer[i * 3 + 2], 1.0f};
+    }
+
+    reportProgress(0.99f, "Denoising complete");
+}
+
+// ============================================
+// Output
+// ============================================
+
+RHI::TexturePtr CLightmap2DCPUBaker::CreateTexture() const
+{
+    using namespace DirectX::PackedVector;
+
+    auto* ctx = RHI::CRHIManager::Instance().GetRenderContext();
+    if (!ctx || m_atlas.empty()) {
+        return nullptr;
+    }
+
+    std::vector<XMHALF4> halfData(m_atlas.size());
+    for (size_t i = 0; i < m_atlas.size(); i++) {
+        halfData[i].x = XMConvertFloatToHalf(m_atlas[i].x);
+        halfData[i].y = XMConvertFloatToHalf(m_atlas[i].y);
+        halfData[i].z = XMConvertFloatToHalf(m_atlas[i].z);
+        halfData[i].w = XMConvertFloatToHalf(m_atlas[i].w);
+    }
+
+    RHI::TextureDesc texDesc;
+    texDesc.width = m_atlasWidth;
+    texDesc.height = m_atlasHeight;
+    texDesc.format = RHI::ETextureFormat::R16G16B16A16_FLOAT;
+    texDesc.usage = RHI::ETextureUsage::ShaderResource;
+    texDesc.debugName = "Lightmap2D_CPUOutput";
+
+    return RHI::TexturePtr(ctx->CreateTexture(texDesc, halfData.data()));
+}
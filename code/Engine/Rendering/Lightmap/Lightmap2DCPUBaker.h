@@ -0,0 +1,153 @@
+#pragma once
+
+#include "LightmapTypes.h"
+#include "../RayTracing/BakeRandom.h"
+#include "../RayTracing/SceneGeometryExport.h"
+#include "Core/Loader/KTXLoader.h"
+#include "RHI/RHIPointers.h"
+#include <DirectXMath.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// ============================================
+// 2D Lightmap CPU Baker
+// ============================================
+// CPU backend for 2D atlas lightmaps, for machines without DXR (build
+// farm, headless bakes) and for checking GPU results.
+//
+// Same estimator and output as CLightmap2DGPUBaker (Lightmap2DBake.hlsl):
+// - Direct irradiance at the texel, plus one cosine-weighted hemisphere
+//   path for indirect light (Russian roulette from the 2nd bounce,
+//   back-facing triangles are culled like the DXR ray flags)
+// - Per texel: mean of clamp(radiance / PI, 0, 500) over the samples,
+//   clamped to 100; alpha = 1 for baked texels
+// - 4 one-texel dilation passes (dilated texels get alpha 0.5), then the
+//   optional OIDN denoise (alpha = 1 everywhere)
+//
+// Scheduling: the atlas is cut into tiles and every tile with valid texels
+// is one CJobSystem job. A tile writes only its own texels, and each texel
+// draws from its own SBakeRandom stream, so the atlas is identical for any
+// thread count.
+
+class CScene;
+class CRayTracer;
+class CLightmapRasterizer;
+class CLightmapDenoiser;
+struct SRay;
+struct SRayHit;
+
+// ============================================
+// Bake Configuration
+// ============================================
+
+struct SLightmap2DCPUBakeConfig {
+    uint32_t samplesPerTexel = 64;      // Monte Carlo samples per texel
+    uint32_t maxBounces = 3;            // Max ray bounces for GI
+    float skyIntensity = 1.0f;          // Sky light intensity multiplier
+    bool enableDenoiser = true;         // Enable Intel OIDN denoising
+    int tileSize = 16;                  // Texels per tile side (one job per tile)
+
+    // Progress callback (0.0 to 1.0), called on the baking thread only
+    std::function<void(float, const char*)> progressCallback = nullptr;
+};
+
+// ============================================
+// CLightmap2DCPUBaker
+// ============================================
+
+class CLightmap2DCPUBaker {
+public:
+    CLightmap2DCPUBaker();
+    ~CLightmap2DCPUBaker();
+
+    // Non-copyable
+    CLightmap2DCPUBaker(const CLightmap2DCPUBaker&) = delete;
+    CLightmap2DCPUBaker& operator=(const CLightmap2DCPUBaker&) = delete;
+
+    // Bake lightmap from scene and rasterizer data
+    // Exports the scene geometry and loads the skybox cubemap to CPU
+    bool BakeLightmap(
+        CScene& scene,
+        const CLightmapRasterizer& rasterizer,
+        const SLightmap2DCPUBakeConfig& config = {});
+
+    // Bake from pre-exported scene data (no scene, no render context)
+    // skybox: sky radiance for rays that miss; nullptr = black sky
+    bool BakeLightmap(
+        const SRayTracingSceneData& sceneData,
+        const std::vector<STexelData>& texels,
+        uint32_t atlasWidth,
+        uint32_t atlasHeight,
+        const CKTXLoader::SCubemapCPUData* skybox,
+        const SLightmap2DCPUBakeConfig& config = {});
+
+    // Baked atlas, RGBA float per texel (row-major, same data as the GPU
+    // baker's R16G16B16A16_FLOAT texture)
+    const std::vector<DirectX::XMFLOAT4>& GetAtlas() const { return m_atlas; }
+    uint32_t GetAtlasWidth() const { return m_atlasWidth; }
+    uint32_t GetAtlasHeight() const { return m_atlasHeight; }
+
+    // Valid texels baked by the last BakeLightmap()
+    uint32_t GetBakedTexelCount() const { return m_bakedTexelCount; }
+
+    // Upload the atlas to an R16G16B16A16_FLOAT texture
+    // Returns nullptr without a render context (headless)
+    RHI::TexturePtr CreateTexture() const;
+
+private:
+    // One sample of the GPU estimator, before the per-sample clamp
+    DirectX::XMFLOAT3 traceSample(
+        const DirectX::XMFLOAT3& worldPos,
+        const DirectX::XMFLOAT3& normal,
+        SBakeRandom& rng) const;
+
+    // Sum of lightColor * intensity * NdotL * attenuation over visible lights
+    DirectX::XMFLOAT3 evaluateDirectIrradiance(
+        const DirectX::XMFLOAT3& pos,
+        const DirectX::XMFLOAT3& normal) const;
+
+    // Closest front-facing hit (back faces are skipped, as with
+    // RAY_FLAG_CULL_BACK_FACING_TRIANGLES)
+    bool traceFrontFace(const SRay& ray, SRayHit& outHit) const;
+
+    // No front-facing triangle between origin and origin + dir * maxDistance
+    bool isVisible(
+        const DirectX::XMFLOAT3& origin,
+        const DirectX::XMFLOAT3& direction,
+        float maxDistance) const;
+
+    DirectX::XMFLOAT3 sampleSky(const DirectX::XMFLOAT3& direction) const;
+
+    // Bake the valid texels of one tile into m_atlas, returns their count
+    int bakeTile(int tileX, int tileY, const std::vector<STexelData>& texels);
+
+    // Expand baked texels into empty neighbours, one texel per pass
+    void dilate(int passes);
+
+    // OIDN in place on m_atlas
+    void denoise();
+
+    bool loadSkybox(CScene& scene);
+
+    void reportProgress(float progress, const char* stage);
+
+private:
+    SLightmap2DCPUBakeConfig m_config;
+
+    // Per-bake scene (valid during BakeLightmap)
+    std::unique_ptr<CRayTracer> m_rayTracer;
+    std::vector<SRayTracingLight> m_lights;
+    const CKTXLoader::SCubemapCPUData* m_skybox = nullptr;
+
+    // Skybox loaded by the scene overload
+    CKTXLoader::SCubemapCPUData m_sceneSkybox;
+
+    // Output
+    std::vector<DirectX::XMFLOAT4> m_atlas;
+    uint32_t m_atlasWidth = 0;
+    uint32_t m_atlasHeight = 0;
+    uint32_t m_bakedTexelCount = 0;
+
+    std::unique_ptr<CLightmapDenoiser> m_denoiser;
+};
@@ -1,6 +1,8 @@
 #include "LightmapAtlas.h"
+#include "LightmapPacker.h"
 #include "Core/FFLog.h"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 
 using namespace DirectX;
@@ -17,11 +19,37 @@ bool CLightmapAtlas::Pack(
     m_entries.resize(meshSizes.size());
     m_resolution = config.resolution;
     m_atlasCount = 0;
+    m_occupancy = 0.0f;
 
     if (meshSizes.empty()) {
         return true;
     }
 
+    auto start = std::chrono::high_resolution_clock::now();
+    bool packed = config.packer == EAtlasPacker::MaxRects ? packMaxRects(meshSizes, config)
+                                                          : packShelf(meshSizes, config);
+    if (!packed) {
+        return false;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    int64_t usedTexels = 0;
+    for (const auto& size : meshSizes) {
+        usedTexels += (int64_t)size.first * size.second;
+    }
+    m_occupancy = (float)((double)usedTexels / ((double)m_atlasCount * m_resolution * m_resolution));
+
+    CFFLog::Info("[LightmapAtlas] Packed %d meshes into %d atlas(es) (%dx%d each), %s, %.1f%% occupied, %.2f ms",
+                (int)meshSizes.size(), m_atlasCount, config.resolution, config.resolution,
+                config.packer == EAtlasPacker::MaxRects ? "MaxRects" : "shelf", m_occupancy * 100.0f, ms);
+
+    return true;
+}
+
+bool CLightmapAtlas::packShelf(
+    const std::vector<std::pair<int, int>>& meshSizes,
+    const SLightmapAtlasConfig& config)
+{
     // Sort meshes by height (tallest first) for better packing
     std::vector<size_t> sortedIndices(meshSizes.size());
     for (size_t i = 0; i < sortedIndices.size(); i++) {
@@ -80,10 +108,36 @@ bool CLightmapAtlas::Pack(
     }
 
     m_atlasCount = atlasIndex + 1;
+    return true;
+}
 
-    CFFLog::Info("[LightmapAtlas] Packed %d meshes into %d atlas(es) (%dx%d each)",
-                (int)meshSizes.size(), m_atlasCount, config.resolution, config.resolution);
+bool CLightmapAtlas::packMaxRects(
+    const std::vector<std::pair<int, int>>& meshSizes,
+    const SLightmapAtlasConfig& config)
+{
+    std::vector<SPackRect> rects(meshSizes.size());
+    for (size_t i = 0; i < meshSizes.size(); i++) {
+        rects[i].width = meshSizes[i].first;
+        rects[i].height = meshSizes[i].second;
+    }
+
+    CMaxRectsPacker packer;
+    if (!packer.Pack(rects, config.resolution, config.padding)) {
+        CFFLog::Error("[LightmapAtlas] MaxRects packing failed");
+        return false;
+    }
+
+    const auto& placements = packer.GetPlacements();
+    for (size_t i = 0; i < meshSizes.size(); i++) {
+        m_entries[i].meshRendererIndex = static_cast<int>(i);
+        m_entries[i].atlasIndex = placements[i].page;
+        m_entries[i].atlasX = placements[i].x;
+        m_entries[i].atlasY = placements[i].y;
+        m_entries[i].width = placements[i].width;
+        m_entries[i].height = placements[i].height;
+    }
 
+    m_atlasCount = packer.GetStats().pageCount;
     return true;
 }
 
@@ -105,7 +159,7 @@ XMFLOAT4 CLightmapAtlas::ComputeScaleOffset(
 std::pair<int, int> CLightmapAtlas::ComputeMeshLightmapSize(
     const XMFLOAT3& boundsMin,
     const XMFLOAT3& boundsMax,
-    int texelsPerUnit,
+    float texelsPerUnit,
     int minSize,
     int maxSize)
 {
@@ -138,6 +192,19 @@ std::pair<int, int> CLightmapAtlas::ComputeMeshLightmapSize(
     return {width, height};
 }
 
+std::pair<int, int> CLightmapAtlas::ComputeMeshLightmapSizeFromArea(
+    float surfaceArea,
+    float uv2Coverage,
+    float texelsPerUnit,
+    int minSize,
+    int maxSize)
+{
+    // side^2 * uv2Coverage texels must cover surfaceArea * texelsPerUnit^2
+    float side = texelsPerUnit * std::sqrt(surfaceArea / std::max(uv2Coverage, 1e-4f));
+    int size = std::max(minSize, std::min(maxSize, static_cast<int>(std::ceil(side))));
+    return {size, size};
+}
+
 // ============================================
 // CLightmapAtlasBuilder Implementation
 // ============================================
@@ -161,19 +228,33 @@ bool CLightmapAtlasBuilder::Build(const SLightmapAtlasConfig& config)
     meshSizes.reserve(m_meshInfos.size());
 
     for (const auto& info : m_meshInfos) {
-        auto size = CLightmapAtlas::ComputeMeshLightmapSize(
-            info.boundsMin,
-            info.boundsMax,
-            config.texelsPerUnit,
-            4,    // minSize
-            512   // maxSize
-        );
+        float texelsPerUnit = config.texelsPerUnit * (info.texelDensityScale > 0.0f ? info.texelDensityScale : 1.0f);
+
+        std::pair<int, int> size;
+        if (info.surfaceArea > 0.0f && info.uv2Coverage > 0.0f) {
+            size = CLightmapAtlas::ComputeMeshLightmapSizeFromArea(
+                info.surfaceArea,
+                info.uv2Coverage,
+                texelsPerUnit,
+                4,    // minSize
+                512   // maxSize
+            );
+        } else {
+            size = CLightmapAtlas::ComputeMeshLightmapSize(
+                info.boundsMin,
+                info.boundsMax,
+                texelsPerUnit,
+                4,    // minSize
+                512   // maxSize
+            );
+        }
         meshSizes.push_back(size);
 
-        CFFLog::Info("[LightmapAtlasBuilder] Mesh %d: bounds (%.1f,%.1f,%.1f)-(%.1f,%.1f,%.1f) -> %dx%d texels",
+        CFFLog::Info("[LightmapAtlasBuilder] Mesh %d: bounds (%.1f,%.1f,%.1f)-(%.1f,%.1f,%.1f), area %.1f, density x%.2f -> %dx%d texels",
                     info.meshRendererIndex,
                     info.boundsMin.x, info.boundsMin.y, info.boundsMin.z,
                     info.boundsMax.x, info.boundsMax.y, info.boundsMax.z,
+                    info.surfaceArea, info.texelDensityScale,
                     size.first, size.second);
     }
 
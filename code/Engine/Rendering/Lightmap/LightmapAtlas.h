@@ -6,8 +6,9 @@
 // ============================================
 // Lightmap Atlas Packing
 // ============================================
-// Packs multiple meshes into a single lightmap atlas texture.
-// Uses a simple row-based packing algorithm.
+// Packs multiple meshes into lightmap atlas textures, with the shelf or the
+// MaxRects packer (SLightmapAtlasConfig::packer). Mesh regions are addressed
+// by scale/offset, so they are never rotated.
 
 class CLightmapAtlas {
 public:
@@ -28,6 +29,9 @@ public:
     int GetAtlasCount() const { return m_atlasCount; }
     int GetAtlasResolution() const { return m_resolution; }
 
+    // Texels covered by meshes / texels of all atlases, [0, 1]
+    float GetOccupancy() const { return m_occupancy; }
+
     // Compute scale/offset for shader binding
     // Returns float4: xy = scale, zw = offset
     static DirectX::XMFLOAT4 ComputeScaleOffset(
@@ -40,15 +44,30 @@ public:
     static std::pair<int, int> ComputeMeshLightmapSize(
         const DirectX::XMFLOAT3& boundsMin,
         const DirectX::XMFLOAT3& boundsMax,
-        int texelsPerUnit,
+        float texelsPerUnit,
+        int minSize = 4,
+        int maxSize = 512
+    );
+
+    // Compute lightmap size from the actual surface: a square region whose
+    // UV2 charts (uv2Coverage of [0,1]^2) get texelsPerUnit over surfaceArea
+    // (world units^2). Returns (width, height) in texels.
+    static std::pair<int, int> ComputeMeshLightmapSizeFromArea(
+        float surfaceArea,
+        float uv2Coverage,
+        float texelsPerUnit,
         int minSize = 4,
         int maxSize = 512
     );
 
 private:
+    bool packShelf(const std::vector<std::pair<int, int>>& meshSizes, const SLightmapAtlasConfig& config);
+    bool packMaxRects(const std::vector<std::pair<int, int>>& meshSizes, const SLightmapAtlasConfig& config);
+
     std::vector<SAtlasEntry> m_entries;
     int m_atlasCount = 0;
     int m_resolution = 1024;
+    float m_occupancy = 0.0f;
 };
 
 // ============================================
@@ -61,6 +80,9 @@ struct SLightmapMeshInfo {
     DirectX::XMFLOAT3 boundsMin;     // World-space AABB
     DirectX::XMFLOAT3 boundsMax;
     bool hasUV2;                     // Already has UV2?
+    float texelDensityScale = 1.0f;  // Per-object multiplier of config.texelsPerUnit
+    float surfaceArea = 0.0f;        // World-space triangle area (0 = unknown, size from bounds)
+    float uv2Coverage = 0.0f;        // Area of the UV2 charts in [0,1]^2
 };
 
 class CLightmapAtlasBuilder {
@@ -6,6 +6,7 @@
 #include "Engine/Rendering/RayTracing/SceneGeometryExport.h"
 #include "Core/FFLog.h"
 #include "Core/Mesh.h"
+#include "Core/GpuMeshResource.h"
 #include "Core/PathManager.h"
 #include "Core/Exporter/KTXExporter.h"
 #include "Core/RenderDocCapture.h"
@@ -16,6 +17,28 @@
 
 using namespace DirectX;
 
+// World-space triangle area of a mesh and the area its UV2 charts cover in [0,1]^2
+static void computeLightmapAreas(const SRayTracingMeshData& mesh, const XMMATRIX& worldMatrix,
+                                 float& outSurfaceArea, float& outUV2Coverage)
+{
+    double surfaceArea = 0.0;
+    double uvArea = 0.0;
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        uint32_t i0 = mesh.indices[t], i1 = mesh.indices[t + 1], i2 = mesh.indices[t + 2];
+        XMVECTOR p0 = XMVector3TransformCoord(XMLoadFloat3(&mesh.positions[i0]), worldMatrix);
+        XMVECTOR p1 = XMVector3TransformCoord(XMLoadFloat3(&mesh.positions[i1]), worldMatrix);
+        XMVECTOR p2 = XMVector3TransformCoord(XMLoadFloat3(&mesh.positions[i2]), worldMatrix);
+        surfaceArea += 0.5 * XMVectorGetX(XMVector3Length(XMVector3Cross(p1 - p0, p2 - p0)));
+
+        const XMFLOAT2& a = mesh.uv2[i0];
+        const XMFLOAT2& b = mesh.uv2[i1];
+        const XMFLOAT2& c = mesh.uv2[i2];
+        uvArea += 0.5 * std::abs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+    }
+    outSurfaceArea = (float)surfaceArea;
+    outUV2Coverage = (float)uvArea;
+}
+
 CLightmapBaker::CLightmapBaker() = default;
 CLightmapBaker::~CLightmapBaker() = default;
 
@@ -71,7 +94,11 @@ bool CLightmapBaker::Bake(CScene& scene, const Config& config, const std::string
 
     // Step 6: Transfer baked data directly to manager (avoids reload from disk)
     reportProgress(0.99f, "Transferring to runtime");
-    scene.GetLightmap2D().SetBakedData(std::move(m_gpuTexture), m_lightmapInfos);
+    if (m_gpuTexture) {
+        scene.GetLightmap2D().SetBakedData(std::move(m_gpuTexture), m_lightmapInfos);
+    } else {
+        CFFLog::Info("[LightmapBaker] No render context, lightmap saved to file only");
+    }
 
     reportProgress(1.0f, "Bake complete");
     CRenderDocCapture::EndFrameCapture();
@@ -141,7 +168,15 @@ bool CLightmapBaker::packAtlas(CScene& scene, const SLightmapAtlasConfig& config
         meshInfo.meshRendererIndex = i;
         meshInfo.boundsMin = worldMin;
         meshInfo.boundsMax = worldMax;
-        meshInfo.hasUV2 = false;  // TODO: Check actual UV2 availability
+        meshInfo.texelDensityScale = meshRenderer->lightmapScale;
+
+        // Size the region from the real surface when the UV2 is cached
+        uint32_t subMesh = meshRenderer->meshes.empty() ? 0 : meshRenderer->meshes[0]->subMeshIndex;
+        const SRayTracingMeshData* meshData = CRayTracingMeshCache::Instance().GetMeshData(meshRenderer->path, subMesh);
+        meshInfo.hasUV2 = meshData && !meshData->uv2.empty() && meshData->uv2.size() == meshData->positions.size();
+        if (meshInfo.hasUV2) {
+            computeLightmapAreas(*meshData, worldMatrix, meshInfo.surfaceArea, meshInfo.uv2Coverage);
+        }
 
         m_atlasBuilder.AddMesh(meshInfo);
         meshCount++;
@@ -157,6 +192,14 @@ bool CLightmapBaker::packAtlas(CScene& scene, const SLightmapAtlasConfig& config
         return false;
     }
 
+    // The bake path renders a single atlas texture: entries on later pages would be
+    // rasterized over page 0 and point at lightmap indices that are never written
+    if (m_atlasBuilder.GetAtlas().GetAtlasCount() > 1) {
+        CFFLog::Error("[LightmapBaker] Meshes need %d atlases of %d^2, only one is supported (raise resolution or lower texelsPerUnit)",
+                      m_atlasBuilder.GetAtlas().GetAtlasCount(), config.resolution);
+        return false;
+    }
+
     // Store results
     m_lightmapInfos = m_atlasBuilder.GetLightmapInfos();
     m_atlasWidth = config.resolution;
@@ -193,7 +236,8 @@ bool CLightmapBaker::rasterize(CScene& scene)
 
         // Get mesh data from ray tracing cache (includes UV2)
         // Note: Mesh must be loaded with cacheForRayTracing=true and generateLightmapUV2=true
-        const SRayTracingMeshData* meshData = meshCache.GetMeshData(meshRenderer->path, 0);
+        uint32_t subMesh = meshRenderer->meshes.empty() ? 0 : meshRenderer->meshes[0]->subMeshIndex;
+        const SRayTracingMeshData* meshData = meshCache.GetMeshData(meshRenderer->path, subMesh);
         if (!meshData) {
             CFFLog::Warning("[LightmapBaker] Mesh data not cached: %s (skipping)", meshRenderer->path.c_str());
             continue;
@@ -205,8 +249,8 @@ bool CLightmapBaker::rasterize(CScene& scene)
             continue;
         }
 
-        // Rasterize using mesh's UV2 data
-        m_rasterizer.RasterizeMesh(
+        // Queue the mesh's UV2 data; the cache keeps it alive until Rasterize()
+        m_rasterizer.AddMesh(
             meshData->positions,
             meshData->normals,
             meshData->uv2,
@@ -217,6 +261,9 @@ bool CLightmapBaker::rasterize(CScene& scene)
         );
     }
 
+    // All meshes at once: setup is parallel over meshes, raster over atlas tiles
+    m_rasterizer.Rasterize();
+
     int validCount = m_rasterizer.GetValidTexelCount();
     CFFLog::Info("[LightmapBaker] Rasterized %d valid texels", validCount);
 
@@ -225,19 +272,22 @@ bool CLightmapBaker::rasterize(CScene& scene)
 
 bool CLightmapBaker::bakeIrradiance(CScene& scene, const SLightmap2DBakeConfig& config)
 {
-    // Initialize GPU baker if not already done (lazy init, reused across bakes)
-    if (!m_gpuBaker.IsAvailable()) {
-        if (!m_gpuBaker.Initialize()) {
-            CFFLog::Error("[LightmapBaker] Failed to initialize GPU baker");
-            return false;
-        }
+    m_gpuTexture.reset();
+    m_bakedOnCPU = false;
 
-        if (!m_gpuBaker.IsAvailable()) {
-            CFFLog::Error("[LightmapBaker] DXR not available for GPU baking");
-            return false;
+    if (config.useGPU) {
+        // Lazy init, reused across bakes (avoids shader recompilation)
+        if (m_gpuBaker.IsAvailable() && m_gpuBaker.Initialize()) {
+            return bakeIrradianceGPU(scene, config);
         }
+        CFFLog::Warning("[LightmapBaker] DXR not available for GPU baking, falling back to CPU");
     }
 
+    return bakeIrradianceCPU(scene, config);
+}
+
+bool CLightmapBaker::bakeIrradianceGPU(CScene& scene, const SLightmap2DBakeConfig& config)
+{
     // Configure GPU bake
     SLightmap2DGPUBakeConfig gpuConfig;
     gpuConfig.samplesPerTexel = config.samplesPerTexel;
@@ -263,6 +313,32 @@ bool CLightmapBaker::bakeIrradiance(CScene& scene, const SLightmap2DBakeConfig&
     return true;
 }
 
+bool CLightmapBaker::bakeIrradianceCPU(CScene& scene, const SLightmap2DBakeConfig& config)
+{
+    SLightmap2DCPUBakeConfig cpuConfig;
+    cpuConfig.samplesPerTexel = config.samplesPerTexel;
+    cpuConfig.maxBounces = config.maxBounces;
+    cpuConfig.skyIntensity = config.skyIntensity;
+    cpuConfig.enableDenoiser = config.enableDenoiser;
+    cpuConfig.progressCallback = [this](float progress, const char* stage) {
+        // Same range as the GPU bake (0.30 - 0.95)
+        float mappedProgress = 0.30f + progress * 0.65f;
+        reportProgress(mappedProgress, stage);
+    };
+
+    if (!m_cpuBaker.BakeLightmap(scene, m_rasterizer, cpuConfig)) {
+        CFFLog::Error("[LightmapBaker] CPU baking failed");
+        return false;
+    }
+    m_bakedOnCPU = true;
+
+    // Upload for immediate use; stays null without a render context
+    m_gpuTexture = m_cpuBaker.CreateTexture();
+
+    CFFLog::Info("[LightmapBaker] CPU baking complete (%dx%d)", m_atlasWidth, m_atlasHeight);
+    return true;
+}
+
 void CLightmapBaker::assignLightmapIndices(CScene& scene)
 {
     auto& world = scene.GetWorld();
@@ -302,7 +378,7 @@ bool CLightmapBaker::saveToFile(const std::string& lightmapPath)
         return false;
     }
 
-    if (!m_gpuTexture) {
+    if (!m_gpuTexture && !m_bakedOnCPU) {
         CFFLog::Error("[LightmapBaker] No atlas texture to save");
         return false;
     }
@@ -339,7 +415,11 @@ bool CLightmapBaker::saveToFile(const std::string& lightmapPath)
 
     // Save atlas.ktx2
     std::string atlasPath = absLightmapPath + "/atlas.ktx2";
-    if (!CKTXExporter::Export2DTextureToKTX2(m_gpuTexture.get(), atlasPath)) {
+    bool exported = m_bakedOnCPU
+        ? CKTXExporter::Export2DFromFloat4Buffer(m_cpuBaker.GetAtlas().data(),
+                                                 (int)m_cpuBaker.GetAtlasWidth(), (int)m_cpuBaker.GetAtlasHeight(), atlasPath)
+        : CKTXExporter::Export2DTextureToKTX2(m_gpuTexture.get(), atlasPath);
+    if (!exported) {
         CFFLog::Error("[LightmapBaker] Failed to export atlas texture: %s", atlasPath.c_str());
         return false;
     }
@@ -3,6 +3,7 @@
 #include "LightmapAtlas.h"
 #include "LightmapRasterizer.h"
 #include "Lightmap2DGPUBaker.h"
+#include "Lightmap2DCPUBaker.h"
 #include "RHI/RHIPointers.h"
 #include <vector>
 #include <DirectXMath.h>
@@ -56,6 +57,8 @@ private:
     bool packAtlas(CScene& scene, const SLightmapAtlasConfig& config);
     bool rasterize(CScene& scene);
     bool bakeIrradiance(CScene& scene, const SLightmap2DBakeConfig& config);
+    bool bakeIrradianceGPU(CScene& scene, const SLightmap2DBakeConfig& config);
+    bool bakeIrradianceCPU(CScene& scene, const SLightmap2DBakeConfig& config);
     void assignLightmapIndices(CScene& scene);
     bool saveToFile(const std::string& lightmapPath);
 
@@ -65,7 +68,9 @@ private:
     CLightmapAtlasBuilder m_atlasBuilder;
     CLightmapRasterizer m_rasterizer;
     CLightmap2DGPUBaker m_gpuBaker;  // Reused across bakes (avoids shader recompilation)
-    RHI::TexturePtr m_gpuTexture;
+    CLightmap2DCPUBaker m_cpuBaker;  // Fallback without DXR (headless / build farm)
+    RHI::TexturePtr m_gpuTexture;    // Atlas texture; null after a headless CPU bake
+    bool m_bakedOnCPU = false;       // Atlas data lives in m_cpuBaker
     std::vector<SLightmapInfo> m_lightmapInfos;
 
     int m_atlasWidth = 0;
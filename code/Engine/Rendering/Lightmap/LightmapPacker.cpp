@@ -0,0 +1,175 @@
+#include "LightmapPacker.h"
+#include "Core/FFLog.h"
+#include <algorithm>
+#include <numeric>
+
+// ============================================
+// CMaxRectsPacker Implementation
+// ============================================
+
+bool CMaxRectsPacker::Pack(const std::vector<SPackRect>& rects, int pageSize, int padding, int maxPages)
+{
+    m_pageSize = pageSize;
+    m_pages.clear();
+    m_placements.assign(rects.size(), SPackPlacement());
+    m_stats = SPackStats();
+
+    // Longest side first, then area: big items get the empty pages, small
+    // ones fill the gaps
+    std::vector<size_t> order(rects.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&rects](size_t a, size_t b) {
+        int longA = std::max(rects[a].width, rects[a].height);
+        int longB = std::max(rects[b].width, rects[b].height);
+        if (longA != longB) return longA > longB;
+        return rects[a].width * rects[a].height > rects[b].width * rects[b].height;
+    });
+
+    bool success = true;
+    for (size_t i : order) {
+        const SPackRect& rect = rects[i];
+        const int w = rect.width + padding;
+        const int h = rect.height + padding;
+        // Pages are square: rotating never makes an item fit
+        if (rect.width <= 0 || rect.height <= 0 || w > pageSize || h > pageSize) {
+            CFFLog::Error("[LightmapPacker] Item %d too large for page (%dx%d + padding %d > %d)",
+                         (int)i, rect.width, rect.height, padding, pageSize);
+            success = false;
+            continue;
+        }
+
+        int bestPage = -1;
+        SFreeRect bestRect = {};
+        bool bestRotated = false;
+        int64_t bestScore = INT64_MAX;
+        for (size_t p = 0; p < m_pages.size(); p++) {
+            SFreeRect candidate;
+            bool rotated;
+            int64_t score;
+            if (FindPosition(m_pages[p], w, h, rect.allowRotation, candidate, rotated, score) && score < bestScore) {
+                bestPage = (int)p;
+                bestRect = candidate;
+                bestRotated = rotated;
+                bestScore = score;
+            }
+        }
+
+        if (bestPage < 0) {
+            if (maxPages > 0 && (int)m_pages.size() >= maxPages) {
+                success = false;
+                continue;
+            }
+            SPage page;
+            page.freeRects.push_back({0, 0, pageSize, pageSize});
+            m_pages.push_back(std::move(page));
+            bestPage = (int)m_pages.size() - 1;
+            FindPosition(m_pages[bestPage], w, h, rect.allowRotation, bestRect, bestRotated, bestScore);
+        }
+
+        SPage& page = m_pages[bestPage];
+        PlaceRect(page, bestRect);
+        page.usedTexels += (int64_t)rect.width * rect.height;
+
+        SPackPlacement& placement = m_placements[i];
+        placement.page = bestPage;
+        placement.x = bestRect.x;
+        placement.y = bestRect.y;
+        placement.rotated = bestRotated;
+        placement.width = bestRotated ? rect.height : rect.width;
+        placement.height = bestRotated ? rect.width : rect.height;
+    }
+
+    UpdateStats();
+    return success;
+}
+
+bool CMaxRectsPacker::FindPosition(const SPage& page, int w, int h, bool allowRotation,
+                                   SFreeRect& outRect, bool& outRotated, int64_t& outScore) const
+{
+    bool found = false;
+    outScore = INT64_MAX;
+
+    auto consider = [&](const SFreeRect& free, int fw, int fh, bool rotated) {
+        if (fw > free.w || fh > free.h) return;
+        int leftoverW = free.w - fw;
+        int leftoverH = free.h - fh;
+        int64_t shortSide = std::min(leftoverW, leftoverH);
+        int64_t longSide = std::max(leftoverW, leftoverH);
+        int64_t score = (shortSide << 32) | longSide;
+        if (score < outScore) {
+            outScore = score;
+            outRect = {free.x, free.y, fw, fh};
+            outRotated = rotated;
+            found = true;
+        }
+    };
+
+    for (const SFreeRect& free : page.freeRects) {
+        consider(free, w, h, false);
+        if (allowRotation && w != h) consider(free, h, w, true);
+    }
+    return found;
+}
+
+void CMaxRectsPacker::PlaceRect(SPage& page, const SFreeRect& used)
+{
+    std::vector<SFreeRect> kept;
+    std::vector<SFreeRect> split;
+    kept.reserve(page.freeRects.size());
+
+    for (const SFreeRect& free : page.freeRects) {
+        if (used.x >= free.x + free.w || used.x + used.w <= free.x ||
+            used.y >= free.y + free.h || used.y + used.h <= free.y) {
+            kept.push_back(free);
+            continue;
+        }
+        // Up to 4 maximal pieces of free around the used rectangle
+        if (used.x > free.x)
+            split.push_back({free.x, free.y, used.x - free.x, free.h});
+        if (used.x + used.w < free.x + free.w)
+            split.push_back({used.x + used.w, free.y, free.x + free.w - (used.x + used.w), free.h});
+        if (used.y > free.y)
+            split.push_back({free.x, free.y, free.w, used.y - free.y});
+        if (used.y + used.h < free.y + free.h)
+            split.push_back({free.x, used.y + used.h, free.w, free.y + free.h - (used.y + used.h)});
+    }
+
+    auto contains = [](const SFreeRect& outer, const SFreeRect& inner) {
+        return inner.x >= outer.x && inner.y >= outer.y &&
+               inner.x + inner.w <= outer.x + outer.w && inner.y + inner.h <= outer.y + outer.h;
+    };
+
+    // The pieces lie inside rectangles of a maximal set, so they can never
+    // contain an untouched rectangle: only the pieces need checking, against
+    // each other and against the untouched ones
+    std::vector<bool> removed(split.size(), false);
+    for (size_t i = 0; i < split.size(); i++) {
+        for (size_t j = 0; j < split.size() && !removed[i]; j++) {
+            if (i != j && !removed[j] && contains(split[j], split[i])) removed[i] = true;
+        }
+        for (size_t j = 0; j < kept.size() && !removed[i]; j++) {
+            if (contains(kept[j], split[i])) removed[i] = true;
+        }
+    }
+
+    page.freeRects = std::move(kept);
+    for (size_t i = 0; i < split.size(); i++) {
+        if (!removed[i]) page.freeRects.push_back(split[i]);
+    }
+}
+
+void CMaxRectsPacker::UpdateStats()
+{
+    m_stats.pageCount = (int)m_pages.size();
+    m_stats.placedCount = 0;
+    for (const SPackPlacement& placement : m_placements) {
+        if (placement.page >= 0) m_stats.placedCount++;
+    }
+
+    const double pageTexels = (double)m_pageSize * m_pageSize;
+    for (const SPage& page : m_pages) {
+        m_stats.usedTexels += page.usedTexels;
+        m_stats.pageOccupancy.push_back((float)(page.usedTexels / pageTexels));
+    }
+    m_stats.occupancy = m_pages.empty() ? 0.0f : (float)(m_stats.usedTexels / (pageTexels * m_pages.size()));
+}
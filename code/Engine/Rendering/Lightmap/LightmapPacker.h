@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// ============================================
+// MaxRects Atlas Packer
+// ============================================
+// Packs rectangles (whole-mesh lightmap regions or individual UV charts)
+// into square pages. MaxRects with best-short-side-fit (J. Jylanki, "A
+// Thousand Ways to Pack the Bin"):
+//   - every page keeps the list of maximal free rectangles
+//   - items are placed largest first, each into the free rectangle with the
+//     best short-side fit over all open pages, rotated by 90 degrees when
+//     allowed and tighter
+//   - a new page is opened only when no open page can hold the item
+//
+// Compared to the shelf packer, the space left above short items in a row is
+// still available to later items, so pages fill up before new ones open.
+
+struct SPackRect {
+    int width = 0;
+    int height = 0;
+    bool allowRotation = false;     // The owner must swap its UV axes if the item comes back rotated
+};
+
+struct SPackPlacement {
+    int page = -1;                  // -1 = not placed
+    int x = 0;
+    int y = 0;
+    int width = 0;                  // As placed (swapped when rotated)
+    int height = 0;
+    bool rotated = false;
+};
+
+struct SPackStats {
+    int pageCount = 0;
+    int placedCount = 0;
+    int64_t usedTexels = 0;         // Item area, padding excluded
+    float occupancy = 0.0f;         // usedTexels / (pageCount * pageSize^2)
+    std::vector<float> pageOccupancy;
+};
+
+class CMaxRectsPacker {
+public:
+    // padding: texels kept free right of and below each item (as the shelf packer)
+    // maxPages: 0 = unlimited
+    // Returns false if an item is larger than a page or maxPages is reached;
+    // the items placed so far keep their placement.
+    bool Pack(const std::vector<SPackRect>& rects, int pageSize, int padding, int maxPages = 0);
+
+    const std::vector<SPackPlacement>& GetPlacements() const { return m_placements; }
+    const SPackStats& GetStats() const { return m_stats; }
+
+private:
+    struct SFreeRect {
+        int x, y, w, h;
+    };
+
+    struct SPage {
+        std::vector<SFreeRect> freeRects;
+        int64_t usedTexels = 0;
+    };
+
+    // Best free rectangle of a page for a w x h footprint (score: lower is better)
+    bool FindPosition(const SPage& page, int w, int h, bool allowRotation,
+                      SFreeRect& outRect, bool& outRotated, int64_t& outScore) const;
+
+    // Cut the footprint out of every free rectangle it overlaps, then drop
+    // free rectangles contained in others
+    void PlaceRect(SPage& page, const SFreeRect& used);
+
+    void UpdateStats();
+
+    int m_pageSize = 0;
+    std::vector<SPage> m_pages;
+    std::vector<SPackPlacement> m_placements;
+    SPackStats m_stats;
+};
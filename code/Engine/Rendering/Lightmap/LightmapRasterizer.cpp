@@ -1,8 +1,15 @@
 #include "LightmapRasterizer.h"
 #include "Core/FFLog.h"
+#include "Core/Jobs/JobSystem.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 
+#if FF_RASTER_SIMD
+#include <emmintrin.h>
+#endif
+
 using namespace DirectX;
 
 void CLightmapRasterizer::Initialize(int atlasWidth, int atlasHeight)
@@ -11,12 +18,15 @@ void CLightmapRasterizer::Initialize(int atlasWidth, int atlasHeight)
     m_height = atlasHeight;
     m_texels.clear();
     m_texels.resize(static_cast<size_t>(m_width) * m_height);
+    m_pending.clear();
+    m_stats = SLightmapRasterStats();
 
     // Initialize all texels as invalid
     for (auto& texel : m_texels) {
         texel.valid = false;
         texel.worldPos = {0, 0, 0};
         texel.normal = {0, 1, 0};
+        texel.coverage = 0.0f;
     }
 }
 
@@ -24,6 +34,7 @@ void CLightmapRasterizer::Clear()
 {
     for (auto& texel : m_texels) {
         texel.valid = false;
+        texel.coverage = 0.0f;
     }
 }
 
@@ -36,7 +47,7 @@ int CLightmapRasterizer::GetValidTexelCount() const
     return count;
 }
 
-void CLightmapRasterizer::RasterizeMesh(
+void CLightmapRasterizer::AddMesh(
     const std::vector<XMFLOAT3>& positions,
     const std::vector<XMFLOAT3>& normals,
     const std::vector<XMFLOAT2>& uv2,
@@ -54,124 +65,452 @@ void CLightmapRasterizer::RasterizeMesh(
         return;
     }
 
-    // Transform positions and normals to world space
-    std::vector<XMFLOAT3> worldPositions(positions.size());
-    std::vector<XMFLOAT3> worldNormals(normals.size());
+    SMeshInput input;
+    input.positions = &positions;
+    input.normals = &normals;
+    input.uv2 = &uv2;
+    input.indices = &indices;
+    XMStoreFloat4x4(&input.worldMatrix, worldMatrix);
+    input.offsetX = atlasOffsetX;
+    input.offsetY = atlasOffsetY;
+    input.regionWidth = regionWidth;
+    input.regionHeight = regionHeight;
+    m_pending.push_back(input);
+}
 
-    // Normal matrix = transpose(inverse(worldMatrix))
-    // For uniform scale, this is just the rotation part
-    XMMATRIX normalMatrix = XMMatrixTranspose(XMMatrixInverse(nullptr, worldMatrix));
+void CLightmapRasterizer::RasterizeMesh(
+    const std::vector<XMFLOAT3>& positions,
+    const std::vector<XMFLOAT3>& normals,
+    const std::vector<XMFLOAT2>& uv2,
+    const std::vector<uint32_t>& indices,
+    const XMMATRIX& worldMatrix,
+    int atlasOffsetX, int atlasOffsetY,
+    int regionWidth, int regionHeight)
+{
+    AddMesh(positions, normals, uv2, indices, worldMatrix, atlasOffsetX, atlasOffsetY, regionWidth, regionHeight);
+    Rasterize();
+}
+
+void CLightmapRasterizer::Rasterize()
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+    m_stats = SLightmapRasterStats();
+    m_stats.meshCount = (int)m_pending.size();
+
+    auto& jobs = CJobSystem::Instance();
+    const bool parallel = m_config.multithreaded;
+
+    // 1. Setup
+    m_setups.assign(m_pending.size(), SMeshSetup());
+    auto setupRange = [this](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) setupMesh(m_pending[i], i, m_setups[i]);
+    };
+    if (parallel) {
+        jobs.ParallelFor((uint32_t)m_pending.size(), 1, setupRange);
+    } else {
+        setupRange(0, (uint32_t)m_pending.size());
+    }
+
+    // 2. Binning: count, prefix sum, fill. Submission order is kept so
+    //    ties resolve the same way on any thread count
+    const int tileSize = std::max(8, m_config.tileSize);
+    const int tilesX = (m_width + tileSize - 1) / tileSize;
+    const int tilesY = (m_height + tileSize - 1) / tileSize;
+    const size_t tileCount = (size_t)tilesX * tilesY;
+    auto forEachTile = [tileSize, tilesX](const STriangleSetup& tri, auto&& func) {
+        for (int ty = tri.minY / tileSize; ty <= tri.maxY / tileSize; ty++) {
+            for (int tx = tri.minX / tileSize; tx <= tri.maxX / tileSize; tx++) {
+                func((size_t)ty * tilesX + tx);
+            }
+        }
+    };
+    std::vector<uint32_t> binStart(tileCount + 1, 0);
+    for (const SMeshSetup& setup : m_setups) {
+        for (const STriangleSetup& tri : setup.triangles) {
+            forEachTile(tri, [&binStart](size_t t) { binStart[t + 1]++; });
+        }
+        m_stats.triangleCount += (int)setup.triangles.size();
+    }
+    for (size_t t = 0; t < tileCount; t++) binStart[t + 1] += binStart[t];
+    std::vector<const STriangleSetup*> binned(binStart.back());
+    std::vector<uint32_t> cursor(binStart.begin(), binStart.end() - 1);
+    for (const SMeshSetup& setup : m_setups) {
+        for (const STriangleSetup& tri : setup.triangles) {
+            forEachTile(tri, [&binned, &cursor, &tri](size_t t) { binned[cursor[t]++] = &tri; });
+        }
+    }
 
+    // 3. Raster, and count the texels of every tile
+    std::atomic<int> covered{0}, partial{0};
+    auto tileRange = [&](uint32_t begin, uint32_t end) {
+        std::vector<float> bestCoverage((size_t)tileSize * tileSize);
+        int tileCovered = 0, tilePartial = 0;
+        for (uint32_t t = begin; t < end; t++) {
+            rasterizeTile((int)(t % tilesX), (int)(t / tilesX), binned.data() + binStart[t],
+                          binStart[t + 1] - binStart[t], bestCoverage, tileCovered, tilePartial);
+        }
+        covered += tileCovered;
+        partial += tilePartial;
+    };
+    if (parallel) {
+        jobs.ParallelFor((uint32_t)tileCount, 1, tileRange);
+    } else {
+        tileRange(0, (uint32_t)tileCount);
+    }
+    m_stats.coveredTexels = covered;
+    m_stats.partialTexels = partial;
+
+    m_setups.clear();
+    m_pending.clear();
+    m_stats.milliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+
+    CFFLog::Info("[LightmapRasterizer] %d meshes, %d triangles -> %d texels (%d partial, %s) in %.2f ms",
+                 m_stats.meshCount, m_stats.triangleCount, m_stats.coveredTexels, m_stats.partialTexels,
+                 m_config.conservative ? "conservative" : "centre",
+                 m_stats.milliseconds);
+}
+
+// ============================================
+// Setup
+// ============================================
+
+// SSE2 has no roundss: avoid the libm call per triangle corner
+static inline int floorToInt(float x)
+{
+    int i = (int)x;
+    return i - (x < (float)i ? 1 : 0);
+}
+
+static inline int ceilToInt(float x)
+{
+    int i = (int)x;
+    return i + (x > (float)i ? 1 : 0);
+}
+
+void CLightmapRasterizer::setupMesh(const SMeshInput& input, uint32_t meshIndex, SMeshSetup& out) const
+{
+    const auto& positions = *input.positions;
+    const auto& normals = *input.normals;
+    const auto& uv2 = *input.uv2;
+    const auto& indices = *input.indices;
+
+    // Transform positions and normals to world space
+    XMMATRIX worldMatrix = XMLoadFloat4x4(&input.worldMatrix);
+    XMMATRIX normalMatrix = XMMatrixTranspose(XMMatrixInverse(nullptr, worldMatrix));
+    out.worldPositions.resize(positions.size());
+    out.worldNormals.resize(normals.size());
     for (size_t i = 0; i < positions.size(); i++) {
-        // Transform position
-        XMVECTOR pos = XMLoadFloat3(&positions[i]);
-        pos = XMVector3TransformCoord(pos, worldMatrix);
-        XMStoreFloat3(&worldPositions[i], pos);
-
-        // Transform normal
-        XMVECTOR norm = XMLoadFloat3(&normals[i]);
-        norm = XMVector3TransformNormal(norm, normalMatrix);
-        norm = XMVector3Normalize(norm);
-        XMStoreFloat3(&worldNormals[i], norm);
-    }
-
-    // Rasterize each triangle
-    size_t triangleCount = indices.size() / 3;
-    for (size_t t = 0; t < triangleCount; t++) {
-        uint32_t i0 = indices[t * 3 + 0];
-        uint32_t i1 = indices[t * 3 + 1];
-        uint32_t i2 = indices[t * 3 + 2];
-
-        rasterizeTriangle(
-            worldPositions[i0], worldPositions[i1], worldPositions[i2],
-            worldNormals[i0], worldNormals[i1], worldNormals[i2],
-            uv2[i0], uv2[i1], uv2[i2],
-            atlasOffsetX, atlasOffsetY,
-            regionWidth, regionHeight
-        );
+        XMStoreFloat3(&out.worldPositions[i], XMVector3TransformCoord(XMLoadFloat3(&positions[i]), worldMatrix));
+        XMStoreFloat3(&out.worldNormals[i],
+                      XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&normals[i]), normalMatrix)));
+    }
+
+    // Texels outside the region (and the atlas) are never touched
+    const int regionMinX = std::max(0, input.offsetX);
+    const int regionMinY = std::max(0, input.offsetY);
+    const int regionMaxX = std::min(m_width, input.offsetX + input.regionWidth) - 1;
+    const int regionMaxY = std::min(m_height, input.offsetY + input.regionHeight) - 1;
+
+    out.triangles.reserve(indices.size() / 3);
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        STriangleSetup tri;
+        tri.mesh = meshIndex;
+        float x[3], y[3];
+        for (int k = 0; k < 3; k++) {
+            tri.v[k] = indices[t + k];
+            x[k] = uv2[tri.v[k]].x * input.regionWidth + input.offsetX;
+            y[k] = uv2[tri.v[k]].y * input.regionHeight + input.offsetY;
+        }
+
+        // Texels whose square overlaps the triangle's bounds
+        tri.minX = std::max(regionMinX, floorToInt(std::min(x[0], std::min(x[1], x[2]))));
+        tri.minY = std::max(regionMinY, floorToInt(std::min(y[0], std::min(y[1], y[2]))));
+        tri.maxX = std::min(regionMaxX, ceilToInt(std::max(x[0], std::max(x[1], x[2]))) - 1);
+        tri.maxY = std::min(regionMaxY, ceilToInt(std::max(y[0], std::max(y[1], y[2]))) - 1);
+        if (tri.minX > tri.maxX || tri.minY > tri.maxY) continue;
+
+        // Edge functions relative to the bounds origin keep float precision
+        // independent of where the region sits in the atlas
+        for (int k = 0; k < 3; k++) {
+            x[k] -= (float)tri.minX;
+            y[k] -= (float)tri.minY;
+        }
+        for (int i = 0; i < 3; i++) {
+            int j = (i + 1) % 3, k = (i + 2) % 3;
+            tri.a[i] = y[j] - y[k];
+            tri.b[i] = x[k] - x[j];
+            tri.c[i] = -(tri.a[i] * x[j] + tri.b[i] * y[j]);
+        }
+        float area2 = tri.a[0] * x[0] + tri.b[0] * y[0] + tri.c[0];
+        if (std::abs(area2) < 1e-8f) continue;  // Degenerate in UV space
+
+        // Either UV winding: flip so the interior is positive
+        if (area2 < 0.0f) {
+            for (int i = 0; i < 3; i++) {
+                tri.a[i] = -tri.a[i];
+                tri.b[i] = -tri.b[i];
+                tri.c[i] = -tri.c[i];
+            }
+            area2 = -area2;
+        }
+        tri.invArea2 = 1.0f / area2;
+
+        // Conservative: a texel square reaches into edge i's half-plane when
+        // E_i(centre) + h_i > 0, and lies inside it when E_i(centre) >= h_i
+        for (int i = 0; i < 3; i++) {
+            tri.h[i] = 0.5f * (std::abs(tri.a[i]) + std::abs(tri.b[i]));
+        }
+
+        // Top-left: the interior lies to the right of the edge, or below a horizontal one
+        for (int i = 0; i < 3; i++) {
+            tri.topLeft[i] = tri.a[i] > 0.0f || (tri.a[i] == 0.0f && tri.b[i] > 0.0f);
+        }
+        out.triangles.push_back(tri);
     }
 }
 
-void CLightmapRasterizer::rasterizeTriangle(
-    const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2,
-    const XMFLOAT3& n0, const XMFLOAT3& n1, const XMFLOAT3& n2,
-    const XMFLOAT2& uv0, const XMFLOAT2& uv1, const XMFLOAT2& uv2,
-    int offsetX, int offsetY,
-    int regionWidth, int regionHeight)
+// ============================================
+// Raster
+// ============================================
+
+void CLightmapRasterizer::rasterizeTile(int tileX, int tileY, const STriangleSetup* const* triangles, size_t triangleCount,
+                                        std::vector<float>& bestCoverage, int& outCovered, int& outPartial)
 {
-    // Convert UV [0,1] to pixel coordinates within the region
-    float x0 = uv0.x * regionWidth + offsetX;
-    float y0 = uv0.y * regionHeight + offsetY;
-    float x1 = uv1.x * regionWidth + offsetX;
-    float y1 = uv1.y * regionHeight + offsetY;
-    float x2 = uv2.x * regionWidth + offsetX;
-    float y2 = uv2.y * regionHeight + offsetY;
-
-    // Compute bounding box
-    int minX = std::max(0, static_cast<int>(std::floor(std::min({x0, x1, x2}))));
-    int maxX = std::min(m_width - 1, static_cast<int>(std::ceil(std::max({x0, x1, x2}))));
-    int minY = std::max(0, static_cast<int>(std::floor(std::min({y0, y1, y2}))));
-    int maxY = std::min(m_height - 1, static_cast<int>(std::ceil(std::max({y0, y1, y2}))));
-
-    // Rasterize
-    for (int py = minY; py <= maxY; py++) {
-        for (int px = minX; px <= maxX; px++) {
-            // Texel center
-            float cx = px + 0.5f;
-            float cy = py + 0.5f;
-
-            // Compute barycentric coordinates
-            float lambda0, lambda1, lambda2;
-            if (!computeBarycentric(cx, cy, x0, y0, x1, y1, x2, y2, lambda0, lambda1, lambda2)) {
-                continue;  // Outside triangle
+    const int tileSize = std::max(8, m_config.tileSize);
+    const int tileX0 = tileX * tileSize;
+    const int tileY0 = tileY * tileSize;
+    const int tileX1 = std::min(tileX0 + tileSize, m_width) - 1;
+    const int tileY1 = std::min(tileY0 + tileSize, m_height) - 1;
+
+    auto countTexels = [&]() {
+        for (int y = tileY0; y <= tileY1; y++) {
+            for (int x = tileX0; x <= tileX1; x++) {
+                const STexelData& texel = m_texels[(size_t)y * m_width + x];
+                outCovered += texel.valid ? 1 : 0;
+                outPartial += texel.valid && texel.coverage < 1.0f ? 1 : 0;
             }
+        }
+    };
+    if (triangleCount == 0) {
+        countTexels();
+        return;
+    }
 
-            // Texel index
-            int idx = py * m_width + px;
-
-            // Interpolate world position
-            m_texels[idx].worldPos.x = lambda0 * p0.x + lambda1 * p1.x + lambda2 * p2.x;
-            m_texels[idx].worldPos.y = lambda0 * p0.y + lambda1 * p1.y + lambda2 * p2.y;
-            m_texels[idx].worldPos.z = lambda0 * p0.z + lambda1 * p1.z + lambda2 * p2.z;
-
-            // Interpolate and normalize normal
-            float nx = lambda0 * n0.x + lambda1 * n1.x + lambda2 * n2.x;
-            float ny = lambda0 * n0.y + lambda1 * n1.y + lambda2 * n2.y;
-            float nz = lambda0 * n0.z + lambda1 * n1.z + lambda2 * n2.z;
-            float len = std::sqrt(nx * nx + ny * ny + nz * nz);
-            if (len > 1e-6f) {
-                m_texels[idx].normal = {nx / len, ny / len, nz / len};
-            } else {
-                m_texels[idx].normal = {0, 1, 0};
+    // Texels written by an earlier Rasterize() keep their coverage
+    for (int y = tileY0; y <= tileY1; y++) {
+        for (int x = tileX0; x <= tileX1; x++) {
+            const STexelData& texel = m_texels[(size_t)y * m_width + x];
+            bestCoverage[(size_t)(y - tileY0) * tileSize + (x - tileX0)] = texel.valid ? texel.coverage : 0.0f;
+        }
+    }
+
+    for (size_t i = 0; i < triangleCount; i++) {
+        const STriangleSetup* tri = triangles[i];
+        int x0 = std::max(tri->minX, tileX0), x1 = std::min(tri->maxX, tileX1);
+        int y0 = std::max(tri->minY, tileY0), y1 = std::min(tri->maxY, tileY1);
+        if (x0 > x1 || y0 > y1) continue;
+
+#if FF_RASTER_SIMD
+        if (m_config.kernel == ERasterKernel::SIMD) {
+            rasterizeTriangleSIMD(*tri, x0, y0, x1, y1, tileX0, tileY0, bestCoverage);
+            continue;
+        }
+#endif
+        rasterizeTriangleScalar(*tri, x0, y0, x1, y1, tileX0, tileY0, bestCoverage);
+    }
+    countTexels();
+}
+
+// Overlap of the texel [0,1]^2 with the triangle, clipped by the three edges
+// (Sutherland-Hodgman). Returns the area and its centroid in (outU, outV).
+static float clipTexel(const float e[3], const float a[3], const float b[3], float& outU, float& outV)
+{
+    float polyU[8] = {0, 1, 1, 0}, polyV[8] = {0, 0, 1, 1};
+    int count = 4;
+    for (int i = 0; i < 3 && count > 0; i++) {
+        float clipU[8], clipV[8], d[8];
+        int clipped = 0;
+        for (int k = 0; k < count; k++) {
+            d[k] = e[i] + a[i] * (polyU[k] - 0.5f) + b[i] * (polyV[k] - 0.5f);
+        }
+        for (int k = 0; k < count; k++) {
+            int n = (k + 1) % count;
+            if (d[k] >= 0.0f) {
+                clipU[clipped] = polyU[k];
+                clipV[clipped] = polyV[k];
+                clipped++;
+            }
+            if ((d[k] >= 0.0f) != (d[n] >= 0.0f)) {
+                float t = d[k] / (d[k] - d[n]);
+                clipU[clipped] = polyU[k] + t * (polyU[n] - polyU[k]);
+                clipV[clipped] = polyV[k] + t * (polyV[n] - polyV[k]);
+                clipped++;
             }
+        }
+        count = clipped;
+        std::copy(clipU, clipU + count, polyU);
+        std::copy(clipV, clipV + count, polyV);
+    }
 
-            m_texels[idx].valid = true;
+    float area = 0.0f, cu = 0.0f, cv = 0.0f;
+    for (int k = 0; k < count; k++) {
+        int n = (k + 1) % count;
+        float cross = polyU[k] * polyV[n] - polyU[n] * polyV[k];
+        area += cross;
+        cu += (polyU[k] + polyU[n]) * cross;
+        cv += (polyV[k] + polyV[n]) * cross;
+    }
+    area *= 0.5f;
+    if (area > 1e-6f) {
+        outU = cu / (6.0f * area);
+        outV = cv / (6.0f * area);
+    }
+    return area;
+}
+
+void CLightmapRasterizer::rasterizeTriangleScalar(const STriangleSetup& tri, int x0, int y0, int x1, int y1,
+                                                  int tileX0, int tileY0, std::vector<float>& bestCoverage)
+{
+    const int tileSize = std::max(8, m_config.tileSize);
+    const SVertexAttributes attributes = loadAttributes(tri);
+    const bool conservative = m_config.conservative;
+
+    for (int py = y0; py <= y1; py++) {
+        // Edge values at texel centres: E = a * x + (b * y + c)
+        float yc = (float)(py - tri.minY) + 0.5f;
+        float row[3];
+        for (int i = 0; i < 3; i++) row[i] = tri.b[i] * yc + tri.c[i];
+
+        float* best = &bestCoverage[(size_t)(py - tileY0) * tileSize];
+        STexelData* texels = &m_texels[(size_t)py * m_width];
+        for (int px = x0; px <= x1; px++) {
+            float xc = (float)(px - tri.minX) + 0.5f;
+            float e[3];
+            bool inside = true;
+            for (int i = 0; i < 3; i++) {
+                e[i] = tri.a[i] * xc + row[i];
+                inside &= conservative ? e[i] + tri.h[i] > 0.0f : (e[i] > 0.0f || (e[i] == 0.0f && tri.topLeft[i]));
+            }
+            if (inside) shadeTexel(tri, attributes, e, texels[px], best[px - tileX0]);
+        }
+    }
+}
+
+#if FF_RASTER_SIMD
+void CLightmapRasterizer::rasterizeTriangleSIMD(const STriangleSetup& tri, int x0, int y0, int x1, int y1,
+                                                int tileX0, int tileY0, std::vector<float>& bestCoverage)
+{
+    const int tileSize = std::max(8, m_config.tileSize);
+    const SVertexAttributes attributes = loadAttributes(tri);
+    const bool conservative = m_config.conservative;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128i laneOffset = _mm_set_epi32(3, 2, 1, 0);
+
+    __m128 a[3], h[3], topLeft[3];
+    for (int i = 0; i < 3; i++) {
+        a[i] = _mm_set1_ps(tri.a[i]);
+        h[i] = _mm_set1_ps(tri.h[i]);
+        topLeft[i] = _mm_castsi128_ps(_mm_set1_epi32(tri.topLeft[i] ? -1 : 0));
+    }
+
+    alignas(16) float e[3][4];
+    for (int py = y0; py <= y1; py++) {
+        // Same arithmetic as the scalar kernel, so both pick the same texels
+        float yc = (float)(py - tri.minY) + 0.5f;
+        __m128 row[3];
+        for (int i = 0; i < 3; i++) row[i] = _mm_set1_ps(tri.b[i] * yc + tri.c[i]);
+
+        float* best = &bestCoverage[(size_t)(py - tileY0) * tileSize];
+        STexelData* texels = &m_texels[(size_t)py * m_width];
+        __m128 xc = _mm_add_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(x0 - tri.minX), laneOffset)), half);
+        for (int px = x0; px <= x1; px += 4) {
+            __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int i = 0; i < 3; i++) {
+                __m128 ei = _mm_add_ps(_mm_mul_ps(a[i], xc), row[i]);
+                _mm_store_ps(e[i], ei);
+                __m128 inside = conservative
+                    ? _mm_cmpgt_ps(_mm_add_ps(ei, h[i]), zero)
+                    : _mm_or_ps(_mm_cmpgt_ps(ei, zero), _mm_and_ps(_mm_cmpeq_ps(ei, zero), topLeft[i]));
+                mask = _mm_and_ps(mask, inside);
+            }
+            // Texel centres are small integers + 0.5: stepping by 4 is exact
+            xc = _mm_add_ps(xc, _mm_set1_ps(4.0f));
+
+            int bits = _mm_movemask_ps(mask);
+            if (x1 - px < 3) bits &= (1 << (x1 - px + 1)) - 1;
+            while (bits) {
+                int lane = 0;
+                while (!(bits & (1 << lane))) lane++;
+                bits &= bits - 1;
+                const float texelE[3] = {e[0][lane], e[1][lane], e[2][lane]};
+                shadeTexel(tri, attributes, texelE, texels[px + lane], best[px + lane - tileX0]);
+            }
         }
     }
 }
+#endif
 
-bool CLightmapRasterizer::computeBarycentric(
-    float px, float py,
-    float x0, float y0,
-    float x1, float y1,
-    float x2, float y2,
-    float& lambda0, float& lambda1, float& lambda2)
+CLightmapRasterizer::SVertexAttributes CLightmapRasterizer::loadAttributes(const STriangleSetup& tri) const
 {
-    // Compute barycentric coordinates using edge function
-    float denom = (y1 - y2) * (x0 - x2) + (x2 - x1) * (y0 - y2);
+    const SMeshSetup& mesh = m_setups[tri.mesh];
+    SVertexAttributes attributes;
+    for (int k = 0; k < 3; k++) {
+        attributes.position[k] = mesh.worldPositions[tri.v[k]];
+        attributes.normal[k] = mesh.worldNormals[tri.v[k]];
+    }
+    return attributes;
+}
 
-    // Check for degenerate triangle
-    if (std::abs(denom) < 1e-8f) {
-        return false;
+void CLightmapRasterizer::shadeTexel(const STriangleSetup& tri, const SVertexAttributes& attributes, const float e[3],
+                                     STexelData& texel, float& best)
+{
+    // Nothing beats a texel that is already fully covered; ties keep the
+    // first triangle in submission order
+    if (best >= 1.0f) return;
+
+    // Sample point in texel-local coordinates [0,1]^2
+    float u = 0.5f, v = 0.5f;
+    float coverage = 1.0f;
+    if (m_config.conservative &&
+        (e[0] < tri.h[0] || e[1] < tri.h[1] || e[2] < tri.h[2])) {
+        coverage = clipTexel(e, tri.a, tri.b, u, v);
+        if (coverage <= 1e-6f) return;  // Only touches a corner of the texel
+        coverage = std::min(coverage, 1.0f);
     }
+    if (coverage <= best) return;
+    best = coverage;
+
+    // Barycentrics at the sample point. Kept in registers: going through a
+    // small array here costs a store-forwarding stall per texel
+    const float du = u - 0.5f, dv = v - 0.5f;
+    const float lambda0 = std::max(0.0f, (e[0] + tri.a[0] * du + tri.b[0] * dv) * tri.invArea2);
+    const float lambda1 = std::max(0.0f, (e[1] + tri.a[1] * du + tri.b[1] * dv) * tri.invArea2);
+    const float lambda2 = std::max(0.0f, (e[2] + tri.a[2] * du + tri.b[2] * dv) * tri.invArea2);
 
-    float invDenom = 1.0f / denom;
+    const XMFLOAT3& p0 = attributes.position[0];
+    const XMFLOAT3& p1 = attributes.position[1];
+    const XMFLOAT3& p2 = attributes.position[2];
+    const XMFLOAT3& n0 = attributes.normal[0];
+    const XMFLOAT3& n1 = attributes.normal[1];
+    const XMFLOAT3& n2 = attributes.normal[2];
 
-    lambda0 = ((y1 - y2) * (px - x2) + (x2 - x1) * (py - y2)) * invDenom;
-    lambda1 = ((y2 - y0) * (px - x2) + (x0 - x2) * (py - y2)) * invDenom;
-    lambda2 = 1.0f - lambda0 - lambda1;
+    texel.worldPos.x = lambda0 * p0.x + lambda1 * p1.x + lambda2 * p2.x;
+    texel.worldPos.y = lambda0 * p0.y + lambda1 * p1.y + lambda2 * p2.y;
+    texel.worldPos.z = lambda0 * p0.z + lambda1 * p1.z + lambda2 * p2.z;
+
+    float nx = lambda0 * n0.x + lambda1 * n1.x + lambda2 * n2.x;
+    float ny = lambda0 * n0.y + lambda1 * n1.y + lambda2 * n2.y;
+    float nz = lambda0 * n0.z + lambda1 * n1.z + lambda2 * n2.z;
+    float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+    if (len > 1e-6f) {
+        float invLen = 1.0f / len;
+        texel.normal = {nx * invLen, ny * invLen, nz * invLen};
+    } else {
+        texel.normal = {0, 1, 0};
+    }
 
-    // Check if inside triangle (with small epsilon for edge cases)
-    const float eps = -1e-4f;
-    return (lambda0 >= eps && lambda1 >= eps && lambda2 >= eps);
+    texel.coverage = coverage;
+    texel.valid = true;
 }
@@ -3,11 +3,61 @@
 #include <vector>
 #include <DirectXMath.h>
 
+// SSE2 is the x64 baseline; everything else uses the scalar kernel
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define FF_RASTER_SIMD 1
+#else
+#define FF_RASTER_SIMD 0
+#endif
+
 // ============================================
 // Lightmap Rasterizer
 // ============================================
 // Rasterizes mesh triangles into lightmap UV space.
 // For each texel, computes the world position and normal.
+//
+// Meshes are queued with AddMesh() and rasterized together by Rasterize():
+//   1. Setup (parallel over meshes): world-space vertices, edge functions
+//      and texel bounds of every triangle, clamped to the mesh's region
+//   2. Binning: triangles are listed per atlas tile, in submission order
+//   3. Raster (parallel over tiles): every tile job owns its texels, so
+//      there are no shared writes and the result does not depend on the
+//      thread count
+//
+// Coverage:
+//   - Centre sampling: a texel belongs to the triangle containing its centre
+//     (top-left fill rule, so shared edges are covered exactly once)
+//   - Conservative: every texel a triangle overlaps is covered; the triangle
+//     with the largest overlap area wins and the texel is sampled at the
+//     centroid of that overlap, which always lies on the surface. Thin
+//     triangles and chart borders no longer leave holes.
+
+enum class ERasterKernel
+{
+    Scalar,     // Edge functions, one texel at a time
+    SIMD        // Edge functions, 4 texels per step. Falls back to Scalar when FF_RASTER_SIMD == 0
+};
+
+#if FF_RASTER_SIMD
+constexpr ERasterKernel RASTER_DEFAULT_KERNEL = ERasterKernel::SIMD;
+#else
+constexpr ERasterKernel RASTER_DEFAULT_KERNEL = ERasterKernel::Scalar;
+#endif
+
+struct SLightmapRasterConfig {
+    bool conservative = true;                   // false = centre sampling
+    ERasterKernel kernel = RASTER_DEFAULT_KERNEL;
+    bool multithreaded = true;                  // CJobSystem::ParallelFor over meshes and tiles
+    int tileSize = 64;                          // Texels per tile side
+};
+
+struct SLightmapRasterStats {
+    int meshCount = 0;
+    int triangleCount = 0;
+    int coveredTexels = 0;                      // Valid texels after the pass
+    int partialTexels = 0;                      // Conservative texels covered by less than a full triangle
+    double milliseconds = 0.0;
+};
 
 class CLightmapRasterizer {
 public:
@@ -17,12 +67,31 @@ public:
     // Initialize rasterizer with atlas dimensions
     void Initialize(int atlasWidth, int atlasHeight);
 
-    // Rasterize a mesh into the atlas
-    // positions, normals, uv2: vertex data (must be same size)
+    void SetConfig(const SLightmapRasterConfig& config) { m_config = config; }
+    const SLightmapRasterConfig& GetConfig() const { return m_config; }
+
+    // Queue a mesh for Rasterize()
+    // positions, normals, uv2: vertex data (must be same size), referenced
+    //   until Rasterize() returns
     // indices: triangle indices
     // worldMatrix: transform from local to world space
     // atlasOffsetX/Y: offset in atlas (from packing)
-    // regionWidth/Height: size of this mesh's region in atlas
+    // regionWidth/Height: size of this mesh's region in atlas; texels
+    //   outside it are never written
+    void AddMesh(
+        const std::vector<DirectX::XMFLOAT3>& positions,
+        const std::vector<DirectX::XMFLOAT3>& normals,
+        const std::vector<DirectX::XMFLOAT2>& uv2,
+        const std::vector<uint32_t>& indices,
+        const DirectX::XMMATRIX& worldMatrix,
+        int atlasOffsetX, int atlasOffsetY,
+        int regionWidth, int regionHeight
+    );
+
+    // Rasterize all queued meshes, then clear the queue
+    void Rasterize();
+
+    // AddMesh() + Rasterize() for a single mesh
     void RasterizeMesh(
         const std::vector<DirectX::XMFLOAT3>& positions,
         const std::vector<DirectX::XMFLOAT3>& normals,
@@ -45,27 +114,74 @@ public:
     // Get count of valid texels
     int GetValidTexelCount() const;
 
+    // Totals of the last Rasterize()
+    const SLightmapRasterStats& GetStats() const { return m_stats; }
+
 private:
-    // Rasterize a single triangle
-    void rasterizeTriangle(
-        const DirectX::XMFLOAT3& p0, const DirectX::XMFLOAT3& p1, const DirectX::XMFLOAT3& p2,
-        const DirectX::XMFLOAT3& n0, const DirectX::XMFLOAT3& n1, const DirectX::XMFLOAT3& n2,
-        const DirectX::XMFLOAT2& uv0, const DirectX::XMFLOAT2& uv1, const DirectX::XMFLOAT2& uv2,
-        int offsetX, int offsetY,
-        int regionWidth, int regionHeight
-    );
+    struct SMeshInput {
+        const std::vector<DirectX::XMFLOAT3>* positions;
+        const std::vector<DirectX::XMFLOAT3>* normals;
+        const std::vector<DirectX::XMFLOAT2>* uv2;
+        const std::vector<uint32_t>* indices;
+        DirectX::XMFLOAT4X4 worldMatrix;
+        int offsetX, offsetY;
+        int regionWidth, regionHeight;
+    };
 
-    // Compute barycentric coordinates
-    // Returns true if point is inside triangle
-    static bool computeBarycentric(
-        float px, float py,
-        float x0, float y0,
-        float x1, float y1,
-        float x2, float y2,
-        float& lambda0, float& lambda1, float& lambda2
-    );
+    // Triangle in atlas texel space. Edge i is opposite vertex i:
+    //   E_i(x, y) = a[i] * (x - minX) + b[i] * (y - minY) + c[i]
+    // oriented so the interior is positive; E_i / area2 is barycentric i.
+    struct STriangleSetup {
+        float a[3], b[3], c[3];
+        float h[3];                     // Half the texel's extent along each edge normal
+        float invArea2;
+        bool topLeft[3];
+        int minX, minY, maxX, maxY;     // Inclusive texel bounds, clamped to the region
+        uint32_t mesh;
+        uint32_t v[3];
+    };
+
+    // World-space vertices and triangles of one mesh
+    struct SMeshSetup {
+        std::vector<DirectX::XMFLOAT3> worldPositions;
+        std::vector<DirectX::XMFLOAT3> worldNormals;
+        std::vector<STriangleSetup> triangles;
+    };
+
+    void setupMesh(const SMeshInput& input, uint32_t meshIndex, SMeshSetup& out) const;
+
+    // Rasterize the binned triangles of one tile into its texels, then add
+    // the tile's valid / partially covered texels to the counters
+    // bestCoverage: tile-local coverage of the texels written so far
+    void rasterizeTile(int tileX, int tileY, const STriangleSetup* const* triangles, size_t triangleCount,
+                       std::vector<float>& bestCoverage, int& outCovered, int& outPartial);
+
+    // Texels [x0, x1] x [y0, y1] of a triangle inside the tile at (tileX0, tileY0)
+    void rasterizeTriangleScalar(const STriangleSetup& tri, int x0, int y0, int x1, int y1,
+                                 int tileX0, int tileY0, std::vector<float>& bestCoverage);
+#if FF_RASTER_SIMD
+    void rasterizeTriangleSIMD(const STriangleSetup& tri, int x0, int y0, int x1, int y1,
+                               int tileX0, int tileY0, std::vector<float>& bestCoverage);
+#endif
+
+    // World-space corners of a triangle, copied once per triangle and tile
+    struct SVertexAttributes {
+        DirectX::XMFLOAT3 position[3];
+        DirectX::XMFLOAT3 normal[3];
+    };
+    SVertexAttributes loadAttributes(const STriangleSetup& tri) const;
+
+    // Texel that passed the kernel's coverage test, given the edge values at
+    // its centre; written when the triangle beats the best coverage so far
+    void shadeTexel(const STriangleSetup& tri, const SVertexAttributes& attributes, const float e[3],
+                    STexelData& texel, float& best);
 
     std::vector<STexelData> m_texels;
     int m_width = 0;
     int m_height = 0;
+
+    SLightmapRasterConfig m_config;
+    std::vector<SMeshInput> m_pending;
+    std::vector<SMeshSetup> m_setups;       // Valid during Rasterize()
+    SLightmapRasterStats m_stats;
 };
@@ -42,17 +42,25 @@ struct SAtlasEntry {
     int height = 0;
 };
 
+// Atlas packing algorithm
+enum class EAtlasPacker {
+    Shelf,                        // Height-sorted rows (original packer)
+    MaxRects                      // CMaxRectsPacker, best short-side fit over all pages
+};
+
 // Atlas configuration
 struct SLightmapAtlasConfig {
     int resolution = 1024;        // Atlas texture size (square)
     int padding = 2;              // Pixels between charts
     int texelsPerUnit = 16;       // Texel density (texels per world unit)
+    EAtlasPacker packer = EAtlasPacker::MaxRects;
 };
 
 // Texel data after rasterization
 struct STexelData {
     DirectX::XMFLOAT3 worldPos = {0.0f, 0.0f, 0.0f};
     DirectX::XMFLOAT3 normal = {0.0f, 1.0f, 0.0f};
+    float coverage = 0.0f;          // Fraction of the texel covered by the source triangle (1 = centre-sampled)
     bool valid = false;
 };
 
@@ -61,7 +69,7 @@ struct SLightmap2DBakeConfig {
     int samplesPerTexel = 64;     // Monte Carlo samples per texel
     int maxBounces = 3;           // Max ray bounces for GI
     float skyIntensity = 1.0f;    // Sky light intensity multiplier
-    bool useGPU = true;           // Use DXR GPU baking if available
+    bool useGPU = true;           // DXR GPU baking if available, else CPU (CLightmap2DCPUBaker)
     bool enableDenoiser = true;   // Enable Intel OIDN denoising
     bool debugExportImages = false; // Export debug KTX2 images (before/after denoise)
 };
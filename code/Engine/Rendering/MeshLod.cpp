@@ -0,0 +1,73 @@
+#include "MeshLod.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+SMeshLodSettings& MeshLod::Settings()
+{
+    static SMeshLodSettings settings;
+    return settings;
+}
+
+MeshLod::SView MeshLod::MakeView(const XMMATRIX& viewProj, float screenError)
+{
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, viewProj);
+
+    // Row-vector convention: clip.y and clip.w come from columns 1 and 3
+    SView view;
+    view.depthColumn = XMFLOAT4(m.m[0][3], m.m[1][3], m.m[2][3], m.m[3][3]);
+    view.projScale = std::sqrt(m.m[0][1] * m.m[0][1] + m.m[1][1] * m.m[1][1] + m.m[2][1] * m.m[2][1]);
+    view.screenError = screenError;
+
+    // Perspective: clip.z = a * w + b. The near and far planes sit at z/w = 0 and
+    // z/w = 1 (swapped for reversed-Z), so the near depth is the smaller solution.
+    XMFLOAT4 zColumn(m.m[0][2], m.m[1][2], m.m[2][2], m.m[3][2]);
+    const XMFLOAT4& w = view.depthColumn;
+    float wLengthSq = w.x * w.x + w.y * w.y + w.z * w.z;
+    if (wLengthSq > 0.0f) {
+        float a = (zColumn.x * w.x + zColumn.y * w.y + zColumn.z * w.z) / wLengthSq;
+        float b = zColumn.w - a * w.w;
+        float depth0 = a != 0.0f ? -b / a : 0.0f;
+        float depth1 = a != 1.0f ? b / (1.0f - a) : 0.0f;
+        if (depth0 > 0.0f && depth1 > 0.0f) {
+            view.nearDepth = std::min(depth0, depth1);
+        } else {
+            view.nearDepth = std::max(std::max(depth0, depth1), 0.0f);
+        }
+    }
+    return view;
+}
+
+float MeshLod::MaxError(const SView& view, const XMFLOAT3& center, float radius, const XMMATRIX& world,
+                        bool clampToNear)
+{
+    if (view.screenError <= 0.0f || view.projScale <= 0.0f) {
+        return 0.0f;
+    }
+
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, world);
+    float worldScale = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        worldScale = std::max(worldScale, m.m[i][0] * m.m[i][0] + m.m[i][1] * m.m[i][1] + m.m[i][2] * m.m[i][2]);
+    }
+    worldScale = std::sqrt(worldScale);
+    if (worldScale <= 0.0f) {
+        return 0.0f;
+    }
+
+    // Orthographic views have no depth term (|xyz| = 0), so the sphere does not move w
+    const XMFLOAT4& c = view.depthColumn;
+    float w = c.x * center.x + c.y * center.y + c.z * center.z + c.w;
+    float depthScale = std::sqrt(c.x * c.x + c.y * c.y + c.z * c.z);
+    float nearest = w - radius * depthScale;
+    if (clampToNear) {
+        nearest = std::max(nearest, view.nearDepth);
+    }
+    if (nearest <= 0.0f) {
+        return 0.0f;    // Camera inside the bounds
+    }
+    return view.screenError * nearest / (view.projScale * worldScale);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <DirectXMath.h>
+
+// ============================================
+// Mesh LOD selection
+// ============================================
+// Meshes carry a chain of simplified index ranges (GpuMeshResource::lods), each
+// with its geometric error in mesh units. Per object and view the culler turns
+// a screen-space error budget into a mesh-space one:
+//
+//   projected error = error * worldScale * projScale / w
+//   maxError        = screenError * w / (projScale * worldScale)
+//
+// with w the clip-space w of the nearest point of the bounding sphere (view
+// depth for perspective, 1 for orthographic) and projScale the vertical
+// projection scale. The coarsest level within maxError is drawn.
+//
+// Shadow cascades reuse the camera budget scaled by shadowBias: shadow maps
+// resolve far less detail than the camera and a cascade's own orthographic
+// projection says nothing about how large the object is on screen. Casters
+// behind or around the camera are still drawn into the cascades, so their
+// nearest depth is clamped to the camera near plane instead of forcing LOD0.
+
+struct SMeshLodSettings {
+    bool enabled = true;
+    float screenError = 0.002f;     // NDC units (2 = viewport height); ~1 pixel at 1080p
+    float shadowBias = 4.0f;        // Cascade budget = camera budget * shadowBias
+};
+
+namespace MeshLod
+{
+    SMeshLodSettings& Settings();
+
+    // Camera terms of the formula above, from a row-vector view-projection matrix
+    struct SView {
+        DirectX::XMFLOAT4 depthColumn{0.0f, 0.0f, 0.0f, 1.0f};  // w = dot(p, xyz) + w
+        float projScale = 1.0f;
+        float screenError = 0.0f;
+        float nearDepth = 0.0f;     // w at the near plane (0 for orthographic)
+    };
+    SView MakeView(const DirectX::XMMATRIX& viewProj, float screenError);
+
+    // Mesh-space error budget for a world-space bounding sphere and the object's
+    // world matrix (largest axis scale). 0 = full detail.
+    // clampToNear: bounds reaching the camera plane use the near-plane budget
+    // instead of full detail (shadow views)
+    float MaxError(const SView& view, const DirectX::XMFLOAT3& center, float radius,
+                   const DirectX::XMMATRIX& world, bool clampToNear = false);
+}
@@ -0,0 +1,105 @@
+// Engine/Rendering/MeshVertexStreams.h
+// Input layouts and buffer binding for the mesh vertex layouts (see Core/PackedVertex.h).
+// Passes create one PSO per EVertexLayout and switch per draw; all variants of a
+// pass share the same set layouts, so the bound descriptor sets stay valid.
+#pragma once
+#include "RHI/ICommandList.h"
+#include "RHI/RHIDescriptors.h"
+#include "Core/GpuMeshResource.h"
+#include <string>
+#include <vector>
+
+namespace MeshVertexStreams {
+
+static const uint32_t kLayoutCount = 2;   // EVertexLayout::Full, EVertexLayout::Packed
+
+inline uint32_t LayoutIndex(EVertexLayout layout) {
+    return static_cast<uint32_t>(layout);
+}
+
+//==============================================
+// Full attribute layout (SVertexPNT, slot 0)
+//==============================================
+inline std::vector<RHI::VertexElement> FullLayout() {
+    using namespace RHI;
+    return {
+        { EVertexSemantic::Position, 0, EVertexFormat::Float3, 0, 0 },
+        { EVertexSemantic::Normal,   0, EVertexFormat::Float3, 12, 0 },
+        { EVertexSemantic::Texcoord, 0, EVertexFormat::Float2, 24, 0 },
+        { EVertexSemantic::Tangent,  0, EVertexFormat::Float4, 32, 0 },
+        { EVertexSemantic::Color,    0, EVertexFormat::Float4, 48, 0 },
+        { EVertexSemantic::Texcoord, 1, EVertexFormat::Float2, 64, 0 }
+    };
+}
+
+//==============================================
+// Packed attribute layout
+// Slot 0: SPackedPosition, slot 1: SPackedAttributes.
+// Normal+tangent arrive as one snorm16x4 (two octahedral pairs) and are decoded
+// in the shader (Shader/PackedVertex.hlsli).
+//==============================================
+inline std::vector<RHI::VertexElement> PackedLayout() {
+    using namespace RHI;
+    return {
+        { EVertexSemantic::Position, 0, EVertexFormat::Half4,        0,  0 },
+        { EVertexSemantic::Normal,   0, EVertexFormat::Short4_Norm,  0,  1 },
+        { EVertexSemantic::Texcoord, 0, EVertexFormat::Half2,        8,  1 },
+        { EVertexSemantic::Texcoord, 1, EVertexFormat::UShort2_Norm, 12, 1 },
+        { EVertexSemantic::Color,    0, EVertexFormat::UByte4_Norm,  16, 1 }
+    };
+}
+
+inline std::vector<RHI::VertexElement> AttributeLayout(EVertexLayout layout) {
+    return layout == EVertexLayout::Packed ? PackedLayout() : FullLayout();
+}
+
+//==============================================
+// Position-only layout (depth pre-pass, shadows)
+// Full meshes read the position out of the interleaved stream (stride 80);
+// packed meshes read the dedicated 8-byte position stream.
+//==============================================
+inline std::vector<RHI::VertexElement> PositionLayout(EVertexLayout layout) {
+    using namespace RHI;
+    if (layout == EVertexLayout::Packed) {
+        return { { EVertexSemantic::Position, 0, EVertexFormat::Half4, 0, 0 } };
+    }
+    return { { EVertexSemantic::Position, 0, EVertexFormat::Float3, 0, 0 } };
+}
+
+// Attribute-pass shader variant for a layout: packed vertices compile with PACKED_VERTEX
+inline std::string ShaderSource(const std::string& source, EVertexLayout layout) {
+    if (layout == EVertexLayout::Packed) {
+        return "#define PACKED_VERTEX 1\n" + source;
+    }
+    return source;
+}
+
+inline const char* LayoutName(EVertexLayout layout) {
+    return layout == EVertexLayout::Packed ? "Packed" : "Full";
+}
+
+//==============================================
+// Binding
+//==============================================
+inline void BindIndices(RHI::ICommandList* cmdList, const GpuMeshResource& mesh) {
+    cmdList->SetIndexBuffer(mesh.ibo.get(), mesh.indexFormat, 0);
+}
+
+// All attributes (matches AttributeLayout(mesh.layout))
+inline void Bind(RHI::ICommandList* cmdList, const GpuMeshResource& mesh) {
+    if (mesh.layout == EVertexLayout::Packed) {
+        cmdList->SetVertexBuffer(0, mesh.positionVbo.get(), sizeof(SPackedPosition), 0);
+        cmdList->SetVertexBuffer(1, mesh.vbo.get(), sizeof(SPackedAttributes), 0);
+    } else {
+        cmdList->SetVertexBuffer(0, mesh.vbo.get(), sizeof(SVertexPNT), 0);
+    }
+    BindIndices(cmdList, mesh);
+}
+
+// Positions only (matches PositionLayout(mesh.layout))
+inline void BindPositions(RHI::ICommandList* cmdList, const GpuMeshResource& mesh) {
+    cmdList->SetVertexBuffer(0, mesh.GetPositionBuffer(), mesh.GetPositionStride(), 0);
+    BindIndices(cmdList, mesh);
+}
+
+} // namespace MeshVertexStreams
@@ -0,0 +1,350 @@
+#include "BVH4.h"
+#include <algorithm>
+#include <cfloat>
+
+using namespace DirectX;
+
+// ============================================
+// SBVHRayPacket4
+// ============================================
+
+void SBVHRayPacket4::SetRay(int lane, const SBVHRay& ray)
+{
+    ox[lane] = ray.origin.x;
+    oy[lane] = ray.origin.y;
+    oz[lane] = ray.origin.z;
+    dx[lane] = ray.direction.x;
+    dy[lane] = ray.direction.y;
+    dz[lane] = ray.direction.z;
+    idx[lane] = ray.invDirection.x;
+    idy[lane] = ray.invDirection.y;
+    idz[lane] = ray.invDirection.z;
+    tMin[lane] = ray.tMin;
+    tMax[lane] = ray.tMax;
+    activeMask |= 1u << lane;
+}
+
+SBVHRay SBVHRayPacket4::GetRay(int lane) const
+{
+    SBVHRay ray;
+    ray.origin = {ox[lane], oy[lane], oz[lane]};
+    ray.direction = {dx[lane], dy[lane], dz[lane]};
+    ray.invDirection = {idx[lane], idy[lane], idz[lane]};
+    ray.tMin = tMin[lane];
+    ray.tMax = tMax[lane];
+    return ray;
+}
+
+// ============================================
+// CBVH4 - collapse binary BVH
+// ============================================
+
+void CBVH4::Clear()
+{
+    m_nodes.clear();
+    m_boundsMin = {0, 0, 0};
+    m_boundsMax = {0, 0, 0};
+}
+
+void CBVH4::BuildFromBinary(const std::vector<SBVHNode>& binaryNodes)
+{
+    Clear();
+    if (binaryNodes.empty()) {
+        return;
+    }
+
+    m_boundsMin = binaryNodes[0].boundsMin;
+    m_boundsMax = binaryNodes[0].boundsMax;
+    m_nodes.reserve(binaryNodes.size() / 2 + 1);
+
+    // (wide node to fill, binary node whose subtree it represents)
+    struct STask { uint32_t wideIndex; uint32_t binaryIndex; };
+    std::vector<STask> stack;
+    m_nodes.emplace_back();
+    stack.push_back({0, 0});
+
+    while (!stack.empty()) {
+        STask task = stack.back();
+        stack.pop_back();
+
+        // Gather up to 4 children by repeatedly opening the largest interior child
+        uint32_t children[4];
+        int childCount = 0;
+        const SBVHNode& source = binaryNodes[task.binaryIndex];
+        if (source.IsLeaf()) {
+            children[childCount++] = task.binaryIndex;     // Root is a single leaf
+        } else {
+            children[childCount++] = source.leftOrFirst;
+            children[childCount++] = source.leftOrFirst + 1;
+        }
+
+        while (childCount < 4) {
+            int best = -1;
+            float bestArea = -1.0f;
+            for (int i = 0; i < childCount; i++) {
+                const SBVHNode& c = binaryNodes[children[i]];
+                if (c.IsLeaf()) continue;
+                float area = BVHMath::SurfaceArea(c.boundsMin, c.boundsMax);
+                if (area > bestArea) {
+                    bestArea = area;
+                    best = i;
+                }
+            }
+            if (best < 0) break;
+
+            uint32_t opened = children[best];
+            children[best] = binaryNodes[opened].leftOrFirst;
+            children[childCount++] = binaryNodes[opened].leftOrFirst + 1;
+        }
+
+        // Fill slots (the reference may move when m_nodes grows, so index each time)
+        for (int i = 0; i < 4; i++) {
+            SBVH4Node& node = m_nodes[task.wideIndex];
+            if (i >= childCount) {
+                node.minX[i] = node.minY[i] = node.minZ[i] = FLT_MAX;
+                node.maxX[i] = node.maxY[i] = node.maxZ[i] = -FLT_MAX;
+                node.child[i] = BVH4_INVALID;
+                node.count[i] = 0;
+                continue;
+            }
+
+            const SBVHNode& c = binaryNodes[children[i]];
+            node.minX[i] = c.boundsMin.x;
+            node.minY[i] = c.boundsMin.y;
+            node.minZ[i] = c.boundsMin.z;
+            node.maxX[i] = c.boundsMax.x;
+            node.maxY[i] = c.boundsMax.y;
+            node.maxZ[i] = c.boundsMax.z;
+
+            if (c.IsLeaf()) {
+                node.child[i] = c.leftOrFirst;
+                node.count[i] = c.primCount;
+            } else {
+                uint32_t wideChild = (uint32_t)m_nodes.size();
+                m_nodes[task.wideIndex].child[i] = wideChild;
+                m_nodes[task.wideIndex].count[i] = 0;
+                m_nodes.emplace_back();
+                stack.push_back({wideChild, children[i]});
+            }
+        }
+    }
+}
+
+// ============================================
+// Scalar kernels (reference + non-SSE fallback)
+// ============================================
+// Same operation order as the SIMD kernels so both select the same hit.
+
+int BVH4Math::IntersectNode4Scalar(const SBVH4Node& node, const SBVHRay& ray, float tMax, float outTNear[4])
+{
+    int mask = 0;
+    for (int i = 0; i < 4; i++) {
+        XMFLOAT3 bmin = {node.minX[i], node.minY[i], node.minZ[i]};
+        XMFLOAT3 bmax = {node.maxX[i], node.maxY[i], node.maxZ[i]};
+        if (BVHMath::RayAABB(ray, bmin, bmax, tMax, outTNear[i])) {
+            mask |= 1 << i;
+        }
+    }
+    return mask;
+}
+
+int BVH4Math::IntersectTriangle4Scalar(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax,
+                                       float& outT, float& outU, float& outV)
+{
+    int bestLane = -1;
+    for (int i = 0; i < 4; i++) {
+        SBVHTriangle t;
+        t.v0 = {tri.v0x[i], tri.v0y[i], tri.v0z[i]};
+        t.e1 = {tri.e1x[i], tri.e1y[i], tri.e1z[i]};
+        t.e2 = {tri.e2x[i], tri.e2y[i], tri.e2z[i]};
+
+        float hitT, u, v;
+        if (BVHMath::RayTriangle(ray, t, tMax, hitT, u, v)) {
+            tMax = hitT;
+            outT = hitT;
+            outU = u;
+            outV = v;
+            bestLane = i;
+        }
+    }
+    return bestLane;
+}
+
+bool BVH4Math::OccludedTriangle4Scalar(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax)
+{
+    for (int i = 0; i < 4; i++) {
+        SBVHTriangle t;
+        t.v0 = {tri.v0x[i], tri.v0y[i], tri.v0z[i]};
+        t.e1 = {tri.e1x[i], tri.e1y[i], tri.e1z[i]};
+        t.e2 = {tri.e2x[i], tri.e2y[i], tri.e2z[i]};
+
+        float hitT, u, v;
+        if (BVHMath::RayTriangle(ray, t, tMax, hitT, u, v)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================
+// SSE kernels
+// ============================================
+#if FF_BVH_SIMD
+
+int BVH4Math::IntersectNode4SIMD(const SBVH4Node& node, const SBVHRay& ray, float tMax, float outTNear[4])
+{
+    const __m128 ox = _mm_set1_ps(ray.origin.x);
+    const __m128 oy = _mm_set1_ps(ray.origin.y);
+    const __m128 oz = _mm_set1_ps(ray.origin.z);
+    const __m128 ix = _mm_set1_ps(ray.invDirection.x);
+    const __m128 iy = _mm_set1_ps(ray.invDirection.y);
+    const __m128 iz = _mm_set1_ps(ray.invDirection.z);
+
+    __m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minX), ox), ix);
+    __m128 tx2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxX), ox), ix);
+    __m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minY), oy), iy);
+    __m128 ty2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxY), oy), iy);
+    __m128 tz1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.minZ), oz), iz);
+    __m128 tz2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.maxZ), oz), iz);
+
+    __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2)), _mm_min_ps(tz1, tz2));
+    __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2)), _mm_max_ps(tz1, tz2));
+    tNear = _mm_max_ps(tNear, _mm_set1_ps(ray.tMin));
+    tFar = _mm_min_ps(tFar, _mm_set1_ps(tMax));
+
+    _mm_storeu_ps(outTNear, tNear);
+    return _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+}
+
+namespace
+{
+    // Möller–Trumbore, 1 ray x 4 triangles. Returns lane mask; t/u/v per lane.
+    inline int intersectTriangle4Lanes(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax,
+                                       __m128& outT, __m128& outU, __m128& outV)
+    {
+        const __m128 dx = _mm_set1_ps(ray.direction.x);
+        const __m128 dy = _mm_set1_ps(ray.direction.y);
+        const __m128 dz = _mm_set1_ps(ray.direction.z);
+        const __m128 e1x = _mm_load_ps(tri.e1x), e1y = _mm_load_ps(tri.e1y), e1z = _mm_load_ps(tri.e1z);
+        const __m128 e2x = _mm_load_ps(tri.e2x), e2y = _mm_load_ps(tri.e2y), e2z = _mm_load_ps(tri.e2z);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        // p = d x e2
+        __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+        __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+        __m128 reject = _mm_and_ps(_mm_cmpgt_ps(det, _mm_set1_ps(-1e-12f)), _mm_cmplt_ps(det, _mm_set1_ps(1e-12f)));
+        __m128 invDet = _mm_div_ps(one, det);
+
+        __m128 sx = _mm_sub_ps(_mm_set1_ps(ray.origin.x), _mm_load_ps(tri.v0x));
+        __m128 sy = _mm_sub_ps(_mm_set1_ps(ray.origin.y), _mm_load_ps(tri.v0y));
+        __m128 sz = _mm_sub_ps(_mm_set1_ps(ray.origin.z), _mm_load_ps(tri.v0z));
+        __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+        reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmplt_ps(u, zero), _mm_cmpgt_ps(u, one)));
+
+        // q = s x e1
+        __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+        __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+        __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+        __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+        reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmplt_ps(v, zero), _mm_cmpgt_ps(_mm_add_ps(u, v), one)));
+
+        __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+        reject = _mm_or_ps(reject, _mm_or_ps(_mm_cmple_ps(t, _mm_set1_ps(ray.tMin)), _mm_cmpge_ps(t, _mm_set1_ps(tMax))));
+
+        outT = t;
+        outU = u;
+        outV = v;
+        return ~_mm_movemask_ps(reject) & 0xF;
+    }
+}
+
+int BVH4Math::IntersectTriangle4SIMD(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax,
+                                     float& outT, float& outU, float& outV)
+{
+    __m128 t, u, v;
+    int mask = intersectTriangle4Lanes(ray, tri, tMax, t, u, v);
+    if (mask == 0) {
+        return -1;
+    }
+
+    alignas(16) float ts[4], us[4], vs[4];
+    _mm_store_ps(ts, t);
+    _mm_store_ps(us, u);
+    _mm_store_ps(vs, v);
+
+    // Nearest lane, ties -> lowest lane (matches the scalar loop)
+    int bestLane = -1;
+    for (int i = 0; i < 4; i++) {
+        if (!(mask & (1 << i))) continue;
+        if (bestLane < 0 || ts[i] < ts[bestLane]) {
+            bestLane = i;
+        }
+    }
+    outT = ts[bestLane];
+    outU = us[bestLane];
+    outV = vs[bestLane];
+    return bestLane;
+}
+
+bool BVH4Math::OccludedTriangle4SIMD(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax)
+{
+    __m128 t, u, v;
+    return intersectTriangle4Lanes(ray, tri, tMax, t, u, v) != 0;
+}
+
+#endif // FF_BVH_SIMD
+
+// ============================================
+// Packet kernel (4 rays x 1 box)
+// ============================================
+
+int BVH4Math::IntersectChildPacket(const SBVH4Node& node, int slot, const SBVHRayPacket4& packet,
+                                   uint32_t laneMask, float& outMinTNear)
+{
+#if FF_BVH_SIMD
+    const __m128 minX = _mm_set1_ps(node.minX[slot]), maxX = _mm_set1_ps(node.maxX[slot]);
+    const __m128 minY = _mm_set1_ps(node.minY[slot]), maxY = _mm_set1_ps(node.maxY[slot]);
+    const __m128 minZ = _mm_set1_ps(node.minZ[slot]), maxZ = _mm_set1_ps(node.maxZ[slot]);
+    const __m128 ox = _mm_load_ps(packet.ox), oy = _mm_load_ps(packet.oy), oz = _mm_load_ps(packet.oz);
+    const __m128 ix = _mm_load_ps(packet.idx), iy = _mm_load_ps(packet.idy), iz = _mm_load_ps(packet.idz);
+
+    __m128 tx1 = _mm_mul_ps(_mm_sub_ps(minX, ox), ix);
+    __m128 tx2 = _mm_mul_ps(_mm_sub_ps(maxX, ox), ix);
+    __m128 ty1 = _mm_mul_ps(_mm_sub_ps(minY, oy), iy);
+    __m128 ty2 = _mm_mul_ps(_mm_sub_ps(maxY, oy), iy);
+    __m128 tz1 = _mm_mul_ps(_mm_sub_ps(minZ, oz), iz);
+    __m128 tz2 = _mm_mul_ps(_mm_sub_ps(maxZ, oz), iz);
+
+    __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2)), _mm_min_ps(tz1, tz2));
+    __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2)), _mm_max_ps(tz1, tz2));
+    tNear = _mm_max_ps(tNear, _mm_load_ps(packet.tMin));
+    tFar = _mm_min_ps(tFar, _mm_load_ps(packet.tMax));
+
+    int mask = _mm_movemask_ps(_mm_cmple_ps(tNear, tFar)) & (int)laneMask;
+    alignas(16) float tNears[4];
+    _mm_store_ps(tNears, tNear);
+#else
+    int mask = 0;
+    float tNears[4];
+    XMFLOAT3 bmin = {node.minX[slot], node.minY[slot], node.minZ[slot]};
+    XMFLOAT3 bmax = {node.maxX[slot], node.maxY[slot], node.maxZ[slot]};
+    for (int i = 0; i < 4; i++) {
+        if (!(laneMask & (1u << i))) continue;
+        SBVHRay ray = packet.GetRay(i);
+        if (BVHMath::RayAABB(ray, bmin, bmax, ray.tMax, tNears[i])) {
+            mask |= 1 << i;
+        }
+    }
+#endif
+
+    outMinTNear = FLT_MAX;
+    for (int i = 0; i < 4; i++) {
+        if (mask & (1 << i)) {
+            outMinTNear = std::min(outMinTNear, tNears[i]);
+        }
+    }
+    return mask;
+}
@@ -0,0 +1,289 @@
+#pragma once
+#include "TriangleBVH.h"
+#include <cstdint>
+#include <vector>
+
+// SSE2 is the x64 baseline; everything else uses the scalar kernels
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define FF_BVH_SIMD 1
+#include <emmintrin.h>
+#else
+#define FF_BVH_SIMD 0
+#endif
+
+// ============================================
+// 4-wide BVH (BVH4)
+// ============================================
+// Collapsed from the binary SAH BVH (CBVHBuilder). One node stores the
+// bounds of its 4 children in SoA layout so a single ray is tested against
+// all 4 boxes with one set of SSE instructions.
+//
+// Both kernels run the same arithmetic in the same order and visit children
+// in the same order, so EBVHKernel::Scalar selects exactly the same nearest
+// hit as EBVHKernel::SIMD (used as reference in TestRayTracerBVH).
+
+enum class EBVHKernel
+{
+    Scalar,
+    SIMD        // Falls back to Scalar when FF_BVH_SIMD == 0
+};
+
+#if FF_BVH_SIMD
+constexpr EBVHKernel BVH_DEFAULT_KERNEL = EBVHKernel::SIMD;
+#else
+constexpr EBVHKernel BVH_DEFAULT_KERNEL = EBVHKernel::Scalar;
+#endif
+
+constexpr uint32_t BVH4_INVALID = UINT32_MAX;
+
+// 128 bytes (two cache lines)
+// Interior child: child = node index, count = 0
+// Leaf child:     child = first primitive, count = primitive count
+// Empty slot:     child = BVH4_INVALID
+struct alignas(16) SBVH4Node
+{
+    float minX[4], minY[4], minZ[4];
+    float maxX[4], maxY[4], maxZ[4];
+    uint32_t child[4];
+    uint32_t count[4];
+};
+static_assert(sizeof(SBVH4Node) == 128, "SBVH4Node must stay 128 bytes");
+
+// 4 triangles in SoA layout (v0 + edges), padding lanes are degenerate
+struct alignas(16) SBVHTriangle4
+{
+    float v0x[4], v0y[4], v0z[4];
+    float e1x[4], e1y[4], e1z[4];
+    float e2x[4], e2y[4], e2z[4];
+    uint32_t primIndex[4];      // Original triangle index, BVH4_INVALID for padding
+};
+
+// 4 rays in SoA layout (coherent packet, e.g. 2x2 primary rays)
+struct alignas(16) SBVHRayPacket4
+{
+    float ox[4], oy[4], oz[4];
+    float dx[4], dy[4], dz[4];
+    float idx[4], idy[4], idz[4];
+    float tMin[4];
+    float tMax[4];
+    uint32_t activeMask = 0;    // bit i = lane i carries a ray
+
+    void SetRay(int lane, const SBVHRay& ray);
+    SBVHRay GetRay(int lane) const;
+};
+
+// ============================================
+// CBVH4 - node storage + traversal
+// ============================================
+class CBVH4
+{
+public:
+    // Leaf ranges stay the binary leaf ranges [first, first + count)
+    void BuildFromBinary(const std::vector<SBVHNode>& binaryNodes);
+    void Clear();
+
+    // Rewrites every leaf slot in place: func(uint32_t& first, uint32_t& count)
+    template<typename TFunc>
+    void RemapLeaves(TFunc&& func);
+
+    bool IsEmpty() const { return m_nodes.empty(); }
+    int GetNodeCount() const { return (int)m_nodes.size(); }
+    const std::vector<SBVH4Node>& GetNodes() const { return m_nodes; }
+
+    // Root bounds
+    const DirectX::XMFLOAT3& GetBoundsMin() const { return m_boundsMin; }
+    const DirectX::XMFLOAT3& GetBoundsMax() const { return m_boundsMax; }
+
+    // Single-ray traversal, nearest child first.
+    // leafFunc(first, count, tMax&) -> bool: test a leaf, shrink tMax on hit.
+    // AnyHit: stop at the first leaf reporting a hit.
+    template<EBVHKernel Kernel, bool AnyHit, typename TLeafFunc>
+    bool Traverse(const SBVHRay& ray, float& tMax, TLeafFunc&& leafFunc) const;
+
+    // Packet traversal: a child is visited when any active lane hits it.
+    // leafFunc(first, count, laneMask) tests the lanes in laneMask and shrinks packet.tMax.
+    template<typename TLeafFunc>
+    void TraversePacket(SBVHRayPacket4& packet, TLeafFunc&& leafFunc) const;
+
+    static const int STACK_SIZE = 256;
+
+private:
+    std::vector<SBVH4Node> m_nodes;
+    DirectX::XMFLOAT3 m_boundsMin = {0, 0, 0};
+    DirectX::XMFLOAT3 m_boundsMax = {0, 0, 0};
+};
+
+// ============================================
+// Kernels
+// ============================================
+namespace BVH4Math
+{
+    // Single ray vs 4 child boxes; returns hit mask, entry distances in outTNear
+    int IntersectNode4Scalar(const SBVH4Node& node, const SBVHRay& ray, float tMax, float outTNear[4]);
+    // 4 rays vs one child box; returns lane mask (already ANDed with laneMask)
+    int IntersectChildPacket(const SBVH4Node& node, int slot, const SBVHRayPacket4& packet,
+                             uint32_t laneMask, float& outMinTNear);
+
+    // Single ray vs 4 triangles; returns nearest lane or -1 (ties -> lowest lane)
+    int IntersectTriangle4Scalar(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax,
+                                 float& outT, float& outU, float& outV);
+    // Any lane hit
+    bool OccludedTriangle4Scalar(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax);
+
+#if FF_BVH_SIMD
+    int IntersectNode4SIMD(const SBVH4Node& node, const SBVHRay& ray, float tMax, float outTNear[4]);
+    int IntersectTriangle4SIMD(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax,
+                               float& outT, float& outU, float& outV);
+    bool OccludedTriangle4SIMD(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax);
+#endif
+
+    template<EBVHKernel Kernel>
+    inline int IntersectNode4(const SBVH4Node& node, const SBVHRay& ray, float tMax, float outTNear[4])
+    {
+#if FF_BVH_SIMD
+        if constexpr (Kernel == EBVHKernel::SIMD) {
+            return IntersectNode4SIMD(node, ray, tMax, outTNear);
+        }
+#endif
+        return IntersectNode4Scalar(node, ray, tMax, outTNear);
+    }
+
+    template<EBVHKernel Kernel>
+    inline int IntersectTriangle4(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax,
+                                  float& outT, float& outU, float& outV)
+    {
+#if FF_BVH_SIMD
+        if constexpr (Kernel == EBVHKernel::SIMD) {
+            return IntersectTriangle4SIMD(ray, tri, tMax, outT, outU, outV);
+        }
+#endif
+        return IntersectTriangle4Scalar(ray, tri, tMax, outT, outU, outV);
+    }
+
+    template<EBVHKernel Kernel>
+    inline bool OccludedTriangle4(const SBVHRay& ray, const SBVHTriangle4& tri, float tMax)
+    {
+#if FF_BVH_SIMD
+        if constexpr (Kernel == EBVHKernel::SIMD) {
+            return OccludedTriangle4SIMD(ray, tri, tMax);
+        }
+#endif
+        return OccludedTriangle4Scalar(ray, tri, tMax);
+    }
+}
+
+// ============================================
+// Traversal (templates)
+// ============================================
+
+template<typename TFunc>
+void CBVH4::RemapLeaves(TFunc&& func)
+{
+    for (auto& node : m_nodes) {
+        for (int i = 0; i < 4; i++) {
+            if (node.child[i] != BVH4_INVALID && node.count[i] > 0) {
+                func(node.child[i], node.count[i]);
+            }
+        }
+    }
+}
+
+template<EBVHKernel Kernel, bool AnyHit, typename TLeafFunc>
+bool CBVH4::Traverse(const SBVHRay& ray, float& tMax, TLeafFunc&& leafFunc) const
+{
+    if (m_nodes.empty()) {
+        return false;
+    }
+
+    struct SEntry { uint32_t child; uint32_t count; float tNear; };
+    SEntry stack[STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = {0, 0, ray.tMin};
+
+    bool found = false;
+    while (stackSize > 0) {
+        SEntry entry = stack[--stackSize];
+        if (entry.tNear > tMax) {
+            continue;   // A closer hit was found after this entry was pushed
+        }
+
+        if (entry.count > 0) {
+            if (leafFunc(entry.child, entry.count, tMax)) {
+                found = true;
+                if constexpr (AnyHit) {
+                    return true;
+                }
+            }
+            continue;
+        }
+
+        const SBVH4Node& node = m_nodes[entry.child];
+        float tNear[4];
+        int mask = BVH4Math::IntersectNode4<Kernel>(node, ray, tMax, tNear);
+
+        // Sort hit children by distance (insertion sort, ties keep slot order)
+        int order[4];
+        int hitCount = 0;
+        for (int i = 0; i < 4; i++) {
+            if (!(mask & (1 << i)) || node.child[i] == BVH4_INVALID) continue;
+            int j = hitCount++;
+            while (j > 0 && tNear[order[j - 1]] > tNear[i]) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = i;
+        }
+
+        // Push farthest first so the nearest is popped next
+        for (int k = hitCount - 1; k >= 0; k--) {
+            int i = order[k];
+            stack[stackSize++] = {node.child[i], node.count[i], tNear[i]};
+        }
+    }
+
+    return found;
+}
+
+template<typename TLeafFunc>
+void CBVH4::TraversePacket(SBVHRayPacket4& packet, TLeafFunc&& leafFunc) const
+{
+    if (m_nodes.empty() || packet.activeMask == 0) {
+        return;
+    }
+
+    struct SEntry { uint32_t child; uint32_t count; uint32_t laneMask; };
+    SEntry stack[STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = {0, 0, packet.activeMask};
+
+    while (stackSize > 0) {
+        SEntry entry = stack[--stackSize];
+
+        if (entry.count > 0) {
+            leafFunc(entry.child, entry.count, entry.laneMask);
+            continue;
+        }
+
+        const SBVH4Node& node = m_nodes[entry.child];
+        float tNear[4];
+        uint32_t masks[4];
+        int order[4];
+        int hitCount = 0;
+        for (int i = 0; i < 4; i++) {
+            if (node.child[i] == BVH4_INVALID) continue;
+            masks[i] = (uint32_t)BVH4Math::IntersectChildPacket(node, i, packet, entry.laneMask, tNear[i]);
+            if (masks[i] == 0) continue;
+            int j = hitCount++;
+            while (j > 0 && tNear[order[j - 1]] > tNear[i]) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = i;
+        }
+
+        for (int k = hitCount - 1; k >= 0; k--) {
+            int i = order[k];
+            stack[stackSize++] = {node.child[i], node.count[i], masks[i]};
+        }
+    }
+}
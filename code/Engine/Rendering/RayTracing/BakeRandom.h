@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+
+// ============================================
+// SBakeRandom - counter-based RNG for CPU baking
+// ============================================
+// The n-th number of a stream is a pure function hash(key, n): there is no
+// shared generator state. Keying each stream by what is being baked (e.g.
+// brick + voxel index) makes the result independent of which thread bakes
+// it and in which order, so bakes are bit-identical for any thread count.
+//
+// Usage:
+//   SBakeRandom rng(SBakeRandom::MakeKey(brickIndex, voxelIndex));
+//   float u1 = rng.Next();
+struct SBakeRandom
+{
+    uint64_t key = 0;
+    uint64_t counter = 0;
+
+    SBakeRandom() = default;
+    explicit SBakeRandom(uint64_t streamKey, uint64_t startCounter = 0)
+        : key(streamKey), counter(startCounter) {}
+
+    // Combine up to three indices into a stream key
+    static uint64_t MakeKey(uint32_t a, uint32_t b = 0, uint32_t c = 0)
+    {
+        uint64_t h = Mix64(0x9E3779B97F4A7C15ull ^ a);
+        h = Mix64(h ^ (0xC2B2AE3D27D4EB4Full * (uint64_t(b) + 1)));
+        h = Mix64(h ^ (0x165667B19E3779F9ull * (uint64_t(c) + 1)));
+        return h;
+    }
+
+    uint32_t NextUInt()
+    {
+        return (uint32_t)(Mix64(key ^ Mix64(counter++)) >> 32);
+    }
+
+    // Uniform float in [0, 1)
+    float Next()
+    {
+        return (NextUInt() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // SplitMix64 finalizer
+    static uint64_t Mix64(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+};
@@ -0,0 +1,197 @@
+#include "MeshBVH.h"
+#include "SceneGeometryExport.h"
+#include <algorithm>
+
+using namespace DirectX;
+
+// ============================================
+// Build
+// ============================================
+
+bool CMeshBVH::Build(const SRayTracingMeshData& mesh)
+{
+    return Build(mesh.positions, mesh.indices);
+}
+
+bool CMeshBVH::Build(const std::vector<XMFLOAT3>& positions, const std::vector<uint32_t>& indices)
+{
+    Clear();
+
+    const uint32_t triCount = (uint32_t)(indices.size() / 3);
+    if (triCount == 0 || positions.empty()) {
+        return false;
+    }
+
+    std::vector<SBVHBuildPrimitive> prims(triCount);
+    for (uint32_t t = 0; t < triCount; t++) {
+        const XMFLOAT3& a = positions[indices[t * 3 + 0]];
+        const XMFLOAT3& b = positions[indices[t * 3 + 1]];
+        const XMFLOAT3& c = positions[indices[t * 3 + 2]];
+
+        SBVHBuildPrimitive& p = prims[t];
+        p.boundsMin = {std::min({a.x, b.x, c.x}), std::min({a.y, b.y, c.y}), std::min({a.z, b.z, c.z})};
+        p.boundsMax = {std::max({a.x, b.x, c.x}), std::max({a.y, b.y, c.y}), std::max({a.z, b.z, c.z})};
+        p.centroid = {(a.x + b.x + c.x) / 3.0f, (a.y + b.y + c.y) / 3.0f, (a.z + b.z + c.z) / 3.0f};
+    }
+
+    std::vector<SBVHNode> binaryNodes;
+    std::vector<uint32_t> primIndices;   // Leaf order -> original triangle
+    CBVHBuilder::Build(prims, MAX_LEAF_TRIANGLES, binaryNodes, primIndices);
+    m_bvh.BuildFromBinary(binaryNodes);
+
+    // Pack each leaf's triangle range into SBVHTriangle4 packets so a leaf
+    // reads one contiguous block; leaf slots now point at the first packet
+    m_leafSlot.assign(triCount, 0);
+    m_bvh.RemapLeaves([&](uint32_t& first, uint32_t& count) {
+        uint32_t firstPacket = (uint32_t)m_packets.size();
+        uint32_t packetCount = (count + 3) / 4;
+        for (uint32_t p = 0; p < packetCount; p++) {
+            SBVHTriangle4 packet = {};
+            for (int lane = 0; lane < 4; lane++) {
+                uint32_t slot = p * 4 + lane;
+                if (slot >= count) {
+                    packet.primIndex[lane] = BVH4_INVALID;   // e1 = e2 = 0 -> never hit
+                    continue;
+                }
+
+                uint32_t t = primIndices[first + slot];
+                const XMFLOAT3& a = positions[indices[t * 3 + 0]];
+                const XMFLOAT3& b = positions[indices[t * 3 + 1]];
+                const XMFLOAT3& c = positions[indices[t * 3 + 2]];
+                packet.v0x[lane] = a.x;
+                packet.v0y[lane] = a.y;
+                packet.v0z[lane] = a.z;
+                packet.e1x[lane] = b.x - a.x;
+                packet.e1y[lane] = b.y - a.y;
+                packet.e1z[lane] = b.z - a.z;
+                packet.e2x[lane] = c.x - a.x;
+                packet.e2y[lane] = c.y - a.y;
+                packet.e2z[lane] = c.z - a.z;
+                packet.primIndex[lane] = t;
+                m_leafSlot[t] = (uint32_t)(m_packets.size() * 4 + lane);
+            }
+            m_packets.push_back(packet);
+        }
+        first = firstPacket;
+    });
+
+    m_triangleCount = (int)triCount;
+    return true;
+}
+
+void CMeshBVH::Clear()
+{
+    m_bvh.Clear();
+    m_packets.clear();
+    m_leafSlot.clear();
+    m_triangleCount = 0;
+}
+
+XMFLOAT3 CMeshBVH::GetTriangleNormal(uint32_t primIndex) const
+{
+    if (primIndex >= m_leafSlot.size()) {
+        return {0, 1, 0};
+    }
+    const SBVHTriangle4& p = m_packets[m_leafSlot[primIndex] / 4];
+    const int lane = m_leafSlot[primIndex] % 4;
+    return {
+        p.e1y[lane] * p.e2z[lane] - p.e1z[lane] * p.e2y[lane],
+        p.e1z[lane] * p.e2x[lane] - p.e1x[lane] * p.e2z[lane],
+        p.e1x[lane] * p.e2y[lane] - p.e1y[lane] * p.e2x[lane]
+    };
+}
+
+// ============================================
+// Single-ray traversal
+// ============================================
+
+template<EBVHKernel Kernel>
+bool CMeshBVH::intersect(const SBVHRay& ray, SBVHTriangleHit& hit) const
+{
+    float tMax = std::min(ray.tMax, hit.t);
+    return m_bvh.Traverse<Kernel, false>(ray, tMax, [&](uint32_t first, uint32_t count, float& leafTMax) {
+        bool found = false;
+        const uint32_t packetCount = (count + 3) / 4;
+        for (uint32_t p = first; p < first + packetCount; p++) {
+            float t, u, v;
+            int lane = BVH4Math::IntersectTriangle4<Kernel>(ray, m_packets[p], leafTMax, t, u, v);
+            if (lane >= 0) {
+                leafTMax = t;
+                hit.t = t;
+                hit.u = u;
+                hit.v = v;
+                hit.primIndex = m_packets[p].primIndex[lane];
+                found = true;
+            }
+        }
+        return found;
+    });
+}
+
+template<EBVHKernel Kernel>
+bool CMeshBVH::occluded(const SBVHRay& ray) const
+{
+    float tMax = ray.tMax;
+    return m_bvh.Traverse<Kernel, true>(ray, tMax, [&](uint32_t first, uint32_t count, float& leafTMax) {
+        const uint32_t packetCount = (count + 3) / 4;
+        for (uint32_t p = first; p < first + packetCount; p++) {
+            if (BVH4Math::OccludedTriangle4<Kernel>(ray, m_packets[p], leafTMax)) {
+                return true;   // Early out: any hit is enough
+            }
+        }
+        return false;
+    });
+}
+
+bool CMeshBVH::Intersect(const SBVHRay& ray, SBVHTriangleHit& hit, EBVHKernel kernel) const
+{
+    if (kernel == EBVHKernel::SIMD) {
+        return intersect<EBVHKernel::SIMD>(ray, hit);
+    }
+    return intersect<EBVHKernel::Scalar>(ray, hit);
+}
+
+bool CMeshBVH::Occluded(const SBVHRay& ray, EBVHKernel kernel) const
+{
+    if (kernel == EBVHKernel::SIMD) {
+        return occluded<EBVHKernel::SIMD>(ray);
+    }
+    return occluded<EBVHKernel::Scalar>(ray);
+}
+
+// ============================================
+// Packet traversal
+// ============================================
+
+uint32_t CMeshBVH::IntersectPacket(SBVHRayPacket4& packet, uint32_t laneMask, SBVHTriangleHit hits[4]) const
+{
+    SBVHRayPacket4 local = packet;
+    local.activeMask = packet.activeMask & laneMask;
+
+    uint32_t hitMask = 0;
+    m_bvh.TraversePacket(local, [&](uint32_t first, uint32_t count, uint32_t leafLanes) {
+        const uint32_t packetCount = (count + 3) / 4;
+        for (int lane = 0; lane < 4; lane++) {
+            if (!(leafLanes & (1u << lane))) continue;
+
+            SBVHRay ray = local.GetRay(lane);
+            for (uint32_t p = first; p < first + packetCount; p++) {
+                float t, u, v;
+                int triLane = BVH4Math::IntersectTriangle4<BVH_DEFAULT_KERNEL>(ray, m_packets[p], local.tMax[lane], t, u, v);
+                if (triLane >= 0) {
+                    local.tMax[lane] = t;
+                    hits[lane].t = t;
+                    hits[lane].u = u;
+                    hits[lane].v = v;
+                    hits[lane].primIndex = m_packets[p].primIndex[triLane];
+                    hitMask |= 1u << lane;
+                }
+            }
+        }
+    });
+
+    for (int lane = 0; lane < 4; lane++) {
+        packet.tMax[lane] = local.tMax[lane];
+    }
+    return hitMask;
+}
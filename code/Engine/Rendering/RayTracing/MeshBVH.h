@@ -0,0 +1,52 @@
+#pragma once
+#include "BVH4.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+struct SRayTracingMeshData;
+
+// ============================================
+// CMeshBVH - Triangle BLAS for one mesh (object space)
+// ============================================
+// Binned-SAH build (CBVHBuilder), collapsed to a BVH4. Triangles are stored
+// in leaf order, packed 4 per SBVHTriangle4 so one SSE test covers a leaf.
+class CMeshBVH
+{
+public:
+    static const int MAX_LEAF_TRIANGLES = 4;
+
+    bool Build(const SRayTracingMeshData& mesh);
+    bool Build(const std::vector<DirectX::XMFLOAT3>& positions, const std::vector<uint32_t>& indices);
+    void Clear();
+
+    // Closest hit in (ray.tMin, ray.tMax); updates hit only if closer than hit.t
+    bool Intersect(const SBVHRay& ray, SBVHTriangleHit& hit, EBVHKernel kernel = BVH_DEFAULT_KERNEL) const;
+
+    // Any hit in (ray.tMin, ray.tMax)
+    bool Occluded(const SBVHRay& ray, EBVHKernel kernel = BVH_DEFAULT_KERNEL) const;
+
+    // Closest hit for the lanes in laneMask; shrinks packet.tMax per lane.
+    // Returns the mask of lanes whose hit was updated.
+    uint32_t IntersectPacket(SBVHRayPacket4& packet, uint32_t laneMask, SBVHTriangleHit hits[4]) const;
+
+    bool IsEmpty() const { return m_bvh.IsEmpty(); }
+    int GetNodeCount() const { return m_bvh.GetNodeCount(); }
+    int GetTriangleCount() const { return m_triangleCount; }
+    const DirectX::XMFLOAT3& GetBoundsMin() const { return m_bvh.GetBoundsMin(); }
+    const DirectX::XMFLOAT3& GetBoundsMax() const { return m_bvh.GetBoundsMax(); }
+
+    // Geometric normal of an original triangle (object space, not normalized)
+    DirectX::XMFLOAT3 GetTriangleNormal(uint32_t primIndex) const;
+
+private:
+    template<EBVHKernel Kernel>
+    bool intersect(const SBVHRay& ray, SBVHTriangleHit& hit) const;
+    template<EBVHKernel Kernel>
+    bool occluded(const SBVHRay& ray) const;
+
+    CBVH4 m_bvh;                              // Leaf: first packet, triangle count
+    std::vector<SBVHTriangle4> m_packets;     // Leaf order, 4 triangles per packet
+    std::vector<uint32_t> m_leafSlot;         // Original triangle -> packet * 4 + lane
+    int m_triangleCount = 0;
+};
@@ -1,5 +1,6 @@
 #include "PathTraceBaker.h"
 #include "RayTracer.h"
+#include "SceneGeometryExport.h"
 #include "Engine/Scene.h"
 #include "Engine/SceneLightSettings.h"
 #include "Engine/GameObject.h"
@@ -10,6 +11,7 @@
 #include "Core/FFLog.h"
 #include "Core/Loader/FFAssetLoader.h"
 #include "Core/PathManager.h"
+#include "Core/DerivedDataCache.h"
 #include <cmath>
 #include <fstream>
 #include <ktx.h>
@@ -34,10 +36,18 @@ bool CPathTraceBaker::Initialize(CScene& scene, const SPathTraceConfig& config)
 
     m_config = config;
     m_debugCubemapExported = false;
+    m_lights.clear();
+
+    // Export once: the ray tracer is built from it and the scene hash covers it
+    auto sceneData = CSceneGeometryExporter::ExportScene(scene);
+    if (!sceneData) {
+        CFFLog::Error("[PathTraceBaker] Failed to export scene geometry");
+        return false;
+    }
 
     // Create Ray Tracer
     m_rayTracer = new CRayTracer();
-    if (!m_rayTracer->Initialize(scene)) {
+    if (!m_rayTracer->Initialize(*sceneData)) {
         CFFLog::Error("[PathTraceBaker] Failed to initialize RayTracer");
         delete m_rayTracer;
         m_rayTracer = nullptr;
@@ -49,15 +59,17 @@ bool CPathTraceBaker::Initialize(CScene& scene, const SPathTraceConfig& config)
         CFFLog::Warning("[PathTraceBaker] Failed to load skybox, using fallback gradient");
     }
 
-    // Initialize random number generator
-    std::random_device rd;
-    m_rng.seed(rd());
+    // Snapshot lights (read-only while baking)
+    gatherLights(scene);
+    computeSceneHash(*sceneData);
+    m_legacyVoxelCounter = 0;
 
     m_initialized = true;
-    CFFLog::Info("[PathTraceBaker] Initialized: samples=%d, bounces=%d, RR=%s, skybox=%s",
+    CFFLog::Info("[PathTraceBaker] Initialized: samples=%d, bounces=%d, RR=%s, skybox=%s, lights=%d",
                  m_config.samplesPerVoxel, m_config.maxBounces,
                  m_config.useRussianRoulette ? "on" : "off",
-                 m_skyboxData.valid ? "loaded" : "fallback");
+                 m_skyboxData.valid ? "loaded" : "fallback",
+                 (int)m_lights.size());
 
     return true;
 }
@@ -76,6 +88,8 @@ void CPathTraceBaker::Shutdown()
     for (int i = 0; i < 6; i++) {
         m_skyboxData.faces[i].clear();
     }
+    m_lights.clear();
+    m_sceneHash = 0;
 
     m_initialized = false;
 }
@@ -136,6 +150,16 @@ void CPathTraceBaker::BakeVoxel(
 SBakeResult CPathTraceBaker::BakeVoxelWithValidity(
     const XMFLOAT3& position,
     CScene& scene)
+{
+    // Legacy interface - sequential stream keys (deterministic per call order)
+    SBakeRandom rng(SBakeRandom::MakeKey(m_legacyVoxelCounter++));
+    return BakeVoxelWithValidity(position, rng);
+}
+
+SBakeResult CPathTraceBaker::BakeVoxelWithValidity(
+    const XMFLOAT3& position,
+    SBakeRandom& rng,
+    int sampleCount) const
 {
     SBakeResult result;
     for (auto& coeff : result.sh) {
@@ -165,17 +189,17 @@ SBakeResult CPathTraceBaker::BakeVoxelWithValidity(
         }
     }
 
-    int numSamples = m_config.samplesPerVoxel;
+    int numSamples = (sampleCount > 0) ? sampleCount : m_config.samplesPerVoxel;
     int hitCount = 0;  // Count geometry hits for validity detection
 
     for (int s = 0; s < numSamples; s++)
     {
-        float u1 = random();
-        float u2 = random();
+        float u1 = rng.Next();
+        float u2 = rng.Next();
         XMFLOAT3 direction = sampleSphereUniform(u1, u2);
 
         bool hitGeometry = false;
-        XMFLOAT3 radiance = traceRadiance(position, direction, scene, 0, hitGeometry);
+        XMFLOAT3 radiance = traceRadiance(position, direction, 0, rng, hitGeometry);
 
         if (hitGeometry) {
             hitCount++;
@@ -203,6 +227,8 @@ SBakeResult CPathTraceBaker::BakeVoxelWithValidity(
 
     // Calculate validity
     result.hitRatio = (float)hitCount / (float)numSamples;
+    result.hitCount = hitCount;
+    result.sampleCount = numSamples;
     result.isValid = (result.hitRatio < m_config.validityHitThreshold);
 
     // Export debug cubemap
@@ -220,9 +246,9 @@ SBakeResult CPathTraceBaker::BakeVoxelWithValidity(
 XMFLOAT3 CPathTraceBaker::traceRadiance(
     const XMFLOAT3& origin,
     const XMFLOAT3& direction,
-    CScene& scene,
     int depth,
-    bool& outHitGeometry)
+    SBakeRandom& rng,
+    bool& outHitGeometry) const
 {
     outHitGeometry = false;
 
@@ -241,7 +267,7 @@ XMFLOAT3 CPathTraceBaker::traceRadiance(
         outHitGeometry = true;
     }
 
-    XMFLOAT3 directLight = evaluateDirectLight(hit.position, hit.normal, hit.albedo, scene);
+    XMFLOAT3 directLight = evaluateDirectLight(hit.position, hit.normal, hit.albedo);
 
     if (depth >= m_config.maxBounces) {
         return directLight;
@@ -252,13 +278,13 @@ XMFLOAT3 CPathTraceBaker::traceRadiance(
         rrProbability = std::max({hit.albedo.x, hit.albedo.y, hit.albedo.z});
         rrProbability = std::max(rrProbability, m_config.rrMinProbability);
 
-        if (random() > rrProbability) {
+        if (rng.Next() > rrProbability) {
             return directLight;
         }
     }
 
-    float u1 = random();
-    float u2 = random();
+    float u1 = rng.Next();
+    float u2 = rng.Next();
     XMFLOAT3 bounceDir = sampleHemisphereCosine(hit.normal, u1, u2);
 
     XMFLOAT3 bounceOrigin = {
@@ -268,7 +294,7 @@ XMFLOAT3 CPathTraceBaker::traceRadiance(
     };
 
     bool dummyHit;  // We don't care about hits after first bounce
-    XMFLOAT3 indirectRadiance = traceRadiance(bounceOrigin, bounceDir, scene, depth + 1, dummyHit);
+    XMFLOAT3 indirectRadiance = traceRadiance(bounceOrigin, bounceDir, depth + 1, rng, dummyHit);
 
     XMFLOAT3 indirectContrib = {
         indirectRadiance.x * hit.albedo.x,
@@ -288,177 +314,188 @@ XMFLOAT3 CPathTraceBaker::traceRadiance(
         directLight.z + indirectContrib.z
     };
 }
-SDirectionalLight* dirLight = nullptr;
+// ============================================
+// Direct Lighting
+// ============================================
 
-XMFLOAT3 CPathTraceBaker::evaluateDirectLight(
-    const XMFLOAT3& hitPos,
-    const XMFLOAT3& hitNormal,
-    const XMFLOAT3& albedo,
-    CScene& scene)
+void CPathTraceBaker::gatherLights(CScene& scene)
 {
-    XMFLOAT3 totalLight = {0, 0, 0};
+    m_lights.clear();
     auto& world = scene.GetWorld();
-    //static SDirectionalLight* dirLight;
-    
 
-    if (dirLight)
-    {
-        XMFLOAT3 dir = dirLight->GetDirection();
-        XMFLOAT3 lightDir = {-dir.x, -dir.y, -dir.z};
-
-        float NdotL = hitNormal.x * lightDir.x +
-                        hitNormal.y * lightDir.y +
-                        hitNormal.z * lightDir.z;
-
-        if (NdotL > 0.0f) {
-            XMFLOAT3 shadowOrigin = {
-                hitPos.x + hitNormal.x * 0.001f,
-                hitPos.y + hitNormal.y * 0.001f,
-                hitPos.z + hitNormal.z * 0.001f
-            };
-
-            bool inShadow = m_rayTracer->TraceShadowRay(shadowOrigin, lightDir, 1000.0f);
-
-            if (!inShadow) {
-                float intensity = dirLight->intensity;
-                totalLight.x += dirLight->color.x * intensity * albedo.x * NdotL * INV_PI;
-                totalLight.y += dirLight->color.y * intensity * albedo.y * NdotL * INV_PI;
-                totalLight.z += dirLight->color.z * intensity * albedo.z * NdotL * INV_PI;
-            }
-        }
-        return totalLight;
-    }
-    else
+    // A directional light, when present, is the only direct light source
+    // (same behaviour as the previous per-sample scene walk)
+    for (size_t i = 0; i < world.Count(); i++)
     {
+        auto* obj = world.Get(i);
+        if (!obj || !obj->GetComponent<STransform>())
+            continue;
 
-        for (size_t i = 0; i < world.Count(); i++)
+        if (auto* dirLight = obj->GetComponent<SDirectionalLight>())
         {
-            auto* obj = world.Get(i);
-            if (!obj)
-                continue;
-
-            auto* transform = obj->GetComponent<STransform>();
-            if (!transform)
-                continue;
-
-            // Directional Light
-            dirLight = obj->GetComponent<SDirectionalLight>();
-            if (dirLight)
-            {
-                XMFLOAT3 dir = dirLight->GetDirection();
-                XMFLOAT3 lightDir = {-dir.x, -dir.y, -dir.z};
-
-                float NdotL = hitNormal.x * lightDir.x + hitNormal.y * lightDir.y + hitNormal.z * lightDir.z;
-
-                if (NdotL > 0.0f)
-                {
-                    XMFLOAT3 shadowOrigin = {hitPos.x + hitNormal.x * 0.001f, hitPos.y + hitNormal.y * 0.001f,
-                                             hitPos.z + hitNormal.z * 0.001f};
-
-                    bool inShadow = m_rayTracer->TraceShadowRay(shadowOrigin, lightDir, 1000.0f);
-
-                    if (!inShadow)
-                    {
-                        float intensity = dirLight->intensity;
-                        totalLight.x += dirLight->color.x * intensity * albedo.x * NdotL * INV_PI;
-                        totalLight.y += dirLight->color.y * intensity * albedo.y * NdotL * INV_PI;
-                        totalLight.z += dirLight->color.z * intensity * albedo.z * NdotL * INV_PI;
-                    }
-                }
-                break;
-            }
-
-            // Point Light
-            auto* pointLight = obj->GetComponent<SPointLight>();
-            if (pointLight)
-            {
-                XMFLOAT3 lightPos = transform->position;
-                XMFLOAT3 toLight = {lightPos.x - hitPos.x, lightPos.y - hitPos.y, lightPos.z - hitPos.z};
+            SPathTraceLight light;
+            light.type = SPathTraceLight::EType::Directional;
+            light.direction = dirLight->GetDirection();
+            light.radiance = {dirLight->color.x * dirLight->intensity,
+                              dirLight->color.y * dirLight->intensity,
+                              dirLight->color.z * dirLight->intensity};
+            m_lights.push_back(light);
+            return;
+        }
+    }
 
-                float dist = std::sqrt(toLight.x * toLight.x + toLight.y * toLight.y + toLight.z * toLight.z);
-                if (dist < 0.001f)
-                    continue;
+    for (size_t i = 0; i < world.Count(); i++)
+    {
+        auto* obj = world.Get(i);
+        if (!obj)
+            continue;
 
-                XMFLOAT3 lightDir = {toLight.x / dist, toLight.y / dist, toLight.z / dist};
+        auto* transform = obj->GetComponent<STransform>();
+        if (!transform)
+            continue;
 
-                float NdotL = hitNormal.x * lightDir.x + hitNormal.y * lightDir.y + hitNormal.z * lightDir.z;
+        if (auto* pointLight = obj->GetComponent<SPointLight>())
+        {
+            SPathTraceLight light;
+            light.type = SPathTraceLight::EType::Point;
+            light.position = transform->GetWorldPosition();
+            light.radiance = {pointLight->color.x * pointLight->intensity,
+                              pointLight->color.y * pointLight->intensity,
+                              pointLight->color.z * pointLight->intensity};
+            m_lights.push_back(light);
+            continue;
+        }
 
-                if (NdotL > 0.0f)
-                {
-                    XMFLOAT3 shadowOrigin = {hitPos.x + hitNormal.x * 0.001f, hitPos.y + hitNormal.y * 0.001f,
-                                             hitPos.z + hitNormal.z * 0.001f};
+        if (auto* spotLight = obj->GetComponent<SSpotLight>())
+        {
+            SPathTraceLight light;
+            light.type = SPathTraceLight::EType::Spot;
+            light.position = transform->GetWorldPosition();
+            light.direction = spotLight->direction;
+            light.innerCos = std::cos(spotLight->innerConeAngle * PI / 180.0f);
+            light.outerCos = std::cos(spotLight->outerConeAngle * PI / 180.0f);
+            light.radiance = {spotLight->color.x * spotLight->intensity,
+                              spotLight->color.y * spotLight->intensity,
+                              spotLight->color.z * spotLight->intensity};
+            m_lights.push_back(light);
+        }
+    }
+}
 
-                    bool inShadow = m_rayTracer->TraceShadowRay(shadowOrigin, lightDir, dist - 0.001f);
+void CPathTraceBaker::computeSceneHash(const SRayTracingSceneData& sceneData)
+{
+    // Fields are added one by one: the exported structs have uninitialized padding
+    CDerivedDataKeyBuilder builder("pathtrace-scene", 1);
 
-                    if (!inShadow)
-                    {
-                        float attenuation = 1.0f / (dist * dist);
-                        float intensity = pointLight->intensity * attenuation;
+    builder.Add((uint32_t)sceneData.meshes.size());
+    for (const auto& mesh : sceneData.meshes) {
+        builder.Add(mesh.positions.data(), mesh.positions.size() * sizeof(XMFLOAT3));
+        builder.Add(mesh.indices.data(), mesh.indices.size() * sizeof(uint32_t));
+    }
 
-                        totalLight.x += pointLight->color.x * intensity * albedo.x * NdotL * INV_PI;
-                        totalLight.y += pointLight->color.y * intensity * albedo.y * NdotL * INV_PI;
-                        totalLight.z += pointLight->color.z * intensity * albedo.z * NdotL * INV_PI;
-                    }
-                }
-                continue;
-            }
+    builder.Add((uint32_t)sceneData.instances.size());
+    for (const auto& instance : sceneData.instances) {
+        builder.Add(&instance.worldTransform, sizeof(XMFLOAT4X4));
+        builder.Add(instance.meshIndex);
+        builder.Add(instance.materialIndex);
+    }
 
-            // Spot Light
-            auto* spotLight = obj->GetComponent<SSpotLight>();
-            if (spotLight)
-            {
-                XMFLOAT3 lightPos = transform->position;
-                XMFLOAT3 toLight = {lightPos.x - hitPos.x, lightPos.y - hitPos.y, lightPos.z - hitPos.z};
+    builder.Add((uint32_t)sceneData.materials.size());
+    for (const auto& material : sceneData.materials) {
+        builder.Add(&material.albedo, sizeof(XMFLOAT3));
+        builder.Add(material.metallic);
+        builder.Add(material.roughness);
+    }
 
-                float dist = std::sqrt(toLight.x * toLight.x + toLight.y * toLight.y + toLight.z * toLight.z);
-                if (dist < 0.001f)
-                    continue;
+    builder.Add((uint32_t)m_lights.size());
+    for (const auto& light : m_lights) {
+        builder.Add((uint32_t)light.type);
+        builder.Add(&light.radiance, sizeof(XMFLOAT3));
+        builder.Add(&light.position, sizeof(XMFLOAT3));
+        builder.Add(&light.direction, sizeof(XMFLOAT3));
+        builder.Add(light.innerCos);
+        builder.Add(light.outerCos);
+    }
 
-                XMFLOAT3 lightDir = {toLight.x / dist, toLight.y / dist, toLight.z / dist};
+    // No skybox = the fallback gradient
+    builder.Add(m_skyboxData.valid);
+    if (m_skyboxData.valid) {
+        builder.Add((uint32_t)m_skyboxData.size);
+        for (const auto& face : m_skyboxData.faces) {
+            builder.Add(face.data(), face.size() * sizeof(XMFLOAT4));
+        }
+    }
 
-                float cosAngle = -(lightDir.x * spotLight->direction.x + lightDir.y * spotLight->direction.y +
-                                   lightDir.z * spotLight->direction.z);
+    m_sceneHash = builder.Build().hash[0];
+}
 
-                float outerCos = std::cos(spotLight->outerConeAngle * PI / 180.0f);
-                float innerCos = std::cos(spotLight->innerConeAngle * PI / 180.0f);
+XMFLOAT3 CPathTraceBaker::evaluateDirectLight(
+    const XMFLOAT3& hitPos,
+    const XMFLOAT3& hitNormal,
+    const XMFLOAT3& albedo) const
+{
+    XMFLOAT3 totalLight = {0, 0, 0};
 
-                if (cosAngle > outerCos)
-                {
-                    float NdotL = hitNormal.x * lightDir.x + hitNormal.y * lightDir.y + hitNormal.z * lightDir.z;
+    XMFLOAT3 shadowOrigin = {
+        hitPos.x + hitNormal.x * 0.001f,
+        hitPos.y + hitNormal.y * 0.001f,
+        hitPos.z + hitNormal.z * 0.001f
+    };
 
-                    if (NdotL > 0.0f)
-                    {
-                        XMFLOAT3 shadowOrigin = {hitPos.x + hitNormal.x * 0.001f, hitPos.y + hitNormal.y * 0.001f,
-                                                 hitPos.z + hitNormal.z * 0.001f};
+    for (const SPathTraceLight& light : m_lights)
+    {
+        XMFLOAT3 lightDir;
+        float shadowDistance = 1000.0f;
+        float scale = 1.0f;
 
-                        bool inShadow = m_rayTracer->TraceShadowRay(shadowOrigin, lightDir, dist - 0.001f);
+        if (light.type == SPathTraceLight::EType::Directional)
+        {
+            lightDir = {-light.direction.x, -light.direction.y, -light.direction.z};
+        }
+        else
+        {
+            XMFLOAT3 toLight = {light.position.x - hitPos.x, light.position.y - hitPos.y, light.position.z - hitPos.z};
+            float dist = std::sqrt(toLight.x * toLight.x + toLight.y * toLight.y + toLight.z * toLight.z);
+            if (dist < 0.001f)
+                continue;
 
-                        if (!inShadow)
-                        {
-                            float spotFactor = (cosAngle - outerCos) / (innerCos - outerCos);
-                            spotFactor = std::clamp(spotFactor, 0.0f, 1.0f);
+            lightDir = {toLight.x / dist, toLight.y / dist, toLight.z / dist};
+            shadowDistance = dist - 0.001f;
+            scale = 1.0f / (dist * dist);
 
-                            float attenuation = 1.0f / (dist * dist);
-                            float intensity = spotLight->intensity * attenuation * spotFactor;
+            if (light.type == SPathTraceLight::EType::Spot)
+            {
+                float cosAngle = -(lightDir.x * light.direction.x + lightDir.y * light.direction.y +
+                                   lightDir.z * light.direction.z);
+                if (cosAngle <= light.outerCos)
+                    continue;
 
-                            totalLight.x += spotLight->color.x * intensity * albedo.x * NdotL * INV_PI;
-                            totalLight.y += spotLight->color.y * intensity * albedo.y * NdotL * INV_PI;
-                            totalLight.z += spotLight->color.z * intensity * albedo.z * NdotL * INV_PI;
-                        }
-                    }
-                }
+                float spotFactor = (cosAngle - light.outerCos) / (light.innerCos - light.outerCos);
+                scale *= std::clamp(spotFactor, 0.0f, 1.0f);
             }
         }
 
-        return totalLight;
+        float NdotL = hitNormal.x * lightDir.x + hitNormal.y * lightDir.y + hitNormal.z * lightDir.z;
+        if (NdotL <= 0.0f)
+            continue;
+
+        if (m_rayTracer->TraceShadowRay(shadowOrigin, lightDir, shadowDistance))
+            continue;
+
+        float k = scale * NdotL * INV_PI;
+        totalLight.x += light.radiance.x * albedo.x * k;
+        totalLight.y += light.radiance.y * albedo.y * k;
+        totalLight.z += light.radiance.z * albedo.z * k;
     }
+
+    return totalLight;
 }
 
 // ============================================
 // Skybox Sampling
 // ============================================
 
-XMFLOAT3 CPathTraceBaker::sampleSkybox(const XMFLOAT3& direction)
+XMFLOAT3 CPathTraceBaker::sampleSkybox(const XMFLOAT3& direction) const
 {
     if (!m_skyboxData.valid) {
         float skyFactor = direction.y * 0.5f + 0.5f;
@@ -483,7 +520,7 @@ XMFLOAT3 CPathTraceBaker::sampleSkybox(const XMFLOAT3& direction)
     return color;
 }
 
-void CPathTraceBaker::directionToCubemapUV(const XMFLOAT3& dir, int& face, float& u, float& v)
+void CPathTraceBaker::directionToCubemapUV(const XMFLOAT3& dir, int& face, float& u, float& v) const
 {
     float absX = std::abs(dir.x);
     float absY = std::abs(dir.y);
@@ -533,7 +570,7 @@ void CPathTraceBaker::directionToCubemapUV(const XMFLOAT3& dir, int& face, float
     v = std::clamp(v, 0.0f, 1.0f);
 }
 
-XMFLOAT3 CPathTraceBaker::sampleCubemapFace(int face, float u, float v)
+XMFLOAT3 CPathTraceBaker::sampleCubemapFace(int face, float u, float v) const
 {
     if (face < 0 || face >= 6 || m_skyboxData.faces[face].empty()) {
         return {0, 0, 0};
@@ -569,9 +606,9 @@ XMFLOAT3 CPathTraceBaker::sampleCubemapFace(int face, float u, float v)
 // Debug Cubemap Export
 // ============================================
 
-bool CPathTraceBaker::shouldExportDebugCubemap(const XMFLOAT3& position)
+bool CPathTraceBaker::shouldExportDebugCubemap(const XMFLOAT3& position) const
 {
-    if (!m_config.debugExportCubemap || m_debugCubemapExported) {
+    if (!m_config.debugExportCubemap || m_debugCubemapExported.load(std::memory_order_relaxed)) {
         return false;
     }
 
@@ -580,16 +617,19 @@ bool CPathTraceBaker::shouldExportDebugCubemap(const XMFLOAT3& position)
     float dz = position.z - m_config.debugExportPosition.z;
     float distSq = dx*dx + dy*dy + dz*dz;
 
-    return distSq <= m_config.debugExportRadius * m_config.debugExportRadius;
+    if (distSq > m_config.debugExportRadius * m_config.debugExportRadius) {
+        return false;
+    }
+
+    // Only one voxel (and one bake thread) exports
+    return !m_debugCubemapExported.exchange(true);
 }
 
 void CPathTraceBaker::exportDebugCubemapFromSamples(
     const XMFLOAT3& position,
     const std::vector<std::vector<XMFLOAT3>>& cubemapAccum,
-    const std::vector<std::vector<float>>& cubemapWeights)
+    const std::vector<std::vector<float>>& cubemapWeights) const
 {
-    m_debugCubemapExported = true;
-
     int resolution = m_config.debugCubemapResolution;
     CFFLog::Info("[PathTraceBaker] Exporting debug cubemap from samples at (%.2f, %.2f, %.2f), resolution=%d",
                  position.x, position.y, position.z, resolution);
@@ -688,7 +728,7 @@ void CPathTraceBaker::exportDebugCubemapFromSamples(
 // Sampling Utils
 // ============================================
 
-XMFLOAT3 CPathTraceBaker::sampleSphereUniform(float u1, float u2)
+XMFLOAT3 CPathTraceBaker::sampleSphereUniform(float u1, float u2) const
 {
     float z = 1.0f - 2.0f * u1;
     float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
@@ -703,7 +743,7 @@ XMFLOAT3 CPathTraceBaker::sampleSphereUniform(float u1, float u2)
 
 XMFLOAT3 CPathTraceBaker::sampleHemisphereCosine(
     const XMFLOAT3& normal,
-    float u1, float u2)
+    float u1, float u2) const
 {
     float r = std::sqrt(u1);
     float theta = 2.0f * PI * u2;
@@ -725,7 +765,7 @@ XMFLOAT3 CPathTraceBaker::sampleHemisphereCosine(
 void CPathTraceBaker::buildTangentBasis(
     const XMFLOAT3& normal,
     XMFLOAT3& tangent,
-    XMFLOAT3& bitangent)
+    XMFLOAT3& bitangent) const
 {
     if (normal.z < -0.9999f) {
         tangent = {0.0f, -1.0f, 0.0f};
@@ -742,7 +782,7 @@ void CPathTraceBaker::buildTangentBasis(
 // SH Projection
 // ============================================
 
-void CPathTraceBaker::evaluateSHBasis(const XMFLOAT3& dir, float basis[9])
+void CPathTraceBaker::evaluateSHBasis(const XMFLOAT3& dir, float basis[9]) const
 {
     basis[0] = 0.282095f;
 
@@ -761,7 +801,7 @@ void CPathTraceBaker::accumulateToSH(
     const XMFLOAT3& direction,
     const XMFLOAT3& radiance,
     float weight,
-    std::array<XMFLOAT3, 9>& outSH)
+    std::array<XMFLOAT3, 9>& outSH) const
 {
     float basis[9];
     evaluateSHBasis(direction, basis);
@@ -1,13 +1,15 @@
 #pragma once
 #include <DirectXMath.h>
 #include <array>
-#include <random>
+#include <atomic>
 #include <vector>
 #include <string>
 #include "Core/Loader/KTXLoader.h"
+#include "BakeRandom.h"
 
 class CScene;
 class CRayTracer;
+struct SRayTracingSceneData;
 
 // ============================================
 // Path Tracing Config
@@ -40,11 +42,31 @@ struct SBakeResult
     std::array<DirectX::XMFLOAT3, 9> sh;  // SH coefficients
     bool isValid = true;                    // false if probe is inside geometry
     float hitRatio = 0.0f;                  // geometry hit ratio (0-1)
+    int hitCount = 0;                       // geometry hits
+    int sampleCount = 0;                    // samples taken (sh is normalized by this)
+};
+
+// ============================================
+// Direct light snapshot (taken at Initialize, read-only while baking)
+// ============================================
+struct SPathTraceLight
+{
+    enum class EType { Directional, Point, Spot };
+
+    EType type = EType::Directional;
+    DirectX::XMFLOAT3 radiance = {0, 0, 0};      // color * intensity
+    DirectX::XMFLOAT3 position = {0, 0, 0};
+    DirectX::XMFLOAT3 direction = {0, -1, 0};    // Light travel direction (dir / spot)
+    float innerCos = 1.0f;                       // Spot only
+    float outerCos = 0.0f;
 };
 
 // ============================================
 // CPathTraceBaker - Path Tracing Baker
 // ============================================
+// BakeVoxelWithValidity(position, rng) is const and thread-safe: one baker
+// (BVH + skybox + lights) is shared by all bake threads, and every voxel
+// draws from its own SBakeRandom stream.
 class CPathTraceBaker
 {
 public:
@@ -63,12 +85,20 @@ public:
         std::array<DirectX::XMFLOAT3, 9>& outSH
     );
 
-    // Baking with validity detection
+    // Baking with validity detection (sequential stream keys, not thread-safe)
     SBakeResult BakeVoxelWithValidity(
         const DirectX::XMFLOAT3& position,
         CScene& scene
     );
 
+    // Baking with validity detection using the caller's RNG stream (thread-safe)
+    // sampleCount: 0 = config.samplesPerVoxel (progressive bakes pass one pass worth)
+    SBakeResult BakeVoxelWithValidity(
+        const DirectX::XMFLOAT3& position,
+        SBakeRandom& rng,
+        int sampleCount = 0
+    ) const;
+
     // Config
     const SPathTraceConfig& GetConfig() const { return m_config; }
     void SetConfig(const SPathTraceConfig& config) { m_config = config; }
@@ -76,49 +106,55 @@ public:
     bool IsInitialized() const { return m_initialized; }
     bool HasSkybox() const { return m_skyboxData.valid; }
 
+    // Hash of everything Initialize() snapshots for baking: exported geometry,
+    // instance transforms, materials, lights and the skybox texels
+    uint64_t GetSceneHash() const { return m_sceneHash; }
+
 private:
     // Path Tracing Core
     DirectX::XMFLOAT3 traceRadiance(
         const DirectX::XMFLOAT3& origin,
         const DirectX::XMFLOAT3& direction,
-        CScene& scene,
         int depth,
+        SBakeRandom& rng,
         bool& outHitGeometry  // output: did ray hit geometry?
-    );
+    ) const;
 
     DirectX::XMFLOAT3 evaluateDirectLight(
         const DirectX::XMFLOAT3& hitPos,
         const DirectX::XMFLOAT3& hitNormal,
-        const DirectX::XMFLOAT3& albedo,
-        CScene& scene
-    );
+        const DirectX::XMFLOAT3& albedo
+    ) const;
 
-    DirectX::XMFLOAT3 sampleSkybox(const DirectX::XMFLOAT3& direction);
+    void gatherLights(CScene& scene);
+    void computeSceneHash(const SRayTracingSceneData& sceneData);
+
+    DirectX::XMFLOAT3 sampleSkybox(const DirectX::XMFLOAT3& direction) const;
 
     // Skybox Sampling
     bool loadSkyboxToCPU(CScene& scene);
-    void directionToCubemapUV(const DirectX::XMFLOAT3& dir, int& face, float& u, float& v);
-    DirectX::XMFLOAT3 sampleCubemapFace(int face, float u, float v);
+    void directionToCubemapUV(const DirectX::XMFLOAT3& dir, int& face, float& u, float& v) const;
+    DirectX::XMFLOAT3 sampleCubemapFace(int face, float u, float v) const;
 
     // Debug Cubemap Export
-    bool shouldExportDebugCubemap(const DirectX::XMFLOAT3& position);
+    bool shouldExportDebugCubemap(const DirectX::XMFLOAT3& position) const;
     void exportDebugCubemapFromSamples(
         const DirectX::XMFLOAT3& position,
         const std::vector<std::vector<DirectX::XMFLOAT3>>& cubemapAccum,
         const std::vector<std::vector<float>>& cubemapWeights
-    );
+    ) const;
 
     // Sampling Utils
     DirectX::XMFLOAT3 sampleHemisphereCosine(
         const DirectX::XMFLOAT3& normal,
         float u1, float u2
-    );
-    DirectX::XMFLOAT3 sampleSphereUniform(float u1, float u2);
+    ) const;
+    DirectX::XMFLOAT3 sampleSphereUniform(float u1, float u2) const;
     void buildTangentBasis(
         const DirectX::XMFLOAT3& normal,
         DirectX::XMFLOAT3& tangent,
         DirectX::XMFLOAT3& bitangent
-    );
+    ) const;
 
     // SH Projection
     void accumulateToSH(
@@ -126,8 +162,8 @@ private:
         const DirectX::XMFLOAT3& radiance,
         float weight,
         std::array<DirectX::XMFLOAT3, 9>& outSH
-    );
-    void evaluateSHBasis(const DirectX::XMFLOAT3& dir, float basis[9]);
+    ) const;
+    void evaluateSHBasis(const DirectX::XMFLOAT3& dir, float basis[9]) const;
 
 private:
     bool m_initialized = false;
@@ -135,10 +171,10 @@ private:
 
     CRayTracer* m_rayTracer = nullptr;
     CKTXLoader::SCubemapCPUData m_skyboxData;
-    bool m_debugCubemapExported = false;
-
-    std::mt19937 m_rng;
-    std::uniform_real_distribution<float> m_dist{0.0f, 1.0f};
+    std::vector<SPathTraceLight> m_lights;
+    uint64_t m_sceneHash = 0;
+    mutable std::atomic<bool> m_debugCubemapExported{false};
 
-    float random() { return m_dist(m_rng); }
+    // Stream key counter for the legacy (scene) overload
+    uint32_t m_legacyVoxelCounter = 0;
 };
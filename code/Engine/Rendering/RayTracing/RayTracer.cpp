@@ -1,52 +1,164 @@
 #include "RayTracer.h"
+#include "SceneGeometryExport.h"
 #include "Engine/Scene.h"
-#include "Engine/GameObject.h"
-#include "Engine/Components/Transform.h"
-#include "Engine/Components/MeshRenderer.h"
-#include "Core/MaterialAsset.h"
-#include "Core/MaterialManager.h"
 #include "Core/FFLog.h"
 #include <algorithm>
 #include <cfloat>
+#include <chrono>
+#include <cmath>
 
 using namespace DirectX;
 
+// ============================================
+// 矩阵工具（3x4 仿射，列向量约定）
+// ============================================
+
+namespace
+{
+    // XMFLOAT4X4 (DirectX row-vector, p' = p * M) -> 3x4 column-vector form
+    SAffine3x4 toAffine(const XMFLOAT4X4& m)
+    {
+        SAffine3x4 a;
+        for (int r = 0; r < 3; r++) {
+            a.m[r][0] = m.m[0][r];
+            a.m[r][1] = m.m[1][r];
+            a.m[r][2] = m.m[2][r];
+            a.m[r][3] = m.m[3][r];
+        }
+        return a;
+    }
+
+    bool invertAffine(const SAffine3x4& a, SAffine3x4& out)
+    {
+        const float (*m)[4] = a.m;
+        float c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+        float c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+        float c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+        float det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+        if (std::abs(det) < 1e-20f) {
+            return false;
+        }
+        float inv = 1.0f / det;
+
+        float r[3][3];
+        r[0][0] = c00 * inv;
+        r[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv;
+        r[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv;
+        r[1][0] = c01 * inv;
+        r[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv;
+        r[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv;
+        r[2][0] = c02 * inv;
+        r[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv;
+        r[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv;
+
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                out.m[i][j] = r[i][j];
+            }
+            out.m[i][3] = -(r[i][0] * m[0][3] + r[i][1] * m[1][3] + r[i][2] * m[2][3]);
+        }
+        return true;
+    }
+
+    inline XMFLOAT3 transformPoint(const SAffine3x4& a, const XMFLOAT3& p)
+    {
+        return {
+            a.m[0][0] * p.x + a.m[0][1] * p.y + a.m[0][2] * p.z + a.m[0][3],
+            a.m[1][0] * p.x + a.m[1][1] * p.y + a.m[1][2] * p.z + a.m[1][3],
+            a.m[2][0] * p.x + a.m[2][1] * p.y + a.m[2][2] * p.z + a.m[2][3]
+        };
+    }
+
+    inline XMFLOAT3 transformVector(const SAffine3x4& a, const XMFLOAT3& v)
+    {
+        return {
+            a.m[0][0] * v.x + a.m[0][1] * v.y + a.m[0][2] * v.z,
+            a.m[1][0] * v.x + a.m[1][1] * v.y + a.m[1][2] * v.z,
+            a.m[2][0] * v.x + a.m[2][1] * v.y + a.m[2][2] * v.z
+        };
+    }
+
+    // Normal transform = inverse-transpose: n' = (worldToObject)^T * n
+    inline XMFLOAT3 transformNormal(const SAffine3x4& worldToObject, const XMFLOAT3& n)
+    {
+        const float (*m)[4] = worldToObject.m;
+        return {
+            m[0][0] * n.x + m[1][0] * n.y + m[2][0] * n.z,
+            m[0][1] * n.x + m[1][1] * n.y + m[2][1] * n.z,
+            m[0][2] * n.x + m[1][2] * n.y + m[2][2] * n.z
+        };
+    }
+
+    inline XMFLOAT3 normalize3(const XMFLOAT3& v)
+    {
+        float len = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+        if (len < 1e-20f) return {0, 1, 0};
+        float inv = 1.0f / len;
+        return {v.x * inv, v.y * inv, v.z * inv};
+    }
+
+    inline SBVHRay makeRay(const SRay& ray)
+    {
+        SBVHRay r;
+        r.origin = ray.origin;
+        r.direction = ray.direction;
+        r.tMin = ray.tMin;
+        r.tMax = ray.tMax;
+        r.UpdateInvDirection();
+        return r;
+    }
+}
+
 // ============================================
 // 初始化
 // ============================================
 
 bool CRayTracer::Initialize(CScene& scene)
+{
+    auto sceneData = CSceneGeometryExporter::ExportScene(scene);
+    if (!sceneData) {
+        CFFLog::Error("[RayTracer] Failed to export scene geometry");
+        return false;
+    }
+    return Initialize(*sceneData);
+}
+
+bool CRayTracer::Initialize(const SRayTracingSceneData& sceneData)
 {
     if (m_initialized) {
         CFFLog::Warning("[RayTracer] Already initialized, rebuilding...");
         Shutdown();
     }
 
-    // 提取场景物体
-    extractObjectsFromScene(scene);
+    auto startTime = std::chrono::high_resolution_clock::now();
 
-    if (m_objects.empty()) {
-        CFFLog::Warning("[RayTracer] No objects to trace!");
+    buildMeshBVHs(sceneData);
+    buildInstances(sceneData);
+
+    if (m_instances.empty()) {
+        CFFLog::Warning("[RayTracer] No triangle geometry to trace!");
         m_initialized = true;
         return true;
     }
 
-    // 构建 BVH
-    buildBVH();
+    buildTLAS();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    float buildMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
 
     m_initialized = true;
-    CFFLog::Info("[RayTracer] Initialized: %d objects, %d BVH nodes",
-                 (int)m_objects.size(), (int)m_bvhNodes.size());
+    CFFLog::Info("[RayTracer] Initialized: %d meshes (%d triangles), %d instances, %d BVH nodes, build %.1f ms",
+                 (int)m_meshBVHs.size(), GetTriangleCount(), (int)m_instances.size(),
+                 GetBVHNodeCount(), buildMs);
 
     return true;
 }
 
 void CRayTracer::Shutdown()
 {
-    m_objects.clear();
-    m_objectIndices.clear();
-    m_bvhNodes.clear();
-    m_rootNode = -1;
+    m_meshBVHs.clear();
+    m_instances.clear();
+    m_tlas.Clear();
     m_initialized = false;
 }
 
@@ -56,344 +168,237 @@ void CRayTracer::Rebuild(CScene& scene)
     Initialize(scene);
 }
 
+int CRayTracer::GetTriangleCount() const
+{
+    int count = 0;
+    for (const auto& bvh : m_meshBVHs) {
+        count += bvh.GetTriangleCount();
+    }
+    return count;
+}
+
+int CRayTracer::GetBVHNodeCount() const
+{
+    int count = m_tlas.GetNodeCount();
+    for (const auto& bvh : m_meshBVHs) {
+        count += bvh.GetNodeCount();
+    }
+    return count;
+}
+
 // ============================================
-// 场景物体提取
+// BVH 构建
 // ============================================
 
-void CRayTracer::extractObjectsFromScene(CScene& scene)
+void CRayTracer::buildMeshBVHs(const SRayTracingSceneData& sceneData)
 {
-    m_objects.clear();
-    auto& world = scene.GetWorld();
-
-    for (size_t i = 0; i < world.Count(); i++)
-    {
-        auto* obj = world.Get(i);
-        if (!obj) continue;
+    m_meshBVHs.clear();
+    m_meshBVHs.resize(sceneData.meshes.size());
 
-        auto* transform = obj->GetComponent<STransform>();
-        auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
+    for (size_t i = 0; i < sceneData.meshes.size(); i++) {
+        if (!m_meshBVHs[i].Build(sceneData.meshes[i])) {
+            CFFLog::Warning("[RayTracer] Mesh has no triangles: %s", sceneData.meshes[i].sourcePath.c_str());
+        }
+    }
+}
 
-        if (!transform || !meshRenderer) continue;
+void CRayTracer::buildInstances(const SRayTracingSceneData& sceneData)
+{
+    m_instances.clear();
+    m_instances.reserve(sceneData.instances.size());
 
-        // 获取局部空间 AABB
-        XMFLOAT3 localMin, localMax;
-        if (!meshRenderer->GetLocalBounds(localMin, localMax)) {
+    for (size_t i = 0; i < sceneData.instances.size(); i++) {
+        const SRayTracingInstance& src = sceneData.instances[i];
+        if (src.meshIndex >= m_meshBVHs.size() || m_meshBVHs[src.meshIndex].IsEmpty()) {
             continue;
         }
 
-        // 将局部 AABB 的 8 个顶点变换到世界空间
-        XMMATRIX worldMatrix = transform->WorldMatrix();
-
-        XMFLOAT3 localCorners[8] = {
-            {localMin.x, localMin.y, localMin.z},
-            {localMax.x, localMin.y, localMin.z},
-            {localMin.x, localMax.y, localMin.z},
-            {localMax.x, localMax.y, localMin.z},
-            {localMin.x, localMin.y, localMax.z},
-            {localMax.x, localMin.y, localMax.z},
-            {localMin.x, localMax.y, localMax.z},
-            {localMax.x, localMax.y, localMax.z}
-        };
-
-        // 计算世界空间 AABB
-        XMFLOAT3 worldMin = {FLT_MAX, FLT_MAX, FLT_MAX};
-        XMFLOAT3 worldMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
-
-        for (int c = 0; c < 8; c++) {
-            XMVECTOR localPt = XMLoadFloat3(&localCorners[c]);
-            XMVECTOR worldPt = XMVector3Transform(localPt, worldMatrix);
-            XMFLOAT3 wp;
-            XMStoreFloat3(&wp, worldPt);
-
-            worldMin.x = std::min(worldMin.x, wp.x);
-            worldMin.y = std::min(worldMin.y, wp.y);
-            worldMin.z = std::min(worldMin.z, wp.z);
-            worldMax.x = std::max(worldMax.x, wp.x);
-            worldMax.y = std::max(worldMax.y, wp.y);
-            worldMax.z = std::max(worldMax.z, wp.z);
+        SRayTracerInstance inst;
+        inst.objectToWorld = toAffine(src.worldTransform);
+        if (!invertAffine(inst.objectToWorld, inst.worldToObject)) {
+            continue;  // Degenerate (zero scale)
         }
-
-        // 获取材质 albedo
-        XMFLOAT3 albedo = {0.5f, 0.5f, 0.5f};  // 默认灰色
-        if (!meshRenderer->materialPath.empty()) {
-            CMaterialAsset* material = CMaterialManager::Instance().Load(meshRenderer->materialPath);
-            if (material) {
-                albedo = material->albedo;
-            }
+        inst.meshIndex = src.meshIndex;
+        inst.instanceIndex = (int)i;
+        if (src.materialIndex < sceneData.materials.size()) {
+            inst.albedo = sceneData.materials[src.materialIndex].albedo;
         }
 
-        // 创建 AABB 物体
-        SAABBObject aabbObj;
-        aabbObj.boundsMin = worldMin;
-        aabbObj.boundsMax = worldMax;
-        aabbObj.albedo = albedo;
-        aabbObj.sceneObjectIndex = (int)i;
-
-        m_objects.push_back(aabbObj);
-    }
-}
-
-// ============================================
-// BVH 构建
-// ============================================
-
-void CRayTracer::buildBVH()
-{
-    if (m_objects.empty()) {
-        m_rootNode = -1;
-        return;
-    }
+        // 世界 AABB：变换 BLAS 根节点的 8 个角点
+        const CMeshBVH& mesh = m_meshBVHs[src.meshIndex];
+        inst.boundsMin = {FLT_MAX, FLT_MAX, FLT_MAX};
+        inst.boundsMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+        for (int c = 0; c < 8; c++) {
+            XMFLOAT3 corner = {
+                (c & 1) ? mesh.GetBoundsMax().x : mesh.GetBoundsMin().x,
+                (c & 2) ? mesh.GetBoundsMax().y : mesh.GetBoundsMin().y,
+                (c & 4) ? mesh.GetBoundsMax().z : mesh.GetBoundsMin().z
+            };
+            XMFLOAT3 w = transformPoint(inst.objectToWorld, corner);
+            inst.boundsMin = {std::min(inst.boundsMin.x, w.x), std::min(inst.boundsMin.y, w.y), std::min(inst.boundsMin.z, w.z)};
+            inst.boundsMax = {std::max(inst.boundsMax.x, w.x), std::max(inst.boundsMax.y, w.y), std::max(inst.boundsMax.z, w.z)};
+        }
 
-    // 初始化索引数组
-    m_objectIndices.resize(m_objects.size());
-    for (size_t i = 0; i < m_objects.size(); i++) {
-        m_objectIndices[i] = (int)i;
+        m_instances.push_back(inst);
     }
-
-    m_bvhNodes.clear();
-    m_bvhNodes.reserve(m_objects.size() * 2);  // 预估节点数量
-
-    // 递归构建
-    m_rootNode = buildBVHRecursive(0, (int)m_objects.size(), 0);
 }
 
-int CRayTracer::buildBVHRecursive(int start, int end, int depth)
+void CRayTracer::buildTLAS()
 {
-    int count = end - start;
-
-    // 创建节点
-    SBVHNode node;
-    computeBounds(start, end, node.boundsMin, node.boundsMax);
-
-    // 叶子节点条件：物体太少或深度太深
-    if (count <= MIN_OBJECTS_PER_LEAF || depth >= MAX_BVH_DEPTH) {
-        node.objectStart = start;
-        node.objectCount = count;
-        node.leftChild = -1;
-        node.rightChild = -1;
-
-        int nodeIndex = (int)m_bvhNodes.size();
-        m_bvhNodes.push_back(node);
-        return nodeIndex;
+    std::vector<SBVHBuildPrimitive> prims(m_instances.size());
+    for (size_t i = 0; i < m_instances.size(); i++) {
+        const auto& inst = m_instances[i];
+        prims[i].boundsMin = inst.boundsMin;
+        prims[i].boundsMax = inst.boundsMax;
+        prims[i].centroid = {
+            (inst.boundsMin.x + inst.boundsMax.x) * 0.5f,
+            (inst.boundsMin.y + inst.boundsMax.y) * 0.5f,
+            (inst.boundsMin.z + inst.boundsMax.z) * 0.5f
+        };
     }
 
-    // 选择分割轴（最长轴）
-    float extentX = node.boundsMax.x - node.boundsMin.x;
-    float extentY = node.boundsMax.y - node.boundsMin.y;
-    float extentZ = node.boundsMax.z - node.boundsMin.z;
-
-    int axis = 0;
-    if (extentY > extentX && extentY > extentZ) axis = 1;
-    else if (extentZ > extentX && extentZ > extentY) axis = 2;
-
-    // 按中心点排序
-    std::sort(m_objectIndices.begin() + start, m_objectIndices.begin() + end,
-        [this, axis](int a, int b) {
-            XMFLOAT3 centerA = getObjectCenter(a);
-            XMFLOAT3 centerB = getObjectCenter(b);
-            float va = (axis == 0) ? centerA.x : (axis == 1) ? centerA.y : centerA.z;
-            float vb = (axis == 0) ? centerB.x : (axis == 1) ? centerB.y : centerB.z;
-            return va < vb;
-        });
-
-    // 中点分割
-    int mid = start + count / 2;
-
-    // 递归构建子节点
-    int nodeIndex = (int)m_bvhNodes.size();
-    m_bvhNodes.push_back(node);  // 先占位
-
-    int leftChild = buildBVHRecursive(start, mid, depth + 1);
-    int rightChild = buildBVHRecursive(mid, end, depth + 1);
-
-    // 更新节点
-    m_bvhNodes[nodeIndex].leftChild = leftChild;
-    m_bvhNodes[nodeIndex].rightChild = rightChild;
-    m_bvhNodes[nodeIndex].objectStart = 0;
-    m_bvhNodes[nodeIndex].objectCount = 0;
-
-    return nodeIndex;
-}
+    std::vector<SBVHNode> binaryNodes;
+    std::vector<uint32_t> order;
+    CBVHBuilder::Build(prims, MAX_INSTANCES_PER_LEAF, binaryNodes, order);
+    m_tlas.BuildFromBinary(binaryNodes);
 
-void CRayTracer::computeBounds(int start, int end,
-                               XMFLOAT3& outMin, XMFLOAT3& outMax) const
-{
-    outMin = {FLT_MAX, FLT_MAX, FLT_MAX};
-    outMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
-
-    for (int i = start; i < end; i++) {
-        int objIdx = m_objectIndices[i];
-        const auto& obj = m_objects[objIdx];
-
-        outMin.x = std::min(outMin.x, obj.boundsMin.x);
-        outMin.y = std::min(outMin.y, obj.boundsMin.y);
-        outMin.z = std::min(outMin.z, obj.boundsMin.z);
-        outMax.x = std::max(outMax.x, obj.boundsMax.x);
-        outMax.y = std::max(outMax.y, obj.boundsMax.y);
-        outMax.z = std::max(outMax.z, obj.boundsMax.z);
+    // 按叶子顺序重排 instance
+    std::vector<SRayTracerInstance> sorted;
+    sorted.reserve(m_instances.size());
+    for (uint32_t idx : order) {
+        sorted.push_back(m_instances[idx]);
     }
-}
-
-XMFLOAT3 CRayTracer::getObjectCenter(int index) const
-{
-    const auto& obj = m_objects[index];
-    return {
-        (obj.boundsMin.x + obj.boundsMax.x) * 0.5f,
-        (obj.boundsMin.y + obj.boundsMax.y) * 0.5f,
-        (obj.boundsMin.z + obj.boundsMax.z) * 0.5f
-    };
+    m_instances = std::move(sorted);
 }
 
 // ============================================
-// 射线相交测试
+// 遍历
 // ============================================
 
-bool CRayTracer::rayAABBIntersect(const SRay& ray,
-                                  const XMFLOAT3& boundsMin,
-                                  const XMFLOAT3& boundsMax,
-                                  float& tNear, float& tFar) const
+SBVHRay CRayTracer::toObjectSpace(const SBVHRay& worldRay, const SRayTracerInstance& inst)
 {
-    // Slab method
-    float tmin = ray.tMin;
-    float tmax = ray.tMax;
-
-    // X slab
-    float invDirX = (ray.direction.x != 0.0f) ? 1.0f / ray.direction.x : FLT_MAX;
-    float t1 = (boundsMin.x - ray.origin.x) * invDirX;
-    float t2 = (boundsMax.x - ray.origin.x) * invDirX;
-    if (t1 > t2) std::swap(t1, t2);
-    tmin = std::max(tmin, t1);
-    tmax = std::min(tmax, t2);
-    if (tmin > tmax) return false;
-
-    // Y slab
-    float invDirY = (ray.direction.y != 0.0f) ? 1.0f / ray.direction.y : FLT_MAX;
-    t1 = (boundsMin.y - ray.origin.y) * invDirY;
-    t2 = (boundsMax.y - ray.origin.y) * invDirY;
-    if (t1 > t2) std::swap(t1, t2);
-    tmin = std::max(tmin, t1);
-    tmax = std::min(tmax, t2);
-    if (tmin > tmax) return false;
-
-    // Z slab
-    float invDirZ = (ray.direction.z != 0.0f) ? 1.0f / ray.direction.z : FLT_MAX;
-    t1 = (boundsMin.z - ray.origin.z) * invDirZ;
-    t2 = (boundsMax.z - ray.origin.z) * invDirZ;
-    if (t1 > t2) std::swap(t1, t2);
-    tmin = std::max(tmin, t1);
-    tmax = std::min(tmax, t2);
-    if (tmin > tmax) return false;
-
-    tNear = tmin;
-    tFar = tmax;
-    return true;
+    // 方向不归一化：物体空间的 t 与世界空间一致
+    SBVHRay r;
+    r.origin = transformPoint(inst.worldToObject, worldRay.origin);
+    r.direction = transformVector(inst.worldToObject, worldRay.direction);
+    r.tMin = worldRay.tMin;
+    r.tMax = worldRay.tMax;
+    r.UpdateInvDirection();
+    return r;
 }
 
-bool CRayTracer::rayAABBIntersectWithNormal(const SRay& ray,
-                                            const XMFLOAT3& boundsMin,
-                                            const XMFLOAT3& boundsMax,
-                                            float& tHit,
-                                            XMFLOAT3& outNormal) const
+template<EBVHKernel Kernel>
+void CRayTracer::traverseTLAS(const SBVHRay& worldRay, SRayHit& closestHit) const
 {
-    float tNear, tFar;
-    if (!rayAABBIntersect(ray, boundsMin, boundsMax, tNear, tFar)) {
-        return false;
-    }
-
-    tHit = tNear;
-
-    // 计算命中点
-    XMFLOAT3 hitPos = {
-        ray.origin.x + ray.direction.x * tHit,
-        ray.origin.y + ray.direction.y * tHit,
-        ray.origin.z + ray.direction.z * tHit
-    };
+    SBVHTriangleHit bestHit;
+    bestHit.t = worldRay.tMax;
+    int bestInstance = -1;
+
+    float tMax = worldRay.tMax;
+    m_tlas.Traverse<Kernel, false>(worldRay, tMax, [&](uint32_t first, uint32_t count, float& leafTMax) {
+        bool found = false;
+        for (uint32_t i = first; i < first + count; i++) {
+            const SRayTracerInstance& inst = m_instances[i];
+            if (m_meshBVHs[inst.meshIndex].Intersect(toObjectSpace(worldRay, inst), bestHit, Kernel)) {
+                bestInstance = (int)i;
+                leafTMax = bestHit.t;
+                found = true;
+            }
+        }
+        return found;
+    });
 
-    // 确定命中的是哪个面（找最近的面）
-    float epsilon = 0.001f;
-    outNormal = {0, 0, 0};
-
-    if (std::abs(hitPos.x - boundsMin.x) < epsilon) outNormal = {-1, 0, 0};
-    else if (std::abs(hitPos.x - boundsMax.x) < epsilon) outNormal = {1, 0, 0};
-    else if (std::abs(hitPos.y - boundsMin.y) < epsilon) outNormal = {0, -1, 0};
-    else if (std::abs(hitPos.y - boundsMax.y) < epsilon) outNormal = {0, 1, 0};
-    else if (std::abs(hitPos.z - boundsMin.z) < epsilon) outNormal = {0, 0, -1};
-    else if (std::abs(hitPos.z - boundsMax.z) < epsilon) outNormal = {0, 0, 1};
-    else {
-        // 备用：使用射线方向的反向
-        outNormal = {-ray.direction.x, -ray.direction.y, -ray.direction.z};
-        // 归一化
-        XMVECTOR n = XMLoadFloat3(&outNormal);
-        n = XMVector3Normalize(n);
-        XMStoreFloat3(&outNormal, n);
+    if (bestInstance >= 0) {
+        finalizeHit(worldRay, bestInstance, bestHit, closestHit);
     }
-
-    return true;
 }
 
-// ============================================
-// BVH 遍历
-// ============================================
-
-void CRayTracer::traverseBVH(const SRay& ray, SRayHit& closestHit) const
+template<EBVHKernel Kernel>
+bool CRayTracer::traverseTLASOccluded(const SBVHRay& worldRay) const
 {
-    if (m_rootNode < 0 || m_bvhNodes.empty()) {
-        return;
-    }
-
-    traverseBVHRecursive(m_rootNode, ray, closestHit);
+    float tMax = worldRay.tMax;
+    return m_tlas.Traverse<Kernel, true>(worldRay, tMax, [&](uint32_t first, uint32_t count, float&) {
+        for (uint32_t i = first; i < first + count; i++) {
+            const SRayTracerInstance& inst = m_instances[i];
+            if (m_meshBVHs[inst.meshIndex].Occluded(toObjectSpace(worldRay, inst), Kernel)) {
+                return true;
+            }
+        }
+        return false;
+    });
 }
 
-void CRayTracer::traverseBVHRecursive(int nodeIndex, const SRay& ray, SRayHit& closestHit) const
+void CRayTracer::traceRayPacket(const SRay* rays, SRayHit* outHits, int laneCount) const
 {
-    if (nodeIndex < 0 || nodeIndex >= (int)m_bvhNodes.size()) {
-        return;
+    SBVHRayPacket4 packet{};
+    SBVHRay worldRays[4];
+    for (int lane = 0; lane < laneCount; lane++) {
+        worldRays[lane] = makeRay(rays[lane]);
+        packet.SetRay(lane, worldRays[lane]);
     }
 
-    const SBVHNode& node = m_bvhNodes[nodeIndex];
+    SBVHTriangleHit bestHits[4];
+    int bestInstance[4] = {-1, -1, -1, -1};
 
-    // 先测试节点的 AABB
-    float tNear, tFar;
-    if (!rayAABBIntersect(ray, node.boundsMin, node.boundsMax, tNear, tFar)) {
-        return;  // 不相交，跳过整个子树
-    }
+    m_tlas.TraversePacket(packet, [&](uint32_t first, uint32_t count, uint32_t laneMask) {
+        for (uint32_t i = first; i < first + count; i++) {
+            const SRayTracerInstance& inst = m_instances[i];
 
-    // 如果节点 AABB 的最近点已经比当前命中更远，跳过
-    if (tNear > closestHit.distance) {
-        return;
-    }
+            // 同一个 instance 变换整个 packet，t 在两个空间中一致
+            SBVHRayPacket4 local{};
+            for (int lane = 0; lane < 4; lane++) {
+                if (!(laneMask & (1u << lane))) continue;
+                SBVHRay objectRay = toObjectSpace(worldRays[lane], inst);
+                objectRay.tMax = packet.tMax[lane];
+                local.SetRay(lane, objectRay);
+            }
 
-    if (node.IsLeaf()) {
-        // 叶子节点：测试所有物体
-        for (int i = node.objectStart; i < node.objectStart + node.objectCount; i++) {
-            int objIdx = m_objectIndices[i];
-            const auto& obj = m_objects[objIdx];
-
-            float tHit;
-            XMFLOAT3 hitNormal;
-            if (rayAABBIntersectWithNormal(ray, obj.boundsMin, obj.boundsMax, tHit, hitNormal)) {
-                if (tHit < closestHit.distance && tHit >= ray.tMin) {
-                    closestHit.valid = true;
-                    closestHit.distance = tHit;
-                    closestHit.position = {
-                        ray.origin.x + ray.direction.x * tHit,
-                        ray.origin.y + ray.direction.y * tHit,
-                        ray.origin.z + ray.direction.z * tHit
-                    };
-                    closestHit.normal = hitNormal;
-                    closestHit.albedo = obj.albedo;
-                    closestHit.objectIndex = objIdx;
+            uint32_t hitMask = m_meshBVHs[inst.meshIndex].IntersectPacket(local, laneMask, bestHits);
+            for (int lane = 0; lane < 4; lane++) {
+                if (hitMask & (1u << lane)) {
+                    packet.tMax[lane] = local.tMax[lane];
+                    bestInstance[lane] = (int)i;
                 }
             }
         }
-    } else {
-        // 内部节点：递归遍历子节点
-        // 优化：先遍历更近的子节点
-        traverseBVHRecursive(node.leftChild, ray, closestHit);
-        traverseBVHRecursive(node.rightChild, ray, closestHit);
+    });
+
+    for (int lane = 0; lane < laneCount; lane++) {
+        SRayHit& hit = outHits[lane];
+        hit = SRayHit();
+        if (bestInstance[lane] >= 0) {
+            finalizeHit(worldRays[lane], bestInstance[lane], bestHits[lane], hit);
+        }
     }
 }
 
+void CRayTracer::finalizeHit(const SBVHRay& worldRay, int instanceIndex,
+                             const SBVHTriangleHit& triHit, SRayHit& outHit) const
+{
+    const SRayTracerInstance& inst = m_instances[instanceIndex];
+    const CMeshBVH& mesh = m_meshBVHs[inst.meshIndex];
+
+    XMFLOAT3 n = normalize3(transformNormal(inst.worldToObject, mesh.GetTriangleNormal(triHit.primIndex)));
+    const XMFLOAT3& d = worldRay.direction;
+    float dDotN = d.x * n.x + d.y * n.y + d.z * n.z;
+
+    outHit.valid = true;
+    outHit.distance = triHit.t;
+    outHit.position = {
+        worldRay.origin.x + d.x * triHit.t,
+        worldRay.origin.y + d.y * triHit.t,
+        worldRay.origin.z + d.z * triHit.t
+    };
+    // 双面：法线翻转到射线来源一侧，便于 bounce/偏移
+    outHit.frontFace = dDotN < 0.0f;
+    outHit.normal = outHit.frontFace ? n : XMFLOAT3(-n.x, -n.y, -n.z);
+    outHit.albedo = inst.albedo;
+    outHit.objectIndex = inst.instanceIndex;
+    outHit.primitiveIndex = (int)triHit.primIndex;
+    outHit.barycentricU = triHit.u;
+    outHit.barycentricV = triHit.v;
+}
+
 // ============================================
 // 公共查询接口
 // ============================================
@@ -404,11 +409,15 @@ SRayHit CRayTracer::TraceRay(const SRay& ray) const
     hit.valid = false;
     hit.distance = FLT_MAX;
 
-    if (!m_initialized || m_objects.empty()) {
+    if (!m_initialized || m_instances.empty()) {
         return hit;
     }
 
-    traverseBVH(ray, hit);
+    if (m_kernel == EBVHKernel::SIMD) {
+        traverseTLAS<EBVHKernel::SIMD>(makeRay(ray), hit);
+    } else {
+        traverseTLAS<EBVHKernel::Scalar>(makeRay(ray), hit);
+    }
     return hit;
 }
 
@@ -422,6 +431,39 @@ SRayHit CRayTracer::TraceRay(const XMFLOAT3& origin, const XMFLOAT3& direction)
     return TraceRay(ray);
 }
 
+bool CRayTracer::Occluded(const SRay& ray) const
+{
+    if (!m_initialized || m_instances.empty()) {
+        return false;
+    }
+    if (m_kernel == EBVHKernel::SIMD) {
+        return traverseTLASOccluded<EBVHKernel::SIMD>(makeRay(ray));
+    }
+    return traverseTLASOccluded<EBVHKernel::Scalar>(makeRay(ray));
+}
+
+void CRayTracer::TraceRays(const SRay* rays, SRayHit* outHits, uint32_t count) const
+{
+    if (!m_initialized || m_instances.empty()) {
+        for (uint32_t i = 0; i < count; i++) {
+            outHits[i] = SRayHit();
+        }
+        return;
+    }
+
+    // Scalar 内核逐条追踪（参考路径）
+    if (m_kernel == EBVHKernel::Scalar) {
+        for (uint32_t i = 0; i < count; i++) {
+            outHits[i] = TraceRay(rays[i]);
+        }
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i += 4) {
+        traceRayPacket(rays + i, outHits + i, (int)std::min(4u, count - i));
+    }
+}
+
 bool CRayTracer::TraceVisibility(const XMFLOAT3& from, const XMFLOAT3& to) const
 {
     XMFLOAT3 dir = {
@@ -431,25 +473,20 @@ bool CRayTracer::TraceVisibility(const XMFLOAT3& from, const XMFLOAT3& to) const
     };
 
     // 计算距离
-    XMVECTOR dirVec = XMLoadFloat3(&dir);
-    float dist = XMVectorGetX(XMVector3Length(dirVec));
+    float dist = std::sqrt(dir.x * dir.x + dir.y * dir.y + dir.z * dir.z);
 
     if (dist < 0.001f) {
         return true;  // 同一点，认为可见
     }
 
     // 归一化
-    dirVec = XMVector3Normalize(dirVec);
-    XMStoreFloat3(&dir, dirVec);
-
     SRay ray;
     ray.origin = from;
-    ray.direction = dir;
+    ray.direction = {dir.x / dist, dir.y / dist, dir.z / dist};
     ray.tMin = 0.001f;
     ray.tMax = dist - 0.001f;  // 不包括终点
 
-    SRayHit hit = TraceRay(ray);
-    return !hit.valid;  // 没有命中 = 可见
+    return !Occluded(ray);  // 没有遮挡 = 可见
 }
 
 bool CRayTracer::TraceShadowRay(const XMFLOAT3& origin,
@@ -462,6 +499,5 @@ bool CRayTracer::TraceShadowRay(const XMFLOAT3& origin,
     ray.tMin = 0.001f;
     ray.tMax = maxDistance;
 
-    SRayHit hit = TraceRay(ray);
-    return hit.valid;  // 命中 = 在阴影中
+    return Occluded(ray);  // 命中 = 在阴影中
 }
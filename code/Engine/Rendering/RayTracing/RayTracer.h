@@ -1,9 +1,11 @@
 #pragma once
+#include "MeshBVH.h"
 #include <DirectXMath.h>
 #include <vector>
 #include <string>
 
 class CScene;
+struct SRayTracingSceneData;
 
 // ============================================
 // Ray Tracing 数据结构
@@ -22,45 +24,43 @@ struct SRayHit
     bool valid = false;
     float distance = FLT_MAX;
     DirectX::XMFLOAT3 position = {0, 0, 0};
-    DirectX::XMFLOAT3 normal = {0, 1, 0};    // AABB 面法线
-    DirectX::XMFLOAT3 albedo = {0.5f, 0.5f, 0.5f};  // 物体 albedo（简化版从材质获取）
-    int objectIndex = -1;
+    DirectX::XMFLOAT3 normal = {0, 1, 0};    // 世界空间几何法线（朝向射线来源一侧）
+    DirectX::XMFLOAT3 albedo = {0.5f, 0.5f, 0.5f};  // 物体 albedo（从材质获取）
+    int objectIndex = -1;                    // 命中的 instance 索引
+    int primitiveIndex = -1;                 // 命中的三角形索引（mesh 内）
+    float barycentricU = 0.0f;               // 重心坐标（顶点 1 权重）
+    float barycentricV = 0.0f;               // 重心坐标（顶点 2 权重）
+    bool frontFace = true;                   // false = 命中三角形背面
 };
 
 // ============================================
-// AABB 物体（简化版几何体）
+// Instance（TLAS 叶子）
 // ============================================
-struct SAABBObject
+// 3x4 仿射矩阵，列向量约定：p' = M * [p, 1]
+struct SAffine3x4
 {
-    DirectX::XMFLOAT3 boundsMin;
-    DirectX::XMFLOAT3 boundsMax;
-    DirectX::XMFLOAT3 albedo = {0.5f, 0.5f, 0.5f};  // 漫反射颜色
-    int sceneObjectIndex = -1;  // 对应场景中的 GameObject 索引
+    float m[3][4];
 };
 
-// ============================================
-// BVH 节点
-// ============================================
-struct SBVHNode
+struct SRayTracerInstance
 {
-    DirectX::XMFLOAT3 boundsMin;
+    SAffine3x4 objectToWorld;
+    SAffine3x4 worldToObject;
+    DirectX::XMFLOAT3 boundsMin;   // 世界空间 AABB
     DirectX::XMFLOAT3 boundsMax;
-
-    int leftChild = -1;     // 左子节点索引（-1 = 叶子）
-    int rightChild = -1;    // 右子节点索引
-
-    // 叶子节点数据
-    int objectStart = 0;    // 物体起始索引
-    int objectCount = 0;    // 物体数量
-
-    bool IsLeaf() const { return leftChild < 0; }
+    DirectX::XMFLOAT3 albedo = {0.5f, 0.5f, 0.5f};
+    uint32_t meshIndex = 0;         // -> m_meshBVHs
+    int instanceIndex = -1;         // 原始 SRayTracingInstance 索引（SRayHit::objectIndex）
 };
 
 // ============================================
 // CRayTracer - CPU 射线追踪器
 // ============================================
-// 使用 AABB 简化版几何体进行射线追踪
-// 后续可升级为三角形精度
+// 两级 BVH，基于三角形精度：
+// - BLAS: 每个 mesh 一棵 binned-SAH 三角形 BVH（物体空间，CMeshBVH）
+// - TLAS: 所有 SRayTracingInstance 世界 AABB 上的 SAH BVH
+// 两级都折叠为 BVH4，SSE 一次测试 4 个子节点 / 4 个三角形
+// 几何数据来自 CRayTracingMeshCache（经 CSceneGeometryExporter 导出）
 // ============================================
 class CRayTracer
 {
@@ -72,9 +72,12 @@ public:
     // 初始化
     // ============================================
 
-    // 从场景构建 BVH
-    // 提取所有 MeshRenderer 的世界空间 AABB
+    // 从场景构建 BVH（导出 CRayTracingMeshCache 中的三角形数据）
     bool Initialize(CScene& scene);
+
+    // 从已导出的几何数据构建 BVH（无需场景，可用于离线/benchmark）
+    bool Initialize(const SRayTracingSceneData& sceneData);
+
     void Shutdown();
 
     // 重建 BVH（场景变化后调用）
@@ -100,62 +103,63 @@ public:
                         const DirectX::XMFLOAT3& lightDir,
                         float maxDistance) const;
 
+    // 遮挡查询（任意命中即返回，不计算最近交点）
+    bool Occluded(const SRay& ray) const;
+
+    // 批量追踪相干射线（如 primary rays），每 4 条组成一个 packet 共享遍历
+    // 结果与逐条 TraceRay 相同
+    void TraceRays(const SRay* rays, SRayHit* outHits, uint32_t count) const;
+
+    // ============================================
+    // 内核选择
+    // ============================================
+    // Scalar 与 SIMD 选择相同的最近命中（Scalar 作为参考 / 无 SSE 平台）
+    void SetKernel(EBVHKernel kernel) { m_kernel = kernel; }
+    EBVHKernel GetKernel() const { return m_kernel; }
+
     // ============================================
     // 状态查询
     // ============================================
     bool IsInitialized() const { return m_initialized; }
-    int GetObjectCount() const { return (int)m_objects.size(); }
-    int GetBVHNodeCount() const { return (int)m_bvhNodes.size(); }
+    int GetObjectCount() const { return (int)m_instances.size(); }
+    int GetMeshCount() const { return (int)m_meshBVHs.size(); }
+    int GetTriangleCount() const;
+    int GetBVHNodeCount() const;
 
 private:
     // ============================================
     // BVH 构建
     // ============================================
-    void extractObjectsFromScene(CScene& scene);
-    void buildBVH();
-    int buildBVHRecursive(int start, int end, int depth);
-
-    // 计算 AABB 并集
-    void computeBounds(int start, int end,
-                       DirectX::XMFLOAT3& outMin,
-                       DirectX::XMFLOAT3& outMax) const;
-
-    // 计算 AABB 中心
-    DirectX::XMFLOAT3 getObjectCenter(int index) const;
+    void buildMeshBVHs(const SRayTracingSceneData& sceneData);
+    void buildInstances(const SRayTracingSceneData& sceneData);
+    void buildTLAS();
 
     // ============================================
-    // 射线相交测试
+    // 遍历
     // ============================================
+    static SBVHRay toObjectSpace(const SBVHRay& worldRay, const SRayTracerInstance& inst);
+    template<EBVHKernel Kernel>
+    void traverseTLAS(const SBVHRay& worldRay, SRayHit& closestHit) const;
+    template<EBVHKernel Kernel>
+    bool traverseTLASOccluded(const SBVHRay& worldRay) const;
+    void traceRayPacket(const SRay* rays, SRayHit* outHits, int laneCount) const;
 
-    // Ray-AABB 相交（slab method）
-    bool rayAABBIntersect(const SRay& ray,
-                          const DirectX::XMFLOAT3& boundsMin,
-                          const DirectX::XMFLOAT3& boundsMax,
-                          float& tNear, float& tFar) const;
-
-    // Ray-AABB 相交并计算命中法线
-    bool rayAABBIntersectWithNormal(const SRay& ray,
-                                    const DirectX::XMFLOAT3& boundsMin,
-                                    const DirectX::XMFLOAT3& boundsMax,
-                                    float& tHit,
-                                    DirectX::XMFLOAT3& outNormal) const;
-
-    // BVH 遍历
-    void traverseBVH(const SRay& ray, SRayHit& closestHit) const;
-    void traverseBVHRecursive(int nodeIndex, const SRay& ray, SRayHit& closestHit) const;
+    // 命中后计算位置/法线/材质
+    void finalizeHit(const SBVHRay& worldRay, int instanceIndex,
+                     const SBVHTriangleHit& triHit, SRayHit& outHit) const;
 
 private:
     bool m_initialized = false;
 
-    // 场景物体（AABB）
-    std::vector<SAABBObject> m_objects;
-    std::vector<int> m_objectIndices;  // 用于 BVH 构建时重排序
+    // BLAS（每个 mesh 一棵）
+    std::vector<CMeshBVH> m_meshBVHs;
+
+    // TLAS
+    std::vector<SRayTracerInstance> m_instances;  // TLAS 叶子顺序
+    CBVH4 m_tlas;
 
-    // BVH
-    std::vector<SBVHNode> m_bvhNodes;
-    int m_rootNode = -1;
+    EBVHKernel m_kernel = BVH_DEFAULT_KERNEL;
 
     // 配置
-    static const int MAX_BVH_DEPTH = 20;
-    static const int MIN_OBJECTS_PER_LEAF = 2;
+    static const int MAX_INSTANCES_PER_LEAF = 1;
 };
@@ -121,9 +121,9 @@ std::unique_ptr<SRayTracingSceneData> CSceneGeometryExporter::ExportScene(CScene
             meshRenderer->EnsureUploaded();
 
             // Process each sub-mesh
-            for (uint32_t subMeshIdx = 0; subMeshIdx < meshRenderer->meshes.size(); ++subMeshIdx) {
-                auto& gpuMesh = meshRenderer->meshes[subMeshIdx];
+            for (const auto& gpuMesh : meshRenderer->meshes) {
                 if (!gpuMesh) continue;
+                uint32_t subMeshIdx = gpuMesh->subMeshIndex;   // Renderers may draw a sub-range
 
                 std::string meshKey = meshRenderer->path + ":" + std::to_string(subMeshIdx);
 
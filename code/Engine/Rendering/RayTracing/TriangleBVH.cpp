@@ -0,0 +1,201 @@
+#include "TriangleBVH.h"
+#include <cmath>
+
+using namespace DirectX;
+
+// ============================================
+// SBVHRay
+// ============================================
+
+void SBVHRay::UpdateInvDirection()
+{
+    // Avoid inf * 0 = NaN in the slab test when a component is exactly zero
+    auto safeInv = [](float d) {
+        const float eps = 1e-20f;
+        if (std::abs(d) < eps) d = (d < 0.0f) ? -eps : eps;
+        return 1.0f / d;
+    };
+    invDirection = {safeInv(direction.x), safeInv(direction.y), safeInv(direction.z)};
+}
+
+// ============================================
+// CBVHBuilder - Binned SAH
+// ============================================
+
+namespace
+{
+    struct SBounds
+    {
+        XMFLOAT3 bmin = {FLT_MAX, FLT_MAX, FLT_MAX};
+        XMFLOAT3 bmax = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+        void Grow(const XMFLOAT3& p)
+        {
+            bmin = {std::min(bmin.x, p.x), std::min(bmin.y, p.y), std::min(bmin.z, p.z)};
+            bmax = {std::max(bmax.x, p.x), std::max(bmax.y, p.y), std::max(bmax.z, p.z)};
+        }
+        void Grow(const SBounds& b)
+        {
+            Grow(b.bmin);
+            Grow(b.bmax);
+        }
+        float Area() const { return BVHMath::SurfaceArea(bmin, bmax); }
+    };
+
+    inline float axisOf(const XMFLOAT3& v, int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    struct SBin
+    {
+        SBounds bounds;
+        int count = 0;
+    };
+
+    struct SBuildTask
+    {
+        uint32_t nodeIndex;
+        uint32_t start;
+        uint32_t count;
+        int depth;
+    };
+}
+
+void CBVHBuilder::Build(const std::vector<SBVHBuildPrimitive>& prims,
+                        int maxLeafSize,
+                        std::vector<SBVHNode>& outNodes,
+                        std::vector<uint32_t>& outPrimIndices)
+{
+    outNodes.clear();
+    outPrimIndices.clear();
+
+    const uint32_t primCount = (uint32_t)prims.size();
+    if (primCount == 0) {
+        return;
+    }
+
+    outPrimIndices.resize(primCount);
+    for (uint32_t i = 0; i < primCount; i++) {
+        outPrimIndices[i] = i;
+    }
+
+    outNodes.reserve(primCount * 2);
+    outNodes.emplace_back();
+
+    std::vector<SBuildTask> stack;
+    stack.push_back({0, 0, primCount, 0});
+
+    while (!stack.empty()) {
+        SBuildTask task = stack.back();
+        stack.pop_back();
+
+        // Node bounds + centroid bounds
+        SBounds nodeBounds, centroidBounds;
+        for (uint32_t i = task.start; i < task.start + task.count; i++) {
+            const auto& p = prims[outPrimIndices[i]];
+            nodeBounds.Grow(p.boundsMin);
+            nodeBounds.Grow(p.boundsMax);
+            centroidBounds.Grow(p.centroid);
+        }
+
+        SBVHNode& node = outNodes[task.nodeIndex];
+        node.boundsMin = nodeBounds.bmin;
+        node.boundsMax = nodeBounds.bmax;
+
+        auto makeLeaf = [&]() {
+            SBVHNode& leaf = outNodes[task.nodeIndex];
+            leaf.leftOrFirst = task.start;
+            leaf.primCount = task.count;
+        };
+
+        if ((int)task.count <= 1 || task.depth >= MAX_BUILD_DEPTH) {
+            makeLeaf();
+            continue;
+        }
+
+        // Evaluate binned SAH on all three axes
+        float bestCost = FLT_MAX;
+        int bestAxis = -1;
+        int bestSplit = -1;
+
+        for (int axis = 0; axis < 3; axis++) {
+            float cmin = axisOf(centroidBounds.bmin, axis);
+            float cmax = axisOf(centroidBounds.bmax, axis);
+            if (cmax - cmin <= 1e-12f) continue;
+
+            SBin bins[SAH_BIN_COUNT];
+            float scale = SAH_BIN_COUNT / (cmax - cmin);
+            for (uint32_t i = task.start; i < task.start + task.count; i++) {
+                const auto& p = prims[outPrimIndices[i]];
+                int b = std::min(SAH_BIN_COUNT - 1, (int)((axisOf(p.centroid, axis) - cmin) * scale));
+                bins[b].count++;
+                bins[b].bounds.Grow(p.boundsMin);
+                bins[b].bounds.Grow(p.boundsMax);
+            }
+
+            // Sweep: left areas/counts, then right
+            float leftArea[SAH_BIN_COUNT - 1], rightArea[SAH_BIN_COUNT - 1];
+            int leftCount[SAH_BIN_COUNT - 1], rightCount[SAH_BIN_COUNT - 1];
+            SBounds leftBox, rightBox;
+            int leftSum = 0, rightSum = 0;
+            for (int i = 0; i < SAH_BIN_COUNT - 1; i++) {
+                leftSum += bins[i].count;
+                leftCount[i] = leftSum;
+                if (bins[i].count > 0) leftBox.Grow(bins[i].bounds);
+                leftArea[i] = leftBox.Area();
+
+                int r = SAH_BIN_COUNT - 1 - i;
+                rightSum += bins[r].count;
+                rightCount[r - 1] = rightSum;
+                if (bins[r].count > 0) rightBox.Grow(bins[r].bounds);
+                rightArea[r - 1] = rightBox.Area();
+            }
+
+            for (int i = 0; i < SAH_BIN_COUNT - 1; i++) {
+                if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+                float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i;
+                }
+            }
+        }
+
+        // Leaf if splitting does not pay off (traversal cost ~ 1 triangle test)
+        float leafCost = task.count * nodeBounds.Area();
+        uint32_t mid = 0;
+        if (bestAxis >= 0 && (bestCost + nodeBounds.Area() < leafCost || (int)task.count > maxLeafSize)) {
+            float cmin = axisOf(centroidBounds.bmin, bestAxis);
+            float scale = SAH_BIN_COUNT / (axisOf(centroidBounds.bmax, bestAxis) - cmin);
+            auto first = outPrimIndices.begin() + task.start;
+            auto last = first + task.count;
+            auto it = std::partition(first, last, [&](uint32_t idx) {
+                int b = std::min(SAH_BIN_COUNT - 1, (int)((axisOf(prims[idx].centroid, bestAxis) - cmin) * scale));
+                return b <= bestSplit;
+            });
+            mid = (uint32_t)(it - first);
+        } else if ((int)task.count > maxLeafSize) {
+            // All centroids coincide: split in half so leaves stay small
+            mid = task.count / 2;
+        } else {
+            makeLeaf();
+            continue;
+        }
+
+        if (mid == 0 || mid == task.count) {
+            mid = task.count / 2;
+        }
+
+        // Children are allocated as an adjacent pair
+        uint32_t leftIndex = (uint32_t)outNodes.size();
+        outNodes.emplace_back();
+        outNodes.emplace_back();
+        outNodes[task.nodeIndex].leftOrFirst = leftIndex;
+        outNodes[task.nodeIndex].primCount = 0;
+
+        stack.push_back({leftIndex + 1, task.start + mid, task.count - mid, task.depth + 1});
+        stack.push_back({leftIndex, task.start, mid, task.depth + 1});
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+
+// ============================================
+// BVH 公共数据结构
+// ============================================
+// Shared by the per-mesh BLAS (triangles) and the scene TLAS (instances).
+// No scene / RHI dependencies: only positions + indices go in.
+
+// Flattened BVH node (32 bytes, two nodes per cache line)
+// Interior: children are adjacent, left = leftOrFirst, right = leftOrFirst + 1
+// Leaf:     primitives [leftOrFirst, leftOrFirst + primCount)
+struct SBVHNode
+{
+    DirectX::XMFLOAT3 boundsMin;
+    uint32_t leftOrFirst = 0;
+    DirectX::XMFLOAT3 boundsMax;
+    uint32_t primCount = 0;     // 0 = interior node
+
+    bool IsLeaf() const { return primCount > 0; }
+};
+static_assert(sizeof(SBVHNode) == 32, "SBVHNode must stay 32 bytes");
+
+// Build input: one AABB per primitive
+struct SBVHBuildPrimitive
+{
+    DirectX::XMFLOAT3 boundsMin;
+    DirectX::XMFLOAT3 boundsMax;
+    DirectX::XMFLOAT3 centroid;
+};
+
+// Ray with precomputed reciprocal direction (used by traversal)
+struct SBVHRay
+{
+    DirectX::XMFLOAT3 origin;
+    DirectX::XMFLOAT3 direction;
+    DirectX::XMFLOAT3 invDirection;
+    float tMin = 0.0f;
+    float tMax = FLT_MAX;
+
+    void UpdateInvDirection();
+};
+
+// ============================================
+// CBVHBuilder - Binned SAH builder
+// ============================================
+class CBVHBuilder
+{
+public:
+    static const int SAH_BIN_COUNT = 16;
+    static const int MAX_BUILD_DEPTH = 60;   // Traversal stack is 64 entries
+
+    // Build a flattened BVH over prims
+    // outPrimIndices: leaf order -> original primitive index
+    static void Build(const std::vector<SBVHBuildPrimitive>& prims,
+                      int maxLeafSize,
+                      std::vector<SBVHNode>& outNodes,
+                      std::vector<uint32_t>& outPrimIndices);
+};
+
+// ============================================
+// Triangles
+// ============================================
+
+// Triangle stored in leaf order: vertex 0 + two edges (Möller–Trumbore)
+struct SBVHTriangle
+{
+    DirectX::XMFLOAT3 v0;
+    DirectX::XMFLOAT3 e1;
+    DirectX::XMFLOAT3 e2;
+};
+
+struct SBVHTriangleHit
+{
+    float t = FLT_MAX;
+    float u = 0.0f;              // Barycentric weight of vertex 1
+    float v = 0.0f;              // Barycentric weight of vertex 2
+    uint32_t primIndex = UINT32_MAX;  // Original triangle index in the mesh
+};
+
+// ============================================
+// Intersection helpers (inline, shared by BLAS/TLAS traversal)
+// ============================================
+namespace BVHMath
+{
+    // Slab test; returns entry distance in outTNear
+    inline bool RayAABB(const SBVHRay& ray, const DirectX::XMFLOAT3& bmin, const DirectX::XMFLOAT3& bmax,
+                        float tMax, float& outTNear)
+    {
+        float tx1 = (bmin.x - ray.origin.x) * ray.invDirection.x;
+        float tx2 = (bmax.x - ray.origin.x) * ray.invDirection.x;
+        float ty1 = (bmin.y - ray.origin.y) * ray.invDirection.y;
+        float ty2 = (bmax.y - ray.origin.y) * ray.invDirection.y;
+        float tz1 = (bmin.z - ray.origin.z) * ray.invDirection.z;
+        float tz2 = (bmax.z - ray.origin.z) * ray.invDirection.z;
+
+        float tmin = std::max({std::min(tx1, tx2), std::min(ty1, ty2), std::min(tz1, tz2)});
+        float tmax = std::min({std::max(tx1, tx2), std::max(ty1, ty2), std::max(tz1, tz2)});
+
+        if (tmin < ray.tMin) tmin = ray.tMin;
+        if (tmax > tMax) tmax = tMax;
+        outTNear = tmin;
+        return tmin <= tmax;
+    }
+
+    // Möller–Trumbore against a precomputed-edge triangle
+    inline bool RayTriangle(const SBVHRay& ray, const SBVHTriangle& tri, float tMax,
+                            float& outT, float& outU, float& outV)
+    {
+        const DirectX::XMFLOAT3& d = ray.direction;
+        // p = d x e2
+        float px = d.y * tri.e2.z - d.z * tri.e2.y;
+        float py = d.z * tri.e2.x - d.x * tri.e2.z;
+        float pz = d.x * tri.e2.y - d.y * tri.e2.x;
+        float det = tri.e1.x * px + tri.e1.y * py + tri.e1.z * pz;
+        if (det > -1e-12f && det < 1e-12f) return false;
+        float invDet = 1.0f / det;
+
+        float sx = ray.origin.x - tri.v0.x;
+        float sy = ray.origin.y - tri.v0.y;
+        float sz = ray.origin.z - tri.v0.z;
+        float u = (sx * px + sy * py + sz * pz) * invDet;
+        if (u < 0.0f || u > 1.0f) return false;
+
+        // q = s x e1
+        float qx = sy * tri.e1.z - sz * tri.e1.y;
+        float qy = sz * tri.e1.x - sx * tri.e1.z;
+        float qz = sx * tri.e1.y - sy * tri.e1.x;
+        float v = (d.x * qx + d.y * qy + d.z * qz) * invDet;
+        if (v < 0.0f || u + v > 1.0f) return false;
+
+        float t = (tri.e2.x * qx + tri.e2.y * qy + tri.e2.z * qz) * invDet;
+        if (t <= ray.tMin || t >= tMax) return false;
+
+        outT = t;
+        outU = u;
+        outV = v;
+        return true;
+    }
+
+    inline float SurfaceArea(const DirectX::XMFLOAT3& bmin, const DirectX::XMFLOAT3& bmax)
+    {
+        float dx = bmax.x - bmin.x;
+        float dy = bmax.y - bmin.y;
+        float dz = bmax.z - bmin.z;
+        if (dx < 0.0f || dy < 0.0f || dz < 0.0f) return 0.0f;
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+}
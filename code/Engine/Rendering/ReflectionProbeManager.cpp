@@ -121,14 +121,14 @@ void CReflectionProbeManager::LoadLocalProbesFromScene(CScene& scene)
         if (loadAndCopyToArray(irradiancePath, sliceIndex, true) &&
             loadAndCopyToArray(prefilteredPath, sliceIndex, false))
         {
-            m_probeData.probes[sliceIndex].position = transform->position;
+            m_probeData.probes[sliceIndex].position = transform->GetWorldPosition();
             m_probeData.probes[sliceIndex].radius = probeComp->radius;
             m_probeCount++;
 
             CFFLog::Info("[ReflectionProbeManager] Loaded probe '%s' at index %d (pos=%.1f,%.1f,%.1f r=%.1f)",
                         objPtr->GetName().c_str(), sliceIndex,
-                        transform->position.x, transform->position.y, transform->position.z,
-                        probeComp->radius);
+                        m_probeData.probes[sliceIndex].position.x, m_probeData.probes[sliceIndex].position.y,
+                        m_probeData.probes[sliceIndex].position.z, probeComp->radius);
         }
     }
 
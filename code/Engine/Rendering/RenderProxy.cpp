@@ -0,0 +1,158 @@
+#include "RenderProxy.h"
+#include "Engine/World.h"
+#include "Engine/GameObject.h"
+#include "Engine/Components/Transform.h"
+#include "Engine/Components/MeshRenderer.h"
+#include "Core/GpuMeshResource.h"
+#include "Core/MaterialManager.h"
+#include <algorithm>
+#include <cfloat>
+
+using namespace DirectX;
+
+namespace
+{
+    // Union of the sub-meshes' local bounds. Returns false when any sub-mesh
+    // has no bounds (such proxies are never culled).
+    bool computeLocalBounds(const SMeshRenderer& meshRenderer, XMFLOAT3& outMin, XMFLOAT3& outMax)
+    {
+        outMin = {FLT_MAX, FLT_MAX, FLT_MAX};
+        outMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+        for (auto& gpuMesh : meshRenderer.meshes) {
+            if (!gpuMesh) continue;
+            if (!gpuMesh->hasBounds) return false;
+            outMin = {std::min(outMin.x, gpuMesh->localBoundsMin.x), std::min(outMin.y, gpuMesh->localBoundsMin.y),
+                      std::min(outMin.z, gpuMesh->localBoundsMin.z)};
+            outMax = {std::max(outMax.x, gpuMesh->localBoundsMax.x), std::max(outMax.y, gpuMesh->localBoundsMax.y),
+                      std::max(outMax.z, gpuMesh->localBoundsMax.z)};
+        }
+        return outMin.x <= outMax.x;
+    }
+}
+
+void CRenderProxyTable::Invalidate()
+{
+    m_valid = false;
+}
+
+XMMATRIX CRenderProxyTable::GetPrevWorldMatrix(size_t i) const
+{
+    return m_transforms[i]->PrevWorldMatrix();
+}
+
+int CRenderProxyTable::Update(CWorld& world)
+{
+    uint32_t materialGeneration = CMaterialManager::Instance().GetGeneration();
+
+    m_lastRebuilt = !m_valid ||
+                    m_worldVersion != world.GetVersion() ||
+                    m_componentEpoch != CGameObject::GetComponentEpoch();
+    if (m_lastRebuilt) {
+        rebuild(world);
+        m_worldVersion = world.GetVersion();
+        m_componentEpoch = CGameObject::GetComponentEpoch();
+        m_materialGeneration = materialGeneration;
+        m_valid = true;
+        m_lastUpdated = (int)Size();
+        return m_lastUpdated;
+    }
+
+    // Material cache cleared: every cached CMaterialAsset* is dangling
+    uint8_t globalDirty = RenderProxyDirty_None;
+    if (m_materialGeneration != materialGeneration) {
+        globalDirty |= RenderProxyDirty_Material;
+        m_materialGeneration = materialGeneration;
+    }
+
+    int updated = 0;
+    for (size_t i = 0; i < Size(); i++) {
+        uint8_t dirty = globalDirty;
+
+        if (m_transformVersions[i] != m_transforms[i]->GetWorldVersion()) {
+            dirty |= RenderProxyDirty_Transform;
+        }
+
+        SMeshRenderer* meshRenderer = m_meshRenderers[i];
+        // Mesh may still be pending (failed load or path just set)
+        if (meshRenderer->meshes.empty()) {
+            meshRenderer->EnsureUploaded();
+        }
+        if (m_renderVersions[i] != meshRenderer->renderVersion) {
+            dirty |= RenderProxyDirty_Mesh | RenderProxyDirty_Material;
+        }
+
+        m_dirty[i] = dirty;
+        if (dirty != RenderProxyDirty_None) {
+            refreshProxy(i, dirty);
+            updated++;
+        }
+    }
+
+    m_lastUpdated = updated;
+    return updated;
+}
+
+void CRenderProxyTable::rebuild(CWorld& world)
+{
+    m_objects.clear();
+    m_meshRenderers.clear();
+    m_transforms.clear();
+
+    for (auto& objPtr : world.Objects()) {
+        auto* obj = objPtr.get();
+        auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
+        auto* transform = obj->GetComponent<STransform>();
+        if (!meshRenderer || !transform) continue;
+
+        m_objects.push_back(obj);
+        m_meshRenderers.push_back(meshRenderer);
+        m_transforms.push_back(transform);
+    }
+
+    size_t count = m_objects.size();
+    m_materials.assign(count, nullptr);
+    m_worldMatrices.resize(count);
+    m_drawable.assign(count, 0);
+    m_bounds.Resize(count);
+    m_transformVersions.assign(count, 0);
+    m_renderVersions.assign(count, 0);
+    m_dirty.assign(count, RenderProxyDirty_All);
+
+    for (size_t i = 0; i < count; i++) {
+        m_meshRenderers[i]->EnsureUploaded();
+        refreshProxy(i, RenderProxyDirty_All);
+    }
+}
+
+void CRenderProxyTable::refreshProxy(size_t i, uint8_t dirty)
+{
+    SMeshRenderer* meshRenderer = m_meshRenderers[i];
+    const STransform* transform = m_transforms[i];
+
+    if (dirty & RenderProxyDirty_Transform) {
+        XMStoreFloat4x4(&m_worldMatrices[i], transform->WorldMatrix());
+        m_transformVersions[i] = transform->GetWorldVersion();
+    }
+
+    if (dirty & RenderProxyDirty_Material) {
+        CMaterialManager& materialMgr = CMaterialManager::Instance();
+        m_materials[i] = meshRenderer->materialPath.empty() ?
+            materialMgr.GetDefault() : materialMgr.Load(meshRenderer->materialPath);
+    }
+
+    if (dirty & RenderProxyDirty_Mesh) {
+        m_renderVersions[i] = meshRenderer->renderVersion;
+        m_drawable[i] = meshRenderer->meshes.empty() ? 0 : 1;
+    }
+
+    if (dirty & (RenderProxyDirty_Transform | RenderProxyDirty_Mesh)) {
+        XMFLOAT3 localMin, localMax;
+        if (!m_drawable[i]) {
+            m_bounds.Set(i, {0, 0, 0}, {0, 0, 0});
+        } else if (computeLocalBounds(*meshRenderer, localMin, localMax)) {
+            m_bounds.SetTransformed(i, localMin, localMax, XMLoadFloat4x4(&m_worldMatrices[i]));
+        } else {
+            m_bounds.Set(i, {0, 0, 0}, {1e30f, 1e30f, 1e30f});
+        }
+    }
+}
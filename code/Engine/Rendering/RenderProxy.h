@@ -0,0 +1,98 @@
+#pragma once
+#include "FrustumCulling.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+class CWorld;
+class CGameObject;
+class CMaterialAsset;
+struct SMeshRenderer;
+struct STransform;
+
+// ============================================
+// CRenderProxyTable - cached per-scene render data
+// ============================================
+// One proxy per CGameObject that has both SMeshRenderer and STransform.
+// World matrices, world bounds, material pointers and component pointers are
+// stored as contiguous SoA arrays so passes no longer call GetComponent,
+// STransform::WorldMatrix() or
+// CMaterialManager::Load(path) per object per pass.
+//
+// Update() runs once per frame and only recomputes what changed:
+//   - World structure (CWorld::Create/Destroy, AddComponent) -> full rebuild
+//   - STransform world version changed (own or parent move) -> Dirty_Transform
+//   - SMeshRenderer::renderVersion changed                 -> Dirty_Mesh | Dirty_Material
+//   - CMaterialManager cache cleared                       -> Dirty_Material (all)
+//
+// Usage:
+//   CRenderProxyTable& proxies = scene.GetRenderProxies();
+//   proxies.Update(scene.GetWorld());
+//   for (size_t i = 0; i < proxies.Size(); i++) { proxies.GetWorldMatrix(i); ... }
+
+enum ERenderProxyDirty : uint8_t
+{
+    RenderProxyDirty_None      = 0,
+    RenderProxyDirty_Transform = 1 << 0,
+    RenderProxyDirty_Mesh      = 1 << 1,
+    RenderProxyDirty_Material  = 1 << 2,
+    RenderProxyDirty_All       = RenderProxyDirty_Transform | RenderProxyDirty_Mesh | RenderProxyDirty_Material
+};
+
+class CRenderProxyTable
+{
+public:
+    // Returns the number of proxies that were recomputed this call
+    int Update(CWorld& world);
+
+    // Drop all proxies; the next Update() rebuilds from scratch
+    void Invalidate();
+
+    size_t Size() const { return m_objects.size(); }
+
+    CGameObject* GetGameObject(size_t i) const { return m_objects[i]; }
+    SMeshRenderer* GetMeshRenderer(size_t i) const { return m_meshRenderers[i]; }
+    STransform* GetTransform(size_t i) const { return m_transforms[i]; }
+    CMaterialAsset* GetMaterial(size_t i) const { return m_materials[i]; }
+    DirectX::XMMATRIX GetWorldMatrix(size_t i) const { return DirectX::XMLoadFloat4x4(&m_worldMatrices[i]); }
+    // Previous frame's world matrix (from CTransformSystem)
+    DirectX::XMMATRIX GetPrevWorldMatrix(size_t i) const;
+    // Has uploaded meshes (proxies without meshes are kept but never drawn)
+    bool IsDrawable(size_t i) const { return m_drawable[i] != 0; }
+
+    // World-space bounds, index-aligned with the proxies
+    const SCullBounds& GetBounds() const { return m_bounds; }
+
+    // ERenderProxyDirty bits recomputed by the last Update()
+    uint8_t GetDirtyFlags(size_t i) const { return m_dirty[i]; }
+
+    // Stats for the last Update()
+    int GetLastUpdatedCount() const { return m_lastUpdated; }
+    bool WasRebuilt() const { return m_lastRebuilt; }
+
+private:
+    void rebuild(CWorld& world);
+    void refreshProxy(size_t i, uint8_t dirty);
+
+    // SoA
+    std::vector<CGameObject*> m_objects;
+    std::vector<SMeshRenderer*> m_meshRenderers;
+    std::vector<STransform*> m_transforms;
+    std::vector<CMaterialAsset*> m_materials;
+    std::vector<DirectX::XMFLOAT4X4> m_worldMatrices;
+    std::vector<uint8_t> m_drawable;
+    SCullBounds m_bounds;
+
+    // Change detection
+    std::vector<uint32_t> m_transformVersions;     // STransform::GetWorldVersion() snapshot
+    std::vector<uint32_t> m_renderVersions;
+    std::vector<uint8_t> m_dirty;
+
+    bool m_valid = false;
+    uint32_t m_worldVersion = 0;
+    uint32_t m_componentEpoch = 0;
+    uint32_t m_materialGeneration = 0;
+
+    int m_lastUpdated = 0;
+    bool m_lastRebuilt = false;
+};
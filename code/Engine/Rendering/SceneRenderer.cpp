@@ -3,6 +3,7 @@
 #include "ShadowPass.h"
 #include "ShowFlags.h"
 #include "ReflectionProbeManager.h"
+#include "FrustumCulling.h"
 #include "RHI/RHIManager.h"
 #include "RHI/IRenderContext.h"
 #include "RHI/ICommandList.h"
@@ -18,6 +19,7 @@
 #include "Core/PathManager.h"
 #include "Core/GpuMeshResource.h"
 #include "Core/Mesh.h"
+#include "MeshVertexStreams.h"
 #include "Engine/Scene.h"
 #include "Engine/GameObject.h"
 #include "Engine/Components/Transform.h"
@@ -26,6 +28,7 @@
 #include "Core/MaterialManager.h"
 #include "Core/TextureManager.h"
 #include "Engine/Camera.h"
+#include "Core/Testing/RenderStats.h"
 #include <algorithm>
 #include <fstream>
 #include <sstream>
@@ -45,8 +48,11 @@ struct RenderItem {
     STransform* transform;
     CMaterialAsset* material;
     XMMATRIX worldMatrix;
+    XMMATRIX prevWorldMatrix;
     float distanceToCamera;
     GpuMeshResource* gpuMesh;
+    SGpuMeshLod lod;    // Index range selected for this view
+    int lodIndex;
     RHI::ITexture* albedoTex;
     RHI::ITexture* normalTex;
     RHI::ITexture* metallicRoughnessTex;
@@ -94,26 +100,18 @@ struct alignas(16) CB_ForwardPerPass {
 
 // 收集并分类渲染项
 void collectRenderItems(
-    CScene& scene,
+    const std::vector<SCullItem>& visibleItems,
     XMVECTOR eye,
     std::vector<RenderItem>& opaqueItems,
     std::vector<RenderItem>& transparentItems,
     const CReflectionProbeManager* probeManager)
 {
-    for (auto& objPtr : scene.GetWorld().Objects()) {
-        auto* obj = objPtr.get();
-        auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
-        auto* transform = obj->GetComponent<STransform>();
-
-        if (!meshRenderer || !transform) continue;
+    for (const SCullItem& cullItem : visibleItems) {
+        auto* obj = cullItem.obj;
+        auto* meshRenderer = cullItem.meshRenderer;
+        auto* transform = cullItem.transform;
 
-        meshRenderer->EnsureUploaded();
-        if (meshRenderer->meshes.empty()) continue;
-
-        CMaterialAsset* material = CMaterialManager::Instance().GetDefault();
-        if (!meshRenderer->materialPath.empty()) {
-            material = CMaterialManager::Instance().Load(meshRenderer->materialPath);
-        }
+        CMaterialAsset* material = cullItem.material;
 
         CTextureManager& texMgr = CTextureManager::Instance();
         RHI::ITexture* albedoTex = material->albedoTexture.empty() ?
@@ -128,7 +126,7 @@ void collectRenderItems(
         bool hasRealMetallicRoughnessTexture = !material->metallicRoughnessMap.empty();
         bool hasRealEmissiveMap = !material->emissiveMap.empty();
 
-        XMMATRIX worldMatrix = transform->WorldMatrix();
+        XMMATRIX worldMatrix = cullItem.worldMatrix;
         XMVECTOR objPos = worldMatrix.r[3];
         XMVECTOR delta = XMVectorSubtract(objPos, eye);
         float distance = XMVectorGetX(XMVector3Length(delta));
@@ -150,8 +148,11 @@ void collectRenderItems(
             item.transform = transform;
             item.material = material;
             item.worldMatrix = worldMatrix;
+            item.prevWorldMatrix = cullItem.prevWorldMatrix;
             item.distanceToCamera = distance;
             item.gpuMesh = gpuMesh.get();
+            item.lodIndex = (int)gpuMesh->SelectLod(cullItem.lodMaxError);
+            item.lod = gpuMesh->GetLod((uint32_t)item.lodIndex);
             item.albedoTex = albedoTex;
             item.normalTex = normalTex;
             item.metallicRoughnessTex = metallicRoughnessTex;
@@ -208,9 +209,12 @@ void CSceneRenderer::Shutdown()
 
     // Cleanup descriptor set resources
     m_vs_ds.reset();
+    m_vsPacked_ds.reset();
     m_ps_ds.reset();
     m_psoOpaque_ds.reset();
     m_psoTransparent_ds.reset();
+    m_psoOpaquePacked_ds.reset();
+    m_psoTransparentPacked_ds.reset();
     m_materialSampler.reset();
 
     auto* ctx = CRHIManager::Instance().GetRenderContext();
@@ -252,7 +256,8 @@ void CSceneRenderer::Render(
     const CShadowPass::Output* shadowData,
     CClusteredLightingPass* clusteredLighting,
     RHI::IDescriptorSet* perFrameSet,
-    const CReflectionProbeManager* probeManager)
+    const CReflectionProbeManager* probeManager,
+    const CSceneCuller* culler)
 {
     IRenderContext* ctx = CRHIManager::Instance().GetRenderContext();
     if (!ctx) return;
@@ -348,7 +353,12 @@ void CSceneRenderer::Render(
     std::vector<RenderItem> opaqueItems;
     std::vector<RenderItem> transparentItems;
     XMVECTOR eye = XMLoadFloat3(&camera.position);
-    collectRenderItems(scene, eye, opaqueItems, transparentItems, probeManager);
+    if (!culler) {
+        // Standalone use (probe baking, screenshots): cull against this camera only
+        m_culler.Cull(scene, camera.GetViewMatrix() * camera.GetProjectionMatrix());
+        culler = &m_culler;
+    }
+    collectRenderItems(culler->GetVisible(CULL_VIEW_CAMERA), eye, opaqueItems, transparentItems, probeManager);
 
     // ============================================
     // Render Opaque Objects
@@ -356,8 +366,14 @@ void CSceneRenderer::Render(
     if (!opaqueItems.empty()) {
         cmdList->SetPipelineState(m_psoOpaque_ds.get());
         cmdList->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
+        EVertexLayout boundLayout = EVertexLayout::Full;
 
         for (auto& item : opaqueItems) {
+            if (item.gpuMesh->layout != boundLayout) {
+                if (!bindVertexLayout(cmdList, item.gpuMesh->layout, false, perFrameSet)) continue;
+                boundLayout = item.gpuMesh->layout;
+            }
+
             // Bind PerMaterial set
             MaterialConstants::CB_Material matData;
             matData.albedo = item.material->albedo;
@@ -383,7 +399,7 @@ void CSceneRenderer::Render(
             // Bind PerDraw set
             PerDrawSlots::CB_PerDraw perDraw;
             XMStoreFloat4x4(&perDraw.World, XMMatrixTranspose(item.worldMatrix));
-            XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(item.worldMatrix));  // TODO: Track previous frame
+            XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(item.prevWorldMatrix));
             perDraw.lightmapIndex = item.lightmapIndex;
             perDraw.objectID = item.probeIndex;  // Store probe index in objectID for now
 
@@ -391,9 +407,9 @@ void CSceneRenderer::Render(
             cmdList->BindDescriptorSet(3, m_perDrawSet);
 
             // Draw
-            cmdList->SetVertexBuffer(0, item.gpuMesh->vbo.get(), sizeof(SVertexPNT), 0);
-            cmdList->SetIndexBuffer(item.gpuMesh->ibo.get(), EIndexFormat::UInt32, 0);
-            cmdList->DrawIndexed(item.gpuMesh->indexCount, 0, 0);
+            MeshVertexStreams::Bind(cmdList, *item.gpuMesh);
+            cmdList->DrawIndexed(item.lod.indexCount, item.lod.firstIndex, 0);
+            CRenderStats::Instance().RecordLodDraw(false, item.lodIndex, (int)(item.lod.indexCount / 3));
         }
     }
 
@@ -403,8 +419,14 @@ void CSceneRenderer::Render(
     if (!transparentItems.empty()) {
         cmdList->SetPipelineState(m_psoTransparent_ds.get());
         cmdList->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
+        EVertexLayout boundLayout = EVertexLayout::Full;
 
         for (auto& item : transparentItems) {
+            if (item.gpuMesh->layout != boundLayout) {
+                if (!bindVertexLayout(cmdList, item.gpuMesh->layout, true, perFrameSet)) continue;
+                boundLayout = item.gpuMesh->layout;
+            }
+
             // Bind PerMaterial set
             MaterialConstants::CB_Material matData;
             matData.albedo = item.material->albedo;
@@ -430,7 +452,7 @@ void CSceneRenderer::Render(
             // Bind PerDraw set
             PerDrawSlots::CB_PerDraw perDraw;
             XMStoreFloat4x4(&perDraw.World, XMMatrixTranspose(item.worldMatrix));
-            XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(item.worldMatrix));
+            XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(item.prevWorldMatrix));
             perDraw.lightmapIndex = item.lightmapIndex;
             perDraw.objectID = item.probeIndex;
 
@@ -438,9 +460,9 @@ void CSceneRenderer::Render(
             cmdList->BindDescriptorSet(3, m_perDrawSet);
 
             // Draw
-            cmdList->SetVertexBuffer(0, item.gpuMesh->vbo.get(), sizeof(SVertexPNT), 0);
-            cmdList->SetIndexBuffer(item.gpuMesh->ibo.get(), EIndexFormat::UInt32, 0);
-            cmdList->DrawIndexed(item.gpuMesh->indexCount, 0, 0);
+            MeshVertexStreams::Bind(cmdList, *item.gpuMesh);
+            cmdList->DrawIndexed(item.lod.indexCount, item.lod.firstIndex, 0);
+            CRenderStats::Instance().RecordLodDraw(false, item.lodIndex, (int)(item.lod.indexCount / 3));
         }
     }
 }
@@ -629,6 +651,18 @@ void CSceneRenderer::initDescriptorSets()
     vsDesc.debugName = "Forward_DS_VS";
     m_vs_ds.reset(ctx->CreateShader(vsDesc));
 
+    // Packed vertex layout variant (optional, packed meshes are skipped without it)
+    std::string vsPackedSource = MeshVertexStreams::ShaderSource(vsSource, EVertexLayout::Packed);
+    SCompiledShader vsPackedCompiled = CompileShaderFromSource(vsPackedSource.c_str(), "main", "vs_5_1", &includeHandler, debugShaders);
+    if (vsPackedCompiled.success) {
+        vsDesc.bytecode = vsPackedCompiled.bytecode.data();
+        vsDesc.bytecodeSize = vsPackedCompiled.bytecode.size();
+        vsDesc.debugName = "Forward_DS_Packed_VS";
+        m_vsPacked_ds.reset(ctx->CreateShader(vsDesc));
+    } else {
+        CFFLog::Warning("[SceneRenderer] Packed vertex shader compile error: %s", vsPackedCompiled.errorMessage.c_str());
+    }
+
     // Compile SM 5.1 pixel shader
     std::string psSource = LoadShaderSource(shaderDir + "MainPass_DS.ps.hlsl");
     if (psSource.empty()) {
@@ -732,23 +766,13 @@ void CSceneRenderer::CreatePSOWithLayouts(IDescriptorSetLayout* perFrameLayout)
     IRenderContext* ctx = CRHIManager::Instance().GetRenderContext();
     if (!ctx) return;
 
-    // Input layout (matches SVertexPNT)
-    std::vector<VertexElement> inputLayout = {
-        { EVertexSemantic::Position, 0, EVertexFormat::Float3, 0, 0 },
-        { EVertexSemantic::Normal,   0, EVertexFormat::Float3, 12, 0 },
-        { EVertexSemantic::Texcoord, 0, EVertexFormat::Float2, 24, 0 },
-        { EVertexSemantic::Tangent,  0, EVertexFormat::Float4, 32, 0 },
-        { EVertexSemantic::Color,    0, EVertexFormat::Float4, 48, 0 },
-        { EVertexSemantic::Texcoord, 1, EVertexFormat::Float2, 64, 0 }  // UV2 for lightmap
-    };
-
     // ============================================
     // Opaque Pipeline State (Descriptor Set Path)
     // ============================================
     PipelineStateDesc psoOpaque;
     psoOpaque.vertexShader = m_vs_ds.get();
     psoOpaque.pixelShader = m_ps_ds.get();
-    psoOpaque.inputLayout = inputLayout;
+    psoOpaque.inputLayout = MeshVertexStreams::FullLayout();  // Matches SVertexPNT
 
     // Rasterizer state
     psoOpaque.rasterizer.fillMode = EFillMode::Solid;
@@ -803,4 +827,41 @@ void CSceneRenderer::CreatePSOWithLayouts(IDescriptorSetLayout* perFrameLayout)
     } else {
         CFFLog::Error("[SceneRenderer] Failed to create PSOs with descriptor set layouts");
     }
+
+    // ============================================
+    // Packed Vertex Layout Variants
+    // ============================================
+    if (m_vsPacked_ds) {
+        psoOpaque.vertexShader = m_vsPacked_ds.get();
+        psoOpaque.inputLayout = MeshVertexStreams::PackedLayout();
+        psoOpaque.debugName = "Forward_Opaque_DS_Packed_PSO";
+        m_psoOpaquePacked_ds.reset(ctx->CreatePipelineState(psoOpaque));
+
+        psoTransparent.vertexShader = m_vsPacked_ds.get();
+        psoTransparent.inputLayout = MeshVertexStreams::PackedLayout();
+        psoTransparent.debugName = "Forward_Transparent_DS_Packed_PSO";
+        m_psoTransparentPacked_ds.reset(ctx->CreatePipelineState(psoTransparent));
+    }
+    if (!m_psoOpaquePacked_ds || !m_psoTransparentPacked_ds) {
+        CFFLog::Warning("[SceneRenderer] No packed vertex PSOs, packed meshes are skipped");
+    }
+}
+
+// Picks the opaque/transparent PSO for a mesh vertex layout and re-binds the
+// frame and pass sets (material and draw sets are bound per item right after).
+bool CSceneRenderer::bindVertexLayout(ICommandList* cmdList, EVertexLayout layout, bool transparent,
+                                      IDescriptorSet* perFrameSet)
+{
+    IPipelineState* pso = nullptr;
+    if (layout == EVertexLayout::Packed) {
+        pso = transparent ? m_psoTransparentPacked_ds.get() : m_psoOpaquePacked_ds.get();
+    } else {
+        pso = transparent ? m_psoTransparent_ds.get() : m_psoOpaque_ds.get();
+    }
+    if (!pso) return false;
+
+    cmdList->SetPipelineState(pso);
+    cmdList->BindDescriptorSet(0, perFrameSet);
+    cmdList->BindDescriptorSet(1, m_perPassSet);
+    return true;
 }
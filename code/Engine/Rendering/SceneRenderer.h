@@ -3,6 +3,7 @@
 #include <memory>
 #include <cstdint>
 #include "ShadowPass.h"
+#include "FrustumCulling.h"
 #include "RHI/RHIResources.h"
 
 // Forward declarations
@@ -10,8 +11,10 @@ class CScene;
 class CCamera;
 class CClusteredLightingPass;
 class CReflectionProbeManager;
+enum class EVertexLayout : uint8_t;
 
 namespace RHI {
+    class ICommandList;
     class IDescriptorSetLayout;
     class IDescriptorSet;
 }
@@ -63,6 +66,8 @@ public:
     // - clusteredLighting: 聚类光照 Pass（用于绑定光照数据）
     // - perFrameSet: PerFrame descriptor set (IBL, shadows, clustered lighting)
     // - probeManager: Reflection probe manager (for per-object probe selection)
+    // - culler: Culling result for this frame (CULL_VIEW_CAMERA is drawn);
+    //           nullptr = cull against the camera internally
     void Render(
         const CCamera& camera,
         CScene& scene,
@@ -73,7 +78,8 @@ public:
         const CShadowPass::Output* shadowData,
         CClusteredLightingPass* clusteredLighting,
         RHI::IDescriptorSet* perFrameSet,
-        const CReflectionProbeManager* probeManager
+        const CReflectionProbeManager* probeManager,
+        const CSceneCuller* culler = nullptr
     );
 
 private:
@@ -83,6 +89,10 @@ private:
     // Descriptor set initialization (DX12 only)
     void initDescriptorSets();
 
+    // Switch PSO for a mesh vertex layout, re-binding the frame and pass sets
+    bool bindVertexLayout(RHI::ICommandList* cmdList, EVertexLayout layout, bool transparent,
+                          RHI::IDescriptorSet* perFrameSet);
+
     // ============================================
     // Rendering Resources (RHI)
     // ============================================
@@ -92,6 +102,7 @@ private:
 
     // Shaders (SM 5.1 descriptor set path)
     std::unique_ptr<RHI::IShader> m_vs_ds;
+    std::unique_ptr<RHI::IShader> m_vsPacked_ds;   // PACKED_VERTEX variant
     std::unique_ptr<RHI::IShader> m_ps_ds;
 
     // Pipeline states (legacy)
@@ -101,6 +112,8 @@ private:
     // Pipeline states (descriptor set path)
     std::unique_ptr<RHI::IPipelineState> m_psoOpaque_ds;
     std::unique_ptr<RHI::IPipelineState> m_psoTransparent_ds;
+    std::unique_ptr<RHI::IPipelineState> m_psoOpaquePacked_ds;        // Packed vertex layout
+    std::unique_ptr<RHI::IPipelineState> m_psoTransparentPacked_ds;
 
     // Constant buffers (legacy)
     std::unique_ptr<RHI::IBuffer> m_cbFrame;
@@ -110,6 +123,9 @@ private:
     std::unique_ptr<RHI::ISampler> m_sampler;
     std::unique_ptr<RHI::ISampler> m_materialSampler;
 
+    // Camera-only culling when Render() is called without a culler
+    CSceneCuller m_culler;
+
     // ============================================
     // Descriptor Set Resources (DX12 only)
     // ============================================
@@ -10,6 +10,9 @@
 #include "Core/PathManager.h"
 #include "Core/GpuMeshResource.h"
 #include "Core/Mesh.h"
+#include "Engine/Rendering/MeshVertexStreams.h"
+#include "Core/Testing/RenderStats.h"
+#include "FrustumCulling.h"
 #include "Scene.h"
 #include "GameObject.h"
 #include "Components/Transform.h"
@@ -438,18 +441,48 @@ XMMATRIX CShadowPass::calculateTightLightMatrix(
     return lightView * lightProj;
 }
 
-void CShadowPass::Render(CScene& scene, SDirectionalLight* light,
-                        const XMMATRIX& cameraView,
-                        const XMMATRIX& cameraProj)
+int CShadowPass::PrepareCascades(SDirectionalLight* light,
+                                 const XMMATRIX& cameraView,
+                                 const XMMATRIX& cameraProj)
+{
+    if (!light) {
+        m_output.cascadeCount = 0;
+        return 0;
+    }
+
+    // Get CSM parameters from light
+    int cascadeCount = std::min(std::max(light->cascade_count, 1), 4);
+    float shadowDistance = light->shadow_distance;
+
+    // Calculate cascade split distances (in camera space)
+    float cameraNear = 0.1f;  // TODO: Get from camera settings
+    auto splits = calculateCascadeSplits(cascadeCount, cameraNear, shadowDistance,
+                                         std::clamp(light->cascade_split_lambda, 0.0f, 1.0f));
+
+    for (int cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex) {
+        // Extract sub-frustum for this cascade
+        auto subFrustumCorners = extractSubFrustum(cameraView, cameraProj,
+                                                    splits[cascadeIndex],
+                                                    splits[cascadeIndex + 1]);
+
+        // Calculate light space matrix with fixed square bounds for this cascade
+        float cascadeFar = splits[cascadeIndex + 1];
+        m_output.lightSpaceVPs[cascadeIndex] = calculateTightLightMatrix(subFrustumCorners, light, cascadeFar);
+        m_output.cascadeSplits[cascadeIndex] = splits[cascadeIndex + 1];  // Far plane distance
+    }
+
+    m_output.cascadeCount = cascadeCount;
+    return cascadeCount;
+}
+
+void CShadowPass::Render(SDirectionalLight* light, const CSceneCuller& culler)
 {
     IRenderContext* ctx = CRHIManager::Instance().GetRenderContext();
     ICommandList* cmdList = ctx->GetCommandList();
 
     if (!cmdList || !light) return;
 
-    // Get CSM parameters from light
-    int cascadeCount = std::min(std::max(light->cascade_count, 1), 4);
-    float shadowDistance = light->shadow_distance;
+    int cascadeCount = m_output.cascadeCount;
     uint32_t shadowMapSize = (uint32_t)light->GetShadowMapResolution();
 
     // Unbind render targets to avoid hazards
@@ -458,11 +491,6 @@ void CShadowPass::Render(CScene& scene, SDirectionalLight* light,
     // Ensure shadow map array resources
     ensureShadowMapArray(shadowMapSize, cascadeCount);
 
-    // Calculate cascade split distances (in camera space)
-    float cameraNear = 0.1f;  // TODO: Get from camera settings
-    auto splits = calculateCascadeSplits(cascadeCount, cameraNear, shadowDistance,
-                                         std::clamp(light->cascade_split_lambda, 0.0f, 1.0f));
-
     // Set pipeline state via RHI (descriptor set path only)
     cmdList->SetPipelineState(m_pso_ds.get());
     cmdList->SetPrimitiveTopology(EPrimitiveTopology::TriangleList);
@@ -473,14 +501,7 @@ void CShadowPass::Render(CScene& scene, SDirectionalLight* light,
 
     // Render each cascade
     for (int cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex) {
-        // Extract sub-frustum for this cascade
-        auto subFrustumCorners = extractSubFrustum(cameraView, cameraProj,
-                                                    splits[cascadeIndex],
-                                                    splits[cascadeIndex + 1]);
-
-        // Calculate light space matrix with fixed square bounds for this cascade
-        float cascadeFar = splits[cascadeIndex + 1];
-        XMMATRIX lightSpaceVP = calculateTightLightMatrix(subFrustumCorners, light, cascadeFar);
+        const XMMATRIX& lightSpaceVP = m_output.lightSpaceVPs[cascadeIndex];
 
         // Bind this cascade's DSV via RHI
         cmdList->SetDepthStencilOnly(m_shadowMapArray.get(), cascadeIndex);
@@ -488,6 +509,10 @@ void CShadowPass::Render(CScene& scene, SDirectionalLight* light,
         // Clear depth for this cascade via RHI
         cmdList->ClearDepthStencilSlice(m_shadowMapArray.get(), cascadeIndex, true, 1.0f, false, 0);
 
+        // The previous cascade may have ended on the packed-layout PSO
+        EVertexLayout boundLayout = EVertexLayout::Full;
+        cmdList->SetPipelineState(m_pso_ds.get());
+
         // Bind PerPass set (Set 1) with light space matrix
         CB_ShadowPass passCB;
         passCB.lightSpaceVP = XMMatrixTranspose(lightSpaceVP);
@@ -496,41 +521,36 @@ void CShadowPass::Render(CScene& scene, SDirectionalLight* light,
         m_perPassSet->Bind(BindingSetItem::VolatileCBV(0, &passCB, sizeof(passCB)));
         cmdList->BindDescriptorSet(1, m_perPassSet);
 
-        // Render all objects to this cascade
-        for (auto& objPtr : scene.GetWorld().Objects()) {
-            auto* obj = objPtr.get();
-            auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
-            auto* transform = obj->GetComponent<STransform>();
-
-            if (!meshRenderer || !transform) continue;
-
-            meshRenderer->EnsureUploaded();
-            if (meshRenderer->meshes.empty()) continue;
-
-            XMMATRIX worldMatrix = transform->WorldMatrix();
-
+        // Render objects inside this cascade
+        int drawCalls = 0;
+        for (const SCullItem& item : culler.GetVisible(CULL_VIEW_CASCADE0 + cascadeIndex)) {
             // Bind PerDraw set (Set 3) with world matrix
             PerDrawSlots::CB_PerDraw perDraw;
-            XMStoreFloat4x4(&perDraw.World, XMMatrixTranspose(worldMatrix));
-            XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(worldMatrix));
+            XMStoreFloat4x4(&perDraw.World, XMMatrixTranspose(item.worldMatrix));
+            XMStoreFloat4x4(&perDraw.WorldPrev, XMMatrixTranspose(item.worldMatrix));
             perDraw.lightmapIndex = -1;  // Not used in shadow pass
             perDraw.objectID = 0;
 
             m_perDrawSet->Bind(BindingSetItem::VolatileCBV(0, &perDraw, sizeof(perDraw)));
             cmdList->BindDescriptorSet(3, m_perDrawSet);
 
-            for (auto& gpuMesh : meshRenderer->meshes) {
+            for (auto& gpuMesh : item.meshRenderer->meshes) {
                 if (!gpuMesh) continue;
 
-                cmdList->SetVertexBuffer(0, gpuMesh->vbo.get(), sizeof(SVertexPNT), 0);
-                cmdList->SetIndexBuffer(gpuMesh->ibo.get(), EIndexFormat::UInt32, 0);
-                cmdList->DrawIndexed(gpuMesh->indexCount, 0, 0);
+                if (gpuMesh->layout != boundLayout) {
+                    if (!bindVertexLayout(cmdList, gpuMesh->layout)) continue;
+                    boundLayout = gpuMesh->layout;
+                }
+
+                uint32_t lodIndex = gpuMesh->SelectLod(item.lodMaxError);
+                SGpuMeshLod lod = gpuMesh->GetLod(lodIndex);
+                MeshVertexStreams::BindPositions(cmdList, *gpuMesh);
+                cmdList->DrawIndexed(lod.indexCount, lod.firstIndex, 0);
+                CRenderStats::Instance().RecordLodDraw(true, (int)lodIndex, (int)(lod.indexCount / 3));
+                drawCalls++;
             }
         }
-
-        // Save cascade data to output
-        m_output.lightSpaceVPs[cascadeIndex] = lightSpaceVP;
-        m_output.cascadeSplits[cascadeIndex] = splits[cascadeIndex + 1];  // Far plane distance
+        CRenderStats::Instance().RecordShadowPass(cascadeIndex, drawCalls);
     }
 
     // Unbind DSV to allow reading as SRV in MainPass
@@ -540,7 +560,6 @@ void CShadowPass::Render(CScene& scene, SDirectionalLight* light,
     cmdList->Barrier(m_shadowMapArray.get(), EResourceState::DepthWrite, EResourceState::ShaderResource);
 
     // Update output bundle
-    m_output.cascadeCount = cascadeCount;
     m_output.shadowMapArray = m_shadowMapArray.get();
     m_output.shadowSampler = m_shadowSampler.get();
     m_output.cascadeBlendRange = std::clamp(light->cascade_blend_range, 0.0f, 0.5f);
@@ -643,13 +662,8 @@ void CShadowPass::CreatePSOWithLayouts(IDescriptorSetLayout* perFrameLayout)
     psoDesc.vertexShader = m_depthVS_ds.get();
     psoDesc.pixelShader = nullptr;  // Depth-only, no pixel shader
 
-    // Input layout (same as legacy PSO)
-    psoDesc.inputLayout = {
-        { EVertexSemantic::Position, 0, EVertexFormat::Float3, 0, 0 },
-        { EVertexSemantic::Normal,   0, EVertexFormat::Float3, 12, 0 },
-        { EVertexSemantic::Texcoord, 0, EVertexFormat::Float2, 24, 0 },
-        { EVertexSemantic::Tangent,  0, EVertexFormat::Float4, 32, 0 }
-    };
+    // Input layout: positions only (the packed variant is created below)
+    psoDesc.inputLayout = MeshVertexStreams::PositionLayout(EVertexLayout::Full);
 
     // Rasterizer state
     psoDesc.rasterizer.fillMode = EFillMode::Solid;
@@ -685,4 +699,25 @@ void CShadowPass::CreatePSOWithLayouts(IDescriptorSetLayout* perFrameLayout)
     } else {
         CFFLog::Error("[ShadowPass] Failed to create PSO with descriptor set layouts");
     }
+
+    // Packed meshes: same shader, half4 position stream
+    psoDesc.inputLayout = MeshVertexStreams::PositionLayout(EVertexLayout::Packed);
+    psoDesc.debugName = "Shadow_DS_Packed_PSO";
+    m_psoPacked_ds.reset(ctx->CreatePipelineState(psoDesc));
+    if (!m_psoPacked_ds) {
+        CFFLog::Warning("[ShadowPass] Failed to create packed vertex PSO, packed meshes are skipped");
+    }
+}
+
+// Position-only PSO for a mesh vertex layout; rebinding the cascade and
+// per-draw sets since SetPipelineState also re-sets the root signature.
+bool CShadowPass::bindVertexLayout(ICommandList* cmdList, EVertexLayout layout)
+{
+    IPipelineState* pso = layout == EVertexLayout::Packed ? m_psoPacked_ds.get() : m_pso_ds.get();
+    if (!pso) return false;
+
+    cmdList->SetPipelineState(pso);
+    cmdList->BindDescriptorSet(1, m_perPassSet);
+    cmdList->BindDescriptorSet(3, m_perDrawSet);
+    return true;
 }
@@ -9,9 +9,12 @@
 
 // Forward declarations
 class CScene;
+class CSceneCuller;
 struct SDirectionalLight;
+enum class EVertexLayout : uint8_t;
 
 namespace RHI {
+    class ICommandList;
     class IDescriptorSetLayout;
     class IDescriptorSet;
 }
@@ -47,12 +50,17 @@ public:
     bool Initialize();
     void Shutdown();
 
-    // Render shadow map from directional light's perspective
-    // Uses tight frustum fitting based on camera view frustum
-    // cameraView, cameraProj: Camera matrices for frustum extraction
-    void Render(CScene& scene, SDirectionalLight* light,
-                const DirectX::XMMATRIX& cameraView,
-                const DirectX::XMMATRIX& cameraProj);
+    // Compute cascade splits and light-space matrices (tight frustum fitting based
+    // on the camera view frustum). Call before culling so the cascades can be culled
+    // together with the camera; results are in GetOutput().
+    // Returns the cascade count.
+    int PrepareCascades(SDirectionalLight* light,
+                        const DirectX::XMMATRIX& cameraView,
+                        const DirectX::XMMATRIX& cameraProj);
+
+    // Render shadow map from directional light's perspective using the cascades from
+    // PrepareCascades. Cascade i draws culler.GetVisible(CULL_VIEW_CASCADE0 + i).
+    void Render(SDirectionalLight* light, const CSceneCuller& culler);
 
     // Get complete shadow output bundle for MainPass
     const Output& GetOutput() const { return m_output; }
@@ -66,6 +74,7 @@ public:
 private:
     void ensureShadowMapArray(uint32_t size, int cascadeCount);
     void initDescriptorSets();
+    bool bindVertexLayout(RHI::ICommandList* cmdList, EVertexLayout layout);
 
     // Tight frustum fitting helpers
     std::array<DirectX::XMFLOAT3, 8> extractFrustumCorners(
@@ -127,7 +136,8 @@ private:
     // Descriptor Set Resources (SM 5.1, DX12 only)
     // ============================================
     RHI::ShaderPtr m_depthVS_ds;
-    RHI::PipelineStatePtr m_pso_ds;
+    RHI::PipelineStatePtr m_pso_ds;         // Full vertex layout (position read from SVertexPNT)
+    RHI::PipelineStatePtr m_psoPacked_ds;   // Packed vertex layout (position stream only)
 
     // Descriptor set layouts
     RHI::IDescriptorSetLayout* m_perPassLayout = nullptr;
@@ -14,11 +14,16 @@
 #include "Core/FFLog.h"
 #include "Core/PathManager.h"
 #include "Core/TextureManager.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/DerivedDataCache.h"
 #include <DirectXPackedVector.h>
 #include <cmath>
 #include <cfloat>
 #include <fstream>
+#include <filesystem>
+#include <cstring>
 #include <chrono>
+#include <thread>
 
 using namespace DirectX;
 using namespace DirectX::PackedVector;
@@ -198,6 +203,9 @@ void CVolumetricLightmap::BuildOctree(CScene& scene)
 
     CFFLog::Info("[VolumetricLightmap] Building octree...");
 
+    // 几何体查询走场景空间索引（每个节点一次 AABB 查询，而不是遍历全部物体）
+    scene.GetSpatialIndex().Update(scene.GetWorld());
+
     // 递归构建
     buildOctreeRecursive(0, 0, scene);
 
@@ -302,77 +310,18 @@ bool CVolumetricLightmap::checkGeometryInBounds(
     const XMFLOAT3& boundsMax,
     CScene& scene)
 {
-    auto& world = scene.GetWorld();
-
-    for (size_t i = 0; i < world.Count(); i++)
-    {
-        auto* obj = world.Get(i);
-        if (!obj) continue;
-
-        auto* transform = obj->GetComponent<STransform>();
-        auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
-
-        if (!transform || !meshRenderer) continue;
-
-        // 获取局部空间 AABB
-        XMFLOAT3 localMin, localMax;
-        if (!meshRenderer->GetLocalBounds(localMin, localMax)) {
-            // 如果无法获取 bounds，使用物体位置作为点进行检测
-            const auto& pos = transform->position;
-            if (pos.x >= boundsMin.x && pos.x <= boundsMax.x &&
-                pos.y >= boundsMin.y && pos.y <= boundsMax.y &&
-                pos.z >= boundsMin.z && pos.z <= boundsMax.z)
-            {
-                return true;
-            }
-            continue;
-        }
-
-        // 将局部 AABB 的 8 个顶点变换到世界空间，计算世界空间 AABB
-        XMMATRIX worldMatrix = transform->WorldMatrix();
-
-        // 局部 AABB 的 8 个顶点
-        XMFLOAT3 localCorners[8] = {
-            {localMin.x, localMin.y, localMin.z},
-            {localMax.x, localMin.y, localMin.z},
-            {localMin.x, localMax.y, localMin.z},
-            {localMax.x, localMax.y, localMin.z},
-            {localMin.x, localMin.y, localMax.z},
-            {localMax.x, localMin.y, localMax.z},
-            {localMin.x, localMax.y, localMax.z},
-            {localMax.x, localMax.y, localMax.z}
-        };
-
-        // 变换到世界空间并计算世界 AABB
-        XMFLOAT3 worldMin = {FLT_MAX, FLT_MAX, FLT_MAX};
-        XMFLOAT3 worldMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
-
-        for (int c = 0; c < 8; c++) {
-            XMVECTOR localPt = XMLoadFloat3(&localCorners[c]);
-            XMVECTOR worldPt = XMVector3Transform(localPt, worldMatrix);
-            XMFLOAT3 wp;
-            XMStoreFloat3(&wp, worldPt);
-
-            worldMin.x = std::min(worldMin.x, wp.x);
-            worldMin.y = std::min(worldMin.y, wp.y);
-            worldMin.z = std::min(worldMin.z, wp.z);
-            worldMax.x = std::max(worldMax.x, wp.x);
-            worldMax.y = std::max(worldMax.y, wp.y);
-            worldMax.z = std::max(worldMax.z, wp.z);
-        }
-
-        // AABB-AABB 相交检测
-        bool intersects =
-            worldMin.x <= boundsMax.x && worldMax.x >= boundsMin.x &&
-            worldMin.y <= boundsMax.y && worldMax.y >= boundsMin.y &&
-            worldMin.z <= boundsMax.z && worldMax.z >= boundsMin.z;
-
-        if (intersects) {
-            return true;
-        }
-    }
-
-    return false;
+    // 空间索引由 BuildOctree 在构建前更新
+    // 没有 bounds 的 Mesh 在索引里是位于物体位置的点
+    SAABB query;
+    query.min = boundsMin;
+    query.max = boundsMax;
+
+    bool found = false;
+    scene.GetSpatialIndex().QueryAABB(query, SpatialCategory_Mesh, [&found](const SSpatialEntry&) {
+        found = true;
+        return false;   // 找到一个即可
+    });
+    return found;
 }
 
 // ============================================
@@ -443,11 +392,11 @@ bool CVolumetricLightmap::IsDXRBakingAvailable() const
     return ctx && ctx->SupportsRaytracing();
 }
 
-void CVolumetricLightmap::BakeAllBricks(CScene& scene, const SLightmapBakeConfig& config)
+bool CVolumetricLightmap::BakeAllBricks(CScene& scene, const SLightmapBakeConfig& config)
 {
     if (m_bricks.empty()) {
         CFFLog::Warning("[VolumetricLightmap] No bricks to bake! Call BuildOctree first.");
-        return;
+        return false;
     }
     // Determine which backend to use
     ELightmapBakeBackend backend = config.backend;
@@ -459,23 +408,211 @@ void CVolumetricLightmap::BakeAllBricks(CScene& scene, const SLightmapBakeConfig
     }
 
     // Dispatch to appropriate backend
+    bool success;
     if (backend == ELightmapBakeBackend::GPU_DXR) {
-        bakeWithGPU(scene, config);
+        success = bakeWithGPU(scene, config);
     } else {
-        bakeWithCPU(scene, config);
+        success = bakeWithCPU(scene, config);
     }
 
     // Apply dilation to fill invalid probes with data from nearby valid probes
     //dilateInvalidProbes();
+    return success;
+}
+
+// ============================================
+// CPU progressive bake: accumulation + checkpoint
+// ============================================
+// Every pass adds one independent SH estimate per voxel. The running sums
+// give the final SH (weighted by sample count) and the spread of the
+// per-pass estimates gives the variance used for early stop.
+
+namespace
+{
+    struct SVoxelBakeAccum
+    {
+        double shSum[VL_SH_COEFF_COUNT][3];     // Σ sh * samples
+        double lumSum[VL_SH_COEFF_COUNT];       // Σ per-pass luminance per coefficient
+        double lumSqSum[VL_SH_COEFF_COUNT];     // Σ (per-pass luminance)^2
+        uint32_t samples;
+        uint32_t hits;
+        uint32_t passes;
+        uint32_t reserved;
+    };
+
+    struct SBrickBakeAccum
+    {
+        SVoxelBakeAccum voxels[VL_BRICK_VOXEL_COUNT];
+        uint32_t converged;     // 1 = brick stopped taking samples
+        uint32_t reserved[3];
+    };
+
+    struct SBakeCheckpointHeader
+    {
+        uint32_t magic = 0x50434C56;  // "VLCP"
+        uint32_t version = 2;
+        uint32_t brickCount = 0;
+        uint32_t passesDone = 0;
+        int32_t samplesPerVoxel = 0;
+        int32_t samplesPerPass = 0;
+        int32_t maxBounces = 0;
+        uint32_t reserved = 0;
+        XMFLOAT3 volumeMin = {0, 0, 0};
+        XMFLOAT3 volumeMax = {0, 0, 0};
+        uint64_t sceneHash = 0;         // CPathTraceBaker::GetSceneHash(): geometry, lights, sky
+        uint64_t brickLayoutHash = 0;   // Bounds and level of every brick, in bake order
+    };
+
+    uint64_t hashBrickLayout(const std::vector<SBrick>& bricks)
+    {
+        CDerivedDataKeyBuilder builder("vl-bricks", 1);
+        builder.Add((uint32_t)bricks.size());
+        for (const SBrick& brick : bricks) {
+            builder.Add(&brick.worldMin, sizeof(XMFLOAT3));
+            builder.Add(&brick.worldMax, sizeof(XMFLOAT3));
+            builder.Add((uint32_t)brick.level);
+        }
+        return builder.Build().hash[0];
+    }
+
+    float luminance(const XMFLOAT3& c)
+    {
+        return 0.2126f * c.x + 0.7152f * c.y + 0.0722f * c.z;
+    }
+
+    void accumulateVoxel(SVoxelBakeAccum& accum, const SBakeResult& result)
+    {
+        for (int c = 0; c < VL_SH_COEFF_COUNT; c++) {
+            accum.shSum[c][0] += (double)result.sh[c].x * result.sampleCount;
+            accum.shSum[c][1] += (double)result.sh[c].y * result.sampleCount;
+            accum.shSum[c][2] += (double)result.sh[c].z * result.sampleCount;
+
+            double lum = luminance(result.sh[c]);
+            accum.lumSum[c] += lum;
+            accum.lumSqSum[c] += lum * lum;
+        }
+        accum.samples += (uint32_t)result.sampleCount;
+        accum.hits += (uint32_t)result.hitCount;
+        accum.passes++;
+    }
+
+    // Relative standard error of the mean SH (luminance), summed over coefficients
+    double relativeStdError(const SVoxelBakeAccum& accum)
+    {
+        if (accum.passes < 2) {
+            return DBL_MAX;
+        }
+        double n = accum.passes;
+        double varianceOfMean = 0.0;
+        double meanNormSq = 0.0;
+        for (int c = 0; c < VL_SH_COEFF_COUNT; c++) {
+            double mean = accum.lumSum[c] / n;
+            double variance = std::max(0.0, (accum.lumSqSum[c] - n * mean * mean) / (n - 1.0));
+            varianceOfMean += variance / n;
+            meanNormSq += mean * mean;
+        }
+        return std::sqrt(varianceOfMean) / std::max(std::sqrt(meanNormSq), 1e-4);
+    }
+
+    // Running sums -> brick SH / validity
+    void resolveBakeAccum(const std::vector<SBrickBakeAccum>& accum, std::vector<SBrick>& bricks,
+                          float validityHitThreshold)
+    {
+        for (size_t b = 0; b < bricks.size(); b++) {
+            for (int v = 0; v < VL_BRICK_VOXEL_COUNT; v++) {
+                const SVoxelBakeAccum& voxel = accum[b].voxels[v];
+                if (voxel.samples == 0) continue;
+
+                for (int c = 0; c < VL_SH_COEFF_COUNT; c++) {
+                    bricks[b].shData[v][c] = {
+                        (float)(voxel.shSum[c][0] / voxel.samples),
+                        (float)(voxel.shSum[c][1] / voxel.samples),
+                        (float)(voxel.shSum[c][2] / voxel.samples)
+                    };
+                }
+                bricks[b].validity[v] = ((float)voxel.hits / (float)voxel.samples) < validityHitThreshold;
+            }
+        }
+    }
+
+    bool saveBakeCheckpoint(const std::string& path, const SBakeCheckpointHeader& header,
+                            const std::vector<SBrickBakeAccum>& accum)
+    {
+        // Write to a temp file and rename, so a crash mid-write keeps the previous checkpoint
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary);
+            if (!file) {
+                CFFLog::Error("[VolumetricLightmap] Failed to create checkpoint: %s", tempPath.c_str());
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(accum.data()), accum.size() * sizeof(SBrickBakeAccum));
+            if (!file) {
+                CFFLog::Error("[VolumetricLightmap] Failed to write checkpoint: %s", tempPath.c_str());
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+        if (ec) {
+            CFFLog::Error("[VolumetricLightmap] Failed to replace checkpoint %s: %s", path.c_str(), ec.message().c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Returns passes done, or -1 if the file is missing or belongs to a different bake
+    int loadBakeCheckpoint(const std::string& path, const SBakeCheckpointHeader& expected,
+                           std::vector<SBrickBakeAccum>& outAccum)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return -1;
+        }
+
+        SBakeCheckpointHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != expected.magic || header.version != expected.version) {
+            CFFLog::Warning("[VolumetricLightmap] Ignoring invalid checkpoint: %s", path.c_str());
+            return -1;
+        }
+
+        if (header.brickCount != expected.brickCount ||
+            header.samplesPerVoxel != expected.samplesPerVoxel ||
+            header.samplesPerPass != expected.samplesPerPass ||
+            header.maxBounces != expected.maxBounces ||
+            memcmp(&header.volumeMin, &expected.volumeMin, sizeof(XMFLOAT3)) != 0 ||
+            memcmp(&header.volumeMax, &expected.volumeMax, sizeof(XMFLOAT3)) != 0) {
+            CFFLog::Warning("[VolumetricLightmap] Checkpoint does not match current bake settings, starting over: %s", path.c_str());
+            return -1;
+        }
+
+        if (header.sceneHash != expected.sceneHash || header.brickLayoutHash != expected.brickLayoutHash) {
+            CFFLog::Warning("[VolumetricLightmap] Scene or brick layout changed since checkpoint, starting over: %s", path.c_str());
+            return -1;
+        }
+
+        std::vector<SBrickBakeAccum> accum(header.brickCount);
+        file.read(reinterpret_cast<char*>(accum.data()), accum.size() * sizeof(SBrickBakeAccum));
+        if (!file) {
+            CFFLog::Warning("[VolumetricLightmap] Truncated checkpoint, starting over: %s", path.c_str());
+            return -1;
+        }
+
+        outAccum = std::move(accum);
+        return (int)header.passesDone;
+    }
 }
 
-void CVolumetricLightmap::bakeWithCPU(CScene& scene, const SLightmapBakeConfig& config)
+bool CVolumetricLightmap::bakeWithCPU(CScene& scene, const SLightmapBakeConfig& config)
 {
     if (m_bricks.empty()) {
         CFFLog::Warning("[VolumetricLightmap] No bricks to bake! Call BuildOctree first.");
-        return;
+        return false;
     }
-    // 创建 Path Trace Baker
+    // 创建 Path Trace Baker（所有线程共享，只读）
     SPathTraceConfig ptConfig;
     ptConfig.samplesPerVoxel = config.cpuSamplesPerVoxel;
     ptConfig.maxBounces = config.cpuMaxBounces;
@@ -484,21 +621,58 @@ void CVolumetricLightmap::bakeWithCPU(CScene& scene, const SLightmapBakeConfig&
     CPathTraceBaker baker;
     if (!baker.Initialize(scene, ptConfig)) {
         CFFLog::Error("[VolumetricLightmap] Failed to initialize PathTraceBaker!");
-        return;
+        return false;
     }
 
+    auto& jobs = CJobSystem::Instance();
+    const uint32_t threadCount = jobs.IsInitialized() ? jobs.GetThreadCount() : 1;
+
     int totalBricks = (int)m_bricks.size();
     int totalVoxels = totalBricks * VL_BRICK_VOXEL_COUNT;
 
+    // Pass layout (single pass unless cpuSamplesPerPass splits the budget)
+    const int totalSamples = std::max(1, config.cpuSamplesPerVoxel);
+    const int samplesPerPass = (config.cpuSamplesPerPass > 0) ? std::min(config.cpuSamplesPerPass, totalSamples) : totalSamples;
+    const int passCount = (totalSamples + samplesPerPass - 1) / samplesPerPass;
+    const bool useCheckpoint = !config.checkpointPath.empty();
+
+    SBakeCheckpointHeader checkpointHeader;
+    checkpointHeader.brickCount = (uint32_t)totalBricks;
+    checkpointHeader.samplesPerVoxel = totalSamples;
+    checkpointHeader.samplesPerPass = samplesPerPass;
+    checkpointHeader.maxBounces = config.cpuMaxBounces;
+    checkpointHeader.volumeMin = m_config.volumeMin;
+    checkpointHeader.volumeMax = m_config.volumeMax;
+    checkpointHeader.sceneHash = baker.GetSceneHash();
+    checkpointHeader.brickLayoutHash = hashBrickLayout(m_bricks);
+
+    std::vector<SBrickBakeAccum> accum(totalBricks);
+    memset(accum.data(), 0, accum.size() * sizeof(SBrickBakeAccum));
+
+    int startPass = 0;
+    if (useCheckpoint && config.resumeFromCheckpoint) {
+        int passesDone = loadBakeCheckpoint(config.checkpointPath, checkpointHeader, accum);
+        if (passesDone > 0) {
+            startPass = std::min(passesDone, passCount);
+            CFFLog::Info("[VolumetricLightmap] Resuming from checkpoint: %d/%d passes done (%s)",
+                         startPass, passCount, config.checkpointPath.c_str());
+        }
+    }
+
     // 计算合适的进度打印间隔
-    int progressInterval = std::max(1, totalBricks / 20);
+    int progressInterval = std::max(1, totalVoxels / 20);
 
     CFFLog::Info("[VolumetricLightmap] ========================================");
     CFFLog::Info("[VolumetricLightmap] Starting CPU Path Trace bake...");
     CFFLog::Info("[VolumetricLightmap]   Total Bricks: %d", totalBricks);
     CFFLog::Info("[VolumetricLightmap]   Total Voxels: %d (%d per brick)", totalVoxels, VL_BRICK_VOXEL_COUNT);
-    CFFLog::Info("[VolumetricLightmap]   Samples per voxel: %d", ptConfig.samplesPerVoxel);
+    CFFLog::Info("[VolumetricLightmap]   Samples per voxel: %d (%d pass(es) of %d)", totalSamples, passCount, samplesPerPass);
     CFFLog::Info("[VolumetricLightmap]   Max bounces: %d", ptConfig.maxBounces);
+    CFFLog::Info("[VolumetricLightmap]   Threads: %u", threadCount);
+    if (config.cpuConvergenceThreshold > 0.0f) {
+        CFFLog::Info("[VolumetricLightmap]   Early stop: rel. std error < %.3f after %d passes",
+                     config.cpuConvergenceThreshold, std::max(2, config.cpuMinPasses));
+    }
     CFFLog::Info("[VolumetricLightmap]   Volume: (%.1f, %.1f, %.1f) to (%.1f, %.1f, %.1f)",
                  m_config.volumeMin.x, m_config.volumeMin.y, m_config.volumeMin.z,
                  m_config.volumeMax.x, m_config.volumeMax.y, m_config.volumeMax.z);
@@ -506,30 +680,122 @@ void CVolumetricLightmap::bakeWithCPU(CScene& scene, const SLightmapBakeConfig&
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    for (size_t i = 0; i < m_bricks.size(); i++)
-    {
-        bakeBrick(m_bricks[i], scene, baker);
+    // 每个体素每个 pass 一个独立 RNG 流（按 brick/voxel/pass 索引），结果与线程数、调度顺序无关
+    auto isCancelled = [&config]() {
+        return config.cancelFlag && config.cancelFlag->load(std::memory_order_relaxed);
+    };
+
+    std::atomic<int64_t> busyNs{0};   // Summed job time, for scaling efficiency
+    int64_t voxelSamplesBaked = 0;    // Samples taken this session, for throughput
+    int64_t voxelPassesBaked = 0;     // bakeVoxel calls this session
+    bool cancelled = false;
+
+    for (int pass = startPass; pass < passCount && !cancelled; pass++) {
+        const int passSamples = std::min(samplesPerPass, totalSamples - pass * samplesPerPass);
 
-        // Progress callback
-        if (config.progressCallback) {
-            float progress = static_cast<float>(i + 1) / static_cast<float>(totalBricks);
-            config.progressCallback(progress);
+        // Only bricks that have not converged take more samples
+        std::vector<int> activeBricks;
+        for (int b = 0; b < totalBricks; b++) {
+            if (!accum[b].converged) activeBricks.push_back(b);
+        }
+        if (activeBricks.empty()) {
+            break;
         }
 
-        // 进度日志
-        bool shouldPrint = (i + 1) % progressInterval == 0 || i == m_bricks.size() - 1;
-        if (shouldPrint)
-        {
-            auto now = std::chrono::high_resolution_clock::now();
-            float elapsedSec = std::chrono::duration<float>(now - startTime).count();
-            float progressPercent = 100.0f * (i + 1) / totalBricks;
+        const int passVoxels = (int)activeBricks.size() * VL_BRICK_VOXEL_COUNT;
+        std::atomic<int> voxelsDone{0};
+
+        const uint32_t voxelsPerJob = 8;
+        CJobCounter counter;
+        for (uint32_t begin = 0; begin < (uint32_t)passVoxels; begin += voxelsPerJob) {
+            uint32_t end = std::min((uint32_t)passVoxels, begin + voxelsPerJob);
+            jobs.Run([this, &baker, &accum, &activeBricks, &voxelsDone, &busyNs, isCancelled,
+                      pass, passSamples, begin, end]() {
+                auto jobStart = std::chrono::high_resolution_clock::now();
+                for (uint32_t v = begin; v < end; v++) {
+                    if (isCancelled()) break;
+                    int brickIndex = activeBricks[v / VL_BRICK_VOXEL_COUNT];
+                    int voxelIndex = (int)(v % VL_BRICK_VOXEL_COUNT);
+                    SBakeResult result = bakeVoxel(brickIndex, voxelIndex, pass, passSamples, baker);
+                    // 每个体素每个 pass 只由一个 job 写入
+                    accumulateVoxel(accum[brickIndex].voxels[voxelIndex], result);
+                    voxelsDone.fetch_add(1, std::memory_order_relaxed);
+                }
+                auto jobEnd = std::chrono::high_resolution_clock::now();
+                busyNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(jobEnd - jobStart).count(),
+                                 std::memory_order_relaxed);
+            }, &counter);
+        }
+
+        // 主线程：参与执行 + 进度回调 / 日志（回调只在调用线程上触发）
+        int lastReported = 0;
+        int lastLogged = 0;
+        while (true) {
+            bool finished = counter.IsDone();
+            if (!finished && !jobs.TryExecuteOne()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            int done = voxelsDone.load(std::memory_order_relaxed);
+            if (done != lastReported) {
+                lastReported = done;
+                if (config.progressCallback) {
+                    float passProgress = static_cast<float>(done) / static_cast<float>(passVoxels);
+                    config.progressCallback((pass + passProgress) / passCount);
+                }
+            }
+
+            // 进度日志
+            if (done - lastLogged >= progressInterval || (finished && done != lastLogged)) {
+                lastLogged = done;
+                auto now = std::chrono::high_resolution_clock::now();
+                float elapsedSec = std::chrono::duration<float>(now - startTime).count();
+                CFFLog::Info("[VolumetricLightmap] Pass %d/%d: %d/%d voxels (%.1f%%) | Elapsed: %.1fs",
+                             pass + 1, passCount, done, passVoxels, 100.0f * done / passVoxels, elapsedSec);
+            }
+
+            if (finished) break;
+        }
 
-            float estimatedTotalTime = (elapsedSec / (i + 1)) * totalBricks;
-            float remainingSec = estimatedTotalTime - elapsedSec;
+        voxelPassesBaked += voxelsDone.load();
+        voxelSamplesBaked += (int64_t)voxelsDone.load() * passSamples;
+        if (isCancelled()) {
+            // The partial pass is dropped: bricks and checkpoint keep the last full pass
+            cancelled = true;
+            break;
+        }
 
-            CFFLog::Info("[VolumetricLightmap] Progress: %d/%d bricks (%.1f%%) | Elapsed: %.1fs | ETA: %.1fs",
-                         (int)(i + 1), totalBricks, progressPercent, elapsedSec, remainingSec);
+        // Convergence (per brick: worst voxel)
+        int newlyConverged = 0;
+        if (config.cpuConvergenceThreshold > 0.0f && pass + 1 >= std::max(2, config.cpuMinPasses)) {
+            for (int b : activeBricks) {
+                double worst = 0.0;
+                for (const auto& voxel : accum[b].voxels) {
+                    worst = std::max(worst, relativeStdError(voxel));
+                }
+                if (worst < config.cpuConvergenceThreshold) {
+                    accum[b].converged = 1;
+                    newlyConverged++;
+                }
+            }
         }
+
+        resolveBakeAccum(accum, m_bricks, baker.GetConfig().validityHitThreshold);
+
+        if (useCheckpoint) {
+            checkpointHeader.passesDone = (uint32_t)(pass + 1);
+            saveBakeCheckpoint(config.checkpointPath, checkpointHeader, accum);
+        }
+
+        auto now = std::chrono::high_resolution_clock::now();
+        float elapsedSec = std::chrono::duration<float>(now - startTime).count();
+        CFFLog::Info("[VolumetricLightmap] Pass %d/%d done: %d active bricks, %d converged this pass | %.1fs",
+                     pass + 1, passCount, (int)activeBricks.size(), newlyConverged, elapsedSec);
+    }
+
+    // Resumed with every pass already done: just resolve the saved sums
+    if (startPass >= passCount) {
+        resolveBakeAccum(accum, m_bricks, baker.GetConfig().validityHitThreshold);
     }
 
     auto endTime = std::chrono::high_resolution_clock::now();
@@ -537,17 +803,55 @@ void CVolumetricLightmap::bakeWithCPU(CScene& scene, const SLightmapBakeConfig&
 
     baker.Shutdown();
 
+    if (cancelled) {
+        CFFLog::Warning("[VolumetricLightmap] CPU bake cancelled (%.2f s)%s", totalElapsedSec,
+                        useCheckpoint ? ", resume from checkpoint to continue" : "");
+        return false;
+    }
+
+    if (useCheckpoint) {
+        std::error_code ec;
+        std::filesystem::remove(config.checkpointPath, ec);
+    }
+    if (config.progressCallback) {
+        config.progressCallback(1.0f);   // Also when every brick converged early
+    }
+
+    int convergedBricks = 0;
+    int64_t totalVoxelSamples = 0;
+    for (const auto& brick : accum) {
+        convergedBricks += brick.converged ? 1 : 0;
+        for (const auto& voxel : brick.voxels) {
+            totalVoxelSamples += voxel.samples;
+        }
+    }
+
+    // Scaling: busy = summed time inside bake jobs
+    //   speedup    ~= busy / wall      (how many threads were effectively baking)
+    //   efficiency  = speedup / threads
+    double busySec = busyNs.load() * 1e-9;
+    double speedup = (totalElapsedSec > 0.0f) ? busySec / totalElapsedSec : 0.0;
+    double efficiency = speedup / threadCount;
+    double voxelPassesPerSec = (totalElapsedSec > 0.0f) ? (double)voxelSamplesBaked / totalSamples / totalElapsedSec : 0.0;
+
     CFFLog::Info("[VolumetricLightmap] ========================================");
     CFFLog::Info("[VolumetricLightmap] CPU Path Trace bake complete!");
-    CFFLog::Info("[VolumetricLightmap]   Bricks baked: %d", totalBricks);
+    CFFLog::Info("[VolumetricLightmap]   Bricks baked: %d (%d converged early)", totalBricks, convergedBricks);
     CFFLog::Info("[VolumetricLightmap]   Voxels baked: %d", totalVoxels);
+    CFFLog::Info("[VolumetricLightmap]   Samples taken: %.1f%% of budget",
+                 100.0 * totalVoxelSamples / ((double)totalVoxels * totalSamples));
     CFFLog::Info("[VolumetricLightmap]   Total time: %.2f seconds", totalElapsedSec);
-    CFFLog::Info("[VolumetricLightmap]   Avg per brick: %.3f ms", (totalElapsedSec * 1000.0f) / totalBricks);
-    CFFLog::Info("[VolumetricLightmap]   Avg per voxel: %.3f ms", (totalElapsedSec * 1000.0f) / totalVoxels);
+    CFFLog::Info("[VolumetricLightmap]   Throughput: %.1f voxels/s (%.1f voxels/s per thread, full sample budget)",
+                 voxelPassesPerSec, voxelPassesPerSec / threadCount);
+    CFFLog::Info("[VolumetricLightmap]   Threads: %u | speedup %.2fx | scaling efficiency %.0f%%",
+                 threadCount, speedup, efficiency * 100.0);
+    CFFLog::Info("[VolumetricLightmap]   Avg per voxel pass: %.3f ms (thread time)",
+                 busySec * 1000.0 / std::max<int64_t>(1, voxelPassesBaked));
     CFFLog::Info("[VolumetricLightmap] ========================================");
+    return true;
 }
 
-void CVolumetricLightmap::bakeWithGPU(CScene& scene, const SLightmapBakeConfig& config)
+bool CVolumetricLightmap::bakeWithGPU(CScene& scene, const SLightmapBakeConfig& config)
 {
     CFFLog::Info("[VolumetricLightmap] ========================================");
     CFFLog::Info("[VolumetricLightmap] Starting GPU DXR cubemap bake...");
@@ -564,7 +868,7 @@ void CVolumetricLightmap::bakeWithGPU(CScene& scene, const SLightmapBakeConfig&
     if (!m_dxrBaker->IsReady()) {
         if (!m_dxrBaker->Initialize()) {
             CFFLog::Error("[VolumetricLightmap] Failed to initialize DXR baker");
-            return;
+            return false;
         }
     }
 
@@ -578,7 +882,7 @@ void CVolumetricLightmap::bakeWithGPU(CScene& scene, const SLightmapBakeConfig&
     // Run DXR bake
     if (!m_dxrBaker->BakeVolumetricLightmap(*this, scene, dxrConfig)) {
         CFFLog::Error("[VolumetricLightmap] DXR bake failed");
-        return;
+        return false;
     }
 
     // Phase 2: Dispatch bake for all voxels
@@ -589,52 +893,29 @@ void CVolumetricLightmap::bakeWithGPU(CScene& scene, const SLightmapBakeConfig&
 
     if (!success) {
         CFFLog::Error("[VolumetricLightmap] GPU bake dispatch failed");
-        return;
+        return false;
     }
     CFFLog::Info("[VolumetricLightmap] ========================================");
     CFFLog::Info("[VolumetricLightmap] GPU DXR cubemap bake complete!");
     CFFLog::Info("[VolumetricLightmap] ========================================");
+    return true;
 }
 
-void CVolumetricLightmap::bakeBrick(SBrick& brick, CScene& scene, CPathTraceBaker& baker)
+SBakeResult CVolumetricLightmap::bakeVoxel(int brickIndex, int voxelIndex, int pass, int sampleCount,
+                                           const CPathTraceBaker& baker) const
 {
-    XMFLOAT3 brickSize = {
-        brick.worldMax.x - brick.worldMin.x,
-        brick.worldMax.y - brick.worldMin.y,
-        brick.worldMax.z - brick.worldMin.z
-    };
-
-    // 对每个体素位置烘焙 SH
-    // 使用 Overlap Baking：voxel[0] brick 边缘，voxel[3] 在另一边缘
-    // 这样相邻 Brick 的边缘体素采样同一个世界位置，实现 C0 连续性
-    for (int z = 0; z < VL_BRICK_SIZE; z++)
-    for (int y = 0; y < VL_BRICK_SIZE; y++)
-    for (int x = 0; x < VL_BRICK_SIZE; x++)
-    {
-        // Overlap Baking: 体素位置从边缘到边缘
-        // voxel[0] -> t=0.0 (brick.worldMin)
-        // voxel[3] -> t=1.0 (brick.worldMax)
-        // 中间体素均匀分布
-        float tx = (float)x / (VL_BRICK_SIZE - 1);  // 0, 1/3, 2/3, 1
-        float ty = (float)y / (VL_BRICK_SIZE - 1);
-        float tz = (float)z / (VL_BRICK_SIZE - 1);
-
-        XMFLOAT3 voxelPos = {
-            brick.worldMin.x + tx * brickSize.x,
-            brick.worldMin.y + ty * brickSize.y,
-            brick.worldMin.z + tz * brickSize.z
-        };
-
-        // 使用 Path Tracing 烘焙 SH，并获取 validity
-        SBakeResult result = baker.BakeVoxelWithValidity(voxelPos, scene);
-
-        // 存储 SH 系数和 validity
-        int voxelIndex = SBrick::VoxelIndex(x, y, z);
-        for (int c = 0; c < VL_SH_COEFF_COUNT; c++) {
-            brick.shData[voxelIndex][c] = result.sh[c];
-        }
-        brick.validity[voxelIndex] = result.isValid;
-    }
+    const SBrick& brick = m_bricks[brickIndex];
+
+    // Overlap Baking: 体素位置从边缘到边缘
+    // voxel[0] -> t=0.0 (brick.worldMin), voxel[3] -> t=1.0 (brick.worldMax)
+    // 相邻 Brick 的边缘体素采样同一个世界位置，实现 C0 连续性
+    int x, y, z;
+    SBrick::IndexToVoxel(voxelIndex, x, y, z);
+    XMFLOAT3 voxelPos = getVoxelWorldPosition(brick, x, y, z);
+
+    // 使用 Path Tracing 烘焙 SH，并获取 validity
+    SBakeRandom rng(SBakeRandom::MakeKey((uint32_t)brickIndex, (uint32_t)voxelIndex, (uint32_t)pass));
+    return baker.BakeVoxelWithValidity(voxelPos, rng, sampleCount);
 }
 
 // ============================================
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <atomic>
 
 // Forward declarations
 namespace RHI {
@@ -19,6 +20,7 @@ namespace RHI {
 class CScene;
 class CPathTraceBaker;
 struct SPathTraceConfig;
+struct SBakeResult;
 class CDXRCubemapBaker;
 
 // ============================================
@@ -51,8 +53,29 @@ struct SLightmapBakeConfig {
     int gpuMaxBounces = 3;
     float gpuSkyIntensity = 1.0f;
 
-    // Progress callback (0.0 to 1.0)
+    // Progress callback (0.0 to 1.0), always called on the thread that started the bake
     std::function<void(float)> progressCallback = nullptr;
+
+    // CPU backend: set to true (from any thread or from progressCallback) to abort the bake.
+    // Checked between voxels; bricks keep the result of the last completed pass.
+    std::atomic<bool>* cancelFlag = nullptr;
+
+    // CPU progressive bake: cpuSamplesPerVoxel is split into passes of cpuSamplesPerPass
+    // samples (0 = one pass). Each voxel accumulates SH across passes.
+    int cpuSamplesPerPass = 0;
+
+    // Checkpoint written after every pass (empty = none). If resumeFromCheckpoint and the
+    // file matches, the bake continues after the last saved pass. Matches = same brick count
+    // and layout (bounds + level of every brick), samples per voxel / pass, bounces, volume
+    // bounds, and the same scene content hash (exported geometry, materials, lights, sky).
+    // Otherwise the file is ignored and the bake starts over. Deleted when the bake completes.
+    std::string checkpointPath;
+    bool resumeFromCheckpoint = true;
+
+    // Early stop: a brick stops taking samples once the relative standard error of its
+    // per-pass SH estimates is below this for every voxel (0 = off, e.g. 0.02 = 2%)
+    float cpuConvergenceThreshold = 0.0f;
+    int cpuMinPasses = 2;   // Passes before a brick can converge (variance needs >= 2)
 };
 
 // ============================================
@@ -253,7 +276,8 @@ public:
 
     // Step 2: 烘焙所有 Brick 的 SH（耗时操作）
     // Uses CPU or GPU backend based on config (auto-fallback if DXR unavailable)
-    void BakeAllBricks(CScene& scene, const SLightmapBakeConfig& config = {});
+    // Returns false if the bake failed or was cancelled
+    bool BakeAllBricks(CScene& scene, const SLightmapBakeConfig& config = {});
 
     // Check if DXR baking is available
     bool IsDXRBakingAvailable() const;
@@ -335,7 +359,8 @@ private:
                     const DirectX::XMFLOAT3& boundsMax,
                     int level);
     bool allocateBrickInAtlas(SBrick& brick);
-    void bakeBrick(SBrick& brick, CScene& scene, CPathTraceBaker& baker);
+    SBakeResult bakeVoxel(int brickIndex, int voxelIndex, int pass, int sampleCount,
+                          const CPathTraceBaker& baker) const;
 
     // ============================================
     // Probe Dilation (leak prevention)
@@ -417,6 +442,6 @@ private:
     std::unique_ptr<CDXRCubemapBaker> m_dxrBaker;
 
     // Backend-specific baking
-    void bakeWithCPU(CScene& scene, const SLightmapBakeConfig& config);
-    void bakeWithGPU(CScene& scene, const SLightmapBakeConfig& config);
+    bool bakeWithCPU(CScene& scene, const SLightmapBakeConfig& config);
+    bool bakeWithGPU(CScene& scene, const SLightmapBakeConfig& config);
 };
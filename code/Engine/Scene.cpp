@@ -6,7 +6,10 @@
 #include "Components/MeshRenderer.h"
 #include "Components/DirectionalLight.h"
 #include "SceneSerializer.h"
+#include "Core/Loader/GltfLoader.h"
 #include <imgui.h>
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <sstream>
 #include <iomanip>
@@ -349,6 +352,61 @@ CGameObject* CScene::PasteGameObject() {
     return newGo;
 }
 
+// ===========================
+// Import Model
+// ===========================
+CGameObject* CScene::ImportModel(const std::string& path) {
+    std::string name = std::filesystem::path(path).stem().string();
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+    if (ext != ".gltf" && ext != ".glb") {
+        CGameObject* go = m_world.Create(name);
+        go->AddComponent<STransform>();
+        go->AddComponent<SMeshRenderer>()->path = path;
+        return go;
+    }
+
+    // Node and mesh tables only: geometry is imported (and cooked) by the mesh renderers
+    SGltfSceneCPU model;
+    SGltfLoadOptions options;
+    options.loadGeometry = false;
+    if (!LoadGLTFScene(path, model, options)) {
+        CFFLog::Error("[Scene] Failed to import model: %s", path.c_str());
+        return nullptr;
+    }
+
+    CGameObject* root = m_world.Create(name);
+    STransform* rootTransform = root->AddComponent<STransform>();
+
+    std::vector<STransform*> transforms(model.nodes.size(), nullptr);
+    uint32_t instances = 0;
+    for (size_t i = 0; i < model.nodes.size(); i++) {
+        const SGltfNode& node = model.nodes[i];
+        CGameObject* go = m_world.Create(node.name.empty() ? name + "_" + std::to_string(i) : node.name);
+
+        STransform* transform = go->AddComponent<STransform>();
+        transform->position = node.translation;
+        transform->rotation = node.rotation;
+        transform->scale = node.scale;
+        transform->SetParent(node.parent >= 0 ? transforms[node.parent] : rootTransform, /*keepWorldTransform*/false);
+        transforms[i] = transform;
+
+        if (node.mesh >= 0 && model.meshes[node.mesh].primitiveCount > 0) {
+            const SGltfMeshRange& range = model.meshes[node.mesh];
+            auto* meshRenderer = go->AddComponent<SMeshRenderer>();
+            meshRenderer->path = path;
+            meshRenderer->subMeshFirst = (int)range.firstPrimitive;
+            meshRenderer->subMeshCount = (int)range.primitiveCount;
+            instances++;
+        }
+    }
+
+    CFFLog::Info("[Scene] Imported %s: %zu nodes, %u mesh instances of %zu meshes",
+                 path.c_str(), model.nodes.size(), instances, model.meshes.size());
+    return root;
+}
+
 // ===========================
 // Duplicate GameObject (Copy + Paste)
 // ===========================
@@ -2,12 +2,15 @@
 #include <cstddef>
 #include <string>
 #include "World.h"
+#include "SpatialIndex.h"
+#include "TransformSystem.h"
 #include "Rendering/Skybox.h"
 #include "Rendering/ReflectionProbeManager.h"
 #include "Rendering/LightProbeManager.h"
 #include "Rendering/VolumetricLightmap.h"
 #include "Rendering/Lightmap/Lightmap2DManager.h"
 #include "Rendering/Lightmap/LightmapBaker.h"
+#include "Rendering/RenderProxy.h"
 #include "SceneLightSettings.h"
 #include "Camera.h"
 
@@ -51,6 +54,17 @@ public:
     CWorld& GetWorld() { return m_world; }
     const CWorld& GetWorld() const { return m_world; }
 
+    // Render proxies (cached world matrices / bounds / materials, see CRenderProxyTable)
+    CRenderProxyTable& GetRenderProxies() { return m_renderProxies; }
+    const CRenderProxyTable& GetRenderProxies() const { return m_renderProxies; }
+
+    // Spatial index over world objects (call Update(GetWorld()) before querying)
+    CSceneSpatialIndex& GetSpatialIndex() { return m_spatialIndex; }
+    const CSceneSpatialIndex& GetSpatialIndex() const { return m_spatialIndex; }
+
+    // Once-per-frame world matrix update (hierarchy order, previous-frame matrices)
+    CTransformSystem& GetTransformSystem() { return m_transformSystem; }
+
     // Selection
     int GetSelected() const { return m_selected; }
     void SetSelected(int index) { m_selected = index; }
@@ -100,6 +114,13 @@ public:
     bool HasFilePath() const { return !m_filePath.empty(); }
     const std::string& GetLightmapPath() const { return m_lightmapPath; }
 
+    // Model import: one GameObject per glTF node under a root named after the
+    // file, parented like the file with the node's local TRS. Nodes sharing a
+    // mesh share its GPU resources (SMeshRenderer sub-mesh range), nothing is
+    // baked or duplicated. Other mesh files become a single object.
+    // Returns the root, nullptr if the file cannot be read.
+    CGameObject* ImportModel(const std::string& path);
+
     // Copy/Paste/Duplicate operations (for Hierarchy panel)
     void CopyGameObject(CGameObject* go);     // Copy to clipboard (JSON)
     CGameObject* PasteGameObject();           // Paste from clipboard
@@ -112,6 +133,9 @@ private:
 
 private:
     CWorld m_world;
+    CRenderProxyTable m_renderProxies;
+    CSceneSpatialIndex m_spatialIndex;
+    CTransformSystem m_transformSystem;
     int m_selected = -1;
     std::string m_filePath;  // Current scene file path
     std::string m_lightmapPath;  // Current scene file path
@@ -5,6 +5,7 @@
 // Place at: E:\forfun\thirdparty\nlohmann\json.hpp
 
 #include "SceneSerializer.h"
+#include "FFSceneFile.h"
 #include "Scene.h"
 #include "SceneLightSettings.h"  // EDiffuseGIMode
 #include "World.h"
@@ -17,8 +18,13 @@
 #include "Components/DirectionalLight.h"  // SDirectionalLight
 
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <unordered_map>
 
 using json = nlohmann::json;
 
@@ -171,21 +177,49 @@ static CComponent* DeserializeComponent(CGameObject* go, const json& j) {
 }
 
 // ===========================
-// Save CScene
+// Clear World
 // ===========================
-bool CSceneSerializer::SaveScene(const CScene& scene, const std::string& filepath) {
+static void ClearWorld(CWorld& world) {
+    // Back to front: no vector shifting, children usually go before their parents
+    while (world.Count() > 0) {
+        world.Destroy(world.Count() - 1);
+    }
+}
+
+// ===========================
+// Save JSON
+// ===========================
+static bool SaveJsonScene(const CWorld& world, const CSceneLightSettings& lightSettings, const std::string& filepath) {
     try {
         json j;
         j["version"] = "1.0";
         j["gameObjects"] = json::array();
 
+        // Object index of each transform, used to store parent links
+        std::unordered_map<const STransform*, int> transformIndex;
+        for (std::size_t i = 0; i < world.Count(); ++i) {
+            auto* go = world.Get(i);
+            if (go && go->GetComponent<STransform>()) {
+                transformIndex[go->GetComponent<STransform>()] = (int)i;
+            }
+        }
+
         // Serialize all GameObjects
-        for (std::size_t i = 0; i < scene.GetWorld().Count(); ++i) {
-            auto* go = scene.GetWorld().Get(i);
+        for (std::size_t i = 0; i < world.Count(); ++i) {
+            auto* go = world.Get(i);
             if (!go) continue;
 
             json goJson;
             goJson["name"] = go->GetName();
+
+            // Parent link (index into gameObjects), local TRS is stored in the Transform
+            auto* transform = go->GetComponent<STransform>();
+            if (transform && transform->GetParent()) {
+                auto it = transformIndex.find(transform->GetParent());
+                if (it != transformIndex.end()) {
+                    goJson["parent"] = it->second;
+                }
+            }
             goJson["components"] = json::array();
 
             // Serialize all components automatically using ForEachComponent
@@ -200,12 +234,12 @@ bool CSceneSerializer::SaveScene(const CScene& scene, const std::string& filepat
 
         // Serialize light settings
         json settingsJson;
-        settingsJson["skyboxAssetPath"] = scene.GetLightSettings().skyboxAssetPath;
-        settingsJson["diffuseGIMode"] = static_cast<int>(scene.GetLightSettings().diffuseGIMode);
-        settingsJson["gBufferDebugMode"] = static_cast<int>(scene.GetLightSettings().gBufferDebugMode);
+        settingsJson["skyboxAssetPath"] = lightSettings.skyboxAssetPath;
+        settingsJson["diffuseGIMode"] = static_cast<int>(lightSettings.diffuseGIMode);
+        settingsJson["gBufferDebugMode"] = static_cast<int>(lightSettings.gBufferDebugMode);
 
         // Serialize Volumetric Lightmap config
-        const auto& vlConfig = scene.GetLightSettings().volumetricLightmap;
+        const auto& vlConfig = lightSettings.volumetricLightmap;
         json vlJson;
         vlJson["volumeMin"] = { vlConfig.volumeMin.x, vlConfig.volumeMin.y, vlConfig.volumeMin.z };
         vlJson["volumeMax"] = { vlConfig.volumeMax.x, vlConfig.volumeMax.y, vlConfig.volumeMax.z };
@@ -223,8 +257,6 @@ bool CSceneSerializer::SaveScene(const CScene& scene, const std::string& filepat
 
         file << j.dump(2); // Pretty print with 2 spaces
         file.close();
-
-        CFFLog::Info("Scene saved to: %s", filepath.c_str());
         return true;
 
     } catch (const std::exception& e) {
@@ -234,11 +266,10 @@ bool CSceneSerializer::SaveScene(const CScene& scene, const std::string& filepat
 }
 
 // ===========================
-// Load CScene
+// Load JSON
 // ===========================
-bool CSceneSerializer::LoadScene(CScene& scene, const std::string& filepath) {
+static bool LoadJsonScene(CWorld& world, CSceneLightSettings& lightSettings, const std::string& filepath) {
     try {
-        scene.SetFilePath(filepath);
         // Read file
         std::ifstream file(filepath);
         if (!file.is_open()) {
@@ -250,29 +281,26 @@ bool CSceneSerializer::LoadScene(CScene& scene, const std::string& filepath) {
         file >> j;
         file.close();
 
-        // Clear existing CScene
-        while (scene.GetWorld().Count() > 0) {
-            scene.GetWorld().Destroy(0);
-        }
-        scene.SetSelected(-1);
+        // Clear existing objects
+        ClearWorld(world);
 
         // Load light settings (just deserialize, don't apply - CScene::LoadFromFile handles that)
         if (j.contains("lightSettings")) {
             const auto& settingsJson = j["lightSettings"];
             if (settingsJson.contains("skyboxAssetPath")) {
-                scene.GetLightSettings().skyboxAssetPath = settingsJson["skyboxAssetPath"].get<std::string>();
+                lightSettings.skyboxAssetPath = settingsJson["skyboxAssetPath"].get<std::string>();
             }
             if (settingsJson.contains("diffuseGIMode")) {
-                scene.GetLightSettings().diffuseGIMode = static_cast<EDiffuseGIMode>(settingsJson["diffuseGIMode"].get<int>());
+                lightSettings.diffuseGIMode = static_cast<EDiffuseGIMode>(settingsJson["diffuseGIMode"].get<int>());
             }
             if (settingsJson.contains("gBufferDebugMode")) {
-                scene.GetLightSettings().gBufferDebugMode = static_cast<EGBufferDebugMode>(settingsJson["gBufferDebugMode"].get<int>());
+                lightSettings.gBufferDebugMode = static_cast<EGBufferDebugMode>(settingsJson["gBufferDebugMode"].get<int>());
             }
 
             // Load Volumetric Lightmap config
             if (settingsJson.contains("volumetricLightmap")) {
                 const auto& vlJson = settingsJson["volumetricLightmap"];
-                auto& vlConfig = scene.GetLightSettings().volumetricLightmap;
+                auto& vlConfig = lightSettings.volumetricLightmap;
 
                 if (vlJson.contains("volumeMin") && vlJson["volumeMin"].is_array() && vlJson["volumeMin"].size() == 3) {
                     vlConfig.volumeMin.x = vlJson["volumeMin"][0].get<float>();
@@ -297,7 +325,7 @@ bool CSceneSerializer::LoadScene(CScene& scene, const std::string& filepath) {
         if (j.contains("gameObjects") && j["gameObjects"].is_array()) {
             for (const auto& goJson : j["gameObjects"]) {
                 std::string name = goJson.value("name", "GameObject");
-                auto* go = scene.GetWorld().Create(name);
+                auto* go = world.Create(name);
 
                 // Load components
                 if (goJson.contains("components") && goJson["components"].is_array()) {
@@ -306,9 +334,21 @@ bool CSceneSerializer::LoadScene(CScene& scene, const std::string& filepath) {
                     }
                 }
             }
-        }
 
-        CFFLog::Info("Scene loaded from: %s", filepath.c_str());
+            // Resolve parent links once every object exists (Transform values are local)
+            const auto& gameObjects = j["gameObjects"];
+            for (std::size_t i = 0; i < gameObjects.size() && i < world.Count(); ++i) {
+                if (!gameObjects[i].contains("parent")) continue;
+                int parentIndex = gameObjects[i]["parent"].get<int>();
+                if (parentIndex < 0 || parentIndex >= (int)world.Count()) continue;
+
+                auto* transform = world.Get(i)->GetComponent<STransform>();
+                auto* parent = world.Get(parentIndex)->GetComponent<STransform>();
+                if (transform && parent && !transform->SetParent(parent, false)) {
+                    CFFLog::Warning("Ignoring cyclic parent link on object %d", (int)i);
+                }
+            }
+        }
         return true;
 
     } catch (const std::exception& e) {
@@ -317,6 +357,82 @@ bool CSceneSerializer::LoadScene(CScene& scene, const std::string& filepath) {
     }
 }
 
+// ===========================
+// Load .ffscene
+// ===========================
+static bool LoadBinaryScene(CWorld& world, CSceneLightSettings& lightSettings, const std::string& filepath) {
+    CFFSceneFile file;
+    if (!file.Open(filepath)) {
+        CFFLog::Error("Failed to open scene file: %s", filepath.c_str());
+        return false;
+    }
+
+    ClearWorld(world);
+    file.ReadLightSettings(lightSettings);
+    file.Instantiate(world);
+    return true;
+}
+
+// ===========================
+// Save / Load World
+// ===========================
+bool CSceneSerializer::IsBinaryScenePath(const std::string& filepath) {
+    std::string ext = std::filesystem::path(filepath).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return ext == ".ffscene";
+}
+
+bool CSceneSerializer::SaveWorld(const CWorld& world, const CSceneLightSettings& settings, const std::string& filepath) {
+    auto start = std::chrono::steady_clock::now();
+    bool ok = IsBinaryScenePath(filepath) ? WriteFFScene(filepath, world, settings)
+                                          : SaveJsonScene(world, settings, filepath);
+    if (!ok) return false;
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::error_code ec;
+    uintmax_t bytes = std::filesystem::file_size(filepath, ec);
+    CFFLog::Info("Scene saved to: %s (%d objects, %.1f ms, %.1f KB)", filepath.c_str(),
+                 (int)world.Count(), ms, ec ? 0.0 : bytes / 1024.0);
+    return true;
+}
+
+bool CSceneSerializer::LoadWorld(CWorld& world, CSceneLightSettings& settings, const std::string& filepath) {
+    auto start = std::chrono::steady_clock::now();
+    bool ok = IsBinaryScenePath(filepath) ? LoadBinaryScene(world, settings, filepath)
+                                          : LoadJsonScene(world, settings, filepath);
+    if (!ok) return false;
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    CFFLog::Info("Scene loaded from: %s (%d objects, %.1f ms)", filepath.c_str(), (int)world.Count(), ms);
+    return true;
+}
+
+bool CSceneSerializer::ConvertScene(const std::string& srcPath, const std::string& dstPath) {
+    CWorld world;
+    CSceneLightSettings settings;
+    if (!LoadWorld(world, settings, srcPath)) {
+        return false;
+    }
+    return SaveWorld(world, settings, dstPath);
+}
+
+// ===========================
+// Save CScene
+// ===========================
+bool CSceneSerializer::SaveScene(const CScene& scene, const std::string& filepath) {
+    return SaveWorld(scene.GetWorld(), scene.GetLightSettings(), filepath);
+}
+
+// ===========================
+// Load CScene
+// ===========================
+bool CSceneSerializer::LoadScene(CScene& scene, const std::string& filepath) {
+    scene.SetFilePath(filepath);
+    bool ok = LoadWorld(scene.GetWorld(), scene.GetLightSettings(), filepath);
+    scene.SetSelected(-1);
+    return ok;
+}
+
 // ===========================
 // Serialize Single GameObject to JSON String
 // ===========================
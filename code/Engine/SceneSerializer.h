@@ -5,16 +5,28 @@
 class CScene;
 class CGameObject;
 class CWorld;
+class CSceneLightSettings;
 
-// CScene serialization to/from JSON files
+// CScene serialization to/from files. The format follows the extension:
+// .ffscene is the binary format (see FFSceneFile.h), anything else is JSON.
 class CSceneSerializer {
 public:
-    // Save scene to JSON file
+    // Save scene to file
     static bool SaveScene(const CScene& scene, const std::string& filepath);
 
-    // Load scene from JSON file (clears existing CScene)
+    // Load scene from file (clears existing CScene)
     static bool LoadScene(CScene& scene, const std::string& filepath);
 
+    // Same, for a world and settings outside CScene (tools, converters, tests)
+    static bool SaveWorld(const CWorld& world, const CSceneLightSettings& settings, const std::string& filepath);
+    static bool LoadWorld(CWorld& world, CSceneLightSettings& settings, const std::string& filepath);
+
+    // JSON <-> .ffscene (either direction, by extension). Components are
+    // rebuilt through the registry, so both files hold the same properties.
+    static bool ConvertScene(const std::string& srcPath, const std::string& dstPath);
+
+    static bool IsBinaryScenePath(const std::string& filepath);
+
     // Serialize GameObject to JSON string (for clipboard copy)
     static std::string SerializeGameObject(const CGameObject* go);
 
@@ -0,0 +1,247 @@
+#include "SpatialIndex.h"
+#include "World.h"
+#include "GameObject.h"
+#include "Components/Transform.h"
+#include "Components/MeshRenderer.h"
+#include "Components/PointLight.h"
+#include "Components/SpotLight.h"
+#include "Components/ReflectionProbe.h"
+#include "Components/LightProbe.h"
+#include "Core/GpuMeshResource.h"
+#include <cfloat>
+
+using namespace DirectX;
+
+namespace
+{
+    // Radius-like parameter whose change invalidates the bounds
+    float categoryRadius(const SSpatialEntry& e)
+    {
+        switch (e.category) {
+        case SpatialCategory_PointLight:      return static_cast<const SPointLight*>(e.component)->range;
+        case SpatialCategory_SpotLight:       return static_cast<const SSpotLight*>(e.component)->range;
+        case SpatialCategory_ReflectionProbe: return static_cast<const SReflectionProbe*>(e.component)->radius;
+        case SpatialCategory_LightProbe:      return static_cast<const SLightProbe*>(e.component)->radius;
+        default:                              return 0.0f;
+        }
+    }
+
+    SAABB sphereBounds(const XMFLOAT3& center, float radius)
+    {
+        SAABB b;
+        b.min = {center.x - radius, center.y - radius, center.z - radius};
+        b.max = {center.x + radius, center.y + radius, center.z + radius};
+        return b;
+    }
+}
+
+// ============================================
+// Update
+// ============================================
+
+int CSceneSpatialIndex::Update(CWorld& world)
+{
+    m_lastMoved = 0;
+    m_lastReinserted = 0;
+
+    if (m_world != &world ||
+        m_worldVersion != world.GetVersion() ||
+        m_componentEpoch != CGameObject::GetComponentEpoch()) {
+        resync(world);
+        m_world = &world;
+        m_worldVersion = world.GetVersion();
+        m_componentEpoch = CGameObject::GetComponentEpoch();
+        return m_lastMoved;
+    }
+
+    for (size_t i = 0; i < m_entries.size(); i++) {
+        if (needsRefresh(i)) {
+            refreshEntry(i);
+        }
+    }
+    return m_lastMoved;
+}
+
+void CSceneSpatialIndex::Clear()
+{
+    m_tree.Clear();
+    m_entries.clear();
+    m_states.clear();
+    m_lookup.clear();
+    m_world = nullptr;
+}
+
+void CSceneSpatialIndex::resync(CWorld& world)
+{
+    std::vector<SSpatialEntry> entries;
+    std::vector<SEntryState> states;
+    std::unordered_map<std::pair<CGameObject*, uint32_t>, uint32_t, SKeyHash> lookup;
+    entries.reserve(m_entries.size());
+    states.reserve(m_states.size());
+    lookup.reserve(m_lookup.size());
+
+    const auto& objects = world.Objects();
+    for (size_t objIndex = 0; objIndex < objects.size(); objIndex++) {
+        CGameObject* obj = objects[objIndex].get();
+        STransform* transform = obj->GetComponent<STransform>();
+        if (!transform) continue;
+
+        const std::pair<uint32_t, CComponent*> components[] = {
+            {SpatialCategory_Mesh,            obj->GetComponent<SMeshRenderer>()},
+            {SpatialCategory_PointLight,      obj->GetComponent<SPointLight>()},
+            {SpatialCategory_SpotLight,       obj->GetComponent<SSpotLight>()},
+            {SpatialCategory_ReflectionProbe, obj->GetComponent<SReflectionProbe>()},
+            {SpatialCategory_LightProbe,      obj->GetComponent<SLightProbe>()},
+        };
+        for (const auto& [category, component] : components) {
+            if (!component) continue;
+
+            SSpatialEntry entry;
+            entry.obj = obj;
+            entry.transform = transform;
+            entry.component = component;
+            entry.category = category;
+            entry.worldIndex = (uint32_t)objIndex;
+
+            // Keep the tree leaf of a surviving (object, category) pair
+            SEntryState state;
+            auto it = m_lookup.find({obj, category});
+            if (it != m_lookup.end()) {
+                state.proxyId = m_states[it->second].proxyId;
+                m_states[it->second].proxyId = CDynamicAABBTree::NULL_NODE;
+                entry.bounds = m_entries[it->second].bounds;
+            }
+
+            lookup[{obj, category}] = (uint32_t)entries.size();
+            entries.push_back(entry);
+            states.push_back(state);
+        }
+    }
+
+    // Entries that did not survive
+    for (const SEntryState& state : m_states) {
+        if (state.proxyId != CDynamicAABBTree::NULL_NODE) {
+            m_tree.DestroyProxy(state.proxyId);
+        }
+    }
+
+    m_entries = std::move(entries);
+    m_states = std::move(states);
+    m_lookup = std::move(lookup);
+
+    // Component pointers may have been reused by a new object at the same
+    // address, so every entry gets fresh bounds (leaves still only move when
+    // they leave their fat AABB)
+    for (size_t i = 0; i < m_entries.size(); i++) {
+        refreshEntry(i);
+    }
+}
+
+bool CSceneSpatialIndex::needsRefresh(size_t i) const
+{
+    const SSpatialEntry& e = m_entries[i];
+    const SEntryState& s = m_states[i];
+    const STransform* t = e.transform;
+
+    if (s.worldVersion != t->GetWorldVersion()) {
+        return true;
+    }
+    if (e.category == SpatialCategory_Mesh) {
+        return s.renderVersion != static_cast<const SMeshRenderer*>(e.component)->renderVersion;
+    }
+    return s.radius != categoryRadius(e);
+}
+
+void CSceneSpatialIndex::refreshEntry(size_t i)
+{
+    SSpatialEntry& e = m_entries[i];
+    SEntryState& s = m_states[i];
+    const STransform* t = e.transform;
+
+    s.worldVersion = t->GetWorldVersion();
+    s.radius = categoryRadius(e);
+
+    if (e.category == SpatialCategory_Mesh) {
+        const auto* meshRenderer = static_cast<const SMeshRenderer*>(e.component);
+        s.renderVersion = meshRenderer->renderVersion;
+
+        XMFLOAT3 localMin = {FLT_MAX, FLT_MAX, FLT_MAX};
+        XMFLOAT3 localMax = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+        for (auto& gpuMesh : meshRenderer->meshes) {
+            if (!gpuMesh || !gpuMesh->hasBounds) continue;
+            localMin = {std::min(localMin.x, gpuMesh->localBoundsMin.x), std::min(localMin.y, gpuMesh->localBoundsMin.y),
+                        std::min(localMin.z, gpuMesh->localBoundsMin.z)};
+            localMax = {std::max(localMax.x, gpuMesh->localBoundsMax.x), std::max(localMax.y, gpuMesh->localBoundsMax.y),
+                        std::max(localMax.z, gpuMesh->localBoundsMax.z)};
+        }
+
+        e.hasBounds = localMin.x <= localMax.x;
+        if (e.hasBounds) {
+            e.bounds = SAABB::Transform(localMin, localMax, t->WorldMatrix());
+        } else {
+            e.bounds = sphereBounds(t->GetWorldPosition(), 0.0f);
+        }
+    } else {
+        e.hasBounds = true;
+        e.bounds = sphereBounds(t->GetWorldPosition(), s.radius);
+    }
+
+    m_lastMoved++;
+    if (s.proxyId == CDynamicAABBTree::NULL_NODE) {
+        s.proxyId = m_tree.CreateProxy(e.bounds, (uint32_t)i);
+        m_lastReinserted++;
+    } else {
+        m_tree.SetUserData(s.proxyId, (uint32_t)i);
+        if (m_tree.MoveProxy(s.proxyId, e.bounds)) {
+            m_lastReinserted++;
+        }
+    }
+}
+
+// ============================================
+// Ray cast
+// ============================================
+
+const SSpatialEntry* CSceneSpatialIndex::RayCast(const XMFLOAT3& origin, const XMFLOAT3& dir,
+                                                 float maxDistance, uint32_t categoryMask,
+                                                 float* outDistance) const
+{
+    const float org[3] = {origin.x, origin.y, origin.z};
+    const float invDir[3] = {1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z};
+
+    const SSpatialEntry* closest = nullptr;
+    float closestDistance = maxDistance;
+
+    m_tree.RayCast(origin, dir, maxDistance, [&](uint32_t i, float) {
+        const SSpatialEntry& e = m_entries[i];
+        if (!(e.category & categoryMask) || !e.hasBounds) return closestDistance;
+
+        // Same convention as PickingUtils::RayAABBIntersect: when the origin is
+        // inside the box the hit is the exit point, so enclosing objects (rooms,
+        // floors) do not shadow everything inside them
+        float tNear = -FLT_MAX, tFar = FLT_MAX;
+        const float bmin[3] = {e.bounds.min.x, e.bounds.min.y, e.bounds.min.z};
+        const float bmax[3] = {e.bounds.max.x, e.bounds.max.y, e.bounds.max.z};
+        for (int a = 0; a < 3; a++) {
+            float t1 = (bmin[a] - org[a]) * invDir[a];
+            float t2 = (bmax[a] - org[a]) * invDir[a];
+            tNear = std::max(tNear, std::min(t1, t2));
+            tFar = std::min(tFar, std::max(t1, t2));
+        }
+        if (tNear > tFar || tFar < 0.0f) return closestDistance;
+
+        float hit = (tNear < 0.0f) ? tFar : tNear;
+        if (hit < closestDistance) {
+            closestDistance = hit;
+            closest = &e;
+        }
+        // Exit hits can be farther than entry points of other leaves, so only
+        // clip the traversal with the closest distance found so far
+        return closestDistance;
+    });
+
+    if (closest && outDistance) {
+        *outDistance = closestDistance;
+    }
+    return closest;
+}
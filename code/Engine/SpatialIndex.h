@@ -0,0 +1,140 @@
+#pragma once
+#include "DynamicAABBTree.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class CWorld;
+class CGameObject;
+class CComponent;
+struct STransform;
+
+// ============================================
+// CSceneSpatialIndex - spatial queries over CWorld
+// ============================================
+// Keeps a CDynamicAABBTree of world-space bounds for every spatially
+// relevant component (mesh renderers, point/spot lights, probes). One object
+// may own several entries (e.g. mesh + point light), one per category.
+//
+// Bounds:
+//   Mesh            - union of sub-mesh local bounds transformed to world
+//                     (position point if the mesh has no bounds yet)
+//   Point/Spot      - sphere(position, range)
+//   Reflection/Light probe - sphere(position, radius)
+//
+// Update() is incremental:
+//   - World structure changed (Create/Destroy/AddComponent) -> entries are
+//     re-synced; surviving entries keep their tree leaves
+//   - Otherwise only entries whose world transform / range / mesh changed get new
+//     bounds, and only those leaving their fat AABB are re-inserted
+//
+// Usage:
+//   CSceneSpatialIndex& index = scene.GetSpatialIndex();
+//   index.Update(scene.GetWorld());
+//   index.QueryAABB(box, SpatialCategory_Mesh, [](const SSpatialEntry& e) { ...; return true; });
+
+enum ESpatialCategory : uint32_t
+{
+    SpatialCategory_Mesh            = 1 << 0,
+    SpatialCategory_PointLight      = 1 << 1,
+    SpatialCategory_SpotLight       = 1 << 2,
+    SpatialCategory_ReflectionProbe = 1 << 3,
+    SpatialCategory_LightProbe      = 1 << 4,
+
+    SpatialCategory_Lights          = SpatialCategory_PointLight | SpatialCategory_SpotLight,
+    SpatialCategory_All             = 0xFFFFFFFFu
+};
+
+struct SSpatialEntry
+{
+    CGameObject* obj = nullptr;
+    STransform* transform = nullptr;
+    CComponent* component = nullptr;    // SMeshRenderer / SPointLight / ... matching category
+    uint32_t category = 0;
+    uint32_t worldIndex = 0;            // Index in CWorld::Objects() (valid until the next structural change)
+    SAABB bounds;                       // Tight world bounds
+    bool hasBounds = true;              // Mesh without uploaded bounds -> point at position
+};
+
+class CSceneSpatialIndex
+{
+public:
+    // Returns the number of entries whose bounds were recomputed
+    int Update(CWorld& world);
+    void Clear();
+
+    size_t GetEntryCount() const { return m_entries.size(); }
+    const SSpatialEntry& GetEntry(size_t i) const { return m_entries[i]; }
+    const CDynamicAABBTree& GetTree() const { return m_tree; }
+
+    // Stats for the last Update()
+    int GetLastMovedCount() const { return m_lastMoved; }
+    int GetLastReinsertedCount() const { return m_lastReinserted; }
+
+    // callback(const SSpatialEntry&) -> bool continue
+    template<typename Func>
+    void QueryAABB(const SAABB& aabb, uint32_t categoryMask, Func&& callback) const {
+        m_tree.QueryAABB(aabb, [&](uint32_t i) {
+            const SSpatialEntry& e = m_entries[i];
+            if (!(e.category & categoryMask) || !e.bounds.Overlaps(aabb)) return true;
+            return callback(e);
+        });
+    }
+
+    template<typename Func>
+    void QuerySphere(const DirectX::XMFLOAT3& center, float radius, uint32_t categoryMask, Func&& callback) const {
+        m_tree.QuerySphere(center, radius, [&](uint32_t i) {
+            const SSpatialEntry& e = m_entries[i];
+            if (!(e.category & categoryMask) || !e.bounds.OverlapsSphere(center, radius)) return true;
+            return callback(e);
+        });
+    }
+
+    template<typename Func>
+    void QueryFrustum(const SFrustumPlanes& frustum, uint32_t categoryMask, Func&& callback) const {
+        m_tree.QueryFrustum(frustum, [&](uint32_t i) {
+            const SSpatialEntry& e = m_entries[i];
+            if (!(e.category & categoryMask) || !e.bounds.IntersectsFrustum(frustum)) return true;
+            return callback(e);
+        });
+    }
+
+    // Closest entry whose tight bounds the ray hits. Entries without bounds are skipped.
+    // Returns nullptr on miss. dir must be normalized.
+    const SSpatialEntry* RayCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& dir,
+                                 float maxDistance, uint32_t categoryMask, float* outDistance = nullptr) const;
+
+private:
+    struct SEntryState
+    {
+        int32_t proxyId = CDynamicAABBTree::NULL_NODE;
+        uint32_t worldVersion = 0;      // STransform::GetWorldVersion() snapshot
+        float radius = 0.0f;            // Light range / probe radius snapshot
+        uint32_t renderVersion = 0;     // SMeshRenderer::renderVersion snapshot
+    };
+
+    void resync(CWorld& world);
+    bool needsRefresh(size_t i) const;
+    void refreshEntry(size_t i);
+
+    CDynamicAABBTree m_tree;
+    std::vector<SSpatialEntry> m_entries;
+    std::vector<SEntryState> m_states;
+
+    // (object, category) -> entry index, used to keep tree leaves across re-syncs
+    struct SKeyHash
+    {
+        size_t operator()(const std::pair<CGameObject*, uint32_t>& k) const {
+            return std::hash<const void*>()(k.first) ^ (size_t(k.second) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+    std::unordered_map<std::pair<CGameObject*, uint32_t>, uint32_t, SKeyHash> m_lookup;
+
+    const CWorld* m_world = nullptr;
+    uint32_t m_worldVersion = 0;
+    uint32_t m_componentEpoch = 0;
+
+    int m_lastMoved = 0;
+    int m_lastReinserted = 0;
+};
@@ -0,0 +1,90 @@
+#include "TransformSystem.h"
+#include "World.h"
+#include "GameObject.h"
+#include "Components/Transform.h"
+#include "Core/Jobs/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+int CTransformSystem::Update(CWorld& world)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (m_world != &world ||
+        m_worldVersion != world.GetVersion() ||
+        m_componentEpoch != CGameObject::GetComponentEpoch() ||
+        m_hierarchyEpoch != STransform::GetHierarchyEpoch()) {
+        sortHierarchy(world);
+        m_world = &world;
+        m_worldVersion = world.GetVersion();
+        m_componentEpoch = CGameObject::GetComponentEpoch();
+        m_hierarchyEpoch = STransform::GetHierarchyEpoch();
+    }
+
+    CJobSystem& jobs = CJobSystem::Instance();
+    int rebuilt = 0;
+    for (size_t level = 0; level + 1 < m_levelOffsets.size(); level++) {
+        uint32_t begin = m_levelOffsets[level];
+        uint32_t end = m_levelOffsets[level + 1];
+
+        if (m_parallel && jobs.IsInitialized() && end - begin >= PARALLEL_THRESHOLD) {
+            // Parents live in earlier levels and are already up to date, so
+            // transforms of this level only read shared state
+            std::atomic<int> levelRebuilt{0};
+            jobs.ParallelFor(end - begin, 512, [&](uint32_t chunkBegin, uint32_t chunkEnd) {
+                levelRebuilt.fetch_add(updateRange(begin + chunkBegin, begin + chunkEnd), std::memory_order_relaxed);
+            });
+            rebuilt += levelRebuilt.load();
+        } else {
+            rebuilt += updateRange(begin, end);
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_lastUpdateMs = std::chrono::duration<float, std::milli>(end - start).count();
+    m_lastRebuilt = rebuilt;
+    return rebuilt;
+}
+
+int CTransformSystem::updateRange(uint32_t begin, uint32_t end)
+{
+    int rebuilt = 0;
+    for (uint32_t i = begin; i < end; i++) {
+        STransform* transform = m_sorted[i];
+        uint32_t version = transform->m_cache.worldVersion;
+        transform->beginFrame();
+        if (transform->m_cache.worldVersion != version) {
+            rebuilt++;
+        }
+    }
+    return rebuilt;
+}
+
+void CTransformSystem::sortHierarchy(CWorld& world)
+{
+    // Counting sort by depth over the dense transform pool
+    std::vector<uint32_t> depths;
+    std::vector<STransform*> transforms;
+    uint32_t maxDepth = 0;
+    world.View<STransform>().Each([&](EntityId, STransform& transform) {
+        uint32_t depth = transform.GetDepth();
+        maxDepth = std::max(maxDepth, depth);
+        depths.push_back(depth);
+        transforms.push_back(&transform);
+    });
+
+    m_levelOffsets.assign(transforms.empty() ? 1 : maxDepth + 2, 0);
+    for (uint32_t depth : depths) {
+        m_levelOffsets[depth + 1]++;
+    }
+    for (size_t level = 1; level < m_levelOffsets.size(); level++) {
+        m_levelOffsets[level] += m_levelOffsets[level - 1];
+    }
+
+    m_sorted.resize(transforms.size());
+    std::vector<uint32_t> cursor(m_levelOffsets.begin(), m_levelOffsets.end() - 1);
+    for (size_t i = 0; i < transforms.size(); i++) {
+        m_sorted[cursor[depths[i]]++] = transforms[i];
+    }
+}
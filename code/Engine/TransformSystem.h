@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+class CWorld;
+struct STransform;
+
+// ============================================
+// CTransformSystem - once-per-frame world matrix update
+// ============================================
+// Walks every STransform of a world in hierarchy order (depth 0, then 1, ...)
+// and refreshes its cached world matrix, so children always see an updated
+// parent. Transforms of one depth level are independent and are split across
+// the job system when the level is large enough.
+//
+// Each update also shifts the frame history used for motion vectors:
+// STransform::PrevWorldMatrix() returns the world matrix of the previous
+// Update() call.
+//
+// The depth-sorted list is cached and rebuilt only when the world structure,
+// components or hierarchy change.
+//
+// Usage (once per frame, main thread, before rendering):
+//   scene.GetTransformSystem().Update(scene.GetWorld());
+class CTransformSystem
+{
+public:
+    // Levels smaller than this run on the calling thread
+    static const uint32_t PARALLEL_THRESHOLD = 2048;
+
+    // Returns the number of world matrices that were rebuilt
+    int Update(CWorld& world);
+
+    void SetParallel(bool parallel) { m_parallel = parallel; }
+    bool IsParallel() const { return m_parallel; }
+
+    // Stats for the last Update()
+    int GetTransformCount() const { return (int)m_sorted.size(); }
+    int GetLevelCount() const { return (int)m_levelOffsets.size() - 1; }
+    int GetLastRebuiltCount() const { return m_lastRebuilt; }
+    float GetLastUpdateMs() const { return m_lastUpdateMs; }
+
+private:
+    void sortHierarchy(CWorld& world);
+    int updateRange(uint32_t begin, uint32_t end);
+
+    // Transforms sorted by depth; level d is [m_levelOffsets[d], m_levelOffsets[d + 1])
+    std::vector<STransform*> m_sorted;
+    std::vector<uint32_t> m_levelOffsets;
+
+    const CWorld* m_world = nullptr;
+    uint32_t m_worldVersion = 0;
+    uint32_t m_componentEpoch = 0;
+    uint32_t m_hierarchyEpoch = 0;
+
+    bool m_parallel = true;
+    int m_lastRebuilt = 0;
+    float m_lastUpdateMs = 0.0f;
+};
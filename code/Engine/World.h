@@ -2,25 +2,42 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <cstdint>
 #include "GameObject.h"
 
 class CWorld {
 public:
     CGameObject* Create(const std::string& name){
-        m_objects.emplace_back(std::make_unique<CGameObject>(name));
+        m_objects.emplace_back(std::make_unique<CGameObject>(name, m_storage));
+        ++m_version;
         return m_objects.back().get();
     }
     void Destroy(std::size_t index){
         if (index < m_objects.size()){
             m_objects.erase(m_objects.begin()+index);
+            ++m_version;
         }
     }
     std::size_t Count() const { return m_objects.size(); }
     CGameObject* Get(std::size_t i){ return (i<m_objects.size())? m_objects[i].get() : nullptr; }
     const CGameObject* Get(std::size_t i) const { return (i<m_objects.size())? m_objects[i].get() : nullptr; }
     const std::vector<std::unique_ptr<CGameObject>>& Objects() const { return m_objects; }
+    // Bumped on Create/Destroy (render caches compare it to detect structural changes)
+    uint32_t GetVersion() const { return m_version; }
+
+    // Dense component pools shared by all objects of this world
+    CComponentStorage& GetComponentStorage() { return m_storage; }
+    const CComponentStorage& GetComponentStorage() const { return m_storage; }
+
+    // Typed iteration over dense arrays, e.g.
+    //   world.View<STransform, SMeshRenderer>().Each([](EntityId, STransform&, SMeshRenderer&) { ... });
+    // Order is pool order, not Objects() order.
+    template<class... Ts>
+    TComponentView<Ts...> View() const { return m_storage.View<Ts...>(); }
 private:
+    CComponentStorage m_storage;   // Declared first: outlives the objects that reference it
     std::vector<std::unique_ptr<CGameObject>> m_objects;
+    uint32_t m_version = 0;
 };
 
 
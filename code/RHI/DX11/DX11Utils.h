@@ -280,6 +280,10 @@ inline DXGI_FORMAT ToD3D11VertexFormat(EVertexFormat format) {
         case EVertexFormat::Float4: return DXGI_FORMAT_R32G32B32A32_FLOAT;
         case EVertexFormat::UByte4: return DXGI_FORMAT_R8G8B8A8_UINT;
         case EVertexFormat::UByte4_Norm: return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case EVertexFormat::Half2: return DXGI_FORMAT_R16G16_FLOAT;
+        case EVertexFormat::Half4: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+        case EVertexFormat::Short4_Norm: return DXGI_FORMAT_R16G16B16A16_SNORM;
+        case EVertexFormat::UShort2_Norm: return DXGI_FORMAT_R16G16_UNORM;
         default: return DXGI_FORMAT_R32G32B32_FLOAT;
     }
 }
@@ -167,6 +167,26 @@ inline uint32_t GetBytesPerPixel(ETextureFormat format) {
     }
 }
 
+// Helper: Get bytes per 4x4 block for block-compressed formats (returns 0 otherwise)
+inline uint32_t GetBlockBytes(ETextureFormat format) {
+    switch (format) {
+        case ETextureFormat::BC1_UNORM:
+        case ETextureFormat::BC1_UNORM_SRGB:        return 8;
+        case ETextureFormat::BC3_UNORM:
+        case ETextureFormat::BC3_UNORM_SRGB:
+        case ETextureFormat::BC5_UNORM:
+        case ETextureFormat::BC7_UNORM:
+        case ETextureFormat::BC7_UNORM_SRGB:        return 16;
+        default:                                     return 0;
+    }
+}
+
+// Helper: Get bytes per row of a mip level (per row of 4x4 blocks for compressed formats)
+inline uint32_t GetRowPitch(ETextureFormat format, uint32_t width) {
+    uint32_t blockBytes = GetBlockBytes(format);
+    return blockBytes ? ((width + 3) / 4) * blockBytes : width * GetBytesPerPixel(format);
+}
+
 // ============================================
 // Index Format
 // ============================================
@@ -296,7 +316,11 @@ enum class EVertexFormat {
     Float3,
     Float4,
     UByte4,
-    UByte4_Norm
+    UByte4_Norm,
+    Half2,
+    Half4,
+    Short4_Norm,
+    UShort2_Norm
 };
 
 struct VertexElement {
@@ -107,7 +107,10 @@ PSOut main(PSIn i) {
     // ============================================
     // Normal Mapping
     // ============================================
-    float3 nTS = gNormalMap.Sample(gMaterialSampler, i.uv).xyz * 2.0 - 1.0;
+    // XY only: cooked normal maps are BC5 (two channels), Z is rebuilt
+    float3 nTS;
+    nTS.xy = gNormalMap.Sample(gMaterialSampler, i.uv).xy * 2.0 - 1.0;
+    nTS.z = sqrt(saturate(1.0 - dot(nTS.xy, nTS.xy)));
     nTS.y = -nTS.y;  // Flip Y (glTF uses OpenGL format)
     nTS = normalize(nTS);
     float3 N = normalize(mul(nTS, i.TBN));
@@ -50,7 +50,7 @@ struct VSOut {
     nointerpolation int lightmapIndex : TEXCOORD8;
 };
 
-VSOut main(VSIn i) {
+VSOut vsMain(VSIn i) {
     VSOut o;
 
     // World space position
@@ -80,3 +80,18 @@ VSOut main(VSIn i) {
 
     return o;
 }
+
+#ifdef PACKED_VERTEX
+// Packed vertex layout (two streams), decoded to VSIn
+#include "PackedVertex.hlsli"
+
+VSOut main(VSInPacked p) {
+    VSIn i;
+    DecodePackedVertex(p, i.pos, i.normal, i.tangent, i.uv, i.uv2, i.color);
+    return vsMain(i);
+}
+#else
+VSOut main(VSIn i) {
+    return vsMain(i);
+}
+#endif
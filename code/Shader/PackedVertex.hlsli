@@ -0,0 +1,36 @@
+// Shader/PackedVertex.hlsli
+// Packed vertex layout input and decode (matches Core/PackedVertex.h and
+// MeshVertexStreams::PackedLayout). Vertex shaders compiled with PACKED_VERTEX
+// read this struct and decode it into their regular vertex input.
+
+#ifndef PACKED_VERTEX_HLSLI
+#define PACKED_VERTEX_HLSLI
+
+struct VSInPacked {
+    float4 pos : POSITION;              // Slot 0: half xyz, w = tangent handedness
+    float4 normalTangent : NORMAL;      // Slot 1: octahedral normal (xy) + tangent (zw), snorm16
+    float2 uv : TEXCOORD0;              // half
+    float2 uv2 : TEXCOORD1;             // unorm16
+    float4 color : COLOR;               // unorm8
+};
+
+// Inverse of OctEncode in Core/PackedVertex.cpp
+float3 OctDecode(float2 e) {
+    float3 v = float3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = saturate(-v.z);
+    v.xy += (v.xy >= 0.0) ? -t : t;
+    return normalize(v);
+}
+
+void DecodePackedVertex(VSInPacked p,
+                        out float3 pos, out float3 normal, out float4 tangent,
+                        out float2 uv, out float2 uv2, out float4 color) {
+    pos = p.pos.xyz;
+    normal = OctDecode(p.normalTangent.xy);
+    tangent = float4(OctDecode(p.normalTangent.zw), p.pos.w);
+    uv = p.uv;
+    uv2 = p.uv2;
+    color = p.color;
+}
+
+#endif // PACKED_VERTEX_HLSLI
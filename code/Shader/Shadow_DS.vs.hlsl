@@ -22,11 +22,10 @@ cbuffer CB_PerDraw : register(b0, space3) {
     float2 _padDraw;
 };
 
+// Position only: bound to the interleaved stream (full layout) or to the
+// half4 position stream (packed layout), see MeshVertexStreams.h
 struct VSInput {
     float3 position : POSITION;
-    float3 normal   : NORMAL;
-    float2 uv       : TEXCOORD0;
-    float4 tangent  : TANGENT;
 };
 
 float4 main(VSInput input) : SV_Position {
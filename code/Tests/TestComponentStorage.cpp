@@ -0,0 +1,288 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Engine/World.h"
+#include "Engine/GameObject.h"
+#include "Engine/ComponentStorage.h"
+#include "Engine/Components/Transform.h"
+#include "Engine/Components/MeshRenderer.h"
+#include "Engine/Components/PointLight.h"
+#include "Engine/Components/SpotLight.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+
+/**
+ * Test: Sparse-set component storage behind CGameObject
+ *
+ * Frame 1 (correctness):
+ *   - GetComponent / AddComponent facade, one component per type
+ *   - ForEachComponent keeps insertion order (serialization)
+ *   - Component pointers stay valid while other objects are created / destroyed
+ *   - Views return exactly the entities owning all viewed types
+ *   - Entity ids are recycled and their pools cleaned on Destroy
+ *
+ * Frame 5 (benchmark, 100k entities):
+ *   - Legacy layout: vector<unique_ptr<CComponent>> per object + dynamic_cast lookup
+ *   - Facade: CGameObject::GetComponent (sparse lookup)
+ *   - View: dense iteration over Transform / Transform+MeshRenderer / lights
+ *
+ * Usage:
+ *   forfun.exe --test TestComponentStorage
+ *   Results: E:/forfun/debug/TestComponentStorage/test.log
+ */
+class CTestComponentStorage : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestComponentStorage";
+    }
+
+    static const int BENCH_ENTITY_COUNT = 100000;
+
+    // Component layout before the sparse-set storage, kept for comparison
+    struct SLegacyObject {
+        std::vector<std::unique_ptr<CComponent>> components;
+
+        template<class T>
+        T* Add() {
+            auto up = std::make_unique<T>();
+            T* raw = up.get();
+            components.emplace_back(std::move(up));
+            return raw;
+        }
+        template<class T>
+        T* Get() {
+            for (auto& c : components) {
+                if (auto p = dynamic_cast<T*>(c.get())) return p;
+            }
+            return nullptr;
+        }
+    };
+
+    // Every object has a transform, 1/2 a mesh renderer, 1/8 a point light, 1/16 a spot light
+    template<class AddFunc>
+    static void populate(int index, AddFunc&& add) {
+        add(0, index);
+        if (index % 2 == 0) add(1, index);
+        if (index % 8 == 1) add(2, index);
+        if (index % 16 == 3) add(3, index);
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestComponentStorage ===");
+            CFFLog::Info("Frame 1: Correctness checks");
+
+            CWorld world;
+            CGameObject* a = world.Create("A");
+            STransform* ta = a->AddComponent<STransform>();
+            SMeshRenderer* ma = a->AddComponent<SMeshRenderer>();
+            SPointLight* la = a->AddComponent<SPointLight>();
+            ta->position = {1.0f, 2.0f, 3.0f};
+
+            ASSERT(ctx, a->GetComponent<STransform>() == ta, "GetComponent returns the added transform");
+            ASSERT(ctx, a->GetComponent<SSpotLight>() == nullptr, "Missing component returns nullptr");
+            ASSERT(ctx, a->AddComponent<STransform>() == ta, "Adding an existing type returns the existing component");
+            ASSERT(ctx, ta->GetOwner() == a, "Owner set");
+
+            std::vector<const CComponent*> order;
+            a->ForEachComponent([&order](const CComponent* c) { order.push_back(c); });
+            ASSERT_EQUAL(ctx, (int)order.size(), 3, "ForEachComponent visits every component once");
+            ASSERT(ctx, order.size() == 3 && order[0] == ta && order[1] == ma && order[2] == la,
+                   "ForEachComponent keeps insertion order");
+
+            // Pointer stability across growth (several pages) and removals
+            for (int i = 0; i < 1000; i++) {
+                CGameObject* obj = world.Create("Filler_" + std::to_string(i));
+                obj->AddComponent<STransform>()->position.x = (float)i;
+                if (i % 2 == 0) obj->AddComponent<SMeshRenderer>();
+            }
+            for (int i = 0; i < 200; i++) {
+                world.Destroy(1 + i * 3);
+            }
+            ASSERT(ctx, a->GetComponent<STransform>() == ta, "Component pointer stable after growth and removals");
+            ASSERT_EQUAL_F(ctx, ta->position.y, 2.0f, 0.0f, "Component data intact");
+
+            // View contents match a GetComponent scan
+            int expected = 0;
+            for (auto& obj : world.Objects()) {
+                if (obj->GetComponent<STransform>() && obj->GetComponent<SMeshRenderer>()) expected++;
+            }
+            int viewed = 0;
+            bool ownersMatch = true;
+            world.View<STransform, SMeshRenderer>().Each([&](EntityId e, STransform& t, SMeshRenderer& mr) {
+                viewed++;
+                CGameObject* owner = t.GetOwner();
+                ownersMatch = ownersMatch && owner == mr.GetOwner() && owner->GetEntity() == e;
+            });
+            ASSERT_EQUAL(ctx, viewed, expected, "Transform+MeshRenderer view matches GetComponent scan");
+            ASSERT(ctx, ownersMatch, "View components belong to the iterated entity");
+
+            int transforms = 0;
+            world.View<STransform>().Each([&transforms](EntityId, STransform&) { transforms++; });
+            ASSERT_EQUAL(ctx, transforms, (int)world.Count(), "Single-type view covers every transform");
+
+            int spotLights = 0;
+            world.View<STransform, SSpotLight>().Each([&spotLights](EntityId, STransform&, SSpotLight&) { spotLights++; });
+            ASSERT_EQUAL(ctx, spotLights, 0, "View over a never-added type is empty");
+
+            // Entity recycling
+            EntityId destroyedEntity = world.Get(1)->GetEntity();
+            world.Destroy(1);
+            CGameObject* reused = world.Create("Reused");
+            ASSERT_EQUAL(ctx, (int)reused->GetEntity(), (int)destroyedEntity, "Entity id recycled");
+            ASSERT(ctx, reused->GetComponent<STransform>() == nullptr, "Recycled entity starts without components");
+            ASSERT_EQUAL(ctx, (int)world.GetComponentStorage().GetEntityCount(), (int)world.Count(),
+                         "Storage entity count matches world");
+
+            // Standalone object (own storage)
+            CGameObject standalone("Standalone");
+            ASSERT(ctx, standalone.AddComponent<SPointLight>() == standalone.GetComponent<SPointLight>(),
+                   "Standalone object works through its private storage");
+
+            CFFLog::Info("✓ Frame 1: Correctness checks passed");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Component Storage");
+
+            // Legacy layout
+            std::vector<std::unique_ptr<SLegacyObject>> legacy;
+            legacy.reserve(BENCH_ENTITY_COUNT);
+            for (int i = 0; i < BENCH_ENTITY_COUNT; i++) {
+                auto obj = std::make_unique<SLegacyObject>();
+                populate(i, [&obj](int type, int index) {
+                    switch (type) {
+                    case 0: obj->Add<STransform>()->position.x = (float)index; break;
+                    case 1: obj->Add<SMeshRenderer>(); break;
+                    case 2: obj->Add<SPointLight>(); break;
+                    default: obj->Add<SSpotLight>(); break;
+                    }
+                });
+                legacy.push_back(std::move(obj));
+            }
+
+            // Sparse-set storage
+            CWorld world;
+            for (int i = 0; i < BENCH_ENTITY_COUNT; i++) {
+                CGameObject* obj = world.Create("E");
+                populate(i, [obj](int type, int index) {
+                    switch (type) {
+                    case 0: obj->AddComponent<STransform>()->position.x = (float)index; break;
+                    case 1: obj->AddComponent<SMeshRenderer>(); break;
+                    case 2: obj->AddComponent<SPointLight>(); break;
+                    default: obj->AddComponent<SSpotLight>(); break;
+                    }
+                });
+            }
+
+            const int iterations = 20;
+            volatile float sink = 0.0f;
+            auto timeMs = [](auto&& fn) {
+                auto t0 = std::chrono::high_resolution_clock::now();
+                for (int it = 0; it < iterations; it++) fn();
+                auto t1 = std::chrono::high_resolution_clock::now();
+                return std::chrono::duration<double, std::milli>(t1 - t0).count() / iterations;
+            };
+
+            // --- Transform + MeshRenderer ---
+            double legacyMesh = timeMs([&]() {
+                float sum = 0.0f;
+                for (auto& obj : legacy) {
+                    auto* t = obj->Get<STransform>();
+                    auto* mr = obj->Get<SMeshRenderer>();
+                    if (t && mr) sum += t->position.x + (float)mr->lightmapInfosIndex;
+                }
+                sink = sink + sum;
+            });
+            double facadeMesh = timeMs([&]() {
+                float sum = 0.0f;
+                for (auto& obj : world.Objects()) {
+                    auto* t = obj->GetComponent<STransform>();
+                    auto* mr = obj->GetComponent<SMeshRenderer>();
+                    if (t && mr) sum += t->position.x + (float)mr->lightmapInfosIndex;
+                }
+                sink = sink + sum;
+            });
+            double viewMesh = timeMs([&]() {
+                float sum = 0.0f;
+                world.View<STransform, SMeshRenderer>().Each([&sum](EntityId, STransform& t, SMeshRenderer& mr) {
+                    sum += t.position.x + (float)mr.lightmapInfosIndex;
+                });
+                sink = sink + sum;
+            });
+
+            // --- Transform only ---
+            double legacyTransform = timeMs([&]() {
+                float sum = 0.0f;
+                for (auto& obj : legacy) {
+                    if (auto* t = obj->Get<STransform>()) sum += t->position.x;
+                }
+                sink = sink + sum;
+            });
+            double viewTransform = timeMs([&]() {
+                float sum = 0.0f;
+                world.View<STransform>().Each([&sum](EntityId, STransform& t) { sum += t.position.x; });
+                sink = sink + sum;
+            });
+
+            // --- Lights (sparse: 1/8 point + 1/16 spot) ---
+            double legacyLights = timeMs([&]() {
+                float sum = 0.0f;
+                for (auto& obj : legacy) {
+                    auto* t = obj->Get<STransform>();
+                    if (!t) continue;
+                    if (auto* p = obj->Get<SPointLight>()) sum += t->position.x + p->range;
+                    if (auto* s = obj->Get<SSpotLight>()) sum += t->position.x + s->range;
+                }
+                sink = sink + sum;
+            });
+            double viewLights = timeMs([&]() {
+                float sum = 0.0f;
+                world.View<STransform, SPointLight>().Each([&sum](EntityId, STransform& t, SPointLight& p) {
+                    sum += t.position.x + p.range;
+                });
+                world.View<STransform, SSpotLight>().Each([&sum](EntityId, STransform& t, SSpotLight& s) {
+                    sum += t.position.x + s.range;
+                });
+                sink = sink + sum;
+            });
+
+            auto speedup = [](double before, double after) { return after > 0.0 ? before / after : 0.0; };
+            log.LogEvent("Iteration CPU time");
+            log.LogInfo("%d entities (1/2 mesh, 1/8 point light, 1/16 spot light)", BENCH_ENTITY_COUNT);
+            log.LogInfo("Transform+Mesh : legacy %7.3f ms | facade %7.3f ms (%.1fx) | view %7.3f ms (%.1fx)",
+                        legacyMesh, facadeMesh, speedup(legacyMesh, facadeMesh), viewMesh, speedup(legacyMesh, viewMesh));
+            log.LogInfo("Transform      : legacy %7.3f ms | view %7.3f ms (%.1fx)",
+                        legacyTransform, viewTransform, speedup(legacyTransform, viewTransform));
+            log.LogInfo("Lights         : legacy %7.3f ms | view %7.3f ms (%.1fx)",
+                        legacyLights, viewLights, speedup(legacyLights, viewLights));
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, viewMesh < legacyMesh, "Transform+Mesh view is faster than the legacy layout");
+            ASSERT(ctx, viewLights < legacyLights, "Light views are faster than the legacy layout");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestComponentStorage)
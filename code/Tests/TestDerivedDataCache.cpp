@@ -0,0 +1,404 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/DerivedDataCache.h"
+#include "Core/Loader/FFMeshLoader.h"
+#include "Core/MeshResourceManager.h"
+#include "Core/TextureManager.h"
+#include "Core/PathManager.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Test: derived-data cache (content-addressed, LRU size limit)
+ *
+ * Frame 1 (CPU only, private cache directory):
+ *   - HashBytes128 matches the MurmurHash3 x64 128 reference vector
+ *   - Keys: deterministic, order / kind / version sensitive, file keys follow
+ *     the content (not the path) and change when the file changes
+ *   - Put / Get / Map round trip, payload alignment, .ffmesh opened from a mapped entry
+ *   - Corrupt payloads and misplaced entries are dropped
+ *   - LRU eviction under the size limit, recency restored from mtimes after a rescan,
+ *     leftover temporary files removed
+ *   - GetOrBuild, disabled cache, hit / miss / time-saved stats
+ *
+ * Frame 5 (benchmark):
+ *   - Hash throughput, 1 MB Put / Get / Map
+ *   - Barrel mesh and textures: cold import (miss) vs warm load (hit), DDC report
+ *
+ * Usage:
+ *   forfun.exe --test TestDerivedDataCache
+ *   Results: E:/forfun/debug/TestDerivedDataCache/test.log
+ */
+class CTestDerivedDataCache : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestDerivedDataCache";
+    }
+
+    static std::vector<uint8_t> makePayload(size_t size, uint32_t seed) {
+        std::vector<uint8_t> data(size);
+        uint32_t state = seed * 747796405u + 2891336453u;
+        for (auto& b : data) {
+            state = state * 1664525u + 1013904223u;
+            b = (uint8_t)(state >> 24);
+        }
+        return data;
+    }
+
+    static SDerivedDataKey makeKey(const char* kind, uint32_t id) {
+        return CDerivedDataKeyBuilder(kind, 1).Add(id).Build();
+    }
+
+    static void writeFile(const std::filesystem::path& path, const std::string& text) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestDerivedDataCache ===");
+            CFFLog::Info("Frame 1: keys, storage, eviction");
+
+            // --- Hash ---
+            {
+                const char* fox = "The quick brown fox jumps over the lazy dog";
+                uint64_t hash[2];
+                HashBytes128(fox, strlen(fox), 0, hash);
+                ASSERT(ctx, hash[0] == 0xe34bbc7bbc071b6cull && hash[1] == 0x7a433ca9c49a9347ull,
+                       "MurmurHash3 x64 128 reference vector");
+                HashBytes128("", 0, 0, hash);
+                ASSERT(ctx, hash[0] == 0 && hash[1] == 0, "Empty input with seed 0 hashes to 0");
+            }
+
+            std::filesystem::path dir = std::filesystem::temp_directory_path() / "forfun_test_ddc";
+            std::error_code ec;
+            std::filesystem::remove_all(dir, ec);
+            std::filesystem::create_directories(dir / "sources", ec);
+
+            // --- Keys ---
+            {
+                SDerivedDataKey a = CDerivedDataKeyBuilder("mesh", 3).Add("ab").Add("c").Build();
+                SDerivedDataKey b = CDerivedDataKeyBuilder("mesh", 3).Add("ab").Add("c").Build();
+                ASSERT(ctx, a == b, "Same inputs, same key");
+                ASSERT(ctx, !(a == CDerivedDataKeyBuilder("mesh", 3).Add("a").Add("bc").Build()), "Parts are delimited");
+                ASSERT(ctx, !(a == CDerivedDataKeyBuilder("mesh", 3).Add("c").Add("ab").Build()), "Order matters");
+                ASSERT(ctx, !(a == CDerivedDataKeyBuilder("mesh", 4).Add("ab").Add("c").Build()), "Version matters");
+                SDerivedDataKey texture = CDerivedDataKeyBuilder("texture", 3).Add("ab").Add("c").Build();
+                ASSERT(ctx, texture.hash[0] != a.hash[0], "Kind matters");
+                ASSERT_EQUAL(ctx, (int)a.ToString().size(), 5 + 32, "Key string is kind/32 hex digits");
+
+                std::filesystem::path one = dir / "sources" / "one.obj";
+                std::filesystem::path two = dir / "sources" / "two.obj";
+                writeFile(one, "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+                writeFile(two, "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+                CDerivedDataKeyBuilder k1("mesh", 1), k2("mesh", 1), k3("mesh", 1);
+                ASSERT(ctx, k1.AddFile(one.string()) && k2.AddFile(two.string()), "File keys built");
+                ASSERT(ctx, k1.Build() == k2.Build(), "Same content at another path, same key");
+
+                // Same size, new content (the mtime changes too, so the memoized hash is refreshed)
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                writeFile(one, "v 0 0 0\nv 2 0 0\nv 0 1 0\nf 1 2 3\n");
+                ASSERT(ctx, k3.AddFile(one.string()) && !(k3.Build() == k1.Build()), "Edited file, new key");
+                CDerivedDataKeyBuilder missing("mesh", 1);
+                ASSERT(ctx, !missing.AddFile((dir / "sources" / "missing.obj").string()), "Missing file has no key");
+            }
+
+            auto& ddc = CDerivedDataCache::Instance();
+            std::string previousRoot = ddc.GetRoot();
+            uint64_t previousLimit = ddc.GetSizeLimit();
+            bool previousEnabled = ddc.IsEnabled();
+            std::filesystem::path root = dir / "ddc";
+            ddc.SetRoot(root.string());
+            ddc.SetEnabled(true);
+            ddc.SetSizeLimit(kDefaultDerivedDataSizeLimit);
+            ddc.ResetStats();
+
+            // --- Round trip ---
+            {
+                SDerivedDataKey key = makeKey("blob", 1);
+                std::vector<uint8_t> payload = makePayload(10000, 1), read;
+                ASSERT(ctx, !ddc.Get(key, read), "Empty cache misses");
+                ASSERT(ctx, ddc.Put(key, payload, 50.0), "Put");
+                ASSERT(ctx, ddc.Contains(key), "Contains after Put");
+                ASSERT(ctx, ddc.Get(key, read) && read == payload, "Get returns the payload");
+
+                CMappedFile mapped;
+                size_t offset = 0;
+                ASSERT(ctx, ddc.Map(key, mapped, offset), "Map");
+                ASSERT(ctx, mapped.Size() - offset == payload.size() &&
+                            memcmp(mapped.Data() + offset, payload.data(), payload.size()) == 0, "Mapped payload");
+                ASSERT(ctx, ((uintptr_t)(mapped.Data() + offset) & 15) == 0, "Mapped payload is 16-byte aligned");
+                mapped.Close();
+
+                CDerivedDataCache::SStats stats = ddc.GetStats();
+                const CDerivedDataCache::SKindStats& s = stats.kinds["blob"];
+                ASSERT_EQUAL(ctx, (int)s.hits, 2, "Two hits");
+                ASSERT_EQUAL(ctx, (int)s.misses, 1, "One miss");
+                ASSERT_EQUAL(ctx, (int)s.puts, 1, "One put");
+                ASSERT_EQUAL_F(ctx, (float)s.buildMsSaved, 100.0f, 1e-3f, "Build time credited per hit");
+                ASSERT(ctx, s.GetTimeSavedMs() > 0.0 && s.GetTimeSavedMs() <= 100.0, "Time saved = build time - read time");
+                ASSERT_EQUAL(ctx, (int)stats.entries, 1, "One entry indexed");
+                ASSERT(ctx, stats.totalBytes == payload.size() + sizeof(SDerivedDataHeader), "Indexed size includes the header");
+
+                // Empty payloads are valid values
+                SDerivedDataKey empty = makeKey("blob", 2);
+                ASSERT(ctx, ddc.Put(empty, nullptr, 0, 1.0) && ddc.Get(empty, read) && read.empty(), "Empty payload");
+            }
+
+            // --- .ffmesh straight from a mapped entry ---
+            {
+                SMeshCPU_PNT mesh;
+                for (uint32_t i = 0; i < 4; i++) {
+                    SVertexPNT v = {};
+                    v.px = (float)(i & 1); v.pz = (float)(i >> 1); v.ny = 1.0f;
+                    mesh.vertices.push_back(v);
+                }
+                mesh.indices = {0, 2, 1, 1, 2, 3};
+                std::vector<uint8_t> bytes;
+                SerializeFFMesh(SFFMeshSourceKey(), {&mesh}, bytes);
+
+                SDerivedDataKey key = makeKey("mesh", 1);
+                CMappedFile mapped;
+                size_t offset = 0;
+                CFFMeshFile file;
+                ASSERT(ctx, ddc.Put(key, bytes, 1.0) && ddc.Map(key, mapped, offset), "Mesh entry mapped");
+                ASSERT(ctx, file.Open(std::move(mapped), offset, key.ToString()), "CFFMeshFile opens the mapped payload");
+                ASSERT(ctx, file.GetSubMeshCount() == 1 &&
+                            memcmp(file.GetVertices(0), mesh.vertices.data(), 4 * sizeof(SVertexPNT)) == 0 &&
+                            memcmp(file.GetIndices(0), mesh.indices.data(), 6 * sizeof(uint32_t)) == 0,
+                       "Mapped mesh data byte-identical");
+                ASSERT(ctx, ((uintptr_t)file.GetVertices(0) & 15) == 0, "Vertex stream 16-byte aligned in the entry");
+            }
+
+            // --- Damaged entries ---
+            {
+                SDerivedDataKey key = makeKey("blob", 3);
+                std::vector<uint8_t> payload = makePayload(4096, 3), read;
+                ddc.Put(key, payload, 1.0);
+                std::filesystem::path file = root / key.ToString();
+                file += ".ddc";
+                {
+                    std::fstream io(file, std::ios::binary | std::ios::in | std::ios::out);
+                    io.seekp(sizeof(SDerivedDataHeader) + 100);
+                    io.put((char)(payload[100] ^ 0xFF));
+                }
+                uint32_t corruptBefore = ddc.GetStats().total.corrupt;
+                ASSERT(ctx, !ddc.Get(key, read), "Corrupt payload rejected");
+                ASSERT(ctx, !ddc.Contains(key) && !std::filesystem::exists(file), "Corrupt entry deleted");
+                ASSERT_EQUAL(ctx, (int)(ddc.GetStats().total.corrupt - corruptBefore), 1, "Corrupt entry counted");
+
+                // A valid file under the wrong name (header key mismatch)
+                SDerivedDataKey source = makeKey("blob", 4), target = makeKey("blob", 5);
+                ddc.Put(source, payload, 1.0);
+                ddc.Put(target, payload, 1.0);
+                std::filesystem::path sourceFile = root / (source.ToString() + ".ddc");
+                std::filesystem::path targetFile = root / (target.ToString() + ".ddc");
+                std::filesystem::copy_file(sourceFile, targetFile, std::filesystem::copy_options::overwrite_existing, ec);
+                CMappedFile mapped;
+                size_t offset = 0;
+                ASSERT(ctx, !ddc.Map(target, mapped, offset), "Misplaced entry rejected");
+                ASSERT(ctx, ddc.Map(source, mapped, offset), "Original entry still valid");
+                mapped.Close();
+            }
+
+            // --- LRU eviction ---
+            {
+                ddc.Clear();
+                ddc.ResetStats();
+                ASSERT_EQUAL(ctx, (int)ddc.GetStats().entries, 0, "Clear removes every entry");
+
+                const size_t size = 1000;
+                const uint64_t entryBytes = size + sizeof(SDerivedDataHeader);
+                ddc.SetSizeLimit(3 * entryBytes);
+                SDerivedDataKey a = makeKey("lru", 1), b = makeKey("lru", 2), c = makeKey("lru", 3), d = makeKey("lru", 4);
+                std::vector<uint8_t> read;
+                auto step = []() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); };
+                ddc.Put(a, makePayload(size, 1), 1.0); step();
+                ddc.Put(b, makePayload(size, 2), 1.0); step();
+                ddc.Put(c, makePayload(size, 3), 1.0); step();
+                ddc.Get(a, read); step();                       // a is now newer than b and c
+                ddc.Put(d, makePayload(size, 4), 1.0); step();
+                ASSERT(ctx, !ddc.Contains(b), "Least recently used entry evicted");
+                ASSERT(ctx, ddc.Contains(a) && ddc.Contains(c) && ddc.Contains(d), "Recent entries kept");
+                ASSERT_EQUAL(ctx, (int)ddc.GetStats().kinds["lru"].evictions, 1, "One eviction");
+                ASSERT(ctx, ddc.GetStats().totalBytes <= 3 * entryBytes, "Size within the limit");
+
+                ASSERT(ctx, !ddc.Put(makeKey("lru", 5), makePayload(4 * size, 5), 1.0), "Entry above the limit refused");
+                ASSERT(ctx, ddc.Contains(a) && ddc.Contains(c) && ddc.Contains(d), "Refused Put evicts nothing");
+
+                // Rescan: recency comes back from the mtimes (c < a < d), temporaries are removed
+                std::filesystem::path temp = root / "lru" / "0123.ddc.tmp9";
+                writeFile(temp, "partial");
+                ddc.SetRoot(root.string());
+                ASSERT_EQUAL(ctx, (int)ddc.GetStats().entries, 3, "Entries found again after a rescan");
+                ASSERT(ctx, !std::filesystem::exists(temp), "Interrupted write removed");
+                ddc.SetSizeLimit(2 * entryBytes);
+                ASSERT(ctx, !ddc.Contains(c) && ddc.Contains(a) && ddc.Contains(d), "Oldest entry evicted after a rescan");
+                ASSERT(ctx, ddc.Get(a, read) && read == makePayload(size, 1), "Surviving entry intact");
+            }
+
+            // --- GetOrBuild, disabled cache ---
+            {
+                ddc.SetSizeLimit(kDefaultDerivedDataSizeLimit);
+                SDerivedDataKey key = makeKey("build", 1);
+                int builds = 0;
+                auto build = [&builds](std::vector<uint8_t>& out) {
+                    builds++;
+                    out = makePayload(256, 7);
+                    return true;
+                };
+                std::vector<uint8_t> first, second;
+                ASSERT(ctx, ddc.GetOrBuild(key, first, build) && ddc.GetOrBuild(key, second, build), "GetOrBuild");
+                ASSERT_EQUAL(ctx, builds, 1, "Second call is a hit");
+                ASSERT(ctx, first == second && first == makePayload(256, 7), "Built and cached payloads match");
+                ASSERT(ctx, !ddc.GetOrBuild(makeKey("build", 2), first, [](std::vector<uint8_t>&) { return false; }),
+                       "Failed build is reported");
+                ASSERT(ctx, !ddc.Contains(makeKey("build", 2)), "Failed build stores nothing");
+
+                ddc.SetEnabled(false);
+                ASSERT(ctx, !ddc.Put(makeKey("build", 3), first, 1.0), "Disabled: Put refused");
+                ASSERT(ctx, !ddc.Get(key, second), "Disabled: lookups miss");
+                ddc.SetEnabled(true);
+            }
+
+            ddc.LogReport();
+            ddc.SetRoot(previousRoot);
+            ddc.SetSizeLimit(previousLimit);
+            ddc.SetEnabled(previousEnabled);
+            ddc.ResetStats();
+            std::filesystem::remove_all(dir, ec);
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Derived Data Cache");
+            auto now = []() { return std::chrono::high_resolution_clock::now(); };
+            auto msSince = [](std::chrono::high_resolution_clock::time_point start) {
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+
+            // --- Raw throughput, private directory ---
+            auto& ddc = CDerivedDataCache::Instance();
+            std::string previousRoot = ddc.GetRoot();
+            std::filesystem::path dir = std::filesystem::temp_directory_path() / "forfun_bench_ddc";
+            std::error_code ec;
+            std::filesystem::remove_all(dir, ec);
+            ddc.SetRoot(dir.string());
+            {
+                std::vector<uint8_t> big = makePayload(64 << 20, 11);
+                uint64_t hash[2];
+                auto start = now();
+                HashBytes128(big.data(), big.size(), 0, hash);
+                double hashMs = msSince(start);
+                log.LogEvent("Throughput");
+                log.LogInfo("HashBytes128, 64 MB          : %8.2f ms (%.0f MB/s)", hashMs, 64.0 / (hashMs / 1000.0));
+
+                const int count = 32;
+                std::vector<uint8_t> blob = makePayload(1 << 20, 12), read;
+                start = now();
+                for (int i = 0; i < count; i++) ddc.Put(makeKey("bench", i), blob, 10.0);
+                double putMs = msSince(start);
+                start = now();
+                for (int i = 0; i < count; i++) ddc.Get(makeKey("bench", i), read);
+                double getMs = msSince(start);
+                start = now();
+                for (int i = 0; i < count; i++) {
+                    CMappedFile mapped;
+                    size_t offset = 0;
+                    ddc.Map(makeKey("bench", i), mapped, offset);
+                }
+                double mapMs = msSince(start);
+                log.LogInfo("Put 1 MB x %d                : %8.2f ms (%.3f ms each)", count, putMs, putMs / count);
+                log.LogInfo("Get 1 MB x %d (copy + hash)  : %8.2f ms (%.3f ms each)", count, getMs, getMs / count);
+                log.LogInfo("Map 1 MB x %d (header only)  : %8.2f ms (%.3f ms each)", count, mapMs, mapMs / count);
+            }
+            ddc.SetRoot(previousRoot);
+            std::filesystem::remove_all(dir, ec);
+
+            // --- Imported assets: cold (miss, import + Put) vs warm (hit) ---
+            ddc.ResetStats();
+            auto& meshes = CMeshResourceManager::Instance();
+            auto& textures = CTextureManager::Instance();
+            const char* meshPath = "pbr_models/Barrel_01_1k.gltf/Barrel_01_1k.gltf";
+            struct STextureCase { const char* path; bool srgb; };
+            const STextureCase textureCases[] = {
+                {"pbr_models/Barrel_01_1k.gltf/Barrel_01_1k_albedo.png", true},
+                {"pbr_models/Barrel_01_1k.gltf/Barrel_01_1k_normal.png", false},
+            };
+
+            log.LogEvent("Cold vs warm load (ms)");
+            std::string fullMesh = FFPath::GetAbsolutePath(meshPath);
+            if (std::filesystem::exists(fullMesh)) {
+                SDerivedDataKey key;
+                if (meshes.MakeDerivedDataKey(fullMesh, true, key)) {
+                    ddc.Remove(key);
+                }
+                double ms[2];
+                for (double& t : ms) {
+                    meshes.ClearCache();
+                    auto start = now();
+                    meshes.GetOrLoad(fullMesh, false, true);
+                    t = msSince(start);
+                }
+                log.LogInfo("%-60s : cold %8.2f | warm %7.2f", meshPath, ms[0], ms[1]);
+                meshes.ClearCache();
+            }
+            for (const STextureCase& tex : textureCases) {
+                std::string full = FFPath::GetAbsolutePath(tex.path);
+                if (!std::filesystem::exists(full)) {
+                    log.LogInfo("%-60s : missing, skipped", tex.path);
+                    continue;
+                }
+                SDerivedDataKey key;
+                if (CTextureManager::MakeCookKey(full, tex.srgb, textures.GetCookOptions(), key)) {
+                    ddc.Remove(key);
+                }
+                double ms[2];
+                for (double& t : ms) {
+                    textures.Clear();
+                    auto start = now();
+                    textures.Load(tex.path, tex.srgb);
+                    t = msSince(start);
+                }
+                log.LogInfo("%-60s : cold %8.2f | warm %7.2f", tex.path, ms[0], ms[1]);
+            }
+            textures.Clear();
+
+            CDerivedDataCache::SStats stats = ddc.GetStats();
+            log.LogEvent("DDC stats");
+            for (const auto& [kind, s] : stats.kinds) {
+                log.LogInfo("%-8s : %u hits, %u misses, %u puts, %.2f MB read, saved %.2f ms",
+                            kind.c_str(), s.hits, s.misses, s.puts, s.bytesRead / (1024.0 * 1024.0), s.GetTimeSavedMs());
+            }
+            ddc.LogReport();
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, stats.total.hits >= stats.total.puts, "Every cold import is followed by a hit");
+            ASSERT(ctx, stats.total.GetTimeSavedMs() > 0.0, "Hits save time");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestDerivedDataCache)
@@ -0,0 +1,383 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Engine/World.h"
+#include "Engine/GameObject.h"
+#include "Engine/FFSceneFile.h"
+#include "Engine/SceneSerializer.h"
+#include "Engine/SceneLightSettings.h"
+#include "Engine/Components/Transform.h"
+#include "Engine/Components/MeshRenderer.h"
+#include "Engine/Components/PointLight.h"
+#include "Engine/Components/LightProbe.h"
+#include "Engine/Components/DirectionalLight.h"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+
+/**
+ * Test: binary .ffscene format (string table, component columns, mmap, regions)
+ *
+ * Frame 1 (CPU only, private directory):
+ *   - World -> .ffscene -> world keeps names, parent links, every component
+ *     property and the light settings
+ *   - JSON -> .ffscene -> JSON converter round trip gives the same JSON file
+ *   - Open maps the file without creating objects
+ *   - Region streaming: only objects in the box (+ ancestors, + objects without
+ *     a Transform), nothing created twice, Instantiate completes the rest
+ *   - Truncated / foreign files are rejected and leave the world untouched
+ *
+ * Frame 5 (benchmark, 100k objects):
+ *   - JSON vs .ffscene: save time, file size, full load time
+ *   - .ffscene Open only (lazy) and one 1/16 region
+ *
+ * Usage:
+ *   forfun.exe --test TestFFScene
+ *   Results: E:/forfun/debug/TestFFScene/test.log
+ */
+class CTestFFScene : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestFFScene";
+    }
+
+    static const int BENCH_OBJECT_COUNT = 100000;
+
+    static int parentIndex(const CWorld& world, size_t i) {
+        const STransform* t = world.Get(i)->GetComponent<STransform>();
+        if (!t || !t->GetParent()) return -1;
+        for (size_t p = 0; p < world.Count(); p++) {
+            if (world.Get(p)->GetComponent<STransform>() == t->GetParent()) return (int)p;
+        }
+        return -2;
+    }
+
+    static std::string readText(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    static void buildSampleWorld(CWorld& world, CSceneLightSettings& settings) {
+        STransform* root = world.Create("Root")->AddComponent<STransform>();
+        root->position = {1.0f, 2.0f, 3.0f};
+        root->scale = {2.0f, 2.0f, 2.0f};
+        root->SetRotationEuler({0.1f, 0.5f, -0.2f});
+
+        CGameObject* child = world.Create("Child");
+        STransform* childTransform = child->AddComponent<STransform>();
+        childTransform->position = {0.0f, 1.0f, 0.0f};
+        childTransform->SetParent(root, false);
+        SMeshRenderer* mesh = child->AddComponent<SMeshRenderer>();
+        mesh->path = "pbr_models/Barrel_01_1k.gltf/Barrel_01_1k.gltf";
+        mesh->materialPath = "materials/barrel.ffasset";
+        mesh->subMeshFirst = 1;
+        mesh->subMeshCount = 2;
+        mesh->lightmapInfosIndex = 7;
+        mesh->showBounds = true;
+
+        CGameObject* light = world.Create("Light");
+        light->AddComponent<STransform>()->position = {-4.0f, 3.0f, 8.0f};
+        SPointLight* point = light->AddComponent<SPointLight>();
+        point->color = {1.0f, 0.5f, 0.25f};
+        point->intensity = 3.5f;
+        point->range = 12.0f;
+
+        CGameObject* probe = world.Create("Probe");
+        probe->AddComponent<STransform>()->position = {5.0f, 1.0f, -5.0f};
+        SLightProbe* sh = probe->AddComponent<SLightProbe>();
+        sh->radius = 6.0f;
+        for (int i = 0; i < 9; i++) sh->shCoeffs[i] = {0.1f * i, -0.05f * i, 0.3f};
+
+        // No Transform: loaded with every region
+        SDirectionalLight* sun = world.Create("Sun")->AddComponent<SDirectionalLight>();
+        sun->intensity = 2.0f;
+        sun->shadow_map_size_index = 2;
+        sun->cascade_count = 3;
+        sun->enable_soft_shadows = false;
+
+        world.Create("Empty");
+
+        settings.skyboxAssetPath = "skybox/test/test.ffasset";
+        settings.diffuseGIMode = EDiffuseGIMode::Lightmap2D;
+        settings.gBufferDebugMode = EGBufferDebugMode::Normal;
+        settings.volumetricLightmap.volumeMin = {-10.0f, -1.0f, -10.0f};
+        settings.volumetricLightmap.volumeMax = {10.0f, 5.0f, 10.0f};
+        settings.volumetricLightmap.minBrickWorldSize = 4.0f;
+        settings.volumetricLightmap.enabled = true;
+    }
+
+    static bool sameWorld(const CWorld& a, const CWorld& b) {
+        if (a.Count() != b.Count()) return false;
+        for (size_t i = 0; i < a.Count(); i++) {
+            if (CSceneSerializer::SerializeGameObject(a.Get(i)) != CSceneSerializer::SerializeGameObject(b.Get(i)) ||
+                parentIndex(a, i) != parentIndex(b, i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool sameSettings(const CSceneLightSettings& a, const CSceneLightSettings& b) {
+        const auto& va = a.volumetricLightmap;
+        const auto& vb = b.volumetricLightmap;
+        return a.skyboxAssetPath == b.skyboxAssetPath && a.diffuseGIMode == b.diffuseGIMode &&
+               a.gBufferDebugMode == b.gBufferDebugMode &&
+               va.volumeMin.x == vb.volumeMin.x && va.volumeMin.y == vb.volumeMin.y && va.volumeMin.z == vb.volumeMin.z &&
+               va.volumeMax.x == vb.volumeMax.x && va.volumeMax.y == vb.volumeMax.y && va.volumeMax.z == vb.volumeMax.z &&
+               va.minBrickWorldSize == vb.minBrickWorldSize && va.enabled == vb.enabled;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestFFScene ===");
+            CFFLog::Info("Frame 1: format, converter, streaming");
+
+            std::filesystem::path dir = std::filesystem::temp_directory_path() / "forfun_test_ffscene";
+            std::error_code ec;
+            std::filesystem::remove_all(dir, ec);
+            std::filesystem::create_directories(dir, ec);
+
+            CWorld world;
+            CSceneLightSettings settings;
+            buildSampleWorld(world, settings);
+
+            // --- Binary round trip ---
+            std::string binPath = (dir / "sample.ffscene").string();
+            ASSERT(ctx, CSceneSerializer::IsBinaryScenePath(binPath), ".ffscene is binary");
+            ASSERT(ctx, !CSceneSerializer::IsBinaryScenePath((dir / "sample.scene").string()), ".scene is JSON");
+            ASSERT(ctx, CSceneSerializer::SaveWorld(world, settings, binPath), "Save .ffscene");
+            {
+                CWorld loaded;
+                CSceneLightSettings loadedSettings;
+                loaded.Create("Stale");
+                ASSERT(ctx, CSceneSerializer::LoadWorld(loaded, loadedSettings, binPath), "Load .ffscene");
+                ASSERT_EQUAL(ctx, (int)loaded.Count(), (int)world.Count(), "Object count (previous objects cleared)");
+                ASSERT(ctx, sameWorld(world, loaded), "Names, parents and properties survive the round trip");
+                ASSERT(ctx, sameSettings(settings, loadedSettings), "Light settings survive the round trip");
+
+                XMFLOAT3 a = world.Get(1)->GetComponent<STransform>()->GetWorldPosition();
+                XMFLOAT3 b = loaded.Get(1)->GetComponent<STransform>()->GetWorldPosition();
+                ASSERT(ctx, std::fabs(a.x - b.x) + std::fabs(a.y - b.y) + std::fabs(a.z - b.z) < 1e-4f,
+                       "Child world position matches (local values + parent link)");
+            }
+
+            // --- Converter: JSON -> .ffscene -> JSON ---
+            {
+                std::filesystem::path json = dir / "sample.scene";
+                std::filesystem::path converted = dir / "converted.ffscene";
+                std::filesystem::path back = dir / "roundtrip.scene";
+                ASSERT(ctx, CSceneSerializer::SaveWorld(world, settings, json.string()), "Save JSON");
+                ASSERT(ctx, CSceneSerializer::ConvertScene(json.string(), converted.string()), "Convert JSON to .ffscene");
+                ASSERT(ctx, CSceneSerializer::ConvertScene(converted.string(), back.string()), "Convert .ffscene to JSON");
+                std::string original = readText(json);
+                ASSERT(ctx, !original.empty() && original == readText(back), "JSON -> .ffscene -> JSON is lossless");
+            }
+
+            // --- Lazy open ---
+            {
+                CFFSceneFile file;
+                ASSERT(ctx, file.Open(binPath), "Open .ffscene");
+                ASSERT_EQUAL(ctx, (int)file.GetObjectCount(), (int)world.Count(), "Object count from the header");
+                ASSERT_EQUAL(ctx, (int)file.GetInstanceCount(), 0, "Open creates no objects");
+                ASSERT(ctx, file.GetObjectName(1) == "Child" && file.GetParent(1) == 0, "Name and parent readable from the map");
+                CSceneLightSettings read;
+                file.ReadLightSettings(read);
+                ASSERT(ctx, sameSettings(settings, read), "Light settings readable without objects");
+            }
+
+            // --- Region streaming ---
+            {
+                CWorld grid;
+                CSceneLightSettings gridSettings;
+                for (int z = 0; z < 8; z++) {
+                    for (int x = 0; x < 8; x++) {
+                        CGameObject* go = grid.Create("Cell_" + std::to_string(x) + "_" + std::to_string(z));
+                        go->AddComponent<STransform>()->position = {x * 10.0f - 35.0f, 0.0f, z * 10.0f - 35.0f};
+                        go->AddComponent<SPointLight>()->range = (float)(x + z);
+                    }
+                }
+                // Far-away group whose child sits at (5, 0, 5)
+                STransform* group = grid.Create("Group")->AddComponent<STransform>();
+                group->position = {500.0f, 0.0f, 500.0f};
+                STransform* member = grid.Create("Member")->AddComponent<STransform>();
+                member->position = {-495.0f, 0.0f, -495.0f};
+                member->SetParent(group, false);
+                grid.Create("Global")->AddComponent<SDirectionalLight>();
+
+                std::string gridPath = (dir / "grid.ffscene").string();
+                ASSERT(ctx, WriteFFScene(gridPath, grid, gridSettings, 20.0f), "Write grid with 20 m cells");
+
+                CFFSceneFile file;
+                ASSERT(ctx, file.Open(gridPath), "Open grid");
+                CWorld streamed;
+                uint32_t first = file.InstantiateRegion(streamed, {-40.0f, -10.0f, -40.0f}, {-0.5f, 10.0f, -0.5f});
+                ASSERT_EQUAL(ctx, (int)first, 17, "Region -x -z: 16 cells + the global object");
+                ASSERT_EQUAL(ctx, (int)file.InstantiateRegion(streamed, {-40.0f, -10.0f, -40.0f}, {-0.5f, 10.0f, -0.5f}), 0,
+                             "Same region again creates nothing");
+                uint32_t second = file.InstantiateRegion(streamed, {0.0f, -10.0f, 0.0f}, {40.0f, 10.0f, 40.0f});
+                ASSERT_EQUAL(ctx, (int)second, 18, "Region +x +z: 16 cells + member + its far-away parent");
+
+                const uint32_t memberIndex = 65;
+                CGameObject* memberGo = file.GetInstance(memberIndex);
+                CGameObject* groupGo = file.GetInstance(memberIndex - 1);
+                ASSERT(ctx, memberGo && groupGo && memberGo->GetComponent<STransform>()->GetParent() ==
+                       groupGo->GetComponent<STransform>(), "Member parented to its group");
+                if (memberGo) {
+                    XMFLOAT3 p = memberGo->GetComponent<STransform>()->GetWorldPosition();
+                    ASSERT(ctx, std::fabs(p.x - 5.0f) < 1e-3f && std::fabs(p.z - 5.0f) < 1e-3f, "Member world position");
+                }
+                CGameObject* cell = file.GetInstance(7 * 8 + 7);
+                ASSERT(ctx, cell && cell->GetName() == "Cell_7_7" && cell->GetComponent<SPointLight>() &&
+                       cell->GetComponent<SPointLight>()->range == 14.0f, "Streamed object has its components");
+
+                uint32_t rest = file.Instantiate(streamed);
+                ASSERT_EQUAL(ctx, (int)(first + second + rest), (int)grid.Count(), "Instantiate creates the rest");
+                ASSERT_EQUAL(ctx, (int)streamed.Count(), (int)grid.Count(), "Every object exactly once");
+            }
+
+            // --- Rejected files ---
+            {
+                std::string bytes = readText(binPath);
+                std::filesystem::path truncated = dir / "truncated.ffscene";
+                std::ofstream(truncated, std::ios::binary).write(bytes.data(), bytes.size() / 2);
+                std::filesystem::path foreign = dir / "foreign.ffscene";
+                std::filesystem::copy_file(dir / "sample.scene", foreign, ec);
+
+                CFFSceneFile file;
+                ASSERT(ctx, !file.Open(truncated.string()), "Truncated file rejected");
+                ASSERT(ctx, !file.Open(foreign.string()), "JSON content with a .ffscene name rejected");
+                ASSERT(ctx, !file.Open((dir / "missing.ffscene").string()), "Missing file rejected");
+
+                CWorld kept;
+                CSceneLightSettings keptSettings;
+                kept.Create("Kept");
+                ASSERT(ctx, !CSceneSerializer::LoadWorld(kept, keptSettings, truncated.string()), "LoadWorld fails");
+                ASSERT_EQUAL(ctx, (int)kept.Count(), 1, "Failed load leaves the world untouched");
+            }
+
+            std::filesystem::remove_all(dir, ec);
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "FFScene vs JSON (100k objects)");
+            auto now = []() { return std::chrono::high_resolution_clock::now(); };
+            auto msSince = [](std::chrono::high_resolution_clock::time_point start) {
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+
+            std::filesystem::path dir = std::filesystem::temp_directory_path() / "forfun_bench_ffscene";
+            std::error_code ec;
+            std::filesystem::remove_all(dir, ec);
+            std::filesystem::create_directories(dir, ec);
+            std::string jsonPath = (dir / "big.scene").string();
+            std::string binPath = (dir / "big.ffscene").string();
+
+            // 2 km x 2 km, groups of 10 (one parent, 9 children), a third with meshes, a tenth with lights
+            const float extent = 2000.0f;
+            double saveMs[2], loadMs[2];
+            uint64_t sizes[2];
+            {
+                CWorld world;
+                CSceneLightSettings settings;
+                uint32_t state = 12345u;
+                auto rnd = [&state]() { state = state * 1664525u + 1013904223u; return (state >> 8) / 16777216.0f; };
+                STransform* groupRoot = nullptr;
+                for (int i = 0; i < BENCH_OBJECT_COUNT; i++) {
+                    CGameObject* go = world.Create("Object_" + std::to_string(i));
+                    STransform* t = go->AddComponent<STransform>();
+                    if (i % 10 == 0) {
+                        t->position = {(rnd() - 0.5f) * extent, 0.0f, (rnd() - 0.5f) * extent};
+                        groupRoot = t;
+                    } else {
+                        t->position = {(rnd() - 0.5f) * 20.0f, rnd() * 5.0f, (rnd() - 0.5f) * 20.0f};
+                        t->SetParent(groupRoot, false);
+                    }
+                    t->SetRotationEuler({0.0f, rnd() * 6.28f, 0.0f});
+                    if (i % 3 == 0) {
+                        SMeshRenderer* mesh = go->AddComponent<SMeshRenderer>();
+                        mesh->path = "props/prop_" + std::to_string(i % 8) + ".gltf";
+                        mesh->materialPath = "materials/prop_" + std::to_string(i % 8) + ".ffasset";
+                    }
+                    if (i % 10 == 5) {
+                        go->AddComponent<SPointLight>()->range = 5.0f + rnd() * 10.0f;
+                    }
+                }
+
+                const std::string paths[2] = {jsonPath, binPath};
+                for (int f = 0; f < 2; f++) {
+                    auto start = now();
+                    CSceneSerializer::SaveWorld(world, settings, paths[f]);
+                    saveMs[f] = msSince(start);
+                    sizes[f] = std::filesystem::file_size(paths[f], ec);
+                }
+            }
+
+            size_t loadedCount[2] = {0, 0};
+            const std::string paths[2] = {jsonPath, binPath};
+            for (int f = 0; f < 2; f++) {
+                CWorld loaded;
+                CSceneLightSettings settings;
+                auto start = now();
+                CSceneSerializer::LoadWorld(loaded, settings, paths[f]);
+                loadMs[f] = msSince(start);
+                loadedCount[f] = loaded.Count();
+            }
+
+            double openMs = 0.0, regionMs = 0.0;
+            uint32_t regionCount = 0;
+            {
+                CFFSceneFile file;
+                auto start = now();
+                file.Open(binPath);
+                openMs = msSince(start);
+
+                CWorld streamed;
+                start = now();
+                regionCount = file.InstantiateRegion(streamed, {-extent / 8, -100.0f, -extent / 8}, {extent / 8, 100.0f, extent / 8});
+                regionMs = msSince(start);
+            }
+
+            log.LogEvent("Results");
+            log.LogInfo("%-24s : %10s | %10s | %10s", "", "save (ms)", "load (ms)", "size (KB)");
+            log.LogInfo("%-24s : %10.1f | %10.1f | %10.1f", "JSON .scene", saveMs[0], loadMs[0], sizes[0] / 1024.0);
+            log.LogInfo("%-24s : %10.1f | %10.1f | %10.1f", "Binary .ffscene", saveMs[1], loadMs[1], sizes[1] / 1024.0);
+            log.LogInfo("Speedup: save x%.1f, load x%.1f, size x%.1f smaller",
+                        saveMs[0] / saveMs[1], loadMs[0] / loadMs[1], (double)sizes[0] / (double)sizes[1]);
+            log.LogInfo(".ffscene Open (map + validate, no objects) : %8.2f ms", openMs);
+            log.LogInfo(".ffscene 1/16 region                      : %8.2f ms (%u objects)", regionMs, regionCount);
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+            std::filesystem::remove_all(dir, ec);
+
+            ASSERT_EQUAL(ctx, (int)loadedCount[0], BENCH_OBJECT_COUNT, "JSON loads every object");
+            ASSERT_EQUAL(ctx, (int)loadedCount[1], BENCH_OBJECT_COUNT, "Binary loads every object");
+            ASSERT(ctx, sizes[1] < sizes[0], ".ffscene is smaller than JSON");
+            ASSERT(ctx, loadMs[1] < loadMs[0], ".ffscene loads faster than JSON");
+            ASSERT(ctx, regionCount > 0 && regionCount < (uint32_t)BENCH_OBJECT_COUNT / 4, "Region loads a fraction of the world");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestFFScene)
@@ -0,0 +1,213 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/Testing/RenderStats.h"
+#include "Core/FFLog.h"
+#include "Engine/Rendering/FrustumCulling.h"
+#include <DirectXMath.h>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+/**
+ * Test: Frustum culling (CPU only, synthetic scene)
+ *
+ * Correctness (Frame 1):
+ *   - 100k random AABBs vs camera + 4 orthographic cascades
+ *   - SIMD kernel returns exactly the scalar result
+ *   - Conservative: any box with a corner inside the clip volume is visible
+ *   - Known cases: box behind camera / outside cascade is culled
+ *   - CRenderStats reports visible / culled counts
+ *
+ * Benchmark (Frame 5):
+ *   - Scalar vs SIMD, objects/s for 5 views
+ *
+ * Usage:
+ *   forfun.exe --test TestFrustumCulling
+ *   Results: E:/forfun/debug/TestFrustumCulling/test.log
+ */
+class CTestFrustumCulling : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestFrustumCulling";
+    }
+
+    static const int OBJECT_COUNT = 100000;
+    static const int CASCADE_COUNT = 4;
+
+    // Synthetic scene: boxes scattered in a 400m cube around the origin
+    static void buildScene(SCullBounds& bounds) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> pos(-200.0f, 200.0f);
+        std::uniform_real_distribution<float> size(0.1f, 4.0f);
+        bounds.Clear();
+        bounds.Reserve(OBJECT_COUNT);
+        for (int i = 0; i < OBJECT_COUNT; i++) {
+            bounds.Add({pos(rng), pos(rng) * 0.25f, pos(rng)}, {size(rng), size(rng), size(rng)});
+        }
+    }
+
+    // Camera at the origin looking down +Z, plus 4 light-space ortho cascades along the view
+    static int buildViews(XMMATRIX outViewProj[1 + CASCADE_COUNT]) {
+        XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0, 2, 0, 1), XMVectorSet(0, 2, 1, 1), XMVectorSet(0, 1, 0, 0));
+        XMMATRIX proj = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 150.0f);
+        outViewProj[0] = view * proj;
+
+        XMVECTOR lightDir = XMVector3Normalize(XMVectorSet(0.3f, -1.0f, 0.4f, 0));
+        const float splits[CASCADE_COUNT + 1] = {0.1f, 10.0f, 30.0f, 70.0f, 150.0f};
+        for (int c = 0; c < CASCADE_COUNT; c++) {
+            float center = (splits[c] + splits[c + 1]) * 0.5f;
+            float radius = (splits[c + 1] - splits[c]) * 0.5f + splits[c + 1] * 0.5f;
+            XMVECTOR target = XMVectorSet(0, 2, center, 1);
+            XMMATRIX lightView = XMMatrixLookAtLH(XMVectorSubtract(target, XMVectorScale(lightDir, 100.0f)),
+                                                  target, XMVectorSet(0, 0, 1, 0));
+            XMMATRIX lightProj = XMMatrixOrthographicOffCenterLH(-radius, radius, -radius, radius, 0.0f, 200.0f);
+            outViewProj[1 + c] = lightView * lightProj;
+        }
+        return 1 + CASCADE_COUNT;
+    }
+
+    static bool cornerInClipVolume(const SCullBounds& b, size_t i, const XMMATRIX& viewProj) {
+        for (int corner = 0; corner < 8; corner++) {
+            XMVECTOR p = XMVectorSet(
+                b.centerX[i] + ((corner & 1) ? b.extentX[i] : -b.extentX[i]),
+                b.centerY[i] + ((corner & 2) ? b.extentY[i] : -b.extentY[i]),
+                b.centerZ[i] + ((corner & 4) ? b.extentZ[i] : -b.extentZ[i]), 1.0f);
+            XMFLOAT4 clip;
+            XMStoreFloat4(&clip, XMVector4Transform(p, viewProj));
+            // Small margin: clip-space z loses precision near a perspective far plane
+            float inner = clip.w * (1.0f - 1e-3f);
+            if (clip.w > 0.0f && std::fabs(clip.x) <= inner && std::fabs(clip.y) <= inner &&
+                clip.z >= clip.w * 1e-3f && clip.z <= inner) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestFrustumCulling ===");
+            CFFLog::Info("Frame 1: Correctness checks");
+
+            SCullBounds bounds;
+            buildScene(bounds);
+
+            XMMATRIX viewProjs[1 + CASCADE_COUNT];
+            int viewCount = buildViews(viewProjs);
+            SFrustumPlanes frusta[1 + CASCADE_COUNT];
+            for (int v = 0; v < viewCount; v++) {
+                frusta[v] = SFrustumPlanes::FromViewProj(viewProjs[v]);
+            }
+
+            std::vector<uint8_t> scalarMasks(OBJECT_COUNT), simdMasks(OBJECT_COUNT);
+            FrustumCulling::CullBounds(bounds, frusta, viewCount, scalarMasks.data(), ECullKernel::Scalar);
+            FrustumCulling::CullBounds(bounds, frusta, viewCount, simdMasks.data(), ECullKernel::SIMD);
+
+            int kernelMismatches = 0;
+            for (int i = 0; i < OBJECT_COUNT; i++) {
+                if (scalarMasks[i] != simdMasks[i]) kernelMismatches++;
+            }
+            ASSERT_EQUAL(ctx, kernelMismatches, 0, "SIMD kernel matches scalar kernel");
+
+            // No false negatives
+            int falseNegatives = 0;
+            int visible[1 + CASCADE_COUNT] = {};
+            for (int i = 0; i < OBJECT_COUNT; i++) {
+                for (int v = 0; v < viewCount; v++) {
+                    bool culledVisible = (simdMasks[i] >> v) & 1;
+                    if (culledVisible) visible[v]++;
+                    if (!culledVisible && cornerInClipVolume(bounds, i, viewProjs[v])) falseNegatives++;
+                }
+            }
+            ASSERT_EQUAL(ctx, falseNegatives, 0, "Boxes with a corner inside a frustum are never culled");
+            ASSERT_IN_RANGE(ctx, visible[0], 1, OBJECT_COUNT - 1, "Camera culls part of the scene");
+
+            // Known cases
+            SCullBounds known;
+            known.Add({0, 2, 20}, {1, 1, 1});      // In front of camera, inside cascade 1
+            known.Add({0, 2, -20}, {1, 1, 1});     // Behind camera
+            known.Add({0, 2, 500}, {1, 1, 1});     // Beyond far plane and all cascades
+            uint8_t knownMasks[3];
+            FrustumCulling::CullBounds(known, frusta, viewCount, knownMasks);
+            ASSERT(ctx, (knownMasks[0] & 1) != 0, "Box in front of the camera is visible");
+            ASSERT(ctx, (knownMasks[1] & 1) == 0, "Box behind the camera is culled");
+            ASSERT_EQUAL(ctx, (int)knownMasks[2], 0, "Box beyond far plane is culled by every view");
+
+            // Transformed bounds: 90 degree rotation swaps extents
+            SCullBounds rotated;
+            rotated.AddTransformed({-1, -2, -3}, {1, 2, 3}, XMMatrixRotationY(XM_PIDIV2) * XMMatrixTranslation(5, 0, 0));
+            ASSERT_EQUAL_F(ctx, rotated.centerX[0], 5.0f, 1e-4f, "Transformed center");
+            ASSERT_EQUAL_F(ctx, rotated.extentX[0], 3.0f, 1e-4f, "Rotated extent X");
+            ASSERT_EQUAL_F(ctx, rotated.extentZ[0], 1.0f, 1e-4f, "Rotated extent Z");
+
+            // Stats
+            auto& stats = CRenderStats::Instance();
+            for (int v = 0; v < viewCount; v++) {
+                stats.RecordCulling(v, OBJECT_COUNT, visible[v]);
+            }
+            ASSERT_EQUAL(ctx, stats.GetVisibleCount(0), visible[0], "RenderStats visible count");
+            ASSERT_EQUAL(ctx, stats.GetCulledCount(0), OBJECT_COUNT - visible[0], "RenderStats culled count");
+
+            for (int v = 0; v < viewCount; v++) {
+                CFFLog::Info("View %d: %d visible, %d culled", v, visible[v], OBJECT_COUNT - visible[v]);
+            }
+            CFFLog::Info("✓ Frame 1: Correctness checks passed");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Frustum Culling");
+
+            SCullBounds bounds;
+            buildScene(bounds);
+            XMMATRIX viewProjs[1 + CASCADE_COUNT];
+            int viewCount = buildViews(viewProjs);
+            SFrustumPlanes frusta[1 + CASCADE_COUNT];
+            for (int v = 0; v < viewCount; v++) {
+                frusta[v] = SFrustumPlanes::FromViewProj(viewProjs[v]);
+            }
+            std::vector<uint8_t> masks(OBJECT_COUNT);
+
+            log.LogEvent("CullBounds");
+            log.LogInfo("%d objects, %d views", OBJECT_COUNT, viewCount);
+            const int iterations = 20;
+            double scalarMs = 0.0;
+            for (ECullKernel kernel : {ECullKernel::Scalar, ECullKernel::SIMD}) {
+                auto start = std::chrono::high_resolution_clock::now();
+                for (int it = 0; it < iterations; it++) {
+                    FrustumCulling::CullBounds(bounds, frusta, viewCount, masks.data(), kernel);
+                }
+                auto end = std::chrono::high_resolution_clock::now();
+                double ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+
+                bool isScalar = (kernel == ECullKernel::Scalar);
+                if (isScalar) scalarMs = ms;
+                log.LogInfo("%-6s: %7.3f ms | %.1f M objects/s | speedup %.2fx",
+                            isScalar ? "Scalar" : "SIMD", ms, OBJECT_COUNT / ms / 1000.0,
+                            (ms > 0.0) ? scalarMs / ms : 0.0);
+            }
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestFrustumCulling)
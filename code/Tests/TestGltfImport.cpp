@@ -0,0 +1,473 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/GpuMeshResource.h"
+#include "Core/Loader/GltfLoader.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/PathManager.h"
+#include "Engine/Scene.h"
+#include "Engine/Components/Transform.h"
+#include "Engine/Components/MeshRenderer.h"
+#include "cgltf.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Test: glTF import (LoadGLTFScene, CScene::ImportModel)
+ *
+ * The previous per-element loader (cgltf_accessor_read_float / read_index for
+ * every vertex) is kept below as the reference; the bulk-copy loader must
+ * produce byte-identical primitives.
+ *
+ * Frame 1 (CPU):
+ *   - Generated .gltf + .bin: interleaved float attributes, normalized
+ *     UNSIGNED_SHORT UVs, 16-bit / missing indices, a skipped LINES primitive
+ *   - Mesh -> primitive ranges, node order / parents / meshes, right- to
+ *     left-handed TRS (incl. a matrix node), winding, generated tangents
+ *   - Serial, parallel and reference output identical; tables-only load
+ *   - ImportModel: one object per node, shared mesh ranges, hierarchy
+ *
+ * Frame 3 (GPU): instanced nodes share the uploaded GpuMeshResource
+ *
+ * Frame 5 (benchmark): Sponza-sized generated scene (and project glTF files
+ * if present), reference vs bulk copy (serial / parallel)
+ *
+ * Usage:
+ *   forfun.exe --test TestGltfImport
+ *   Results: E:/forfun/debug/TestGltfImport/test.log
+ */
+class CTestGltfImport : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestGltfImport";
+    }
+
+    // Minimal glTF writer: one .bin buffer, views / accessors appended in order
+    struct SGltfWriter {
+        std::vector<uint8_t> bin;
+        std::string views, accessors, meshes, nodes;
+        int viewCount = 0, accessorCount = 0;
+
+        static void append(std::string& list, const std::string& item) {
+            if (!list.empty()) list += ",";
+            list += item;
+        }
+        int addView(const void* data, size_t bytes, size_t stride = 0) {
+            while (bin.size() % 4) bin.push_back(0);
+            size_t offset = bin.size();
+            bin.insert(bin.end(), (const uint8_t*)data, (const uint8_t*)data + bytes);
+            char json[160];
+            if (stride) {
+                snprintf(json, sizeof(json), "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu,\"byteStride\":%zu}", offset, bytes, stride);
+            } else {
+                snprintf(json, sizeof(json), "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu}", offset, bytes);
+            }
+            append(views, json);
+            return viewCount++;
+        }
+        // componentType: 5121 UBYTE, 5123 USHORT, 5125 UINT, 5126 FLOAT
+        int addAccessor(int view, size_t offset, int componentType, size_t count, const char* type, bool normalized = false) {
+            char json[200];
+            snprintf(json, sizeof(json), "{\"bufferView\":%d,\"byteOffset\":%zu,\"componentType\":%d,\"count\":%zu,\"type\":\"%s\"%s}",
+                     view, offset, componentType, count, type, normalized ? ",\"normalized\":true" : "");
+            append(accessors, json);
+            return accessorCount++;
+        }
+        void addMesh(const std::string& name, const std::string& primitives) {
+            append(meshes, "{\"name\":\"" + name + "\",\"primitives\":[" + primitives + "]}");
+        }
+        void addNode(const std::string& json) { append(nodes, json); }
+
+        bool write(const std::filesystem::path& gltfPath, const std::string& rootNodes) const {
+            std::filesystem::create_directories(gltfPath.parent_path());
+            std::filesystem::path binPath = gltfPath;
+            binPath.replace_extension(".bin");
+            std::ofstream binFile(binPath, std::ios::binary | std::ios::trunc);
+            binFile.write((const char*)bin.data(), (std::streamsize)bin.size());
+
+            std::string json = "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[" + rootNodes + "]}],"
+                "\"nodes\":[" + nodes + "],\"meshes\":[" + meshes + "],"
+                "\"buffers\":[{\"uri\":\"" + binPath.filename().string() + "\",\"byteLength\":" + std::to_string(bin.size()) + "}],"
+                "\"bufferViews\":[" + views + "],\"accessors\":[" + accessors + "]}";
+            std::ofstream gltfFile(gltfPath, std::ios::binary | std::ios::trunc);
+            gltfFile.write(json.data(), (std::streamsize)json.size());
+            return binFile.good() && gltfFile.good();
+        }
+    };
+
+    // Quad (interleaved P/N, UNSIGNED_SHORT UVs, 16-bit indices) used by nodes A and B,
+    // triangle (no indices) + LINES primitive used by node C, root node given as a matrix,
+    // one node outside the scene
+    static bool writeSmallScene(const std::filesystem::path& path) {
+        SGltfWriter w;
+        const float pn[4][6] = {
+            {0, 0, 0, 0, 0, 1}, {1, 0, 0, 0, 0, 1}, {1, 1, 0, 0, 0, 1}, {0, 1, 0, 0, 0, 1},
+        };
+        const uint16_t uv[4][2] = {{0, 0}, {65535, 0}, {65535, 65535}, {0, 65535}};
+        const uint16_t quadIndices[6] = {0, 1, 2, 0, 2, 3};
+        const float tri[3][3] = {{0, 0, 0}, {0, 0, 1}, {1, 0, 0}};
+
+        int pnView = w.addView(pn, sizeof(pn), 6 * sizeof(float));
+        int pos = w.addAccessor(pnView, 0, 5126, 4, "VEC3");
+        int nrm = w.addAccessor(pnView, 3 * sizeof(float), 5126, 4, "VEC3");
+        int uv0 = w.addAccessor(w.addView(uv, sizeof(uv)), 0, 5123, 4, "VEC2", true);
+        int idx = w.addAccessor(w.addView(quadIndices, sizeof(quadIndices)), 0, 5123, 6, "SCALAR");
+        int triPos = w.addAccessor(w.addView(tri, sizeof(tri)), 0, 5126, 3, "VEC3");
+
+        char prim[200];
+        snprintf(prim, sizeof(prim), "{\"attributes\":{\"POSITION\":%d,\"NORMAL\":%d,\"TEXCOORD_0\":%d},\"indices\":%d}", pos, nrm, uv0, idx);
+        w.addMesh("Quad", prim);
+        char triPrims[200];
+        snprintf(triPrims, sizeof(triPrims), "{\"attributes\":{\"POSITION\":%d}},{\"attributes\":{\"POSITION\":%d},\"mode\":1}", triPos, triPos);
+        w.addMesh("Tri", triPrims);
+
+        w.addNode("{\"name\":\"Root\",\"children\":[1,2,3],\"matrix\":[2,0,0,0, 0,2,0,0, 0,0,2,0, 0,0,5,1]}");
+        w.addNode("{\"name\":\"A\",\"mesh\":0,\"translation\":[1,2,3],\"rotation\":[0,0.70710678,0,0.70710678]}");
+        w.addNode("{\"name\":\"B\",\"mesh\":0,\"translation\":[-1,0,0]}");
+        w.addNode("{\"name\":\"C\",\"mesh\":1,\"scale\":[1,3,1]}");
+        w.addNode("{\"name\":\"Orphan\",\"mesh\":1}");
+        return w.write(path, "0");
+    }
+
+    // Sponza-sized scene: meshCount wavy grids of n x n quads (tightly packed float
+    // attributes, 32-bit indices), each mesh referenced by two nodes
+    static bool writeLargeScene(const std::filesystem::path& path, uint32_t meshCount, uint32_t n) {
+        SGltfWriter w;
+        const uint32_t side = n + 1;
+        std::string roots;
+        for (uint32_t m = 0; m < meshCount; m++) {
+            std::vector<float> positions, normals, uvs;
+            for (uint32_t z = 0; z < side; z++) {
+                for (uint32_t x = 0; x < side; x++) {
+                    float fx = (float)x / n, fz = (float)z / n;
+                    positions.insert(positions.end(), {fx, 0.1f * std::sin(fx * 6.0f + m) * std::cos(fz * 5.0f), fz});
+                    normals.insert(normals.end(), {0.0f, 1.0f, 0.0f});
+                    uvs.insert(uvs.end(), {fx, fz});
+                }
+            }
+            std::vector<uint32_t> indices;
+            for (uint32_t z = 0; z < n; z++) {
+                for (uint32_t x = 0; x < n; x++) {
+                    uint32_t i = z * side + x;
+                    indices.insert(indices.end(), {i, i + side, i + 1, i + 1, i + side, i + side + 1});
+                }
+            }
+            int pos = w.addAccessor(w.addView(positions.data(), positions.size() * sizeof(float)), 0, 5126, side * side, "VEC3");
+            int nrm = w.addAccessor(w.addView(normals.data(), normals.size() * sizeof(float)), 0, 5126, side * side, "VEC3");
+            int uv0 = w.addAccessor(w.addView(uvs.data(), uvs.size() * sizeof(float)), 0, 5126, side * side, "VEC2");
+            int idx = w.addAccessor(w.addView(indices.data(), indices.size() * sizeof(uint32_t)), 0, 5125, indices.size(), "SCALAR");
+
+            char prim[200];
+            snprintf(prim, sizeof(prim), "{\"attributes\":{\"POSITION\":%d,\"NORMAL\":%d,\"TEXCOORD_0\":%d},\"indices\":%d}", pos, nrm, uv0, idx);
+            w.addMesh("Grid" + std::to_string(m), prim);
+            for (uint32_t k = 0; k < 2; k++) {
+                w.addNode("{\"mesh\":" + std::to_string(m) + ",\"translation\":[" + std::to_string(m) + ",0," + std::to_string(k * 2) + "]}");
+                SGltfWriter::append(roots, std::to_string(m * 2 + k));
+            }
+        }
+        return w.write(path, roots);
+    }
+
+    // ============================================
+    // Reference: the previous loader, one element at a time
+    // ============================================
+    static bool referenceLoad(const std::string& path, std::vector<SMeshCPU_PNT>& out) {
+        out.clear();
+        cgltf_options opt{}; cgltf_data* data = nullptr;
+        if (cgltf_parse_file(&opt, path.c_str(), &data) != cgltf_result_success) return false;
+        if (cgltf_load_buffers(&opt, data, path.c_str()) != cgltf_result_success) { cgltf_free(data); return false; }
+
+        for (size_t mi = 0; mi < data->meshes_count; ++mi) {
+            for (size_t pi = 0; pi < data->meshes[mi].primitives_count; ++pi) {
+                const cgltf_primitive* prim = &data->meshes[mi].primitives[pi];
+                const cgltf_accessor *acc_pos = nullptr, *acc_nrm = nullptr, *acc_uv0 = nullptr, *acc_tan = nullptr, *acc_col = nullptr;
+                for (size_t a = 0; a < prim->attributes_count; ++a) {
+                    auto& att = prim->attributes[a];
+                    switch (att.type) {
+                        case cgltf_attribute_type_position: acc_pos = att.data; break;
+                        case cgltf_attribute_type_normal:   acc_nrm = att.data; break;
+                        case cgltf_attribute_type_texcoord: if (att.index == 0) acc_uv0 = att.data; break;
+                        case cgltf_attribute_type_tangent:  acc_tan = att.data; break;
+                        case cgltf_attribute_type_color:    if (att.index == 0) acc_col = att.data; break;
+                        default: break;
+                    }
+                }
+                if (!acc_pos || prim->type != cgltf_primitive_type_triangles) continue;
+
+                SMeshCPU_PNT mesh;
+                mesh.vertices.resize(acc_pos->count);
+                for (size_t i = 0; i < acc_pos->count; ++i) {
+                    float p[3] = {0}, n[3] = {0}, uv[2] = {0}, t[4] = {0, 0, 0, 1}, c[4] = {1, 1, 1, 1};
+                    cgltf_accessor_read_float(acc_pos, i, p, 3);
+                    if (acc_nrm) cgltf_accessor_read_float(acc_nrm, i, n, 3);
+                    if (acc_uv0) cgltf_accessor_read_float(acc_uv0, i, uv, 2);
+                    if (acc_tan) cgltf_accessor_read_float(acc_tan, i, t, 4);
+                    if (acc_col) cgltf_accessor_read_float(acc_col, i, c, acc_col->type == cgltf_type_vec4 ? 4 : 3);
+                    SVertexPNT& v = mesh.vertices[i];
+                    v = SVertexPNT{};
+                    v.px = p[0]; v.py = p[1]; v.pz = -p[2];
+                    v.nx = n[0]; v.ny = n[1]; v.nz = -n[2];
+                    v.u = uv[0]; v.v = uv[1];
+                    v.tx = t[0]; v.ty = t[1]; v.tz = -t[2]; v.tw = t[3];
+                    v.r = c[0]; v.g = c[1]; v.b = c[2]; v.a = c[3];
+                }
+                size_t icount = prim->indices ? prim->indices->count : acc_pos->count;
+                mesh.indices.resize(icount);
+                for (size_t i = 0; i < icount; ++i) {
+                    mesh.indices[i] = prim->indices ? (uint32_t)cgltf_accessor_read_index(prim->indices, i) : (uint32_t)i;
+                }
+                for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) std::swap(mesh.indices[i + 1], mesh.indices[i + 2]);
+                if (!acc_tan) ComputeTangents(mesh.vertices, mesh.indices);
+                out.push_back(std::move(mesh));
+            }
+        }
+        cgltf_free(data);
+        return true;
+    }
+
+    static bool sameMesh(const SMeshCPU_PNT& a, const SMeshCPU_PNT& b) {
+        return a.vertices.size() == b.vertices.size() && a.indices == b.indices &&
+               memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(SVertexPNT)) == 0;
+    }
+    static bool samePrimitives(const std::vector<SGltfMeshCPU>& a, const std::vector<SMeshCPU_PNT>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (!sameMesh(a[i].mesh, b[i])) return false;
+        }
+        return true;
+    }
+
+    static std::filesystem::path testDir() {
+        return std::filesystem::temp_directory_path() / "forfun_test_gltf";
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("TestGltfImport: CPU tests");
+
+            std::string path = (testDir() / "small.gltf").string();
+            ASSERT(ctx, writeSmallScene(path), "Write test glTF");
+
+            SGltfSceneCPU scene;
+            SGltfLoadStats stats;
+            ASSERT(ctx, LoadGLTFScene(path, scene, SGltfLoadOptions(), &stats), "LoadGLTFScene");
+
+            // --- Tables ---
+            ASSERT_EQUAL(ctx, (int)scene.meshes.size(), 2, "Two meshes");
+            ASSERT_EQUAL(ctx, (int)scene.primitives.size(), 2, "LINES primitive skipped");
+            if (scene.meshes.size() == 2 && scene.primitives.size() == 2) {
+                ASSERT(ctx, scene.meshes[0].name == "Quad" && scene.meshes[1].name == "Tri", "Mesh names");
+                ASSERT_EQUAL(ctx, (int)scene.meshes[0].firstPrimitive, 0, "Quad range start");
+                ASSERT_EQUAL(ctx, (int)scene.meshes[0].primitiveCount, 1, "Quad range count");
+                ASSERT_EQUAL(ctx, (int)scene.meshes[1].firstPrimitive, 1, "Tri range start");
+                ASSERT_EQUAL(ctx, (int)scene.meshes[1].primitiveCount, 1, "Tri range count (LINES skipped)");
+                ASSERT_EQUAL(ctx, (int)scene.primitives[1].meshIndex, 1, "Primitive keeps its mesh index");
+            }
+
+            ASSERT_EQUAL(ctx, (int)scene.nodes.size(), 4, "Nodes outside the default scene are ignored");
+            if (scene.nodes.size() == 4) {
+                const char* names[] = {"Root", "A", "B", "C"};
+                const int parents[] = {-1, 0, 0, 0};
+                const int meshes[] = {-1, 0, 0, 1};
+                for (int i = 0; i < 4; i++) {
+                    ASSERT(ctx, scene.nodes[i].name == names[i], "Depth-first node order");
+                    ASSERT_EQUAL(ctx, scene.nodes[i].parent, parents[i], "Node parent");
+                    ASSERT_EQUAL(ctx, scene.nodes[i].mesh, meshes[i], "Node mesh");
+                }
+                const SGltfNode& root = scene.nodes[0];
+                ASSERT_EQUAL_F(ctx, root.scale.x, 2.0f, 1e-5f, "Matrix node: scale");
+                ASSERT_EQUAL_F(ctx, root.scale.z, 2.0f, 1e-5f, "Matrix node: scale z");
+                ASSERT_EQUAL_F(ctx, root.translation.z, -5.0f, 1e-5f, "Matrix node: translation z flipped");
+                ASSERT_EQUAL_F(ctx, std::fabs(root.rotation.w), 1.0f, 1e-5f, "Matrix node: no rotation");
+
+                const SGltfNode& a = scene.nodes[1];
+                ASSERT_EQUAL_F(ctx, a.translation.x, 1.0f, 1e-6f, "TRS node: translation x");
+                ASSERT_EQUAL_F(ctx, a.translation.y, 2.0f, 1e-6f, "TRS node: translation y");
+                ASSERT_EQUAL_F(ctx, a.translation.z, -3.0f, 1e-6f, "TRS node: translation z flipped");
+                ASSERT_EQUAL_F(ctx, a.rotation.y, -0.70710678f, 1e-6f, "TRS node: rotation y flipped");
+                ASSERT_EQUAL_F(ctx, a.rotation.w, 0.70710678f, 1e-6f, "TRS node: rotation w kept");
+                ASSERT_EQUAL_F(ctx, scene.nodes[3].scale.y, 3.0f, 1e-6f, "TRS node: scale");
+            }
+
+            // --- Geometry ---
+            if (scene.primitives.size() == 2) {
+                const SMeshCPU_PNT& quad = scene.primitives[0].mesh;
+                ASSERT_EQUAL(ctx, (int)quad.vertices.size(), 4, "Quad vertices");
+                if (quad.vertices.size() == 4) {
+                    const SVertexPNT& v = quad.vertices[2];
+                    ASSERT(ctx, v.px == 1.0f && v.py == 1.0f && v.pz == 0.0f, "Interleaved positions");
+                    ASSERT(ctx, v.nz == -1.0f, "Interleaved normals, z flipped");
+                    ASSERT(ctx, v.u == 1.0f && v.v == 1.0f && quad.vertices[1].v == 0.0f, "Normalized UNSIGNED_SHORT UVs");
+                    ASSERT(ctx, v.r == 1.0f && v.a == 1.0f, "Default vertex color");
+                    float t = std::sqrt(v.tx * v.tx + v.ty * v.ty + v.tz * v.tz);
+                    ASSERT_EQUAL_F(ctx, t, 1.0f, 1e-4f, "Generated tangent");
+                }
+                const std::vector<uint32_t> quadIndices = {0, 2, 1, 0, 3, 2};
+                ASSERT(ctx, quad.indices == quadIndices, "16-bit indices, winding flipped");
+                const std::vector<uint32_t> triIndices = {0, 2, 1};
+                ASSERT(ctx, scene.primitives[1].mesh.indices == triIndices, "Non-indexed primitive");
+            }
+            ASSERT_EQUAL(ctx, (int)stats.bulkAccessors, 4, "Float / index accessors copied in bulk");
+            ASSERT_EQUAL(ctx, (int)stats.convertedAccessors, 1, "Normalized UVs unpacked");
+
+            // --- Serial / parallel / reference / tables only ---
+            std::vector<SMeshCPU_PNT> reference;
+            ASSERT(ctx, referenceLoad(path, reference), "Reference loader");
+            ASSERT(ctx, samePrimitives(scene.primitives, reference), "Parallel output equals the reference");
+
+            SGltfLoadOptions serialOptions;
+            serialOptions.parallel = false;
+            SGltfSceneCPU serial;
+            ASSERT(ctx, LoadGLTFScene(path, serial, serialOptions), "Serial load");
+            ASSERT(ctx, samePrimitives(serial.primitives, reference), "Serial output equals the reference");
+
+            SGltfLoadOptions tableOptions;
+            tableOptions.loadGeometry = false;
+            SGltfSceneCPU tables;
+            ASSERT(ctx, LoadGLTFScene(path, tables, tableOptions), "Tables-only load");
+            ASSERT(ctx, tables.primitives.empty(), "Tables-only: no geometry");
+            ASSERT(ctx, tables.meshes.size() == scene.meshes.size() && tables.nodes.size() == scene.nodes.size() &&
+                        tables.meshes[1].firstPrimitive == scene.meshes[1].firstPrimitive,
+                   "Tables-only: same ranges and nodes");
+
+            std::vector<SGltfMeshCPU> flat;
+            ASSERT(ctx, LoadGLTF_PNT(path, flat), "LoadGLTF_PNT");
+            ASSERT_EQUAL(ctx, (int)flat.size(), 2, "LoadGLTF_PNT: one mesh per primitive");
+            SGltfSceneCPU missing;
+            ASSERT(ctx, !LoadGLTFScene((testDir() / "missing.gltf").string(), missing), "Missing file fails");
+
+            // --- Scene import: hierarchy, instancing through sub-mesh ranges ---
+            CScene& sceneRef = CScene::Instance();
+            size_t before = sceneRef.GetWorld().Count();
+            CGameObject* root = sceneRef.ImportModel(path);
+            ASSERT(ctx, root != nullptr, "ImportModel");
+            ASSERT_EQUAL(ctx, (int)(sceneRef.GetWorld().Count() - before), 5, "Root + one object per node");
+            if (root && sceneRef.GetWorld().Count() - before == 5) {
+                STransform* rootTransform = root->GetComponent<STransform>();
+                CGameObject* gltfRoot = sceneRef.GetWorld().Get(before + 1);
+                ASSERT(ctx, gltfRoot->GetComponent<STransform>()->GetParent() == rootTransform, "Node parented to the import root");
+                ASSERT_EQUAL(ctx, (int)gltfRoot->GetComponent<STransform>()->GetChildren().size(), 3, "Node children");
+                ASSERT(ctx, gltfRoot->GetComponent<SMeshRenderer>() == nullptr, "Transform-only node has no renderer");
+
+                SMeshRenderer* a = sceneRef.GetWorld().Get(before + 2)->GetComponent<SMeshRenderer>();
+                SMeshRenderer* b = sceneRef.GetWorld().Get(before + 3)->GetComponent<SMeshRenderer>();
+                SMeshRenderer* c = sceneRef.GetWorld().Get(before + 4)->GetComponent<SMeshRenderer>();
+                ASSERT(ctx, a && b && c, "Mesh nodes have renderers");
+                if (a && b && c) {
+                    ASSERT(ctx, a->path == path && b->path == path, "Instances reference the source file");
+                    ASSERT(ctx, a->subMeshFirst == 0 && a->subMeshCount == 1, "Node A draws the Quad range");
+                    ASSERT(ctx, b->subMeshFirst == a->subMeshFirst && b->subMeshCount == a->subMeshCount, "Node B instances the same range");
+                    ASSERT(ctx, c->subMeshFirst == 1 && c->subMeshCount == 1, "Node C draws the Tri range");
+                }
+                STransform* at = sceneRef.GetWorld().Get(before + 2)->GetComponent<STransform>();
+                DirectX::XMFLOAT3 world = at->GetWorldPosition();
+                ASSERT_EQUAL_F(ctx, world.x, 2.0f, 1e-4f, "World position: parent scale applied (x)");
+                ASSERT_EQUAL_F(ctx, world.z, -11.0f, 1e-4f, "World position: parent scale + translation (z)");
+            }
+
+            CFFLog::Info("TestGltfImport: CPU tests done");
+        });
+
+        ctx.OnFrame(3, [&ctx]() {
+            CWorld& world = CScene::Instance().GetWorld();
+            std::vector<SMeshRenderer*> renderers;
+            for (size_t i = 0; i < world.Count(); i++) {
+                SMeshRenderer* mr = world.Get(i)->GetComponent<SMeshRenderer>();
+                if (mr && mr->path.find("forfun_test_gltf") != std::string::npos) renderers.push_back(mr);
+            }
+            ASSERT_EQUAL(ctx, (int)renderers.size(), 3, "Imported renderers found");
+            if (renderers.size() == 3) {
+                for (SMeshRenderer* mr : renderers) mr->EnsureUploaded();
+                ASSERT(ctx, renderers[0]->meshes.size() == 1 && renderers[1]->meshes.size() == 1 &&
+                            renderers[2]->meshes.size() == 1, "Each node draws one sub-mesh");
+                if (renderers[0]->meshes.size() == 1 && renderers[1]->meshes.size() == 1 && renderers[2]->meshes.size() == 1) {
+                    ASSERT(ctx, renderers[0]->meshes[0] == renderers[1]->meshes[0], "Instances share the GPU mesh");
+                    ASSERT(ctx, renderers[0]->meshes[0] != renderers[2]->meshes[0], "Different meshes stay separate");
+                    ASSERT_EQUAL(ctx, (int)renderers[2]->meshes[0]->subMeshIndex, 1, "Sub-mesh index of the range");
+                }
+            }
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "glTF Import");
+
+            auto timeIt = [](auto&& func) {
+                auto start = std::chrono::high_resolution_clock::now();
+                func();
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+            auto report = [&](const char* name, const std::string& path) {
+                std::vector<SMeshCPU_PNT> reference;
+                SGltfSceneCPU serial, parallel, tables;
+                SGltfLoadOptions serialOptions, tableOptions;
+                serialOptions.parallel = false;
+                tableOptions.loadGeometry = false;
+                SGltfLoadStats stats;
+
+                double referenceMs = timeIt([&]() { referenceLoad(path, reference); });
+                double serialMs = timeIt([&]() { LoadGLTFScene(path, serial, serialOptions); });
+                double parallelMs = timeIt([&]() { LoadGLTFScene(path, parallel, SGltfLoadOptions(), &stats); });
+                double tablesMs = timeIt([&]() { LoadGLTFScene(path, tables, tableOptions); });
+
+                log.LogEvent(name);
+                log.LogInfo("%u primitives, %zu meshes, %zu nodes, %.2f M vertices, %.2f M triangles, %u bulk / %u converted accessors",
+                            stats.primitives, parallel.meshes.size(), parallel.nodes.size(), stats.vertices / 1e6,
+                            stats.indices / 3 / 1e6, stats.bulkAccessors, stats.convertedAccessors);
+                log.LogInfo("Reference (per element)  : %8.1f ms", referenceMs);
+                log.LogInfo("Bulk copy, serial        : %8.1f ms | %5.1fx", serialMs, referenceMs / serialMs);
+                log.LogInfo("Bulk copy, parallel (%2u) : %8.1f ms | %5.1fx (parse %.1f ms, geometry %.1f ms)",
+                            CJobSystem::Instance().GetThreadCount(), parallelMs, referenceMs / parallelMs,
+                            stats.parseMs, stats.geometryMs);
+                log.LogInfo("Node / mesh tables only  : %8.1f ms", tablesMs);
+                ctx.Assert(samePrimitives(parallel.primitives, reference), "Benchmark: parallel equals reference");
+                ctx.Assert(samePrimitives(serial.primitives, reference), "Benchmark: serial equals reference");
+                return referenceMs / serialMs;
+            };
+
+            // Sponza: ~260K triangles in ~100 primitives; 96 meshes x 48^2 quads, two instances each
+            std::string path = (testDir() / "large.gltf").string();
+            ASSERT(ctx, writeLargeScene(path, 96, 48), "Write benchmark glTF");
+            double speedup = report("Generated: 96 meshes x 48x48 grid, 192 nodes", path);
+            ASSERT(ctx, speedup > 1.0, "Bulk copy is faster than the per-element reference");
+
+            const char* files[] = {
+                "pbr_models/Barrel_01_1k.gltf/Barrel_01_1k.gltf",
+                "Sponza/glTF/Sponza.gltf",
+            };
+            for (const char* name : files) {
+                std::string file = FFPath::GetAbsolutePath(name);
+                if (!std::filesystem::exists(file)) {
+                    log.LogInfo("%s : missing, skipped", name);
+                    continue;
+                }
+                report(name, file);
+            }
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestGltfImport)
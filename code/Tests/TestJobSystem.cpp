@@ -0,0 +1,178 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/FFLog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+/**
+ * Test: Job System correctness + micro-benchmark
+ *
+ * Correctness (Frame 1):
+ *   - ParallelFor covers every index exactly once
+ *   - RunAfter continuation starts only after its dependency completes
+ *   - Nested Run/Wait from inside a job does not deadlock
+ *
+ * Benchmark (Frame 5):
+ *   - Scheduling overhead: ns per empty job (submit + execute + counter)
+ *   - Scaling: fixed CPU-bound workload with 1..N threads, speedup and efficiency
+ *
+ * Usage:
+ *   forfun.exe --test TestJobSystem
+ *   Results: E:/forfun/debug/TestJobSystem/test.log
+ */
+class CTestJobSystem : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestJobSystem";
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestJobSystem ===");
+            CFFLog::Info("Frame 1: Correctness checks");
+
+            auto& jobs = CJobSystem::Instance();
+            if (!jobs.IsInitialized()) {
+                jobs.Initialize();
+            }
+
+            // ParallelFor coverage
+            const uint32_t count = 100000;
+            std::vector<std::atomic<int>> hits(count);
+            for (auto& h : hits) h = 0;
+            jobs.ParallelFor(count, 0, [&hits](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; i++) {
+                    hits[i].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+            int badCount = 0;
+            for (auto& h : hits) {
+                if (h.load() != 1) badCount++;
+            }
+            ASSERT_EQUAL(ctx, badCount, 0, "ParallelFor visits every index exactly once");
+
+            // Dependencies
+            CJobCounter stageA, stageB;
+            std::atomic<int> doneA{0};
+            std::atomic<bool> orderOk{true};
+            for (int i = 0; i < 256; i++) {
+                jobs.Run([&doneA]() { doneA.fetch_add(1); }, &stageA);
+            }
+            jobs.RunAfter(stageA, [&doneA, &orderOk]() {
+                if (doneA.load() != 256) orderOk = false;
+            }, &stageB);
+            jobs.Wait(stageB);
+            ASSERT(ctx, orderOk.load(), "RunAfter starts after dependency completes");
+
+            // Nested jobs
+            CJobCounter outer;
+            std::atomic<int> innerCount{0};
+            for (int i = 0; i < 32; i++) {
+                jobs.Run([&jobs, &innerCount]() {
+                    CJobCounter inner;
+                    for (int j = 0; j < 32; j++) {
+                        jobs.Run([&innerCount]() { innerCount.fetch_add(1); }, &inner);
+                    }
+                    jobs.Wait(inner);
+                }, &outer);
+            }
+            jobs.Wait(outer);
+            ASSERT_EQUAL(ctx, innerCount.load(), 32 * 32, "Nested jobs all executed");
+
+            CFFLog::Info("✓ Frame 1: Correctness checks passed");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Job System");
+
+            auto& jobs = CJobSystem::Instance();
+            uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+            // Scheduling overhead
+            log.LogEvent("Scheduling Overhead");
+            {
+                const int jobCount = 200000;
+                jobs.ResetStats();
+                auto start = std::chrono::high_resolution_clock::now();
+                CJobCounter counter;
+                for (int i = 0; i < jobCount; i++) {
+                    jobs.Run([]() {}, &counter);
+                }
+                jobs.Wait(counter);
+                auto end = std::chrono::high_resolution_clock::now();
+                double ns = std::chrono::duration<double, std::nano>(end - start).count() / jobCount;
+                auto stats = jobs.GetStats();
+                log.LogInfo("Empty jobs: %d, threads: %u", jobCount, jobs.GetThreadCount());
+                log.LogInfo("  %.1f ns/job, stolen: %llu", ns, (unsigned long long)stats.jobsStolen);
+            }
+
+            // Scaling (restart the system with 1..N threads)
+            log.LogEvent("Scaling");
+            const uint32_t itemCount = 1 << 16;
+            auto workload = [itemCount](uint32_t begin, uint32_t end) {
+                volatile float sink = 0.0f;
+                for (uint32_t i = begin; i < end; i++) {
+                    float x = (float)i / itemCount;
+                    for (int k = 0; k < 200; k++) {
+                        x = std::sin(x) * 1.0001f + 0.1f;
+                    }
+                    sink = sink + x;
+                }
+            };
+
+            // 1, 2, 4, ... plus the full core count
+            std::vector<uint32_t> threadCounts;
+            for (uint32_t t = 1; t < maxThreads; t *= 2) {
+                threadCounts.push_back(t);
+            }
+            threadCounts.push_back(maxThreads);
+
+            double baselineMs = 0.0;
+            for (uint32_t threads : threadCounts) {
+                jobs.Shutdown();
+                if (threads > 1) {
+                    jobs.Initialize(threads - 1);
+                }
+
+                auto start = std::chrono::high_resolution_clock::now();
+                jobs.ParallelFor(itemCount, 256, workload);
+                auto end = std::chrono::high_resolution_clock::now();
+                double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+                if (threads == 1) baselineMs = ms;
+                double speedup = (ms > 0.0) ? baselineMs / ms : 0.0;
+                log.LogInfo("Threads %2u: %8.2f ms | speedup %.2fx | efficiency %.0f%%",
+                            threads, ms, speedup, 100.0 * speedup / threads);
+            }
+
+            // Restore default configuration
+            jobs.Shutdown();
+            jobs.Initialize();
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestJobSystem)
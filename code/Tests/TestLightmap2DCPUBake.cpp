@@ -0,0 +1,282 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Engine/Rendering/Lightmap/Lightmap2DCPUBaker.h"
+#include "Engine/Rendering/Lightmap/LightmapRasterizer.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace DirectX;
+
+/**
+ * Test: CPU path-traced 2D lightmap baker (CLightmap2DCPUBaker)
+ *
+ * Frame 1 (CPU only, denoiser off):
+ *   - Uniform sky, nothing above the floor: every texel is sky * skyIntensity
+ *   - Directional light straight down, black sky: every texel is intensity / PI
+ *   - A down-facing occluder shadows the texels under it; the same quad
+ *     facing up is culled like on the GPU and casts no shadow
+ *   - Output is identical for any tile size / job split
+ *   - Dilation: neighbours of the chart get alpha 0.5, texels further than
+ *     4 texels away stay empty
+ *
+ * Frame 5 (benchmark, floor + occluder in a 256^2 atlas):
+ *   - Msamples/s per tile size with CJobSystem
+ *
+ * Usage:
+ *   forfun.exe --test TestLightmap2DCPUBake
+ *   Results: E:/forfun/debug/TestLightmap2DCPUBake/test.log
+ */
+class CTestLightmap2DCPUBake : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestLightmap2DCPUBake";
+    }
+
+    // Unit floor quad (y = 0, normal +Y), UV2 = (x, z)
+    static void rasterizeFloor(CLightmapRasterizer& rasterizer, int atlasSize, int region) {
+        std::vector<XMFLOAT3> positions = {{0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1}};
+        std::vector<XMFLOAT3> normals(4, XMFLOAT3(0.0f, 1.0f, 0.0f));
+        std::vector<XMFLOAT2> uv2 = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+        std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
+
+        rasterizer.Initialize(atlasSize, atlasSize);
+        rasterizer.RasterizeMesh(positions, normals, uv2, indices, XMMatrixIdentity(), 0, 0, region, region);
+    }
+
+    static void addQuad(SRayTracingSceneData& scene, const std::vector<XMFLOAT3>& corners,
+                        const std::vector<uint32_t>& indices, const XMFLOAT3& albedo) {
+        SRayTracingMeshData mesh;
+        mesh.positions = corners;
+        mesh.normals.assign(corners.size(), XMFLOAT3(0.0f, 1.0f, 0.0f));
+        mesh.indices = indices;
+        mesh.vertexCount = (uint32_t)corners.size();
+        mesh.indexCount = (uint32_t)indices.size();
+
+        SRayTracingMaterial material;
+        material.albedo = albedo;
+
+        SRayTracingInstance instance;
+        XMStoreFloat4x4(&instance.worldTransform, XMMatrixIdentity());
+        instance.meshIndex = (uint32_t)scene.meshes.size();
+        instance.materialIndex = (uint32_t)scene.materials.size();
+        instance.instanceID = (uint32_t)scene.instances.size();
+
+        scene.meshes.push_back(mesh);
+        scene.materials.push_back(material);
+        scene.instances.push_back(instance);
+    }
+
+    // Floor, plus an optional occluder over x in [0, 0.5] at y = 1
+    // Front face as in DXR: dot(ray, cross(e1, e2)) < 0
+    static SRayTracingSceneData makeScene(bool occluder, bool occluderFacesDown) {
+        SRayTracingSceneData scene;
+        addQuad(scene, {{0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1}}, {0, 1, 2, 0, 2, 3}, {0.8f, 0.8f, 0.8f});
+        if (occluder) {
+            std::vector<XMFLOAT3> corners = {{0, 1, 0}, {0.5f, 1, 0}, {0.5f, 1, 1}, {0, 1, 1}};
+            // cross(e1, e2) = -Y for (0,1,2): front face for rays going up
+            std::vector<uint32_t> down = {0, 1, 2, 0, 2, 3};
+            std::vector<uint32_t> up = {0, 2, 1, 0, 3, 2};
+            addQuad(scene, corners, occluderFacesDown ? down : up, {0.5f, 0.5f, 0.5f});
+        }
+        return scene;
+    }
+
+    static SRayTracingLight sunStraightDown(float intensity) {
+        SRayTracingLight light;
+        light.type = SRayTracingLight::EType::Directional;
+        light.direction = {0.0f, -1.0f, 0.0f};
+        light.color = {1.0f, 1.0f, 1.0f};
+        light.intensity = intensity;
+        return light;
+    }
+
+    // 1x1 cubemap: the same radiance in every direction
+    static CKTXLoader::SCubemapCPUData uniformSky(const XMFLOAT3& radiance) {
+        CKTXLoader::SCubemapCPUData sky;
+        sky.size = 1;
+        for (auto& face : sky.faces) {
+            face.assign(1, XMFLOAT4(radiance.x, radiance.y, radiance.z, 1.0f));
+        }
+        sky.valid = true;
+        return sky;
+    }
+
+    static bool near(float a, float b, float eps = 1e-4f) {
+        return std::abs(a - b) <= eps * std::max(1.0f, std::abs(b));
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestLightmap2DCPUBake ===");
+            CFFLog::Info("Frame 1: CPU lightmap baker");
+
+            auto& jobs = CJobSystem::Instance();
+            if (!jobs.IsInitialized()) {
+                jobs.Initialize();
+            }
+
+            const int atlasSize = 32;
+            CLightmapRasterizer floor;
+            rasterizeFloor(floor, atlasSize, atlasSize);
+
+            SLightmap2DCPUBakeConfig config;
+            config.samplesPerTexel = 16;
+            config.maxBounces = 3;
+            config.enableDenoiser = false;
+
+            // Uniform sky: every path misses, cos-weighted pdf cancels exactly
+            {
+                SRayTracingSceneData scene = makeScene(false, false);
+                CKTXLoader::SCubemapCPUData sky = uniformSky({0.5f, 0.25f, 1.0f});
+                SLightmap2DCPUBakeConfig skyConfig = config;
+                skyConfig.skyIntensity = 2.0f;
+
+                CLightmap2DCPUBaker baker;
+                bool ok = baker.BakeLightmap(scene, floor.GetTexels(), atlasSize, atlasSize, &sky, skyConfig);
+                ASSERT(ctx, ok, "Sky bake succeeds");
+                ASSERT_EQUAL(ctx, (int)baker.GetBakedTexelCount(), atlasSize * atlasSize, "Every floor texel is baked");
+
+                int wrong = 0;
+                for (const XMFLOAT4& texel : baker.GetAtlas()) {
+                    if (!near(texel.x, 1.0f) || !near(texel.y, 0.5f) || !near(texel.z, 2.0f) || texel.w != 1.0f) wrong++;
+                }
+                ASSERT_EQUAL(ctx, wrong, 0, "Uniform sky: texel = sky * skyIntensity, alpha 1");
+            }
+
+            // Directional light, black sky: E / PI
+            {
+                SRayTracingSceneData scene = makeScene(false, false);
+                scene.lights.push_back(sunStraightDown(3.0f));
+
+                CLightmap2DCPUBaker baker;
+                baker.BakeLightmap(scene, floor.GetTexels(), atlasSize, atlasSize, nullptr, config);
+                int wrong = 0;
+                for (const XMFLOAT4& texel : baker.GetAtlas()) {
+                    if (!near(texel.x, 3.0f / XM_PI) || !near(texel.y, 3.0f / XM_PI) || !near(texel.z, 3.0f / XM_PI)) wrong++;
+                }
+                ASSERT_EQUAL(ctx, wrong, 0, "Directional light: texel = intensity / PI");
+            }
+
+            // Occluder over x < 0.5: shadow only when it faces the floor
+            {
+                const int shadowed = 12 * atlasSize + 4;
+                const int lit = 12 * atlasSize + 28;
+
+                SRayTracingSceneData down = makeScene(true, true);
+                down.lights.push_back(sunStraightDown(3.0f));
+                CLightmap2DCPUBaker baker;
+                baker.BakeLightmap(down, floor.GetTexels(), atlasSize, atlasSize, nullptr, config);
+                ASSERT(ctx, baker.GetAtlas()[shadowed].x < 1e-6f, "Texel under the occluder is in shadow");
+                ASSERT(ctx, near(baker.GetAtlas()[lit].x, 3.0f / XM_PI), "Texel beside the occluder is lit");
+
+                SRayTracingSceneData up = makeScene(true, false);
+                up.lights.push_back(sunStraightDown(3.0f));
+                baker.BakeLightmap(up, floor.GetTexels(), atlasSize, atlasSize, nullptr, config);
+                ASSERT(ctx, near(baker.GetAtlas()[shadowed].x, 3.0f / XM_PI), "Back-facing occluder is culled (no shadow)");
+            }
+
+            // Same atlas for any tile split
+            {
+                SRayTracingSceneData scene = makeScene(true, true);
+                scene.lights.push_back(sunStraightDown(3.0f));
+                CKTXLoader::SCubemapCPUData sky = uniformSky({0.3f, 0.4f, 0.5f});
+
+                SLightmap2DCPUBakeConfig a = config;
+                a.tileSize = 16;
+                SLightmap2DCPUBakeConfig b = config;
+                b.tileSize = 5;
+
+                CLightmap2DCPUBaker bakerA, bakerB;
+                bakerA.BakeLightmap(scene, floor.GetTexels(), atlasSize, atlasSize, &sky, a);
+                bakerB.BakeLightmap(scene, floor.GetTexels(), atlasSize, atlasSize, &sky, b);
+                ASSERT(ctx, bakerA.GetAtlas().size() == bakerB.GetAtlas().size() &&
+                            std::memcmp(bakerA.GetAtlas().data(), bakerB.GetAtlas().data(),
+                                        bakerA.GetAtlas().size() * sizeof(XMFLOAT4)) == 0,
+                       "Tile size 16 and 5 give identical atlases");
+
+                // Sky and bounce light under the occluder: between shadow and full sun
+                float underOccluder = bakerA.GetAtlas()[12 * atlasSize + 4].x;
+                ASSERT(ctx, underOccluder > 0.0f && underOccluder < bakerA.GetAtlas()[12 * atlasSize + 28].x,
+                       "Occluded texel gets indirect light only");
+            }
+
+            // Dilation: chart in the top-left 16^2 of a 32^2 atlas
+            {
+                CLightmapRasterizer chart;
+                rasterizeFloor(chart, atlasSize, 16);
+                SRayTracingSceneData scene = makeScene(false, false);
+                scene.lights.push_back(sunStraightDown(3.0f));
+
+                CLightmap2DCPUBaker baker;
+                baker.BakeLightmap(scene, chart.GetTexels(), atlasSize, atlasSize, nullptr, config);
+                const auto& atlas = baker.GetAtlas();
+                ASSERT_EQUAL(ctx, (int)baker.GetBakedTexelCount(), 16 * 16, "Only the chart is baked");
+                ASSERT(ctx, atlas[5 * atlasSize + 16].w == 0.5f && atlas[5 * atlasSize + 16].x == atlas[5 * atlasSize + 15].x,
+                       "Neighbour of the chart is dilated with alpha 0.5");
+                ASSERT(ctx, atlas[5 * atlasSize + 19].w == 0.5f, "4 passes reach 4 texels out");
+                ASSERT(ctx, atlas[5 * atlasSize + 20].w == 0.0f && atlas[5 * atlasSize + 20].x == 0.0f,
+                       "Texels 5 out stay empty");
+            }
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            CFFLog& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "CPU lightmap baker (floor + occluder, 256^2 atlas)");
+            auto& jobs = CJobSystem::Instance();
+            if (!jobs.IsInitialized()) {
+                jobs.Initialize();
+            }
+
+            const int atlasSize = 256;
+            CLightmapRasterizer floor;
+            rasterizeFloor(floor, atlasSize, atlasSize);
+            SRayTracingSceneData scene = makeScene(true, true);
+            scene.lights.push_back(sunStraightDown(3.0f));
+            CKTXLoader::SCubemapCPUData sky = uniformSky({0.3f, 0.4f, 0.5f});
+
+            SLightmap2DCPUBakeConfig config;
+            config.samplesPerTexel = 32;
+            config.maxBounces = 3;
+            config.enableDenoiser = false;
+
+            log.LogEvent("Throughput");
+            log.LogInfo("%d texels, %u samples, %u threads", atlasSize * atlasSize, config.samplesPerTexel, jobs.GetThreadCount());
+
+            bool baked = true;
+            for (int tileSize : {8, 16, 32, 64}) {
+                config.tileSize = tileSize;
+                CLightmap2DCPUBaker baker;
+                auto start = std::chrono::high_resolution_clock::now();
+                baked &= baker.BakeLightmap(scene, floor.GetTexels(), atlasSize, atlasSize, &sky, config);
+                double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+                double samples = (double)baker.GetBakedTexelCount() * config.samplesPerTexel;
+                log.LogInfo("Tile %2d: %8.2f ms | %6.2f Msamples/s", tileSize, seconds * 1000.0, samples / seconds / 1e6);
+            }
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, baked, "Benchmark bakes succeed");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestLightmap2DCPUBake)
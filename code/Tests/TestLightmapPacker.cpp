@@ -0,0 +1,274 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Engine/Rendering/Lightmap/LightmapAtlas.h"
+#include "Engine/Rendering/Lightmap/LightmapPacker.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Test: MaxRects lightmap atlas packer vs the shelf packer
+ *
+ * Frame 1 (CPU only):
+ *   - Placements stay inside the page, keep the padding, never overlap
+ *   - Rotation: a tall item rotated into the space next to a wide one
+ *   - Items larger than a page fail, maxPages limits the page count
+ *   - Perfect fit of equal squares gives 100% occupancy on one page
+ *   - Atlas builder: per-object density override, size from surface area
+ *   - MaxRects occupancy >= shelf occupancy through CLightmapAtlas
+ *
+ * Frame 5 (benchmark, 2000 items, 512^2 pages):
+ *   - Shelf vs MaxRects vs MaxRects + rotation on synthetic distributions:
+ *     pages, occupancy, packing time
+ *
+ * Usage:
+ *   forfun.exe --test TestLightmapPacker
+ *   Results: E:/forfun/debug/TestLightmapPacker/test.log
+ */
+class CTestLightmapPacker : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestLightmapPacker";
+    }
+
+    struct SPlaced {
+        int page, x, y, w, h;
+    };
+
+    // Footprints (item + padding) must lie in the page and not overlap
+    static bool validLayout(const std::vector<SPlaced>& placed, int pageSize, int padding) {
+        for (size_t i = 0; i < placed.size(); i++) {
+            const SPlaced& a = placed[i];
+            if (a.page < 0 || a.x < 0 || a.y < 0 || a.x + a.w + padding > pageSize || a.y + a.h + padding > pageSize) {
+                return false;
+            }
+            for (size_t j = i + 1; j < placed.size(); j++) {
+                const SPlaced& b = placed[j];
+                if (a.page == b.page && a.x < b.x + b.w + padding && b.x < a.x + a.w + padding &&
+                    a.y < b.y + b.h + padding && b.y < a.y + a.h + padding) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static std::vector<SPlaced> fromPacker(const CMaxRectsPacker& packer) {
+        std::vector<SPlaced> placed;
+        for (const SPackPlacement& p : packer.GetPlacements()) placed.push_back({p.page, p.x, p.y, p.width, p.height});
+        return placed;
+    }
+
+    static std::vector<SPlaced> fromAtlas(const CLightmapAtlas& atlas) {
+        std::vector<SPlaced> placed;
+        for (const SAtlasEntry& e : atlas.GetEntries()) placed.push_back({e.atlasIndex, e.atlasX, e.atlasY, e.width, e.height});
+        return placed;
+    }
+
+    // Synthetic lightmap region sizes
+    static std::vector<std::pair<int, int>> distribution(const std::string& name, int count, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::pair<int, int>> sizes(count);
+        for (auto& size : sizes) {
+            if (name == "uniform 8-128") {
+                std::uniform_int_distribution<int> d(8, 128);
+                size = {d(rng), d(rng)};
+            } else if (name == "power law 4-512") {
+                // Many props, few large walls/floors
+                std::exponential_distribution<float> d(1.0f / 24.0f);
+                std::uniform_real_distribution<float> aspect(0.5f, 2.0f);
+                int side = std::clamp((int)(4 + d(rng)), 4, 512);
+                size = {side, std::clamp((int)(side * aspect(rng)), 4, 512)};
+            } else if (name == "elongated") {
+                std::uniform_int_distribution<int> thin(4, 32), tall(64, 256);
+                size = (rng() & 1) ? std::make_pair(thin(rng), tall(rng)) : std::make_pair(tall(rng), thin(rng));
+            } else {
+                // xatlas-like charts: small, mixed aspect
+                std::uniform_int_distribution<int> d(2, 48);
+                size = {d(rng), d(rng)};
+            }
+        }
+        return sizes;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestLightmapPacker ===");
+            CFFLog::Info("Frame 1: MaxRects packer");
+
+            // Perfect fit
+            {
+                CMaxRectsPacker packer;
+                std::vector<SPackRect> rects(4, SPackRect{256, 256, false});
+                ASSERT(ctx, packer.Pack(rects, 512, 0), "4 x 256^2 pack into 512^2");
+                ASSERT_EQUAL(ctx, packer.GetStats().pageCount, 1, "Perfect fit uses one page");
+                ASSERT_EQUAL_F(ctx, packer.GetStats().occupancy, 1.0f, 1e-6f, "Perfect fit is 100% occupied");
+                ASSERT(ctx, validLayout(fromPacker(packer), 512, 0), "Perfect fit layout is valid");
+            }
+
+            // Rotation: a 64x128 item only fits next to the 128x64 one when rotated
+            {
+                std::vector<SPackRect> rects = {{128, 64, true}, {64, 128, false}};
+                CMaxRectsPacker upright;
+                upright.Pack(rects, 128, 0);
+                ASSERT_EQUAL(ctx, upright.GetStats().pageCount, 2, "Without rotation the tall item opens a page");
+
+                rects[1].allowRotation = true;
+                CMaxRectsPacker rotating;
+                rotating.Pack(rects, 128, 0);
+                const SPackPlacement& p = rotating.GetPlacements()[1];
+                ASSERT_EQUAL(ctx, rotating.GetStats().pageCount, 1, "With rotation both items share a page");
+                ASSERT(ctx, p.rotated && p.width == 128 && p.height == 64, "Rotated placement reports swapped size");
+                ASSERT(ctx, validLayout(fromPacker(rotating), 128, 0), "Rotated layout is valid");
+            }
+
+            // Failures
+            {
+                CMaxRectsPacker packer;
+                std::vector<SPackRect> rects = {{100, 20, false}, {255, 10, false}};
+                ASSERT(ctx, !packer.Pack(rects, 256, 2), "Item wider than page - padding fails");
+                ASSERT(ctx, packer.GetPlacements()[0].page == 0 && packer.GetPlacements()[1].page == -1,
+                       "Items that fit keep their placement");
+
+                std::vector<SPackRect> many(9, SPackRect{100, 100, false});
+                ASSERT(ctx, !packer.Pack(many, 256, 0, 2), "maxPages = 2 cannot hold 9 x 100^2 in 256^2");
+                ASSERT_EQUAL(ctx, packer.GetStats().pageCount, 2, "maxPages is respected");
+                ASSERT_EQUAL(ctx, packer.GetStats().placedCount, 8, "4 items per page placed");
+            }
+
+            // Padding + random layout
+            {
+                auto sizes = distribution("uniform 8-128", 300, 7);
+                std::vector<SPackRect> rects;
+                for (const auto& s : sizes) rects.push_back({s.first, s.second, true});
+                CMaxRectsPacker packer;
+                ASSERT(ctx, packer.Pack(rects, 512, 3), "300 random items pack");
+                ASSERT(ctx, validLayout(fromPacker(packer), 512, 3), "Random layout: in bounds, padded, no overlap");
+                ASSERT_EQUAL(ctx, packer.GetStats().placedCount, 300, "Every item placed");
+                int64_t used = 0;
+                for (const auto& s : sizes) used += (int64_t)s.first * s.second;
+                ASSERT(ctx, packer.GetStats().usedTexels == used, "Stats count item texels");
+            }
+
+            // Atlas builder: density override and area-based size
+            {
+                auto fromArea = CLightmapAtlas::ComputeMeshLightmapSizeFromArea(4.0f, 1.0f, 16.0f);
+                ASSERT(ctx, fromArea.first == 32 && fromArea.second == 32, "4 m^2 at full UV coverage, 16 texels/unit -> 32^2");
+                fromArea = CLightmapAtlas::ComputeMeshLightmapSizeFromArea(4.0f, 0.5f, 16.0f);
+                ASSERT_EQUAL(ctx, fromArea.first, 46, "Half UV coverage -> side x sqrt(2)");
+
+                CLightmapAtlasBuilder builder;
+                SLightmapMeshInfo mesh = {};
+                mesh.boundsMin = {0.0f, 0.0f, 0.0f};
+                mesh.boundsMax = {2.0f, 2.0f, 2.0f};
+                mesh.texelDensityScale = 1.0f;
+                builder.AddMesh(mesh);
+                mesh.meshRendererIndex = 1;
+                mesh.texelDensityScale = 2.0f;
+                builder.AddMesh(mesh);
+                mesh.meshRendererIndex = 2;
+                mesh.texelDensityScale = 1.0f;
+                mesh.surfaceArea = 24.0f;
+                mesh.uv2Coverage = 0.6f;
+                builder.AddMesh(mesh);
+
+                SLightmapAtlasConfig config;
+                config.resolution = 512;
+                config.texelsPerUnit = 16;
+                ASSERT(ctx, builder.Build(config), "Builder succeeds");
+                const auto& entries = builder.GetAtlas().GetEntries();
+                ASSERT(ctx, entries[0].width == 32 && entries[1].width == 64, "texelDensityScale 2 doubles the region");
+                ASSERT_EQUAL(ctx, entries[2].width, 102, "Surface area 24 at 60% UV coverage -> ceil(16 * sqrt(40)) = 102");
+            }
+
+            // Through CLightmapAtlas: MaxRects never worse than shelf
+            for (const char* name : {"uniform 8-128", "power law 4-512", "elongated", "charts 2-48"}) {
+                auto sizes = distribution(name, 500, 11);
+                SLightmapAtlasConfig config;
+                config.resolution = 512;
+                config.packer = EAtlasPacker::Shelf;
+                CLightmapAtlas shelf, maxRects;
+                shelf.Pack(sizes, config);
+                config.packer = EAtlasPacker::MaxRects;
+                bool packed = maxRects.Pack(sizes, config);
+
+                char msg[160];
+                snprintf(msg, sizeof(msg), "%s: MaxRects %d pages %.1f%% vs shelf %d pages %.1f%%", name,
+                         maxRects.GetAtlasCount(), maxRects.GetOccupancy() * 100.0f, shelf.GetAtlasCount(), shelf.GetOccupancy() * 100.0f);
+                ASSERT(ctx, packed && validLayout(fromAtlas(maxRects), 512, config.padding), msg);
+                ASSERT(ctx, maxRects.GetAtlasCount() <= shelf.GetAtlasCount() && maxRects.GetOccupancy() >= shelf.GetOccupancy(), msg);
+            }
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            CFFLog& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Lightmap atlas packing (2000 items, 512^2 pages, padding 2)");
+            auto now = []() { return std::chrono::high_resolution_clock::now(); };
+            auto msSince = [](std::chrono::high_resolution_clock::time_point start) {
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+
+            const int pageSize = 512;
+            const int padding = 2;
+            log.LogEvent("Pages / occupancy / time");
+            log.LogInfo("%-18s : %-24s | %-24s | %-24s", "", "shelf", "MaxRects", "MaxRects + rotation");
+
+            bool neverWorse = true;
+            for (const char* name : {"uniform 8-128", "power law 4-512", "elongated", "charts 2-48"}) {
+                auto sizes = distribution(name, 2000, 1);
+
+                SLightmapAtlasConfig config;
+                config.resolution = pageSize;
+                config.padding = padding;
+                config.packer = EAtlasPacker::Shelf;
+                CLightmapAtlas shelf;
+                auto start = now();
+                shelf.Pack(sizes, config);
+                double shelfMs = msSince(start);
+
+                std::vector<SPackRect> rects;
+                for (const auto& s : sizes) rects.push_back({s.first, s.second, false});
+                CMaxRectsPacker upright;
+                start = now();
+                upright.Pack(rects, pageSize, padding);
+                double uprightMs = msSince(start);
+
+                for (SPackRect& r : rects) r.allowRotation = true;
+                CMaxRectsPacker rotating;
+                start = now();
+                rotating.Pack(rects, pageSize, padding);
+                double rotatingMs = msSince(start);
+
+                log.LogInfo("%-18s : %2d  %5.1f%%  %9.2f ms | %2d  %5.1f%%  %9.2f ms | %2d  %5.1f%%  %9.2f ms", name,
+                            shelf.GetAtlasCount(), shelf.GetOccupancy() * 100.0f, shelfMs,
+                            upright.GetStats().pageCount, upright.GetStats().occupancy * 100.0f, uprightMs,
+                            rotating.GetStats().pageCount, rotating.GetStats().occupancy * 100.0f, rotatingMs);
+                neverWorse &= upright.GetStats().occupancy >= shelf.GetOccupancy();
+            }
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, neverWorse, "MaxRects occupancy >= shelf on every distribution");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestLightmapPacker)
@@ -0,0 +1,403 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Engine/Rendering/Lightmap/LightmapRasterizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+/**
+ * Test: tiled, multithreaded, conservative lightmap rasterizer
+ *
+ * Frame 1 (CPU only):
+ *   - Full-region quad: every kernel covers every texel, positions interpolate
+ *   - Scalar, SIMD, single- and multithreaded give identical texels
+ *   - Texels outside the mesh's region are never written
+ *   - Conservative covers a sliver that misses every texel centre, coverage
+ *     sums to the triangle area and samples lie on the triangle
+ *   - Conservative is a superset of centre sampling
+ *
+ * Frame 5 (benchmark, 256 lat-long spheres in a 2048^2 atlas):
+ *   - Reference vs Scalar vs SIMD, 1 thread vs CJobSystem: texels/sec
+ *   - Coverage: centre sampling vs conservative
+ *
+ * Usage:
+ *   forfun.exe --test TestLightmapRasterizer
+ *   Results: E:/forfun/debug/TestLightmapRasterizer/test.log
+ */
+class CTestLightmapRasterizer : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestLightmapRasterizer";
+    }
+
+    struct SMesh {
+        std::vector<XMFLOAT3> positions;
+        std::vector<XMFLOAT3> normals;
+        std::vector<XMFLOAT2> uv2;
+        std::vector<uint32_t> indices;
+    };
+
+    // Quad in the XZ plane, world position = (u, 0, v) of the UV2 [uvMin, uvMax]
+    static SMesh makeQuad(float uvMin, float uvMax) {
+        SMesh mesh;
+        mesh.uv2 = {{uvMin, uvMin}, {uvMax, uvMin}, {uvMax, uvMax}, {uvMin, uvMax}};
+        for (const XMFLOAT2& uv : mesh.uv2) {
+            mesh.positions.push_back({uv.x, 0.0f, uv.y});
+            mesh.normals.push_back({0.0f, 1.0f, 0.0f});
+        }
+        mesh.indices = {0, 1, 2, 0, 2, 3};
+        return mesh;
+    }
+
+    // Unit sphere with lat-long UV2: thin triangles towards the poles
+    static SMesh makeSphere(int slices, int stacks) {
+        SMesh mesh;
+        for (int j = 0; j <= stacks; j++) {
+            float theta = XM_PI * j / stacks;
+            for (int i = 0; i <= slices; i++) {
+                float phi = XM_2PI * i / slices;
+                XMFLOAT3 p = {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+                mesh.positions.push_back(p);
+                mesh.normals.push_back(p);
+                mesh.uv2.push_back({(float)i / slices, (float)j / stacks});
+            }
+        }
+        for (int j = 0; j < stacks; j++) {
+            for (int i = 0; i < slices; i++) {
+                uint32_t v0 = j * (slices + 1) + i, v1 = v0 + 1, v2 = v0 + slices + 1, v3 = v2 + 1;
+                mesh.indices.insert(mesh.indices.end(), {v0, v2, v1, v1, v2, v3});
+            }
+        }
+        return mesh;
+    }
+
+    // Random, overlapping triangles inside [0,1]^2
+    static SMesh makeSoup(int count, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> d(0.0f, 1.0f);
+        SMesh mesh;
+        for (int i = 0; i < count * 3; i++) {
+            XMFLOAT2 uv = {d(rng), d(rng)};
+            mesh.uv2.push_back(uv);
+            mesh.positions.push_back({uv.x, d(rng), uv.y});
+            mesh.normals.push_back({d(rng) - 0.5f, 1.0f, d(rng) - 0.5f});
+            mesh.indices.push_back((uint32_t)i);
+        }
+        return mesh;
+    }
+
+    static void rasterize(CLightmapRasterizer& rasterizer, const SMesh& mesh, int size,
+                          int offset, int region, const SLightmapRasterConfig& config) {
+        rasterizer.Initialize(size, size);
+        rasterizer.SetConfig(config);
+        rasterizer.RasterizeMesh(mesh.positions, mesh.normals, mesh.uv2, mesh.indices,
+                                 XMMatrixIdentity(), offset, offset, region, region);
+    }
+
+    // The rasterizer's original serial path: per-texel barycentric test at the
+    // texel centre over each triangle's bounding box. Accuracy and speed baseline.
+    static bool barycentric(float px, float py, float x0, float y0, float x1, float y1, float x2, float y2,
+                            float& lambda0, float& lambda1, float& lambda2) {
+        float denom = (y1 - y2) * (x0 - x2) + (x2 - x1) * (y0 - y2);
+        if (std::abs(denom) < 1e-8f) return false;
+        float invDenom = 1.0f / denom;
+        lambda0 = ((y1 - y2) * (px - x2) + (x2 - x1) * (py - y2)) * invDenom;
+        lambda1 = ((y2 - y0) * (px - x2) + (x0 - x2) * (py - y2)) * invDenom;
+        lambda2 = 1.0f - lambda0 - lambda1;
+        const float eps = -1e-4f;
+        return lambda0 >= eps && lambda1 >= eps && lambda2 >= eps;
+    }
+
+    static void rasterizeReference(std::vector<STexelData>& texels, int size, const SMesh& mesh,
+                                   const XMMATRIX& world, int offsetX, int offsetY, int regionWidth, int regionHeight) {
+        XMMATRIX normalMatrix = XMMatrixTranspose(XMMatrixInverse(nullptr, world));
+        std::vector<XMFLOAT3> positions(mesh.positions.size()), normals(mesh.normals.size());
+        for (size_t i = 0; i < mesh.positions.size(); i++) {
+            XMStoreFloat3(&positions[i], XMVector3TransformCoord(XMLoadFloat3(&mesh.positions[i]), world));
+            XMStoreFloat3(&normals[i], XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&mesh.normals[i]), normalMatrix)));
+        }
+
+        for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+            uint32_t v[3] = {mesh.indices[t], mesh.indices[t + 1], mesh.indices[t + 2]};
+            float x[3], y[3];
+            for (int k = 0; k < 3; k++) {
+                x[k] = mesh.uv2[v[k]].x * regionWidth + offsetX;
+                y[k] = mesh.uv2[v[k]].y * regionHeight + offsetY;
+            }
+            int minX = std::max(0, (int)std::floor(std::min({x[0], x[1], x[2]})));
+            int maxX = std::min(size - 1, (int)std::ceil(std::max({x[0], x[1], x[2]})));
+            int minY = std::max(0, (int)std::floor(std::min({y[0], y[1], y[2]})));
+            int maxY = std::min(size - 1, (int)std::ceil(std::max({y[0], y[1], y[2]})));
+
+            for (int py = minY; py <= maxY; py++) {
+                for (int px = minX; px <= maxX; px++) {
+                    float l[3];
+                    if (!barycentric(px + 0.5f, py + 0.5f, x[0], y[0], x[1], y[1], x[2], y[2], l[0], l[1], l[2])) {
+                        continue;
+                    }
+                    const XMFLOAT3 &p0 = positions[v[0]], &p1 = positions[v[1]], &p2 = positions[v[2]];
+                    const XMFLOAT3 &n0 = normals[v[0]], &n1 = normals[v[1]], &n2 = normals[v[2]];
+                    STexelData& texel = texels[py * size + px];
+                    texel.worldPos = {l[0] * p0.x + l[1] * p1.x + l[2] * p2.x,
+                                      l[0] * p0.y + l[1] * p1.y + l[2] * p2.y,
+                                      l[0] * p0.z + l[1] * p1.z + l[2] * p2.z};
+                    float nx = l[0] * n0.x + l[1] * n1.x + l[2] * n2.x;
+                    float ny = l[0] * n0.y + l[1] * n1.y + l[2] * n2.y;
+                    float nz = l[0] * n0.z + l[1] * n1.z + l[2] * n2.z;
+                    float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+                    texel.normal = len > 1e-6f ? XMFLOAT3(nx / len, ny / len, nz / len) : XMFLOAT3(0, 1, 0);
+                    texel.coverage = 1.0f;
+                    texel.valid = true;
+                }
+            }
+        }
+    }
+
+    static int countValid(const std::vector<STexelData>& texels) {
+        int count = 0;
+        for (const STexelData& texel : texels) count += texel.valid ? 1 : 0;
+        return count;
+    }
+
+    static bool sameTexels(const CLightmapRasterizer& a, const CLightmapRasterizer& b) {
+        const auto& ta = a.GetTexels();
+        const auto& tb = b.GetTexels();
+        if (ta.size() != tb.size()) return false;
+        for (size_t i = 0; i < ta.size(); i++) {
+            if (ta[i].valid != tb[i].valid) return false;
+            if (!ta[i].valid) continue;
+            if (std::memcmp(&ta[i].worldPos, &tb[i].worldPos, sizeof(XMFLOAT3)) != 0 ||
+                std::memcmp(&ta[i].normal, &tb[i].normal, sizeof(XMFLOAT3)) != 0 ||
+                ta[i].coverage != tb[i].coverage) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestLightmapRasterizer ===");
+            CFFLog::Info("Frame 1: Lightmap rasterizer");
+
+            SLightmapRasterConfig centre;
+            centre.conservative = false;
+            centre.multithreaded = false;
+            SLightmapRasterConfig conservative = centre;
+            conservative.conservative = true;
+
+            // Full-region quad
+            {
+                SMesh quad = makeQuad(0.0f, 1.0f);
+                std::vector<STexelData> reference(64 * 64);
+                rasterizeReference(reference, 64, quad, XMMatrixIdentity(), 0, 0, 64, 64);
+                ASSERT_EQUAL(ctx, countValid(reference), 64 * 64, "Reference: full quad covers every texel");
+                for (ERasterKernel kernel : {ERasterKernel::Scalar, ERasterKernel::SIMD}) {
+                    for (bool cons : {false, true}) {
+                        SLightmapRasterConfig config = centre;
+                        config.kernel = kernel;
+                        config.conservative = cons;
+                        CLightmapRasterizer rasterizer;
+                        rasterize(rasterizer, quad, 64, 0, 64, config);
+                        ASSERT_EQUAL(ctx, rasterizer.GetValidTexelCount(), 64 * 64, "Full quad covers every texel");
+                        const STexelData& texel = rasterizer.GetTexels()[20 * 64 + 10];
+                        ASSERT(ctx, std::abs(texel.worldPos.x - 10.5f / 64) < 1e-5f && std::abs(texel.worldPos.z - 20.5f / 64) < 1e-5f,
+                               "Texel (10,20) samples its centre");
+                    }
+                }
+            }
+
+            // Kernels, threads and tile sizes agree
+            {
+                auto& jobs = CJobSystem::Instance();
+                if (!jobs.IsInitialized()) {
+                    jobs.Initialize();
+                }
+                SMesh soup = makeSoup(400, 3);
+                for (bool cons : {false, true}) {
+                    SLightmapRasterConfig config = cons ? conservative : centre;
+                    config.kernel = ERasterKernel::Scalar;
+                    CLightmapRasterizer scalar, simd, threaded;
+                    rasterize(scalar, soup, 256, 0, 256, config);
+                    config.kernel = ERasterKernel::SIMD;
+                    rasterize(simd, soup, 256, 0, 256, config);
+                    config.multithreaded = true;
+                    config.tileSize = 16;
+                    rasterize(threaded, soup, 256, 0, 256, config);
+                    ASSERT(ctx, sameTexels(scalar, simd), cons ? "Conservative: SIMD == Scalar" : "Centre: SIMD == Scalar");
+                    ASSERT(ctx, sameTexels(scalar, threaded), cons ? "Conservative: tiled threads == single" : "Centre: tiled threads == single");
+                }
+            }
+
+            // Region clamp: UV2 spilling past [0,1] stays inside the region
+            {
+                SMesh quad = makeQuad(-0.1f, 1.1f);
+                CLightmapRasterizer rasterizer;
+                rasterize(rasterizer, quad, 64, 16, 32, conservative);
+                int outside = 0;
+                for (int y = 0; y < 64; y++) {
+                    for (int x = 0; x < 64; x++) {
+                        bool inRegion = x >= 16 && x < 48 && y >= 16 && y < 48;
+                        if (rasterizer.GetTexels()[y * 64 + x].valid != inRegion) outside++;
+                    }
+                }
+                ASSERT_EQUAL(ctx, outside, 0, "Exactly the region's texels are written");
+            }
+
+            // Sliver between texel centres: x in [10.6, 10.85], y in [4, 40] of a 64 region
+            {
+                SMesh sliver;
+                sliver.uv2 = {{10.6f / 64, 4.0f / 64}, {10.85f / 64, 4.0f / 64}, {10.6f / 64, 40.0f / 64}};
+                for (const XMFLOAT2& uv : sliver.uv2) {
+                    sliver.positions.push_back({uv.x, 0.0f, uv.y});
+                    sliver.normals.push_back({0.0f, 1.0f, 0.0f});
+                }
+                sliver.indices = {0, 1, 2};
+
+                CLightmapRasterizer sampled, covered;
+                std::vector<STexelData> reference(64 * 64);
+                rasterizeReference(reference, 64, sliver, XMMatrixIdentity(), 0, 0, 64, 64);
+                rasterize(sampled, sliver, 64, 0, 64, centre);
+                rasterize(covered, sliver, 64, 0, 64, conservative);
+                ASSERT_EQUAL(ctx, countValid(reference), 0, "Reference misses the sliver");
+                ASSERT_EQUAL(ctx, sampled.GetValidTexelCount(), 0, "Centre sampling misses the sliver");
+                ASSERT_EQUAL(ctx, covered.GetValidTexelCount(), 36, "Conservative covers the sliver's 36 texels");
+
+                double coverageSum = 0.0;
+                bool onTriangle = true;
+                for (const STexelData& texel : covered.GetTexels()) {
+                    if (!texel.valid) continue;
+                    coverageSum += texel.coverage;
+                    // World = UV here: inside x >= 10.6, y >= 4 and the hypotenuse
+                    float x = texel.worldPos.x * 64, y = texel.worldPos.z * 64;
+                    float hyp = (10.85f - x) * 36.0f - (y - 4.0f) * 0.25f;
+                    onTriangle &= x >= 10.6f - 1e-3f && y >= 4.0f - 1e-3f && hyp >= -1e-2f;
+                }
+                ASSERT_EQUAL_F(ctx, (float)coverageSum, 0.5f * 0.25f * 36.0f, 1e-3f, "Coverage sums to the sliver's area");
+                ASSERT(ctx, onTriangle, "Partial texels sample inside the triangle");
+            }
+
+            // Conservative is a superset of centre sampling; shared edges pick the larger overlap
+            {
+                SMesh sphere = makeSphere(48, 24);
+                CLightmapRasterizer sampled, covered;
+                rasterize(sampled, sphere, 128, 0, 128, centre);
+                rasterize(covered, sphere, 128, 0, 128, conservative);
+                int missing = 0, halfCovered = 0;
+                for (size_t i = 0; i < sampled.GetTexels().size(); i++) {
+                    if (sampled.GetTexels()[i].valid && !covered.GetTexels()[i].valid) missing++;
+                    if (covered.GetTexels()[i].valid && covered.GetTexels()[i].coverage < 0.5f) halfCovered++;
+                }
+                ASSERT_EQUAL(ctx, missing, 0, "Every centre-sampled texel is covered conservatively");
+                CFFLog::Info("Sphere 128^2: centre %d, conservative %d (%d partial, %d below half)",
+                             sampled.GetValidTexelCount(), covered.GetValidTexelCount(),
+                             covered.GetStats().partialTexels, halfCovered);
+                ASSERT(ctx, covered.GetStats().partialTexels > 0, "Thin pole triangles produce partial texels");
+            }
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            CFFLog& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Lightmap rasterizer (256 spheres, 2048^2 atlas)");
+            auto& jobs = CJobSystem::Instance();
+            if (!jobs.IsInitialized()) {
+                jobs.Initialize();
+            }
+
+            // 16 x 16 regions of 128^2, 64 x 32 quads per sphere
+            const int atlasSize = 2048;
+            const int region = 128;
+            SMesh sphere = makeSphere(64, 32);
+            auto run = [&](const SLightmapRasterConfig& config, CLightmapRasterizer& rasterizer) {
+                rasterizer.Initialize(atlasSize, atlasSize);
+                rasterizer.SetConfig(config);
+                for (int r = 0; r < 256; r++) {
+                    XMMATRIX world = XMMatrixTranslation((float)(r % 16) * 3.0f, 0.0f, (float)(r / 16) * 3.0f);
+                    rasterizer.AddMesh(sphere.positions, sphere.normals, sphere.uv2, sphere.indices, world,
+                                       (r % 16) * region, (r / 16) * region, region - 2, region - 2);
+                }
+                auto start = std::chrono::high_resolution_clock::now();
+                rasterizer.Rasterize();
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+
+            log.LogEvent("Throughput");
+            log.LogInfo("%d triangles, %u threads", 256 * (int)sphere.indices.size() / 3, jobs.GetThreadCount());
+
+            std::vector<STexelData> reference((size_t)atlasSize * atlasSize);
+            auto referenceStart = std::chrono::high_resolution_clock::now();
+            for (int r = 0; r < 256; r++) {
+                XMMATRIX world = XMMatrixTranslation((float)(r % 16) * 3.0f, 0.0f, (float)(r / 16) * 3.0f);
+                rasterizeReference(reference, atlasSize, sphere, world, (r % 16) * region, (r / 16) * region,
+                                   region - 2, region - 2);
+            }
+            double referenceMs = std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - referenceStart).count();
+            int referenceTexels = countValid(reference);
+            log.LogInfo("Reference (original)   : %8.2f ms | %7.1f Mtexels/s", referenceMs,
+                        referenceTexels / (referenceMs * 1000.0));
+
+            struct SRun { const char* name; ERasterKernel kernel; bool conservative; bool threads; };
+            const SRun runs[] = {
+                {"Scalar, centre, 1T     ", ERasterKernel::Scalar, false, false},
+                {"SIMD, centre, 1T       ", ERasterKernel::SIMD, false, false},
+                {"SIMD, centre, MT       ", ERasterKernel::SIMD, false, true},
+                {"Scalar, conserv., 1T   ", ERasterKernel::Scalar, true, false},
+                {"SIMD, conserv., 1T     ", ERasterKernel::SIMD, true, false},
+                {"SIMD, conserv., MT     ", ERasterKernel::SIMD, true, true},
+            };
+
+            int centreTexels = 0, conservativeTexels = 0;
+            for (const SRun& r : runs) {
+                SLightmapRasterConfig config;
+                config.kernel = r.kernel;
+                config.conservative = r.conservative;
+                config.multithreaded = r.threads;
+                CLightmapRasterizer rasterizer;
+                double ms = run(config, rasterizer);
+                int texels = rasterizer.GetValidTexelCount();
+                if (r.conservative) {
+                    conservativeTexels = texels;
+                } else {
+                    centreTexels = texels;
+                }
+                log.LogInfo("%s: %8.2f ms | %7.1f Mtexels/s | %5.1fx", r.name, ms,
+                            texels / (ms * 1000.0), referenceMs / ms);
+            }
+
+            log.LogEvent("Coverage");
+            log.LogInfo("Reference     : %d texels", referenceTexels);
+            log.LogInfo("Centre        : %d texels", centreTexels);
+            log.LogInfo("Conservative  : %d texels (+%.1f%% over reference)", conservativeTexels,
+                        100.0 * (conservativeTexels - referenceTexels) / std::max(1, referenceTexels));
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, conservativeTexels >= centreTexels, "Conservative covers at least the centre-sampled texels");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestLightmapRasterizer)
@@ -0,0 +1,239 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/Loader/FFMeshLoader.h"
+#include "Core/MeshResourceManager.h"
+#include "Core/DerivedDataCache.h"
+#include "Core/PathManager.h"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Test: cooked .ffmesh cache
+ *
+ * Frame 1 (CPU only):
+ *   - WriteFFMesh / CFFMeshFile round trip is byte-identical (vertices, indices)
+ *   - Sub-mesh ranges and bounds
+ *   - Source key mismatch (mtime, size, import options) is detected
+ *   - Truncated and bad-magic files are rejected
+ *   - Indices past the sub-mesh's vertex count are rejected
+ *
+ * Frame 5 (benchmark):
+ *   - Loads a set of meshes through CMeshResourceManager from source
+ *     (disk cache disabled), then cooks them and loads them again from .ffmesh
+ *   - Reports load time per mesh before / after
+ *
+ * Usage:
+ *   forfun.exe --test TestMeshCache
+ *   Results: E:/forfun/debug/TestMeshCache/test.log
+ */
+class CTestMeshCache : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestMeshCache";
+    }
+
+    // Grid of quads in the XZ plane, distinct values in every attribute
+    static SMeshCPU_PNT makeGrid(uint32_t n, float offset) {
+        SMeshCPU_PNT mesh;
+        for (uint32_t z = 0; z <= n; z++) {
+            for (uint32_t x = 0; x <= n; x++) {
+                SVertexPNT v = {};
+                v.px = offset + (float)x; v.py = 0.5f * (float)((x + z) % 3); v.pz = (float)z;
+                v.nx = 0.0f; v.ny = 1.0f; v.nz = 0.0f;
+                v.u = (float)x / n; v.v = (float)z / n;
+                v.tx = 1.0f; v.ty = 0.0f; v.tz = 0.0f; v.tw = 1.0f;
+                v.r = v.g = v.b = v.a = 1.0f;
+                v.u2 = v.u * 0.5f; v.v2 = v.v * 0.5f;
+                mesh.vertices.push_back(v);
+            }
+        }
+        for (uint32_t z = 0; z < n; z++) {
+            for (uint32_t x = 0; x < n; x++) {
+                uint32_t i0 = z * (n + 1) + x, i1 = i0 + 1, i2 = i0 + n + 1, i3 = i2 + 1;
+                mesh.indices.insert(mesh.indices.end(), {i0, i2, i1, i1, i2, i3});
+            }
+        }
+        return mesh;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestMeshCache ===");
+            CFFLog::Info("Frame 1: .ffmesh round trip");
+
+            std::filesystem::path dir = std::filesystem::temp_directory_path() / "forfun_test_meshcache";
+            std::string path = (dir / "grid.ffmesh").string();
+
+            SMeshCPU_PNT a = makeGrid(16, 0.0f);
+            SMeshCPU_PNT b = makeGrid(5, 100.0f);
+            SFFMeshSourceKey key;
+            key.sourceMtime = 1234567;
+            key.sourceSize = 4096;
+            key.importOptions = FFMeshImport_LightmapUV2;
+
+            ASSERT(ctx, WriteFFMesh(path, key, {&a, &b}), "WriteFFMesh succeeds");
+
+            {
+                CFFMeshFile file;
+                ASSERT(ctx, file.Open(path), "Open cooked file");
+                ASSERT(ctx, file.Matches(key), "Source key matches");
+                ASSERT_EQUAL(ctx, (int)file.GetSubMeshCount(), 2, "Sub-mesh count");
+
+                const SMeshCPU_PNT* sources[2] = {&a, &b};
+                for (uint32_t i = 0; i < 2 && file.GetSubMeshCount() == 2; i++) {
+                    const SMeshCPU_PNT& src = *sources[i];
+                    const SFFMeshSubMesh& desc = file.GetSubMesh(i);
+                    ASSERT_EQUAL(ctx, (int)desc.vertexCount, (int)src.vertices.size(), "Sub-mesh vertex count");
+                    ASSERT_EQUAL(ctx, (int)desc.indexCount, (int)src.indices.size(), "Sub-mesh index count");
+                    ASSERT(ctx, memcmp(file.GetVertices(i), src.vertices.data(), src.vertices.size() * sizeof(SVertexPNT)) == 0,
+                           "Vertices byte-identical");
+                    ASSERT(ctx, memcmp(file.GetIndices(i), src.indices.data(), src.indices.size() * sizeof(uint32_t)) == 0,
+                           "Indices byte-identical");
+                    ASSERT(ctx, ((uintptr_t)file.GetVertices(i) & 3) == 0, "Vertex data aligned");
+                }
+                if (file.GetSubMeshCount() == 2) {
+                    const SFFMeshSubMesh& desc = file.GetSubMesh(1);
+                    ASSERT_EQUAL_F(ctx, desc.boundsMin[0], 100.0f, 1e-6f, "Bounds min x");
+                    ASSERT_EQUAL_F(ctx, desc.boundsMax[0], 105.0f, 1e-6f, "Bounds max x");
+                    ASSERT_EQUAL_F(ctx, desc.boundsMax[1], 1.0f, 1e-6f, "Bounds max y");
+                    ASSERT_EQUAL_F(ctx, desc.boundsMax[2], 5.0f, 1e-6f, "Bounds max z");
+
+                    SMeshCPU_PNT copy;
+                    file.CopySubMesh(1, copy);
+                    ASSERT(ctx, copy.indices == b.indices, "CopySubMesh indices");
+                }
+
+                SFFMeshSourceKey stale = key;
+                stale.sourceMtime++;
+                ASSERT(ctx, !file.Matches(stale), "Changed mtime invalidates");
+                stale = key;
+                stale.sourceSize++;
+                ASSERT(ctx, !file.Matches(stale), "Changed size invalidates");
+                stale = key;
+                stale.importOptions = FFMeshImport_None;
+                ASSERT(ctx, !file.Matches(stale), "Changed import options invalidate");
+            }
+
+            // Damaged files
+            std::vector<char> bytes;
+            {
+                std::ifstream in(path, std::ios::binary);
+                bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            }
+            std::string damaged = (dir / "damaged.ffmesh").string();
+            auto writeBytes = [&damaged](const char* data, size_t size) {
+                std::ofstream out(damaged, std::ios::binary | std::ios::trunc);
+                out.write(data, (std::streamsize)size);
+            };
+
+            CFFMeshFile file;
+            writeBytes(bytes.data(), bytes.size() - 8);
+            ASSERT(ctx, !file.Open(damaged), "Truncated file rejected");
+            writeBytes(bytes.data(), 16);
+            ASSERT(ctx, !file.Open(damaged), "File shorter than the header rejected");
+            std::vector<char> badMagic = bytes;
+            badMagic[0] ^= 0x5A;
+            writeBytes(badMagic.data(), badMagic.size());
+            ASSERT(ctx, !file.Open(damaged), "Bad magic rejected");
+            std::vector<char> badIndex = bytes;
+            SFFMeshHeader header;
+            memcpy(&header, bytes.data(), sizeof(header));
+            uint32_t outOfRange = (uint32_t)a.vertices.size();
+            memcpy(badIndex.data() + header.indexDataOffset, &outOfRange, sizeof(outOfRange));
+            writeBytes(badIndex.data(), badIndex.size());
+            ASSERT(ctx, !file.Open(damaged), "Index past the sub-mesh vertex count rejected");
+            writeBytes(nullptr, 0);
+            ASSERT(ctx, !file.Open(damaged), "Empty file rejected");
+            ASSERT(ctx, !file.Open((dir / "missing.ffmesh").string()), "Missing file rejected");
+
+            std::error_code ec;
+            std::filesystem::remove_all(dir, ec);
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Mesh Cache");
+
+            const char* meshes[] = {
+                "mesh/cube.obj",
+                "mesh/sphere.obj",
+                "pbr_models/Barrel_01_1k.gltf/Barrel_01_1k.gltf",
+            };
+
+            auto& manager = CMeshResourceManager::Instance();
+            bool wasEnabled = manager.IsDiskCacheEnabled();
+            auto timeLoad = [&manager](const std::string& path, size_t& outCount) {
+                manager.ClearCache();
+                auto start = std::chrono::high_resolution_clock::now();
+                auto resources = manager.GetOrLoad(path, false, true);
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+                outCount = resources.size();
+                return ms;
+            };
+
+            log.LogEvent("Load time (ms): source import vs cooked .ffmesh");
+            double totalSource = 0.0, totalCooked = 0.0;
+            for (const char* mesh : meshes) {
+                std::string path = FFPath::GetAbsolutePath(mesh);
+                if (!std::filesystem::exists(path)) {
+                    log.LogInfo("%-50s : missing, skipped", mesh);
+                    continue;
+                }
+
+                // Source, nothing written
+                size_t sourceCount = 0;
+                manager.SetDiskCacheEnabled(false);
+                double sourceMs = timeLoad(path, sourceCount);
+
+                // Cook, then measure the cooked load
+                size_t cookedCount = 0;
+                SDerivedDataKey key;
+                if (manager.MakeDerivedDataKey(path, true, key)) {
+                    CDerivedDataCache::Instance().Remove(key);
+                }
+                manager.SetDiskCacheEnabled(true);
+                timeLoad(path, cookedCount);
+                manager.ResetLoadStats();
+                double cookedMs = timeLoad(path, cookedCount);
+                ASSERT_EQUAL(ctx, (int)manager.GetLoadStats().cookedLoads, 1, "Second load comes from the cooked file");
+                ASSERT_EQUAL(ctx, (int)cookedCount, (int)sourceCount, "Cooked load has the same sub-meshes");
+
+                log.LogInfo("%-50s : source %8.2f | cooked %7.2f | %5.1fx", mesh, sourceMs, cookedMs,
+                            cookedMs > 0.0 ? sourceMs / cookedMs : 0.0);
+                totalSource += sourceMs;
+                totalCooked += cookedMs;
+            }
+            log.LogInfo("%-50s : source %8.2f | cooked %7.2f", "Total", totalSource, totalCooked);
+
+            manager.SetDiskCacheEnabled(wasEnabled);
+            manager.ClearCache();
+            manager.LogLoadReport();
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, totalCooked <= totalSource, "Cooked loads are not slower than source imports");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestMeshCache)
@@ -0,0 +1,380 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/MeshSimplifier.h"
+#include "Core/MeshOptimizer.h"
+#include "Core/GpuMeshResource.h"
+#include "Core/Loader/FFMeshLoader.h"
+#include "Core/Loader/ObjLoader.h"
+#include "Core/PathManager.h"
+#include "Engine/Rendering/MeshLod.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+
+/**
+ * Test: mesh LOD chains (Core/MeshSimplifier.h, Engine/Rendering/MeshLod.h)
+ *
+ * Frame 1 (CPU only, deterministic):
+ *   - Flat grid simplifies with zero error and keeps its outline
+ *   - Seamed UV sphere stays closed in position space, no flipped triangles
+ *   - Error limit respected, same output on repeated runs
+ *   - GenerateMeshLods: fewer triangles and larger error at every level,
+ *     .ffmesh round trip of the LOD table
+ *   - LOD selection: SelectLod thresholds, screen-error budget vs distance / scale
+ *
+ * Frame 5 (benchmark):
+ *   - Triangles, error and simplification time per level for a dense sphere
+ *     and a few project meshes
+ *
+ * Usage:
+ *   forfun.exe --test TestMeshLod
+ *   Results: E:/forfun/debug/TestMeshLod/test.log
+ */
+class CTestMeshLod : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestMeshLod";
+    }
+
+    // Flat grid of (n+1)^2 vertices in the XZ plane, normals up
+    static SMeshCPU_PNT makeGrid(uint32_t n) {
+        SMeshCPU_PNT mesh;
+        for (uint32_t z = 0; z <= n; z++) {
+            for (uint32_t x = 0; x <= n; x++) {
+                SVertexPNT v = {};
+                v.px = (float)x; v.pz = (float)z;
+                v.ny = 1.0f;
+                v.u = (float)x / n; v.v = (float)z / n;
+                mesh.vertices.push_back(v);
+            }
+        }
+        for (uint32_t z = 0; z < n; z++) {
+            for (uint32_t x = 0; x < n; x++) {
+                uint32_t i0 = z * (n + 1) + x, i1 = i0 + 1, i2 = i0 + n + 1, i3 = i2 + 1;
+                mesh.indices.insert(mesh.indices.end(), {i0, i2, i1, i1, i2, i3});
+            }
+        }
+        return mesh;
+    }
+
+    // UV sphere: duplicated seam column and pole rows, like an exported mesh
+    static SMeshCPU_PNT makeSphere(uint32_t rings, uint32_t segments, float r) {
+        const float pi = 3.14159265f;
+        SMeshCPU_PNT mesh;
+        for (uint32_t y = 0; y <= rings; y++) {
+            float theta = pi * (float)y / rings;
+            float sinTheta = (y == 0 || y == rings) ? 0.0f : std::sin(theta);   // Poles weld too
+            for (uint32_t x = 0; x <= segments; x++) {
+                float phi = 2.0f * pi * (float)(x % segments) / segments;    // Seam copies bit-identical
+                SVertexPNT v = {};
+                v.nx = sinTheta * std::cos(phi);
+                v.ny = std::cos(theta);
+                v.nz = sinTheta * std::sin(phi);
+                v.px = r * v.nx; v.py = r * v.ny; v.pz = r * v.nz;
+                v.u = (float)x / segments; v.v = (float)y / rings;
+                mesh.vertices.push_back(v);
+            }
+        }
+        for (uint32_t y = 0; y < rings; y++) {
+            for (uint32_t x = 0; x < segments; x++) {
+                uint32_t i0 = y * (segments + 1) + x, i1 = i0 + 1;
+                uint32_t i2 = i0 + segments + 1, i3 = i2 + 1;
+                if (y != 0) mesh.indices.insert(mesh.indices.end(), {i0, i1, i2});
+                if (y != rings - 1) mesh.indices.insert(mesh.indices.end(), {i1, i3, i2});
+            }
+        }
+        return mesh;
+    }
+
+    static XMFLOAT3 position(const SVertexPNT& v) { return XMFLOAT3(v.px, v.py, v.pz); }
+
+    static XMFLOAT3 triangleNormal(const std::vector<SVertexPNT>& vertices, const uint32_t* tri) {
+        XMFLOAT3 a = position(vertices[tri[0]]), b = position(vertices[tri[1]]), c = position(vertices[tri[2]]);
+        float e1[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+        float e2[3] = {c.x - a.x, c.y - a.y, c.z - a.z};
+        return XMFLOAT3(e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]);
+    }
+
+    // Every directed edge between distinct positions has its reverse: closed and consistently wound
+    static bool isClosed(const std::vector<SVertexPNT>& vertices, const std::vector<uint32_t>& indices) {
+        std::map<std::array<float, 3>, uint32_t> ids;
+        auto id = [&](uint32_t v) {
+            std::array<float, 3> key = {vertices[v].px, vertices[v].py, vertices[v].pz};
+            return ids.emplace(key, (uint32_t)ids.size()).first->second;
+        };
+        std::map<std::pair<uint32_t, uint32_t>, int> edges;
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            uint32_t p[3] = {id(indices[t]), id(indices[t + 1]), id(indices[t + 2])};
+            if (p[0] == p[1] || p[1] == p[2] || p[0] == p[2]) continue;
+            for (int k = 0; k < 3; k++) {
+                edges[{p[k], p[(k + 1) % 3]}]++;
+            }
+        }
+        for (const auto& e : edges) {
+            auto reverse = edges.find({e.first.second, e.first.first});
+            if (reverse == edges.end() || reverse->second != e.second) return false;
+        }
+        return true;
+    }
+
+    // Triangle normals point away from the sphere center (slivers whose plane
+    // passes through the center, e.g. along a meridian, count as not flipped)
+    static bool facesOutward(const std::vector<SVertexPNT>& vertices, const std::vector<uint32_t>& indices) {
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            XMFLOAT3 n = triangleNormal(vertices, &indices[t]);
+            const SVertexPNT& a = vertices[indices[t]];
+            float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+            if (n.x * a.px + n.y * a.py + n.z * a.pz < -1e-3f * length) return false;
+        }
+        return true;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("TestMeshLod: CPU tests");
+
+            // --- Flat grid: collapses are free, outline stays ---
+            {
+                SMeshCPU_PNT grid = makeGrid(32);
+                size_t target = grid.indices.size() / 10;
+                float error = -1.0f;
+                std::vector<uint32_t> lod = SimplifyMesh(grid.vertices.data(), (uint32_t)grid.vertices.size(),
+                                                         grid.indices.data(), grid.indices.size(), target, 1e-4f, &error);
+                ASSERT(ctx, !lod.empty() && lod.size() <= target, "Planar grid reaches the target");
+                ASSERT(ctx, error >= 0.0f && error < 1e-3f, "Planar grid error ~0");
+                ASSERT_EQUAL(ctx, (int)(lod.size() % 3), 0, "Whole triangles");
+
+                bool corners[4] = {false, false, false, false};
+                const uint32_t cornerIds[4] = {0, 32, 33 * 32, 33 * 33 - 1};
+                bool upward = true;
+                float area = 0.0f;
+                for (size_t t = 0; t < lod.size(); t += 3) {
+                    XMFLOAT3 n = triangleNormal(grid.vertices, &lod[t]);
+                    upward = upward && n.y > 0.0f;
+                    area += 0.5f * n.y;
+                    for (int c = 0; c < 4; c++) {
+                        for (int k = 0; k < 3; k++) corners[c] = corners[c] || lod[t + k] == cornerIds[c];
+                    }
+                }
+                ASSERT(ctx, corners[0] && corners[1] && corners[2] && corners[3], "Grid corners kept");
+                ASSERT(ctx, upward, "No flipped triangles on the grid");
+                ASSERT_EQUAL_F(ctx, area, 32.0f * 32.0f, 1e-2f, "Grid area preserved (outline intact)");
+            }
+
+            // --- Seamed sphere: closed, outward, within the error limit ---
+            SMeshCPU_PNT sphere = makeSphere(24, 48, 1.0f);
+            {
+                ASSERT(ctx, isClosed(sphere.vertices, sphere.indices), "Source sphere is closed");
+
+                float error = 0.0f;
+                std::vector<uint32_t> lod = SimplifyMesh(sphere.vertices.data(), (uint32_t)sphere.vertices.size(),
+                                                         sphere.indices.data(), sphere.indices.size(),
+                                                         sphere.indices.size() / 4, 1.0f, &error);
+                ASSERT(ctx, lod.size() <= sphere.indices.size() / 4, "Sphere reaches the target");
+                ASSERT(ctx, isClosed(sphere.vertices, lod), "Simplified sphere stays closed across the UV seam");
+                ASSERT(ctx, facesOutward(sphere.vertices, lod), "No flipped triangles on the sphere");
+                ASSERT(ctx, error > 0.0f && error < 0.1f, "Sphere error small and reported");
+
+                std::vector<uint32_t> again = SimplifyMesh(sphere.vertices.data(), (uint32_t)sphere.vertices.size(),
+                                                           sphere.indices.data(), sphere.indices.size(),
+                                                           sphere.indices.size() / 4, 1.0f);
+                ASSERT(ctx, again == lod, "Deterministic output");
+
+                float limited = 0.0f;
+                std::vector<uint32_t> capped = SimplifyMesh(sphere.vertices.data(), (uint32_t)sphere.vertices.size(),
+                                                            sphere.indices.data(), sphere.indices.size(),
+                                                            0, 0.005f, &limited);
+                ASSERT(ctx, limited <= 0.005f, "Error limit respected");
+                ASSERT(ctx, capped.size() < sphere.indices.size() && capped.size() > lod.size() / 4,
+                       "Error limit stops early");
+                ASSERT(ctx, isClosed(sphere.vertices, capped), "Error-limited sphere stays closed");
+            }
+
+            // --- LOD chain ---
+            {
+                SMeshCPU_PNT mesh = makeSphere(48, 96, 2.0f);
+                SMeshLodOptions options;
+                options.lodCount = 4;
+                options.maxError = 0.1f;
+                uint32_t built = GenerateMeshLods(mesh, options);
+                ASSERT_EQUAL(ctx, (int)built, 3, "Three LODs below LOD0");
+                ASSERT_EQUAL(ctx, (int)mesh.lods.size(), (int)built, "mesh.lods filled");
+
+                size_t previousCount = mesh.indices.size();
+                float previousError = 0.0f;
+                bool inRange = true;
+                for (const SMeshLodCPU& lod : mesh.lods) {
+                    ASSERT(ctx, lod.indices.size() < previousCount, "Each level has fewer triangles");
+                    ASSERT(ctx, lod.error >= previousError, "Error grows with the level");
+                    for (uint32_t i : lod.indices) inRange = inRange && i < mesh.vertices.size();
+                    previousCount = lod.indices.size();
+                    previousError = lod.error;
+                }
+                ASSERT(ctx, inRange, "LODs index the shared vertex buffer");
+                ASSERT(ctx, previousError <= options.maxError * 2.0f, "Cumulative error within the budget (radius 2)");
+
+                SMeshCPU_PNT none = makeSphere(48, 96, 2.0f);
+                options.lodCount = 1;
+                ASSERT_EQUAL(ctx, (int)GenerateMeshLods(none, options), 0, "lodCount 1 builds nothing");
+
+                // Cooked round trip
+                std::filesystem::path dir = std::filesystem::temp_directory_path() / "forfun_test_meshlod";
+                std::string path = (dir / "sphere.ffmesh").string();
+                SMeshCPU_PNT grid = makeGrid(4);
+                SFFMeshSourceKey key;
+                key.importOptions = FFMeshImport_Lods;
+                ASSERT(ctx, WriteFFMesh(path, key, {&grid, &mesh}), "WriteFFMesh with LODs");
+
+                CFFMeshFile file;
+                ASSERT(ctx, file.Open(path), "Open cooked file with LODs");
+                if (file.GetSubMeshCount() == 2) {
+                    ASSERT_EQUAL(ctx, (int)file.GetLodCount(0), 0, "Sub-mesh without LODs");
+                    ASSERT_EQUAL(ctx, (int)file.GetLodCount(1), (int)mesh.lods.size(), "LOD count stored");
+                    ASSERT_EQUAL(ctx, (int)file.GetSubMesh(1).indexCount, (int)mesh.indices.size(), "indexCount is LOD0");
+
+                    SMeshCPU_PNT copy;
+                    file.CopySubMesh(1, copy);
+                    ASSERT(ctx, copy.indices == mesh.indices, "LOD0 indices round trip");
+                    bool same = copy.lods.size() == mesh.lods.size();
+                    for (size_t l = 0; same && l < copy.lods.size(); l++) {
+                        same = copy.lods[l].indices == mesh.lods[l].indices && copy.lods[l].error == mesh.lods[l].error;
+                    }
+                    ASSERT(ctx, same, "LOD indices and errors round trip");
+                    // Runs are contiguous: one index buffer upload covers every level
+                    const SFFMeshLod& last = file.GetLod(1, file.GetLodCount(1) - 1);
+                    ASSERT_EQUAL(ctx, (int)(last.firstIndex + last.indexCount),
+                                 (int)(file.GetHeader().indexCount - file.GetSubMesh(1).firstIndex), "LOD runs contiguous");
+                }
+                file.Close();
+                std::error_code ec;
+                std::filesystem::remove_all(dir, ec);
+            }
+
+            // --- Selection ---
+            {
+                GpuMeshResource mesh;
+                mesh.indexCount = 300;
+                ASSERT_EQUAL(ctx, (int)mesh.SelectLod(1.0f), 0, "No LODs: always LOD0");
+                mesh.lods = {SGpuMeshLod{300, 150, 0.01f}, SGpuMeshLod{450, 60, 0.05f}};
+                ASSERT_EQUAL(ctx, (int)mesh.GetLodCount(), 3, "LOD count includes LOD0");
+                ASSERT_EQUAL(ctx, (int)mesh.SelectLod(0.0f), 0, "Zero budget: LOD0");
+                ASSERT_EQUAL(ctx, (int)mesh.SelectLod(0.01f), 1, "Budget equal to the error selects the level");
+                ASSERT_EQUAL(ctx, (int)mesh.SelectLod(0.049f), 1, "Budget between levels");
+                ASSERT_EQUAL(ctx, (int)mesh.SelectLod(10.0f), 2, "Large budget: coarsest");
+                ASSERT_EQUAL(ctx, (int)mesh.GetLod(0).indexCount, 300, "GetLod(0) is the full range");
+                ASSERT_EQUAL(ctx, (int)mesh.GetLod(2).firstIndex, 450, "GetLod(2) range");
+                ASSERT_EQUAL(ctx, (int)mesh.GetIndexBytes(), 510 * 4, "Index bytes cover every level");
+
+                // Camera at the origin looking down +Z, 90 degree vertical FOV (projScale 1)
+                XMMATRIX proj = XMMatrixPerspectiveFovLH(XM_PIDIV2, 16.0f / 9.0f, 0.1f, 1000.0f);
+                MeshLod::SView view = MeshLod::MakeView(proj, 0.002f);
+                ASSERT_EQUAL_F(ctx, view.projScale, 1.0f, 1e-5f, "projScale from the projection");
+
+                XMMATRIX identity = XMMatrixIdentity();
+                float near10 = MeshLod::MaxError(view, XMFLOAT3(0, 0, 10), 1.0f, identity);
+                float far20 = MeshLod::MaxError(view, XMFLOAT3(0, 0, 20), 1.0f, identity);
+                ASSERT_EQUAL_F(ctx, near10, 0.002f * 9.0f, 1e-6f, "Budget at nearest sphere depth");
+                ASSERT_EQUAL_F(ctx, far20 / near10, 19.0f / 9.0f, 1e-4f, "Budget grows with distance");
+                float scaled = MeshLod::MaxError(view, XMFLOAT3(0, 0, 10), 1.0f, XMMatrixScaling(1.0f, 4.0f, 2.0f));
+                ASSERT_EQUAL_F(ctx, scaled, near10 / 4.0f, 1e-6f, "Budget in mesh units (largest scale)");
+                ASSERT_EQUAL_F(ctx, MeshLod::MaxError(view, XMFLOAT3(0, 0, 0.5f), 1.0f, identity), 0.0f, 0.0f,
+                               "Camera inside the bounds: full detail");
+                ASSERT_EQUAL_F(ctx, view.nearDepth, 0.1f, 1e-4f, "Near depth from the projection");
+                ASSERT_EQUAL_F(ctx, MeshLod::MaxError(view, XMFLOAT3(0, 0, 0.5f), 1.0f, identity, true),
+                               0.002f * 0.1f, 1e-7f, "Shadow view: caster around the camera uses the near-plane budget");
+                ASSERT_EQUAL_F(ctx, MeshLod::MaxError(view, XMFLOAT3(0, 0, -20), 1.0f, identity, true),
+                               0.002f * 0.1f, 1e-7f, "Shadow view: caster behind the camera is not forced to LOD0");
+                ASSERT_EQUAL_F(ctx, MeshLod::MaxError(view, XMFLOAT3(0, 0, 10), 1.0f, identity, true), near10, 1e-7f,
+                               "Shadow view: unchanged in front of the near plane");
+                float rzNear = 0.1f, rzFar = 1000.0f;
+                XMMATRIX reversed = XMMatrixPerspectiveFovLH(XM_PIDIV2, 16.0f / 9.0f, rzFar, rzNear);
+                ASSERT_EQUAL_F(ctx, MeshLod::MakeView(reversed, 0.002f).nearDepth, rzNear, 1e-3f,
+                               "Near depth from a reversed-Z projection");
+                MeshLod::SView disabled = MeshLod::MakeView(proj, 0.0f);
+                ASSERT_EQUAL_F(ctx, MeshLod::MaxError(disabled, XMFLOAT3(0, 0, 100), 1.0f, identity), 0.0f, 0.0f,
+                               "Zero screen error disables LODs");
+
+                // Orthographic: no perspective division, constant budget
+                MeshLod::SView ortho = MeshLod::MakeView(XMMatrixOrthographicLH(20.0f, 20.0f, 0.1f, 100.0f), 0.002f);
+                float o1 = MeshLod::MaxError(ortho, XMFLOAT3(0, 0, 5), 1.0f, identity);
+                float o2 = MeshLod::MaxError(ortho, XMFLOAT3(0, 0, 50), 1.0f, identity);
+                ASSERT_EQUAL_F(ctx, o1, 0.002f * 10.0f, 1e-6f, "Orthographic budget");
+                ASSERT_EQUAL_F(ctx, o1, o2, 1e-9f, "Orthographic budget independent of depth");
+            }
+
+            CFFLog::Info("TestMeshLod: CPU tests done");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Mesh LOD");
+
+            auto msSince = [](std::chrono::high_resolution_clock::time_point start) {
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+            auto report = [&](const char* name, SMeshCPU_PNT& mesh) {
+                OptimizeMesh(mesh);
+                auto start = std::chrono::high_resolution_clock::now();
+                uint32_t built = GenerateMeshLods(mesh);
+                double ms = msSince(start);
+                std::string chain = std::to_string(mesh.indices.size() / 3);
+                for (const SMeshLodCPU& lod : mesh.lods) {
+                    char level[64];
+                    snprintf(level, sizeof(level), " -> %zu (%.5f)", lod.indices.size() / 3, lod.error);
+                    chain += level;
+                }
+                log.LogInfo("%-20s : %u LODs in %8.2f ms (%.2f Mtris/s): %s", name, built, ms,
+                            ms > 0.0 ? mesh.indices.size() / 3 / ms / 1000.0 : 0.0, chain.c_str());
+                return built;
+            };
+
+            log.LogEvent("Default options (4 levels, 0.5 reduction, 5% radius error budget)");
+            SMeshCPU_PNT sphere = makeSphere(256, 512, 1.0f);
+            ASSERT(ctx, report("sphere 256x512", sphere) > 0, "Dense sphere gets LODs");
+            SMeshCPU_PNT grid = makeGrid(256);
+            report("grid 256", grid);
+
+            const char* meshes[] = {
+                "mesh/sphere.obj",
+                "mesh/cube.obj",
+            };
+            for (const char* name : meshes) {
+                std::string path = FFPath::GetAbsolutePath(name);
+                SMeshCPU_PNT mesh;
+                if (!std::filesystem::exists(path) || !LoadOBJ_PNT(path, mesh)) {
+                    log.LogInfo("%-20s : missing, skipped", name);
+                    continue;
+                }
+                report(name, mesh);
+            }
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestMeshLod)
@@ -0,0 +1,393 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/MeshOptimizer.h"
+#include "Core/MeshResourceManager.h"
+#include "Core/Loader/ObjLoader.h"
+#include "Core/PathManager.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * Test: import-time mesh optimization (Core/MeshOptimizer.h)
+ *
+ * Frame 1 (CPU only, deterministic):
+ *   - FIFO cache analysis on hand-computed index streams
+ *   - Vertex cache reordering: ACMR improves, triangles and winding preserved,
+ *     identical output on repeated runs, degenerate triangles survive
+ *   - Overdraw clustering: permutation of the input, ACMR stays near the threshold,
+ *     outer shell of nested spheres drawn first
+ *   - Vertex fetch remap: first-use order, unreferenced vertices dropped
+ *   - 16-bit index eligibility, full OptimizeMesh pipeline
+ *
+ * Frame 5 (benchmark):
+ *   - ACMR / ATVR before and after, per stage timings on a large shuffled sphere
+ *   - Same report for a few project meshes
+ *
+ * Usage:
+ *   forfun.exe --test TestMeshOptimizer
+ *   Results: E:/forfun/debug/TestMeshOptimizer/test.log
+ */
+class CTestMeshOptimizer : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestMeshOptimizer";
+    }
+
+    // Fixed LCG so the shuffles (and results) are the same on every platform
+    struct SRandom {
+        uint32_t state;
+        explicit SRandom(uint32_t seed) : state(seed) {}
+        uint32_t Next() {
+            state = state * 1664525u + 1013904223u;
+            return state >> 8;
+        }
+    };
+
+    static void shuffleTriangles(std::vector<uint32_t>& indices, uint32_t seed) {
+        SRandom rng(seed);
+        size_t triangles = indices.size() / 3;
+        for (size_t i = triangles; i > 1; i--) {
+            size_t j = rng.Next() % i;
+            for (int k = 0; k < 3; k++) {
+                std::swap(indices[(i - 1) * 3 + k], indices[j * 3 + k]);
+            }
+        }
+    }
+
+    // Flat grid of (n+1)^2 vertices, two triangles per cell, row-major
+    static SMeshCPU_PNT makeGrid(uint32_t n) {
+        SMeshCPU_PNT mesh;
+        for (uint32_t y = 0; y <= n; y++) {
+            for (uint32_t x = 0; x <= n; x++) {
+                SVertexPNT v = {};
+                v.px = (float)x; v.pz = (float)y;
+                v.ny = 1.0f;
+                mesh.vertices.push_back(v);
+            }
+        }
+        for (uint32_t y = 0; y < n; y++) {
+            for (uint32_t x = 0; x < n; x++) {
+                uint32_t i0 = y * (n + 1) + x, i1 = i0 + 1, i2 = i0 + n + 1, i3 = i2 + 1;
+                mesh.indices.insert(mesh.indices.end(), {i0, i2, i1, i1, i2, i3});
+            }
+        }
+        return mesh;
+    }
+
+    // UV sphere appended to mesh, outward normals
+    static void appendSphere(SMeshCPU_PNT& mesh, uint32_t rings, uint32_t segments, float r) {
+        const float pi = 3.14159265f;
+        uint32_t base = (uint32_t)mesh.vertices.size();
+        for (uint32_t y = 0; y <= rings; y++) {
+            float theta = pi * (float)y / rings;
+            for (uint32_t x = 0; x <= segments; x++) {
+                float phi = 2.0f * pi * (float)x / segments;
+                SVertexPNT v = {};
+                v.nx = std::sin(theta) * std::cos(phi);
+                v.ny = std::cos(theta);
+                v.nz = std::sin(theta) * std::sin(phi);
+                v.px = r * v.nx; v.py = r * v.ny; v.pz = r * v.nz;
+                mesh.vertices.push_back(v);
+            }
+        }
+        for (uint32_t y = 0; y < rings; y++) {
+            for (uint32_t x = 0; x < segments; x++) {
+                uint32_t i0 = base + y * (segments + 1) + x, i1 = i0 + 1;
+                uint32_t i2 = i0 + segments + 1, i3 = i2 + 1;
+                mesh.indices.insert(mesh.indices.end(), {i0, i1, i2, i1, i3, i2});
+            }
+        }
+    }
+
+    // Triangles as rotation-normalized tuples of vertex ids, sorted: equal iff
+    // the two lists hold the same triangles with the same winding
+    static std::vector<std::array<uint32_t, 3>> canonicalTriangles(const std::vector<uint32_t>& indices,
+                                                                  const std::vector<uint32_t>* vertexIds = nullptr) {
+        std::vector<std::array<uint32_t, 3>> tris;
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            std::array<uint32_t, 3> tri;
+            for (int k = 0; k < 3; k++) {
+                tri[k] = vertexIds ? (*vertexIds)[indices[t + k]] : indices[t + k];
+            }
+            int first = (int)(std::min_element(tri.begin(), tri.end()) - tri.begin());
+            std::rotate(tri.begin(), tri.begin() + first, tri.end());
+            tris.push_back(tri);
+        }
+        std::sort(tris.begin(), tris.end());
+        return tris;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("TestMeshOptimizer: CPU tests");
+
+            // --- FIFO analysis ---
+            {
+                std::vector<uint32_t> tri = {0, 1, 2};
+                SVertexCacheStats s = AnalyzeVertexCache(tri.data(), tri.size(), 3);
+                ASSERT_EQUAL(ctx, (int)s.misses, 3, "Single triangle: 3 misses");
+                ASSERT_EQUAL_F(ctx, s.acmr, 3.0f, 1e-6f, "Single triangle: ACMR 3");
+                ASSERT_EQUAL_F(ctx, s.atvr, 1.0f, 1e-6f, "Single triangle: ATVR 1");
+
+                std::vector<uint32_t> quad = {0, 1, 2, 2, 1, 3};
+                s = AnalyzeVertexCache(quad.data(), quad.size(), 4);
+                ASSERT_EQUAL(ctx, (int)s.misses, 4, "Quad: shared edge hits");
+                ASSERT_EQUAL_F(ctx, s.acmr, 2.0f, 1e-6f, "Quad: ACMR 2");
+
+                // FIFO (not LRU): the hit on 0 does not keep it resident, 8 misses (LRU would give 7)
+                std::vector<uint32_t> fifo = {0, 1, 2, 0, 3, 4, 0, 1, 2};
+                s = AnalyzeVertexCache(fifo.data(), fifo.size(), 5, 4);
+                ASSERT_EQUAL(ctx, (int)s.misses, 8, "FIFO eviction order");
+                ASSERT_EQUAL(ctx, (int)s.vertices, 5, "Referenced vertex count");
+
+                // Unreferenced vertices do not count against ATVR
+                s = AnalyzeVertexCache(tri.data(), tri.size(), 100);
+                ASSERT_EQUAL_F(ctx, s.atvr, 1.0f, 1e-6f, "ATVR over referenced vertices only");
+
+                s = AnalyzeVertexCache(nullptr, 0, 0);
+                ASSERT_EQUAL(ctx, (int)s.misses, 0, "Empty mesh");
+            }
+
+            // --- Vertex cache ---
+            {
+                SMeshCPU_PNT grid = makeGrid(64);
+                shuffleTriangles(grid.indices, 1234);
+                uint32_t vertexCount = (uint32_t)grid.vertices.size();
+                SVertexCacheStats before = AnalyzeVertexCache(grid.indices.data(), grid.indices.size(), vertexCount);
+
+                std::vector<uint32_t> optimized = grid.indices;
+                OptimizeVertexCache(optimized.data(), optimized.size(), vertexCount);
+                SVertexCacheStats after = AnalyzeVertexCache(optimized.data(), optimized.size(), vertexCount);
+                CFFLog::Info("  Shuffled grid ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+                             before.acmr, after.acmr, before.atvr, after.atvr);
+
+                ASSERT(ctx, before.acmr > 2.0f, "Shuffled grid starts near the worst case");
+                ASSERT(ctx, after.acmr < 0.8f, "Optimized grid ACMR below 0.8");
+                ASSERT(ctx, after.atvr < 1.5f, "Optimized grid ATVR below 1.5");
+                ASSERT(ctx, canonicalTriangles(optimized) == canonicalTriangles(grid.indices),
+                       "Same triangles, same winding");
+
+                std::vector<uint32_t> again = grid.indices;
+                OptimizeVertexCache(again.data(), again.size(), vertexCount);
+                ASSERT(ctx, again == optimized, "Deterministic output");
+
+                // Already-optimized input does not get worse
+                std::vector<uint32_t> twice = optimized;
+                OptimizeVertexCache(twice.data(), twice.size(), vertexCount);
+                SVertexCacheStats second = AnalyzeVertexCache(twice.data(), twice.size(), vertexCount);
+                ASSERT(ctx, second.acmr <= after.acmr * 1.02f, "Re-optimizing is stable");
+
+                // Degenerate and duplicate triangles are kept
+                std::vector<uint32_t> odd = {0, 0, 1, 2, 3, 4, 0, 0, 1, 5, 5, 5};
+                std::vector<uint32_t> oddOptimized = odd;
+                OptimizeVertexCache(oddOptimized.data(), oddOptimized.size(), 6);
+                ASSERT(ctx, canonicalTriangles(oddOptimized) == canonicalTriangles(odd),
+                       "Degenerate / duplicate triangles preserved");
+            }
+
+            // --- Overdraw ---
+            {
+                // Inner sphere first in the input: the worst order for overdraw
+                SMeshCPU_PNT nested;
+                appendSphere(nested, 24, 48, 1.0f);
+                uint32_t innerVertices = (uint32_t)nested.vertices.size();
+                appendSphere(nested, 24, 48, 2.0f);
+                uint32_t vertexCount = (uint32_t)nested.vertices.size();
+
+                OptimizeVertexCache(nested.indices.data(), nested.indices.size(), vertexCount);
+                std::vector<uint32_t> cacheOnly = nested.indices;
+                SVertexCacheStats before = AnalyzeVertexCache(cacheOnly.data(), cacheOnly.size(), vertexCount);
+
+                const float threshold = 1.05f;
+                OptimizeOverdraw(nested.indices.data(), nested.indices.size(), nested.vertices.data(), vertexCount, threshold);
+                SVertexCacheStats after = AnalyzeVertexCache(nested.indices.data(), nested.indices.size(), vertexCount);
+                CFFLog::Info("  Nested spheres ACMR %.3f -> %.3f after overdraw pass", before.acmr, after.acmr);
+
+                ASSERT(ctx, canonicalTriangles(nested.indices) == canonicalTriangles(cacheOnly),
+                       "Overdraw pass is a permutation of triangles");
+                // The cluster model is a window cache, the report a FIFO: allow a little slack
+                ASSERT(ctx, after.acmr <= before.acmr * threshold * 1.1f, "ACMR stays near the threshold");
+
+                // Outer shell first: its triangles sit in the first half of the list on average
+                double outerRank = 0.0, innerRank = 0.0;
+                size_t outerCount = 0, innerCount = 0;
+                for (size_t t = 0; t < nested.indices.size() / 3; t++) {
+                    if (nested.indices[t * 3] >= innerVertices) { outerRank += (double)t; outerCount++; }
+                    else { innerRank += (double)t; innerCount++; }
+                }
+                ASSERT(ctx, nested.indices[0] >= innerVertices, "First cluster is on the outer sphere");
+                ASSERT(ctx, outerRank / outerCount < innerRank / innerCount, "Outer sphere drawn before inner sphere");
+
+                std::vector<uint32_t> again = cacheOnly;
+                OptimizeOverdraw(again.data(), again.size(), nested.vertices.data(), vertexCount, threshold);
+                ASSERT(ctx, again == nested.indices, "Overdraw pass deterministic");
+
+                // Threshold 1 never trades cache efficiency for order
+                std::vector<uint32_t> strict = cacheOnly;
+                OptimizeOverdraw(strict.data(), strict.size(), nested.vertices.data(), vertexCount, 1.0f);
+                SVertexCacheStats strictStats = AnalyzeVertexCache(strict.data(), strict.size(), vertexCount);
+                ASSERT(ctx, strictStats.acmr <= after.acmr + 1e-4f, "Lower threshold keeps ACMR lower");
+            }
+
+            // --- Vertex fetch ---
+            {
+                SMeshCPU_PNT mesh;
+                for (uint32_t i = 0; i < 6; i++) {
+                    SVertexPNT v = {};
+                    v.px = (float)i;    // Identifies the original vertex
+                    mesh.vertices.push_back(v);
+                }
+                mesh.indices = {4, 2, 0, 0, 2, 5};     // 1 and 3 unused
+
+                std::vector<uint32_t> remap;
+                uint32_t used = BuildVertexFetchRemap(mesh.indices.data(), mesh.indices.size(), 6, remap);
+                ASSERT_EQUAL(ctx, (int)used, 4, "Four referenced vertices");
+                ASSERT_EQUAL(ctx, (int)remap[4], 0, "First use gets slot 0");
+                ASSERT_EQUAL(ctx, (int)remap[2], 1, "Second use gets slot 1");
+                ASSERT_EQUAL(ctx, (int)remap[5], 3, "Last new vertex gets slot 3");
+                ASSERT(ctx, remap[1] == kUnusedVertex && remap[3] == kUnusedVertex, "Unused vertices flagged");
+
+                std::vector<float> originalPositions;
+                for (uint32_t index : mesh.indices) originalPositions.push_back(mesh.vertices[index].px);
+
+                uint32_t count = OptimizeVertexFetch(mesh);
+                ASSERT_EQUAL(ctx, (int)count, 4, "Vertex fetch returns the used count");
+                ASSERT_EQUAL(ctx, (int)mesh.vertices.size(), 4, "Unused vertices dropped");
+                std::vector<uint32_t> expected = {0, 1, 2, 2, 1, 3};
+                ASSERT(ctx, mesh.indices == expected, "Indices in first-use order");
+
+                bool same = true;
+                for (size_t i = 0; i < mesh.indices.size(); i++) {
+                    same = same && mesh.vertices[mesh.indices[i]].px == originalPositions[i];
+                }
+                ASSERT(ctx, same, "Every corner still references the same vertex data");
+            }
+
+            // --- 16-bit indices ---
+            ASSERT(ctx, CanUse16BitIndices(0), "Empty mesh fits 16-bit");
+            ASSERT(ctx, CanUse16BitIndices(65535), "65535 vertices fit 16-bit (max index 65534)");
+            ASSERT(ctx, !CanUse16BitIndices(65536), "65536 vertices would need index 0xFFFF");
+
+            // --- Full pipeline ---
+            {
+                SMeshCPU_PNT grid = makeGrid(96);
+                shuffleTriangles(grid.indices, 99);
+                SVertexPNT unused = {};
+                grid.vertices.push_back(unused);
+                grid.indices.push_back(0);      // Stray index that does not form a triangle
+                auto reference = canonicalTriangles(std::vector<uint32_t>(grid.indices.begin(), grid.indices.end() - 1));
+
+                // Remember the original id of each vertex through its position
+                std::vector<uint32_t> ids;
+                SMeshOptimizeOptions options;
+                options.overdraw = true;
+                SMeshOptimizeReport r = OptimizeMesh(grid, options);
+                for (const auto& v : grid.vertices) ids.push_back((uint32_t)v.pz * 97 + (uint32_t)v.px);
+
+                ASSERT_EQUAL(ctx, (int)r.verticesBefore, 97 * 97 + 1, "Report: vertices before");
+                ASSERT_EQUAL(ctx, (int)r.verticesAfter, 97 * 97, "Report: unused vertex dropped");
+                ASSERT_EQUAL(ctx, (int)grid.indices.size(), 96 * 96 * 6, "Stray index trimmed");
+                ASSERT(ctx, r.after.acmr < r.before.acmr * 0.4f, "Pipeline ACMR improvement");
+                ASSERT_EQUAL_F(ctx, r.after.atvr * r.after.vertices, r.after.acmr * r.after.triangles, 1e-2f,
+                               "ACMR and ATVR count the same misses");
+                ASSERT(ctx, canonicalTriangles(grid.indices, &ids) == reference, "Pipeline keeps the surface");
+                ASSERT(ctx, CanUse16BitIndices(r.verticesAfter), "Result is 16-bit eligible");
+            }
+
+            CFFLog::Info("TestMeshOptimizer: CPU tests done");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Mesh Optimizer");
+
+            auto msSince = [](std::chrono::high_resolution_clock::time_point start) {
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+            auto logStats = [&log](const char* label, const std::vector<uint32_t>& indices, uint32_t vertexCount) {
+                SVertexCacheStats s16 = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount, 16);
+                SVertexCacheStats s32 = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount, 32);
+                log.LogInfo("%-24s : ACMR %.3f / %.3f   ATVR %.3f / %.3f  (FIFO 16 / 32)",
+                            label, s16.acmr, s32.acmr, s16.atvr, s32.atvr);
+                return s16;
+            };
+
+            // Large sphere, triangles shuffled: worst-case input
+            SMeshCPU_PNT sphere;
+            appendSphere(sphere, 256, 512, 1.0f);
+            shuffleTriangles(sphere.indices, 7);
+            uint32_t vertexCount = (uint32_t)sphere.vertices.size();
+            size_t triangles = sphere.indices.size() / 3;
+
+            log.LogEvent("Shuffled sphere");
+            log.LogInfo("Triangles / vertices     : %zu / %u", triangles, vertexCount);
+            SVertexCacheStats before = logStats("Input", sphere.indices, vertexCount);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            OptimizeVertexCache(sphere.indices.data(), sphere.indices.size(), vertexCount);
+            double cacheMs = msSince(start);
+            SVertexCacheStats afterCache = logStats("Vertex cache", sphere.indices, vertexCount);
+
+            start = std::chrono::high_resolution_clock::now();
+            OptimizeOverdraw(sphere.indices.data(), sphere.indices.size(), sphere.vertices.data(), vertexCount, 1.05f);
+            double overdrawMs = msSince(start);
+            logStats("+ Overdraw (1.05)", sphere.indices, vertexCount);
+
+            start = std::chrono::high_resolution_clock::now();
+            OptimizeVertexFetch(sphere);
+            double fetchMs = msSince(start);
+            logStats("+ Vertex fetch", sphere.indices, vertexCount);
+
+            log.LogInfo("Vertex cache             : %8.2f ms  (%.2f Mtris/s)", cacheMs, cacheMs > 0.0 ? triangles / cacheMs / 1000.0 : 0.0);
+            log.LogInfo("Overdraw                 : %8.2f ms", overdrawMs);
+            log.LogInfo("Vertex fetch             : %8.2f ms", fetchMs);
+            log.LogInfo("Index buffer             : %s", CanUse16BitIndices(vertexCount) ? "16-bit" : "32-bit");
+            ASSERT(ctx, afterCache.acmr < before.acmr * 0.3f, "Large mesh ACMR improvement");
+
+            // Project meshes, as the importer sees them
+            const char* meshes[] = {
+                "mesh/cube.obj",
+                "mesh/sphere.obj",
+            };
+            log.LogEvent("Project meshes (FIFO 16)");
+            for (const char* name : meshes) {
+                std::string path = FFPath::GetAbsolutePath(name);
+                SMeshCPU_PNT mesh;
+                if (!std::filesystem::exists(path) || !LoadOBJ_PNT(path, mesh)) {
+                    log.LogInfo("%-24s : missing, skipped", name);
+                    continue;
+                }
+                SMeshOptimizeReport r = OptimizeMesh(mesh);
+                log.LogInfo("%-24s : ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %u tris, %.2f ms, %s indices",
+                            name, r.before.acmr, r.after.acmr, r.before.atvr, r.after.atvr,
+                            r.after.triangles, r.ms, CanUse16BitIndices(r.verticesAfter) ? "16-bit" : "32-bit");
+                ASSERT(ctx, r.after.acmr <= r.before.acmr * 1.02f, "Optimization never makes a real mesh worse");
+            }
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestMeshOptimizer)
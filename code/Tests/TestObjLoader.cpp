@@ -0,0 +1,309 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/Loader/ObjLoader.h"
+#include "Core/Jobs/JobSystem.h"
+#include <DirectXMath.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Test: streaming OBJ parser (LoadOBJ_PNT / ParseOBJ_PNT)
+ *
+ * The previous istringstream-based parser is kept below as the reference;
+ * the new parser must produce byte-identical SMeshCPU_PNT output.
+ *
+ * Frame 1 (correctness):
+ *   - Triangles, quads, n-gons, v / v/vt / v//vn / v/vt/vn corners
+ *   - Negative (relative) indices, comments, blank lines, CRLF, tabs
+ *   - Missing normals (generated), flipZ / flipWinding off
+ *   - Multi-chunk parse (file above OBJ_PARALLEL_MIN_BYTES, relative indices
+ *     crossing chunk boundaries) equals single-chunk and reference output
+ *   - Malformed input is rejected
+ *
+ * Frame 5 (benchmark): large generated grid, reference vs streaming
+ * (single chunk / parallel), reported in MB/s.
+ *
+ * Usage:
+ *   forfun.exe --test TestObjLoader
+ *   Results: E:/forfun/debug/TestObjLoader/test.log
+ */
+class CTestObjLoader : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestObjLoader";
+    }
+
+    // ============================================
+    // Reference: previous LoadOBJ_PNT, unchanged apart from reading from a stream
+    // ============================================
+    struct VIdx { int v=-1, vt=-1, vn=-1; };
+    static inline VIdx parseVIdx(const std::string& s) {
+        VIdx idx{}; std::string buf; int slot=0; int vals[3]={-1,-1,-1};
+        for (char c: s){ if (c=='/'){ vals[slot++]=buf.empty()? -1:std::stoi(buf); buf.clear(); } else buf.push_back(c); }
+        vals[slot++]=buf.empty()? -1:std::stoi(buf);
+        idx.v=vals[0]; idx.vt=vals[1]; idx.vn=vals[2]; return idx;
+    }
+    static inline void trim(std::string& s){ size_t a=0; while (a<s.size() && isspace((unsigned char)s[a])) ++a; size_t b=s.size(); while (b>a && isspace((unsigned char)s[b-1])) --b; s=s.substr(a,b-a); }
+    static inline int fix(int idx, int n){ return idx>0? idx-1 : (idx<0? n+idx : -1); }
+
+    static bool referenceParseOBJ(std::istream& in, SMeshCPU_PNT& out, bool flipZ, bool flipWinding)
+    {
+        std::vector<float> P; std::vector<float> N; std::vector<float> T;
+
+        struct Key{ int v,vt,vn; bool operator==(const Key&o)const{return v==o.v&&vt==o.vt&&vn==o.vn;} };
+        struct KH{ size_t operator()(const Key&k)const{ return (std::hash<int>()(k.v)*73856093)^(std::hash<int>()(k.vt)*19349663)^(std::hash<int>()(k.vn)*83492791); } };
+        std::unordered_map<Key, uint32_t, KH> map;
+
+        out.vertices.clear(); out.indices.clear();
+        std::string line;
+        while (std::getline(in,line)){
+            trim(line); if (line.empty()||line[0]=='#') continue;
+            std::istringstream iss(line); std::string tag; iss>>tag;
+            if (tag=="v"){ float x,y,z; iss>>x>>y>>z; if (flipZ) z=-z; P.insert(P.end(),{x,y,z}); }
+            else if (tag=="vn"){ float x,y,z; iss>>x>>y>>z; if (flipZ) z=-z; N.insert(N.end(),{x,y,z}); }
+            else if (tag=="vt"){ float u,v; iss>>u>>v; T.insert(T.end(),{u,v}); }
+            else if (tag=="f"){
+                std::vector<VIdx> face; std::string s; while (iss>>s) face.push_back(parseVIdx(s));
+                if (face.size()<3) continue;
+                for (size_t k=1;k+1<face.size();++k){
+                    VIdx tri[3] = { face[0], face[k], face[k+1] };
+                    for (int t=0;t<3;++t){
+                        int nv=(int)P.size()/3, nn=(int)N.size()/3, nt=(int)T.size()/2;
+                        int iv=fix(tri[t].v,nv), it=fix(tri[t].vt,nt), in=fix(tri[t].vn,nn);
+                        Key key{iv,it,in}; auto itK=map.find(key); uint32_t oi;
+                        if (itK==map.end()){
+                            SVertexPNT v{};
+                            v.px=P[iv*3+0]; v.py=P[iv*3+1]; v.pz=P[iv*3+2];
+                            if (in>=0){ v.nx=N[in*3+0]; v.ny=N[in*3+1]; v.nz=N[in*3+2]; }
+                            else { v.nx=0; v.ny=1; v.nz=0; }
+                            if (it>=0){ v.u=T[it*2+0]; v.v=T[it*2+1]; } else { v.u=0; v.v=0; }
+                            v.tx=v.ty=v.tz=0; v.tw=1;
+                            v.r=v.g=v.b=v.a=1.0f;
+                            v.u2=0.0f; v.v2=0.0f;
+                            oi=(uint32_t)out.vertices.size(); out.vertices.push_back(v); map.emplace(key,oi);
+                        } else oi=itK->second;
+                        out.indices.push_back(oi);
+                    }
+                    if (flipWinding) std::swap(out.indices[out.indices.size()-3], out.indices[out.indices.size()-2]);
+                }
+            }
+        }
+        if (N.empty()){
+            std::vector<DirectX::XMFLOAT3> acc(out.vertices.size(),{0,0,0});
+            for (size_t i=0;i+2<out.indices.size();i+=3){
+                auto i0=out.indices[i], i1=out.indices[i+1], i2=out.indices[i+2];
+                using namespace DirectX;
+                XMVECTOR p0=XMLoadFloat3((XMFLOAT3*)&out.vertices[i0].px);
+                XMVECTOR p1=XMLoadFloat3((XMFLOAT3*)&out.vertices[i1].px);
+                XMVECTOR p2=XMLoadFloat3((XMFLOAT3*)&out.vertices[i2].px);
+                XMVECTOR n=XMVector3Normalize(XMVector3Cross(p1-p0,p2-p0));
+                DirectX::XMFLOAT3 nn; XMStoreFloat3(&nn,n);
+                auto add=[&](uint32_t ii){ acc[ii].x+=nn.x; acc[ii].y+=nn.y; acc[ii].z+=nn.z; };
+                add(i0); add(i1); add(i2);
+            }
+            for (size_t i=0;i<out.vertices.size();++i){
+                using namespace DirectX;
+                XMVECTOR n=XMVector3Normalize(XMLoadFloat3(&acc[i]));
+                DirectX::XMFLOAT3 nn; XMStoreFloat3(&nn,n);
+                out.vertices[i].nx=nn.x; out.vertices[i].ny=nn.y; out.vertices[i].nz=nn.z;
+            }
+        }
+        ComputeTangents(out.vertices, out.indices);
+        return !out.vertices.empty() && !out.indices.empty();
+    }
+
+    // ============================================
+    // Helpers
+    // ============================================
+    static bool sameMesh(const SMeshCPU_PNT& a, const SMeshCPU_PNT& b) {
+        return a.vertices.size() == b.vertices.size() && a.indices == b.indices &&
+               memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(SVertexPNT)) == 0;
+    }
+
+    static bool matchesReference(const std::string& text, bool flipZ = true, bool flipWinding = true) {
+        std::istringstream in(text);
+        SMeshCPU_PNT expected, actual;
+        bool refOk = referenceParseOBJ(in, expected, flipZ, flipWinding);
+        bool ok = ParseOBJ_PNT(text.data(), text.size(), actual, flipZ, flipWinding);
+        return refOk == ok && sameMesh(expected, actual);
+    }
+
+    // Grid of n x n quads with slightly noisy positions.
+    // relative: rows of vertices interleaved with their faces, faces use negative indices
+    static std::string makeGridObj(int n, bool normals, bool relative) {
+        std::string text = "# generated grid\nmtllib none.mtl\no grid\n";
+        char line[256];
+        uint32_t seed = 12345;
+        auto noise = [&seed]() { seed = seed * 1664525u + 1013904223u; return (float)(seed >> 8) / 16777216.0f - 0.5f; };
+        auto writeRow = [&](int z) {
+            for (int x = 0; x <= n; x++) {
+                snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", x * 0.01f, 0.02f * noise(), z * 0.01f);
+                text += line;
+                snprintf(line, sizeof(line), "vt %.5f %.5f\n", (float)x / n, (float)z / n);
+                text += line;
+                if (normals) {
+                    snprintf(line, sizeof(line), "vn %g %g %g\n", 0.1f * noise(), 1.0f, 0.1f * noise());
+                    text += line;
+                }
+            }
+        };
+        auto writeFaces = [&](int z, int rowsWritten) {
+            int stride = n + 1;
+            int count = rowsWritten * stride;
+            for (int x = 0; x < n; x++) {
+                int i[4] = { z * stride + x + 1, z * stride + x + 2, (z + 1) * stride + x + 2, (z + 1) * stride + x + 1 };
+                if (relative) for (int& k : i) k -= count + 1;
+                if (normals) snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n",
+                                      i[0], i[0], i[0], i[1], i[1], i[1], i[2], i[2], i[2], i[3], i[3], i[3]);
+                else snprintf(line, sizeof(line), "f %d/%d %d/%d %d/%d %d/%d\n", i[0], i[0], i[1], i[1], i[2], i[2], i[3], i[3]);
+                text += line;
+            }
+        };
+
+        if (relative) {
+            writeRow(0);
+            for (int z = 0; z < n; z++) {
+                writeRow(z + 1);
+                writeFaces(z, z + 2);
+            }
+        } else {
+            for (int z = 0; z <= n; z++) writeRow(z);
+            text += "g faces\ns 1\nusemtl none\n";
+            for (int z = 0; z < n; z++) writeFaces(z, n + 1);
+        }
+        return text;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestObjLoader ===");
+            CFFLog::Info("Frame 1: output identical to the reference parser");
+
+            const std::string cube =
+                "# cube\n"
+                "v -1 -1 1\nv 1 -1 1\nv 1 1 1\nv -1 1 1\nv -1 -1 -1\nv 1 -1 -1\nv 1 1 -1\nv -1 1 -1\n"
+                "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+                "vn 0 0 1\nvn 0 0 -1\nvn 1 0 0\nvn -1 0 0\nvn 0 1 0\nvn 0 -1 0\n"
+                "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+                "f 6/1/2 5/2/2 8/3/2 7/4/2\n"
+                "f 2/1/3 6/2/3 7/3/3 3/4/3\n"
+                "f 5/1/4 1/2/4 4/3/4 8/4/4\n"
+                "f 4/1/5 3/2/5 7/3/5 8/4/5\n"
+                "f 5/1/6 6/2/6 2/3/6 1/4/6\n";
+            ASSERT(ctx, matchesReference(cube), "Quads with v/vt/vn");
+            ASSERT(ctx, matchesReference(cube, false, false), "flipZ / flipWinding off");
+
+            ASSERT(ctx, matchesReference("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0.5 1.5 0\nf 1 2 3 5 4\n"),
+                   "Pentagon, positions only (generated normals)");
+            ASSERT(ctx, matchesReference("v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nf 1//1 2//1 3//1\n"), "v//vn corners");
+            ASSERT(ctx, matchesReference("v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nvt 1 0\nf 1/1 2/2 3/1\n"), "v/vt corners");
+            ASSERT(ctx, matchesReference("v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nvn 0 0 1\nf -3/-1/-1 -2/-1/-1 -1/-1/-1\n"
+                                         "v 1 1 0\nf -4/1/1 -2/1/1 -1/1/1\n"),
+                   "Negative indices");
+            ASSERT(ctx, matchesReference("\r\n  # comment\r\nv\t+1.5e0  -2.25E-1 3.\r\n\r\nv .5 0 0 1.0\r\n"
+                                         "v 0 1 0\r\nvp 0.5\r\n  f 1 2 3  \r\nf 1 2\r\nl 1 2\r\n"),
+                   "CRLF, tabs, blank lines, exponents, ignored tags");
+            ASSERT(ctx, matchesReference("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3"), "No trailing newline");
+
+            // Multi-chunk: above the parallel threshold, relative indices crossing chunk boundaries
+            {
+                std::string big = makeGridObj(330, false, true);
+                SMeshCPU_PNT single, chunked, expected;
+                std::istringstream in(big);
+                referenceParseOBJ(in, expected, true, true);
+                ParseOBJ_PNT(big.data(), big.size(), single, true, true, false);
+                bool ok = ParseOBJ_PNT(big.data(), big.size(), chunked, true, true, true);
+                CFFLog::Info("Chunked input: %.1f MB, %zu vertices, %zu indices (%u threads)", big.size() / (1024.0 * 1024.0),
+                             chunked.vertices.size(), chunked.indices.size(), CJobSystem::Instance().GetThreadCount());
+                ASSERT(ctx, big.size() >= OBJ_PARALLEL_MIN_BYTES, "Chunked input is above the parallel threshold");
+                ASSERT(ctx, ok, "Chunked parse succeeds");
+                ASSERT(ctx, sameMesh(single, expected), "Single chunk equals reference");
+                ASSERT(ctx, sameMesh(chunked, expected), "Multi-chunk equals reference");
+            }
+
+            // Malformed input
+            SMeshCPU_PNT mesh;
+            const char* bad[] = {
+                "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n",         // Index past the end
+                "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 x\n",         // Not a number
+                "v 0 0 0\nv 1 0 0\nv 0 1 0\nf -4 2 3\n",        // Relative index before the first vertex
+                "v 0 0 0\nv 1 0 0\nv 0 1 0\n",                  // No faces
+                "",
+            };
+            for (const char* text : bad) {
+                ASSERT(ctx, !ParseOBJ_PNT(text, strlen(text), mesh), "Malformed input rejected");
+            }
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "OBJ Parser");
+
+            // ~2 M triangles, v/vt/vn
+            std::filesystem::path path = std::filesystem::temp_directory_path() / "forfun_test_objloader.obj";
+            std::string text = makeGridObj(1000, true, false);
+            {
+                std::ofstream file(path, std::ios::binary | std::ios::trunc);
+                file.write(text.data(), (std::streamsize)text.size());
+            }
+            double megabytes = text.size() / (1024.0 * 1024.0);
+            std::string().swap(text);
+
+            auto timeIt = [](auto&& func) {
+                auto start = std::chrono::high_resolution_clock::now();
+                func();
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+
+            SMeshCPU_PNT reference, single, parallel;
+            double referenceMs = timeIt([&]() {
+                std::ifstream in(path);
+                referenceParseOBJ(in, reference, true, true);
+            });
+            double singleMs = timeIt([&]() { LoadOBJ_PNT(path.string(), single, true, true, false); });
+            double parallelMs = timeIt([&]() { LoadOBJ_PNT(path.string(), parallel, true, true, true); });
+
+            log.LogEvent("OBJ parse throughput");
+            log.LogInfo("File: %.1f MB, %zu vertices, %zu triangles", megabytes, reference.vertices.size(), reference.indices.size() / 3);
+            log.LogInfo("Reference (istringstream) : %8.1f ms | %7.1f MB/s", referenceMs, megabytes / (referenceMs / 1000.0));
+            log.LogInfo("Streaming, single chunk   : %8.1f ms | %7.1f MB/s | %5.1fx", singleMs,
+                        megabytes / (singleMs / 1000.0), referenceMs / singleMs);
+            log.LogInfo("Streaming, parallel (%2u)  : %8.1f ms | %7.1f MB/s | %5.1fx", CJobSystem::Instance().GetThreadCount(),
+                        parallelMs, megabytes / (parallelMs / 1000.0), referenceMs / parallelMs);
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+
+            ASSERT(ctx, sameMesh(single, reference), "Benchmark: single chunk equals reference");
+            ASSERT(ctx, sameMesh(parallel, reference), "Benchmark: parallel equals reference");
+            ASSERT(ctx, singleMs < referenceMs, "Streaming parser is faster than the reference");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestObjLoader)
@@ -0,0 +1,291 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/PackedVertex.h"
+#include "Core/MeshResourceManager.h"
+#include "Core/PathManager.h"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * Test: packed vertex layout
+ *
+ * Frame 1 (CPU only):
+ *   - Octahedral encode/decode: axes, lower hemisphere, zero vector, random directions
+ *   - Pack/unpack round trip of every SVertexPNT field
+ *   - Error metrics on well-behaved and problematic meshes (half overflow,
+ *     far-from-origin detail, tiling UVs, HDR colors)
+ *   - Per-mesh layout selection for each CMeshResourceManager mode
+ *
+ * Frame 5 (benchmark):
+ *   - Vertex memory full vs packed, pack throughput, measured error
+ *   - Loads a few meshes with EVertexLayoutMode::Auto and logs the chosen layouts
+ *
+ * Usage:
+ *   forfun.exe --test TestPackedVertex
+ *   Results: E:/forfun/debug/TestPackedVertex/test.log
+ */
+class CTestPackedVertex : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestPackedVertex";
+    }
+
+    // atan2 form: acos(dot) bottoms out around 0.02 degrees in float
+    static float angleBetween(float ax, float ay, float az, float bx, float by, float bz) {
+        float cx = ay * bz - az * by, cy = az * bx - ax * bz, cz = ax * by - ay * bx;
+        float cross = std::sqrt(cx * cx + cy * cy + cz * cz);
+        return std::atan2(cross, ax * bx + ay * by + az * bz) * 57.2957795f;
+    }
+
+    // UV sphere of radius r around center, with tangents, colors and UV2 in [0,1]
+    static std::vector<SVertexPNT> makeSphere(uint32_t rings, uint32_t segments, float r, float cx = 0.0f) {
+        const float pi = 3.14159265f;
+        std::vector<SVertexPNT> vertices;
+        for (uint32_t y = 0; y <= rings; y++) {
+            float theta = pi * (float)y / rings;
+            for (uint32_t x = 0; x <= segments; x++) {
+                float phi = 2.0f * pi * (float)x / segments;
+                SVertexPNT v = {};
+                v.nx = std::sin(theta) * std::cos(phi);
+                v.ny = std::cos(theta);
+                v.nz = std::sin(theta) * std::sin(phi);
+                v.px = cx + r * v.nx; v.py = r * v.ny; v.pz = r * v.nz;
+                v.tx = -std::sin(phi); v.ty = 0.0f; v.tz = std::cos(phi);
+                v.tw = (x & 1) ? 1.0f : -1.0f;
+                v.u = (float)x / segments; v.v = (float)y / rings;
+                v.r = v.u; v.g = v.v; v.b = 0.5f; v.a = 1.0f;
+                v.u2 = v.u * 0.25f + 0.5f; v.v2 = v.v * 0.25f;
+                vertices.push_back(v);
+            }
+        }
+        return vertices;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestPackedVertex ===");
+            CFFLog::Info("Frame 1: encode / decode / error metrics");
+
+            ASSERT_EQUAL(ctx, (int)(sizeof(SPackedPosition) + sizeof(SPackedAttributes)), 28, "Packed vertex is 28 bytes");
+
+            // Octahedral: axes and lower hemisphere map back exactly (up to snorm16)
+            const float dirs[][3] = {
+                {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1},
+                {0.577f, 0.577f, -0.577f}, {-0.3f, 0.2f, -0.93f}, {0.7071f, 0.0f, -0.7071f}, {0.0f, -0.01f, -1.0f},
+            };
+            for (const auto& d : dirs) {
+                float u, v, x, y, z;
+                OctEncode(d[0], d[1], d[2], u, v);
+                ASSERT(ctx, u >= -1.0f && u <= 1.0f && v >= -1.0f && v <= 1.0f, "Oct coordinates in [-1,1]");
+                OctDecode(u, v, x, y, z);
+                ASSERT(ctx, angleBetween(d[0], d[1], d[2], x, y, z) < 1e-3f, "Oct round trip (float)");
+            }
+
+            // Zero vector: defined result, no NaN
+            {
+                float u, v, x, y, z;
+                OctEncode(0.0f, 0.0f, 0.0f, u, v);
+                OctDecode(u, v, x, y, z);
+                ASSERT(ctx, std::isfinite(x) && std::isfinite(y) && std::isfinite(z), "Zero vector decodes finite");
+                ASSERT_EQUAL_F(ctx, z, 1.0f, 1e-6f, "Zero vector decodes to +Z");
+            }
+
+            // Quantized round trip over many directions
+            float worstDegrees = 0.0f;
+            uint32_t seed = 12345;
+            auto rnd = [&seed]() {
+                seed = seed * 1664525u + 1013904223u;
+                return (float)(seed >> 8) / (float)(1u << 24) * 2.0f - 1.0f;
+            };
+            for (int i = 0; i < 20000; i++) {
+                SVertexPNT v = {};
+                v.nx = rnd(); v.ny = rnd(); v.nz = rnd();
+                if (v.nx * v.nx + v.ny * v.ny + v.nz * v.nz < 1e-4f) continue;
+                SVertexPNT r = UnpackVertex(PackPosition(v), PackAttributes(v));
+                float a = angleBetween(v.nx, v.ny, v.nz, r.nx, r.ny, r.nz);
+                worstDegrees = a > worstDegrees ? a : worstDegrees;
+            }
+            CFFLog::Info("Worst octahedral snorm16 error: %.5f deg", worstDegrees);
+            ASSERT(ctx, worstDegrees < 0.02f, "Octahedral snorm16 error below 0.02 degrees");
+
+            // Every field of a single vertex
+            {
+                SVertexPNT v = {};
+                v.px = 1.25f; v.py = -0.5f; v.pz = 3.0f;
+                v.nx = 0.0f; v.ny = 0.0f; v.nz = -1.0f;
+                v.tx = 1.0f; v.ty = 0.0f; v.tz = 0.0f; v.tw = -1.0f;
+                v.u = 0.75f; v.v = 0.125f;
+                v.r = 1.0f; v.g = 0.5f; v.b = 0.0f; v.a = 0.25f;
+                v.u2 = 0.3f; v.v2 = 0.9f;
+                SVertexPNT r = UnpackVertex(PackPosition(v), PackAttributes(v));
+                ASSERT_EQUAL_F(ctx, r.px, 1.25f, 1e-6f, "Position x (exact in half)");
+                ASSERT_EQUAL_F(ctx, r.py, -0.5f, 1e-6f, "Position y (exact in half)");
+                ASSERT_EQUAL_F(ctx, r.pz, 3.0f, 1e-6f, "Position z (exact in half)");
+                ASSERT_EQUAL_F(ctx, r.nz, -1.0f, 1e-4f, "Normal -Z");
+                ASSERT_EQUAL_F(ctx, r.tx, 1.0f, 1e-4f, "Tangent +X");
+                ASSERT_EQUAL_F(ctx, r.tw, -1.0f, 0.0f, "Tangent handedness");
+                ASSERT_EQUAL_F(ctx, r.u, 0.75f, 1e-6f, "UV u");
+                ASSERT_EQUAL_F(ctx, r.v, 0.125f, 1e-6f, "UV v");
+                ASSERT_EQUAL_F(ctx, r.g, 0.5f, 0.51f / 255.0f, "Color g (unorm8)");
+                ASSERT_EQUAL_F(ctx, r.a, 0.25f, 0.51f / 255.0f, "Color a (unorm8)");
+                ASSERT_EQUAL_F(ctx, r.u2, 0.3f, 0.51f / 65535.0f, "UV2 u (unorm16)");
+                ASSERT_EQUAL_F(ctx, r.v2, 0.9f, 0.51f / 65535.0f, "UV2 v (unorm16)");
+            }
+
+            // Error metrics and selection
+            SVertexPackingTolerance tolerance;
+            using Mode = CMeshResourceManager::EVertexLayoutMode;
+            auto select = [&tolerance](const std::vector<SVertexPNT>& mesh, Mode mode) {
+                return CMeshResourceManager::SelectVertexLayout(mesh.data(), (uint32_t)mesh.size(), mode, tolerance);
+            };
+
+            std::vector<SVertexPNT> sphere = makeSphere(32, 64, 1.0f);
+            SVertexPackingError e = MeasurePackingError(sphere.data(), sphere.size());
+            CFFLog::Info("Sphere: pos %.6f (rel %.6f), normal %.4f deg, tangent %.4f deg, uv %.6f, uv2 %.7f, color %.5f",
+                         e.maxPosition, e.maxPositionRelative, e.maxNormalDegrees, e.maxTangentDegrees,
+                         e.maxUV, e.maxUV2, e.maxColor);
+            ASSERT(ctx, e.maxPosition <= 1.0f / 2048.0f, "Unit sphere position error within half precision");
+            ASSERT(ctx, tolerance.Accepts(e), "Unit sphere accepted by default tolerance");
+            ASSERT(ctx, select(sphere, Mode::Auto) == EVertexLayout::Packed, "Auto packs a unit sphere");
+            ASSERT(ctx, select(sphere, Mode::Full) == EVertexLayout::Full, "Full mode never packs");
+            ASSERT(ctx, select({}, Mode::Packed) == EVertexLayout::Full, "Empty mesh stays full");
+
+            // Positions beyond the half range (65504)
+            std::vector<SVertexPNT> huge = sphere;
+            huge[7].px = 100000.0f;
+            e = MeasurePackingError(huge.data(), huge.size());
+            ASSERT(ctx, !std::isfinite(e.maxPosition), "Half overflow reported as infinite error");
+            ASSERT(ctx, !tolerance.Accepts(e), "Half overflow rejected");
+            ASSERT(ctx, select(huge, Mode::Packed) == EVertexLayout::Full, "Forced packing still refuses half overflow");
+
+            // Small detail far from the origin: half spacing at 4000 is 2 units
+            std::vector<SVertexPNT> farDetail = makeSphere(8, 16, 0.5f, 4000.0f);
+            e = MeasurePackingError(farDetail.data(), farDetail.size());
+            ASSERT(ctx, e.maxPositionRelative > tolerance.maxPositionRelative, "Far-from-origin detail exceeds tolerance");
+            ASSERT(ctx, select(farDetail, Mode::Auto) == EVertexLayout::Full, "Auto keeps far-from-origin mesh full");
+            ASSERT(ctx, select(farDetail, Mode::Packed) == EVertexLayout::Packed, "Forced packing accepts finite error");
+
+            // Tiling UVs lose precision in half
+            std::vector<SVertexPNT> tiled = sphere;
+            for (auto& v : tiled) { v.u = v.u * 300.0f + 0.013f; }
+            e = MeasurePackingError(tiled.data(), tiled.size());
+            ASSERT(ctx, e.maxUV > tolerance.maxUV, "Large tiling UVs exceed tolerance");
+            ASSERT(ctx, select(tiled, Mode::Auto) == EVertexLayout::Full, "Auto keeps tiled-UV mesh full");
+
+            // HDR vertex colors are clamped by unorm8
+            std::vector<SVertexPNT> hdr = sphere;
+            hdr[3].r = 4.0f;
+            e = MeasurePackingError(hdr.data(), hdr.size());
+            ASSERT(ctx, e.maxColor > 1.0f, "HDR color error measured");
+            ASSERT(ctx, select(hdr, Mode::Auto) == EVertexLayout::Full, "Auto keeps HDR-color mesh full");
+
+            // Out-of-range lightmap UVs are clamped by unorm16
+            std::vector<SVertexPNT> uv2 = sphere;
+            uv2[5].u2 = 1.5f;
+            ASSERT(ctx, select(uv2, Mode::Auto) == EVertexLayout::Full, "Auto keeps UV2 outside [0,1] full");
+
+            // Degenerate tangents (meshes without UVs) do not block packing
+            std::vector<SVertexPNT> noTangent = sphere;
+            for (auto& v : noTangent) { v.tx = v.ty = v.tz = 0.0f; }
+            ASSERT(ctx, select(noTangent, Mode::Auto) == EVertexLayout::Packed, "Zero tangents still pack");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Packed Vertex Layout");
+
+            // Memory and pack throughput
+            std::vector<SVertexPNT> sphere = makeSphere(512, 1024, 1.0f);
+            size_t count = sphere.size();
+
+            auto start = std::chrono::high_resolution_clock::now();
+            SPackedMesh packed;
+            PackVertices(sphere.data(), count, packed);
+            double packMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+            start = std::chrono::high_resolution_clock::now();
+            SVertexPackingError e = MeasurePackingError(sphere.data(), count);
+            double measureMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+            double fullMB = count * sizeof(SVertexPNT) / (1024.0 * 1024.0);
+            double positionMB = count * sizeof(SPackedPosition) / (1024.0 * 1024.0);
+            double attributeMB = count * sizeof(SPackedAttributes) / (1024.0 * 1024.0);
+
+            log.LogEvent("Vertex memory (sphere)");
+            log.LogInfo("Vertices                 : %zu", count);
+            log.LogInfo("Full (SVertexPNT, 80 B)  : %8.2f MB", fullMB);
+            log.LogInfo("Packed (8 + 20 B)        : %8.2f MB  (%.1f%% of full)", positionMB + attributeMB,
+                        100.0 * (positionMB + attributeMB) / fullMB);
+            log.LogInfo("Depth/shadow fetch       : %8.2f MB  (%.1f%% of full)", positionMB, 100.0 * positionMB / fullMB);
+
+            log.LogEvent("CPU cost");
+            log.LogInfo("Pack                     : %8.2f ms  (%.1f Mverts/s)", packMs, packMs > 0.0 ? count / packMs / 1000.0 : 0.0);
+            log.LogInfo("Measure error            : %8.2f ms  (%.1f Mverts/s)", measureMs, measureMs > 0.0 ? count / measureMs / 1000.0 : 0.0);
+
+            log.LogEvent("Round-trip error");
+            log.LogInfo("Position                 : %.6f (%.2e of diagonal)", e.maxPosition, e.maxPositionRelative);
+            log.LogInfo("Normal / tangent         : %.4f / %.4f deg", e.maxNormalDegrees, e.maxTangentDegrees);
+            log.LogInfo("UV / UV2 / color         : %.6f / %.7f / %.5f", e.maxUV, e.maxUV2, e.maxColor);
+
+            ASSERT(ctx, (positionMB + attributeMB) < fullMB * 0.4, "Packed layout under 40% of full");
+
+            // Per-mesh selection through the resource manager
+            const char* meshes[] = {
+                "mesh/cube.obj",
+                "mesh/sphere.obj",
+                "pbr_models/Barrel_01_1k.gltf/Barrel_01_1k.gltf",
+            };
+            auto& manager = CMeshResourceManager::Instance();
+            auto previousMode = manager.GetVertexLayoutMode();
+            manager.SetVertexLayoutMode(CMeshResourceManager::EVertexLayoutMode::Auto);
+            manager.ClearCache();
+            manager.ResetLoadStats();
+
+            log.LogEvent("Auto layout selection");
+            for (const char* mesh : meshes) {
+                std::string path = FFPath::GetAbsolutePath(mesh);
+                if (!std::filesystem::exists(path)) {
+                    log.LogInfo("%-50s : missing, skipped", mesh);
+                    continue;
+                }
+                auto resources = manager.GetOrLoad(path);
+                for (size_t i = 0; i < resources.size(); i++) {
+                    if (!resources[i]) continue;
+                    log.LogInfo("%-50s [%zu] : %-6s %7u verts, %8.1f KB", mesh, i,
+                                resources[i]->layout == EVertexLayout::Packed ? "packed" : "full",
+                                resources[i]->vertexCount, resources[i]->GetVertexBytes() / 1024.0);
+                }
+            }
+            const auto& stats = manager.GetLoadStats();
+            log.LogInfo("Total: %u packed, %u full, %.2f KB (%.2f KB as SVertexPNT)",
+                        stats.packedMeshes, stats.fullMeshes, stats.vertexBytes / 1024.0, stats.vertexBytesFull / 1024.0);
+            ASSERT(ctx, stats.vertexBytes <= stats.vertexBytesFull, "Auto selection never grows vertex memory");
+
+            manager.SetVertexLayoutMode(previousMode);
+            manager.ClearCache();
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestPackedVertex)
@@ -0,0 +1,402 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/FFLog.h"
+#include "Engine/Rendering/RayTracing/RayTracer.h"
+#include "Engine/Rendering/RayTracing/SceneGeometryExport.h"
+#include <DirectXMath.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+/**
+ * Test: CRayTracer two-level triangle BVH
+ *
+ * Builds a synthetic scene (no assets, no GPU):
+ *   - Ground plane + grid of UV-sphere instances with rotation / non-uniform scale
+ *
+ * Correctness (Frame 1):
+ *   - Closest hit matches brute-force triangle intersection on random rays
+ *   - Occluded() agrees with TraceRay().valid
+ *   - Scalar and SIMD kernels select the same nearest hit
+ *   - Packet traversal (TraceRays) matches single-ray TraceRay
+ *
+ * Benchmark (Frame 5):
+ *   - Mrays/s for coherent primary rays, incoherent random rays and shadow rays
+ *   - Scalar vs SIMD kernel, single-ray vs packet, single thread vs CJobSystem::ParallelFor
+ *
+ * Usage:
+ *   forfun.exe --test TestRayTracerBVH
+ *   Results: E:/forfun/debug/TestRayTracerBVH/test.log
+ */
+namespace {
+    const int SPHERE_SEGMENTS = 24;
+    const int GRID_SIZE = 12;          // GRID_SIZE^2 sphere instances
+    const float GRID_SPACING = 2.5f;
+
+    void AppendUVSphere(SRayTracingMeshData& mesh, int segments)
+    {
+        const int rings = segments;
+        const int sectors = segments * 2;
+        for (int i = 0; i <= rings; i++) {
+            float theta = XM_PI * i / rings;
+            for (int j = 0; j <= sectors; j++) {
+                float phi = XM_2PI * j / sectors;
+                mesh.positions.push_back({std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+            }
+        }
+        const uint32_t stride = sectors + 1;
+        for (int i = 0; i < rings; i++) {
+            for (int j = 0; j < sectors; j++) {
+                uint32_t a = i * stride + j;
+                uint32_t b = a + 1;
+                uint32_t c = a + stride;
+                uint32_t d = c + 1;
+                mesh.indices.insert(mesh.indices.end(), {a, c, b, b, c, d});
+            }
+        }
+        mesh.vertexCount = (uint32_t)mesh.positions.size();
+        mesh.indexCount = (uint32_t)mesh.indices.size();
+    }
+
+    void AppendPlane(SRayTracingMeshData& mesh, float halfSize)
+    {
+        mesh.positions = {{-halfSize, 0, -halfSize}, {halfSize, 0, -halfSize}, {halfSize, 0, halfSize}, {-halfSize, 0, halfSize}};
+        mesh.indices = {0, 2, 1, 0, 3, 2};
+        mesh.vertexCount = 4;
+        mesh.indexCount = 6;
+    }
+
+    // Row-vector world matrix: scale, Y rotation, translation
+    XMFLOAT4X4 MakeTransform(float sx, float sy, float sz, float yaw, float tx, float ty, float tz)
+    {
+        XMFLOAT4X4 m;
+        float c = std::cos(yaw), s = std::sin(yaw);
+        m.m[0][0] = sx * c;  m.m[0][1] = 0;  m.m[0][2] = -sx * s; m.m[0][3] = 0;
+        m.m[1][0] = 0;       m.m[1][1] = sy; m.m[1][2] = 0;       m.m[1][3] = 0;
+        m.m[2][0] = sz * s;  m.m[2][1] = 0;  m.m[2][2] = sz * c;  m.m[2][3] = 0;
+        m.m[3][0] = tx;      m.m[3][1] = ty; m.m[3][2] = tz;      m.m[3][3] = 1;
+        return m;
+    }
+
+    XMFLOAT3 TransformPoint(const XMFLOAT4X4& m, const XMFLOAT3& p)
+    {
+        return {
+            p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+            p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+            p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2]
+        };
+    }
+
+    void BuildSyntheticScene(SRayTracingSceneData& scene)
+    {
+        scene.meshes.resize(2);
+        AppendPlane(scene.meshes[0], GRID_SIZE * GRID_SPACING);
+        AppendUVSphere(scene.meshes[1], SPHERE_SEGMENTS);
+
+        scene.materials.resize(2);
+        scene.materials[0].albedo = {0.8f, 0.8f, 0.8f};
+        scene.materials[1].albedo = {0.9f, 0.3f, 0.2f};
+
+        SRayTracingInstance ground;
+        ground.worldTransform = MakeTransform(1, 1, 1, 0, 0, 0, 0);
+        ground.meshIndex = 0;
+        ground.materialIndex = 0;
+        scene.instances.push_back(ground);
+
+        const float offset = (GRID_SIZE - 1) * GRID_SPACING * 0.5f;
+        for (int z = 0; z < GRID_SIZE; z++) {
+            for (int x = 0; x < GRID_SIZE; x++) {
+                float scale = 0.6f + 0.05f * ((x + z) % 5);
+                SRayTracingInstance inst;
+                inst.worldTransform = MakeTransform(scale, scale * 1.4f, scale, 0.3f * (x - z),
+                                                    x * GRID_SPACING - offset, scale * 1.4f, z * GRID_SPACING - offset);
+                inst.meshIndex = 1;
+                inst.materialIndex = 1;
+                inst.instanceID = (uint32_t)scene.instances.size();
+                scene.instances.push_back(inst);
+            }
+        }
+    }
+
+    // Reference: test every world-space triangle
+    float BruteForceClosest(const SRayTracingSceneData& scene, const SRay& ray)
+    {
+        SBVHRay bvhRay;
+        bvhRay.origin = ray.origin;
+        bvhRay.direction = ray.direction;
+        bvhRay.tMin = ray.tMin;
+        bvhRay.tMax = ray.tMax;
+
+        float closest = ray.tMax;
+        for (const auto& inst : scene.instances) {
+            const auto& mesh = scene.meshes[inst.meshIndex];
+            for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+                XMFLOAT3 a = TransformPoint(inst.worldTransform, mesh.positions[mesh.indices[i]]);
+                XMFLOAT3 b = TransformPoint(inst.worldTransform, mesh.positions[mesh.indices[i + 1]]);
+                XMFLOAT3 c = TransformPoint(inst.worldTransform, mesh.positions[mesh.indices[i + 2]]);
+                SBVHTriangle tri{a, {b.x - a.x, b.y - a.y, b.z - a.z}, {c.x - a.x, c.y - a.y, c.z - a.z}};
+                float t, u, v;
+                if (BVHMath::RayTriangle(bvhRay, tri, closest, t, u, v)) {
+                    closest = t;
+                }
+            }
+        }
+        return closest;
+    }
+
+    XMFLOAT3 RandomDirection(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        XMFLOAT3 d;
+        float lenSq;
+        do {
+            d = {dist(rng), dist(rng), dist(rng)};
+            lenSq = d.x * d.x + d.y * d.y + d.z * d.z;
+        } while (lenSq < 1e-4f || lenSq > 1.0f);
+        float inv = 1.0f / std::sqrt(lenSq);
+        return {d.x * inv, d.y * inv, d.z * inv};
+    }
+
+    // Pinhole camera looking down at the grid; rays ordered in 2x2 quads
+    // so consecutive groups of 4 form coherent packets for TraceRays
+    std::vector<SRay> MakePrimaryRays(int width, int height)
+    {
+        std::vector<SRay> rays;
+        rays.reserve((size_t)width * height);
+        XMFLOAT3 eye = {0.0f, 12.0f, -30.0f};
+        for (int qy = 0; qy < height; qy += 2) {
+            for (int qx = 0; qx < width; qx += 2) {
+                for (int i = 0; i < 4; i++) {
+                    int x = qx + (i & 1);
+                    int y = qy + (i >> 1);
+                    float u = (x + 0.5f) / width * 2.0f - 1.0f;
+                    float v = 1.0f - (y + 0.5f) / height * 2.0f;
+                    XMFLOAT3 d = {u * 0.8f, v * 0.45f - 0.35f, 1.0f};
+                    float inv = 1.0f / std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+                    SRay ray;
+                    ray.origin = eye;
+                    ray.direction = {d.x * inv, d.y * inv, d.z * inv};
+                    rays.push_back(ray);
+                }
+            }
+        }
+        return rays;
+    }
+
+    std::vector<SRay> MakeRandomRays(std::mt19937& rng, size_t count)
+    {
+        std::uniform_real_distribution<float> pos(-GRID_SIZE * GRID_SPACING * 0.5f, GRID_SIZE * GRID_SPACING * 0.5f);
+        std::uniform_real_distribution<float> height(0.1f, 4.0f);
+        std::vector<SRay> rays(count);
+        for (auto& ray : rays) {
+            ray.origin = {pos(rng), height(rng), pos(rng)};
+            ray.direction = RandomDirection(rng);
+        }
+        return rays;
+    }
+
+    // Returns Mrays/s
+    template<typename TFunc>
+    double MeasureRays(const std::vector<SRay>& rays, bool parallel, TFunc&& traceRange)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        if (parallel) {
+            CJobSystem::Instance().ParallelFor((uint32_t)rays.size(), 1024, traceRange);
+        } else {
+            traceRange(0, (uint32_t)rays.size());
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        return (seconds > 0.0) ? rays.size() / seconds / 1e6 : 0.0;
+    }
+}
+
+class CTestRayTracerBVH : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestRayTracerBVH";
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [this, &ctx]() {
+            CFFLog::Info("=== TestRayTracerBVH ===");
+            CFFLog::Info("Frame 1: Build + brute-force comparison");
+
+            BuildSyntheticScene(m_scene);
+            bool ok = m_rayTracer.Initialize(m_scene);
+            ASSERT(ctx, ok, "CRayTracer initialized from synthetic scene");
+            ASSERT_EQUAL(ctx, m_rayTracer.GetObjectCount(), (int)m_scene.instances.size(), "All instances in TLAS");
+
+            std::mt19937 rng(1234);
+            std::vector<SRay> rays = MakeRandomRays(rng, 2000);
+
+            int hitCount = 0;
+            int distanceMismatch = 0;
+            int occlusionMismatch = 0;
+            for (const auto& ray : rays) {
+                SRayHit hit = m_rayTracer.TraceRay(ray);
+                float reference = BruteForceClosest(m_scene, ray);
+                bool referenceHit = reference < ray.tMax;
+
+                if (hit.valid) hitCount++;
+                if (hit.valid != referenceHit ||
+                    (referenceHit && std::abs(hit.distance - reference) > 1e-3f * std::max(1.0f, reference))) {
+                    distanceMismatch++;
+                }
+                if (m_rayTracer.Occluded(ray) != hit.valid) {
+                    occlusionMismatch++;
+                }
+            }
+
+            CFFLog::Info("Rays: %d, hits: %d", (int)rays.size(), hitCount);
+            ASSERT(ctx, hitCount > 0, "Random rays hit geometry");
+            ASSERT_EQUAL(ctx, distanceMismatch, 0, "BVH closest hit matches brute force");
+            ASSERT_EQUAL(ctx, occlusionMismatch, 0, "Occluded() agrees with TraceRay()");
+
+            // Straight down onto the ground between spheres: normal faces the ray
+            SRayHit groundHit = m_rayTracer.TraceRay({GRID_SPACING * 0.5f, 10.0f, GRID_SPACING * 0.5f}, {0, -1, 0});
+            ASSERT(ctx, groundHit.valid, "Downward ray hits ground");
+            ASSERT_EQUAL(ctx, groundHit.objectIndex, 0, "Hit reports original instance index");
+            ASSERT_EQUAL_F(ctx, groundHit.normal.y, 1.0f, 1e-4f, "Ground normal faces the ray");
+
+            // Kernel equivalence: identical nearest hit, not just distance
+            std::vector<SRay> kernelRays = MakeRandomRays(rng, 20000);
+            int kernelMismatch = 0;
+            for (const auto& ray : kernelRays) {
+                m_rayTracer.SetKernel(EBVHKernel::SIMD);
+                SRayHit simdHit = m_rayTracer.TraceRay(ray);
+                bool simdOccluded = m_rayTracer.Occluded(ray);
+                m_rayTracer.SetKernel(EBVHKernel::Scalar);
+                SRayHit scalarHit = m_rayTracer.TraceRay(ray);
+                bool scalarOccluded = m_rayTracer.Occluded(ray);
+
+                if (simdHit.valid != scalarHit.valid || simdHit.distance != scalarHit.distance ||
+                    simdHit.objectIndex != scalarHit.objectIndex || simdHit.primitiveIndex != scalarHit.primitiveIndex ||
+                    simdOccluded != scalarOccluded) {
+                    kernelMismatch++;
+                }
+            }
+            m_rayTracer.SetKernel(BVH_DEFAULT_KERNEL);
+            ASSERT_EQUAL(ctx, kernelMismatch, 0, "Scalar and SIMD kernels select the same hit");
+
+            // Packet traversal vs single rays (coherent primary rays)
+            std::vector<SRay> primary = MakePrimaryRays(320, 180);
+            std::vector<SRayHit> packetHits(primary.size());
+            m_rayTracer.TraceRays(primary.data(), packetHits.data(), (uint32_t)primary.size());
+            int packetMismatch = 0;
+            for (size_t i = 0; i < primary.size(); i++) {
+                SRayHit single = m_rayTracer.TraceRay(primary[i]);
+                if (single.valid != packetHits[i].valid || single.distance != packetHits[i].distance ||
+                    single.objectIndex != packetHits[i].objectIndex) {
+                    packetMismatch++;
+                }
+            }
+            ASSERT_EQUAL(ctx, packetMismatch, 0, "Packet traversal matches single-ray traversal");
+
+            CFFLog::Info("✓ Frame 1: BVH matches brute force, kernels agree");
+        });
+
+        ctx.OnFrame(5, [this, &ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "RayTracer BVH");
+
+            auto& jobs = CJobSystem::Instance();
+            if (!jobs.IsInitialized()) {
+                jobs.Initialize();
+            }
+
+            log.LogEvent("Scene");
+            log.LogInfo("Instances: %d, meshes: %d, triangles (unique): %d, BVH nodes: %d",
+                        m_rayTracer.GetObjectCount(), m_rayTracer.GetMeshCount(),
+                        m_rayTracer.GetTriangleCount(), m_rayTracer.GetBVHNodeCount());
+
+            std::mt19937 rng(5678);
+            std::vector<SRay> primary = MakePrimaryRays(1280, 720);
+            std::vector<SRay> incoherent = MakeRandomRays(rng, 1 << 20);
+            std::vector<SRay> shadow = MakeRandomRays(rng, 1 << 20);
+
+            std::atomic<int> sink{0};
+            auto closest = [this, &sink](const std::vector<SRay>& rays) {
+                return [this, &sink, &rays](uint32_t begin, uint32_t end) {
+                    int hits = 0;
+                    for (uint32_t i = begin; i < end; i++) {
+                        hits += m_rayTracer.TraceRay(rays[i]).valid ? 1 : 0;
+                    }
+                    sink.fetch_add(hits, std::memory_order_relaxed);
+                };
+            };
+            auto occluded = [this, &sink](const std::vector<SRay>& rays) {
+                return [this, &sink, &rays](uint32_t begin, uint32_t end) {
+                    int hits = 0;
+                    for (uint32_t i = begin; i < end; i++) {
+                        hits += m_rayTracer.Occluded(rays[i]) ? 1 : 0;
+                    }
+                    sink.fetch_add(hits, std::memory_order_relaxed);
+                };
+            };
+            // Ranges are multiples of 4 (grain 1024) so packets never straddle jobs
+            std::vector<SRayHit> packetHits(primary.size());
+            auto packets = [this, &sink, &primary, &packetHits](uint32_t begin, uint32_t end) {
+                m_rayTracer.TraceRays(primary.data() + begin, packetHits.data() + begin, end - begin);
+                int hits = 0;
+                for (uint32_t i = begin; i < end; i++) {
+                    hits += packetHits[i].valid ? 1 : 0;
+                }
+                sink.fetch_add(hits, std::memory_order_relaxed);
+            };
+
+            log.LogEvent("Throughput (Mrays/s)");
+            log.LogInfo("Threads: %u, SIMD kernels: %s", jobs.GetThreadCount(), FF_BVH_SIMD ? "SSE" : "unavailable");
+            struct SCase { const char* name; EBVHKernel kernel; std::function<void(uint32_t, uint32_t)> func; const std::vector<SRay>* rays; };
+            const SCase cases[] = {
+                {"Primary scalar",    EBVHKernel::Scalar, closest(primary),    &primary},
+                {"Primary SIMD",      EBVHKernel::SIMD,   closest(primary),    &primary},
+                {"Primary packet",    EBVHKernel::SIMD,   packets,             &primary},
+                {"Random scalar",     EBVHKernel::Scalar, closest(incoherent), &incoherent},
+                {"Random SIMD",       EBVHKernel::SIMD,   closest(incoherent), &incoherent},
+                {"Shadow scalar",     EBVHKernel::Scalar, occluded(shadow),    &shadow},
+                {"Shadow SIMD",       EBVHKernel::SIMD,   occluded(shadow),    &shadow},
+            };
+            for (const auto& c : cases) {
+                m_rayTracer.SetKernel(c.kernel);
+                double single = MeasureRays(*c.rays, false, c.func);
+                double multi = MeasureRays(*c.rays, true, c.func);
+                log.LogInfo("%-18s %8.2f (1 thread) | %8.2f (%u threads) | %.2fx",
+                            c.name, single, multi, jobs.GetThreadCount(), single > 0.0 ? multi / single : 0.0);
+            }
+            m_rayTracer.SetKernel(BVH_DEFAULT_KERNEL);
+            log.LogInfo("(hit checksum %d)", sink.load());
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+        });
+
+        ctx.OnFrame(10, [this, &ctx]() {
+            m_rayTracer.Shutdown();
+
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+
+private:
+    SRayTracingSceneData m_scene;
+    CRayTracer m_rayTracer;
+};
+
+REGISTER_TEST(CTestRayTracerBVH)
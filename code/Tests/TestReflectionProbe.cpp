@@ -53,7 +53,7 @@ public:
             {
                 auto* lightObj = world.Create("DirectionalLight");
                 auto* transform = lightObj->AddComponent<STransform>();
-                transform->rotationEuler = { XMConvertToRadians(45.0f), XMConvertToRadians(-30.0f), 0.0f };
+                transform->SetRotationEuler({ XMConvertToRadians(45.0f), XMConvertToRadians(-30.0f), 0.0f });
 
                 auto* light = lightObj->AddComponent<SDirectionalLight>();
                 light->color = { 1.0f, 1.0f, 1.0f };
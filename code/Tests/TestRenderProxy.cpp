@@ -0,0 +1,207 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/MaterialManager.h"
+#include "Engine/World.h"
+#include "Engine/GameObject.h"
+#include "Engine/Components/Transform.h"
+#include "Engine/Components/MeshRenderer.h"
+#include "Engine/Rendering/RenderProxy.h"
+#include <DirectXMath.h>
+#include <chrono>
+#include <string>
+
+using namespace DirectX;
+
+/**
+ * Test: Render proxy table (cached world matrices / bounds / materials)
+ *
+ * Frame 1 (correctness, private CWorld):
+ *   - Proxies are built for objects with SMeshRenderer + STransform only
+ *   - Unchanged world -> Update() recomputes nothing
+ *   - Transform edit -> exactly that proxy gets Dirty_Transform, matrix + bounds follow
+ *   - materialPath edit + MarkRenderStateDirty() -> material re-resolved
+ *   - AddComponent / Destroy -> table rebuilt
+ *
+ * Frame 5 (benchmark, 10k objects):
+ *   - "Before": 4 passes each doing GetComponent x2 + WorldMatrix() + CMaterialManager::Load
+ *   - "After":  one Update() + 4 passes reading the SoA table (static and 1% moving)
+ *
+ * Usage:
+ *   forfun.exe --test TestRenderProxy
+ *   Results: E:/forfun/debug/TestRenderProxy/test.log
+ */
+class CTestRenderProxy : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestRenderProxy";
+    }
+
+    static const int BENCH_OBJECT_COUNT = 10000;
+    static const int PASS_COUNT = 4;    // Depth pre-pass, G-Buffer, shadow, transparent
+
+    static CGameObject* createDrawable(CWorld& world, int index, const char* materialPath) {
+        CGameObject* obj = world.Create("Proxy_" + std::to_string(index));
+        auto* transform = obj->AddComponent<STransform>();
+        transform->position = {(float)(index % 100) * 2.0f, 0.0f, (float)(index / 100) * 2.0f};
+        auto* meshRenderer = obj->AddComponent<SMeshRenderer>();
+        meshRenderer->path = "mesh/cube.obj";
+        meshRenderer->materialPath = materialPath;
+        return obj;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestRenderProxy ===");
+            CFFLog::Info("Frame 1: Correctness checks");
+
+            CWorld world;
+            for (int i = 0; i < 8; i++) {
+                createDrawable(world, i, "");
+            }
+            CGameObject* lightOnly = world.Create("NoMesh");
+            lightOnly->AddComponent<STransform>();
+
+            CRenderProxyTable proxies;
+            proxies.Update(world);
+            ASSERT(ctx, proxies.WasRebuilt(), "First Update rebuilds");
+            ASSERT_EQUAL(ctx, (int)proxies.Size(), 8, "Only objects with mesh + transform get proxies");
+            ASSERT(ctx, proxies.IsDrawable(0), "Cube mesh uploaded");
+            ASSERT(ctx, proxies.GetMaterial(0) == CMaterialManager::Instance().GetDefault(),
+                   "Empty materialPath resolves to default material");
+
+            // No changes
+            int updated = proxies.Update(world);
+            ASSERT(ctx, !proxies.WasRebuilt(), "Unchanged world does not rebuild");
+            ASSERT_EQUAL(ctx, updated, 0, "Unchanged world recomputes nothing");
+
+            // Transform edit
+            STransform* moved = proxies.GetTransform(3);
+            float oldCenterX = proxies.GetBounds().centerX[3];
+            moved->position.x += 10.0f;
+            updated = proxies.Update(world);
+            ASSERT_EQUAL(ctx, updated, 1, "Only the moved proxy is recomputed");
+            ASSERT(ctx, (proxies.GetDirtyFlags(3) & RenderProxyDirty_Transform) != 0, "Moved proxy flagged Dirty_Transform");
+            ASSERT_EQUAL(ctx, (int)proxies.GetDirtyFlags(2), 0, "Other proxies stay clean");
+
+            XMFLOAT4X4 cached, expected;
+            XMStoreFloat4x4(&cached, proxies.GetWorldMatrix(3));
+            XMStoreFloat4x4(&expected, moved->WorldMatrix());
+            ASSERT_EQUAL_F(ctx, cached._41, expected._41, 1e-5f, "Cached world matrix follows transform");
+            ASSERT_EQUAL_F(ctx, proxies.GetBounds().centerX[3], oldCenterX + 10.0f, 1e-4f, "Bounds follow transform");
+
+            // Material edit from code
+            SMeshRenderer* recolored = proxies.GetMeshRenderer(5);
+            recolored->materialPath = "materials/default_white.ffasset";
+            recolored->MarkRenderStateDirty();
+            proxies.Update(world);
+            ASSERT(ctx, (proxies.GetDirtyFlags(5) & RenderProxyDirty_Material) != 0, "Material edit flagged Dirty_Material");
+            ASSERT(ctx, proxies.GetMaterial(5) == CMaterialManager::Instance().Load(recolored->materialPath),
+                   "Material re-resolved after edit");
+
+            // Structural changes
+            lightOnly->AddComponent<SMeshRenderer>()->path = "mesh/cube.obj";
+            proxies.Update(world);
+            ASSERT(ctx, proxies.WasRebuilt(), "AddComponent triggers rebuild");
+            ASSERT_EQUAL(ctx, (int)proxies.Size(), 9, "New mesh renderer gets a proxy");
+
+            world.Destroy(0);
+            proxies.Update(world);
+            ASSERT(ctx, proxies.WasRebuilt(), "Destroy triggers rebuild");
+            ASSERT_EQUAL(ctx, (int)proxies.Size(), 8, "Destroyed object loses its proxy");
+
+            CFFLog::Info("✓ Frame 1: Correctness checks passed");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Render Proxy Table");
+
+            CWorld world;
+            for (int i = 0; i < BENCH_OBJECT_COUNT; i++) {
+                createDrawable(world, i, (i % 2) ? "materials/default_white.ffasset" : "");
+            }
+
+            const int frames = 20;
+            volatile float sink = 0.0f;
+
+            // Before: every pass scans components and resolves matrix + material
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int f = 0; f < frames; f++) {
+                for (int pass = 0; pass < PASS_COUNT; pass++) {
+                    for (auto& objPtr : world.Objects()) {
+                        auto* obj = objPtr.get();
+                        auto* meshRenderer = obj->GetComponent<SMeshRenderer>();
+                        auto* transform = obj->GetComponent<STransform>();
+                        if (!meshRenderer || !transform) continue;
+                        meshRenderer->EnsureUploaded();
+
+                        CMaterialAsset* material = CMaterialManager::Instance().GetDefault();
+                        if (!meshRenderer->materialPath.empty()) {
+                            material = CMaterialManager::Instance().Load(meshRenderer->materialPath);
+                        }
+                        XMMATRIX worldMatrix = transform->WorldMatrix();
+                        sink = sink + XMVectorGetX(worldMatrix.r[3]) + material->roughness;
+                    }
+                }
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double beforeMs = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+
+            // After: one Update per frame, passes read the table
+            CRenderProxyTable proxies;
+            proxies.Update(world);
+            auto runAfter = [&](int movingStride) {
+                auto t0 = std::chrono::high_resolution_clock::now();
+                for (int f = 0; f < frames; f++) {
+                    if (movingStride > 0) {
+                        for (size_t i = 0; i < proxies.Size(); i += movingStride) {
+                            proxies.GetTransform(i)->position.y = (float)f * 0.01f;
+                        }
+                    }
+                    proxies.Update(world);
+                    for (int pass = 0; pass < PASS_COUNT; pass++) {
+                        for (size_t i = 0; i < proxies.Size(); i++) {
+                            if (!proxies.IsDrawable(i)) continue;
+                            XMMATRIX worldMatrix = proxies.GetWorldMatrix(i);
+                            sink = sink + XMVectorGetX(worldMatrix.r[3]) + proxies.GetMaterial(i)->roughness;
+                        }
+                    }
+                }
+                auto t1 = std::chrono::high_resolution_clock::now();
+                return std::chrono::duration<double, std::milli>(t1 - t0).count() / frames;
+            };
+            double afterStaticMs = runAfter(0);
+            double afterMovingMs = runAfter(100);
+
+            log.LogEvent("Frame CPU time");
+            log.LogInfo("%d objects, %d passes", BENCH_OBJECT_COUNT, PASS_COUNT);
+            log.LogInfo("Before (per-pass scans) : %7.3f ms", beforeMs);
+            log.LogInfo("After  (static)         : %7.3f ms | speedup %.2fx", afterStaticMs,
+                        afterStaticMs > 0.0 ? beforeMs / afterStaticMs : 0.0);
+            log.LogInfo("After  (1%% moving)      : %7.3f ms | speedup %.2fx", afterMovingMs,
+                        afterMovingMs > 0.0 ? beforeMs / afterMovingMs : 0.0);
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, afterStaticMs < beforeMs, "Proxy table is faster than per-pass scans");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestRenderProxy)
@@ -0,0 +1,375 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/SphericalHarmonics.h"
+#include "Core/SphericalHarmonicsBatch.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+namespace SH = SphericalHarmonics;
+
+/**
+ * Test: batched SoA SH library (evaluate, blend, rotate, window)
+ *
+ * Frame 1 (CPU only):
+ *   - SetProbe / GetProbe round trip, padding lanes stay 0
+ *   - EvaluateBatch matches EvaluateSH / _L1 / _L3 / _L4 (L1 - L4)
+ *   - BlendBatch matches a per-probe weighted sum
+ *   - RotateBatch: rotated probes at d * R equal the originals at d (L1 - L4),
+ *     identity keeps the coefficients, in-place works
+ *   - Hanning / Lanczos band scales; windowing reduces the ringing of a
+ *     small bright light projected to L4
+ *   - Scalar and SIMD kernels agree (counts not a multiple of 4)
+ *
+ * Frame 5 (benchmark, 4096 L2 probes):
+ *   - Per-probe AoS loops vs batch scalar vs batch SIMD for evaluate (64
+ *     directions), blend (8 probes per target), rotate and window
+ *
+ * Usage:
+ *   forfun.exe --test TestSHBatch
+ *   Results: E:/forfun/debug/TestSHBatch/test.log
+ */
+class CTestSHBatch : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestSHBatch";
+    }
+
+    static const int BENCH_PROBE_COUNT = 4096;
+
+    static std::vector<XMFLOAT3> randomCoeffs(std::mt19937& rng, size_t count) {
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<XMFLOAT3> coeffs(count);
+        for (XMFLOAT3& c : coeffs) c = XMFLOAT3(dist(rng), dist(rng), dist(rng));
+        return coeffs;
+    }
+
+    static std::vector<XMFLOAT3> randomDirections(std::mt19937& rng, size_t count) {
+        std::normal_distribution<float> dist;
+        std::vector<XMFLOAT3> dirs(count);
+        for (XMFLOAT3& d : dirs) {
+            float x = dist(rng), y = dist(rng), z = dist(rng);
+            float len = std::sqrt(x * x + y * y + z * z);
+            d = XMFLOAT3(x / len, y / len, z / len);
+        }
+        return dirs;
+    }
+
+    // Row-vector rotation about a unit axis (Rodrigues)
+    static XMFLOAT3X3 rotationAxisAngle(XMFLOAT3 a, float angle) {
+        const float c = std::cos(angle), s = std::sin(angle), t = 1.0f - c;
+        XMFLOAT3X3 m;
+        m._11 = t * a.x * a.x + c;       m._12 = t * a.x * a.y + s * a.z; m._13 = t * a.x * a.z - s * a.y;
+        m._21 = t * a.x * a.y - s * a.z; m._22 = t * a.y * a.y + c;       m._23 = t * a.y * a.z + s * a.x;
+        m._31 = t * a.x * a.z + s * a.y; m._32 = t * a.y * a.z - s * a.x; m._33 = t * a.z * a.z + c;
+        return m;
+    }
+
+    static XMFLOAT3 transform(const XMFLOAT3& d, const XMFLOAT3X3& m) {
+        return XMFLOAT3(d.x * m._11 + d.y * m._21 + d.z * m._31,
+                        d.x * m._12 + d.y * m._22 + d.z * m._32,
+                        d.x * m._13 + d.y * m._23 + d.z * m._33);
+    }
+
+    static float maxDiff(const std::vector<XMFLOAT3>& a, const std::vector<XMFLOAT3>& b) {
+        float d = 0.0f;
+        for (size_t i = 0; i < a.size(); i++) {
+            d = std::max({d, std::abs(a[i].x - b[i].x), std::abs(a[i].y - b[i].y), std::abs(a[i].z - b[i].z)});
+        }
+        return d;
+    }
+
+    // Existing single-probe evaluation (clamped to 0)
+    static XMFLOAT3 evaluateScalar(int order, const XMFLOAT3* coeffs, const XMFLOAT3& dir) {
+        switch (order) {
+            case 1: { std::array<XMFLOAT3, 4> c; std::copy(coeffs, coeffs + 4, c.begin()); return SH::EvaluateSH_L1(c, dir); }
+            case 2: { std::array<XMFLOAT3, 9> c; std::copy(coeffs, coeffs + 9, c.begin()); return SH::EvaluateSH(c, dir); }
+            case 3: { std::array<XMFLOAT3, 16> c; std::copy(coeffs, coeffs + 16, c.begin()); return SH::EvaluateSH_L3(c, dir); }
+            default: { std::array<XMFLOAT3, 25> c; std::copy(coeffs, coeffs + 25, c.begin()); return SH::EvaluateSH_L4(c, dir); }
+        }
+    }
+
+    static void testOrder(CTestContext& ctx, int order) {
+        std::mt19937 rng(1234 + order);
+        const int coeffCount = SH::CoeffCount(order);
+        const size_t probeCount = 13;
+        const size_t dirCount = 7;
+        char msg[128];
+
+        std::vector<XMFLOAT3> coeffs = randomCoeffs(rng, probeCount * coeffCount);
+        SH::CSHBatch batch(order, probeCount);
+        for (size_t p = 0; p < probeCount; p++) batch.SetProbe(p, &coeffs[p * coeffCount]);
+
+        std::vector<XMFLOAT3> back(probeCount * coeffCount);
+        for (size_t p = 0; p < probeCount; p++) batch.GetProbe(p, &back[p * coeffCount]);
+        bool padding = true;
+        for (int i = 0; i < coeffCount; i++)
+            for (int c = 0; c < 3; c++)
+                for (size_t p = probeCount; p < batch.GetStride(); p++) padding &= batch.Row(i, c)[p] == 0.0f;
+        snprintf(msg, sizeof(msg), "L%d SetProbe / GetProbe round trip, padding is 0", order);
+        ASSERT(ctx, maxDiff(coeffs, back) == 0.0f && padding, msg);
+
+        // Evaluate
+        std::vector<XMFLOAT3> dirs = randomDirections(rng, dirCount);
+        std::vector<XMFLOAT3> scalar(dirCount * probeCount), simd(dirCount * probeCount), expected(dirCount * probeCount);
+        SH::EvaluateBatch(batch, dirs.data(), dirCount, scalar.data(), SH::EBatchKernel::Scalar);
+        SH::EvaluateBatch(batch, dirs.data(), dirCount, simd.data(), SH::EBatchKernel::SIMD);
+        std::vector<XMFLOAT3> clamped = simd;
+        for (size_t d = 0; d < dirCount; d++) {
+            for (size_t p = 0; p < probeCount; p++) {
+                expected[d * probeCount + p] = evaluateScalar(order, &coeffs[p * coeffCount], dirs[d]);
+                XMFLOAT3& c = clamped[d * probeCount + p];
+                c = XMFLOAT3(std::max(c.x, 0.0f), std::max(c.y, 0.0f), std::max(c.z, 0.0f));
+            }
+        }
+        snprintf(msg, sizeof(msg), "L%d EvaluateBatch matches EvaluateSH (%.2e)", order, maxDiff(clamped, expected));
+        ASSERT(ctx, maxDiff(clamped, expected) < 1e-5f, msg);
+        snprintf(msg, sizeof(msg), "L%d EvaluateBatch SIMD matches scalar", order);
+        ASSERT(ctx, maxDiff(scalar, simd) < 1e-5f, msg);
+
+        // Blend: 10 targets of 3 probes
+        const size_t targetCount = 10;
+        const int k = 3;
+        std::vector<uint32_t> indices(targetCount * k);
+        std::vector<float> weights(targetCount * k);
+        for (size_t i = 0; i < indices.size(); i++) {
+            indices[i] = (uint32_t)(rng() % probeCount);
+            weights[i] = 0.1f + 0.2f * (float)(i % 4);
+        }
+        SH::CSHBatch blendScalar, blendSIMD;
+        SH::BlendBatch(batch, indices.data(), weights.data(), targetCount, k, blendScalar, SH::EBatchKernel::Scalar);
+        SH::BlendBatch(batch, indices.data(), weights.data(), targetCount, k, blendSIMD, SH::EBatchKernel::SIMD);
+        std::vector<XMFLOAT3> blended(targetCount * coeffCount), blendedSIMD(targetCount * coeffCount), blendExpected(targetCount * coeffCount);
+        for (size_t t = 0; t < targetCount; t++) {
+            blendScalar.GetProbe(t, &blended[t * coeffCount]);
+            blendSIMD.GetProbe(t, &blendedSIMD[t * coeffCount]);
+            for (int i = 0; i < coeffCount; i++) {
+                XMFLOAT3 sum(0, 0, 0);
+                for (int j = 0; j < k; j++) {
+                    const XMFLOAT3& c = coeffs[indices[t * k + j] * coeffCount + i];
+                    float w = weights[t * k + j];
+                    sum = XMFLOAT3(sum.x + w * c.x, sum.y + w * c.y, sum.z + w * c.z);
+                }
+                blendExpected[t * coeffCount + i] = sum;
+            }
+        }
+        snprintf(msg, sizeof(msg), "L%d BlendBatch matches per-probe weighted sum (scalar and SIMD)", order);
+        ASSERT(ctx, maxDiff(blended, blendExpected) < 1e-5f && maxDiff(blendedSIMD, blendExpected) < 1e-5f, msg);
+
+        // Rotate
+        XMFLOAT3X3 rotation = rotationAxisAngle(XMFLOAT3(0.267261f, 0.534522f, 0.801784f), 1.1f);
+        SH::CSHBatch rotated, rotatedScalar;
+        SH::RotateBatch(batch, rotation, rotated, SH::EBatchKernel::SIMD);
+        SH::RotateBatch(batch, rotation, rotatedScalar, SH::EBatchKernel::Scalar);
+        std::vector<XMFLOAT3> rotatedDirs(dirCount);
+        for (size_t d = 0; d < dirCount; d++) rotatedDirs[d] = transform(dirs[d], rotation);
+        std::vector<XMFLOAT3> afterRotation(dirCount * probeCount), afterRotationScalar(dirCount * probeCount);
+        SH::EvaluateBatch(rotated, rotatedDirs.data(), dirCount, afterRotation.data());
+        SH::EvaluateBatch(rotatedScalar, rotatedDirs.data(), dirCount, afterRotationScalar.data());
+        snprintf(msg, sizeof(msg), "L%d rotated probes at d * R equal the originals at d (%.2e)", order, maxDiff(afterRotation, scalar));
+        ASSERT(ctx, maxDiff(afterRotation, scalar) < 1e-4f, msg);
+        snprintf(msg, sizeof(msg), "L%d RotateBatch SIMD matches scalar", order);
+        ASSERT(ctx, maxDiff(afterRotation, afterRotationScalar) < 1e-5f, msg);
+
+        XMFLOAT3X3 identity = rotationAxisAngle(XMFLOAT3(0, 1, 0), 0.0f);
+        SH::CSHBatch same = batch;
+        SH::RotateBatch(same, identity, same);
+        std::vector<XMFLOAT3> sameCoeffs(probeCount * coeffCount);
+        for (size_t p = 0; p < probeCount; p++) same.GetProbe(p, &sameCoeffs[p * coeffCount]);
+        snprintf(msg, sizeof(msg), "L%d identity rotation (in place) keeps coefficients (%.2e)", order, maxDiff(sameCoeffs, coeffs));
+        ASSERT(ctx, maxDiff(sameCoeffs, coeffs) < 1e-5f, msg);
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestSHBatch ===");
+            CFFLog::Info("Frame 1: batched SH operations");
+
+            for (int order = 1; order <= 4; order++) testOrder(ctx, order);
+
+            // Window band scales
+            {
+                float hanning[3], lanczos[3];
+                SH::ComputeWindow(SH::ESHWindow::Hanning, 2, 3.0f, hanning);
+                SH::ComputeWindow(SH::ESHWindow::Lanczos, 2, 3.0f, lanczos);
+                ASSERT(ctx, hanning[0] == 1.0f && std::abs(hanning[1] - 0.75f) < 1e-6f && std::abs(hanning[2] - 0.25f) < 1e-6f,
+                       "Hanning width 3: 1, 0.75, 0.25");
+                ASSERT(ctx, lanczos[0] == 1.0f && std::abs(lanczos[1] - 0.826993f) < 1e-5f && std::abs(lanczos[2] - 0.413497f) < 1e-5f,
+                       "Lanczos width 3: 1, 0.827, 0.413");
+
+                float narrow[5];
+                SH::ComputeWindow(SH::ESHWindow::Hanning, 4, 2.0f, narrow);
+                ASSERT(ctx, narrow[2] == 0.0f && narrow[3] == 0.0f && narrow[4] == 0.0f, "Bands at l >= width are removed");
+            }
+
+            // Deringing: a small bright cap projected to L4 rings below 0
+            {
+                const int size = 32;
+                std::array<std::vector<XMFLOAT4>, 6> cubemap;
+                for (int face = 0; face < 6; face++) {
+                    cubemap[face].resize(size * size);
+                    for (int y = 0; y < size; y++) {
+                        for (int x = 0; x < size; x++) {
+                            float v = SH::CubemapTexelToDirection(face, x, y, size).y > 0.9f ? 10.0f : 0.0f;
+                            cubemap[face][y * size + x] = XMFLOAT4(v, v, v, 1.0f);
+                        }
+                    }
+                }
+                std::array<XMFLOAT3, 25> coeffs;
+                SH::ProjectCubemapToSH_L4(cubemap, size, coeffs);
+
+                SH::CSHBatch raw(4, 1);
+                raw.SetProbe(0, coeffs.data());
+                SH::CSHBatch hanning = raw, lanczos = raw;
+                SH::ApplyWindow(hanning, SH::ESHWindow::Hanning, 5.0f);
+                SH::ApplyWindow(lanczos, SH::ESHWindow::Lanczos, 5.0f, SH::EBatchKernel::Scalar);
+
+                std::mt19937 rng(7);
+                std::vector<XMFLOAT3> dirs = randomDirections(rng, 2048);
+                auto minimum = [&](const SH::CSHBatch& probe) {
+                    std::vector<XMFLOAT3> values(dirs.size());
+                    SH::EvaluateBatch(probe, dirs.data(), dirs.size(), values.data());
+                    float m = 0.0f;
+                    for (const XMFLOAT3& v : values) m = std::min(m, v.x);
+                    return m;
+                };
+                float rawMin = minimum(raw), hanningMin = minimum(hanning), lanczosMin = minimum(lanczos);
+                CFFLog::Info("L4 cap ringing minimum: raw %.4f, Hanning %.4f, Lanczos %.4f", rawMin, hanningMin, lanczosMin);
+                ASSERT(ctx, rawMin < -0.01f, "Unwindowed L4 projection of a small light rings below 0");
+                ASSERT(ctx, hanningMin > rawMin && lanczosMin > rawMin, "Hanning / Lanczos reduce the ringing");
+
+                float bandScale[5];
+                SH::ComputeWindow(SH::ESHWindow::Hanning, 4, 5.0f, bandScale);
+                std::array<XMFLOAT3, 25> windowed;
+                hanning.GetProbe(0, windowed.data());
+                bool scaled = true;
+                for (int i = 0; i < 25; i++) {
+                    float s = bandScale[(int)std::sqrt((float)i)];
+                    scaled &= std::abs(windowed[i].x - coeffs[i].x * s) < 1e-6f;
+                }
+                ASSERT(ctx, scaled, "ApplyWindow scales each coefficient by its band scale");
+            }
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            CFFLog& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Batched SH (4096 L2 probes)");
+            auto now = []() { return std::chrono::high_resolution_clock::now(); };
+            auto msSince = [](std::chrono::high_resolution_clock::time_point start) {
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+            // Calls/sec of one variant: repeat for at least 50 ms
+            auto perSec = [&](auto&& run) {
+                int runs = 0;
+                auto start = now();
+                double ms = 0.0;
+                do {
+                    run();
+                    runs++;
+                    ms = msSince(start);
+                } while (ms < 50.0);
+                return runs * 1000.0 / ms;
+            };
+
+            std::mt19937 rng(42);
+            const size_t probeCount = BENCH_PROBE_COUNT;
+            std::vector<XMFLOAT3> aos = randomCoeffs(rng, probeCount * 9);
+            SH::CSHBatch batch(2, probeCount);
+            for (size_t p = 0; p < probeCount; p++) batch.SetProbe(p, &aos[p * 9]);
+
+            // Evaluate: 4096 probes x 64 directions
+            const size_t dirCount = 64;
+            std::vector<XMFLOAT3> dirs = randomDirections(rng, dirCount);
+            std::vector<XMFLOAT3> values(dirCount * probeCount);
+            double evalAoS = perSec([&]() {
+                for (size_t d = 0; d < dirCount; d++) {
+                    for (size_t p = 0; p < probeCount; p++) {
+                        std::array<XMFLOAT3, 9> c;
+                        std::copy(&aos[p * 9], &aos[p * 9] + 9, c.begin());
+                        values[d * probeCount + p] = SH::EvaluateSH(c, dirs[d]);
+                    }
+                }
+            });
+            double evalScalar = perSec([&]() { SH::EvaluateBatch(batch, dirs.data(), dirCount, values.data(), SH::EBatchKernel::Scalar); });
+            double evalSIMD = perSec([&]() { SH::EvaluateBatch(batch, dirs.data(), dirCount, values.data(), SH::EBatchKernel::SIMD); });
+
+            // Blend: 4096 targets x 8 probes
+            const int k = 8;
+            std::vector<uint32_t> indices(probeCount * k);
+            std::vector<float> weights(probeCount * k);
+            for (size_t i = 0; i < indices.size(); i++) {
+                indices[i] = (uint32_t)(rng() % probeCount);
+                weights[i] = 1.0f / k;
+            }
+            std::vector<XMFLOAT3> blendedAoS(probeCount * 9);
+            SH::CSHBatch blended;
+            double blendAoS = perSec([&]() {
+                // Same loop as CLightProbeManager::BlendProbesForPosition
+                for (size_t t = 0; t < probeCount; t++) {
+                    XMFLOAT3* out = &blendedAoS[t * 9];
+                    for (int band = 0; band < 9; band++) out[band] = XMFLOAT3(0, 0, 0);
+                    for (int j = 0; j < k; j++) {
+                        const XMFLOAT3* src = &aos[indices[t * k + j] * 9];
+                        for (int band = 0; band < 9; band++) {
+                            XMVECTOR v = XMVectorAdd(XMLoadFloat3(&out[band]), XMVectorScale(XMLoadFloat3(&src[band]), weights[t * k + j]));
+                            XMStoreFloat3(&out[band], v);
+                        }
+                    }
+                }
+            });
+            double blendScalar = perSec([&]() { SH::BlendBatch(batch, indices.data(), weights.data(), probeCount, k, blended, SH::EBatchKernel::Scalar); });
+            double blendSIMD = perSec([&]() { SH::BlendBatch(batch, indices.data(), weights.data(), probeCount, k, blended, SH::EBatchKernel::SIMD); });
+
+            // Rotate / window the whole batch
+            XMFLOAT3X3 rotation = rotationAxisAngle(XMFLOAT3(0.0f, 0.6f, 0.8f), 0.7f);
+            SH::CSHBatch rotated;
+            double rotateScalar = perSec([&]() { SH::RotateBatch(batch, rotation, rotated, SH::EBatchKernel::Scalar); });
+            double rotateSIMD = perSec([&]() { SH::RotateBatch(batch, rotation, rotated, SH::EBatchKernel::SIMD); });
+            SH::CSHBatch windowed = batch;
+            double windowScalar = perSec([&]() { SH::ApplyWindow(windowed, SH::ESHWindow::Hanning, 3.0f, SH::EBatchKernel::Scalar); });
+            double windowSIMD = perSec([&]() { SH::ApplyWindow(windowed, SH::ESHWindow::Hanning, 3.0f, SH::EBatchKernel::SIMD); });
+
+            const double evalsPerCall = (double)probeCount * dirCount / 1e6;
+            const double probesPerCall = (double)probeCount / 1e6;
+            log.LogEvent("Throughput (millions per second)");
+            log.LogInfo("%-28s : %10s | %10s | %10s | %6s", "", "per-probe", "batch", "batch SIMD", "gain");
+            log.LogInfo("%-28s : %10.1f | %10.1f | %10.1f | x%5.1f", "Evaluate (probe x dir)",
+                        evalAoS * evalsPerCall, evalScalar * evalsPerCall, evalSIMD * evalsPerCall, evalSIMD / evalAoS);
+            log.LogInfo("%-28s : %10.1f | %10.1f | %10.1f | x%5.1f", "Blend 8 probes (targets)",
+                        blendAoS * probesPerCall, blendScalar * probesPerCall, blendSIMD * probesPerCall, blendSIMD / blendAoS);
+            log.LogInfo("%-28s : %10s | %10.1f | %10.1f | x%5.1f", "Rotate (probes)",
+                        "-", rotateScalar * probesPerCall, rotateSIMD * probesPerCall, rotateSIMD / rotateScalar);
+            log.LogInfo("%-28s : %10s | %10.1f | %10.1f | x%5.1f", "Hanning window (probes)",
+                        "-", windowScalar * probesPerCall, windowSIMD * probesPerCall, windowSIMD / windowScalar);
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, evalSIMD > evalAoS, "Batched evaluation outperforms per-probe EvaluateSH");
+            ASSERT(ctx, blendSIMD > blendAoS, "Batched blending outperforms the per-probe loop");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestSHBatch)
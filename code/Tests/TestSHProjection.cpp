@@ -0,0 +1,335 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/SphericalHarmonics.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <type_traits>
+#include <vector>
+
+using namespace DirectX;
+namespace SH = SphericalHarmonics;
+
+/**
+ * Test: cubemap -> SH projection kernels (weight tables, SIMD, double accumulation)
+ *
+ * Frame 1 (CPU only):
+ *   - Constant cubemap gives c0 = color * sqrt(4π) and ~0 elsewhere (L1 - L4)
+ *   - A cubemap built from known SH coefficients projects back to them (L1 - L4)
+ *   - Table kernels (Scalar, SIMD) match the per-texel reference loop, also for sizes
+ *     that are not a multiple of 4
+ *   - ProjectCubemapToSH (both overloads) and _L1/_L3/_L4 use the new kernel
+ *   - 256² accumulation error against a double-precision sum
+ *   - Weight tables are built once per (size, order) and released on demand
+ *
+ * Frame 5 (benchmark):
+ *   - Probes/sec for 32² - 256² cubemaps, L1 - L4, reference vs table kernels
+ *
+ * Usage:
+ *   forfun.exe --test TestSHProjection
+ *   Results: E:/forfun/debug/TestSHProjection/test.log
+ */
+class CTestSHProjection : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestSHProjection";
+    }
+
+    // Flat cubemap [face * size² + y * size + x] with per-face pointers
+    struct SCubemap {
+        int size = 0;
+        std::vector<XMFLOAT4> pixels;
+        const XMFLOAT4* faces[6] = {};
+
+        explicit SCubemap(int s) : size(s), pixels((size_t)6 * s * s) {
+            for (int face = 0; face < 6; face++) faces[face] = pixels.data() + (size_t)face * s * s;
+        }
+        XMFLOAT4& At(int face, int x, int y) { return pixels[((size_t)face * size + y) * size + x]; }
+    };
+
+    template<int Order>
+    static void evaluateBasis(const XMFLOAT3& dir, std::array<float, SH::CoeffCount(Order)>& basis) {
+        if constexpr (Order == 1) SH::EvaluateBasisL1(dir, basis);
+        else if constexpr (Order == 2) SH::EvaluateBasis(dir, basis);
+        else if constexpr (Order == 3) SH::EvaluateBasisL3(dir, basis);
+        else SH::EvaluateBasisL4(dir, basis);
+    }
+
+    // Per-texel direction / solid angle / basis with float accumulation: the kernel
+    // the weight tables replaced, kept here as the accuracy and speed baseline
+    template<int Order>
+    static void projectReference(const XMFLOAT4* const faces[6], int size,
+                                 std::array<XMFLOAT3, SH::CoeffCount(Order)>& outCoeffs) {
+        constexpr int N = SH::CoeffCount(Order);
+        for (int i = 0; i < N; i++) outCoeffs[i] = XMFLOAT3(0, 0, 0);
+
+        for (int face = 0; face < 6; face++) {
+            for (int y = 0; y < size; y++) {
+                for (int x = 0; x < size; x++) {
+                    float u = ((float)x + 0.5f) / (float)size * 2.0f - 1.0f;
+                    float v = ((float)y + 0.5f) / (float)size * 2.0f - 1.0f;
+                    float t = 1.0f + u * u + v * v;
+                    float texelSize = 2.0f / size;
+                    float solidAngle = texelSize * texelSize / (t * std::sqrt(t));
+
+                    const XMFLOAT4& pixel = faces[face][y * size + x];
+                    std::array<float, N> basis;
+                    evaluateBasis<Order>(SH::CubemapTexelToDirection(face, x, y, size), basis);
+                    for (int i = 0; i < N; i++) {
+                        outCoeffs[i].x += pixel.x * basis[i] * solidAngle;
+                        outCoeffs[i].y += pixel.y * basis[i] * solidAngle;
+                        outCoeffs[i].z += pixel.z * basis[i] * solidAngle;
+                    }
+                }
+            }
+        }
+    }
+
+    // Unclamped Σ c_i * Y_i(dir) per texel
+    template<int Order>
+    static SCubemap cubemapFromSH(int size, const std::array<XMFLOAT3, SH::CoeffCount(Order)>& coeffs) {
+        SCubemap cube(size);
+        for (int face = 0; face < 6; face++) {
+            for (int y = 0; y < size; y++) {
+                for (int x = 0; x < size; x++) {
+                    std::array<float, SH::CoeffCount(Order)> basis;
+                    evaluateBasis<Order>(SH::CubemapTexelToDirection(face, x, y, size), basis);
+                    XMFLOAT4 c(0, 0, 0, 1);
+                    for (int i = 0; i < SH::CoeffCount(Order); i++) {
+                        c.x += coeffs[i].x * basis[i];
+                        c.y += coeffs[i].y * basis[i];
+                        c.z += coeffs[i].z * basis[i];
+                    }
+                    cube.At(face, x, y) = c;
+                }
+            }
+        }
+        return cube;
+    }
+
+    template<int Order>
+    static std::array<XMFLOAT3, SH::CoeffCount(Order)> sampleCoeffs() {
+        std::array<XMFLOAT3, SH::CoeffCount(Order)> coeffs;
+        for (int i = 0; i < SH::CoeffCount(Order); i++) {
+            coeffs[i] = XMFLOAT3(0.5f - 0.07f * i, 0.2f + 0.03f * (i % 5), (i % 2) ? -0.3f : 0.4f);
+        }
+        return coeffs;
+    }
+
+    template<size_t N>
+    static float maxDiff(const std::array<XMFLOAT3, N>& a, const std::array<XMFLOAT3, N>& b) {
+        float d = 0.0f;
+        for (size_t i = 0; i < N; i++) {
+            d = std::max(d, std::abs(a[i].x - b[i].x));
+            d = std::max(d, std::abs(a[i].y - b[i].y));
+            d = std::max(d, std::abs(a[i].z - b[i].z));
+        }
+        return d;
+    }
+
+    template<int Order>
+    static void testOrder(CTestContext& ctx) {
+        constexpr int N = SH::CoeffCount(Order);
+        char msg[128];
+
+        // Constant color: only the DC term, c0 = color * Y0 * 4π (midpoint dω: ~3e-4 relative at 32²)
+        SCubemap constant(32);
+        for (XMFLOAT4& p : constant.pixels) p = XMFLOAT4(1.0f, 0.5f, 2.0f, 1.0f);
+        std::array<XMFLOAT3, N> flat;
+        SH::ProjectCubemap<Order>(constant.faces, constant.size, flat);
+        const float c0 = 0.282095f * 4.0f * 3.14159265f;
+        snprintf(msg, sizeof(msg), "L%d constant cubemap: c0 = color * sqrt(4pi) (%.4f vs %.4f)", Order, flat[0].x, c0);
+        ASSERT(ctx, std::abs(flat[0].x / c0 - 1.0f) < 1e-3f && std::abs(flat[0].y / (0.5f * c0) - 1.0f) < 1e-3f &&
+                    std::abs(flat[0].z / (2.0f * c0) - 1.0f) < 1e-3f, msg);
+        float higher = 0.0f;
+        for (int i = 1; i < N; i++) higher = std::max({higher, std::abs(flat[i].x), std::abs(flat[i].y), std::abs(flat[i].z)});
+        // Band 4 has a cube-symmetric term (x⁴ + y⁴ + z⁴) the texel grid aliases into
+        snprintf(msg, sizeof(msg), "L%d constant cubemap: higher bands ~0 (%.2e)", Order, higher);
+        ASSERT(ctx, higher < (Order == 4 ? 5e-3f : 1e-4f), msg);
+
+        // Known coefficients project back (discretization error only)
+        const std::array<XMFLOAT3, N> expected = sampleCoeffs<Order>();
+        SCubemap cube = cubemapFromSH<Order>(64, expected);
+        std::array<XMFLOAT3, N> reference, scalar, simd;
+        projectReference<Order>(cube.faces, cube.size, reference);
+        SH::ProjectCubemap<Order>(cube.faces, cube.size, scalar, SH::EProjectKernel::Scalar);
+        SH::ProjectCubemap<Order>(cube.faces, cube.size, simd, SH::EProjectKernel::SIMD);
+        snprintf(msg, sizeof(msg), "L%d known coefficients recovered (%.2e)", Order, maxDiff(simd, expected));
+        ASSERT(ctx, maxDiff(simd, expected) < 5e-3f, msg);
+        snprintf(msg, sizeof(msg), "L%d SIMD matches reference (%.2e)", Order, maxDiff(simd, reference));
+        ASSERT(ctx, maxDiff(simd, reference) < 1e-4f, msg);
+        snprintf(msg, sizeof(msg), "L%d SIMD matches scalar table kernel (%.2e)", Order, maxDiff(simd, scalar));
+        ASSERT(ctx, maxDiff(simd, scalar) < 1e-5f, msg);
+
+        // Row tail (size % 4 != 0) goes through the scalar loop
+        SCubemap odd = cubemapFromSH<Order>(6, expected);
+        projectReference<Order>(odd.faces, odd.size, reference);
+        SH::ProjectCubemap<Order>(odd.faces, odd.size, simd, SH::EProjectKernel::SIMD);
+        snprintf(msg, sizeof(msg), "L%d size 6 (row tail) matches reference", Order);
+        ASSERT(ctx, maxDiff(simd, reference) < 1e-5f, msg);
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestSHProjection ===");
+            CFFLog::Info("Frame 1: projection kernels");
+            SH::ReleaseProjectionTables();
+
+            testOrder<1>(ctx);
+            testOrder<2>(ctx);
+            testOrder<3>(ctx);
+            testOrder<4>(ctx);
+
+            // Public entry points route to the table kernel
+            {
+                const auto expected2 = sampleCoeffs<2>();
+                SCubemap cube = cubemapFromSH<2>(16, expected2);
+                std::array<std::vector<XMFLOAT4>, 6> faces;
+                for (int face = 0; face < 6; face++) faces[face].assign(cube.faces[face], cube.faces[face] + 16 * 16);
+
+                std::array<XMFLOAT3, 9> kernel, fromFaces, fromFlat;
+                SH::ProjectCubemap<2>(cube.faces, 16, kernel);
+                SH::ProjectCubemapToSH(faces, 16, fromFaces);
+                SH::ProjectCubemapToSH(cube.pixels.data(), 16, fromFlat);
+                ASSERT(ctx, maxDiff(kernel, fromFaces) == 0.0f, "ProjectCubemapToSH (faces) uses the kernel");
+                ASSERT(ctx, maxDiff(kernel, fromFlat) == 0.0f, "ProjectCubemapToSH (flat) uses the kernel");
+
+                std::array<XMFLOAT3, 4> l1Kernel, l1;
+                std::array<XMFLOAT3, 16> l3Kernel, l3;
+                std::array<XMFLOAT3, 25> l4Kernel, l4;
+                SH::ProjectCubemap<1>(cube.faces, 16, l1Kernel);
+                SH::ProjectCubemap<3>(cube.faces, 16, l3Kernel);
+                SH::ProjectCubemap<4>(cube.faces, 16, l4Kernel);
+                SH::ProjectCubemapToSH_L1(faces, 16, l1);
+                SH::ProjectCubemapToSH_L3(faces, 16, l3);
+                SH::ProjectCubemapToSH_L4(faces, 16, l4);
+                ASSERT(ctx, maxDiff(l1Kernel, l1) == 0.0f && maxDiff(l3Kernel, l3) == 0.0f && maxDiff(l4Kernel, l4) == 0.0f,
+                       "ProjectCubemapToSH_L1/_L3/_L4 use the kernel");
+            }
+
+            // Accumulation: 393k texels against a double sum of the same terms
+            {
+                const int size = 256;
+                SCubemap cube(size);
+                for (int face = 0; face < 6; face++) {
+                    for (int y = 0; y < size; y++) {
+                        for (int x = 0; x < size; x++) {
+                            float value = 100.0f + (float)((x * 7 + y * 13 + face * 31) % 17);
+                            cube.At(face, x, y) = XMFLOAT4(value, value, value, 1.0f);
+                        }
+                    }
+                }
+                double exact = 0.0;
+                for (int face = 0; face < 6; face++) {
+                    for (int y = 0; y < size; y++) {
+                        for (int x = 0; x < size; x++) {
+                            double u = (x + 0.5) / size * 2.0 - 1.0;
+                            double v = (y + 0.5) / size * 2.0 - 1.0;
+                            double t = 1.0 + u * u + v * v;
+                            double dOmega = (2.0 / size) * (2.0 / size) / (t * std::sqrt(t));
+                            exact += cube.At(face, x, y).x * 0.282095 * dOmega;
+                        }
+                    }
+                }
+                std::array<XMFLOAT3, 4> reference, simd;
+                projectReference<1>(cube.faces, size, reference);
+                SH::ProjectCubemap<1>(cube.faces, size, simd, SH::EProjectKernel::SIMD);
+                double referenceError = std::abs(reference[0].x - exact) / exact;
+                double simdError = std::abs(simd[0].x - exact) / exact;
+                CFFLog::Info("256^2 c0 relative error: reference %.2e, SIMD %.2e", referenceError, simdError);
+                ASSERT(ctx, simdError < 1e-6, "256^2 accumulation stays within 1e-6 of the double sum");
+                ASSERT(ctx, simdError <= referenceError, "Row/double accumulation is at least as precise as float");
+            }
+
+            // Tables: one per (size, order), reused, released on demand
+            {
+                SH::ReleaseProjectionTables();
+                ASSERT_EQUAL(ctx, (int)SH::GetProjectionTableBytes(), 0, "No tables after release");
+
+                SCubemap cube(32);
+                std::array<XMFLOAT3, 9> coeffs;
+                SH::ProjectCubemap<2>(cube.faces, 32, coeffs);
+                const size_t bytes = SH::GetProjectionTableBytes();
+                ASSERT_EQUAL(ctx, (int)bytes, (int)(9 * 6 * 32 * 32 * sizeof(float)), "L2 32^2 table: 9 rows of 6 * 32^2 weights");
+                SH::ProjectCubemap<2>(cube.faces, 32, coeffs);
+                ASSERT_EQUAL(ctx, (int)SH::GetProjectionTableBytes(), (int)bytes, "Second projection reuses the table");
+                SH::ReleaseProjectionTables();
+            }
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            CFFLog& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "SH projection (probes/sec)");
+            auto now = []() { return std::chrono::high_resolution_clock::now(); };
+            auto msSince = [](std::chrono::high_resolution_clock::time_point start) {
+                return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            };
+
+            // Probes/sec of one kernel: repeat for at least 100 ms
+            auto probesPerSec = [&](auto&& project) {
+                int runs = 0;
+                auto start = now();
+                double ms = 0.0;
+                do {
+                    project();
+                    runs++;
+                    ms = msSince(start);
+                } while (ms < 100.0);
+                return runs * 1000.0 / ms;
+            };
+
+            double speedup256L2 = 0.0;
+            auto benchOrder = [&](auto orderTag) {
+                constexpr int Order = decltype(orderTag)::value;
+                std::array<XMFLOAT3, SH::CoeffCount(Order)> coeffs;
+                for (int size : {32, 64, 128, 256}) {
+                    SCubemap cube = cubemapFromSH<Order>(size, sampleCoeffs<Order>());
+                    auto start = now();
+                    SH::ProjectCubemap<Order>(cube.faces, size, coeffs);
+                    double firstMs = msSince(start);
+
+                    double reference = probesPerSec([&]() { projectReference<Order>(cube.faces, size, coeffs); });
+                    double scalar = probesPerSec([&]() { SH::ProjectCubemap<Order>(cube.faces, size, coeffs, SH::EProjectKernel::Scalar); });
+                    double simd = probesPerSec([&]() { SH::ProjectCubemap<Order>(cube.faces, size, coeffs, SH::EProjectKernel::SIMD); });
+                    log.LogInfo("L%d %4d^2 : %10.1f | %10.1f | %10.1f | x%5.1f | %8.2f", Order, size,
+                                reference, scalar, simd, simd / reference, firstMs);
+                    if (Order == 2 && size == 256) speedup256L2 = simd / reference;
+                }
+            };
+
+            log.LogEvent("Probes/sec (table build included in first-call ms)");
+            log.LogInfo("%-10s : %10s | %10s | %10s | %6s | %8s", "", "reference", "scalar", "SIMD", "gain", "1st (ms)");
+            benchOrder(std::integral_constant<int, 1>());
+            benchOrder(std::integral_constant<int, 2>());
+            benchOrder(std::integral_constant<int, 3>());
+            benchOrder(std::integral_constant<int, 4>());
+            log.LogInfo("Tables cached: %.1f MB", SH::GetProjectionTableBytes() / (1024.0 * 1024.0));
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+            SH::ReleaseProjectionTables();
+
+            ASSERT(ctx, speedup256L2 > 1.0, "L2 256^2: table kernel outperforms the reference");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestSHProjection)
@@ -0,0 +1,352 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Engine/World.h"
+#include "Engine/GameObject.h"
+#include "Engine/SpatialIndex.h"
+#include "Engine/Components/Transform.h"
+#include "Engine/Components/MeshRenderer.h"
+#include "Engine/Components/PointLight.h"
+#include "Engine/Components/SpotLight.h"
+#include "Engine/Components/LightProbe.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+
+/**
+ * Test: Scene spatial index (dynamic AABB tree over CWorld)
+ *
+ * Frame 1 (correctness, private CWorld):
+ *   - AABB / sphere / frustum queries match a brute-force scan of GetComponent
+ *   - Closest-hit ray cast matches brute force (mesh bounds)
+ *   - Moving one object refreshes only that entry; small moves stay inside the fat AABB
+ *   - Destroy / AddComponent re-sync the index, tree stays valid
+ *
+ * Frame 5 (benchmark, 10k objects):
+ *   - Linear GetComponent scans vs tree queries (AABB, sphere, frustum, ray)
+ *   - Incremental Update() with 1% of the objects moving
+ *
+ * Usage:
+ *   forfun.exe --test TestSpatialIndex
+ *   Results: E:/forfun/debug/TestSpatialIndex/test.log
+ */
+class CTestSpatialIndex : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestSpatialIndex";
+    }
+
+    static const int BENCH_OBJECT_COUNT = 10000;
+    static const int GRID_SIZE = 100;
+    static constexpr float GRID_SPACING = 4.0f;
+
+    // Deterministic layout: point lights, spot lights and light probes on a grid
+    static CGameObject* createObject(CWorld& world, int index) {
+        CGameObject* obj = world.Create("Spatial_" + std::to_string(index));
+        auto* transform = obj->AddComponent<STransform>();
+        transform->position = {(float)(index % GRID_SIZE) * GRID_SPACING,
+                               (float)((index * 7) % 5),
+                               (float)(index / GRID_SIZE) * GRID_SPACING};
+        switch (index % 3) {
+        case 0: obj->AddComponent<SPointLight>()->range = 1.0f + (float)(index % 4); break;
+        case 1: obj->AddComponent<SSpotLight>()->range = 2.0f + (float)(index % 3); break;
+        default: obj->AddComponent<SLightProbe>()->radius = 1.5f; break;
+        }
+        return obj;
+    }
+
+    static float componentRange(CGameObject* obj, uint32_t& category) {
+        if (auto* p = obj->GetComponent<SPointLight>()) { category = SpatialCategory_PointLight; return p->range; }
+        if (auto* s = obj->GetComponent<SSpotLight>()) { category = SpatialCategory_SpotLight; return s->range; }
+        if (auto* l = obj->GetComponent<SLightProbe>()) { category = SpatialCategory_LightProbe; return l->radius; }
+        category = 0;
+        return 0.0f;
+    }
+
+    static SAABB sphereBox(const XMFLOAT3& c, float r) {
+        SAABB b;
+        b.min = {c.x - r, c.y - r, c.z - r};
+        b.max = {c.x + r, c.y + r, c.z + r};
+        return b;
+    }
+
+    // Brute force: world indices of objects whose sphere bounds pass the test
+    template<typename Pred>
+    static std::set<uint32_t> bruteForce(CWorld& world, uint32_t mask, Pred&& pred) {
+        std::set<uint32_t> result;
+        const auto& objects = world.Objects();
+        for (size_t i = 0; i < objects.size(); i++) {
+            auto* transform = objects[i]->GetComponent<STransform>();
+            uint32_t category;
+            float range = componentRange(objects[i].get(), category);
+            if (!transform || !(category & mask)) continue;
+            if (pred(sphereBox(transform->position, range))) result.insert((uint32_t)i);
+        }
+        return result;
+    }
+
+    static SFrustumPlanes testFrustum() {
+        XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(20, 10, -10, 1), XMVectorSet(40, 0, 40, 1), XMVectorSet(0, 1, 0, 0));
+        XMMATRIX proj = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 80.0f);
+        return SFrustumPlanes::FromViewProj(view * proj);
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestSpatialIndex ===");
+            CFFLog::Info("Frame 1: Correctness checks");
+
+            CWorld world;
+            for (int i = 0; i < 300; i++) {
+                createObject(world, i);
+            }
+
+            CSceneSpatialIndex index;
+            int refreshed = index.Update(world);
+            ASSERT_EQUAL(ctx, (int)index.GetEntryCount(), 300, "One entry per light / probe");
+            ASSERT_EQUAL(ctx, refreshed, 300, "First Update computes every entry");
+            ASSERT(ctx, index.GetTree().Validate(), "Tree valid after build");
+
+            auto collect = [](auto&& query) {
+                std::set<uint32_t> result;
+                query([&result](const SSpatialEntry& e) { result.insert(e.worldIndex); return true; });
+                return result;
+            };
+
+            // AABB
+            SAABB box;
+            box.min = {10.0f, 0.0f, 10.0f};
+            box.max = {30.0f, 2.0f, 24.0f};
+            auto treeBox = collect([&](auto&& cb) { index.QueryAABB(box, SpatialCategory_All, cb); });
+            auto refBox = bruteForce(world, SpatialCategory_All, [&](const SAABB& b) { return b.Overlaps(box); });
+            ASSERT(ctx, !refBox.empty() && treeBox == refBox, "AABB query matches brute force");
+
+            // Sphere, lights only
+            XMFLOAT3 center = {50.0f, 1.0f, 20.0f};
+            auto treeSphere = collect([&](auto&& cb) { index.QuerySphere(center, 9.0f, SpatialCategory_Lights, cb); });
+            auto refSphere = bruteForce(world, SpatialCategory_Lights, [&](const SAABB& b) { return b.OverlapsSphere(center, 9.0f); });
+            ASSERT(ctx, !refSphere.empty() && treeSphere == refSphere, "Sphere query matches brute force");
+
+            // Frustum
+            SFrustumPlanes frustum = testFrustum();
+            auto treeFrustum = collect([&](auto&& cb) { index.QueryFrustum(frustum, SpatialCategory_All, cb); });
+            auto refFrustum = bruteForce(world, SpatialCategory_All, [&](const SAABB& b) { return b.IntersectsFrustum(frustum); });
+            ASSERT(ctx, !refFrustum.empty() && treeFrustum == refFrustum, "Frustum query matches brute force");
+
+            // Early out
+            int visited = 0;
+            index.QueryAABB(box, SpatialCategory_All, [&visited](const SSpatialEntry&) { visited++; return false; });
+            ASSERT_EQUAL(ctx, visited, 1, "Returning false stops the query");
+
+            // Incremental update
+            auto* movedTransform = world.Objects()[42]->GetComponent<STransform>();
+            movedTransform->position.x += 0.01f;
+            refreshed = index.Update(world);
+            ASSERT_EQUAL(ctx, refreshed, 1, "Only the moved entry is refreshed");
+            ASSERT_EQUAL(ctx, index.GetLastReinsertedCount(), 0, "Small move stays inside the fat AABB");
+
+            movedTransform->position = {500.0f, 0.0f, 500.0f};
+            index.Update(world);
+            ASSERT_EQUAL(ctx, index.GetLastReinsertedCount(), 1, "Large move re-inserts the leaf");
+            int found = -1;
+            index.QuerySphere(movedTransform->position, 0.5f, SpatialCategory_All,
+                              [&found](const SSpatialEntry& e) { found = (int)e.worldIndex; return true; });
+            ASSERT_EQUAL(ctx, found, 42, "Moved entry found at its new position");
+
+            ASSERT_EQUAL(ctx, index.Update(world), 0, "Unchanged world refreshes nothing");
+
+            // Ray cast against mesh bounds (the index only reports meshes with uploaded bounds)
+            CGameObject* nearMesh = world.Create("NearMesh");
+            nearMesh->AddComponent<STransform>()->position = {0.0f, 50.0f, 10.0f};
+            nearMesh->AddComponent<SMeshRenderer>()->path = "mesh/cube.obj";
+            CGameObject* farMesh = world.Create("FarMesh");
+            farMesh->AddComponent<STransform>()->position = {0.0f, 50.0f, 20.0f};
+            farMesh->AddComponent<SMeshRenderer>()->path = "mesh/cube.obj";
+            nearMesh->GetComponent<SMeshRenderer>()->EnsureUploaded();
+            farMesh->GetComponent<SMeshRenderer>()->EnsureUploaded();
+
+            index.Update(world);
+            ASSERT_EQUAL(ctx, (int)index.GetEntryCount(), 302, "AddComponent re-syncs the index");
+            float distance = 0.0f;
+            const SSpatialEntry* hit = index.RayCast({0.0f, 50.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, FLT_MAX,
+                                                     SpatialCategory_Mesh, &distance);
+            ASSERT(ctx, hit && hit->obj == nearMesh, "Ray hits the closest mesh");
+            if (hit) {
+                ASSERT_IN_RANGE(ctx, distance, 8.0f, 10.0f, "Hit distance at the near face");
+            }
+            ASSERT(ctx, !index.RayCast({0.0f, 50.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, FLT_MAX, SpatialCategory_Mesh),
+                   "Ray pointing away misses");
+            ASSERT(ctx, !index.RayCast({0.0f, 50.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, FLT_MAX, SpatialCategory_Lights),
+                   "Category mask filters ray hits");
+
+            // Destroy
+            world.Destroy(0);
+            index.Update(world);
+            ASSERT_EQUAL(ctx, (int)index.GetEntryCount(), 301, "Destroy re-syncs the index");
+            ASSERT_EQUAL(ctx, index.GetTree().GetProxyCount(), 301, "Destroyed entry leaves the tree");
+            ASSERT(ctx, index.GetTree().Validate(), "Tree valid after re-sync");
+            treeBox = collect([&](auto&& cb) { index.QueryAABB(box, SpatialCategory_All, cb); });
+            refBox = bruteForce(world, SpatialCategory_All, [&](const SAABB& b) { return b.Overlaps(box); });
+            ASSERT(ctx, treeBox == refBox, "World indices remapped after Destroy");
+
+            CFFLog::Info("✓ Frame 1: Correctness checks passed");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Scene Spatial Index");
+
+            CWorld world;
+            for (int i = 0; i < BENCH_OBJECT_COUNT; i++) {
+                createObject(world, i);
+            }
+
+            CSceneSpatialIndex index;
+            auto b0 = std::chrono::high_resolution_clock::now();
+            index.Update(world);
+            auto b1 = std::chrono::high_resolution_clock::now();
+            double buildMs = std::chrono::duration<double, std::milli>(b1 - b0).count();
+
+            const int iterations = 200;
+            auto timeMs = [](auto&& fn) {
+                auto t0 = std::chrono::high_resolution_clock::now();
+                for (int it = 0; it < iterations; it++) fn(it);
+                auto t1 = std::chrono::high_resolution_clock::now();
+                return std::chrono::duration<double, std::milli>(t1 - t0).count() / iterations;
+            };
+
+            // Query shapes move across the grid so results are not cached
+            const float extent = GRID_SIZE * GRID_SPACING;
+            auto queryBox = [extent](int it) {
+                float x = std::fmod((float)it * 13.7f, extent - 20.0f);
+                float z = std::fmod((float)it * 29.3f, extent - 20.0f);
+                SAABB b;
+                b.min = {x, 0.0f, z};
+                b.max = {x + 20.0f, 4.0f, z + 20.0f};
+                return b;
+            };
+            SFrustumPlanes frustum = testFrustum();
+
+            volatile size_t sink = 0;
+            auto linearQuery = [&](auto&& pred) {
+                size_t count = 0;
+                for (auto& objPtr : world.Objects()) {
+                    auto* transform = objPtr->GetComponent<STransform>();
+                    uint32_t category;
+                    float range = componentRange(objPtr.get(), category);
+                    if (transform && category && pred(sphereBox(transform->position, range))) count++;
+                }
+                return count;
+            };
+            auto countQuery = [](auto&& query) {
+                size_t count = 0;
+                query([&count](const SSpatialEntry&) { count++; return true; });
+                return count;
+            };
+
+            double linearAabb = timeMs([&](int it) {
+                SAABB b = queryBox(it);
+                sink = sink + linearQuery([&](const SAABB& e) { return e.Overlaps(b); });
+            });
+            double treeAabb = timeMs([&](int it) {
+                SAABB b = queryBox(it);
+                sink = sink + countQuery([&](auto&& cb) { index.QueryAABB(b, SpatialCategory_All, cb); });
+            });
+
+            double linearSphere = timeMs([&](int it) {
+                SAABB b = queryBox(it);
+                sink = sink + linearQuery([&](const SAABB& e) { return e.OverlapsSphere(b.min, 10.0f); });
+            });
+            double treeSphere = timeMs([&](int it) {
+                SAABB b = queryBox(it);
+                sink = sink + countQuery([&](auto&& cb) { index.QuerySphere(b.min, 10.0f, SpatialCategory_All, cb); });
+            });
+
+            double linearFrustum = timeMs([&](int) {
+                sink = sink + linearQuery([&](const SAABB& e) { return e.IntersectsFrustum(frustum); });
+            });
+            double treeFrustum = timeMs([&](int) {
+                sink = sink + countQuery([&](auto&& cb) { index.QueryFrustum(frustum, SpatialCategory_All, cb); });
+            });
+
+            // Ray: closest hit along +Z through a grid row
+            double linearRay = timeMs([&](int it) {
+                float x = (float)(it % GRID_SIZE) * GRID_SPACING;
+                float best = FLT_MAX;
+                for (auto& objPtr : world.Objects()) {
+                    auto* transform = objPtr->GetComponent<STransform>();
+                    uint32_t category;
+                    float range = componentRange(objPtr.get(), category);
+                    if (!transform || !category) continue;
+                    SAABB b = sphereBox(transform->position, range);
+                    if (x >= b.min.x && x <= b.max.x && 1.0f >= b.min.y && 1.0f <= b.max.y && b.max.z >= -1.0f) {
+                        best = std::min(best, std::max(b.min.z + 1.0f, 0.0f));
+                    }
+                }
+                sink = sink + (size_t)best;
+            });
+            double treeRay = timeMs([&](int it) {
+                float x = (float)(it % GRID_SIZE) * GRID_SPACING;
+                float distance = 0.0f;
+                index.RayCast({x, 1.0f, -1.0f}, {0.0f, 0.0f, 1.0f}, FLT_MAX, SpatialCategory_All, &distance);
+                sink = sink + (size_t)distance;
+            });
+
+            // Incremental update, 1% of the objects moving every frame
+            std::vector<STransform*> movers;
+            for (int i = 0; i < BENCH_OBJECT_COUNT; i += 100) {
+                movers.push_back(world.Objects()[i]->GetComponent<STransform>());
+            }
+            int reinserted = 0;
+            double updateMs = timeMs([&](int it) {
+                for (STransform* t : movers) {
+                    t->position.y = (float)(it % 50) * 0.2f;
+                }
+                index.Update(world);
+                reinserted += index.GetLastReinsertedCount();
+            });
+
+            auto speedup = [](double before, double after) { return after > 0.0 ? before / after : 0.0; };
+            log.LogEvent("Query CPU time");
+            log.LogInfo("%d objects, tree height %d, build %.3f ms", BENCH_OBJECT_COUNT,
+                        index.GetTree().GetHeight(), buildMs);
+            log.LogInfo("AABB    : linear %7.4f ms | tree %7.4f ms | speedup %.1fx", linearAabb, treeAabb, speedup(linearAabb, treeAabb));
+            log.LogInfo("Sphere  : linear %7.4f ms | tree %7.4f ms | speedup %.1fx", linearSphere, treeSphere, speedup(linearSphere, treeSphere));
+            log.LogInfo("Frustum : linear %7.4f ms | tree %7.4f ms | speedup %.1fx", linearFrustum, treeFrustum, speedup(linearFrustum, treeFrustum));
+            log.LogInfo("Ray     : linear %7.4f ms | tree %7.4f ms | speedup %.1fx", linearRay, treeRay, speedup(linearRay, treeRay));
+            log.LogEvent("Incremental update");
+            log.LogInfo("1%% moving: %.4f ms per Update, %.1f re-inserts per frame", updateMs,
+                        (double)reinserted / iterations);
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, index.GetTree().Validate(), "Tree valid after benchmark updates");
+            ASSERT(ctx, treeAabb < linearAabb, "Tree AABB query is faster than a linear scan");
+            ASSERT(ctx, treeRay < linearRay, "Tree ray cast is faster than a linear scan");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestSpatialIndex)
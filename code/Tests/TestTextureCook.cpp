@@ -0,0 +1,479 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/TextureCooker.h"
+#include "Core/TextureManager.h"
+#include "Core/PathManager.h"
+#include "Core/Exporter/KTXExporter.h"
+#include "Core/Loader/KTXLoader.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/DerivedDataCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * Test: texture cooking (CPU mips + BC1/BC3/BC5/BC7, cooked texture cache)
+ *
+ * Frame 1 (CPU only):
+ *   - Encode / decode round trip per format on synthetic images, PSNR bounds
+ *     (BC7 beats BC1 on color, BC5 normals within a few degrees)
+ *   - Flat blocks are exact where the format can represent them
+ *   - Mip chain: sRGB averaging in linear space, normal maps stay unit length,
+ *     sizes down to 1x1, RGBA8 fallback for sizes that are not multiples of 4
+ *   - Format selection (opaque / alpha / normal map detection)
+ *   - Parallel and serial cooks are byte-identical
+ *   - KTX2 export and the cooked DDC payload round trip keep format and mips
+ *   - Cook keys depend on the color space and options, not on the path
+ *
+ * Frame 5 (benchmark):
+ *   - 2048x2048 encode per format, serial vs job system (MPix/s, PSNR)
+ *   - Barrel textures through CTextureManager: RGBA8 + GPU mips vs first
+ *     (cooking) load vs cooked load; time and GPU memory
+ *
+ * Usage:
+ *   forfun.exe --test TestTextureCook
+ *   Results: E:/forfun/debug/TestTextureCook/test.log
+ */
+class CTestTextureCook : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestTextureCook";
+    }
+
+    // Smooth gradients + detail + noise, alpha ramp when withAlpha
+    static SDecodedTexture makePhoto(uint32_t width, uint32_t height, bool srgb, bool withAlpha) {
+        SDecodedTexture image;
+        image.width = width;
+        image.height = height;
+        image.format = srgb ? RHI::ETextureFormat::R8G8B8A8_UNORM_SRGB : RHI::ETextureFormat::R8G8B8A8_UNORM;
+        image.generateMips = true;
+        image.mips.assign(1, SDecodedTexture::SMip{0, width * 4});
+        image.data.resize((size_t)width * height * 4);
+        uint32_t seed = 12345;
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                float u = (float)x / width, v = (float)y / height;
+                seed = seed * 1664525u + 1013904223u;
+                float noise = ((seed >> 24) / 255.0f - 0.5f) * 0.04f;
+                float detail = 0.08f * std::sin(u * 60.0f) * std::cos(v * 45.0f);
+                float rgb[3] = {0.2f + 0.6f * u + detail, 0.7f - 0.5f * v + noise, 0.5f + 0.3f * std::sin(6.0f * (u + v))};
+                uint8_t* p = &image.data[((size_t)y * width + x) * 4];
+                for (int c = 0; c < 3; c++) {
+                    p[c] = (uint8_t)std::lround(std::fmin(std::fmax(rgb[c], 0.0f), 1.0f) * 255.0f);
+                }
+                p[3] = withAlpha ? (uint8_t)(255.0f * u) : 255;
+            }
+        }
+        return image;
+    }
+
+    // Tangent-space normals of a bumpy height field, linear
+    static SDecodedTexture makeNormalMap(uint32_t width, uint32_t height) {
+        SDecodedTexture image = makePhoto(width, height, false, false);
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                float u = (float)x / width * 6.2831853f, v = (float)y / height * 6.2831853f;
+                float dx = 0.6f * std::cos(4.0f * u) * std::cos(3.0f * v);
+                float dy = -0.45f * std::sin(4.0f * u) * std::sin(3.0f * v);
+                float len = std::sqrt(dx * dx + dy * dy + 1.0f);
+                float n[3] = {-dx / len, -dy / len, 1.0f / len};
+                uint8_t* p = &image.data[((size_t)y * width + x) * 4];
+                for (int c = 0; c < 3; c++) {
+                    p[c] = (uint8_t)std::lround((n[c] * 0.5f + 0.5f) * 255.0f);
+                }
+            }
+        }
+        return image;
+    }
+
+    // PSNR over the first `channels` channels of two tightly packed RGBA8 images
+    static double psnr(const uint8_t* a, const uint8_t* b, size_t pixels, int channels) {
+        double sum = 0.0;
+        for (size_t i = 0; i < pixels; i++) {
+            for (int c = 0; c < channels; c++) {
+                double d = (double)a[i * 4 + c] - (double)b[i * 4 + c];
+                sum += d * d;
+            }
+        }
+        double mse = sum / ((double)pixels * channels);
+        return mse <= 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+    // Mean angle (degrees) between stored normals and BC5 XY with Z rebuilt
+    static double meanNormalErrorDegrees(const uint8_t* reference, const uint8_t* decoded, size_t pixels) {
+        double sum = 0.0;
+        for (size_t i = 0; i < pixels; i++) {
+            float a[3], b[3];
+            for (int c = 0; c < 3; c++) a[c] = reference[i * 4 + c] / 127.5f - 1.0f;
+            b[0] = decoded[i * 4 + 0] / 127.5f - 1.0f;
+            b[1] = decoded[i * 4 + 1] / 127.5f - 1.0f;
+            b[2] = std::sqrt(std::fmax(0.0f, 1.0f - b[0] * b[0] - b[1] * b[1]));
+            float la = std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+            float lb = std::sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+            float d = (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]) / (la * lb);
+            sum += std::acos(std::fmin(1.0f, std::fmax(-1.0f, d))) * 57.29578;
+        }
+        return sum / (double)pixels;
+    }
+
+    static std::vector<uint8_t> roundTrip(ETextureCookFormat format, const SDecodedTexture& image, bool parallel = true) {
+        std::vector<uint8_t> blocks((size_t)((image.width + 3) / 4) * ((image.height + 3) / 4) * GetCookBlockBytes(format));
+        EncodeBlocks(format, image.data.data(), image.width, image.height, image.width * 4, blocks.data(), parallel);
+        std::vector<uint8_t> decoded((size_t)image.width * image.height * 4);
+        DecodeBlocks(format, blocks.data(), image.width, image.height, decoded.data());
+        return decoded;
+    }
+
+    static double millisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestTextureCook ===");
+            CFFLog::Info("Frame 1: Encoder / mip / cache checks");
+
+            // --- Round trip quality ---
+            const SDecodedTexture photo = makePhoto(256, 256, true, false);
+            const SDecodedTexture alphaPhoto = makePhoto(256, 256, true, true);
+            const SDecodedTexture normals = makeNormalMap(256, 256);
+            const size_t pixels = 256 * 256;
+
+            double bc1 = psnr(photo.data.data(), roundTrip(ETextureCookFormat::BC1, photo).data(), pixels, 3);
+            double bc7 = psnr(photo.data.data(), roundTrip(ETextureCookFormat::BC7, photo).data(), pixels, 3);
+            std::vector<uint8_t> bc3Decoded = roundTrip(ETextureCookFormat::BC3, alphaPhoto);
+            double bc3 = psnr(alphaPhoto.data.data(), bc3Decoded.data(), pixels, 3);
+            double bc3Alpha = 0.0;
+            {
+                std::vector<uint8_t> a(pixels * 4, 0), b(pixels * 4, 0);
+                for (size_t i = 0; i < pixels; i++) {
+                    a[i * 4] = alphaPhoto.data[i * 4 + 3];
+                    b[i * 4] = bc3Decoded[i * 4 + 3];
+                }
+                bc3Alpha = psnr(a.data(), b.data(), pixels, 1);
+            }
+            std::vector<uint8_t> bc5Decoded = roundTrip(ETextureCookFormat::BC5, normals);
+            double bc5 = psnr(normals.data.data(), bc5Decoded.data(), pixels, 2);
+            double bc5Degrees = meanNormalErrorDegrees(normals.data.data(), bc5Decoded.data(), pixels);
+            CFFLog::Info("PSNR: BC1 %.2f dB, BC7 %.2f dB, BC3 %.2f dB (alpha %.2f dB), BC5 %.2f dB (%.3f deg)",
+                         bc1, bc7, bc3, bc3Alpha, bc5, bc5Degrees);
+
+            ASSERT(ctx, bc1 > 34.0, "BC1 PSNR above 34 dB on the synthetic photo");
+            ASSERT(ctx, bc7 > bc1 + 2.0, "BC7 at least 2 dB better than BC1");
+            ASSERT(ctx, bc3 > 34.0, "BC3 color PSNR above 34 dB");
+            ASSERT(ctx, bc3Alpha > 45.0, "BC3 alpha ramp PSNR above 45 dB");
+            ASSERT(ctx, bc5 > 40.0, "BC5 XY PSNR above 40 dB");
+            ASSERT(ctx, bc5Degrees < 1.0, "BC5 normals within 1 degree on average");
+
+            // --- Flat blocks ---
+            {
+                SDecodedTexture flat = makePhoto(8, 8, false, false);
+                for (size_t i = 0; i < flat.data.size(); i += 4) {
+                    flat.data[i + 0] = 77; flat.data[i + 1] = 201; flat.data[i + 2] = 3; flat.data[i + 3] = 141;
+                }
+                // Mode 6 shares the p-bit across channels: exact when all channels have the same parity
+                std::vector<uint8_t> bc7Flat = roundTrip(ETextureCookFormat::BC7, flat);
+                ASSERT(ctx, bc7Flat == flat.data, "BC7 flat RGBA block is exact");
+                std::vector<uint8_t> bc5Flat = roundTrip(ETextureCookFormat::BC5, flat);
+                ASSERT(ctx, bc5Flat[0] == 77 && bc5Flat[1] == 201, "BC5 flat block is exact");
+                std::vector<uint8_t> bc3Flat = roundTrip(ETextureCookFormat::BC3, flat);
+                ASSERT(ctx, bc3Flat[3] == 141, "BC3 flat alpha is exact");
+            }
+
+            // --- Partial blocks: 6x6 encodes like the 8x8 image with its edges repeated ---
+            {
+                SDecodedTexture small = makePhoto(6, 6, true, false);
+                SDecodedTexture padded = makePhoto(8, 8, true, false);
+                for (uint32_t y = 0; y < 8; y++) {
+                    for (uint32_t x = 0; x < 8; x++) {
+                        memcpy(&padded.data[(y * 8 + x) * 4], &small.data[(std::min(y, 5u) * 6 + std::min(x, 5u)) * 4], 4);
+                    }
+                }
+                std::vector<uint8_t> a = roundTrip(ETextureCookFormat::BC7, small);
+                std::vector<uint8_t> b = roundTrip(ETextureCookFormat::BC7, padded);
+                bool same = true;
+                for (uint32_t y = 0; y < 6; y++) {
+                    same = same && memcmp(&a[y * 6 * 4], &b[y * 8 * 4], 6 * 4) == 0;
+                }
+                ASSERT(ctx, same, "Partial blocks repeat the edge pixels");
+            }
+
+            // --- Mips ---
+            {
+                // Black / white checker: linear average 0.5 = sRGB 188, not 128
+                SDecodedTexture checker = makePhoto(4, 4, true, false);
+                for (uint32_t i = 0; i < 16; i++) {
+                    uint8_t v = ((i % 4) + (i / 4)) % 2 ? 255 : 0;
+                    checker.data[i * 4 + 0] = checker.data[i * 4 + 1] = checker.data[i * 4 + 2] = v;
+                }
+                STextureCookOptions options;
+                options.colorFormat = ETextureCookFormat::RGBA8;
+                SDecodedTexture cooked;
+                STextureCookReport report;
+                ASSERT(ctx, CookTexture(checker, options, cooked, &report), "Cook sRGB checker");
+                ASSERT_EQUAL(ctx, (int)cooked.mips.size(), 3, "4x4 has 3 mips");
+                ASSERT_EQUAL(ctx, (int)cooked.data[cooked.mips[1].offset], 188, "sRGB mip averages in linear space");
+                ASSERT_EQUAL(ctx, (int)cooked.data[cooked.mips[2].offset], 188, "sRGB 1x1 mip");
+
+                checker.format = RHI::ETextureFormat::R8G8B8A8_UNORM;
+                options.detectNormalMaps = false;
+                ASSERT(ctx, CookTexture(checker, options, cooked, &report), "Cook linear checker");
+                ASSERT_EQUAL(ctx, (int)cooked.data[cooked.mips[1].offset], 128, "Linear mip is a plain average");
+                ASSERT(ctx, !cooked.generateMips, "Cooked textures carry their mips");
+            }
+            {
+                STextureCookOptions options;
+                SDecodedTexture cooked;
+                STextureCookReport report;
+                ASSERT(ctx, CookTexture(normals, options, cooked, &report), "Cook normal map");
+                ASSERT(ctx, report.normalMap && report.format == ETextureCookFormat::BC5, "Normal map detected, BC5");
+                ASSERT(ctx, cooked.format == RHI::ETextureFormat::BC5_UNORM, "BC5 RHI format");
+                ASSERT_EQUAL(ctx, (int)report.mipCount, 9, "256x256 has 9 mips");
+                ASSERT_EQUAL(ctx, (int)cooked.GetSizeBytes(), (int)report.cookedBytes, "Report matches the data");
+
+                // Mip 4 (16x16) decoded: XY of unit vectors
+                std::vector<uint8_t> mip(16 * 16 * 4);
+                DecodeBlocks(ETextureCookFormat::BC5, cooked.data.data() + cooked.mips[4].offset, 16, 16, mip.data());
+                int unit = 0;
+                for (size_t i = 0; i < 256; i++) {
+                    float x = mip[i * 4] / 127.5f - 1.0f, y = mip[i * 4 + 1] / 127.5f - 1.0f;
+                    unit += (x * x + y * y <= 1.02f) ? 1 : 0;
+                }
+                ASSERT_EQUAL(ctx, unit, 256, "Normal mips stay inside the unit disc");
+                ASSERT_EQUAL(ctx, (int)cooked.mips[8].rowPitch, 16, "1x1 BC5 mip is one block");
+            }
+            {
+                // 30x30: not block aligned, RGBA8 with CPU mips
+                SDecodedTexture odd = makePhoto(30, 30, true, false);
+                STextureCookOptions options;
+                SDecodedTexture cooked;
+                STextureCookReport report;
+                ASSERT(ctx, CookTexture(odd, options, cooked, &report), "Cook 30x30");
+                ASSERT(ctx, report.format == ETextureCookFormat::RGBA8, "Unaligned size falls back to RGBA8");
+                ASSERT_EQUAL(ctx, (int)report.mipCount, 5, "30x30 has 5 mips");
+                ASSERT_EQUAL(ctx, (int)cooked.mips[1].rowPitch, 15 * 4, "Mip 1 is 15 pixels wide");
+            }
+
+            // --- Format selection ---
+            {
+                STextureCookOptions options;
+                options.colorFormat = ETextureCookFormat::Auto;
+                bool normalMap = true;
+                ASSERT(ctx, SelectCookFormat(photo, true, options, &normalMap) == ETextureCookFormat::BC1 && !normalMap,
+                       "Auto: opaque color is BC1");
+                ASSERT(ctx, SelectCookFormat(alphaPhoto, true, options) == ETextureCookFormat::BC3, "Auto: alpha is BC3");
+                ASSERT(ctx, SelectCookFormat(normals, false, options) == ETextureCookFormat::BC5, "Auto: normal map is BC5");
+                ASSERT(ctx, SelectCookFormat(normals, true, options) == ETextureCookFormat::BC1, "sRGB is never a normal map");
+                options.colorFormat = ETextureCookFormat::BC7;
+                ASSERT(ctx, SelectCookFormat(photo, false, options) == ETextureCookFormat::BC7, "BC7 for linear color");
+                options.detectNormalMaps = false;
+                ASSERT(ctx, SelectCookFormat(normals, false, options) == ETextureCookFormat::BC7, "Detection off");
+                ASSERT(ctx, !IsNormalMapRGBA8(photo.data.data(), 256, 256, 256 * 4), "Photo is not a normal map");
+            }
+
+            // --- Parallel == serial ---
+            {
+                STextureCookOptions options;
+                SDecodedTexture serial, parallel;
+                options.parallel = false;
+                CookTexture(photo, options, serial);
+                options.parallel = true;
+                CookTexture(photo, options, parallel);
+                ASSERT(ctx, serial.data == parallel.data, "Parallel cook is byte-identical to serial");
+            }
+
+            // --- KTX2 round trip ---
+            {
+                std::filesystem::path dir = std::filesystem::temp_directory_path() / "forfun_test_texturecook";
+                std::string path = (dir / "photo.ktx2").string();
+                STextureCookOptions options;
+                SDecodedTexture cooked;
+                CookTexture(photo, options, cooked);
+                ASSERT(ctx, CKTXExporter::Export2DFromDecoded(cooked, path), "Export cooked KTX2");
+
+                SDecodedTexture loaded;
+                ASSERT(ctx, CKTXLoader::Decode2DTextureFromKTX2(path, loaded), "Decode cooked KTX2");
+                ASSERT(ctx, loaded.format == RHI::ETextureFormat::BC7_UNORM_SRGB, "Format survives");
+                ASSERT_EQUAL(ctx, (int)loaded.mips.size(), (int)cooked.mips.size(), "Mip count survives");
+                bool same = loaded.mips.size() == cooked.mips.size();
+                for (size_t mip = 0; same && mip < cooked.mips.size(); mip++) {
+                    size_t end = mip + 1 < cooked.mips.size() ? cooked.mips[mip + 1].offset : cooked.data.size();
+                    size_t size = end - cooked.mips[mip].offset;
+                    same = loaded.mips[mip].rowPitch == cooked.mips[mip].rowPitch &&
+                           memcmp(loaded.data.data() + loaded.mips[mip].offset,
+                                  cooked.data.data() + cooked.mips[mip].offset, size) == 0;
+                }
+                ASSERT(ctx, same, "Mip data and row pitch byte-identical");
+
+                // DDC payload
+                std::vector<uint8_t> payload;
+                SerializeCookedTexture(cooked, payload);
+                SDecodedTexture restored;
+                ASSERT(ctx, DeserializeCookedTexture(payload.data(), payload.size(), restored), "Cooked payload reads back");
+                ASSERT(ctx, restored.format == cooked.format && restored.width == cooked.width &&
+                            restored.height == cooked.height && restored.data == cooked.data &&
+                            restored.mips.size() == cooked.mips.size() && !restored.generateMips,
+                       "Cooked payload keeps format, size and data");
+                ASSERT(ctx, !DeserializeCookedTexture(payload.data(), payload.size() - 1, restored), "Truncated payload rejected");
+
+                // Keys hash the file content: the KTX2 written above stands in for a source image
+                std::string copy = (dir / "copy.ktx2").string();
+                std::error_code ec;
+                std::filesystem::copy_file(path, copy, std::filesystem::copy_options::overwrite_existing, ec);
+                SDerivedDataKey srgbKey, linearKey, copyKey, bc1Key;
+                STextureCookOptions bc1 = options;
+                bc1.colorFormat = ETextureCookFormat::BC1;
+                ASSERT(ctx, CTextureManager::MakeCookKey(path, true, options, srgbKey) &&
+                            CTextureManager::MakeCookKey(path, false, options, linearKey) &&
+                            CTextureManager::MakeCookKey(copy, true, options, copyKey) &&
+                            CTextureManager::MakeCookKey(path, true, bc1, bc1Key), "Cook keys built");
+                ASSERT(ctx, !(srgbKey == linearKey), "Cook key per color space");
+                ASSERT(ctx, !(srgbKey == bc1Key), "Cook key per format");
+                ASSERT(ctx, srgbKey == copyKey, "Same bytes at another path share the key");
+                ASSERT(ctx, !CTextureManager::MakeCookKey((dir / "missing.png").string(), true, options, srgbKey),
+                       "Missing file has no key");
+
+                std::filesystem::remove_all(dir, ec);
+            }
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Texture Cooking");
+
+            // --- CPU encoder ---
+            const uint32_t size = 2048;
+            const SDecodedTexture photo = makePhoto(size, size, true, true);
+            const SDecodedTexture normals = makeNormalMap(size, size);
+            const double mpix = (double)size * size / 1e6;
+            log.LogEvent("Encode 2048x2048 (top level): serial vs job system");
+            log.LogInfo("Threads: %u", CJobSystem::Instance().GetThreadCount());
+
+            const ETextureCookFormat formats[] = {
+                ETextureCookFormat::BC1, ETextureCookFormat::BC3, ETextureCookFormat::BC5, ETextureCookFormat::BC7};
+            for (ETextureCookFormat format : formats) {
+                const SDecodedTexture& image = format == ETextureCookFormat::BC5 ? normals : photo;
+                std::vector<uint8_t> blocks((size_t)(size / 4) * (size / 4) * GetCookBlockBytes(format));
+
+                auto start = std::chrono::high_resolution_clock::now();
+                EncodeBlocks(format, image.data.data(), size, size, size * 4, blocks.data(), false);
+                double serialMs = millisecondsSince(start);
+                start = std::chrono::high_resolution_clock::now();
+                EncodeBlocks(format, image.data.data(), size, size, size * 4, blocks.data(), true);
+                double parallelMs = millisecondsSince(start);
+
+                std::vector<uint8_t> decoded((size_t)size * size * 4);
+                DecodeBlocks(format, blocks.data(), size, size, decoded.data());
+                int channels = format == ETextureCookFormat::BC5 ? 2 : (format == ETextureCookFormat::BC1 ? 3 : 4);
+                log.LogInfo("%-4s : serial %8.2f ms (%6.1f MPix/s) | parallel %8.2f ms (%6.1f MPix/s) | %.2fx | PSNR %.2f dB",
+                            GetCookFormatName(format), serialMs, mpix / (serialMs / 1000.0), parallelMs,
+                            mpix / (parallelMs / 1000.0), parallelMs > 0.0 ? serialMs / parallelMs : 0.0,
+                            psnr(image.data.data(), decoded.data(), (size_t)size * size, channels));
+            }
+
+            {
+                STextureCookOptions options;
+                options.colorFormat = ETextureCookFormat::RGBA8;
+                SDecodedTexture cooked;
+                STextureCookReport serial, parallel;
+                options.parallel = false;
+                CookTexture(photo, options, cooked, &serial);
+                options.parallel = true;
+                CookTexture(photo, options, cooked, &parallel);
+                log.LogInfo("Mips : sRGB chain serial %.2f ms | parallel %.2f ms", serial.mipMs, parallel.mipMs);
+
+                options.colorFormat = ETextureCookFormat::BC7;
+                CookTexture(photo, options, cooked, &parallel);
+                log.LogInfo("Full BC7 cook (mips + encode): %.2f ms, %.1f MB -> %.1f MB", parallel.mipMs + parallel.encodeMs,
+                            parallel.sourceBytes / 1048576.0, parallel.cookedBytes / 1048576.0);
+            }
+
+            // --- Texture manager: legacy vs cooking vs cooked ---
+            const struct { const char* path; bool srgb; } textures[] = {
+                {"pbr_models/Barrel_01_1k.gltf/Barrel_01_1k_albedo.png", true},
+                {"pbr_models/Barrel_01_1k.gltf/Barrel_01_1k_normal.png", false},
+                {"pbr_models/Barrel_01_1k.gltf/Barrel_01_1k_metallic.png", false},
+            };
+            auto& manager = CTextureManager::Instance();
+            const bool wasCooking = manager.IsCookEnabled();
+            const bool wasCaching = manager.IsDiskCacheEnabled();
+            auto timeLoad = [&manager](const std::string& path, bool srgb, RHI::ETextureFormat& outFormat) {
+                manager.Clear();
+                auto start = std::chrono::high_resolution_clock::now();
+                RHI::TextureSharedPtr texture = manager.Load(path, srgb);
+                double ms = millisecondsSince(start);
+                outFormat = texture ? texture->GetFormat() : RHI::ETextureFormat::Unknown;
+                return ms;
+            };
+
+            log.LogEvent("Load time (ms): RGBA8 + GPU mips | first load (cook) | cooked KTX2");
+            double totalLegacy = 0.0, totalCooked = 0.0;
+            for (const auto& tex : textures) {
+                std::string path = FFPath::GetAbsolutePath(tex.path);
+                if (!std::filesystem::exists(path)) {
+                    log.LogInfo("%-50s : missing, skipped", tex.path);
+                    continue;
+                }
+
+                RHI::ETextureFormat format;
+                manager.SetCookEnabled(false);
+                double legacyMs = timeLoad(tex.path, tex.srgb, format);
+
+                SDerivedDataKey key;
+                if (CTextureManager::MakeCookKey(path, tex.srgb, manager.GetCookOptions(), key)) {
+                    CDerivedDataCache::Instance().Remove(key);
+                }
+                manager.SetCookEnabled(true);
+                manager.SetDiskCacheEnabled(true);
+                manager.ResetCookStats();
+                double cookMs = timeLoad(tex.path, tex.srgb, format);
+                ASSERT_EQUAL(ctx, (int)manager.GetCookStats().cooks, 1, "First load cooks");
+                manager.ResetCookStats();
+                double cookedMs = timeLoad(tex.path, tex.srgb, format);
+                CTextureManager::SCookStats stats = manager.GetCookStats();
+                ASSERT_EQUAL(ctx, (int)stats.cachedLoads, 1, "Second load reads the cooked file");
+                ASSERT(ctx, RHI::GetBlockBytes(format) != 0, "Cooked texture is block compressed");
+                if (!tex.srgb && std::string(tex.path).find("normal") != std::string::npos) {
+                    ASSERT(ctx, format == RHI::ETextureFormat::BC5_UNORM, "Barrel normal map is BC5");
+                }
+
+                log.LogInfo("%-50s : %8.2f | %8.2f | %7.2f | %5.1fx | GPU %6.2f MB -> %5.2f MB", tex.path, legacyMs,
+                            cookMs, cookedMs, cookedMs > 0.0 ? legacyMs / cookedMs : 0.0,
+                            stats.rgbaBytes / 1048576.0, stats.cookedBytes / 1048576.0);
+                totalLegacy += legacyMs;
+                totalCooked += cookedMs;
+            }
+            log.LogInfo("%-50s : %8.2f | %8s | %7.2f", "Total", totalLegacy, "", totalCooked);
+
+            manager.SetCookEnabled(wasCooking);
+            manager.SetDiskCacheEnabled(wasCaching);
+            manager.Clear();
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, totalCooked <= totalLegacy, "Cooked loads are not slower than RGBA8 + GPU mips");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestTextureCook)
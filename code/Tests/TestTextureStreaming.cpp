@@ -0,0 +1,284 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/TextureStreamer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Test: CTextureStreamer (background decode, budgeted upload), CPU only
+ *
+ * Uses a synthetic decoder (simulated file latency + per-pixel work) and a
+ * memcpy "upload", so it needs no assets and no GPU.
+ *
+ * Frame 1 (correctness):
+ *   - Decode order follows priority, then request order; SetPriority reorders
+ *   - Cancel works for queued, decoding and decoded requests
+ *   - Upload budget: max uploads, max bytes (but at least one upload per pump)
+ *   - Failed decodes reach the upload callback with nullptr
+ *   - Flush waits for and uploads everything
+ *
+ * Frame 5 (benchmark, 256 queued 512x512 textures):
+ *   - Legacy: decode + upload on the main thread, 2 textures per frame (old Tick(2))
+ *   - Streaming: decode on workers, main thread uploads under the budget
+ *   - Reports main-thread stall per frame (max / average) and frames to finish
+ *
+ * Usage:
+ *   forfun.exe --test TestTextureStreaming
+ *   Results: E:/forfun/debug/TestTextureStreaming/test.log
+ */
+class CTestTextureStreaming : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestTextureStreaming";
+    }
+
+    static const int BENCH_TEXTURE_COUNT = 256;
+    static const uint32_t BENCH_TEXTURE_SIZE = 512;
+
+    // Stand-in for file read + image decode: fixed latency, then per-pixel work
+    static bool syntheticDecode(const std::string& path, uint32_t size, int latencyMs, SDecodedTexture& out) {
+        if (path.find("missing") != std::string::npos) {
+            return false;
+        }
+        if (latencyMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(latencyMs));
+        }
+
+        uint32_t seed = (uint32_t)std::hash<std::string>()(path);
+        out.width = size;
+        out.height = size;
+        out.format = RHI::ETextureFormat::R8G8B8A8_UNORM;
+        out.generateMips = true;
+        out.data.resize((size_t)size * size * 4);
+        out.mips.assign(1, SDecodedTexture::SMip{0, size * 4});
+        for (size_t i = 0; i < out.data.size(); i++) {
+            seed = seed * 1664525u + 1013904223u;
+            // "Unfilter" against the previous byte, like PNG Sub
+            out.data[i] = (uint8_t)((seed >> 24) + (i > 0 ? out.data[i - 1] : 0));
+        }
+        return true;
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestTextureStreaming ===");
+            CFFLog::Info("Frame 1: Correctness checks");
+
+            // --- Priority order (single worker held on a gate so the queue builds up) ---
+            {
+                std::atomic<bool> gate{false};
+                std::mutex orderMutex;
+                std::vector<std::string> decodeOrder;
+                CTextureStreamer streamer([&](const std::string& path, bool, SDecodedTexture& out) {
+                    while (!gate.load()) std::this_thread::yield();
+                    std::lock_guard<std::mutex> lock(orderMutex);
+                    decodeOrder.push_back(path);
+                    return syntheticDecode(path, 4, 0, out);
+                }, 1);
+
+                streamer.Request("blocker", false);
+                while (streamer.GetQueuedCount() != 0) std::this_thread::yield();  // Worker holds "blocker"
+                streamer.Request("low_a", false, 0.0f);
+                streamer.Request("low_b", false, 0.0f);
+                CTextureStreamer::RequestId raised = streamer.Request("raised", false, 0.0f);
+                streamer.Request("high", false, 5.0f);
+                CTextureStreamer::RequestId cancelled = streamer.Request("cancelled", false, 10.0f);
+                ASSERT(ctx, streamer.SetPriority(raised, 7.0f), "SetPriority on a queued request");
+                ASSERT(ctx, streamer.Cancel(cancelled), "Cancel a queued request");
+                ASSERT(ctx, !streamer.Cancel(cancelled), "Cancel twice fails");
+                gate = true;
+
+                std::vector<CTextureStreamer::RequestId> uploaded;
+                streamer.Flush([&uploaded](CTextureStreamer::RequestId id, SDecodedTexture*) { uploaded.push_back(id); });
+
+                const std::vector<std::string> expected = {"blocker", "raised", "high", "low_a", "low_b"};
+                ASSERT(ctx, decodeOrder == expected, "Decode order: priority, then request order");
+                ASSERT_EQUAL(ctx, (int)uploaded.size(), 5, "Flush uploads every non-cancelled request");
+                ASSERT(ctx, std::find(uploaded.begin(), uploaded.end(), cancelled) == uploaded.end(),
+                       "Cancelled request is never uploaded");
+                ASSERT_EQUAL(ctx, (int)streamer.GetPendingCount(), 0, "Nothing pending after Flush");
+            }
+
+            // --- Cancel while decoding / after decoding ---
+            {
+                std::atomic<bool> gate{false};
+                CTextureStreamer streamer([&](const std::string& path, bool, SDecodedTexture& out) {
+                    if (path == "slow") while (!gate.load()) std::this_thread::yield();
+                    return syntheticDecode(path, 4, 0, out);
+                }, 1);
+
+                CTextureStreamer::RequestId slow = streamer.Request("slow", false);
+                while (streamer.GetQueuedCount() != 0) std::this_thread::yield();
+                ASSERT(ctx, streamer.Cancel(slow), "Cancel a decoding request");
+                gate = true;
+
+                CTextureStreamer::RequestId done = streamer.Request("done", false);
+                while (streamer.GetReadyCount() == 0) std::this_thread::yield();
+                ASSERT(ctx, streamer.Cancel(done), "Cancel a decoded request");
+
+                int uploads = 0;
+                streamer.Flush([&uploads](CTextureStreamer::RequestId, SDecodedTexture*) { uploads++; });
+                ASSERT_EQUAL(ctx, uploads, 0, "Cancelled results are dropped");
+                ASSERT_EQUAL(ctx, (int)streamer.GetStats().cancelled, 2, "Cancel count");
+            }
+
+            // --- Budgets and failures ---
+            {
+                const uint32_t size = 64;
+                const uint64_t textureBytes = (uint64_t)size * size * 4;
+                CTextureStreamer streamer([size](const std::string& path, bool, SDecodedTexture& out) {
+                    return syntheticDecode(path, size, 0, out);
+                }, 2);
+                for (int i = 0; i < 8; i++) {
+                    streamer.Request("tex_" + std::to_string(i), false);
+                }
+                CTextureStreamer::RequestId missing = streamer.Request("missing", false);
+                while (streamer.GetReadyCount() != 9) std::this_thread::yield();
+
+                auto countUploads = [](CTextureStreamer::RequestId, SDecodedTexture*) {};
+                CTextureStreamer::SUploadBudget budget;
+                budget.maxUploads = 1;
+                ASSERT_EQUAL(ctx, (int)streamer.PumpUploads(budget, countUploads), 1, "maxUploads limits the pump");
+
+                budget.maxUploads = 0;
+                budget.maxMilliseconds = 0.0f;
+                budget.maxBytes = textureBytes * 3;
+                ASSERT_EQUAL(ctx, (int)streamer.PumpUploads(budget, countUploads), 3, "maxBytes limits the pump");
+
+                budget.maxBytes = 1;
+                ASSERT_EQUAL(ctx, (int)streamer.PumpUploads(budget, countUploads), 1,
+                             "A texture larger than the byte budget still uploads alone");
+
+                bool missingFailed = false;
+                streamer.Flush([&](CTextureStreamer::RequestId id, SDecodedTexture* decoded) {
+                    if (id == missing) missingFailed = decoded == nullptr;
+                });
+                ASSERT(ctx, missingFailed, "Failed decode reaches the upload callback as nullptr");
+                ASSERT_EQUAL(ctx, (int)streamer.GetStats().failed, 1, "Failure counted");
+            }
+
+            CFFLog::Info("✓ Frame 1: Correctness checks passed");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Texture Streaming");
+
+            const int latencyMs = 2;
+            const uint64_t uploadBytes = (uint64_t)BENCH_TEXTURE_SIZE * BENCH_TEXTURE_SIZE * 4;
+            std::vector<uint8_t> gpuStaging(uploadBytes);
+            auto upload = [&gpuStaging](const SDecodedTexture& decoded) {
+                std::memcpy(gpuStaging.data(), decoded.data.data(), std::min(gpuStaging.size(), decoded.data.size()));
+            };
+            auto nowMs = []() {
+                return std::chrono::duration<double, std::milli>(
+                    std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+            };
+
+            struct SFrameStats {
+                double maxStallMs = 0.0;
+                double totalStallMs = 0.0;
+                int frames = 0;
+            };
+
+            // Legacy: everything on the main thread, 2 textures per frame
+            SFrameStats legacy;
+            {
+                int remaining = BENCH_TEXTURE_COUNT;
+                int next = 0;
+                while (remaining > 0) {
+                    double start = nowMs();
+                    for (int i = 0; i < 2 && remaining > 0; i++, remaining--) {
+                        SDecodedTexture decoded;
+                        syntheticDecode("bench_" + std::to_string(next++), BENCH_TEXTURE_SIZE, latencyMs, decoded);
+                        upload(decoded);
+                    }
+                    double stall = nowMs() - start;
+                    legacy.maxStallMs = std::max(legacy.maxStallMs, stall);
+                    legacy.totalStallMs += stall;
+                    legacy.frames++;
+                }
+            }
+
+            // Streaming: main thread only requests and uploads; frames are paced at ~60 Hz
+            SFrameStats streaming;
+            CTextureStreamer::SStats streamStats;
+            uint32_t workerCount = 0;
+            {
+                CTextureStreamer streamer([latencyMs](const std::string& path, bool, SDecodedTexture& out) {
+                    return syntheticDecode(path, BENCH_TEXTURE_SIZE, latencyMs, out);
+                });
+                workerCount = streamer.GetWorkerCount();
+
+                double start = nowMs();
+                for (int i = 0; i < BENCH_TEXTURE_COUNT; i++) {
+                    streamer.Request("bench_" + std::to_string(i), false, (float)(i % 4));
+                }
+                double requestMs = nowMs() - start;
+                streaming.maxStallMs = requestMs;
+                streaming.totalStallMs = requestMs;
+
+                CTextureStreamer::SUploadBudget budget;
+                budget.maxMilliseconds = 2.0f;
+                int uploaded = 0;
+                while (uploaded < BENCH_TEXTURE_COUNT) {
+                    double frameStart = nowMs();
+                    uploaded += (int)streamer.PumpUploads(budget, [&upload](CTextureStreamer::RequestId, SDecodedTexture* decoded) {
+                        if (decoded) upload(*decoded);
+                    });
+                    double stall = nowMs() - frameStart;
+                    streaming.maxStallMs = std::max(streaming.maxStallMs, stall);
+                    streaming.totalStallMs += stall;
+                    streaming.frames++;
+
+                    // Rest of the frame (rendering) while the workers decode
+                    double frameTime = nowMs() - frameStart;
+                    if (frameTime < 16.6) {
+                        std::this_thread::sleep_for(std::chrono::microseconds((int)((16.6 - frameTime) * 1000.0)));
+                    }
+                }
+                streamStats = streamer.GetStats();
+            }
+
+            log.LogEvent("Main-thread stall");
+            log.LogInfo("%d textures %ux%u RGBA8, %d ms simulated file latency", BENCH_TEXTURE_COUNT,
+                        BENCH_TEXTURE_SIZE, BENCH_TEXTURE_SIZE, latencyMs);
+            log.LogInfo("Legacy (2/frame, main thread) : max %7.3f ms | avg %7.3f ms | total %8.1f ms | %d frames",
+                        legacy.maxStallMs, legacy.totalStallMs / legacy.frames, legacy.totalStallMs, legacy.frames);
+            log.LogInfo("Streaming (%u workers)         : max %7.3f ms | avg %7.3f ms | total %8.1f ms | %d frames",
+                        workerCount, streaming.maxStallMs, streaming.totalStallMs / std::max(1, streaming.frames),
+                        streaming.totalStallMs, streaming.frames);
+            log.LogInfo("Worker decode time %.1f ms, upload time %.1f ms, %.1f MB uploaded",
+                        streamStats.decodeMs, streamStats.uploadMs, streamStats.uploadedBytes / (1024.0 * 1024.0));
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, streaming.totalStallMs < legacy.totalStallMs, "Streaming reduces total main-thread time");
+            ASSERT(ctx, streaming.maxStallMs < legacy.maxStallMs, "Streaming reduces the worst frame stall");
+            ASSERT_EQUAL(ctx, (int)streamStats.uploaded, BENCH_TEXTURE_COUNT, "Every texture uploaded");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestTextureStreaming)
@@ -0,0 +1,285 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Engine/World.h"
+#include "Engine/GameObject.h"
+#include "Engine/TransformSystem.h"
+#include "Engine/Components/Transform.h"
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace DirectX;
+
+/**
+ * Test: Transform hierarchy, cached world matrices and CTransformSystem
+ *
+ * Frame 1 (correctness):
+ *   - Quaternion LocalMatrix matches the old Euler S * R(RollPitchYaw) * T
+ *   - Euler round trip (GetRotationEuler / SetRotationEuler)
+ *   - Child world = child local * parent world, parent moves propagate
+ *   - SetParent keepWorldTransform, cycle rejection, parent destruction
+ *   - SetWorldMatrix under a parent (editor gizmo path)
+ *   - PrevWorldMatrix after CTransformSystem updates
+ *
+ * Frame 5 (benchmark, 100k transforms):
+ *   - Old path: Euler S*R*T rebuilt on every WorldMatrix() call (4 passes per frame)
+ *   - Cached: 4 passes over WorldMatrix() after one CTransformSystem::Update
+ *   - CTransformSystem serial vs parallel, static scene vs 1% moving
+ *
+ * Usage:
+ *   forfun.exe --test TestTransformHierarchy
+ *   Results: E:/forfun/debug/TestTransformHierarchy/test.log
+ */
+class CTestTransformHierarchy : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestTransformHierarchy";
+    }
+
+    static const int BENCH_TRANSFORM_COUNT = 100000;
+
+    static bool nearlyEqual(FXMMATRIX a, CXMMATRIX b, float eps = 1e-4f) {
+        for (int r = 0; r < 4; r++) {
+            XMVECTOR d = XMVectorAbs(XMVectorSubtract(a.r[r], b.r[r]));
+            if (!XMVector4LessOrEqual(d, XMVectorReplicate(eps))) return false;
+        }
+        return true;
+    }
+
+    // World matrix as the engine computed it before the hierarchy (Euler angles, no cache)
+    static XMMATRIX legacyWorldMatrix(const XMFLOAT3& p, const XMFLOAT3& euler, const XMFLOAT3& s) {
+        return XMMatrixScaling(s.x, s.y, s.z) *
+               XMMatrixRotationRollPitchYaw(euler.x, euler.y, euler.z) *
+               XMMatrixTranslation(p.x, p.y, p.z);
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&ctx]() {
+            CFFLog::Info("=== TestTransformHierarchy ===");
+            CFFLog::Info("Frame 1: Correctness checks");
+
+            CWorld world;
+            CTransformSystem system;
+
+            // --- Local matrix vs legacy Euler path ---
+            STransform* a = world.Create("A")->AddComponent<STransform>();
+            XMFLOAT3 euler{0.3f, -1.1f, 0.7f};
+            a->position = {1.0f, 2.0f, 3.0f};
+            a->scale = {2.0f, 1.0f, 0.5f};
+            a->SetRotationEuler(euler);
+            ASSERT(ctx, nearlyEqual(a->WorldMatrix(), legacyWorldMatrix(a->position, euler, a->scale)),
+                   "Quaternion world matrix matches the Euler S*R*T");
+
+            // --- Euler round trip (bypass the hint by writing the quaternion directly) ---
+            XMFLOAT4 q;
+            XMStoreFloat4(&q, XMQuaternionRotationRollPitchYaw(euler.x, euler.y, euler.z));
+            a->rotation = q;
+            XMFLOAT3 extracted = a->GetRotationEuler();
+            ASSERT_EQUAL_F(ctx, extracted.x, euler.x, 1e-4f, "Euler round trip pitch");
+            ASSERT_EQUAL_F(ctx, extracted.y, euler.y, 1e-4f, "Euler round trip yaw");
+            ASSERT_EQUAL_F(ctx, extracted.z, euler.z, 1e-4f, "Euler round trip roll");
+
+            // --- Parent / child composition ---
+            STransform* parent = world.Create("Parent")->AddComponent<STransform>();
+            STransform* child = world.Create("Child")->AddComponent<STransform>();
+            parent->position = {10.0f, 0.0f, 0.0f};
+            parent->SetRotation(0.0f, 90.0f, 0.0f);
+            child->position = {0.0f, 0.0f, 5.0f};
+            ASSERT(ctx, child->SetParent(parent, false), "SetParent succeeds");
+            ASSERT(ctx, child->GetParent() == parent && parent->GetChildren().size() == 1, "Parent / child links set");
+            ASSERT_EQUAL(ctx, (int)child->GetDepth(), 1, "Child depth");
+            ASSERT(ctx, nearlyEqual(child->WorldMatrix(), child->LocalMatrix() * parent->WorldMatrix()),
+                   "Child world = local * parent world");
+            XMFLOAT3 cw = child->GetWorldPosition();
+            ASSERT_EQUAL_F(ctx, cw.x, 15.0f, 1e-4f, "Child rotated by parent yaw (x)");
+            ASSERT_EQUAL_F(ctx, cw.z, 0.0f, 1e-4f, "Child rotated by parent yaw (z)");
+
+            // --- Parent move propagates through versions ---
+            uint32_t childVersion = child->GetWorldVersion();
+            parent->position.y = 4.0f;
+            ASSERT(ctx, child->GetWorldVersion() != childVersion, "Parent move changes the child world version");
+            ASSERT_EQUAL_F(ctx, child->GetWorldPosition().y, 4.0f, 1e-4f, "Parent move reaches the child");
+            childVersion = child->GetWorldVersion();
+            ASSERT_EQUAL(ctx, (int)child->GetWorldVersion(), (int)childVersion, "Unchanged transform keeps its version");
+
+            // --- Cycles are rejected ---
+            ASSERT(ctx, !parent->SetParent(child), "Parenting to a descendant is rejected");
+            ASSERT(ctx, parent->GetParent() == nullptr, "Rejected SetParent leaves the hierarchy unchanged");
+
+            // --- keepWorldTransform ---
+            STransform* other = world.Create("Other")->AddComponent<STransform>();
+            other->position = {-3.0f, 1.0f, 2.0f};
+            other->scale = {2.0f, 2.0f, 2.0f};
+            XMMATRIX before = child->WorldMatrix();
+            child->SetParent(other, true);
+            ASSERT(ctx, nearlyEqual(child->WorldMatrix(), before), "Reparent with keepWorldTransform keeps the pose");
+            ASSERT(ctx, parent->GetChildren().empty(), "Old parent forgets the child");
+
+            // --- SetWorldMatrix under a parent ---
+            XMMATRIX target = XMMatrixRotationRollPitchYaw(0.2f, 0.4f, 0.0f) * XMMatrixTranslation(7.0f, 8.0f, 9.0f);
+            ASSERT(ctx, child->SetWorldMatrix(target), "SetWorldMatrix decomposes");
+            ASSERT(ctx, nearlyEqual(child->WorldMatrix(), target), "SetWorldMatrix under a parent");
+
+            // --- Destroying the parent keeps the child's world pose ---
+            before = child->WorldMatrix();
+            world.Destroy(world.Count() - 1);   // "Other"
+            ASSERT(ctx, child->GetParent() == nullptr, "Child detached when its parent is destroyed");
+            ASSERT(ctx, nearlyEqual(child->WorldMatrix(), before), "Detached child keeps its world pose");
+
+            // --- Frame history ---
+            STransform* mover = world.Create("Mover")->AddComponent<STransform>();
+            mover->position = {1.0f, 0.0f, 0.0f};
+            system.Update(world);
+            ASSERT(ctx, nearlyEqual(mover->PrevWorldMatrix(), mover->WorldMatrix()),
+                   "First update: previous = current");
+            mover->position = {2.0f, 0.0f, 0.0f};
+            int rebuilt = system.Update(world);
+            ASSERT_EQUAL(ctx, rebuilt, 1, "Only the moved transform is rebuilt");
+            ASSERT_EQUAL_F(ctx, XMVectorGetX(mover->PrevWorldMatrix().r[3]), 1.0f, 1e-6f, "Previous frame position");
+            ASSERT_EQUAL_F(ctx, XMVectorGetX(mover->WorldMatrix().r[3]), 2.0f, 1e-6f, "Current frame position");
+            system.Update(world);
+            ASSERT(ctx, nearlyEqual(mover->PrevWorldMatrix(), mover->WorldMatrix()),
+                   "Static transform: previous = current");
+
+            // --- Deep chain sorted by level ---
+            STransform* last = nullptr;
+            for (int i = 0; i < 8; i++) {
+                STransform* t = world.Create("Chain")->AddComponent<STransform>();
+                t->position = {1.0f, 0.0f, 0.0f};
+                if (last) t->SetParent(last, false);
+                last = t;
+            }
+            system.Update(world);
+            ASSERT_EQUAL(ctx, system.GetLevelCount(), 8, "Chain produces 8 levels");
+            ASSERT_EQUAL_F(ctx, last->GetWorldPosition().x, 8.0f, 1e-5f, "Chain leaf accumulates parents");
+
+            CFFLog::Info("✓ Frame 1: Correctness checks passed");
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Transform Hierarchy");
+
+            // 100k transforms, later chained in groups of 10 (root + 9 levels)
+            CWorld world;
+            std::vector<STransform*> transforms;
+            std::vector<XMFLOAT3> eulers;
+            transforms.reserve(BENCH_TRANSFORM_COUNT);
+            eulers.reserve(BENCH_TRANSFORM_COUNT);
+            for (int i = 0; i < BENCH_TRANSFORM_COUNT; i++) {
+                STransform* t = world.Create("T")->AddComponent<STransform>();
+                XMFLOAT3 e{(float)(i % 7) * 0.1f, (float)(i % 13) * 0.2f, 0.0f};
+                t->position = {(float)(i % 100), 0.0f, (float)(i / 100)};
+                t->SetRotationEuler(e);
+                transforms.push_back(t);
+                eulers.push_back(e);
+            }
+
+            const int passes = 4;    // Roughly: culling, depth pre-pass, G-buffer, shadows
+            volatile float sink = 0.0f;
+            auto timeMs = [](auto&& fn) {
+                auto t0 = std::chrono::high_resolution_clock::now();
+                fn();
+                auto t1 = std::chrono::high_resolution_clock::now();
+                return std::chrono::duration<double, std::milli>(t1 - t0).count();
+            };
+
+            // Old path: every pass rebuilds S * R(Euler) * T
+            double legacyMs = timeMs([&]() {
+                float sum = 0.0f;
+                for (int p = 0; p < passes; p++) {
+                    for (size_t i = 0; i < transforms.size(); i++) {
+                        XMMATRIX m = legacyWorldMatrix(transforms[i]->position, eulers[i], transforms[i]->scale);
+                        sum += XMVectorGetX(m.r[3]);
+                    }
+                }
+                sink = sink + sum;
+            });
+
+            CTransformSystem system;
+            system.Update(world);
+            double cachedMs = timeMs([&]() {
+                system.Update(world);
+                float sum = 0.0f;
+                for (int p = 0; p < passes; p++) {
+                    for (STransform* t : transforms) {
+                        sum += XMVectorGetX(t->WorldMatrix().r[3]);
+                    }
+                }
+                sink = sink + sum;
+            });
+
+            // Build the hierarchy and time the per-frame update
+            for (int i = 0; i < BENCH_TRANSFORM_COUNT; i++) {
+                if (i % 10 != 0) transforms[i]->SetParent(transforms[i - 1], false);
+            }
+            auto moveOnePercent = [&](int frame) {
+                for (int i = frame % 100; i < BENCH_TRANSFORM_COUNT; i += 100) {
+                    transforms[i]->position.y = (float)frame;
+                }
+            };
+            auto timeUpdates = [&](bool parallel, bool moving) {
+                system.SetParallel(parallel);
+                system.Update(world);
+                const int frames = 10;
+                double total = 0.0;
+                for (int f = 0; f < frames; f++) {
+                    if (moving) moveOnePercent(f);
+                    total += timeMs([&]() { system.Update(world); });
+                }
+                return total / frames;
+            };
+            // Every transform moving (roots only: the whole hierarchy is rebuilt)
+            auto timeAllMoving = [&](bool parallel) {
+                system.SetParallel(parallel);
+                const int frames = 10;
+                double total = 0.0;
+                for (int f = 0; f < frames; f++) {
+                    for (int i = 0; i < BENCH_TRANSFORM_COUNT; i += 10) transforms[i]->position.y = (float)f;
+                    total += timeMs([&]() { system.Update(world); });
+                }
+                return total / frames;
+            };
+
+            double staticSerial = timeUpdates(false, false);
+            double movingSerial = timeUpdates(false, true);
+            double allSerial = timeAllMoving(false);
+            double staticParallel = timeUpdates(true, false);
+            double movingParallel = timeUpdates(true, true);
+            double allParallel = timeAllMoving(true);
+
+            log.LogEvent("World matrix CPU time");
+            log.LogInfo("%d transforms, %d matrix reads per transform per frame", BENCH_TRANSFORM_COUNT, passes);
+            log.LogInfo("Flat  : legacy Euler rebuild %7.3f ms | cached (update + reads) %7.3f ms (%.1fx)",
+                        legacyMs, cachedMs, cachedMs > 0.0 ? legacyMs / cachedMs : 0.0);
+            log.LogEvent("CTransformSystem::Update (hierarchy, chains of 10 below each root)");
+            log.LogInfo("Levels: %d", system.GetLevelCount());
+            log.LogInfo("Static     : serial %7.3f ms | parallel %7.3f ms", staticSerial, staticParallel);
+            log.LogInfo("1%% moving  : serial %7.3f ms | parallel %7.3f ms", movingSerial, movingParallel);
+            log.LogInfo("All moving : serial %7.3f ms | parallel %7.3f ms", allSerial, allParallel);
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+
+            ASSERT(ctx, cachedMs < legacyMs, "Cached world matrices are faster than the Euler rebuild");
+            ASSERT_EQUAL(ctx, system.GetLastRebuiltCount(), BENCH_TRANSFORM_COUNT, "All-moving frame rebuilds every transform");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestTransformHierarchy)
@@ -0,0 +1,141 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/Jobs/JobSystem.h"
+#include "Core/FFLog.h"
+#include "Core/PathManager.h"
+#include "Engine/Scene.h"
+#include "Engine/Rendering/VolumetricLightmap.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+ * Test: Parallel CPU volumetric lightmap bake
+ *
+ * Frame 5:
+ *   - Bake with 1 thread, then with all threads
+ *   - SH + validity must be bit-identical (per-voxel counter-based RNG)
+ *   - Progress callback reaches 1.0 and is called on the calling thread
+ *   - Cancel from progressCallback -> BakeAllBricks returns false
+ *   - Logs voxels/s and speedup
+ *
+ * Usage:
+ *   forfun.exe --test TestVolumetricLightmapCPUBake
+ *   Results: E:/forfun/debug/TestVolumetricLightmapCPUBake/test.log
+ */
+class CTestVolumetricLightmapCPUBake : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestVolumetricLightmapCPUBake";
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&]() {
+            std::string scenePath = FFPath::GetAbsolutePath("scenes/volumetric_lightmap_test.scene");
+            CScene::Instance().LoadFromFile(scenePath);
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            CFFLog::Info("=== TestVolumetricLightmapCPUBake ===");
+
+            CScene& scene = CScene::Instance();
+            CVolumetricLightmap& lightmap = scene.GetVolumetricLightmap();
+
+            CVolumetricLightmap::Config vlConfig;
+            vlConfig.volumeMin = { -10.0f, 0.0f, -10.0f };
+            vlConfig.volumeMax = { 10.0f, 10.0f, 10.0f };
+            vlConfig.minBrickWorldSize = 10.0f;  // Larger bricks for faster test
+
+            ASSERT(ctx, lightmap.Initialize(vlConfig), "Volumetric lightmap initialized");
+            lightmap.BuildOctree(scene);
+            ASSERT(ctx, !lightmap.GetBricks().empty(), "Octree generated bricks");
+
+            SLightmapBakeConfig bakeConfig;
+            bakeConfig.backend = ELightmapBakeBackend::CPU;
+            bakeConfig.cpuSamplesPerVoxel = 64;
+            bakeConfig.cpuMaxBounces = 2;
+
+            auto& log = CFFLog::Instance();
+            log.BeginSession("BENCHMARK", "Volumetric Lightmap CPU Bake");
+
+            auto& jobs = CJobSystem::Instance();
+            auto bake = [&](const char* label, double& outMs) {
+                auto start = std::chrono::high_resolution_clock::now();
+                bool ok = lightmap.BakeAllBricks(scene, bakeConfig);
+                auto end = std::chrono::high_resolution_clock::now();
+                outMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+                size_t voxelCount = lightmap.GetBricks().size() * VL_BRICK_VOXEL_COUNT;
+                log.LogInfo("%-10s threads %2u: %8.2f ms | %.0f voxels/s", label,
+                            jobs.IsInitialized() ? jobs.GetThreadCount() : 1u, outMs,
+                            voxelCount / (outMs / 1000.0));
+                return ok;
+            };
+
+            // Single-threaded reference
+            jobs.Shutdown();
+            double serialMs = 0.0;
+            ASSERT(ctx, bake("Serial", serialMs), "Serial bake succeeded");
+            std::vector<SBrick> reference = lightmap.GetBricks();
+
+            // Parallel
+            jobs.Initialize();
+            std::atomic<int> offThreadCallbacks{0};
+            float lastProgress = 0.0f;
+            std::thread::id callerThread = std::this_thread::get_id();
+            bakeConfig.progressCallback = [&](float progress) {
+                if (std::this_thread::get_id() != callerThread) offThreadCallbacks++;
+                lastProgress = progress;
+            };
+            double parallelMs = 0.0;
+            ASSERT(ctx, bake("Parallel", parallelMs), "Parallel bake succeeded");
+            ASSERT_EQUAL(ctx, offThreadCallbacks.load(), 0, "Progress callback runs on the calling thread");
+            ASSERT_EQUAL_F(ctx, lastProgress, 1.0f, 1e-6f, "Progress reaches 1.0");
+
+            const auto& bricks = lightmap.GetBricks();
+            ASSERT_EQUAL(ctx, (int)bricks.size(), (int)reference.size(), "Same brick count");
+            int mismatches = 0;
+            for (size_t i = 0; i < bricks.size() && i < reference.size(); i++) {
+                if (std::memcmp(&bricks[i].shData, &reference[i].shData, sizeof(bricks[i].shData)) != 0 ||
+                    bricks[i].validity != reference[i].validity) {
+                    mismatches++;
+                }
+            }
+            ASSERT_EQUAL(ctx, mismatches, 0, "Parallel bake is bit-identical to serial bake");
+
+            double speedup = (parallelMs > 0.0) ? serialMs / parallelMs : 0.0;
+            log.LogInfo("Speedup: %.2fx on %u threads (efficiency %.0f%%)",
+                        speedup, jobs.GetThreadCount(), 100.0 * speedup / jobs.GetThreadCount());
+
+            // Cancellation
+            std::atomic<bool> cancel{false};
+            bakeConfig.cancelFlag = &cancel;
+            bakeConfig.progressCallback = [&cancel](float progress) {
+                if (progress > 0.1f) cancel = true;
+            };
+            bool cancelledResult = lightmap.BakeAllBricks(scene, bakeConfig);
+            ASSERT(ctx, !cancelledResult, "Cancelled bake returns false");
+
+            log.EndSession();
+            log.FlushToFile(GetTestLogPath(ctx.testName).c_str());
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestVolumetricLightmapCPUBake)
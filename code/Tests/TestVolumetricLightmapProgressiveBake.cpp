@@ -0,0 +1,162 @@
+#include "Core/Testing/TestCase.h"
+#include "Core/Testing/TestRegistry.h"
+#include "Core/FFLog.h"
+#include "Core/PathManager.h"
+#include "Engine/Scene.h"
+#include "Engine/GameObject.h"
+#include "Engine/Components/DirectionalLight.h"
+#include "Engine/Components/PointLight.h"
+#include "Engine/Components/SpotLight.h"
+#include "Engine/Rendering/VolumetricLightmap.h"
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+/**
+ * Test: Progressive / resumable CPU volumetric lightmap bake
+ *
+ * Frame 5:
+ *   - Reference: 4 passes x 16 spp without checkpoint
+ *   - Cancel during pass 3 -> checkpoint holds 2 passes
+ *   - Resume from checkpoint -> bit-identical to the reference, checkpoint deleted
+ *   - Lights changed after the cancel -> checkpoint ignored, bake starts over
+ *   - Early stop (huge threshold, cpuMinPasses = 2) -> identical to a 2-pass bake
+ *
+ * Usage:
+ *   forfun.exe --test TestVolumetricLightmapProgressiveBake
+ *   Results: E:/forfun/debug/TestVolumetricLightmapProgressiveBake/test.log
+ */
+class CTestVolumetricLightmapProgressiveBake : public ITestCase {
+public:
+    const char* GetName() const override {
+        return "TestVolumetricLightmapProgressiveBake";
+    }
+
+    void Setup(CTestContext& ctx) override {
+        ctx.OnFrame(1, [&]() {
+            std::string scenePath = FFPath::GetAbsolutePath("scenes/volumetric_lightmap_test.scene");
+            CScene::Instance().LoadFromFile(scenePath);
+        });
+
+        ctx.OnFrame(5, [&ctx]() {
+            CFFLog::Info("=== TestVolumetricLightmapProgressiveBake ===");
+
+            CScene& scene = CScene::Instance();
+            CVolumetricLightmap& lightmap = scene.GetVolumetricLightmap();
+
+            CVolumetricLightmap::Config vlConfig;
+            vlConfig.volumeMin = { -10.0f, 0.0f, -10.0f };
+            vlConfig.volumeMax = { 10.0f, 10.0f, 10.0f };
+            vlConfig.minBrickWorldSize = 10.0f;  // Larger bricks for faster test
+
+            ASSERT(ctx, lightmap.Initialize(vlConfig), "Volumetric lightmap initialized");
+            lightmap.BuildOctree(scene);
+            ASSERT(ctx, !lightmap.GetBricks().empty(), "Octree generated bricks");
+
+            auto sameBricks = [](const std::vector<SBrick>& a, const std::vector<SBrick>& b) {
+                if (a.size() != b.size()) return false;
+                for (size_t i = 0; i < a.size(); i++) {
+                    if (std::memcmp(&a[i].shData, &b[i].shData, sizeof(a[i].shData)) != 0 ||
+                        a[i].validity != b[i].validity) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            SLightmapBakeConfig bakeConfig;
+            bakeConfig.backend = ELightmapBakeBackend::CPU;
+            bakeConfig.cpuSamplesPerVoxel = 64;
+            bakeConfig.cpuSamplesPerPass = 16;
+            bakeConfig.cpuMaxBounces = 2;
+
+            // Reference (uninterrupted)
+            ASSERT(ctx, lightmap.BakeAllBricks(scene, bakeConfig), "Reference progressive bake succeeded");
+            std::vector<SBrick> reference = lightmap.GetBricks();
+
+            // Interrupted during pass 3
+            std::string checkpointPath = GetTestLogPath(ctx.testName) + ".vlcheckpoint";
+            std::filesystem::remove(checkpointPath);
+
+            std::atomic<bool> cancel{false};
+            bakeConfig.checkpointPath = checkpointPath;
+            bakeConfig.cancelFlag = &cancel;
+            bakeConfig.progressCallback = [&cancel](float progress) {
+                if (progress > 0.5f) cancel = true;
+            };
+            ASSERT(ctx, !lightmap.BakeAllBricks(scene, bakeConfig), "Cancelled bake returns false");
+            ASSERT(ctx, std::filesystem::exists(checkpointPath), "Checkpoint written before cancel");
+
+            // Resume
+            cancel = false;
+            float firstProgress = -1.0f;
+            bakeConfig.progressCallback = [&firstProgress](float progress) {
+                if (firstProgress < 0.0f) firstProgress = progress;
+            };
+            ASSERT(ctx, lightmap.BakeAllBricks(scene, bakeConfig), "Resumed bake succeeded");
+            ASSERT_IN_RANGE(ctx, firstProgress, 0.5f, 1.0f, "Resumed bake starts after the saved passes");
+            ASSERT(ctx, sameBricks(lightmap.GetBricks(), reference), "Resumed bake is bit-identical to uninterrupted bake");
+            ASSERT(ctx, !std::filesystem::exists(checkpointPath), "Checkpoint deleted after completion");
+
+            // Same bricks and settings, different lighting: the checkpoint must not be reused
+            auto scaleLights = [&scene](float factor) {
+                int count = 0;
+                for (size_t i = 0; i < scene.GetWorld().Count(); i++) {
+                    CGameObject* obj = scene.GetWorld().Get(i);
+                    if (!obj) continue;
+                    if (auto* light = obj->GetComponent<SDirectionalLight>()) { light->intensity *= factor; count++; }
+                    if (auto* light = obj->GetComponent<SPointLight>()) { light->intensity *= factor; count++; }
+                    if (auto* light = obj->GetComponent<SSpotLight>()) { light->intensity *= factor; count++; }
+                }
+                return count;
+            };
+
+            cancel = false;
+            bakeConfig.progressCallback = [&cancel](float progress) {
+                if (progress > 0.5f) cancel = true;
+            };
+            ASSERT(ctx, !lightmap.BakeAllBricks(scene, bakeConfig), "Second cancelled bake returns false");
+            ASSERT(ctx, scaleLights(2.0f) > 0, "Test scene has lights");
+
+            cancel = false;
+            firstProgress = -1.0f;
+            bakeConfig.progressCallback = [&firstProgress](float progress) {
+                if (firstProgress < 0.0f) firstProgress = progress;
+            };
+            ASSERT(ctx, lightmap.BakeAllBricks(scene, bakeConfig), "Bake after light change succeeded");
+            ASSERT_IN_RANGE(ctx, firstProgress, 0.0f, 0.3f, "Checkpoint of different lighting is ignored (bake starts over)");
+            scaleLights(0.5f);
+
+            // Early stop: every brick converges after cpuMinPasses
+            bakeConfig.checkpointPath.clear();
+            bakeConfig.cancelFlag = nullptr;
+            bakeConfig.progressCallback = nullptr;
+            bakeConfig.cpuSamplesPerVoxel = 32;
+            ASSERT(ctx, lightmap.BakeAllBricks(scene, bakeConfig), "2-pass bake succeeded");
+            std::vector<SBrick> twoPass = lightmap.GetBricks();
+
+            bakeConfig.cpuSamplesPerVoxel = 64;
+            bakeConfig.cpuConvergenceThreshold = 1e6f;
+            bakeConfig.cpuMinPasses = 2;
+            ASSERT(ctx, lightmap.BakeAllBricks(scene, bakeConfig), "Early-stop bake succeeded");
+            ASSERT(ctx, sameBricks(lightmap.GetBricks(), twoPass), "Converged bricks stop after cpuMinPasses");
+        });
+
+        ctx.OnFrame(10, [&ctx]() {
+            if (ctx.failures.empty()) {
+                ctx.testPassed = true;
+                CFFLog::Info("✓ ALL ASSERTIONS PASSED");
+            } else {
+                ctx.testPassed = false;
+                CFFLog::Error("✗ TEST FAILED: %zu assertion(s) failed", ctx.failures.size());
+                for (const auto& failure : ctx.failures) {
+                    CFFLog::Error("  - %s", failure.c_str());
+                }
+            }
+            ctx.Finish();
+        });
+    }
+};
+
+REGISTER_TEST(CTestVolumetricLightmapProgressiveBake)
@@ -40,6 +40,8 @@
 #include "Camera.h"   // CCamera（Viewport 面板用）
 #include "EditorContext.h"  // ✅ 编辑器交互管理（相机控制）
 #include "Core/TextureManager.h"  // Texture cache manager
+#include "Core/DerivedDataCache.h"  // Cooked asset cache
+#include "Core/Jobs/JobSystem.h"  // Work-stealing job system
 #include "Components/DirectionalLight.h"
 #include "DebugPaths.h"  // Debug output directories
 #include "FFLog.h"  // Logging system
@@ -343,6 +345,9 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
     // 1.5) Initialize logging (clears old log file)
     CFFLog::Initialize();
 
+    // 1.6) Job system (worker threads for CPU-side engine work)
+    CJobSystem::Instance().Initialize();
+
     // 2) Load render configuration
     {
         std::string configPath = SRenderConfig::GetDefaultPath();
@@ -467,8 +472,8 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
         // 1. RHI BeginFrame
         rhiCtx->BeginFrame();
 
-        // 1.5. Process async texture loads (frame-budget: 2 textures per frame)
-        CTextureManager::Instance().Tick(2);
+        // 1.5. Upload textures decoded in the background (byte/time upload budget)
+        CTextureManager::Instance().Tick();
 
         // 2. Deferred initialization (must be after command list is open for DX12)
         if (!sceneInitialized) {
@@ -570,6 +575,9 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
             editorCamera.aspectRatio = aspect;
             CEditorContext::Instance().Update(dt, editorCamera);
 
+            // World matrices for this frame (also shifts previous-frame matrices for motion vectors)
+            CScene::Instance().GetTransformSystem().Update(CScene::Instance().GetWorld());
+
             // Collect debug lines
             g_pipeline->GetDebugLinePass().BeginFrame();
             CDebugRenderSystem::Instance().CollectAndRender(CScene::Instance(), g_pipeline->GetDebugLinePass());
@@ -725,6 +733,8 @@ cleanup:
         ImGui::DestroyContext();
     }
 
+    CDerivedDataCache::Instance().LogReport();
+
     // Shutdown singleton managers before RHI (they hold GPU resources)
     CFFLog::Info("Shutting down TextureManager...");
     CTextureManager::Instance().Shutdown();
@@ -734,6 +744,9 @@ cleanup:
         RHI::CRHIManager::Instance().Shutdown();
     }
 
+    CFFLog::Info("Shutting down JobSystem...");
+    CJobSystem::Instance().Shutdown();
+
     CFFLog::Info("Shutdown complete.");
     return exitCode;
 }
\ No newline at end of file